@@ -0,0 +1,713 @@
+/**
+ * This module implements the throughput test of the AT Client command queue.
+ *
+ * A fake modem answering a few polling commands runs on the master side of a pseudo-terminal,
+ * whose slave side is handed to the AT Client.  The same polling sequence is sent a number of
+ * times:
+ *  - synchronously, with le_atClient_SetCommandAndSend(),
+ *  - asynchronously, with le_atClient_SendAsync(), every command on its own command line,
+ *  - asynchronously, allowing the commands to be concatenated on the same command line.
+ *
+ * Every response is checked, and the number of commands per second and of command lines the
+ * modem received are reported for each mode.
+ *
+ * The intermediate responses of a message listing answering hundreds of lines are then read one at
+ * a time, and in bulk with le_atClient_GetIntermediateResponses(), and the number of calls (that
+ * is, of IPC round trips for a client app) and the time spent are reported for both.
+ *
+ * A listing larger than the responses buffer of a command must still complete with its final
+ * response.
+ *
+ * Finally, a device is stopped while a command sent asynchronously waits for the modem, which must
+ * complete the command with LE_TERMINATED.
+ *
+ * Usage: atClientPipelineTest [<rounds> [<modem delay per command line in us>]]
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+#include <pty.h>
+#include <termios.h>
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Default number of times the polling sequence is sent in each mode
+ */
+//--------------------------------------------------------------------------------------------------
+#define DEFAULT_ROUNDS 200
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Default time the fake modem takes to process a command line, in microseconds
+ */
+//--------------------------------------------------------------------------------------------------
+#define DEFAULT_LINE_DELAY_US 500
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Command timeout in milliseconds
+ */
+//--------------------------------------------------------------------------------------------------
+#define COMMAND_TIMEOUT 5000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of messages in the listing answered by the fake modem, and number of times it is read
+ */
+//--------------------------------------------------------------------------------------------------
+#define LISTING_MESSAGES 200
+#define LISTING_READS    50
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of messages in the listing answered by the fake modem to the large listing command: more
+ * than 64 KiB of intermediate responses, the most a command keeps.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LARGE_LISTING_MESSAGES 1000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Message listing command
+ */
+//--------------------------------------------------------------------------------------------------
+#define LISTING_CMD "AT+CMGL=4"
+#define LARGE_LISTING_CMD "AT+CMGL=1"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Polling command, and the answer of the fake modem
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const char* cmdPtr;             ///< Command
+    const char* interRspPtr;        ///< Expected intermediate response
+    const char* answerPtr;          ///< Intermediate response sent by the modem
+}
+PollCmd_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Polling sequence
+ */
+//--------------------------------------------------------------------------------------------------
+static const PollCmd_t PollCmds[] =
+{
+    { "AT+CSQ",    "+CSQ:",   "+CSQ: 21,99"                  },
+    { "AT+CREG?",  "+CREG:",  "+CREG: 0,1"                   },
+    { "AT+CGREG?", "+CGREG:", "+CGREG: 0,1"                  },
+    { "AT+COPS?",  "+COPS:",  "+COPS: 0,0,\"Orange F\",7"    },
+    { "AT+CESQ",   "+CESQ:",  "+CESQ: 99,99,255,255,22,55"   },
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test parameters and state
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t                Rounds = DEFAULT_ROUNDS;
+static uint32_t                LineDelayUs = DEFAULT_LINE_DELAY_US;
+static int                     MasterFd = -1;
+static le_atClient_DeviceRef_t DevRef;
+static uint32_t                ModemLines;
+static uint32_t                CompletedCmds;
+static uint32_t                ExpectedCmds;
+static uint32_t                StartLines;
+static le_clk_Time_t           StartTime;
+static bool                    Concatenate;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write a string to the master side of the pseudo-terminal
+ */
+//--------------------------------------------------------------------------------------------------
+static void ModemWrite
+(
+    const char* strPtr
+)
+{
+    size_t len = strlen(strPtr);
+
+    while (len > 0)
+    {
+        ssize_t count = write(MasterFd, strPtr, len);
+
+        if (count < 0)
+        {
+            LE_FATAL_IF(EINTR != errno, "write failed (%m)");
+            continue;
+        }
+        strPtr += count;
+        len -= count;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write the intermediate responses of a message listing
+ */
+//--------------------------------------------------------------------------------------------------
+static void ModemWriteListing
+(
+    size_t messageCount
+)
+{
+    size_t i;
+
+    for (i = 0; i < messageCount; i++)
+    {
+        char listing[128];
+
+        snprintf(listing, sizeof(listing),
+                 "\r\n+CMGL: %zu,1,,24\r\n"
+                 "07913366003001F0040B913366611568F60000319050909500%04zX04D4F29C0E\r\n",
+                 i + 1, i);
+        ModemWrite(listing);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Answer a command line, whose commands are separated by ';'
+ */
+//--------------------------------------------------------------------------------------------------
+static void ModemAnswer
+(
+    char* linePtr
+)
+{
+    char answer[4096] = "";
+    char* savePtr;
+    char* cmdPtr;
+    size_t i;
+
+    __atomic_add_fetch(&ModemLines, 1, __ATOMIC_RELAXED);
+
+    if (LineDelayUs > 0)
+    {
+        usleep(LineDelayUs);
+    }
+
+    if (strncasecmp(linePtr, "AT", 2) != 0)
+    {
+        ModemWrite("\r\nERROR\r\n");
+        return;
+    }
+
+    for (cmdPtr = strtok_r(linePtr + 2, ";", &savePtr);
+         cmdPtr != NULL;
+         cmdPtr = strtok_r(NULL, ";", &savePtr))
+    {
+        if ((strcmp(cmdPtr, LISTING_CMD + 2) == 0) || (strcmp(cmdPtr, LARGE_LISTING_CMD + 2) == 0))
+        {
+            ModemWrite(answer);
+            answer[0] = '\0';
+
+            ModemWriteListing((strcmp(cmdPtr, LISTING_CMD + 2) == 0) ? LISTING_MESSAGES :
+                                                                      LARGE_LISTING_MESSAGES);
+            continue;
+        }
+
+        for (i = 0; i < NUM_ARRAY_MEMBERS(PollCmds); i++)
+        {
+            if (strcmp(cmdPtr, PollCmds[i].cmdPtr + 2) == 0)
+            {
+                break;
+            }
+        }
+
+        if (i == NUM_ARRAY_MEMBERS(PollCmds))
+        {
+            // The modem stops executing the command line at the first error
+            ModemWrite(answer);
+            ModemWrite("\r\nERROR\r\n");
+            return;
+        }
+
+        le_utf8_Append(answer, "\r\n", sizeof(answer), NULL);
+        le_utf8_Append(answer, PollCmds[i].answerPtr, sizeof(answer), NULL);
+        le_utf8_Append(answer, "\r\n", sizeof(answer), NULL);
+    }
+
+    le_utf8_Append(answer, "\r\nOK\r\n", sizeof(answer), NULL);
+    ModemWrite(answer);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fake modem thread: read command lines on the master side of the pseudo-terminal, and answer them
+ */
+//--------------------------------------------------------------------------------------------------
+static void* ModemThread
+(
+    void* contextPtr
+)
+{
+    char line[LE_ATDEFS_COMMAND_MAX_BYTES + 1];
+    size_t len = 0;
+
+    for (;;)
+    {
+        char c;
+        ssize_t count = read(MasterFd, &c, 1);
+
+        if (count <= 0)
+        {
+            LE_FATAL_IF((count < 0) && (EINTR != errno), "read failed (%m)");
+            continue;
+        }
+
+        if ('\r' == c)
+        {
+            line[len] = '\0';
+            ModemAnswer(line);
+            len = 0;
+        }
+        else if (len < sizeof(line) - 1)
+        {
+            line[len++] = c;
+        }
+    }
+
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check the intermediate response of a polling command
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckResponse
+(
+    le_atClient_CmdRef_t cmdRef,
+    const PollCmd_t*     pollCmdPtr
+)
+{
+    char rsp[LE_ATDEFS_RESPONSE_MAX_BYTES];
+
+    LE_ASSERT(LE_OK == le_atClient_GetFirstIntermediateResponse(cmdRef, rsp, sizeof(rsp)));
+    LE_ASSERT(0 == strcmp(rsp, pollCmdPtr->answerPtr));
+    LE_ASSERT(LE_NOT_FOUND == le_atClient_GetNextIntermediateResponse(cmdRef, rsp, sizeof(rsp)));
+
+    LE_ASSERT(LE_OK == le_atClient_GetFinalResponse(cmdRef, rsp, sizeof(rsp)));
+    LE_ASSERT(0 == strcmp(rsp, "OK"));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Report the throughput of a mode
+ */
+//--------------------------------------------------------------------------------------------------
+static void Report
+(
+    const char* modePtr
+)
+{
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), StartTime);
+    double seconds = elapsed.sec + elapsed.usec / 1e6;
+    uint32_t cmdCount = Rounds * NUM_ARRAY_MEMBERS(PollCmds);
+    uint32_t lines = __atomic_load_n(&ModemLines, __ATOMIC_RELAXED) - StartLines;
+
+    LE_INFO("%s: %"PRIu32" commands on %"PRIu32" command lines in %.3f s: %.0f commands/s",
+            modePtr, cmdCount, lines, seconds, cmdCount / seconds);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send the polling sequence synchronously
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestSync
+(
+    void
+)
+{
+    uint32_t round;
+    size_t i;
+
+    StartLines = __atomic_load_n(&ModemLines, __ATOMIC_RELAXED);
+    StartTime = le_clk_GetRelativeTime();
+
+    for (round = 0; round < Rounds; round++)
+    {
+        for (i = 0; i < NUM_ARRAY_MEMBERS(PollCmds); i++)
+        {
+            le_atClient_CmdRef_t cmdRef;
+
+            LE_ASSERT(LE_OK == le_atClient_SetCommandAndSend(&cmdRef,
+                                                             DevRef,
+                                                             PollCmds[i].cmdPtr,
+                                                             PollCmds[i].interRspPtr,
+                                                             "OK|ERROR|+CME ERROR:",
+                                                             COMMAND_TIMEOUT));
+            CheckResponse(cmdRef, &PollCmds[i]);
+            LE_ASSERT(LE_OK == le_atClient_Delete(cmdRef));
+        }
+    }
+
+    Report("Synchronous");
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the intermediate responses of a message listing one at a time, and in bulk
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestBulk
+(
+    void
+)
+{
+    static char lines[2 * LISTING_MESSAGES][LE_ATDEFS_RESPONSE_MAX_BYTES];
+    uint8_t responses[LE_ATCLIENT_RESPONSES_MAX_BYTES];
+    le_atClient_CmdRef_t cmdRef;
+    uint32_t oneCalls = 0;
+    uint32_t bulkCalls = 0;
+    uint32_t read;
+    uint32_t i;
+
+    LE_ASSERT(LE_OK == le_atClient_SetCommandAndSend(&cmdRef,
+                                                     DevRef,
+                                                     LISTING_CMD,
+                                                     "",
+                                                     "OK|ERROR|+CMS ERROR:",
+                                                     COMMAND_TIMEOUT));
+
+    // One at a time
+    le_clk_Time_t start = le_clk_GetRelativeTime();
+
+    for (read = 0; read < LISTING_READS; read++)
+    {
+        i = 0;
+        LE_ASSERT(LE_OK == le_atClient_GetFirstIntermediateResponse(cmdRef, lines[i],
+                                                                    sizeof(lines[i])));
+        do
+        {
+            i++;
+        }
+        while ((i < NUM_ARRAY_MEMBERS(lines)) &&
+               (LE_OK == le_atClient_GetNextIntermediateResponse(cmdRef, lines[i],
+                                                                 sizeof(lines[i]))));
+        LE_ASSERT(NUM_ARRAY_MEMBERS(lines) == i);
+
+        // One call per line (a client app would make one more to get LE_NOT_FOUND)
+        oneCalls += i;
+    }
+
+    le_clk_Time_t oneTime = le_clk_Sub(le_clk_GetRelativeTime(), start);
+
+    // In bulk
+    start = le_clk_GetRelativeTime();
+
+    for (read = 0; read < LISTING_READS; read++)
+    {
+        le_result_t result;
+
+        i = 0;
+        do
+        {
+            size_t size = sizeof(responses);
+            uint32_t count;
+            size_t offset = 0;
+
+            result = le_atClient_GetIntermediateResponses(cmdRef, i, responses, &size, &count);
+            LE_ASSERT((LE_OK == result) || (LE_OVERFLOW == result));
+            LE_ASSERT(count > 0);
+            bulkCalls++;
+
+            for (; count > 0; count--, i++)
+            {
+                LE_ASSERT(0 == strcmp((char*)responses + offset, lines[i]));
+                offset += strlen((char*)responses + offset) + 1;
+            }
+            LE_ASSERT(offset == size);
+        }
+        while (LE_OVERFLOW == result);
+
+        LE_ASSERT(NUM_ARRAY_MEMBERS(lines) == i);
+    }
+
+    le_clk_Time_t bulkTime = le_clk_Sub(le_clk_GetRelativeTime(), start);
+
+    // With a buffer smaller than a line, each call gets one response, truncated if needed.
+    le_result_t result;
+
+    i = 0;
+    do
+    {
+        char small[16];
+        size_t size = sizeof(small);
+        uint32_t count;
+
+        result = le_atClient_GetIntermediateResponses(cmdRef, i, (uint8_t*)small, &size, &count);
+        LE_ASSERT((LE_OK == result) || (LE_OVERFLOW == result));
+        LE_ASSERT(1 == count);
+        LE_ASSERT(0 == strncmp(small, lines[i], sizeof(small) - 1));
+        i++;
+    }
+    while (LE_OVERFLOW == result);
+
+    LE_ASSERT(NUM_ARRAY_MEMBERS(lines) == i);
+
+    size_t size = sizeof(responses);
+    uint32_t count;
+    LE_ASSERT(LE_NOT_FOUND == le_atClient_GetIntermediateResponses(cmdRef, i, responses, &size,
+                                                                   &count));
+    LE_ASSERT(LE_OK == le_atClient_Delete(cmdRef));
+
+    LE_INFO("Listing of %u lines, one at a time: %.1f calls, %.1f us per read",
+            (unsigned int)NUM_ARRAY_MEMBERS(lines), (double)oneCalls / LISTING_READS,
+            (oneTime.sec * 1e6 + oneTime.usec) / LISTING_READS);
+    LE_INFO("Listing of %u lines, in bulk: %.1f calls, %.1f us per read",
+            (unsigned int)NUM_ARRAY_MEMBERS(lines), (double)bulkCalls / LISTING_READS,
+            (bulkTime.sec * 1e6 + bulkTime.usec) / LISTING_READS);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send a command whose intermediate responses do not fit in its responses buffer: the responses
+ * beyond are dropped, but the command completes with its final response.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestLargeListing
+(
+    void
+)
+{
+    char rsp[LE_ATDEFS_RESPONSE_MAX_BYTES];
+    le_atClient_CmdRef_t cmdRef;
+    uint32_t count = 0;
+    le_result_t result;
+
+    LE_ASSERT(LE_OK == le_atClient_SetCommandAndSend(&cmdRef,
+                                                     DevRef,
+                                                     LARGE_LISTING_CMD,
+                                                     "",
+                                                     "OK|ERROR|+CMS ERROR:",
+                                                     COMMAND_TIMEOUT));
+
+    LE_ASSERT(LE_OK == le_atClient_GetFinalResponse(cmdRef, rsp, sizeof(rsp)));
+    LE_ASSERT(0 == strcmp(rsp, "OK"));
+
+    LE_ASSERT(LE_OK == le_atClient_GetFirstIntermediateResponse(cmdRef, rsp, sizeof(rsp)));
+    LE_ASSERT(0 == strcmp(rsp, "+CMGL: 1,1,,24"));
+    do
+    {
+        count++;
+        result = le_atClient_GetNextIntermediateResponse(cmdRef, rsp, sizeof(rsp));
+    }
+    while (LE_OK == result);
+
+    LE_ASSERT(LE_NOT_FOUND == result);
+    LE_ASSERT((count > 2 * LISTING_MESSAGES) && (count < 2 * LARGE_LISTING_MESSAGES));
+    LE_ASSERT(LE_OK == le_atClient_Delete(cmdRef));
+
+    LE_INFO("Listing of %u lines: %"PRIu32" kept, command completed",
+            2 * LARGE_LISTING_MESSAGES, count);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Completion handler of the command whose device is stopped before the modem answers
+ */
+//--------------------------------------------------------------------------------------------------
+static void TerminatedResultHandler
+(
+    le_atClient_CmdRef_t cmdRef,
+    le_result_t          result,
+    const char*          finalRspPtr,
+    void*                contextPtr
+)
+{
+    LE_ASSERT(LE_TERMINATED == result);
+    LE_ASSERT(0 == strcmp(finalRspPtr, ""));
+    LE_ASSERT(LE_OK == le_atClient_Delete(cmdRef));
+
+    LE_INFO("====== ATClient pipeline test PASSED ======");
+    exit(EXIT_SUCCESS);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stop a device while a command sent asynchronously waits for the modem's answer
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestStop
+(
+    void
+)
+{
+    struct termios term;
+    int masterFd;
+    int slaveFd;
+    char c;
+
+    // Nobody answers on this pseudo-terminal.
+    LE_ASSERT(0 == openpty(&masterFd, &slaveFd, NULL, NULL, NULL));
+    LE_ASSERT(0 == tcgetattr(slaveFd, &term));
+    cfmakeraw(&term);
+    LE_ASSERT(0 == tcsetattr(slaveFd, TCSANOW, &term));
+
+    le_atClient_DeviceRef_t devRef = le_atClient_Start(slaveFd);
+    LE_ASSERT(devRef);
+
+    le_atClient_CmdRef_t cmdRef = le_atClient_Create();
+
+    LE_ASSERT(LE_OK == le_atClient_SetCommand(cmdRef, PollCmds[0].cmdPtr));
+    LE_ASSERT(LE_OK == le_atClient_SetDevice(cmdRef, devRef));
+    LE_ASSERT(LE_OK == le_atClient_SetIntermediateResponse(cmdRef, PollCmds[0].interRspPtr));
+    LE_ASSERT(LE_OK == le_atClient_SetFinalResponse(cmdRef, "OK|ERROR|+CME ERROR:"));
+    LE_ASSERT(LE_OK == le_atClient_SetTimeout(cmdRef, COMMAND_TIMEOUT));
+    LE_ASSERT(LE_OK == le_atClient_SendAsync(cmdRef, false, TerminatedResultHandler, NULL));
+
+    // Wait for the command line to be sent, then stop the device.
+    do
+    {
+        LE_ASSERT(1 == read(masterFd, &c, 1));
+    }
+    while ('\r' != c);
+
+    LE_ASSERT(LE_OK == le_atClient_Stop(devRef));
+    close(masterFd);
+}
+
+static void StartAsync(bool concatenate);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Completion handler of the commands sent asynchronously
+ */
+//--------------------------------------------------------------------------------------------------
+static void CommandResultHandler
+(
+    le_atClient_CmdRef_t cmdRef,
+    le_result_t          result,
+    const char*          finalRspPtr,
+    void*                contextPtr
+)
+{
+    const PollCmd_t* pollCmdPtr = contextPtr;
+
+    LE_ASSERT(LE_OK == result);
+    LE_ASSERT(0 == strcmp(finalRspPtr, "OK"));
+    CheckResponse(cmdRef, pollCmdPtr);
+    LE_ASSERT(LE_OK == le_atClient_Delete(cmdRef));
+
+    if (++CompletedCmds < ExpectedCmds)
+    {
+        return;
+    }
+
+    uint32_t lines = __atomic_load_n(&ModemLines, __ATOMIC_RELAXED) - StartLines;
+
+    if (!Concatenate)
+    {
+        Report("Asynchronous");
+        LE_ASSERT(lines == ExpectedCmds);
+
+        StartAsync(true);
+    }
+    else
+    {
+        Report("Asynchronous, concatenated");
+        LE_ASSERT(lines < ExpectedCmds);
+
+        TestStop();
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queue the polling sequence asynchronously
+ */
+//--------------------------------------------------------------------------------------------------
+static void StartAsync
+(
+    bool concatenate
+)
+{
+    uint32_t round;
+    size_t i;
+
+    Concatenate = concatenate;
+    CompletedCmds = 0;
+    ExpectedCmds = Rounds * NUM_ARRAY_MEMBERS(PollCmds);
+    StartLines = __atomic_load_n(&ModemLines, __ATOMIC_RELAXED);
+    StartTime = le_clk_GetRelativeTime();
+
+    for (round = 0; round < Rounds; round++)
+    {
+        for (i = 0; i < NUM_ARRAY_MEMBERS(PollCmds); i++)
+        {
+            le_atClient_CmdRef_t cmdRef = le_atClient_Create();
+
+            LE_ASSERT(LE_OK == le_atClient_SetCommand(cmdRef, PollCmds[i].cmdPtr));
+            LE_ASSERT(LE_OK == le_atClient_SetDevice(cmdRef, DevRef));
+            LE_ASSERT(LE_OK == le_atClient_SetIntermediateResponse(cmdRef,
+                                                                   PollCmds[i].interRspPtr));
+            LE_ASSERT(LE_OK == le_atClient_SetFinalResponse(cmdRef, "OK|ERROR|+CME ERROR:"));
+            LE_ASSERT(LE_OK == le_atClient_SetTimeout(cmdRef, COMMAND_TIMEOUT));
+
+            LE_ASSERT(LE_OK == le_atClient_SendAsync(cmdRef,
+                                                     concatenate,
+                                                     CommandResultHandler,
+                                                     (void*)&PollCmds[i]));
+
+            // A command can not be sent again, or deleted, before it has completed
+            if ((0 == round) && (0 == i))
+            {
+                LE_ASSERT(LE_BUSY == le_atClient_SendAsync(cmdRef,
+                                                           concatenate,
+                                                           CommandResultHandler,
+                                                           (void*)&PollCmds[i]));
+                LE_ASSERT(LE_BUSY == le_atClient_Delete(cmdRef));
+            }
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Main of the test
+ */
+//--------------------------------------------------------------------------------------------------
+COMPONENT_INIT
+{
+    struct termios term;
+    int slaveFd;
+
+    LE_INFO("====== ATClient pipeline test Start ======");
+
+    if (le_arg_NumArgs() >= 1)
+    {
+        Rounds = strtoul(le_arg_GetArg(0), NULL, 10);
+        LE_ASSERT(Rounds > 0);
+    }
+    if (le_arg_NumArgs() >= 2)
+    {
+        LineDelayUs = strtoul(le_arg_GetArg(1), NULL, 10);
+    }
+
+    // The slave side must be raw, so that "\r" is not translated and nothing is echoed back.
+    LE_ASSERT(0 == openpty(&MasterFd, &slaveFd, NULL, NULL, NULL));
+    LE_ASSERT(0 == tcgetattr(slaveFd, &term));
+    cfmakeraw(&term);
+    LE_ASSERT(0 == tcsetattr(slaveFd, TCSANOW, &term));
+
+    le_thread_Start(le_thread_Create("FakeModem", ModemThread, NULL));
+
+    DevRef = le_atClient_Start(slaveFd);
+    LE_ASSERT(DevRef);
+
+    TestSync();
+    TestBulk();
+    TestLargeListing();
+
+    // The asynchronous modes complete in the completion handlers, called from the event loop.
+    StartAsync(false);
+}
@@ -0,0 +1,400 @@
+/**
+ * This module implements a replay benchmark of the AT Client unsolicited response matching.
+ *
+ * A captured AT transcript is written to the master side of a pseudo-terminal, whose slave side is
+ * handed to the AT Client as if it were the modem UART.  A few dozen unsolicited response handlers
+ * are subscribed, as a modem service would, and the number of times each one is called is checked
+ * against a naive reference matcher run on the same transcript.  The number of lines per second
+ * the AT Client sustains is then reported.
+ *
+ * Usage: atClientReplayBench [<transcript file> [<iterations>]]
+ *
+ * The transcript file holds one line per response, without the "\r\n" framing.  A built-in
+ * transcript is used if none is given.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+#include <pty.h>
+#include <termios.h>
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Default number of times the transcript is replayed
+ */
+//--------------------------------------------------------------------------------------------------
+#define DEFAULT_ITERATIONS 2000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Time allowed for the whole replay, in seconds
+ */
+//--------------------------------------------------------------------------------------------------
+#define REPLAY_TIMEOUT 120
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of lines in a transcript
+ */
+//--------------------------------------------------------------------------------------------------
+#define TRANSCRIPT_MAX_LINES 4096
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unsolicited response subscription
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const char* patternPtr;     ///< Unsolicited response prefix
+    uint32_t    lineCount;      ///< Number of lines of the unsolicited response
+    uint64_t    expected;       ///< Number of calls expected from the reference matcher
+    uint64_t    received;       ///< Number of calls of the handler
+}
+Subscription_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Subscriptions of a typical set of modem services
+ */
+//--------------------------------------------------------------------------------------------------
+static Subscription_t Subscriptions[] =
+{
+    { "+CREG:",     1 }, { "+CGREG:",    1 }, { "+CEREG:",    1 }, { "+C5GREG:",   1 },
+    { "+CSQ:",      1 }, { "+CESQ:",     1 }, { "+CIEV:",     1 }, { "+CMTI:",     1 },
+    { "+CMT:",      2 }, { "+CDS:",      2 }, { "+CBM:",      2 }, { "+CDSI:",     1 },
+    { "RING",       1 }, { "+CRING:",    1 }, { "+CLIP:",     1 }, { "+CCWA:",     1 },
+    { "NO CARRIER", 1 }, { "BUSY",       1 }, { "NO ANSWER",  1 }, { "+CUSD:",     1 },
+    { "+CGEV:",     1 }, { "+CTZV:",     1 }, { "+CTZE:",     1 }, { "+CTZDST:",   1 },
+    { "+WIND:",     1 }, { "^RSSI:",     1 }, { "^MODE:",     1 }, { "+QIND:",     1 },
+    { "+KSUP:",     1 }, { "+CPIN:",     1 }, { "+XCIEV:",    1 }, { "+PSUTTZ:",   1 },
+    { "+STKPCI:",   1 }, { "+CUSATP:",   1 }, { "+CSSI:",     1 }, { "+CSSU:",     1 },
+    { "+CCCM:",     1 }, { "+CEN1:",     1 }, { "+CEN2:",     1 }, { "+CNEMS1:",   1 },
+    { "+CNEMIU:",   1 }, { "+CMCCSI:",   1 }, { "+CREG:",     1 }, { "+CMTI:",     1 },
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Built-in transcript, captured from a module attached to an LTE network
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* BuiltInTranscript[] =
+{
+    "+CREG: 1,\"2F3C\",\"01A2B3C4\",7",
+    "+CGREG: 1,\"2F3C\",\"01A2B3C4\",7,\"01\"",
+    "+CEREG: 1,\"2F3C\",\"01A2B3C4\",7",
+    "+CSQ: 21,99",
+    "+CESQ: 99,99,255,255,22,55",
+    "+CIEV: 2,3",
+    "+CMTI: \"SM\",3",
+    "+CMT: ,24",
+    "07913366003001F0040B913366611568F600003190509095004004D4F29C0E",
+    "RING",
+    "+CLIP: \"+33612345678\",145,,,,0",
+    "NO CARRIER",
+    "+CUSD: 0,\"Balance: 12.50 EUR\",15",
+    "+CGEV: NW DETACH",
+    "+CGEV: ME PDN ACT 1",
+    "+CTZV: 19/10/20,14:32:10+08,0",
+    "+WIND: 4",
+    "^RSSI: 18",
+    "+QIND: \"csq\",21,99",
+    "+KSUP: 0",
+    "+CPIN: READY",
+    "+XCIEV: 4",
+    "+PSUTTZ: 2019,10,20,14,32,10,\"+08\",0",
+    "+STKPCI: 0,\"D0188103012500\"",
+    "+CDS: 25",
+    "07913366003001F006D70B913366611568F6319050909500403190509095004000",
+    "+CEREG: 5,\"2F3C\",\"01A2B3C5\",7",
+    "^MODE: 17,17",
+    "+KCELL: 1,\"20801\",\"2F3C\",\"01A2B3C4\",22",
+    "+CSSI: 1",
+    "+CREG: 0",
+    "+CSQ: 23,99",
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Transcript framed as the modem sends it, and its number of lines
+ */
+//--------------------------------------------------------------------------------------------------
+static char*  TranscriptPtr;
+static size_t TranscriptSize;
+static size_t TranscriptLines;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Replay parameters and state
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t     Iterations = DEFAULT_ITERATIONS;
+static uint64_t     ExpectedCalls;
+static uint64_t     ReceivedCalls;
+static int          MasterFd = -1;
+static le_sem_Ref_t DoneSem;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a line to the framed transcript
+ */
+//--------------------------------------------------------------------------------------------------
+static void AppendLine
+(
+    const char* linePtr,
+    size_t      len
+)
+{
+    if (0 == len)
+    {
+        return;
+    }
+
+    LE_ASSERT(len <= LE_ATDEFS_UNSOLICITED_MAX_LEN);
+    LE_ASSERT(TranscriptLines < TRANSCRIPT_MAX_LINES);
+
+    TranscriptPtr = realloc(TranscriptPtr, TranscriptSize + len + 4);
+    LE_ASSERT(TranscriptPtr);
+
+    memcpy(TranscriptPtr + TranscriptSize, "\r\n", 2);
+    memcpy(TranscriptPtr + TranscriptSize + 2, linePtr, len);
+    memcpy(TranscriptPtr + TranscriptSize + 2 + len, "\r\n", 2);
+    TranscriptSize += len + 4;
+    TranscriptLines++;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Load the transcript, from a file if one is given, or else from the built-in one
+ */
+//--------------------------------------------------------------------------------------------------
+static void LoadTranscript
+(
+    const char* pathPtr
+)
+{
+    size_t i;
+
+    if (NULL == pathPtr)
+    {
+        for (i = 0; i < NUM_ARRAY_MEMBERS(BuiltInTranscript); i++)
+        {
+            AppendLine(BuiltInTranscript[i], strlen(BuiltInTranscript[i]));
+        }
+        return;
+    }
+
+    FILE* filePtr = fopen(pathPtr, "r");
+    LE_FATAL_IF(NULL == filePtr, "Can't open '%s' (%m)", pathPtr);
+
+    char line[LE_ATDEFS_UNSOLICITED_MAX_BYTES + 2];
+
+    while (NULL != fgets(line, sizeof(line), filePtr))
+    {
+        size_t len = strcspn(line, "\r\n");
+
+        AppendLine(line, len);
+    }
+
+    fclose(filePtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Count the handler calls expected for one pass of the transcript, by testing every line against
+ * every subscription as the AT Client did before matching was compiled.  Returns how long it took.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_clk_Time_t ComputeExpectedCalls
+(
+    void
+)
+{
+    uint32_t pendingLines[NUM_ARRAY_MEMBERS(Subscriptions)] = {0};
+    le_clk_Time_t start = le_clk_GetRelativeTime();
+    const char* currentPtr = TranscriptPtr;
+    const char* endPtr = TranscriptPtr + TranscriptSize;
+    size_t i;
+
+    while (currentPtr < endPtr)
+    {
+        // Skip the leading "\r\n"; each line is followed by "\r\n".
+        const char* linePtr = currentPtr + 2;
+        size_t len = strstr(linePtr, "\r\n") - linePtr;
+
+        for (i = 0; i < NUM_ARRAY_MEMBERS(Subscriptions); i++)
+        {
+            Subscription_t* subPtr = &Subscriptions[i];
+
+            if ((pendingLines[i] > 0) ||
+                (0 == strncmp(linePtr, subPtr->patternPtr, strlen(subPtr->patternPtr))))
+            {
+                if (++pendingLines[i] == subPtr->lineCount)
+                {
+                    pendingLines[i] = 0;
+                    subPtr->expected++;
+                    ExpectedCalls++;
+                }
+            }
+        }
+
+        currentPtr = linePtr + len + 2;
+    }
+
+    return le_clk_Sub(le_clk_GetRelativeTime(), start);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unsolicited response handler: count the calls, and signal the end of the replay
+ */
+//--------------------------------------------------------------------------------------------------
+static void UnsolicitedHandler
+(
+    const char* unsolicitedRsp,
+    void*       contextPtr
+)
+{
+    Subscription_t* subPtr = contextPtr;
+
+    subPtr->received++;
+
+    if (++ReceivedCalls == ExpectedCalls)
+    {
+        le_sem_Post(DoneSem);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writer thread: replay the transcript on the master side of the pseudo-terminal
+ */
+//--------------------------------------------------------------------------------------------------
+static void* WriterThread
+(
+    void* contextPtr
+)
+{
+    uint32_t i;
+
+    for (i = 0; i < Iterations; i++)
+    {
+        size_t offset = 0;
+
+        while (offset < TranscriptSize)
+        {
+            ssize_t count = write(MasterFd, TranscriptPtr + offset, TranscriptSize - offset);
+
+            if (count < 0)
+            {
+                LE_FATAL_IF(EINTR != errno, "write failed (%m)");
+                continue;
+            }
+            offset += count;
+        }
+    }
+
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Main of the test
+ */
+//--------------------------------------------------------------------------------------------------
+COMPONENT_INIT
+{
+    const char* pathPtr = NULL;
+    struct termios term;
+    int slaveFd;
+    size_t i;
+
+    LE_INFO("====== ATClient replay benchmark Start ======");
+
+    if (le_arg_NumArgs() >= 1)
+    {
+        pathPtr = le_arg_GetArg(0);
+    }
+    if (le_arg_NumArgs() >= 2)
+    {
+        Iterations = strtoul(le_arg_GetArg(1), NULL, 10);
+        LE_ASSERT(Iterations > 0);
+    }
+
+    LoadTranscript(pathPtr);
+    LE_ASSERT(TranscriptLines > 0);
+
+    le_clk_Time_t naiveTime = ComputeExpectedCalls();
+    LE_ASSERT(ExpectedCalls > 0);
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(Subscriptions); i++)
+    {
+        Subscriptions[i].expected *= Iterations;
+    }
+    ExpectedCalls *= Iterations;
+
+    // The slave side must be raw, so that "\r" is not translated and nothing is echoed back.
+    LE_ASSERT(0 == openpty(&MasterFd, &slaveFd, NULL, NULL, NULL));
+    LE_ASSERT(0 == tcgetattr(slaveFd, &term));
+    cfmakeraw(&term);
+    LE_ASSERT(0 == tcsetattr(slaveFd, TCSANOW, &term));
+
+    le_atClient_DeviceRef_t devRef = le_atClient_Start(slaveFd);
+    LE_ASSERT(devRef);
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(Subscriptions); i++)
+    {
+        LE_ASSERT(NULL != le_atClient_AddUnsolicitedResponseHandler(Subscriptions[i].patternPtr,
+                                                                   devRef,
+                                                                   UnsolicitedHandler,
+                                                                   &Subscriptions[i],
+                                                                   Subscriptions[i].lineCount));
+    }
+
+    DoneSem = le_sem_Create("ReplayDoneSem", 0);
+
+    le_clk_Time_t start = le_clk_GetRelativeTime();
+
+    le_thread_Ref_t writerThread = le_thread_Create("ReplayWriter", WriterThread, NULL);
+    le_thread_SetJoinable(writerThread);
+    le_thread_Start(writerThread);
+
+    le_clk_Time_t timeout = { REPLAY_TIMEOUT, 0 };
+    le_result_t result = le_sem_WaitWithTimeOut(DoneSem, timeout);
+
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), start);
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(Subscriptions); i++)
+    {
+        LE_ERROR_IF(Subscriptions[i].received != Subscriptions[i].expected,
+                    "'%s': %"PRIu64" calls, %"PRIu64" expected",
+                    Subscriptions[i].patternPtr,
+                    Subscriptions[i].received,
+                    Subscriptions[i].expected);
+    }
+    LE_ASSERT(LE_OK == result);
+
+    le_thread_Join(writerThread, NULL);
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(Subscriptions); i++)
+    {
+        LE_ASSERT(Subscriptions[i].received == Subscriptions[i].expected);
+    }
+
+    double lines = (double)TranscriptLines * Iterations;
+    double seconds = elapsed.sec + elapsed.usec / 1e6;
+    double naiveUsec = (naiveTime.sec * 1e6 + naiveTime.usec) / TranscriptLines;
+
+    LE_INFO("Replayed %.0f lines (%"PRIu64" handler calls, %zu subscriptions) in %.3f s:"
+            " %.0f lines/s",
+            lines, ExpectedCalls, NUM_ARRAY_MEMBERS(Subscriptions), seconds, lines / seconds);
+    LE_INFO("Reference matcher: %.3f us/line", naiveUsec);
+
+    LE_INFO("====== ATClient replay benchmark PASSED ======");
+
+    exit(EXIT_SUCCESS);
+}
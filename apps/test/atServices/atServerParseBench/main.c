@@ -0,0 +1,460 @@
+/**
+ * This module implements the throughput test of the AT Server command parser.
+ *
+ * A scripted AT session is written at full speed on the master side of a pseudo-terminal, whose
+ * slave side is opened by the AT Server, while the responses are read back.  A few hundred
+ * commands are registered, so that commands are looked up among a realistic number of names, and
+ * the session mixes basic, extended, concatenated, parameter and dial commands.
+ *
+ * The command handlers read back every parameter and answer OK, or ERROR if a parameter differs
+ * from the expected one.  The number of command lines and commands per second are reported.
+ *
+ * Then, a listing command answering a few hundred intermediate responses is sent several times on
+ * a second device, a SOCK_SEQPACKET socket on which every write of the AT Server is received as
+ * one packet.  The number of writes and the latency per command are reported.
+ *
+ * Usage: atServerParseBench [<rounds>]
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+#include <pty.h>
+#include <termios.h>
+#include <sys/socket.h>
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Default number of times the script is sent
+ */
+//--------------------------------------------------------------------------------------------------
+#define DEFAULT_ROUNDS 2000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of registered commands which are never received
+ */
+//--------------------------------------------------------------------------------------------------
+#define FILLER_CMDS 200
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of parameters of a benchmark command
+ */
+//--------------------------------------------------------------------------------------------------
+#define PARAM_MAX 4
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of intermediate responses of the listing command
+ */
+//--------------------------------------------------------------------------------------------------
+#define LIST_LINES 400
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of times the listing command is sent
+ */
+//--------------------------------------------------------------------------------------------------
+#define LIST_ROUNDS 20
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Benchmark command, and the parameters it is expected to receive
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const char* namePtr;                ///< Command name
+    const char* paramPtr[PARAM_MAX];    ///< Expected parameters
+}
+BenchCmd_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Benchmark commands
+ */
+//--------------------------------------------------------------------------------------------------
+static const BenchCmd_t BenchCmds[] =
+{
+    { "AT+CSQ",   { NULL } },
+    { "AT+CREG",  { NULL } },
+    { "AT+CGREG", { NULL } },
+    { "AT+COPS",  { "0", "0", "Orange F", "7" } },
+    { "AT+CMGS",  { "+33612345678", "145" } },
+    { "ATE",      { "0" } },
+    { "ATV",      { "1" } },
+    { "ATD",      { "+33612345678;" } },
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Script line, and the number of commands it holds
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const char* linePtr;    ///< Command line
+    uint32_t    cmdCount;   ///< Number of commands
+}
+ScriptLine_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Script of the session
+ */
+//--------------------------------------------------------------------------------------------------
+static const ScriptLine_t Script[] =
+{
+    { "AT+CSQ\r",                       1 },
+    { "AT+CREG?\r",                     1 },
+    { "at+cops=0,0,\"Orange F\",7\r",   1 },
+    { "ATE0V1\r",                       2 },
+    { "AT+CSQ;+CREG?;+CGREG?\r",        3 },
+    { "AT+CMGS=\"+33612345678\",145\r", 1 },
+    { "ATD+33612345678;\r",             1 },
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test parameters and state
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t         Rounds = DEFAULT_ROUNDS;
+static int              MasterFd = -1;
+static int              ListFd = -1;
+static le_thread_Ref_t  MainThread;
+static uint32_t         HandledCmds;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Command handler: check the parameters and send the final result code
+ */
+//--------------------------------------------------------------------------------------------------
+static void CmdHandler
+(
+    le_atServer_CmdRef_t commandRef,
+    le_atServer_Type_t type,
+    uint32_t parametersNumber,
+    void* contextPtr
+)
+{
+    const BenchCmd_t* cmdPtr = contextPtr;
+    le_atServer_FinalRsp_t final = LE_ATSERVER_OK;
+    char param[LE_ATDEFS_PARAMETER_MAX_BYTES];
+    uint32_t i;
+
+    HandledCmds++;
+
+    for (i = 0; i < parametersNumber; i++)
+    {
+        if ((i >= PARAM_MAX) ||
+            (NULL == cmdPtr->paramPtr[i]) ||
+            (LE_OK != le_atServer_GetParameter(commandRef, i, param, sizeof(param))) ||
+            (0 != strcmp(param, cmdPtr->paramPtr[i])))
+        {
+            LE_ERROR("%s: unexpected parameter %"PRIu32, cmdPtr->namePtr, i);
+            final = LE_ATSERVER_ERROR;
+            break;
+        }
+    }
+
+    if ((LE_ATSERVER_OK == final) && (i < PARAM_MAX) && (cmdPtr->paramPtr[i]))
+    {
+        LE_ERROR("%s: missing parameter %"PRIu32, cmdPtr->namePtr, i);
+        final = LE_ATSERVER_ERROR;
+    }
+
+    LE_ASSERT_OK(le_atServer_SendFinalResultCode(commandRef, final, "", 0));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Listing command handler: send the intermediate responses and the final result code
+ */
+//--------------------------------------------------------------------------------------------------
+static void ListHandler
+(
+    le_atServer_CmdRef_t commandRef,
+    le_atServer_Type_t type,
+    uint32_t parametersNumber,
+    void* contextPtr
+)
+{
+    char rsp[LE_ATDEFS_RESPONSE_MAX_BYTES];
+    uint32_t i;
+
+    for (i = 0; i < LIST_LINES; i++)
+    {
+        snprintf(rsp, sizeof(rsp),
+                 "+CMGL: %"PRIu32",\"REC READ\",\"+33612345678\",,\"26/10/19,12:00:00+08\"", i);
+        LE_ASSERT_OK(le_atServer_SendIntermediateResponse(commandRef, rsp));
+    }
+
+    LE_ASSERT_OK(le_atServer_SendFinalResultCode(commandRef, LE_ATSERVER_OK, "", 0));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send the listing command on the second device, and measure the writes and latency per command
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunListing
+(
+    void
+)
+{
+    static const char cmd[] = "AT+CMGL=4\r";
+    static const char final[] = "\r\nOK\r\n";
+    char packet[64 * 1024];
+    uint32_t writes = 0;
+    uint32_t lines = 0;
+    uint32_t round;
+
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+
+    for (round = 0; round < LIST_ROUNDS; round++)
+    {
+        bool done = false;
+
+        LE_ASSERT(sizeof(cmd) - 1 == write(ListFd, cmd, sizeof(cmd) - 1));
+
+        while (!done)
+        {
+            ssize_t count = recv(ListFd, packet, sizeof(packet), 0);
+            ssize_t n;
+
+            if (count < 0)
+            {
+                LE_FATAL_IF(EINTR != errno, "recv failed (%m)");
+                continue;
+            }
+            LE_ASSERT(count > 0);
+
+            writes++;
+            for (n = 0; n < count; n++)
+            {
+                if ('\n' == packet[n])
+                {
+                    lines++;
+                }
+            }
+
+            done = (count >= (ssize_t)(sizeof(final) - 1)) &&
+                   (0 == memcmp(packet + count - (sizeof(final) - 1), final, sizeof(final) - 1));
+        }
+    }
+
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+    double ms = elapsed.sec * 1000.0 + elapsed.usec / 1000.0;
+
+    // Each response but the first intermediate one ends with one line feed, and the final result
+    // code and first intermediate response start with an extra one.
+    LE_ASSERT(lines == LIST_ROUNDS * (LIST_LINES + 3));
+
+    LE_INFO("Listing of %d lines: %.1f writes/command, %.3f ms/command",
+            LIST_LINES, (double)writes / LIST_ROUNDS, ms / LIST_ROUNDS);
+
+    // The responses are written by blocks, not line by line
+    LE_ASSERT(writes * 10 < LIST_ROUNDS * LIST_LINES);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check the number of handled commands, and exit.  Called on the AT Server thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckAndExit
+(
+    void* param1Ptr,
+    void* param2Ptr
+)
+{
+    uint32_t expectedCmds = (uint32_t)(uintptr_t)param1Ptr;
+
+    LE_INFO("%"PRIu32" commands handled, %"PRIu32" expected", HandledCmds, expectedCmds);
+    LE_ASSERT(HandledCmds == expectedCmds);
+
+    LE_INFO("====== ATServer parse bench PASSED ======");
+    exit(EXIT_SUCCESS);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Host thread: write the script on the master side of the pseudo-terminal while reading the
+ * final result codes
+ */
+//--------------------------------------------------------------------------------------------------
+static void* HostThread
+(
+    void* contextPtr
+)
+{
+    size_t scriptLen = 0;
+    uint32_t cmdCount = 0;
+    uint32_t round;
+    size_t i;
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(Script); i++)
+    {
+        scriptLen += strlen(Script[i].linePtr);
+        cmdCount += Script[i].cmdCount;
+    }
+
+    char* bufPtr = malloc(scriptLen * Rounds);
+    LE_ASSERT(bufPtr);
+
+    char* writePtr = bufPtr;
+    for (round = 0; round < Rounds; round++)
+    {
+        for (i = 0; i < NUM_ARRAY_MEMBERS(Script); i++)
+        {
+            size_t len = strlen(Script[i].linePtr);
+            memcpy(writePtr, Script[i].linePtr, len);
+            writePtr += len;
+        }
+    }
+
+    char* endPtr = writePtr;
+    uint32_t expectedLines = Rounds * NUM_ARRAY_MEMBERS(Script);
+    uint32_t okCount = 0;
+    uint32_t errorCount = 0;
+    char line[LE_ATDEFS_RESPONSE_MAX_BYTES];
+    size_t lineLen = 0;
+
+    writePtr = bufPtr;
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+
+    while ((okCount + errorCount) < expectedLines)
+    {
+        struct pollfd pfd = { .fd = MasterFd, .events = POLLIN };
+        char rsp[1024];
+
+        if (writePtr < endPtr)
+        {
+            pfd.events |= POLLOUT;
+        }
+
+        if (poll(&pfd, 1, -1) < 0)
+        {
+            LE_FATAL_IF(EINTR != errno, "poll failed (%m)");
+            continue;
+        }
+
+        if (pfd.revents & POLLOUT)
+        {
+            ssize_t count = write(MasterFd, writePtr, endPtr - writePtr);
+            if (count > 0)
+            {
+                writePtr += count;
+            }
+        }
+
+        if (pfd.revents & POLLIN)
+        {
+            ssize_t count = read(MasterFd, rsp, sizeof(rsp));
+            ssize_t n;
+
+            for (n = 0; n < count; n++)
+            {
+                if ('\n' != rsp[n])
+                {
+                    if (('\r' != rsp[n]) && (lineLen < sizeof(line) - 1))
+                    {
+                        line[lineLen++] = rsp[n];
+                    }
+                    continue;
+                }
+
+                line[lineLen] = '\0';
+                if (0 == strcmp(line, "OK"))
+                {
+                    okCount++;
+                }
+                else if (0 == strcmp(line, "ERROR"))
+                {
+                    errorCount++;
+                }
+                lineLen = 0;
+            }
+        }
+    }
+
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+    double seconds = elapsed.sec + elapsed.usec / 1000000.0;
+
+    LE_INFO("%"PRIu32" command lines, %"PRIu32" commands in %.3f s: "
+            "%.0f lines/s, %.0f commands/s",
+            expectedLines, cmdCount * Rounds, seconds,
+            expectedLines / seconds, (cmdCount * Rounds) / seconds);
+
+    LE_ASSERT(0 == errorCount);
+    free(bufPtr);
+
+    RunListing();
+
+    le_event_QueueFunctionToThread(MainThread, CheckAndExit,
+                                   (void*)(uintptr_t)(cmdCount * Rounds), NULL);
+
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Main of the test
+ */
+//--------------------------------------------------------------------------------------------------
+COMPONENT_INIT
+{
+    struct termios term;
+    int slaveFd;
+    uint32_t i;
+
+    LE_INFO("====== ATServer parse bench Start ======");
+
+    if (le_arg_NumArgs() >= 1)
+    {
+        Rounds = strtoul(le_arg_GetArg(0), NULL, 10);
+        LE_ASSERT(Rounds > 0);
+    }
+
+    MainThread = le_thread_GetCurrent();
+
+    // The slave side must be raw, so that "\r" is not translated and nothing is echoed back.
+    LE_ASSERT(0 == openpty(&MasterFd, &slaveFd, NULL, NULL, NULL));
+    LE_ASSERT(0 == tcgetattr(slaveFd, &term));
+    cfmakeraw(&term);
+    LE_ASSERT(0 == tcsetattr(slaveFd, TCSANOW, &term));
+
+    LE_ASSERT(le_atServer_Open(slaveFd));
+
+    // Every write of the AT Server is received as one packet on the host side.
+    int listFds[2];
+    LE_ASSERT(0 == socketpair(AF_UNIX, SOCK_SEQPACKET, 0, listFds));
+    ListFd = listFds[0];
+    LE_ASSERT(le_atServer_Open(listFds[1]));
+
+    for (i = 0; i < FILLER_CMDS; i++)
+    {
+        char name[LE_ATDEFS_COMMAND_MAX_BYTES];
+
+        snprintf(name, sizeof(name), "AT+XF%03"PRIu32, i);
+        LE_ASSERT(le_atServer_Create(name));
+    }
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(BenchCmds); i++)
+    {
+        le_atServer_CmdRef_t cmdRef = le_atServer_Create(BenchCmds[i].namePtr);
+
+        LE_ASSERT(cmdRef);
+        LE_ASSERT(le_atServer_AddCommandHandler(cmdRef, CmdHandler, (void*)&BenchCmds[i]));
+    }
+
+    le_atServer_CmdRef_t listRef = le_atServer_Create("AT+CMGL");
+    LE_ASSERT(listRef);
+    LE_ASSERT(le_atServer_AddCommandHandler(listRef, ListHandler, NULL));
+
+    le_thread_Start(le_thread_Create("AtHost", HostThread, NULL));
+}
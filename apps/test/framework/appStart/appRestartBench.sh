@@ -0,0 +1,81 @@
+#!/bin/bash
+
+# Restart benchmark for the Supervisor's cache of app runtime areas.
+#
+# Installs a sandboxed app with a couple of hundred required files, starts it once with an empty
+# cache (right after the install) and then restarts it a number of times.  Reports the time
+# app_Start() took for the first start and on average for the restarts, as measured by the
+# Supervisor ("app startTimes").
+#
+# Usage: appRestartBench.sh <targetAddr> [<targetType>] [<maxRestartMs>]
+
+LoadTestLib
+
+targetAddr=$1
+targetType=${2:-ar7}
+maxRestartMs=$3
+
+OnFail() {
+    echo "App Restart Benchmark Failed!"
+}
+
+appName=restartBench
+restartCount=10
+
+if [ "$LEGATO_ROOT" == "" ]
+then
+    if [ "$WORKSPACE" == "" ]
+    then
+        echo "Neither LEGATO_ROOT nor WORKSPACE are defined." >&2
+        exit 1
+    else
+        LEGATO_ROOT="$WORKSPACE"
+    fi
+fi
+
+# Prints the time the last start of the app spent in app_Start() (the LAUNCH column).
+GetLaunchMs() {
+    ssh root@$targetAddr "$BIN_PATH/app startTimes $appName" | awk -v app=$appName '$1 == app { print $4 }'
+}
+
+echo "******** App Restart Benchmark Starting ***********"
+
+echo "Make sure Legato is running."
+ssh root@$targetAddr "$BIN_PATH/legato start"
+CheckRet
+
+echo "Install the app."
+appDir="$LEGATO_ROOT/build/$targetType/tests/apps"
+cd "$appDir"
+CheckRet
+InstallApp $appName
+
+echo "Start the app with an empty cache."
+ssh root@$targetAddr "$BIN_PATH/app start $appName"
+CheckRet
+firstMs=$(GetLaunchMs)
+
+echo "Restart the app $restartCount times."
+restartTotalMs=0
+for i in $(seq 1 $restartCount)
+do
+    ssh root@$targetAddr "$BIN_PATH/app restart $appName"
+    CheckRet
+    restartTotalMs=$((restartTotalMs + $(GetLaunchMs)))
+done
+restartMs=$((restartTotalMs / restartCount))
+
+echo "First start took $firstMs ms, restarts took $restartMs ms on average."
+
+echo "Remove the app."
+ssh root@$targetAddr "$BIN_PATH/app remove $appName"
+
+if [ -n "$maxRestartMs" ] && [ "$restartMs" -gt "$maxRestartMs" ]
+then
+    echo "Restarting the app took more than $maxRestartMs ms."
+    OnFail
+    exit 1
+fi
+
+echo "App Restart Benchmark Passed!"
+exit 0
@@ -0,0 +1,102 @@
+#!/bin/bash
+
+# Boot benchmark for the Supervisor's app auto-start.
+#
+# Installs 50 synthetic apps (5 servers, 45 clients bound to them), restarts Legato and reports how
+# long it took from the start of app auto-start until the last app was launched, as measured by the
+# Supervisor ("app startTimes").  Build the system with SUPERV_APP_START_THREADS set to 0 to get
+# the one-app-at-a-time baseline.
+#
+# Usage: appStartBench.sh <targetAddr> [<targetType>] [<maxTotalMs>]
+
+LoadTestLib
+
+targetAddr=$1
+targetType=${2:-ar7}
+maxTotalMs=$3
+
+OnFail() {
+    echo "App Start Benchmark Failed!"
+}
+
+appCount=50
+
+appsList=""
+for i in $(seq 0 $((appCount - 1)))
+do
+    appsList="$appsList $(printf "startBench%02d" $i)"
+done
+
+if [ "$LEGATO_ROOT" == "" ]
+then
+    if [ "$WORKSPACE" == "" ]
+    then
+        echo "Neither LEGATO_ROOT nor WORKSPACE are defined." >&2
+        exit 1
+    else
+        LEGATO_ROOT="$WORKSPACE"
+    fi
+fi
+
+echo "******** App Start Benchmark Starting ***********"
+
+echo "Make sure Legato is running."
+ssh root@$targetAddr "$BIN_PATH/legato start"
+CheckRet
+
+echo "Install all the apps."
+appDir="$LEGATO_ROOT/build/$targetType/tests/apps"
+cd "$appDir"
+CheckRet
+for app in $appsList
+do
+    InstallApp ${app}
+done
+
+echo "Restart Legato to auto-start the apps."
+ssh root@$targetAddr "$BIN_PATH/legato restart"
+CheckRet
+
+echo "Wait for all the apps to run."
+for i in $(seq 1 60)
+do
+    running=$(ssh root@$targetAddr "$BIN_PATH/app status" | grep -c "^\[running\] startBench")
+    if [ "$running" -eq "$appCount" ]
+    then
+        break
+    fi
+    sleep 1
+done
+
+if [ "$running" -ne "$appCount" ]
+then
+    echo "Only $running of $appCount apps are running."
+    OnFail
+    exit 1
+fi
+
+ssh root@$targetAddr "$BIN_PATH/app startTimes" | grep "APP\|startBench" > /tmp/appStartBench.txt
+cat /tmp/appStartBench.txt
+
+# The last column is the time from the start of auto-start until the app was launched.
+lastMs=$(awk '/^startBench/ { if ($5 > max) max = $5 } END { print max + 0 }' /tmp/appStartBench.txt)
+sandboxMs=$(awk '/^startBench/ { sum += $3 } END { print sum + 0 }' /tmp/appStartBench.txt)
+
+echo "All $appCount apps launched $lastMs ms after auto-start began" \
+     "($sandboxMs ms of sandbox set-up done on helper threads)."
+
+echo "Remove all the apps."
+for app in $appsList
+do
+    ssh root@$targetAddr "$BIN_PATH/app remove $app"
+done
+
+if [ -n "$maxTotalMs" ] && [ "$lastMs" -gt "$maxTotalMs" ]
+then
+    echo "Boot to all apps running took more than $maxTotalMs ms."
+    OnFail
+    exit 1
+fi
+
+echo "App Start Benchmark Passed!"
+exit 0
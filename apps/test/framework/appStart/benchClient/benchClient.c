@@ -0,0 +1,20 @@
+//--------------------------------------------------------------------------------------------------
+/** @file benchClient.c
+ *
+ * Client side of the synthetic apps used by the app auto-start benchmark.  Connects to its server
+ * app and then stays idle.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "interfaces.h"
+
+
+COMPONENT_INIT
+{
+    startBench_Ping();
+
+    LE_INFO("======== Bench client '%s' started ========", le_arg_GetProgramName());
+}
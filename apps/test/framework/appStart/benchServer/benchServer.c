@@ -0,0 +1,31 @@
+//--------------------------------------------------------------------------------------------------
+/** @file benchServer.c
+ *
+ * Server side of the synthetic apps used by the app auto-start benchmark.  Other benchmark apps
+ * are bound to it, so the Supervisor must launch it before them.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "interfaces.h"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks that the server app is up.
+ */
+//--------------------------------------------------------------------------------------------------
+void startBench_Ping
+(
+    void
+)
+{
+}
+
+
+COMPONENT_INIT
+{
+    LE_INFO("======== Bench server '%s' started ========", le_arg_GetProgramName());
+}
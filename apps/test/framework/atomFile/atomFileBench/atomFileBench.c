@@ -0,0 +1,232 @@
+//--------------------------------------------------------------------------------------------------
+/** @file atomFileBench.c
+ *
+ * Micro-benchmark of small atomic file updates, like the ones made by services that keep their
+ * state in small files.  Reports how many updates per second are done:
+ *
+ *  - by modifying a file in place (le_atomFile_Open(), which copies the file first),
+ *  - by rewriting a whole file (le_atomFile_Create() with LE_FLOCK_REPLACE_IF_EXIST),
+ *  - by rewriting a whole file from several threads, each one updating its own file.
+ *
+ * Usage: atomFileBench [directory]   (default is /tmp)
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include <sys/uio.h>
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of updates made by each test (and by each thread of the multi-thread test).
+ */
+//--------------------------------------------------------------------------------------------------
+#define UPDATE_COUNT        200
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of threads of the multi-thread test.
+ */
+//--------------------------------------------------------------------------------------------------
+#define THREAD_COUNT        4
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the files updated, in bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+#define FILE_BYTES          2048
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Directory the files are created in.
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* DirPath = "/tmp";
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Content written to the files.  Filled before any test starts, and only read afterwards, as it is
+ * shared by the threads of the multi-thread test.
+ */
+//--------------------------------------------------------------------------------------------------
+static char Content[FILE_BYTES];
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the path of the file used by a test.
+ */
+//--------------------------------------------------------------------------------------------------
+static void GetTestFilePath
+(
+    int index,                  ///< [IN] Index of the file.
+    char* bufferPtr,            ///< [OUT] Path.
+    size_t bufferSize           ///< [IN] Size of the path buffer.
+)
+{
+    int length = snprintf(bufferPtr, bufferSize, "%s/atomFileBench%d", DirPath, index);
+
+    LE_FATAL_IF((length < 0) || ((size_t)length >= bufferSize),
+                "Path of test file %d in '%s' is too long.", index, DirPath);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Change a few bytes in the middle of a file, keeping the rest of it.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ModifyFile
+(
+    const char* pathPtr,        ///< [IN] Path of the file.
+    int count                   ///< [IN] Update number.
+)
+{
+    int fd = le_atomFile_Open(pathPtr, LE_FLOCK_READ_AND_WRITE);
+    LE_FATAL_IF(fd < 0, "Failed to open '%s' (%s).", pathPtr, LE_RESULT_TXT(fd));
+
+    LE_FATAL_IF(pwrite(fd, &count, sizeof(count), FILE_BYTES / 2) != sizeof(count),
+                "Failed to write '%s' (%m).", pathPtr);
+
+    LE_FATAL_IF(le_atomFile_Close(fd) != LE_OK, "Failed to commit '%s'.", pathPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Rewrite a whole file: the update number followed by the rest of the content.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RewriteFile
+(
+    const char* pathPtr,        ///< [IN] Path of the file.
+    int count                   ///< [IN] Update number.
+)
+{
+    int fd = le_atomFile_Create(pathPtr, LE_FLOCK_WRITE, LE_FLOCK_REPLACE_IF_EXIST,
+                                S_IRUSR | S_IWUSR);
+    LE_FATAL_IF(fd < 0, "Failed to create '%s' (%s).", pathPtr, LE_RESULT_TXT(fd));
+
+    struct iovec iov[] =
+    {
+        { .iov_base = &count, .iov_len = sizeof(count) },
+        { .iov_base = Content + sizeof(count), .iov_len = sizeof(Content) - sizeof(count) },
+    };
+
+    LE_FATAL_IF(writev(fd, iov, NUM_ARRAY_MEMBERS(iov)) != sizeof(Content),
+                "Failed to write '%s' (%m).", pathPtr);
+
+    LE_FATAL_IF(le_atomFile_Close(fd) != LE_OK, "Failed to commit '%s'.", pathPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Rewrite one file over and over.  Thread main function of the multi-thread test.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* RewriteThreadMain
+(
+    void* contextPtr            ///< [IN] Index of the file.
+)
+{
+    char path[PATH_MAX];
+    int i;
+
+    GetTestFilePath((intptr_t)contextPtr, path, sizeof(path));
+
+    for (i = 0; i < UPDATE_COUNT; i++)
+    {
+        RewriteFile(path, i);
+    }
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Report the rate of a test.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Report
+(
+    const char* testNamePtr,    ///< [IN] Name of the test.
+    int updateCount,            ///< [IN] Number of updates made.
+    le_clk_Time_t startTime     ///< [IN] Time the test started at.
+)
+{
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+    uint64_t elapsedUsec = (uint64_t)elapsed.sec * 1000000 + elapsed.usec;
+
+    LE_INFO("%s: %d updates in %" PRIu64 " ms, %" PRIu64 " updates/s.",
+            testNamePtr,
+            updateCount,
+            elapsedUsec / 1000,
+            elapsedUsec ? (uint64_t)updateCount * 1000000 / elapsedUsec : 0);
+}
+
+
+COMPONENT_INIT
+{
+    char path[PATH_MAX];
+    le_clk_Time_t startTime;
+    int i;
+
+    if (le_arg_NumArgs() > 0)
+    {
+        DirPath = le_arg_GetArg(0);
+    }
+
+    LE_INFO("======== Starting Atomic File Benchmark in '%s' ========", DirPath);
+
+    memset(Content, 'x', sizeof(Content));
+    GetTestFilePath(0, path, sizeof(path));
+    RewriteFile(path, 0);
+
+    startTime = le_clk_GetRelativeTime();
+    for (i = 0; i < UPDATE_COUNT; i++)
+    {
+        ModifyFile(path, i);
+    }
+    Report("Modify in place", UPDATE_COUNT, startTime);
+
+    startTime = le_clk_GetRelativeTime();
+    for (i = 0; i < UPDATE_COUNT; i++)
+    {
+        RewriteFile(path, i);
+    }
+    Report("Rewrite whole file", UPDATE_COUNT, startTime);
+
+    le_thread_Ref_t threads[THREAD_COUNT];
+
+    startTime = le_clk_GetRelativeTime();
+    for (i = 0; i < THREAD_COUNT; i++)
+    {
+        threads[i] = le_thread_Create("atomFileBench", RewriteThreadMain, (void*)(intptr_t)i);
+        le_thread_SetJoinable(threads[i]);
+        le_thread_Start(threads[i]);
+    }
+    for (i = 0; i < THREAD_COUNT; i++)
+    {
+        LE_ASSERT(le_thread_Join(threads[i], NULL) == LE_OK);
+    }
+    Report("Rewrite from " STRINGIZE(THREAD_COUNT) " threads", THREAD_COUNT * UPDATE_COUNT,
+           startTime);
+
+    for (i = 0; i < THREAD_COUNT; i++)
+    {
+        GetTestFilePath(i, path, sizeof(path));
+        le_atomFile_Delete(path);
+    }
+
+    LE_INFO("======== Atomic File Benchmark Done ========");
+    exit(EXIT_SUCCESS);
+}
@@ -112,6 +112,126 @@ static void TestString(void)
     CheckString("", 512, 12, true); // Empty
 }
 
+#ifndef LE_CONFIG_RPC
+/** Varint **/
+
+static void CheckVarUint64(uint64_t value, size_t expectedSz)
+{
+    uint8_t buffer[BUFFER_SZ];
+    uint8_t* bufferPtr = buffer;
+
+    ResetBuffer(bufferPtr, sizeof(buffer));
+
+    // Pack
+    LE_TEST(le_pack_PackVarUint64(&bufferPtr, value));
+    LE_TEST((size_t)(bufferPtr - buffer) == expectedSz);
+    LE_TEST(bufferPtr[0] == CHECK_CHAR);
+
+    // Unpack
+    uint64_t valueOut = 0;
+    bufferPtr = buffer;
+    LE_TEST(le_pack_UnpackVarUint64(&bufferPtr, &valueOut));
+    LE_TEST((size_t)(bufferPtr - buffer) == expectedSz);
+
+    LE_TEST(valueOut == value);
+}
+
+static void CheckVarInt32(int32_t value, size_t expectedSz)
+{
+    uint8_t buffer[BUFFER_SZ];
+    uint8_t* bufferPtr = buffer;
+
+    ResetBuffer(bufferPtr, sizeof(buffer));
+
+    // Pack
+    LE_TEST(le_pack_PackVarInt32(&bufferPtr, value));
+    LE_TEST((size_t)(bufferPtr - buffer) == expectedSz);
+
+    // Unpack
+    int32_t valueOut = 0;
+    bufferPtr = buffer;
+    LE_TEST(le_pack_UnpackVarInt32(&bufferPtr, &valueOut));
+
+    LE_TEST(valueOut == value);
+}
+
+static void TestVarint(void)
+{
+    printf("=> varint\n");
+    CheckVarUint64(0, 1);
+    CheckVarUint64(0x7F, 1);
+    CheckVarUint64(0x80, 2);
+    CheckVarUint64(0x3FFF, 2);
+    CheckVarUint64(UINT32_MAX, LE_PACK_VARUINT32_MAX_SIZE);
+    CheckVarUint64(UINT64_MAX, LE_PACK_VARUINT64_MAX_SIZE);
+
+    CheckVarInt32(0, 1);
+    CheckVarInt32(-1, 1);
+    CheckVarInt32(LE_FAULT, 1);
+    CheckVarInt32(63, 1);
+    CheckVarInt32(-64, 1);
+    CheckVarInt32(64, 2);
+    CheckVarInt32(INT32_MAX, LE_PACK_VARUINT32_MAX_SIZE);
+    CheckVarInt32(INT32_MIN, LE_PACK_VARUINT32_MAX_SIZE);
+
+    // Overlong and out of range encodings must be rejected.
+    uint8_t overlong[LE_PACK_VARUINT64_MAX_SIZE + 1];
+    uint8_t* bufferPtr = overlong;
+    uint64_t value64;
+    uint32_t value32;
+    memset(overlong, 0xFF, sizeof(overlong));
+    LE_TEST(!le_pack_UnpackVarUint64(&bufferPtr, &value64));
+
+    uint8_t tooBig[] = { 0xFF, 0xFF, 0xFF, 0xFF, 0x1F };
+    bufferPtr = tooBig;
+    LE_TEST(!le_pack_UnpackVarUint32(&bufferPtr, &value32));
+    LE_TEST(bufferPtr == tooBig);
+}
+
+static void CheckVarString
+(
+    const char* stringPtr,      ///< Test string
+    uint32_t maxStringCount,    ///< Max string size
+    bool expectedRes            ///< Expected result
+)
+{
+    uint8_t buffer[BUFFER_SZ];
+    uint8_t* bufferPtr = buffer;
+    size_t stringLen = strnlen(stringPtr, BUFFER_SZ);
+    char valueOut[BUFFER_SZ];
+
+    ResetBuffer(bufferPtr, sizeof(buffer));
+
+    printf("'%s' - [%zd] maxString[%d]:\n", stringPtr, stringLen, maxStringCount);
+
+    LE_TEST(expectedRes == le_pack_PackVarString(&bufferPtr, stringPtr, maxStringCount));
+    if (!expectedRes)
+    {
+        printf("   [passed]\n");
+        return;
+    }
+
+    // Short strings only need a single byte of length prefix.
+    LE_TEST((size_t)(bufferPtr - buffer) == stringLen + 1);
+
+    bufferPtr = buffer;
+    LE_TEST(le_pack_UnpackVarString(&bufferPtr, valueOut, sizeof(valueOut), maxStringCount));
+    LE_TEST(0 == strcmp(stringPtr, valueOut));
+
+    printf("   [passed]\n");
+}
+
+static void TestVarString(void)
+{
+    printf("=> varstring\n");
+
+    CheckVarString("normal", 128, true);
+    CheckVarString("buffertooshort", 10, false);
+    CheckVarString("bufferexactlen", 14, true);
+    CheckVarString("", 12, true); // Empty
+}
+#endif
+
 COMPONENT_INIT
 {
     printf("======== le_pack Test Started ========\n");
@@ -121,6 +241,10 @@ COMPONENT_INIT
 
     TestUint8();
     TestString();
+#ifndef LE_CONFIG_RPC
+    TestVarint();
+    TestVarString();
+#endif
 
     printf("======== le_pack Test Complete ========\n");
     printf("\n");
@@ -0,0 +1,369 @@
+//--------------------------------------------------------------------------------------------------
+/** @file varintBench.c
+ *
+ * Micro-benchmark of the compact (varint) le_pack encoding against the default fixed width one.
+ * For a few message layouts modelled on common API calls, reports:
+ *
+ *  - the number of payload bytes used by each encoding,
+ *  - how many messages per second each encoding packs,
+ *  - how many messages per second each encoding unpacks.
+ *
+ * Usage: varintBench [iterations]   (default is 100000)
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Default number of times each message is packed and unpacked.
+ */
+//--------------------------------------------------------------------------------------------------
+#define DEFAULT_ITERATION_COUNT     100000
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of fields of a message, and maximum size of a string field (including the null
+ * terminator).
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_FIELD_COUNT             4
+#define MAX_STRING_BYTES            64
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the buffer messages are packed into.  Large enough for any message below in either
+ * encoding.
+ */
+//--------------------------------------------------------------------------------------------------
+#define PAYLOAD_BYTES               512
+
+
+#ifndef LE_CONFIG_RPC
+//--------------------------------------------------------------------------------------------------
+/**
+ * Type of a message field.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    FIELD_RESULT,               ///< le_result_t
+    FIELD_UINT32,               ///< uint32_t (also used for enums and sizes)
+    FIELD_INT32,                ///< int32_t
+    FIELD_UINT64,               ///< uint64_t
+    FIELD_STRING                ///< Null-terminated string
+}
+FieldType_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A message field and its value.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    FieldType_t type;           ///< Type of the field.
+    int64_t value;              ///< Value of integer fields.
+    const char* stringPtr;      ///< Value of string fields.
+}
+Field_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A message layout.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const char* namePtr;                ///< Name reported for the message.
+    size_t fieldCount;                  ///< Number of fields used.
+    Field_t fields[MAX_FIELD_COUNT];    ///< Fields, in packing order.
+}
+Message_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Messages benchmarked.
+ */
+//--------------------------------------------------------------------------------------------------
+static const Message_t Messages[] =
+{
+    {
+        "Result only",
+        1,
+        {
+            { FIELD_RESULT, LE_OK, NULL },
+        }
+    },
+    {
+        "Result and enums",
+        3,
+        {
+            { FIELD_RESULT, LE_OK, NULL },
+            { FIELD_UINT32, 3, NULL },
+            { FIELD_UINT32, 1, NULL },
+        }
+    },
+    {
+        "2D location",
+        4,
+        {
+            { FIELD_RESULT, LE_OK, NULL },
+            { FIELD_INT32, 48117300, NULL },
+            { FIELD_INT32, -1652700, NULL },
+            { FIELD_INT32, 12, NULL },
+        }
+    },
+    {
+        "Error and timestamp",
+        2,
+        {
+            { FIELD_RESULT, LE_NOT_FOUND, NULL },
+            { FIELD_UINT64, 1760000000000, NULL },
+        }
+    },
+    {
+        "Short string",
+        2,
+        {
+            { FIELD_RESULT, LE_OK, NULL },
+            { FIELD_STRING, 0, "359377060012345" },
+        }
+    },
+};
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Buffer messages are packed into and unpacked from.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t Payload[PAYLOAD_BYTES];
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pack a message.
+ *
+ * @return Number of payload bytes used.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t PackMessage
+(
+    const Message_t* msgPtr,    ///< [IN] Message to pack.
+    bool compact                ///< [IN] true to use the compact encoding.
+)
+{
+    uint8_t* bufferPtr = Payload;
+    bool ok = true;
+    size_t i;
+
+    for (i = 0; i < msgPtr->fieldCount; i++)
+    {
+        const Field_t* fieldPtr = &msgPtr->fields[i];
+
+        switch (fieldPtr->type)
+        {
+            case FIELD_RESULT:
+                ok = compact ? le_pack_PackVarResult(&bufferPtr, (le_result_t)fieldPtr->value) :
+                               le_pack_PackResult(&bufferPtr, (le_result_t)fieldPtr->value);
+                break;
+
+            case FIELD_UINT32:
+                ok = compact ? le_pack_PackVarUint32(&bufferPtr, (uint32_t)fieldPtr->value) :
+                               le_pack_PackUint32(&bufferPtr, (uint32_t)fieldPtr->value);
+                break;
+
+            case FIELD_INT32:
+                ok = compact ? le_pack_PackVarInt32(&bufferPtr, (int32_t)fieldPtr->value) :
+                               le_pack_PackInt32(&bufferPtr, (int32_t)fieldPtr->value);
+                break;
+
+            case FIELD_UINT64:
+                ok = compact ? le_pack_PackVarUint64(&bufferPtr, (uint64_t)fieldPtr->value) :
+                               le_pack_PackUint64(&bufferPtr, (uint64_t)fieldPtr->value);
+                break;
+
+            case FIELD_STRING:
+                ok = compact ?
+                     le_pack_PackVarString(&bufferPtr, fieldPtr->stringPtr, MAX_STRING_BYTES - 1) :
+                     le_pack_PackString(&bufferPtr, fieldPtr->stringPtr, MAX_STRING_BYTES - 1);
+                break;
+        }
+
+        LE_FATAL_IF(!ok, "Failed to pack field %zu of '%s'.", i, msgPtr->namePtr);
+    }
+
+    return bufferPtr - Payload;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unpack a message, checking the values read back.
+ */
+//--------------------------------------------------------------------------------------------------
+static void UnpackMessage
+(
+    const Message_t* msgPtr,    ///< [IN] Message expected.
+    bool compact                ///< [IN] true if packed with the compact encoding.
+)
+{
+    uint8_t* bufferPtr = Payload;
+    char string[MAX_STRING_BYTES];
+    bool ok = true;
+    size_t i;
+
+    for (i = 0; i < msgPtr->fieldCount; i++)
+    {
+        const Field_t* fieldPtr = &msgPtr->fields[i];
+        int64_t value = 0;
+
+        switch (fieldPtr->type)
+        {
+            case FIELD_RESULT:
+            {
+                le_result_t result;
+                ok = compact ? le_pack_UnpackVarResult(&bufferPtr, &result) :
+                               le_pack_UnpackResult(&bufferPtr, &result);
+                value = result;
+                break;
+            }
+
+            case FIELD_UINT32:
+            {
+                uint32_t uint32;
+                ok = compact ? le_pack_UnpackVarUint32(&bufferPtr, &uint32) :
+                               le_pack_UnpackUint32(&bufferPtr, &uint32);
+                value = uint32;
+                break;
+            }
+
+            case FIELD_INT32:
+            {
+                int32_t int32;
+                ok = compact ? le_pack_UnpackVarInt32(&bufferPtr, &int32) :
+                               le_pack_UnpackInt32(&bufferPtr, &int32);
+                value = int32;
+                break;
+            }
+
+            case FIELD_UINT64:
+            {
+                uint64_t uint64;
+                ok = compact ? le_pack_UnpackVarUint64(&bufferPtr, &uint64) :
+                               le_pack_UnpackUint64(&bufferPtr, &uint64);
+                value = (int64_t)uint64;
+                break;
+            }
+
+            case FIELD_STRING:
+                ok = compact ? le_pack_UnpackVarString(&bufferPtr, string, sizeof(string),
+                                                       sizeof(string) - 1) :
+                               le_pack_UnpackString(&bufferPtr, string, sizeof(string),
+                                                    sizeof(string) - 1);
+                ok = ok && (strcmp(string, fieldPtr->stringPtr) == 0);
+                break;
+        }
+
+        LE_FATAL_IF(!ok || (value != fieldPtr->value),
+                    "Failed to unpack field %zu of '%s'.", i, msgPtr->namePtr);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the rate of a test, in operations per second.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t GetRate
+(
+    int count,                  ///< [IN] Number of operations made.
+    le_clk_Time_t startTime     ///< [IN] Time the test started at.
+)
+{
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+    uint64_t elapsedUsec = (uint64_t)elapsed.sec * 1000000 + elapsed.usec;
+
+    return elapsedUsec ? (uint64_t)count * 1000000 / elapsedUsec : 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Benchmark one encoding of a message.
+ */
+//--------------------------------------------------------------------------------------------------
+static void BenchEncoding
+(
+    const Message_t* msgPtr,    ///< [IN] Message to benchmark.
+    bool compact,               ///< [IN] true to use the compact encoding.
+    int iterationCount          ///< [IN] Number of times the message is packed and unpacked.
+)
+{
+    le_clk_Time_t startTime;
+    size_t payloadBytes = 0;
+    uint64_t packRate;
+    uint64_t unpackRate;
+    int i;
+
+    startTime = le_clk_GetRelativeTime();
+    for (i = 0; i < iterationCount; i++)
+    {
+        payloadBytes = PackMessage(msgPtr, compact);
+    }
+    packRate = GetRate(iterationCount, startTime);
+
+    startTime = le_clk_GetRelativeTime();
+    for (i = 0; i < iterationCount; i++)
+    {
+        UnpackMessage(msgPtr, compact);
+    }
+    unpackRate = GetRate(iterationCount, startTime);
+
+    LE_INFO("%-20s %-8s %3zu bytes, pack %" PRIu64 " msg/s, unpack %" PRIu64 " msg/s.",
+            msgPtr->namePtr,
+            compact ? "compact" : "fixed",
+            payloadBytes,
+            packRate,
+            unpackRate);
+}
+#endif /* !LE_CONFIG_RPC */
+
+
+COMPONENT_INIT
+{
+#ifdef LE_CONFIG_RPC
+    LE_INFO("Compact encoding is not available with LE_CONFIG_RPC.");
+#else
+    int iterationCount = DEFAULT_ITERATION_COUNT;
+    size_t i;
+
+    if (le_arg_NumArgs() > 0)
+    {
+        iterationCount = atoi(le_arg_GetArg(0));
+        LE_FATAL_IF(iterationCount <= 0, "Invalid iteration count '%s'.", le_arg_GetArg(0));
+    }
+
+    LE_INFO("======== Starting Varint Encoding Benchmark (%d iterations) ========",
+            iterationCount);
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(Messages); i++)
+    {
+        BenchEncoding(&Messages[i], false, iterationCount);
+        BenchEncoding(&Messages[i], true, iterationCount);
+    }
+
+    LE_INFO("======== Varint Encoding Benchmark Done ========");
+#endif
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,83 @@
+#!/bin/bash
+
+# SMACK rule loading benchmark for the Supervisor.
+#
+# Restarts an installed app a number of times and reports the time app_Start() took on average,
+# as measured by the Supervisor ("app startTimes").  If strace is available on the target, also
+# reports the system calls the Supervisor made to the SMACK file system for each start.
+#
+# Usage: smackRuleBench.sh <targetAddr> <appName> [<restartCount>]
+
+LoadTestLib
+
+targetAddr=$1
+appName=$2
+restartCount=${3:-10}
+
+OnFail() {
+    echo "SMACK Rule Benchmark Failed!"
+}
+
+if [ -z "$appName" ]
+then
+    echo "Usage: $0 <targetAddr> <appName> [<restartCount>]" >&2
+    exit 1
+fi
+
+# Prints the time the last start of the app spent in app_Start() (the LAUNCH column).
+GetLaunchMs() {
+    ssh root@$targetAddr "$BIN_PATH/app startTimes $appName" | awk -v app=$appName '$1 == app { print $4 }'
+}
+
+echo "******** SMACK Rule Benchmark Starting ***********"
+
+echo "Make sure Legato is running."
+ssh root@$targetAddr "$BIN_PATH/legato start"
+CheckRet
+
+ssh root@$targetAddr "[ ! -e /legato/SMACK_DISABLED ]"
+if [ $? -ne 0 ]
+then
+    echo "SMACK is disabled on the target."
+    exit 0
+fi
+
+ssh root@$targetAddr "$BIN_PATH/app start $appName"
+
+# Trace the Supervisor's accesses to the SMACK file system while the app is restarted.
+straceLog=/tmp/smackRuleBench.strace
+ssh root@$targetAddr "command -v strace > /dev/null"
+haveStrace=$?
+if [ $haveStrace -eq 0 ]
+then
+    ssh root@$targetAddr "strace -f -e trace=open,openat,write -o $straceLog \
+                          -p \$(pidof supervisor) > /dev/null 2>&1 &"
+    sleep 1
+fi
+
+echo "Restart the app $restartCount times."
+restartTotalMs=0
+for i in $(seq 1 $restartCount)
+do
+    ssh root@$targetAddr "$BIN_PATH/app restart $appName"
+    CheckRet
+    restartTotalMs=$((restartTotalMs + $(GetLaunchMs)))
+done
+
+echo "App starts took $((restartTotalMs / restartCount)) ms on average."
+
+if [ $haveStrace -eq 0 ]
+then
+    ssh root@$targetAddr "killall strace; sleep 1"
+    opens=$(ssh root@$targetAddr "grep -c 'open.*/smack/load2' $straceLog")
+    writes=$(ssh root@$targetAddr \
+             "grep 'open.*/smack/load2' $straceLog | sed 's/.*= //' | sort -u |
+              while read fd; do grep -c \"write(\$fd, \" $straceLog; done |
+              awk '{ n += \$1 } END { print n + 0 }'")
+    echo "Per start: $((opens / restartCount)) opens of load2," \
+         "about $((writes / restartCount)) writes to it."
+    ssh root@$targetAddr "rm -f $straceLog"
+fi
+
+echo "SMACK Rule Benchmark Done!"
+exit 0
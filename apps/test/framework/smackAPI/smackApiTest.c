@@ -30,6 +30,24 @@ static const char* GetProcLabel
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set a rule that the main thread has in its batch, and check that it is in effect.
+ *
+ * @return Non-NULL if the rule is in effect.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* SetBatchedRuleThreadMain
+(
+    void* contextPtr
+)
+{
+    smack_SetRule("testLabel1", "rx", "testLabel3");
+
+    return smack_HasAccess("testLabel1", "rx", "testLabel3") ? contextPtr : NULL;
+}
+
+
 COMPONENT_INIT
 {
     LE_TEST_INIT;
@@ -83,6 +101,44 @@ COMPONENT_INIT
     LE_TEST(!smack_HasAccess("testLabel1", "rw", "testLabel2"));
     LE_TEST(!smack_HasAccess("testLabel1", "r", "testLabel3"));
 
+    // Test a batch of rules, including one set twice.
+    smack_StartRuleBatch();
+    smack_SetRule("testLabel1", "rw", "testLabel2");
+    smack_SetRule("testLabel1", "r", "testLabel3");
+    smack_SetRule("testLabel1", "rw", "testLabel2");
+    smack_CommitRuleBatch();
+
+    LE_TEST(smack_HasAccess("testLabel1", "rw", "testLabel2"));
+    LE_TEST(smack_HasAccess("testLabel1", "r", "testLabel3"));
+    LE_TEST(!smack_HasAccess("testLabel1", "x", "testLabel2"));
+
+    // A rule that is still in another thread's batch must be in effect once set by this thread.
+    smack_StartRuleBatch();
+    smack_SetRule("testLabel1", "rx", "testLabel3");
+
+    le_thread_Ref_t threadRef = le_thread_Create("smackRuleTest", SetBatchedRuleThreadMain,
+                                                 (void*)1);
+    void* threadResultPtr = NULL;
+    le_thread_SetJoinable(threadRef);
+    le_thread_Start(threadRef);
+    LE_ASSERT(le_thread_Join(threadRef, &threadResultPtr) == LE_OK);
+    LE_TEST(threadResultPtr != NULL);
+
+    smack_CommitRuleBatch();
+
+    // Rules set again after being revoked must be loaded again.
+    smack_RevokeSubject("testLabel1");
+    LE_TEST(!smack_HasAccess("testLabel1", "rw", "testLabel2"));
+
+    smack_SetRule("testLabel1", "rw", "testLabel2");
+    LE_TEST(smack_HasAccess("testLabel1", "rw", "testLabel2"));
+
+    // Changing the access mode of a rule that is already set.
+    smack_SetRule("testLabel1", "r", "testLabel2");
+    LE_TEST(!smack_HasAccess("testLabel1", "w", "testLabel2"));
+
+    smack_RevokeSubject("testLabel1");
+
     // Cleanup.
     LE_ASSERT(smack_SetLabel("/dev/null", "_") == LE_OK);
     LE_ASSERT(smack_SetLabel("/dev/zero", "_") == LE_OK);
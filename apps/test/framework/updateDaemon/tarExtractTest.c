@@ -0,0 +1,304 @@
+/**
+ * Unit test of the Update Daemon's tar extractor (tarExtract.c).
+ *
+ * Tar streams are built in memory, fed to the extractor through a pipe, and the extracted tree is
+ * checked.  Streams that would write outside the extraction directory, either through a ".."
+ * component or through a symbolic link extracted earlier, must be refused.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "tarExtract.h"
+
+
+/// Size of a tar block.
+#define BLOCK_BYTES         512
+
+/// Largest tar stream built by the test.  Small enough to fit in a pipe.
+#define MAX_STREAM_BYTES    (16 * BLOCK_BYTES)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Tar stream being built, and its size.
+ */
+//--------------------------------------------------------------------------------------------------
+static char Stream[MAX_STREAM_BYTES];
+static size_t StreamBytes;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Directory the tests run in, with the extraction directory and a directory outside of it.
+ */
+//--------------------------------------------------------------------------------------------------
+static char TestDir[] = "/tmp/tarExtractTestXXXXXX";
+static char ExtractDir[PATH_MAX];
+static char OutsideDir[PATH_MAX];
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start building a new tar stream.
+ */
+//--------------------------------------------------------------------------------------------------
+static void NewStream
+(
+    void
+)
+{
+    memset(Stream, 0, sizeof(Stream));
+    StreamBytes = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add an entry to the tar stream.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddEntry
+(
+    char type,                  ///< [IN] Tar type flag.
+    const char* namePtr,        ///< [IN] Path of the entry.
+    const char* linkNamePtr,    ///< [IN] Link target, or NULL.
+    const char* dataPtr,        ///< [IN] File data, or NULL.
+    mode_t mode                 ///< [IN] Permissions.
+)
+{
+    size_t dataBytes = (dataPtr != NULL) ? strlen(dataPtr) : 0;
+    size_t paddedBytes = (dataBytes + BLOCK_BYTES - 1) / BLOCK_BYTES * BLOCK_BYTES;
+    char* headerPtr = Stream + StreamBytes;
+
+    LE_ASSERT(StreamBytes + BLOCK_BYTES + paddedBytes + 2 * BLOCK_BYTES <= sizeof(Stream));
+
+    // ustar header fields: name, mode, size, checksum, type, link name, magic.
+    strncpy(headerPtr, namePtr, 100);
+    snprintf(headerPtr + 100, 8, "%07o", (unsigned int)mode);
+    snprintf(headerPtr + 124, 12, "%011o", (unsigned int)dataBytes);
+    memset(headerPtr + 148, ' ', 8);
+    headerPtr[156] = type;
+    if (linkNamePtr != NULL)
+    {
+        strncpy(headerPtr + 157, linkNamePtr, 100);
+    }
+    memcpy(headerPtr + 257, "ustar\0" "00", 8);
+
+    unsigned int checksum = 0;
+    size_t i;
+
+    for (i = 0; i < BLOCK_BYTES; i++)
+    {
+        checksum += (unsigned char)headerPtr[i];
+    }
+    snprintf(headerPtr + 148, 8, "%06o", checksum);
+
+    StreamBytes += BLOCK_BYTES;
+
+    if (dataPtr != NULL)
+    {
+        memcpy(Stream + StreamBytes, dataPtr, dataBytes);
+        StreamBytes += paddedBytes;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Extract the tar stream into the (emptied) extraction directory.
+ *
+ * @return Result of the extraction.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t Extract
+(
+    void
+)
+{
+    int fds[2];
+
+    // End of archive.
+    StreamBytes += 2 * BLOCK_BYTES;
+
+    le_dir_RemoveRecursive(ExtractDir);
+    LE_ASSERT(le_dir_MakePath(ExtractDir, S_IRWXU) == LE_OK);
+
+    LE_ASSERT(pipe2(fds, O_NONBLOCK) == 0);
+    LE_ASSERT(write(fds[1], Stream, StreamBytes) == (ssize_t)StreamBytes);
+    close(fds[1]);
+
+    tarExtract_Start(ExtractDir);
+    le_result_t result = tarExtract_Process(fds[0]);
+    tarExtract_Stop();
+
+    close(fds[0]);
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check the content of a file.
+ *
+ * @return true if the file holds the expected data.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsFileContent
+(
+    const char* dirPtr,         ///< [IN] Directory of the file.
+    const char* namePtr,        ///< [IN] Path of the file in the directory.
+    const char* dataPtr         ///< [IN] Expected content.
+)
+{
+    char path[PATH_MAX];
+    char buffer[BLOCK_BYTES];
+
+    snprintf(path, sizeof(path), "%s/%s", dirPtr, namePtr);
+
+    int fd = open(path, O_RDONLY);
+
+    if (fd == -1)
+    {
+        return false;
+    }
+
+    ssize_t bytesRead = read(fd, buffer, sizeof(buffer));
+    close(fd);
+
+    return (bytesRead == (ssize_t)strlen(dataPtr)) && (memcmp(buffer, dataPtr, bytesRead) == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if something exists at a path.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool Exists
+(
+    const char* dirPtr,         ///< [IN] Directory.
+    const char* namePtr         ///< [IN] Path in the directory.
+)
+{
+    char path[PATH_MAX];
+    struct stat pathStat;
+
+    snprintf(path, sizeof(path), "%s/%s", dirPtr, namePtr);
+
+    return lstat(path, &pathStat) == 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Extract a well formed tree.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestTree
+(
+    void
+)
+{
+    struct stat pathStat;
+    char path[PATH_MAX];
+
+    NewStream();
+    AddEntry('5', "./", NULL, NULL, 0755);
+    AddEntry('5', "bin/", NULL, NULL, 0750);
+    AddEntry('0', "bin/hello", NULL, "hello world\n", 0755);
+    AddEntry('0', "lib/deep/file", NULL, "no parent entries\n", 0644);
+    AddEntry('2', "lib/link", "deep/file", NULL, 0777);
+    AddEntry('1', "bin/hardlink", "bin/hello", NULL, 0755);
+
+    LE_TEST_OK(Extract() == LE_OK, "well formed tree is extracted");
+    LE_TEST_OK(IsFileContent(ExtractDir, "bin/hello", "hello world\n"), "file content");
+    LE_TEST_OK(IsFileContent(ExtractDir, "lib/deep/file", "no parent entries\n"),
+               "missing parent directories are created");
+    LE_TEST_OK(IsFileContent(ExtractDir, "lib/link", "no parent entries\n"), "symbolic link");
+    LE_TEST_OK(IsFileContent(ExtractDir, "bin/hardlink", "hello world\n"), "hard link");
+
+    snprintf(path, sizeof(path), "%s/bin", ExtractDir);
+    LE_TEST_OK((stat(path, &pathStat) == 0) && ((pathStat.st_mode & 07777) == 0750),
+               "directory permissions");
+
+    snprintf(path, sizeof(path), "%s/bin/hello", ExtractDir);
+    LE_TEST_OK((stat(path, &pathStat) == 0) && ((pathStat.st_mode & 07777) == 0755),
+               "file permissions");
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Refuse entries that would be written outside the extraction directory.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestEscapes
+(
+    void
+)
+{
+    NewStream();
+    AddEntry('0', "../escaped", NULL, "dotdot\n", 0644);
+    LE_TEST_OK(Extract() == LE_FORMAT_ERROR, "'..' component is refused");
+    LE_TEST_OK(!Exists(TestDir, "escaped"), "nothing written outside through '..'");
+
+    // A symbolic link to a directory outside, then a file "through" it.
+    NewStream();
+    AddEntry('2', "a", OutsideDir, NULL, 0777);
+    AddEntry('0', "a/passwd", NULL, "symlink\n", 0644);
+    LE_TEST_OK(Extract() == LE_FORMAT_ERROR, "file through a symbolic link is refused");
+    LE_TEST_OK(!Exists(OutsideDir, "passwd"), "no file written through a symbolic link");
+
+    // Same with a relative link, a directory entry and a missing parent directory.
+    NewStream();
+    AddEntry('2', "b", "../outside", NULL, 0777);
+    AddEntry('5', "b/sub/", NULL, NULL, 0755);
+    LE_TEST_OK(Extract() == LE_FORMAT_ERROR, "directory through a symbolic link is refused");
+    LE_TEST_OK(!Exists(OutsideDir, "sub"), "no directory created through a symbolic link");
+
+    NewStream();
+    AddEntry('2', "c", OutsideDir, NULL, 0777);
+    AddEntry('0', "c/new/file", NULL, "symlink\n", 0644);
+    LE_TEST_OK(Extract() == LE_FORMAT_ERROR, "file under a symbolic link is refused");
+    LE_TEST_OK(!Exists(OutsideDir, "new"), "no parent created through a symbolic link");
+
+    // Links placed through a symbolic link, and hard links to files outside.
+    NewStream();
+    AddEntry('2', "d", OutsideDir, NULL, 0777);
+    AddEntry('2', "d/link", "/etc", NULL, 0777);
+    LE_TEST_OK(Extract() == LE_FORMAT_ERROR, "symbolic link through a symbolic link is refused");
+    LE_TEST_OK(!Exists(OutsideDir, "link"), "no link created through a symbolic link");
+
+    NewStream();
+    AddEntry('2', "e", OutsideDir, NULL, 0777);
+    AddEntry('1', "stolen", "e/target", NULL, 0644);
+    LE_TEST_OK(Extract() == LE_FORMAT_ERROR, "hard link through a symbolic link is refused");
+    LE_TEST_OK(!Exists(ExtractDir, "stolen"), "no hard link to a file outside");
+}
+
+
+COMPONENT_INIT
+{
+    LE_TEST_PLAN(LE_TEST_NO_PLAN);
+
+    LE_ASSERT(mkdtemp(TestDir) != NULL);
+    snprintf(ExtractDir, sizeof(ExtractDir), "%s/extract", TestDir);
+    snprintf(OutsideDir, sizeof(OutsideDir), "%s/outside", TestDir);
+    LE_ASSERT(le_dir_MakePath(OutsideDir, S_IRWXU) == LE_OK);
+
+    // A file outside, for the hard link test.
+    char path[PATH_MAX];
+    snprintf(path, sizeof(path), "%s/target", OutsideDir);
+    int fd = open(path, O_WRONLY | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    LE_ASSERT(fd != -1);
+    close(fd);
+
+    TestTree();
+    TestEscapes();
+
+    le_dir_RemoveRecursive(TestDir);
+
+    LE_TEST_EXIT;
+}
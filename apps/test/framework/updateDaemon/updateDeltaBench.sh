@@ -0,0 +1,63 @@
+#!/bin/bash
+
+# App delta update benchmark for the Update Daemon.
+#
+# Makes a delta app update between two versions of an app with update-util, then installs the
+# new version of the app both from the full app update and from the delta app update, each time
+# starting from the old version, and reports the size of each update and the time each install
+# took, as seen from the host, along with what the Update Daemon logged about the payload.
+#
+# Usage: updateDeltaBench.sh <targetAddr> <oldAppUpdate> <newAppUpdate>
+
+LoadTestLib
+
+targetAddr=$1
+shift
+
+OnFail() {
+    echo "Update Delta Benchmark Failed!"
+}
+
+if [ $# -ne 2 ]
+then
+    echo "Usage: $0 <targetAddr> <oldAppUpdate> <newAppUpdate>" >&2
+    exit 1
+fi
+
+oldUpdate=$1
+newUpdate=$2
+deltaUpdate=$(mktemp --suffix=.update)
+trap "rm -f $deltaUpdate" EXIT
+
+echo "******** Update Delta Benchmark Starting ***********"
+
+echo "Make the delta app update."
+update-util "$oldUpdate" "$newUpdate" "$deltaUpdate" --app-delta
+CheckRet
+
+echo "Make sure Legato is running."
+ssh root@$targetAddr "$BIN_PATH/legato start"
+CheckRet
+
+for updatePack in "$newUpdate" "$deltaUpdate"
+do
+    echo "Install the old version of the app from '$oldUpdate'."
+    cat "$oldUpdate" | ssh root@$targetAddr "$BIN_PATH/update && $BIN_PATH/update --mark-good -f"
+    CheckRet
+
+    ClearLogs
+
+    echo "Install '$updatePack' ($(stat -c %s "$updatePack") bytes)."
+    startNs=$(date +%s%N)
+    cat "$updatePack" | ssh root@$targetAddr "$BIN_PATH/update"
+    CheckRet
+    endNs=$(date +%s%N)
+
+    echo "Install took $(( (endNs - startNs) / 1000000 )) ms."
+
+    ssh root@$targetAddr "/sbin/logread | grep -E 'Applied delta|byte payload in'" |
+        sed 's/^.*| *//'
+done
+
+echo "Update Delta Benchmark Done!"
+exit 0
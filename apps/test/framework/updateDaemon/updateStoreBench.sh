@@ -0,0 +1,65 @@
+#!/bin/bash
+
+# File store benchmark for the Update Daemon.
+#
+# Installs three consecutive system updates and reports, for each of them, the time the install
+# took, as seen from the host, the flash used by apps, systems and the file store afterwards, and
+# how much the Update Daemon saved by sharing identical files, as logged by the Update Daemon.
+#
+# Usage: updateStoreBench.sh <targetAddr> <update1> <update2> <update3>
+
+LoadTestLib
+
+targetAddr=$1
+shift
+
+OnFail() {
+    echo "Update Store Benchmark Failed!"
+}
+
+if [ $# -ne 3 ]
+then
+    echo "Usage: $0 <targetAddr> <update1> <update2> <update3>" >&2
+    exit 1
+fi
+
+# Print the flash used under /legato.  du counts each hard linked file once.
+PrintFlashUsage() {
+    ssh root@$targetAddr "du -sk /legato /legato/apps /legato/systems /legato/store 2>/dev/null" |
+        while read kbytes path
+        do
+            echo "    $path: $kbytes KiB"
+        done
+}
+
+echo "******** Update Store Benchmark Starting ***********"
+
+echo "Make sure Legato is running."
+ssh root@$targetAddr "$BIN_PATH/legato start"
+CheckRet
+
+echo "Flash usage before the updates:"
+PrintFlashUsage
+
+for updatePack in "$@"
+do
+    ClearLogs
+
+    echo "Install '$updatePack' ($(stat -c %s "$updatePack") bytes)."
+    startNs=$(date +%s%N)
+    cat "$updatePack" | ssh root@$targetAddr "$BIN_PATH/update"
+    CheckRet
+    endNs=$(date +%s%N)
+
+    echo "Install took $(( (endNs - startNs) / 1000000 )) ms."
+
+    echo "Files shared by the Update Daemon:"
+    ssh root@$targetAddr "/sbin/logread | grep -E 'Deduplicated|from the file store'" |
+        sed 's/^.*| *//'
+
+    echo "Flash usage after the update:"
+    PrintFlashUsage
+done
+
+echo "Update Store Benchmark Done!"
+exit 0
@@ -0,0 +1,46 @@
+#!/bin/bash
+
+# Unpack benchmark for the Update Daemon.
+#
+# Installs an update pack (e.g., a large system update) and reports the time the install took,
+# as seen from the host, and the wall clock and CPU time the Update Daemon spent unpacking each
+# payload of the pack, as logged by the Update Daemon.
+#
+# Usage: updateUnpackBench.sh <targetAddr> <updatePackPath>
+
+LoadTestLib
+
+targetAddr=$1
+updatePack=$2
+
+OnFail() {
+    echo "Update Unpack Benchmark Failed!"
+}
+
+if [ ! -f "$updatePack" ]
+then
+    echo "Usage: $0 <targetAddr> <updatePackPath>" >&2
+    exit 1
+fi
+
+echo "******** Update Unpack Benchmark Starting ***********"
+
+echo "Make sure Legato is running."
+ssh root@$targetAddr "$BIN_PATH/legato start"
+CheckRet
+
+ClearLogs
+
+echo "Install '$updatePack' ($(stat -c %s "$updatePack") bytes)."
+startNs=$(date +%s%N)
+cat "$updatePack" | ssh root@$targetAddr "$BIN_PATH/update"
+CheckRet
+endNs=$(date +%s%N)
+
+echo "Install took $(( (endNs - startNs) / 1000000 )) ms."
+
+echo "Unpack times logged by the Update Daemon:"
+ssh root@$targetAddr "/sbin/logread | grep 'byte payload in'" | sed 's/^.*| *//'
+
+echo "Update Unpack Benchmark Done!"
+exit 0
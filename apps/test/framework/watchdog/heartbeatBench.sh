@@ -0,0 +1,77 @@
+#!/bin/bash
+
+# Watchdog daemon load benchmark.
+#
+# Runs the dogTestHeartbeatPack app (200 processes kicking their watchdog every 100 ms), first
+# kicking through le_wdog_Kick() and then through shared heartbeat counters, and reports the CPU
+# time the watchdog daemon used over the same period in each case.
+#
+# Usage: heartbeatBench.sh <targetAddr> [<seconds>]
+
+LoadTestLib
+
+targetAddr=$1
+seconds=${2:-30}
+appName=dogTestHeartbeatPack
+procCount=200
+
+OnFail() {
+    echo "Watchdog Heartbeat Benchmark Failed!"
+}
+
+if [ -z "$targetAddr" ]
+then
+    echo "Usage: $0 <targetAddr> [<seconds>]" >&2
+    exit 1
+fi
+
+# Prints the user + system CPU time of the watchdog daemon, in clock ticks.
+GetDaemonTicks() {
+    ssh root@$targetAddr "cat /proc/\$(pidof watchdog)/stat" | awk '{ print $14 + $15 }'
+}
+
+# Runs the app with every process kicking in the given mode, and prints the daemon CPU use.
+Measure() {
+    local mode=$1
+
+    ssh root@$targetAddr "for i in \$(seq -f '%03g' 1 $procCount)
+                          do
+                              $BIN_PATH/config set /apps/$appName/procs/h\$i/envVars/WDOG_KICK_MODE $mode
+                          done"
+    CheckRet
+
+    ssh root@$targetAddr "$BIN_PATH/app start $appName"
+    CheckRet
+
+    # Let the processes start and settle.
+    sleep 5
+
+    local startTicks=$(GetDaemonTicks)
+    sleep $seconds
+    local endTicks=$(GetDaemonTicks)
+
+    ssh root@$targetAddr "$BIN_PATH/app status $appName" | grep -q running
+    CheckRet
+
+    ssh root@$targetAddr "$BIN_PATH/app stop $appName"
+
+    local ticks=$((endTicks - startTicks))
+    local ms=$((ticks * 1000 / clockTicks))
+    echo "$mode: watchdog daemon used $ms ms of CPU in $seconds s" \
+         "($((ms / (seconds * 10)))% of one CPU)."
+}
+
+echo "******** Watchdog Heartbeat Benchmark Starting ***********"
+
+echo "Make sure Legato is running."
+ssh root@$targetAddr "$BIN_PATH/legato start"
+CheckRet
+
+clockTicks=$(ssh root@$targetAddr "getconf CLK_TCK")
+clockTicks=${clockTicks:-100}
+
+Measure ipc
+Measure heartbeat
+
+echo "Watchdog Heartbeat Benchmark Done!"
+exit 0
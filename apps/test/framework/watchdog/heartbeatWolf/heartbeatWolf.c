@@ -0,0 +1,111 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file heartbeatWolf.c
+ *
+ * Watchdog load generator for heartbeatBench.sh.  Kicks the watchdog every 100 ms until stopped,
+ * either through a shared heartbeat counter or through le_wdog_Kick(), as selected by the
+ * WDOG_KICK_MODE environment variable ("heartbeat", the default, or "ipc").
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "interfaces.h"
+#include <sys/mman.h>
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * How often to kick the watchdog, in milliseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+#define KICK_INTERVAL_MS    100
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Heartbeat counter shared with the watchdog daemon, or NULL to kick through IPC.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t* HeartbeatPtr;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Last value stored in the heartbeat counter.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t Heartbeat;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Kick the watchdog.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Kick
+(
+    le_timer_Ref_t timerRef
+)
+{
+    if (HeartbeatPtr != NULL)
+    {
+        __atomic_store_n(HeartbeatPtr, ++Heartbeat, __ATOMIC_RELAXED);
+    }
+    else
+    {
+        le_wdog_Kick();
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Map the heartbeat counter.
+ *
+ * @return The heartbeat counter, or NULL if the watchdog must be kicked through IPC.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t* OpenHeartbeat
+(
+    void
+)
+{
+    int fd;
+    le_result_t result = le_wdog_OpenHeartbeat(&fd);
+
+    if (result != LE_OK)
+    {
+        LE_WARN("No heartbeat (%s), kicking through IPC.", LE_RESULT_TXT(result));
+        return NULL;
+    }
+
+    uint32_t* heartbeatPtr = mmap(NULL, sizeof(*heartbeatPtr), PROT_READ | PROT_WRITE,
+                                  MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (heartbeatPtr == MAP_FAILED)
+    {
+        LE_WARN("Cannot map heartbeat (%m), kicking through IPC.");
+        return NULL;
+    }
+
+    return heartbeatPtr;
+}
+
+COMPONENT_INIT
+{
+    const char* modePtr = getenv("WDOG_KICK_MODE");
+
+    if ((modePtr == NULL) || (strcmp(modePtr, "ipc") != 0))
+    {
+        HeartbeatPtr = OpenHeartbeat();
+    }
+
+    LE_INFO("Kicking every %d ms through %s.", KICK_INTERVAL_MS,
+            (HeartbeatPtr != NULL) ? "heartbeat" : "IPC");
+
+    Kick(NULL);
+
+    le_timer_Ref_t timerRef = le_timer_Create("kick");
+    le_timer_SetMsInterval(timerRef, KICK_INTERVAL_MS);
+    le_timer_SetRepeat(timerRef, 0);
+    le_timer_SetHandler(timerRef, Kick);
+    le_timer_Start(timerRef);
+}
@@ -0,0 +1,80 @@
+/*
+ * Server for the worker thread test, processing requests on a pool of worker threads.  Same as
+ * workersServerMain.c, but also checks that the worker init function ran on the thread processing
+ * each request.
+ */
+
+
+#include "legato.h"
+#include "workerPool_server.h"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set by the worker init function on each worker thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static __thread bool WorkerInitDone = false;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Worker init function
+ */
+//--------------------------------------------------------------------------------------------------
+static void InitWorker
+(
+    void* contextPtr
+)
+{
+    LE_ASSERT(contextPtr == &WorkerInitDone);
+    LE_ASSERT(!WorkerInitDone);
+
+    WorkerInitDone = true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Slow request; holds up whichever thread is processing it.
+ */
+//--------------------------------------------------------------------------------------------------
+void workerPool_Slow
+(
+    uint32_t delayMs
+)
+{
+    LE_ASSERT(WorkerInitDone);
+    LE_ASSERT(workerPool_GetClientSessionRef() != NULL);
+
+    usleep(delayMs * 1000);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fast request
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t workerPool_Fast
+(
+    uint32_t value
+)
+{
+    LE_ASSERT(WorkerInitDone);
+    LE_ASSERT(workerPool_GetClientSessionRef() != NULL);
+
+    return value;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialization
+ */
+//--------------------------------------------------------------------------------------------------
+COMPONENT_INIT
+{
+    workerPool_SetWorkerInitHandler(InitWorker, &WorkerInitDone);
+    workerPool_AdvertiseService();
+}
@@ -0,0 +1,115 @@
+/*
+ * Client for the worker thread test.
+ *
+ * A few threads keep the server busy with slow requests, while the main thread measures the
+ * latency of fast requests.  If a latency limit (in milliseconds) is given on the command line,
+ * the test fails if the 99th percentile latency of the fast requests is above it.
+ */
+
+#include "legato.h"
+#include "workers_interface.h"
+
+
+/// Number of threads sending slow requests.
+#define SLOW_CLIENT_COUNT       2
+
+/// How long each slow request takes, in milliseconds.
+#define SLOW_DELAY_MS           200
+
+/// Number of fast requests to measure.
+#define FAST_CALL_COUNT         100
+
+/// Time between fast requests, in microseconds.
+#define FAST_CALL_INTERVAL_US   10000
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sends slow requests forever.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* SlowClientThread
+(
+    void* contextPtr
+)
+{
+    workers_ConnectService();
+
+    for (;;)
+    {
+        workers_Slow(SLOW_DELAY_MS);
+    }
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compare function for sorting latencies with qsort().
+ */
+//--------------------------------------------------------------------------------------------------
+static int CompareLatency
+(
+    const void* aPtr,
+    const void* bPtr
+)
+{
+    uint64_t a = *(const uint64_t*)aPtr;
+    uint64_t b = *(const uint64_t*)bPtr;
+
+    return (a > b) - (a < b);
+}
+
+
+COMPONENT_INIT
+{
+    uint64_t latencyUs[FAST_CALL_COUNT];
+    uint64_t limitMs = 0;
+    int i;
+
+    if (le_arg_NumArgs() > 0)
+    {
+        limitMs = strtoull(le_arg_GetArg(0), NULL, 10);
+    }
+
+    workers_ConnectService();
+
+    for (i = 0; i < SLOW_CLIENT_COUNT; i++)
+    {
+        le_thread_Start(le_thread_Create("SlowClient", SlowClientThread, NULL));
+    }
+
+    // Give the slow clients time to get going.
+    usleep(SLOW_DELAY_MS * 1000 / 2);
+
+    for (i = 0; i < FAST_CALL_COUNT; i++)
+    {
+        le_clk_Time_t start = le_clk_GetRelativeTime();
+
+        LE_ASSERT(workers_Fast(i) == (uint32_t)i);
+
+        le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), start);
+        latencyUs[i] = ((uint64_t)elapsed.sec * 1000000) + elapsed.usec;
+
+        usleep(FAST_CALL_INTERVAL_US);
+    }
+
+    qsort(latencyUs, FAST_CALL_COUNT, sizeof(latencyUs[0]), CompareLatency);
+
+    uint64_t p50Us = latencyUs[FAST_CALL_COUNT / 2];
+    uint64_t p99Us = latencyUs[(FAST_CALL_COUNT * 99) / 100];
+    uint64_t maxUs = latencyUs[FAST_CALL_COUNT - 1];
+
+    LE_INFO("Fast request latency: p50 %" PRIu64 " us, p99 %" PRIu64 " us, max %" PRIu64 " us",
+            p50Us, p99Us, maxUs);
+
+    if ((limitMs != 0) && (p99Us > (limitMs * 1000)))
+    {
+        LE_ERROR("FAILED: p99 latency is above %" PRIu64 " ms", limitMs);
+        exit(EXIT_FAILURE);
+    }
+
+    LE_INFO("PASSED");
+    exit(EXIT_SUCCESS);
+}
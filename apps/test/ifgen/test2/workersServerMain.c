@@ -0,0 +1,50 @@
+/*
+ * Server for the worker thread test.  The same code is built with and without worker threads.
+ */
+
+
+#include "legato.h"
+#include "workers_server.h"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Slow request; holds up whichever thread is processing it.
+ */
+//--------------------------------------------------------------------------------------------------
+void workers_Slow
+(
+    uint32_t delayMs
+)
+{
+    LE_ASSERT(workers_GetClientSessionRef() != NULL);
+
+    usleep(delayMs * 1000);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fast request
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t workers_Fast
+(
+    uint32_t value
+)
+{
+    LE_ASSERT(workers_GetClientSessionRef() != NULL);
+
+    return value;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialization
+ */
+//--------------------------------------------------------------------------------------------------
+COMPONENT_INIT
+{
+    workers_AdvertiseService();
+}
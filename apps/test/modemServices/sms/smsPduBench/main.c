@@ -0,0 +1,264 @@
+/**
+ * This module implements a benchmark of the SMS PDU encoding and decoding.
+ *
+ * Messages of the maximum length are encoded as SMS-SUBMIT PDUs, and decoded from SMS-DELIVER PDUs,
+ * in GSM 7 bits (with and without escaped characters), 8 bits and UCS2. Every decoded message is
+ * checked against the original one. The decoding of the segments of a concatenated message, which
+ * are delivered as PDUs, is timed too.
+ *
+ * Usage: smsPduBench [<iterations>]
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+#include "smsPdu.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Default number of iterations
+ */
+//--------------------------------------------------------------------------------------------------
+#define DEFAULT_ITERATIONS 100000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Destination and originating address of the PDUs
+ */
+//--------------------------------------------------------------------------------------------------
+#define ADDRESS "+33612345678"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Concatenated message User Data Header: 8-bit reference 0x2A, segment 1 of 2
+ */
+//--------------------------------------------------------------------------------------------------
+#define CONCAT_UDH  0x05, 0x00, 0x03, 0x2A, 0x02, 0x01
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Message to benchmark
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const char*         name;       ///< Name of the message
+    smsPdu_Encoding_t   encoding;   ///< Encoding of the PDUs
+    uint8_t             data[LE_SMS_TEXT_MAX_LEN];  ///< Message
+    size_t              length;     ///< Message length
+}
+Message_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of iterations
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t Iterations = DEFAULT_ITERATIONS;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the time elapsed since a start time, in nanoseconds per iteration
+ */
+//--------------------------------------------------------------------------------------------------
+static double Elapsed
+(
+    le_clk_Time_t start
+)
+{
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), start);
+
+    return (elapsed.sec * 1e9 + elapsed.usec * 1e3) / Iterations;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fill a message with a repeated pattern
+ */
+//--------------------------------------------------------------------------------------------------
+static void FillMessage
+(
+    Message_t*  msgPtr,     ///< [OUT] Message
+    const char* patternPtr, ///< [IN] Pattern
+    size_t      length      ///< [IN] Message length
+)
+{
+    size_t patternLen = strlen(patternPtr);
+    size_t i;
+
+    LE_ASSERT(length <= sizeof(msgPtr->data));
+
+    for (i = 0; i < length; i++)
+    {
+        msgPtr->data[i] = patternPtr[i % patternLen];
+    }
+
+    msgPtr->length = length;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check a decoded message against the original one
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckMessage
+(
+    const Message_t*        msgPtr,     ///< [IN] Original message
+    const pa_sms_Message_t* decodedPtr  ///< [IN] Decoded message
+)
+{
+    LE_ASSERT(PA_SMS_DELIVER == decodedPtr->type);
+    LE_ASSERT(decodedPtr->smsDeliver.dataLen == msgPtr->length);
+    LE_ASSERT(0 == memcmp(decodedPtr->smsDeliver.data, msgPtr->data, msgPtr->length));
+    LE_ASSERT(0 == strcmp(decodedPtr->smsDeliver.oa, ADDRESS));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Benchmark the encoding and the decoding of a message
+ */
+//--------------------------------------------------------------------------------------------------
+static void BenchMessage
+(
+    const Message_t* msgPtr     ///< [IN] Message
+)
+{
+    smsPdu_DataToEncode_t data;
+    pa_sms_Pdu_t pdu;
+    pa_sms_Message_t message;
+    uint32_t i;
+
+    memset(&data, 0, sizeof(data));
+    data.protocol = PA_SMS_PROTOCOL_GSM;
+    data.messagePtr = msgPtr->data;
+    data.length = msgPtr->length;
+    data.addressPtr = ADDRESS;
+    data.encoding = msgPtr->encoding;
+    data.messageType = PA_SMS_SUBMIT;
+
+    le_clk_Time_t start = le_clk_GetRelativeTime();
+
+    for (i = 0; i < Iterations; i++)
+    {
+        LE_ASSERT_OK(smsPdu_Encode(&data, &pdu));
+    }
+
+    double encodeTime = Elapsed(start);
+
+    data.messageType = PA_SMS_DELIVER;
+    LE_ASSERT_OK(smsPdu_Encode(&data, &pdu));
+
+    start = le_clk_GetRelativeTime();
+
+    for (i = 0; i < Iterations; i++)
+    {
+        LE_ASSERT_OK(smsPdu_Decode(PA_SMS_PROTOCOL_GSM, pdu.data, pdu.dataLen, true, &message));
+    }
+
+    double decodeTime = Elapsed(start);
+
+    CheckMessage(msgPtr, &message);
+
+    LE_INFO("%s (%zu bytes, PDU %u bytes): encode %.0f ns/PDU, decode %.0f ns/PDU",
+            msgPtr->name, msgPtr->length, pdu.dataLen, encodeTime, decodeTime);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Benchmark the decoding of a segment of a concatenated message
+ */
+//--------------------------------------------------------------------------------------------------
+static void BenchConcatenated
+(
+    void
+)
+{
+    static const uint8_t udh[] = { CONCAT_UDH };
+    Message_t segment = { .name = "Concatenated segment", .encoding = SMSPDU_8_BITS };
+    smsPdu_DataToEncode_t data;
+    pa_sms_Pdu_t pdu;
+    pa_sms_Message_t message;
+    int firstByte = 0;
+    uint32_t i;
+
+    // The User Data Header is the beginning of the user data
+    FillMessage(&segment, "0123456789", LE_SMS_PDU_MAX_PAYLOAD);
+    memcpy(segment.data, udh, sizeof(udh));
+
+    memset(&data, 0, sizeof(data));
+    data.protocol = PA_SMS_PROTOCOL_GSM;
+    data.messagePtr = segment.data;
+    data.length = segment.length;
+    data.addressPtr = ADDRESS;
+    data.encoding = segment.encoding;
+    data.messageType = PA_SMS_DELIVER;
+
+    LE_ASSERT_OK(smsPdu_Encode(&data, &pdu));
+
+#ifdef LE_CONFIG_MDM_HAS_SMSC_INFORMATION
+    firstByte++;
+#endif
+
+    // TP-UDHI
+    pdu.data[firstByte] |= (1 << 6);
+
+    le_clk_Time_t start = le_clk_GetRelativeTime();
+
+    for (i = 0; i < Iterations; i++)
+    {
+        // Segments are delivered as PDUs
+        LE_ASSERT(LE_UNSUPPORTED == smsPdu_Decode(PA_SMS_PROTOCOL_GSM, pdu.data, pdu.dataLen,
+                                                  true, &message));
+    }
+
+    LE_INFO("%s (PDU %u bytes): decode %.0f ns/PDU", segment.name, pdu.dataLen, Elapsed(start));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Main of the benchmark
+ */
+//--------------------------------------------------------------------------------------------------
+COMPONENT_INIT
+{
+    Message_t message;
+
+    LE_INFO("====== SMS PDU benchmark Start ======");
+
+    if (le_arg_NumArgs() >= 1)
+    {
+        Iterations = strtoul(le_arg_GetArg(0), NULL, 10);
+        LE_ASSERT(Iterations > 0);
+    }
+
+    LE_ASSERT_OK(smsPdu_Initialize());
+
+    message.name = "GSM 7 bits";
+    message.encoding = SMSPDU_7_BITS;
+    FillMessage(&message, "The quick brown fox jumps over the lazy dog. ", LE_SMS_TEXT_MAX_LEN);
+    BenchMessage(&message);
+
+    // Escaped characters take two septets
+    message.name = "GSM 7 bits escaped";
+    FillMessage(&message, "{Price} [EUR] 10 ~ 12 | ", 120);
+    BenchMessage(&message);
+
+    message.name = "8 bits";
+    message.encoding = SMSPDU_8_BITS;
+    FillMessage(&message, "\x01\x02\x80\xFF binary ", LE_SMS_PDU_MAX_PAYLOAD);
+    BenchMessage(&message);
+
+    message.name = "UCS2";
+    message.encoding = SMSPDU_UCS2_16_BITS;
+    FillMessage(&message, "\x04\x1F\x04\x40\x04\x38\x04\x32\x04\x35\x04\x42",
+                LE_SMS_PDU_MAX_PAYLOAD);
+    BenchMessage(&message);
+
+    BenchConcatenated();
+
+    LE_INFO("====== SMS PDU benchmark PASSED ======");
+
+    exit(EXIT_SUCCESS);
+}
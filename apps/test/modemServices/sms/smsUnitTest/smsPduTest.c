@@ -15,6 +15,21 @@
 
 #define PDU_MAX     256
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of random messages, and seed of the random generator, of the round trip test
+ */
+//--------------------------------------------------------------------------------------------------
+#define ROUND_TRIP_ITERATIONS   2000
+#define ROUND_TRIP_SEED         0x5A5A
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of septets of a GSM 7 bits message
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_SEPTETS             160
+
 
 typedef struct
 {
@@ -955,7 +970,7 @@ static const PduReceived_t PduReceivedDb[] =
         },
         .expected =
         {
-            .result = LE_UNSUPPORTED,
+            .result = LE_OK,
             .encoding = SMSPDU_7_BITS,
             .message =
             {
@@ -967,7 +982,7 @@ static const PduReceived_t PduReceivedDb[] =
                     .scts = "13/07/05,09:31:19+08",
                     .data = "Toute l'équipe Orange Business Services vous présente ses"
                         " meilleurs voeux pour 2015 ! Plus d'infos sur http://business,(",
-                        .dataLen = 160,
+                        .dataLen = 153,
                 },
             },
         },
@@ -992,8 +1007,8 @@ static const PduReceived_t PduReceivedDb[] =
      * Length: 15
      */
     {
-        .checkLength = false, /* SMS not supported */
-        .checkData = false, /* SMS not supported */
+        .checkLength = true,
+        .checkData = true,
         .proto = PA_SMS_PROTOCOL_GSM,
         .length = 42,
         .data =
@@ -1006,18 +1021,18 @@ static const PduReceived_t PduReceivedDb[] =
         },
         .expected =
         {
-            .result = LE_UNSUPPORTED,
+            .result = LE_OK,
             .encoding = SMSPDU_7_BITS,
             .message =
             {
                 .type = PA_SMS_DELIVER,
                 .smsDeliver =
                 {
-                    .oa = "Orange Info",
+                    .oa = "Orange",
                     .format = LE_SMS_FORMAT_TEXT,
                     .scts = "13/07/05,09:31:20+08",
-                    .data = "uscrite",
-                    .dataLen = 15,
+                    .data = "uscrite ",
+                    .dataLen = 8,
                 },
             },
         },
@@ -1046,8 +1061,8 @@ static const PduReceived_t PduReceivedDb[] =
      * Length: 57
      */
     {
-        .checkLength = false, /* SMS not supported */
-        .checkData = false, /* SMS not supported */
+        .checkLength = true,
+        .checkData = false, /* Truncated PDU */
         .proto = PA_SMS_PROTOCOL_GSM,
         .length = 136,
         .data =
@@ -1069,18 +1084,18 @@ static const PduReceived_t PduReceivedDb[] =
         },
         .expected =
         {
-            .result = LE_UNSUPPORTED,
-            .encoding = SMSPDU_7_BITS,
+            .result = LE_OK,
+            .encoding = SMSPDU_UCS2_16_BITS,
             .message =
             {
                 .type = PA_SMS_DELIVER,
                 .smsDeliver =
                 {
-                    .oa = "33688266023",
-                    .format = LE_SMS_FORMAT_TEXT,
+                    .oa = "+33688266023",
+                    .format = LE_SMS_FORMAT_UCS2,
                     .scts = "15/05/07,10:28:31+08",
                     .data = "",
-                    .dataLen = 57,
+                    .dataLen = 108,
                 },
             },
         },
@@ -1468,6 +1483,188 @@ static const PduReceived_t PduReceivedDb[] =
             },
         },
     },
+
+    /* 14 */
+    /*
+     * 07913386094000F0440B913386286620F300045150700182138009060804123403014869
+     *
+     * SMS DELIVER (receive)
+     * SMSC: 33689004000
+     * Sender: 33688266023
+     * TimeStamp: 07/05/15 10:28:31 GMT +02:00
+     * TP-PID: 00
+     * TP-DCS: 04
+     * Alphabet: 8bit
+     * User Data Header: 06 08 04 12 34 03 01
+     *
+     * Segment 1/3 of a concatenated message with a 16-bit reference (0x1234)
+     */
+    {
+        .checkLength = true,
+        .checkData = true,
+        .proto = PA_SMS_PROTOCOL_GSM,
+        .length = 36,
+        .data =
+        {
+            0x07, 0x91, 0x33, 0x86, 0x09, 0x40, 0x00, 0xF0, 0x44, 0x0B,
+            0x91, 0x33, 0x86, 0x28, 0x66, 0x20, 0xF3, 0x00, 0x04, 0x51,
+            0x50, 0x70, 0x01, 0x82, 0x13, 0x80, 0x09, 0x06, 0x08, 0x04,
+            0x12, 0x34, 0x03, 0x01, 0x48, 0x69,
+        },
+        .expected =
+        {
+            .result = LE_OK,
+            .encoding = SMSPDU_8_BITS,
+            .message =
+            {
+                .type = PA_SMS_DELIVER,
+                .smsDeliver =
+                {
+                    .oa = "+33688266023",
+                    .format = LE_SMS_FORMAT_BINARY,
+                    .scts = "15/05/07,10:28:31+08",
+                    .data = "Hi",
+                    .dataLen = 2,
+                },
+            },
+        },
+    },
+    /* 15 */
+    /*
+     * 07913386094000F0440B913386286620F30004515070018213800B0824010100032A02014869
+     *
+     * SMS DELIVER (receive)
+     * SMSC: 33689004000
+     * Sender: 33688266023
+     * TimeStamp: 07/05/15 10:28:31 GMT +02:00
+     * TP-PID: 00
+     * TP-DCS: 04
+     * Alphabet: 8bit
+     * User Data Header: 08 24 01 01 00 03 2A 02 01
+     *
+     * Segment 1/2 of a concatenated message with an 8-bit reference (0x2A), after a national
+     * language shift information element
+     */
+    {
+        .checkLength = true,
+        .checkData = true,
+        .proto = PA_SMS_PROTOCOL_GSM,
+        .length = 38,
+        .data =
+        {
+            0x07, 0x91, 0x33, 0x86, 0x09, 0x40, 0x00, 0xF0, 0x44, 0x0B,
+            0x91, 0x33, 0x86, 0x28, 0x66, 0x20, 0xF3, 0x00, 0x04, 0x51,
+            0x50, 0x70, 0x01, 0x82, 0x13, 0x80, 0x0B, 0x08, 0x24, 0x01,
+            0x01, 0x00, 0x03, 0x2A, 0x02, 0x01, 0x48, 0x69,
+        },
+        .expected =
+        {
+            .result = LE_OK,
+            .encoding = SMSPDU_8_BITS,
+            .message =
+            {
+                .type = PA_SMS_DELIVER,
+                .smsDeliver =
+                {
+                    .oa = "+33688266023",
+                    .format = LE_SMS_FORMAT_BINARY,
+                    .scts = "15/05/07,10:28:31+08",
+                    .data = "Hi",
+                    .dataLen = 2,
+                },
+            },
+        },
+    },
+    /* 16 */
+    /*
+     * 07913386094000F0440B913386286620F3000451507001821380080500072A02014869
+     *
+     * SMS DELIVER (receive)
+     * SMSC: 33689004000
+     * Sender: 33688266023
+     * TimeStamp: 07/05/15 10:28:31 GMT +02:00
+     * TP-PID: 00
+     * TP-DCS: 04
+     * Alphabet: 8bit
+     * User Data Header: 05 00 07 2A 02 01
+     *
+     * Concatenation information element longer than the User Data Header
+     */
+    {
+        .checkLength = false, /* SMS not supported */
+        .checkData = false, /* SMS not supported */
+        .proto = PA_SMS_PROTOCOL_GSM,
+        .length = 35,
+        .data =
+        {
+            0x07, 0x91, 0x33, 0x86, 0x09, 0x40, 0x00, 0xF0, 0x44, 0x0B,
+            0x91, 0x33, 0x86, 0x28, 0x66, 0x20, 0xF3, 0x00, 0x04, 0x51,
+            0x50, 0x70, 0x01, 0x82, 0x13, 0x80, 0x08, 0x05, 0x00, 0x07,
+            0x2A, 0x02, 0x01, 0x48, 0x69,
+        },
+        .expected =
+        {
+            .result = LE_UNSUPPORTED,
+            .encoding = SMSPDU_8_BITS,
+            .message =
+            {
+                .type = PA_SMS_DELIVER,
+                .smsDeliver =
+                {
+                    .oa = "+33688266023",
+                    .format = LE_SMS_FORMAT_BINARY,
+                    .scts = "15/05/07,10:28:31+08",
+                    .data = "",
+                    .dataLen = 8,
+                },
+            },
+        },
+    },
+    /* 17 */
+    /*
+     * 07913386094000F0440B913386286620F3000451507001821380313000032A0201
+     *
+     * SMS DELIVER (receive)
+     * SMSC: 33689004000
+     * Sender: 33688266023
+     * TimeStamp: 07/05/15 10:28:31 GMT +02:00
+     * TP-PID: 00
+     * TP-DCS: 04
+     * Alphabet: 8bit
+     * User Data Header: 30 00 03 2A 02 01
+     *
+     * User Data Header longer than the PDU
+     */
+    {
+        .checkLength = false, /* SMS not supported */
+        .checkData = false, /* SMS not supported */
+        .proto = PA_SMS_PROTOCOL_GSM,
+        .length = 33,
+        .data =
+        {
+            0x07, 0x91, 0x33, 0x86, 0x09, 0x40, 0x00, 0xF0, 0x44, 0x0B,
+            0x91, 0x33, 0x86, 0x28, 0x66, 0x20, 0xF3, 0x00, 0x04, 0x51,
+            0x50, 0x70, 0x01, 0x82, 0x13, 0x80, 0x31, 0x30, 0x00, 0x03,
+            0x2A, 0x02, 0x01,
+        },
+        .expected =
+        {
+            .result = LE_UNSUPPORTED,
+            .encoding = SMSPDU_8_BITS,
+            .message =
+            {
+                .type = PA_SMS_DELIVER,
+                .smsDeliver =
+                {
+                    .oa = "+33688266023",
+                    .format = LE_SMS_FORMAT_BINARY,
+                    .scts = "15/05/07,10:28:31+08",
+                    .data = "",
+                    .dataLen = 49,
+                },
+            },
+        },
+    },
 };
 
 static le_result_t TestDecodePdu
@@ -2097,6 +2294,188 @@ static le_result_t TestEncodePdu
     return LE_OK;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Encode a message, decode the PDU and check that the original message is back
+ *
+ * @return
+ *      - LE_OK the encoding returned the expected result, and the message is back
+ *      - LE_FAULT otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t RoundTripPdu
+(
+    smsPdu_DataToEncode_t* dataPtr,         ///< [IN] Message to encode
+    le_result_t expected,                   ///< [IN] Expected result of the encoding
+    le_sms_Format_t format                  ///< [IN] Expected format of the decoded message
+)
+{
+    pa_sms_Pdu_t pdu;
+    pa_sms_Message_t message;
+    const uint8_t* decodedPtr;
+    uint32_t decodedLen;
+    le_sms_Format_t decodedFormat;
+    le_result_t res;
+
+    res = smsPdu_Encode(dataPtr, &pdu);
+    if (res != expected)
+    {
+        LE_ERROR("smsPdu_Encode() returns %d, expected %d (encoding %d, length %u)",
+                 res, expected, dataPtr->encoding, dataPtr->length);
+        return LE_FAULT;
+    }
+
+    if (res != LE_OK)
+    {
+        return LE_OK;
+    }
+
+    res = smsPdu_Decode(PA_SMS_PROTOCOL_GSM, pdu.data, pdu.dataLen, true, &message);
+    if ((res != LE_OK) || (message.type != dataPtr->messageType))
+    {
+        LE_ERROR("smsPdu_Decode() returns %d, type %d", res, message.type);
+        DumpPdu("Pdu encoded:", pdu.data, pdu.dataLen);
+        return LE_FAULT;
+    }
+
+    if (message.type == PA_SMS_DELIVER)
+    {
+        decodedPtr = message.smsDeliver.data;
+        decodedLen = message.smsDeliver.dataLen;
+        decodedFormat = message.smsDeliver.format;
+    }
+    else
+    {
+        decodedPtr = message.smsSubmit.data;
+        decodedLen = message.smsSubmit.dataLen;
+        decodedFormat = message.smsSubmit.format;
+    }
+
+    if ((decodedFormat != format) || (decodedLen != dataPtr->length) ||
+        (memcmp(decodedPtr, dataPtr->messagePtr, decodedLen) != 0))
+    {
+        LE_ERROR("Message doesn't match (format %d, length %u/%u)",
+                 decodedFormat, decodedLen, dataPtr->length);
+        DumpPdu("Message:", dataPtr->messagePtr, dataPtr->length);
+        DumpPdu("Pdu encoded:", pdu.data, pdu.dataLen);
+        return LE_FAULT;
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Encode and decode random messages of all lengths, in GSM 7 bits, 8 bits and UCS2.
+ *
+ * The chars of the GSM 7 bits alphabet, and the number of septets of each one, are found by
+ * encoding them one by one.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t TestRoundTripPdu
+(
+    void
+)
+{
+    uint8_t charset[UINT8_MAX];
+    uint8_t septets[UINT8_MAX + 1];
+    uint8_t text[LE_SMS_TEXT_MAX_LEN];
+    size_t charsetLen = 0;
+    smsPdu_DataToEncode_t data;
+    pa_sms_Pdu_t pdu;
+    pa_sms_Message_t message;
+    uint32_t refLen;
+    int c;
+    int i;
+
+    memset(&data, 0, sizeof(data));
+    data.protocol = PA_SMS_PROTOCOL_GSM;
+    data.addressPtr = "+33612345678";
+    data.messagePtr = text;
+    data.encoding = SMSPDU_7_BITS;
+    data.messageType = PA_SMS_SUBMIT;
+
+    // Septets of a char are found from the PDU length, 'A' being a single septet
+    text[0] = 'A';
+    data.length = 1;
+    LE_ASSERT_OK(smsPdu_Encode(&data, &pdu));
+    refLen = pdu.dataLen;
+
+    for (c = 1; c <= UINT8_MAX; c++)
+    {
+        text[0] = c;
+
+        if ((smsPdu_Encode(&data, &pdu) != LE_OK) ||
+            (smsPdu_Decode(PA_SMS_PROTOCOL_GSM, pdu.data, pdu.dataLen, true, &message) != LE_OK) ||
+            (message.smsSubmit.dataLen != 1) || (message.smsSubmit.data[0] != c))
+        {
+            continue;
+        }
+
+        septets[c] = 1 + pdu.dataLen - refLen;
+        charset[charsetLen++] = c;
+    }
+
+    LE_INFO("%zu chars in the GSM 7 bits alphabet", charsetLen);
+    if (charsetLen < 100)
+    {
+        return LE_FAULT;
+    }
+
+    srand(ROUND_TRIP_SEED);
+
+    for (i = 0; i < ROUND_TRIP_ITERATIONS; i++)
+    {
+        size_t length = 1 + rand() % LE_SMS_TEXT_MAX_LEN;
+        size_t total = 0;
+        size_t j;
+
+        data.messageType = (rand() % 2) ? PA_SMS_DELIVER : PA_SMS_SUBMIT;
+        data.length = length;
+
+        /* GSM 7 bits, escaped chars being rarer */
+        for (j = 0; j < length; j++)
+        {
+            do
+            {
+                text[j] = charset[rand() % charsetLen];
+            }
+            while ((septets[text[j]] > 1) && (rand() % 4));
+
+            total += septets[text[j]];
+        }
+
+        data.encoding = SMSPDU_7_BITS;
+        if (RoundTripPdu(&data, (total <= MAX_SEPTETS) ? LE_OK : LE_OVERFLOW,
+                         LE_SMS_FORMAT_TEXT) != LE_OK)
+        {
+            return LE_FAULT;
+        }
+
+        /* 8 bits and UCS2 */
+        for (j = 0; j < length; j++)
+        {
+            text[j] = rand();
+        }
+
+        data.encoding = SMSPDU_8_BITS;
+        if (RoundTripPdu(&data, (length <= LE_SMS_PDU_MAX_PAYLOAD) ? LE_OK : LE_OVERFLOW,
+                         LE_SMS_FORMAT_BINARY) != LE_OK)
+        {
+            return LE_FAULT;
+        }
+
+        data.encoding = SMSPDU_UCS2_16_BITS;
+        if (RoundTripPdu(&data, (length <= LE_SMS_PDU_MAX_PAYLOAD) ? LE_OK : LE_OVERFLOW,
+                         LE_SMS_FORMAT_UCS2) != LE_OK)
+        {
+            return LE_FAULT;
+        }
+    }
+
+    return LE_OK;
+}
+
 //--------------------------------------------------------------------------------------------------
 /*
  * SMS PDU encoding and decoding test
@@ -2114,5 +2493,8 @@ void testle_sms_SmsPduTest
     LE_INFO("Test DecodePdu started");
     LE_ASSERT_OK(TestDecodePdu());
 
+    LE_INFO("Test RoundTripPdu started");
+    LE_ASSERT_OK(TestRoundTripPdu());
+
     LE_INFO("smsPduTest SUCCESS");
 }
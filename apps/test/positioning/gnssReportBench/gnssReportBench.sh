@@ -0,0 +1,88 @@
+#!/bin/bash
+
+# GNSS service load benchmark.
+#
+# Runs the gnssReportBench app (5 processes reading every position) with a 10 Hz acquisition rate,
+# reading the positions with one call per data, with position reports and with the shared latest
+# fix in turn, and reports the CPU time the positioning daemon and the subscribers used over the
+# same period in each case.
+#
+# Usage: gnssReportBench.sh <targetAddr> [<seconds>]
+
+LoadTestLib
+
+targetAddr=$1
+seconds=${2:-30}
+appName=gnssReportBench
+procCount=5
+
+OnFail() {
+    echo "GNSS Report Benchmark Failed!"
+}
+
+if [ -z "$targetAddr" ]
+then
+    echo "Usage: $0 <targetAddr> [<seconds>]" >&2
+    exit 1
+fi
+
+# Prints the user + system CPU time of the given processes, in clock ticks.
+GetTicks() {
+    ssh root@$targetAddr "for pid in \$(pidof $1); do cat /proc/\$pid/stat; done" \
+        | awk '{ ticks += $14 + $15 } END { print ticks + 0 }'
+}
+
+# Runs the app with every process reading in the given mode, and prints the CPU use.
+Measure() {
+    local mode=$1
+
+    ssh root@$targetAddr "for i in \$(seq 1 $procCount)
+                          do
+                              $BIN_PATH/config set /apps/$appName/procs/s\$i/envVars/GNSS_READ_MODE $mode
+                          done"
+    CheckRet
+
+    ssh root@$targetAddr "$BIN_PATH/app start $appName"
+    CheckRet
+
+    # Let the processes start and settle.
+    sleep 5
+
+    local startDaemon=$(GetTicks posDaemon)
+    local startSubscribers=$(GetTicks gnssSubscriber)
+    sleep $seconds
+    local endDaemon=$(GetTicks posDaemon)
+    local endSubscribers=$(GetTicks gnssSubscriber)
+
+    ssh root@$targetAddr "$BIN_PATH/app status $appName" | grep -q running
+    CheckRet
+
+    ssh root@$targetAddr "$BIN_PATH/app stop $appName"
+
+    local daemonMs=$(((endDaemon - startDaemon) * 1000 / clockTicks))
+    local subscribersMs=$(((endSubscribers - startSubscribers) * 1000 / clockTicks))
+    echo "$mode: positioning daemon used $daemonMs ms and subscribers $subscribersMs ms of CPU" \
+         "in $seconds s ($(((daemonMs + subscribersMs) / (seconds * 10)))% of one CPU)."
+}
+
+echo "******** GNSS Report Benchmark Starting ***********"
+
+echo "Make sure Legato is running."
+ssh root@$targetAddr "$BIN_PATH/legato start"
+CheckRet
+
+clockTicks=$(ssh root@$targetAddr "getconf CLK_TCK")
+clockTicks=${clockTicks:-100}
+
+# 10 Hz positions.
+ssh root@$targetAddr "$BIN_PATH/gnss stop; $BIN_PATH/gnss set acqRate 100 && $BIN_PATH/gnss start"
+CheckRet
+
+Measure sample
+Measure report
+Measure latestFix
+
+ssh root@$targetAddr "$BIN_PATH/gnss stop"
+
+echo "GNSS Report Benchmark Done!"
+exit 0
@@ -0,0 +1,229 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file gnssSubscriber.c
+ *
+ * GNSS position subscriber for gnssReportBench.sh.  Reads every position with all its data, as
+ * selected by the GNSS_READ_MODE environment variable:
+ *  - "sample": position handler and one le_gnss_Get... call per data, as before position reports.
+ *  - "report": position report handler, the report is the message.
+ *  - "latestFix" (default): shared latest fix read every READ_INTERVAL_MS, without any message.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "interfaces.h"
+#include <sys/mman.h>
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * How often to read the latest fix, in milliseconds: the 10 Hz position rate of the benchmark.
+ */
+//--------------------------------------------------------------------------------------------------
+#define READ_INTERVAL_MS    100
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Latest fix shared with the GNSS service.
+ */
+//--------------------------------------------------------------------------------------------------
+static const le_gnss_LatestFix_t* LatestFixPtr;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Last sequence read from the latest fix.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t LastSequence;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of positions read, and last position read.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t PositionCount;
+static le_gnss_PositionReport_t LastReport;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Count a position and log the count every 100 positions.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CountPosition
+(
+    void
+)
+{
+    if (0 == (++PositionCount % 100))
+    {
+        LE_INFO("%"PRIu32" positions read, last latitude %"PRId32" longitude %"PRId32,
+                PositionCount, LastReport.latitude, LastReport.longitude);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Position handler reading all the position data with one call per data.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SampleHandler
+(
+    le_gnss_SampleRef_t positionSampleRef,
+    void* contextPtr
+)
+{
+    le_gnss_PositionReport_t* reportPtr = &LastReport;
+    uint16_t satId[LE_GNSS_SV_INFO_MAX_LEN];
+    size_t satIdNumElements = NUM_ARRAY_MEMBERS(satId);
+    le_gnss_Constellation_t satConst[LE_GNSS_SV_INFO_MAX_LEN];
+    size_t satConstNumElements = NUM_ARRAY_MEMBERS(satConst);
+    bool satUsed[LE_GNSS_SV_INFO_MAX_LEN];
+    size_t satUsedNumElements = NUM_ARRAY_MEMBERS(satUsed);
+    uint8_t satSnr[LE_GNSS_SV_INFO_MAX_LEN];
+    size_t satSnrNumElements = NUM_ARRAY_MEMBERS(satSnr);
+    uint16_t satAzim[LE_GNSS_SV_INFO_MAX_LEN];
+    size_t satAzimNumElements = NUM_ARRAY_MEMBERS(satAzim);
+    uint8_t satElev[LE_GNSS_SV_INFO_MAX_LEN];
+    size_t satElevNumElements = NUM_ARRAY_MEMBERS(satElev);
+
+    le_gnss_GetPositionState(positionSampleRef, &reportPtr->fixState);
+    le_gnss_GetLocation(positionSampleRef, &reportPtr->latitude, &reportPtr->longitude,
+                        &reportPtr->hAccuracy);
+    le_gnss_GetAltitude(positionSampleRef, &reportPtr->altitude, &reportPtr->vAccuracy);
+    le_gnss_GetAltitudeOnWgs84(positionSampleRef, &reportPtr->altitudeOnWgs84);
+    le_gnss_GetHorizontalSpeed(positionSampleRef, &reportPtr->hSpeed, &reportPtr->hSpeedAccuracy);
+    le_gnss_GetVerticalSpeed(positionSampleRef, &reportPtr->vSpeed, &reportPtr->vSpeedAccuracy);
+    le_gnss_GetDirection(positionSampleRef, &reportPtr->direction, &reportPtr->directionAccuracy);
+    le_gnss_GetMagneticDeviation(positionSampleRef, &reportPtr->magneticDeviation);
+    le_gnss_GetDate(positionSampleRef, &reportPtr->year, &reportPtr->month, &reportPtr->day);
+    le_gnss_GetTime(positionSampleRef, &reportPtr->hours, &reportPtr->minutes,
+                    &reportPtr->seconds, &reportPtr->milliseconds);
+    le_gnss_GetEpochTime(positionSampleRef, &reportPtr->epochTime);
+    le_gnss_GetGpsTime(positionSampleRef, &reportPtr->gpsWeek, &reportPtr->gpsTimeOfWeek);
+    le_gnss_GetTimeAccuracy(positionSampleRef, &reportPtr->timeAccuracy);
+    le_gnss_GetGpsLeapSeconds(positionSampleRef, &reportPtr->leapSeconds);
+    le_gnss_GetDilutionOfPrecision(positionSampleRef, LE_GNSS_HDOP, &reportPtr->hdop);
+    le_gnss_GetDilutionOfPrecision(positionSampleRef, LE_GNSS_VDOP, &reportPtr->vdop);
+    le_gnss_GetDilutionOfPrecision(positionSampleRef, LE_GNSS_PDOP, &reportPtr->pdop);
+    le_gnss_GetDilutionOfPrecision(positionSampleRef, LE_GNSS_GDOP, &reportPtr->gdop);
+    le_gnss_GetDilutionOfPrecision(positionSampleRef, LE_GNSS_TDOP, &reportPtr->tdop);
+    le_gnss_GetSatellitesStatus(positionSampleRef, &reportPtr->satsInViewCount,
+                                &reportPtr->satsTrackingCount, &reportPtr->satsUsedCount);
+    le_gnss_GetSatellitesInfo(positionSampleRef,
+                              satId, &satIdNumElements,
+                              satConst, &satConstNumElements,
+                              satUsed, &satUsedNumElements,
+                              satSnr, &satSnrNumElements,
+                              satAzim, &satAzimNumElements,
+                              satElev, &satElevNumElements);
+    le_gnss_ReleaseSampleRef(positionSampleRef);
+
+    CountPosition();
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Position report handler.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReportHandler
+(
+    const le_gnss_PositionReport_t* reportPtr,
+    void* contextPtr
+)
+{
+    LastReport = *reportPtr;
+    CountPosition();
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the latest fix, if it has changed since the last read.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReadLatestFix
+(
+    le_timer_Ref_t timerRef
+)
+{
+    uint32_t sequence;
+
+    do
+    {
+        sequence = __atomic_load_n(&LatestFixPtr->sequence, __ATOMIC_ACQUIRE);
+        if (sequence == LastSequence)
+        {
+            return;
+        }
+        memcpy(&LastReport, &LatestFixPtr->report, sizeof(LastReport));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    }
+    while ((sequence & 1) || (sequence != __atomic_load_n(&LatestFixPtr->sequence,
+                                                          __ATOMIC_RELAXED)));
+
+    LastSequence = sequence;
+    CountPosition();
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Map the latest fix.
+ *
+ * @return The latest fix, or NULL if it is not available.
+ */
+//--------------------------------------------------------------------------------------------------
+static const le_gnss_LatestFix_t* OpenLatestFix
+(
+    void
+)
+{
+    int fd;
+    le_result_t result = le_gnss_OpenLatestFix(&fd);
+
+    if (LE_OK != result)
+    {
+        LE_WARN("No latest fix (%s).", LE_RESULT_TXT(result));
+        return NULL;
+    }
+
+    const le_gnss_LatestFix_t* latestFixPtr = mmap(NULL, sizeof(*latestFixPtr), PROT_READ,
+                                                   MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (MAP_FAILED == latestFixPtr)
+    {
+        LE_WARN("Cannot map the latest fix (%m).");
+        return NULL;
+    }
+
+    return latestFixPtr;
+}
+
+COMPONENT_INIT
+{
+    const char* modePtr = getenv("GNSS_READ_MODE");
+
+    if ((NULL != modePtr) && (0 == strcmp(modePtr, "sample")))
+    {
+        le_gnss_AddPositionHandler(SampleHandler, NULL);
+    }
+    else if ((NULL != modePtr) && (0 == strcmp(modePtr, "report")))
+    {
+        le_gnss_AddPositionReportHandler(ReportHandler, NULL);
+    }
+    else
+    {
+        LatestFixPtr = OpenLatestFix();
+        LE_FATAL_IF(NULL == LatestFixPtr, "Latest fix mode is not available.");
+
+        le_timer_Ref_t timerRef = le_timer_Create("readLatestFix");
+        le_timer_SetMsInterval(timerRef, READ_INTERVAL_MS);
+        le_timer_SetRepeat(timerRef, 0);
+        le_timer_SetHandler(timerRef, ReadLatestFix);
+        le_timer_Start(timerRef);
+        modePtr = "latestFix";
+    }
+
+    LE_INFO("Reading positions in %s mode.", modePtr);
+}
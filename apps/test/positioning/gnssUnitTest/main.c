@@ -11,6 +11,7 @@
 #include "pa_gnss_simu.h"
 #include "le_gnss_local.h"
 #include "le_log.h"
+#include <sys/mman.h>
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -91,6 +92,23 @@ static le_gnss_SampleRef_t GnssPositionSampleRef;
 //--------------------------------------------------------------------------------------------------
 static le_gnss_PositionHandlerRef_t GnssPositionHandlerRef = NULL;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Position report handler's reference.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static le_gnss_PositionReportHandlerRef_t GnssPositionReportHandlerRef = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Last position report received by the position report handler, and number of reports received.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static le_gnss_PositionReport_t LastPositionReport;
+static uint32_t PositionReportCount = 0;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Thread and semaphore reference.
@@ -438,6 +456,103 @@ static void Testle_gnss_SetDataResolution
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler function for Position report Notifications.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void GnssPositionReportHandlerFunction
+(
+    const le_gnss_PositionReport_t* reportPtr,
+    void* contextPtr
+)
+{
+    LE_ASSERT(NULL != reportPtr);
+    memcpy(&LastPositionReport, reportPtr, sizeof(LastPositionReport));
+    PositionReportCount++;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test: le_gnss_GetPositionReport() returns the values of the le_gnss_Get... functions, and the
+ * position report handler, called before the position handler, got the same report.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Testle_gnss_GetPositionReport
+(
+    le_gnss_SampleRef_t positionSampleRef
+)
+{
+    le_gnss_PositionReport_t report;
+    le_gnss_SatelliteReport_t satellites[LE_GNSS_SV_INFO_MAX_LEN];
+    size_t satellitesNumElements = NUM_ARRAY_MEMBERS(satellites);
+    int32_t latitude, longitude, hAccuracy, altitude, vAccuracy, vSpeed, vSpeedAccuracy;
+    uint32_t hSpeed, hSpeedAccuracy;
+    uint16_t hours, minutes, seconds, milliseconds, dop;
+    uint8_t satsInViewCount, satsTrackingCount, satsUsedCount;
+    le_gnss_FixState_t state;
+
+    // The position report handler was added by CLIENT1.
+    le_gnss_SetClientSimu(CLIENT1);
+
+    // Pass invalid sample reference
+    LE_ASSERT(LE_FAULT == le_gnss_GetPositionReport(GnssPositionSampleRef, &report,
+                                                    satellites, &satellitesNumElements));
+    LE_ASSERT_OK(le_gnss_GetPositionReport(positionSampleRef, &report,
+                                           satellites, &satellitesNumElements));
+    LE_ASSERT(satellitesNumElements <= LE_GNSS_SV_INFO_MAX_LEN);
+
+    LE_ASSERT_OK(le_gnss_GetPositionState(positionSampleRef, &state));
+    LE_ASSERT(state == report.fixState);
+
+    if (LE_OK == le_gnss_GetLocation(positionSampleRef, &latitude, &longitude, &hAccuracy))
+    {
+        LE_ASSERT(report.validity & LE_GNSS_REPORT_LOCATION);
+        LE_ASSERT(report.validity & LE_GNSS_REPORT_H_ACCURACY);
+        LE_ASSERT((latitude == report.latitude) && (longitude == report.longitude));
+        LE_ASSERT(hAccuracy == report.hAccuracy);
+    }
+    le_gnss_GetAltitude(positionSampleRef, &altitude, &vAccuracy);
+    LE_ASSERT((altitude == report.altitude) && (vAccuracy == report.vAccuracy));
+    le_gnss_GetHorizontalSpeed(positionSampleRef, &hSpeed, &hSpeedAccuracy);
+    LE_ASSERT((hSpeed == report.hSpeed) && (hSpeedAccuracy == report.hSpeedAccuracy));
+    le_gnss_GetVerticalSpeed(positionSampleRef, &vSpeed, &vSpeedAccuracy);
+    LE_ASSERT((vSpeed == report.vSpeed) && (vSpeedAccuracy == report.vSpeedAccuracy));
+    le_gnss_GetTime(positionSampleRef, &hours, &minutes, &seconds, &milliseconds);
+    LE_ASSERT((hours == report.hours) && (minutes == report.minutes));
+    LE_ASSERT((seconds == report.seconds) && (milliseconds == report.milliseconds));
+    le_gnss_GetDilutionOfPrecision(positionSampleRef, LE_GNSS_HDOP, &dop);
+    LE_ASSERT(dop == report.hdop);
+    le_gnss_GetDilutionOfPrecision(positionSampleRef, LE_GNSS_PDOP, &dop);
+    LE_ASSERT(dop == report.pdop);
+    le_gnss_GetSatellitesStatus(positionSampleRef, &satsInViewCount, &satsTrackingCount,
+                                &satsUsedCount);
+    LE_ASSERT(satsInViewCount == report.satsInViewCount);
+    LE_ASSERT(satsTrackingCount == report.satsTrackingCount);
+    LE_ASSERT(satsUsedCount == report.satsUsedCount);
+
+    if (satellitesNumElements)
+    {
+        uint16_t satId[LE_GNSS_SV_INFO_MAX_LEN];
+        size_t satIdNumElements = satellitesNumElements;
+        size_t i;
+
+        LE_ASSERT(report.validity & LE_GNSS_REPORT_SAT_INFO);
+        LE_ASSERT_OK(le_gnss_GetSatellitesInfo(positionSampleRef, satId, &satIdNumElements,
+                                               NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+                                               NULL, NULL));
+        for (i = 0; i < satellitesNumElements; i++)
+        {
+            LE_ASSERT(satId[i] == satellites[i].satId);
+        }
+        LE_ASSERT(0 != satellites[satellitesNumElements - 1].satId);
+    }
+
+    LE_ASSERT(PositionReportCount > 0);
+    LE_ASSERT(0 == memcmp(&LastPositionReport, &report, sizeof(report)));
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Handler function for Position Notifications.
@@ -659,6 +774,9 @@ static void GnssPositionHandlerFunction
                                         &satElevNumElements);
     LE_ASSERT((LE_OK == result) || (LE_OUT_OF_RANGE == result));
 
+    LE_INFO("======== GNSS GetPositionReport ========");
+    Testle_gnss_GetPositionReport(positionSampleRef);
+
     LE_INFO("======== GNSS SetGetDOPResolution ========");
     Testle_gnss_SetGetDOPResolution(positionSampleRef);
 
@@ -703,6 +821,9 @@ static void* AppHandler
     // Subscribe position handler
     GnssPositionHandlerRef = le_gnss_AddPositionHandler(GnssPositionHandlerFunction, NULL);
     LE_ASSERT(NULL != GnssPositionHandlerRef);
+    GnssPositionReportHandlerRef = le_gnss_AddPositionReportHandler(
+                                                    GnssPositionReportHandlerFunction, NULL);
+    LE_ASSERT(NULL != GnssPositionReportHandlerRef);
     UNLOCK
     // Semaphore is used to synchronize the task execution with the core test
     le_sem_Post(ThreadSemaphore);
@@ -751,6 +872,132 @@ static void Testset_gnss_PositionData
     SynchTest();
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that a shared memory returned by the service cannot be written by a client, neither
+ * through its file descriptor nor by reopening it.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckReadOnlyMemory
+(
+    int     fd,             ///< [IN] File descriptor returned by the service.
+    size_t  size            ///< [IN] Size of the memory.
+)
+{
+    char path[32];
+
+    LE_ASSERT(MAP_FAILED == mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+
+    snprintf(path, sizeof(path), "/proc/self/fd/%d", fd);
+    int rwFd = open(path, O_RDWR | O_CLOEXEC);
+
+    if (0 != geteuid())
+    {
+        LE_ASSERT(rwFd < 0);
+    }
+    else if (rwFd >= 0)
+    {
+        // Permissions do not apply to root, the memory is sealed against writes.
+        LE_ASSERT(MAP_FAILED == mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, rwFd, 0));
+        LE_ASSERT(write(rwFd, "", 1) < 0);
+        close(rwFd);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test: the latest fix shared memory is updated at each position.
+ *
+ * API tested:
+ * - le_gnss_OpenLatestFix
+ */
+//--------------------------------------------------------------------------------------------------
+static void Testle_gnss_LatestFix
+(
+    void
+)
+{
+    const le_gnss_LatestFix_t* latestFixPtr;
+    le_gnss_PositionReport_t report;
+    le_gnss_FixState_t state;
+    uint32_t sequence;
+    int fd;
+
+    LOCK
+    LE_ASSERT_OK(le_gnss_OpenLatestFix(&fd));
+    UNLOCK
+    LE_ASSERT(fd >= 0);
+
+    // The latest fix is read-only for the clients.
+    CheckReadOnlyMemory(fd, sizeof(le_gnss_LatestFix_t));
+    latestFixPtr = mmap(NULL, sizeof(le_gnss_LatestFix_t), PROT_READ, MAP_SHARED, fd, 0);
+    LE_ASSERT(MAP_FAILED != latestFixPtr);
+    close(fd);
+
+    // The last position is published as soon as the latest fix is opened.
+    sequence = __atomic_load_n(&latestFixPtr->sequence, __ATOMIC_ACQUIRE);
+    LE_ASSERT((0 != sequence) && (0 == (sequence & 1)));
+
+    pa_gnssSimu_ReportEvent();
+    SynchTest();
+
+    LE_ASSERT(sequence + 2 == __atomic_load_n(&latestFixPtr->sequence, __ATOMIC_ACQUIRE));
+    memcpy(&report, &latestFixPtr->report, sizeof(report));
+
+    le_gnss_SampleRef_t positionSampleRef = le_gnss_GetLastSampleRef();
+    LE_ASSERT_OK(le_gnss_GetPositionState(positionSampleRef, &state));
+    LE_ASSERT(state == report.fixState);
+    if (report.validity & LE_GNSS_REPORT_LOCATION)
+    {
+        int32_t latitude, longitude;
+
+        le_gnss_GetLocation(positionSampleRef, &latitude, &longitude, NULL);
+        LE_ASSERT((latitude == report.latitude) && (longitude == report.longitude));
+    }
+    le_gnss_ReleaseSampleRef(positionSampleRef);
+
+    munmap((void*)latestFixPtr, sizeof(le_gnss_LatestFix_t));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test: the NMEA records ring is shared read-only with the clients.
+ *
+ * API tested:
+ * - le_gnss_OpenNmeaRecords
+ */
+//--------------------------------------------------------------------------------------------------
+static void Testle_gnss_NmeaRecords
+(
+    void
+)
+{
+    size_t size = sizeof(le_gnss_NmeaRing_t) + LE_GNSS_NMEA_RING_SLOTS * sizeof(le_gnss_NmeaSlot_t);
+    const le_gnss_NmeaRing_t* ringPtr;
+    int fd;
+
+    LOCK
+    LE_ASSERT_OK(le_gnss_OpenNmeaRecords(&fd));
+    UNLOCK
+    LE_ASSERT(fd >= 0);
+
+    CheckReadOnlyMemory(fd, size);
+    ringPtr = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    LE_ASSERT(MAP_FAILED != ringPtr);
+    close(fd);
+
+    LE_ASSERT(LE_GNSS_NMEA_RING_SLOTS == ringPtr->slotCount);
+
+    // A second client shares the same ring.
+    LOCK
+    LE_ASSERT_OK(le_gnss_OpenNmeaRecords(&fd));
+    UNLOCK
+    LE_ASSERT(fd >= 0);
+    close(fd);
+
+    munmap((void*)ringPtr, size);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Test: this function handles the remove position handler
@@ -766,6 +1013,8 @@ static void RemoveHandler
     LOCK
     le_gnss_RemovePositionHandler(GnssPositionHandlerRef);
     GnssPositionHandlerRef = NULL;
+    le_gnss_RemovePositionReportHandler(GnssPositionReportHandlerRef);
+    GnssPositionReportHandlerRef = NULL;
     UNLOCK
     // Semaphore is used to synchronize the task execution with the core test
     le_sem_Post(ThreadSemaphore);
@@ -1262,6 +1511,12 @@ COMPONENT_INIT
     LE_INFO("======== GNSS Position Fill the position data ========");
     Testset_gnss_PositionData();
 
+    LE_INFO("======== GNSS Latest fix ========");
+    Testle_gnss_LatestFix();
+
+    LE_INFO("======== GNSS NMEA records ========");
+    Testle_gnss_NmeaRecords();
+
     LE_INFO("======== GNSS Device State Test ========");
     Testle_gnss_GetState();
 
@@ -0,0 +1,505 @@
+/**
+ * This module implements a replay benchmark of the NMEA decoder of the GNSS service.
+ *
+ * A recorded NMEA log is pushed at full speed, one sentence per frame as the platform adaptor
+ * reports it, through the decoder which fills in the NMEA records ring of the GNSS service. A
+ * reader thread reads the ring at the same time, as a client would, and checks every record it
+ * gets against the record decoded from the same sentence beforehand, so that a torn read would be
+ * caught. The number of sentences per second the decoder sustains is then reported, along with
+ * the time a client takes to parse the same log with the C library.
+ *
+ * Usage: nmeaReplayBench [<NMEA log file> [<rounds>]]
+ *
+ * The log file holds one sentence per line. A built-in log is used if none is given.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+#include "gnssNmea.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Default number of times the log is replayed
+ */
+//--------------------------------------------------------------------------------------------------
+#define DEFAULT_ROUNDS 20000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of sentences in a log
+ */
+//--------------------------------------------------------------------------------------------------
+#define LOG_MAX_LINES 4096
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum length of a sentence, the NMEA-0183 maximum being 82 characters
+ */
+//--------------------------------------------------------------------------------------------------
+#define SENTENCE_MAX_LEN 128
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Built-in log, recorded from a GPS and GLONASS receiver at 1 Hz
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* BuiltInLog[] =
+{
+    "$GPGSV,3,1,11,02,62,282,44,05,38,072,41,07,09,320,30,12,17,129,35*7E",
+    "$GPGSV,3,2,11,13,44,215,43,15,67,124,46,18,12,043,29,20,05,257,*7A",
+    "$GPGSV,3,3,11,24,21,084,38,25,54,167,45,29,28,305,40*4F",
+    "$GLGSV,2,1,07,65,31,045,37,66,72,103,42,72,18,330,33,74,42,231,40*69",
+    "$GLGSV,2,2,07,75,63,313,44,76,14,289,31,84,05,020,*5A",
+    "$GNGSA,A,3,02,05,12,13,15,24,25,29,,,,,1.21,0.68,1.00*19",
+    "$GNGSA,A,3,65,66,74,75,,,,,,,,,1.21,0.68,1.00*13",
+    "$GPGGA,093512.00,4851.0032,N,00216.9125,E,1,12,0.68,65.4,M,47.3,M,,*69",
+    "$GPRMC,093512.00,A,4851.0032,N,00216.9125,E,5.21,36.6,191026,1.2,W,A*23",
+    "$GPVTG,36.6,T,35.4,M,5.21,N,9.649,K,A*16",
+    "$GNGNS,093512.00,4851.0032,N,00216.9125,E,AN,15,0.68,65.4,47.3,,*55",
+    "$PQXFI,093512.00,4851.0032,N,00216.9125,E,65.4,4.1,3.2,0.12*60",
+    "$GPGSV,3,1,11,02,62,282,44,05,38,072,41,07,09,320,30,12,17,129,35*7E",
+    "$GPGSV,3,2,11,13,44,215,43,15,67,124,46,18,12,043,29,20,05,257,*7A",
+    "$GPGSV,3,3,11,24,21,084,38,25,54,167,45,29,28,305,40*4F",
+    "$GLGSV,2,1,07,65,31,045,37,66,72,103,42,72,18,330,33,74,42,231,40*69",
+    "$GLGSV,2,2,07,75,63,313,44,76,14,289,31,84,05,020,*5A",
+    "$GNGSA,A,3,02,05,12,13,15,24,25,29,,,,,1.21,0.68,1.00*19",
+    "$GNGSA,A,3,65,66,74,75,,,,,,,,,1.21,0.68,1.00*13",
+    "$GPGGA,093513.00,4851.0047,N,00216.9139,E,1,12,0.68,65.6,M,47.3,M,,*65",
+    "$GPRMC,093513.00,A,4851.0047,N,00216.9139,E,5.34,37.1,191026,1.2,W,A*2F",
+    "$GPVTG,37.1,T,35.4,M,5.34,N,9.890,K,A*1E",
+    "$GNGNS,093513.00,4851.0047,N,00216.9139,E,AN,15,0.68,65.6,47.3,,*59",
+    "$PQXFI,093513.00,4851.0047,N,00216.9139,E,65.6,4.1,3.2,0.12*6C",
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Log sentences, each one framed as the platform adaptor reports it
+ */
+//--------------------------------------------------------------------------------------------------
+static char*  LogFrames[LOG_MAX_LINES];
+static size_t LogLines;
+static size_t LogSize;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Records decoded from the log sentences, in the order they are written in the ring
+ */
+//--------------------------------------------------------------------------------------------------
+static le_gnss_NmeaRecord_t ExpectedRecords[LOG_MAX_LINES];
+static uint32_t             ExpectedCount;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * NMEA records ring, as shared by the GNSS service
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t             RingBuffer[(GNSS_NMEA_RING_SIZE + sizeof(uint64_t) - 1) /
+                                       sizeof(uint64_t)];
+static le_gnss_NmeaRing_t*  RingPtr = (le_gnss_NmeaRing_t*)RingBuffer;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Replay parameters and state
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t Rounds = DEFAULT_ROUNDS;
+static bool     ReplayDone;
+static uint64_t RecordsRead;
+static uint64_t Overflows;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a sentence to the log
+ */
+//--------------------------------------------------------------------------------------------------
+static void AppendLine
+(
+    const char* linePtr,
+    size_t      len
+)
+{
+    if (0 == len)
+    {
+        return;
+    }
+
+    LE_ASSERT(len <= SENTENCE_MAX_LEN);
+    LE_ASSERT(LogLines < LOG_MAX_LINES);
+
+    char* framePtr = malloc(len + 3);
+    LE_ASSERT(framePtr);
+
+    memcpy(framePtr, linePtr, len);
+    memcpy(framePtr + len, "\r\n", 3);
+    LogFrames[LogLines++] = framePtr;
+    LogSize += len + 2;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Load the log, from a file if one is given, or else from the built-in one
+ */
+//--------------------------------------------------------------------------------------------------
+static void LoadLog
+(
+    const char* pathPtr
+)
+{
+    size_t i;
+
+    if (NULL == pathPtr)
+    {
+        for (i = 0; i < NUM_ARRAY_MEMBERS(BuiltInLog); i++)
+        {
+            AppendLine(BuiltInLog[i], strlen(BuiltInLog[i]));
+        }
+        return;
+    }
+
+    FILE* filePtr = fopen(pathPtr, "r");
+    LE_FATAL_IF(NULL == filePtr, "Can't open '%s' (%m)", pathPtr);
+
+    char line[SENTENCE_MAX_LEN + 3];
+
+    while (NULL != fgets(line, sizeof(line), filePtr))
+    {
+        size_t len = strcspn(line, "\r\n");
+
+        AppendLine(line, len);
+    }
+
+    fclose(filePtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode a sentence given as a string
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t Decode
+(
+    const char*             sentencePtr,
+    le_gnss_NmeaRecord_t*   recordPtr
+)
+{
+    return gnssNmea_DecodeSentence(sentencePtr, strlen(sentencePtr), recordPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check the decoding of known sentences
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestDecoder
+(
+    void
+)
+{
+    le_gnss_NmeaRecord_t record;
+
+    LE_ASSERT(LE_OK == Decode("$GPGGA,093512.00,4851.0032,N,00216.9125,E,1,12,0.68,65.4,M,"
+                              "47.3,M,,*69", &record));
+    LE_ASSERT(LE_GNSS_NMEA_GGA == record.sentence);
+    LE_ASSERT(0 == strcmp(record.talker, "GP"));
+    LE_ASSERT(0x1FFE == record.fields);
+    LE_ASSERT((9 == record.gga.hours) && (35 == record.gga.minutes) &&
+              (12 == record.gga.seconds) && (0 == record.gga.milliseconds));
+    LE_ASSERT(48850053 == record.gga.latitude);
+    LE_ASSERT(2281875 == record.gga.longitude);
+    LE_ASSERT((1 == record.gga.quality) && (12 == record.gga.satsUsedCount));
+    LE_ASSERT(68 == record.gga.hdop);
+    LE_ASSERT((65400 == record.gga.altitude) && (47300 == record.gga.geoidSeparation));
+
+    LE_ASSERT(LE_OK == Decode("$GPRMC,093512.00,A,4851.0032,N,00216.9125,E,5.21,36.6,191026,"
+                              "1.2,W,A*23", &record));
+    LE_ASSERT(LE_GNSS_NMEA_RMC == record.sentence);
+    LE_ASSERT(record.rmc.valid);
+    LE_ASSERT((48850053 == record.rmc.latitude) && (2281875 == record.rmc.longitude));
+    LE_ASSERT((268 == record.rmc.hSpeed) && (366 == record.rmc.direction));
+    LE_ASSERT((2026 == record.rmc.year) && (10 == record.rmc.month) && (19 == record.rmc.day));
+    LE_ASSERT(-12 == record.rmc.magneticDeviation);
+    LE_ASSERT('A' == record.rmc.mode);
+
+    LE_ASSERT(LE_OK == Decode("$GPRMC,235959.999,A,3352.1280,S,15112.5430,W,0.00,,010100,,,D*7A",
+                              &record));
+    LE_ASSERT((23 == record.rmc.hours) && (59 == record.rmc.minutes) &&
+              (59 == record.rmc.seconds) && (999 == record.rmc.milliseconds));
+    LE_ASSERT((-33868800 == record.rmc.latitude) && (-151209050 == record.rmc.longitude));
+    LE_ASSERT((0 == record.rmc.hSpeed) && (0 == (record.fields & (1 << 8))));
+    LE_ASSERT((2000 == record.rmc.year) && (1 == record.rmc.month) && (1 == record.rmc.day));
+
+    LE_ASSERT(LE_OK == Decode("$GPVTG,36.6,T,35.4,M,5.21,N,9.649,K,A*16", &record));
+    LE_ASSERT(LE_GNSS_NMEA_VTG == record.sentence);
+    LE_ASSERT((366 == record.vtg.direction) && (354 == record.vtg.magneticDirection));
+    LE_ASSERT((268 == record.vtg.hSpeed) && ('A' == record.vtg.mode));
+
+    LE_ASSERT(LE_OK == Decode("$GNGSA,A,3,02,05,12,13,15,24,25,29,,,,,1.21,0.68,1.00*19",
+                              &record));
+    LE_ASSERT(LE_GNSS_NMEA_GSA == record.sentence);
+    LE_ASSERT(0 == strcmp(record.talker, "GN"));
+    LE_ASSERT(('A' == record.gsa.selectionMode) && (3 == record.gsa.fixType));
+    LE_ASSERT((2 == record.gsa.satId1) && (29 == record.gsa.satId8) && (0 == record.gsa.satId9));
+    LE_ASSERT((121 == record.gsa.pdop) && (68 == record.gsa.hdop) && (100 == record.gsa.vdop));
+
+    LE_ASSERT(LE_OK == Decode("$GPGSV,3,2,11,13,44,215,43,15,67,124,46,18,12,043,29,20,05,257,"
+                              "*7A", &record));
+    LE_ASSERT(LE_GNSS_NMEA_GSV == record.sentence);
+    LE_ASSERT((3 == record.gsv.sentenceCount) && (2 == record.gsv.sentenceNumber) &&
+              (11 == record.gsv.satsInViewCount));
+    LE_ASSERT((13 == record.gsv.sat1.satId) && (44 == record.gsv.sat1.satElev) &&
+              (215 == record.gsv.sat1.satAzim) && (43 == record.gsv.sat1.satSnr));
+    LE_ASSERT((20 == record.gsv.sat4.satId) && (5 == record.gsv.sat4.satElev) &&
+              (257 == record.gsv.sat4.satAzim) && (0 == record.gsv.sat4.satSnr));
+    LE_ASSERT(0x7FFFE == record.fields);
+
+    // Sentences which are not decoded
+    LE_ASSERT(LE_UNSUPPORTED == Decode("$GNGNS,093512.00,4851.0032,N,00216.9125,E,AN,15,0.68,"
+                                       "65.4,47.3,,*55", &record));
+    LE_ASSERT(LE_UNSUPPORTED == Decode("$PQXFI,093512.00,4851.0032,N,00216.9125,E,65.4,4.1,3.2,"
+                                       "0.12*60", &record));
+    LE_ASSERT(LE_UNSUPPORTED == Decode("$PSWI,SA,1,6,0,1.2,1.5*32", &record));
+
+    // Malformed sentences
+    LE_ASSERT(LE_FORMAT_ERROR == Decode("$GPVTG,36.6,T,35.4,M,5.21,N,9.649,K,A*17", &record));
+    LE_ASSERT(LE_FORMAT_ERROR == Decode("$GPVTG,36.6,T,35.4,M,5.21,N,9.649,K,A", &record));
+    LE_ASSERT(LE_FORMAT_ERROR == Decode("GPVTG,36.6,T,35.4,M,5.21,N,9.649,K,A*16", &record));
+    LE_ASSERT(LE_FORMAT_ERROR == Decode("$GPGGA,0935x2.00,4851.0032,N,00216.9125,E,1,12,0.68,"
+                                        "65.4,M,47.3,M,,*20", &record));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check the NMEA records ring when the reader does not keep up with the writer
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestRing
+(
+    void
+)
+{
+    le_gnss_NmeaRecord_t record;
+    le_gnss_NmeaRecord_t written;
+    uint32_t position = 0;
+    uint32_t i;
+
+    gnssNmea_InitRing(RingPtr);
+    LE_ASSERT(LE_GNSS_NMEA_RING_SLOTS == RingPtr->slotCount);
+    LE_ASSERT(LE_NOT_FOUND == gnssNmea_ReadRecord(RingPtr, &position, &record));
+
+    LE_ASSERT(LE_OK == Decode(BuiltInLog[0], &written));
+    for (i = 0; i < LE_GNSS_NMEA_RING_SLOTS + 10; i++)
+    {
+        written.gsv.sentenceNumber = i;
+        gnssNmea_WriteRecord(RingPtr, &written);
+    }
+
+    // The oldest records are lost.
+    LE_ASSERT(LE_OVERFLOW == gnssNmea_ReadRecord(RingPtr, &position, &record));
+    LE_ASSERT(11 == position);
+    for (i = 11; i < LE_GNSS_NMEA_RING_SLOTS + 10; i++)
+    {
+        LE_ASSERT(LE_OK == gnssNmea_ReadRecord(RingPtr, &position, &record));
+        LE_ASSERT(i == record.gsv.sentenceNumber);
+    }
+    LE_ASSERT(LE_NOT_FOUND == gnssNmea_ReadRecord(RingPtr, &position, &record));
+
+    // A frame holding several sentences
+    const char* framePtr = "$GPVTG,36.6,T,35.4,M,5.21,N,9.649,K,A*16\r\n"
+                           "$PSWI,SA,1,6,0,1.2,1.5*32\r\n"
+                           "$GPVTG,37.1,T,35.4,M,5.34,N,9.890,K,A*1E\r\n";
+    LE_ASSERT(2 == gnssNmea_DecodeFrame(RingPtr, framePtr, strlen(framePtr)));
+    LE_ASSERT(LE_OK == gnssNmea_ReadRecord(RingPtr, &position, &record));
+    LE_ASSERT(366 == record.vtg.direction);
+    LE_ASSERT(LE_OK == gnssNmea_ReadRecord(RingPtr, &position, &record));
+    LE_ASSERT(371 == record.vtg.direction);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode the log once, to know the records expected in the ring
+ */
+//--------------------------------------------------------------------------------------------------
+static void ComputeExpectedRecords
+(
+    void
+)
+{
+    size_t i;
+
+    for (i = 0; i < LogLines; i++)
+    {
+        if (LE_OK == gnssNmea_DecodeSentence(LogFrames[i], strcspn(LogFrames[i], "\r\n"),
+                                             &ExpectedRecords[ExpectedCount]))
+        {
+            ExpectedCount++;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse the log as a client parsing the NMEA flow with the C library would.  Returns how long it
+ * took.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_clk_Time_t ParseWithLibc
+(
+    void
+)
+{
+    le_clk_Time_t start = le_clk_GetRelativeTime();
+    char sentence[SENTENCE_MAX_LEN + 3];
+    volatile double sum = 0;
+    size_t i;
+
+    for (i = 0; i < LogLines; i++)
+    {
+        char* savePtr;
+        char* fieldPtr;
+        char* charPtr;
+        unsigned int checksum;
+
+        strcpy(sentence, LogFrames[i]);
+        fieldPtr = strchr(sentence, '*');
+        if ((NULL == fieldPtr) || (1 != sscanf(fieldPtr + 1, "%2x", &checksum)))
+        {
+            continue;
+        }
+        *fieldPtr = '\0';
+        for (charPtr = sentence + 1; '\0' != *charPtr; charPtr++)
+        {
+            checksum ^= (unsigned char)*charPtr;
+        }
+        if (0 != checksum)
+        {
+            continue;
+        }
+
+        for (fieldPtr = strtok_r(sentence + 1, ",", &savePtr);
+             NULL != fieldPtr;
+             fieldPtr = strtok_r(NULL, ",", &savePtr))
+        {
+            sum += strtod(fieldPtr, NULL);
+        }
+    }
+
+    return le_clk_Sub(le_clk_GetRelativeTime(), start);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reader thread: read the ring as a client would, and check every record read
+ */
+//--------------------------------------------------------------------------------------------------
+static void* ReaderThread
+(
+    void* contextPtr
+)
+{
+    le_gnss_NmeaRecord_t record;
+    uint32_t position = 0;
+
+    for (;;)
+    {
+        uint32_t recordPosition = position;
+        le_result_t result = gnssNmea_ReadRecord(RingPtr, &position, &record);
+
+        if (LE_OK == result)
+        {
+            LE_ASSERT(0 == memcmp(&record, &ExpectedRecords[recordPosition % ExpectedCount],
+                                  sizeof(record)));
+            RecordsRead++;
+        }
+        else if (LE_OVERFLOW == result)
+        {
+            Overflows++;
+        }
+        else if (__atomic_load_n(&ReplayDone, __ATOMIC_ACQUIRE))
+        {
+            break;
+        }
+        else
+        {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Main of the test
+ */
+//--------------------------------------------------------------------------------------------------
+COMPONENT_INIT
+{
+    const char* pathPtr = NULL;
+    uint64_t written = 0;
+    uint32_t round;
+    size_t i;
+
+    LE_INFO("====== GNSS NMEA replay benchmark Start ======");
+
+    if (le_arg_NumArgs() >= 1)
+    {
+        pathPtr = le_arg_GetArg(0);
+    }
+    if (le_arg_NumArgs() >= 2)
+    {
+        Rounds = strtoul(le_arg_GetArg(1), NULL, 10);
+        LE_ASSERT(Rounds > 0);
+    }
+
+    TestDecoder();
+    TestRing();
+
+    LoadLog(pathPtr);
+    LE_ASSERT(LogLines > 0);
+
+    ComputeExpectedRecords();
+    LE_ASSERT(ExpectedCount > 0);
+
+    le_clk_Time_t libcTime = ParseWithLibc();
+
+    gnssNmea_InitRing(RingPtr);
+
+    le_thread_Ref_t readerThread = le_thread_Create("NmeaReader", ReaderThread, NULL);
+    le_thread_SetJoinable(readerThread);
+    le_thread_Start(readerThread);
+
+    le_clk_Time_t start = le_clk_GetRelativeTime();
+
+    for (round = 0; round < Rounds; round++)
+    {
+        for (i = 0; i < LogLines; i++)
+        {
+            written += gnssNmea_DecodeFrame(RingPtr, LogFrames[i], strlen(LogFrames[i]));
+        }
+    }
+
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), start);
+
+    __atomic_store_n(&ReplayDone, true, __ATOMIC_RELEASE);
+    le_thread_Join(readerThread, NULL);
+
+    LE_ASSERT(written == (uint64_t)ExpectedCount * Rounds);
+    LE_ASSERT(RecordsRead > 0);
+
+    double sentences = (double)LogLines * Rounds;
+    double seconds = elapsed.sec + elapsed.usec / 1e6;
+    double libcUsec = (libcTime.sec * 1e6 + libcTime.usec) / LogLines;
+
+    LE_INFO("Replayed %.0f sentences (%"PRIu64" records) in %.3f s: %.0f sentences/s, %.1f MB/s",
+            sentences, written, seconds, sentences / seconds,
+            (double)LogSize * Rounds / seconds / 1e6);
+    LE_INFO("Reader: %"PRIu64" records checked, %"PRIu64" overflows", RecordsRead, Overflows);
+    LE_INFO("C library parsing: %.3f us/sentence", libcUsec);
+
+    LE_INFO("====== GNSS NMEA replay benchmark PASSED ======");
+
+    exit(EXIT_SUCCESS);
+}
@@ -15,6 +15,15 @@
 //--------------------------------------------------------------------------------------------------
 static le_pos_MovementHandlerRef_t  NavigationHandlerRef;
 static le_pos_MovementHandlerRef_t  FiftyNavigationHandlerRef;
+static le_pos_MovementSampleHandlerRef_t SampleNavigationHandlerRef;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sample data given to the sample navigation handler
+ */
+//--------------------------------------------------------------------------------------------------
+static le_pos_SampleData_t          NavigationSampleData;
+static bool                         NavigationSampleReceived;
 //--------------------------------------------------------------------------------------------------
 /**
  * Server Service Reference
@@ -788,6 +797,81 @@ static void Testle_pos_GetAcquisitionRate
     LE_ASSERT(acqRate == acquisitionRate);
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that the position sample's data are the ones returned by the accessor functions.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckSampleData
+(
+    le_pos_SampleRef_t positionSampleRef,
+    const le_pos_SampleData_t* dataPtr
+)
+{
+    int32_t latitude, longitude, horizontalAccuracy;
+    uint16_t hrs, min, sec, msec;
+    uint16_t year, month, day;
+    uint32_t heading, headingAccuracy;
+    uint32_t direction, directionAccuracy;
+    int32_t altitude, altitudeAccuracy;
+    uint32_t hSpeed, hSpeedAccuracy;
+    int32_t vSpeed, vSpeedAccuracy;
+    le_pos_FixState_t state;
+
+    LE_ASSERT_OK(le_pos_sample_Get2DLocation(positionSampleRef, &latitude,
+                                             &longitude, &horizontalAccuracy));
+    LE_ASSERT_OK(le_pos_sample_GetTime(positionSampleRef, &hrs, &min, &sec, &msec));
+    LE_ASSERT_OK(le_pos_sample_GetDate(positionSampleRef, &year, &month, &day));
+    LE_ASSERT_OK(le_pos_sample_GetDirection(positionSampleRef, &direction, &directionAccuracy));
+    LE_ASSERT_OK(le_pos_sample_GetAltitude(positionSampleRef, &altitude, &altitudeAccuracy));
+    LE_ASSERT_OK(le_pos_sample_GetHorizontalSpeed(positionSampleRef, &hSpeed, &hSpeedAccuracy));
+    LE_ASSERT_OK(le_pos_sample_GetVerticalSpeed(positionSampleRef, &vSpeed, &vSpeedAccuracy));
+    LE_ASSERT_OK(le_pos_sample_GetFixState(positionSampleRef, &state));
+    LE_ASSERT(LE_OUT_OF_RANGE == (le_pos_sample_GetHeading(positionSampleRef, &heading,
+                                                           &headingAccuracy)));
+
+    LE_ASSERT((le_pos_SampleValidity_t)(LE_POS_SAMPLE_LOCATION | LE_POS_SAMPLE_H_ACCURACY |
+                                        LE_POS_SAMPLE_ALTITUDE | LE_POS_SAMPLE_V_ACCURACY |
+                                        LE_POS_SAMPLE_H_SPEED | LE_POS_SAMPLE_H_SPEED_ACCURACY |
+                                        LE_POS_SAMPLE_V_SPEED | LE_POS_SAMPLE_V_SPEED_ACCURACY |
+                                        LE_POS_SAMPLE_DIRECTION |
+                                        LE_POS_SAMPLE_DIRECTION_ACCURACY |
+                                        LE_POS_SAMPLE_DATE | LE_POS_SAMPLE_TIME)
+              == dataPtr->validity);
+    LE_ASSERT(state == dataPtr->fixState);
+    LE_ASSERT((latitude == dataPtr->latitude) && (longitude == dataPtr->longitude));
+    LE_ASSERT(horizontalAccuracy == dataPtr->hAccuracy);
+    LE_ASSERT((altitude == dataPtr->altitude) && (altitudeAccuracy == dataPtr->vAccuracy));
+    LE_ASSERT((hSpeed == dataPtr->hSpeed) && (hSpeedAccuracy == dataPtr->hSpeedAccuracy));
+    LE_ASSERT((vSpeed == dataPtr->vSpeed) && (vSpeedAccuracy == dataPtr->vSpeedAccuracy));
+    LE_ASSERT((heading == dataPtr->heading) && (headingAccuracy == dataPtr->headingAccuracy));
+    LE_ASSERT((direction == dataPtr->direction) &&
+              (directionAccuracy == dataPtr->directionAccuracy));
+    LE_ASSERT((year == dataPtr->year) && (month == dataPtr->month) && (day == dataPtr->day));
+    LE_ASSERT((hrs == dataPtr->hours) && (min == dataPtr->minutes) &&
+              (sec == dataPtr->seconds) && (msec == dataPtr->milliseconds));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler function for Navigation notification with the position sample's data.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void SampleNavigationHandler
+(
+    const le_pos_SampleData_t* dataPtr,
+    void* contextPtr
+)
+{
+    LE_ASSERT(NULL != dataPtr);
+
+    // Checked by the navigation handler, which is given the same sample
+    NavigationSampleData = *dataPtr;
+    NavigationSampleReceived = true;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Handler function for Navigation notification.
@@ -899,6 +983,15 @@ static void NavigationHandler
     LE_ASSERT_OK(le_pos_sample_GetFixState(positionSampleRef, &state));
     LE_ASSERT(LE_OUT_OF_RANGE == (le_pos_sample_GetHeading(positionSampleRef, &heading,
                                                            &headingAccuracy)));
+
+    // test of the bulk accessor, and of the data given to the sample navigation handler
+    le_pos_SampleData_t data;
+    LE_ASSERT(LE_BAD_PARAMETER == le_pos_sample_GetData(NULL, &data));
+    LE_ASSERT_OK(le_pos_sample_GetData(positionSampleRef, &data));
+    CheckSampleData(positionSampleRef, &data);
+    LE_ASSERT(NavigationSampleReceived);
+    CheckSampleData(positionSampleRef, &NavigationSampleData);
+
     le_pos_sample_Release(positionSampleRef);
     le_sem_Post(ThreadSemaphore);
 }
@@ -931,6 +1024,13 @@ static void* NavigationThread
     // Test that the acquisitionRate is 4000 msec.
     LE_ASSERT(4000 == le_pos_GetAcquisitionRate());
 
+    // Test the registration of an handler given the position sample's data. It is registered
+    // before NavigationHandler, which checks the data it receives.
+    LE_ASSERT(NULL == le_pos_AddMovementSampleHandler(0, 0, NULL, NULL));
+    SampleNavigationHandlerRef = le_pos_AddMovementSampleHandler(0, 0, SampleNavigationHandler,
+                                                                 NULL);
+    LE_ASSERT(SampleNavigationHandlerRef != NULL);
+
     // Test the registration of an handler for movement notifications with horizontal or vertical
     // magnitude of 0 meters. (It will set an acquisition rate of 1sec).
     NavigationHandlerRef = le_pos_AddMovementHandler(0, 0, NavigationHandler, NULL);
@@ -1001,6 +1101,11 @@ static void RemoveHandler
 
     FiftyNavigationHandlerRef = NULL;
 
+    // test for Remove Handler of the position sample's data
+    le_pos_RemoveMovementSampleHandler(SampleNavigationHandlerRef);
+
+    SampleNavigationHandlerRef = NULL;
+
     // Semaphore is used to synchronize the task execution with the core test
     le_sem_Post(ThreadSemaphore);
 }
@@ -0,0 +1,388 @@
+/**
+ * This module implements a benchmark of the message store of the SMS Inbox service.
+ *
+ * A message box is filled with messages, then the store is reopened to time the loading of its
+ * index. The message box is browsed, reading every message and marking it as read, then every
+ * other message is deleted while browsing it, as a client would. The log is compacted, a torn
+ * record at its end is checked to be dropped when the store is reopened, and the remaining messages
+ * are deleted.
+ *
+ * The same browse and delete are timed on the layout of earlier versions of the service, one
+ * Jansson file per message plus a Jansson list of the messages of the message box, which are read
+ * and rewritten on each operation.
+ *
+ * Usage: smsInboxStoreBench [<messages>]
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+#include "smsStore.h"
+
+#include "le_hex.h"
+#include "jansson.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Default number of messages in the message box
+ */
+//--------------------------------------------------------------------------------------------------
+#define DEFAULT_MESSAGES 5000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Benchmark directory
+ */
+//--------------------------------------------------------------------------------------------------
+#define BENCH_PATH "/tmp/smsInboxStoreBench/"
+#define STORE_PATH BENCH_PATH "msgStore.log"
+#define LEGACY_MSG_PATH BENCH_PATH "msg/"
+#define LEGACY_CFG_PATH BENCH_PATH "cfg/bench.json"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Message boxes of the store
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* MboxNames[] = { "bench" };
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of messages
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t Messages = DEFAULT_MESSAGES;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the time elapsed since a start time, in seconds
+ */
+//--------------------------------------------------------------------------------------------------
+static double Elapsed
+(
+    le_clk_Time_t start
+)
+{
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), start);
+
+    return elapsed.sec + elapsed.usec / 1e6;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Build the message of a given rank
+ */
+//--------------------------------------------------------------------------------------------------
+static void BuildMessage
+(
+    uint32_t            rank,
+    smsStore_Message_t* msgPtr
+)
+{
+    memset(msgPtr, 0, sizeof(smsStore_Message_t));
+
+    msgPtr->format = LE_SMS_FORMAT_TEXT;
+    msgPtr->fields = SMSSTORE_FIELD_SENDERTEL | SMSSTORE_FIELD_TIMESTAMP | SMSSTORE_FIELD_DATA;
+    snprintf(msgPtr->imsi, sizeof(msgPtr->imsi), "404445900658964");
+    snprintf(msgPtr->senderTel, sizeof(msgPtr->senderTel), "+3361%07"PRIu32, rank);
+    snprintf(msgPtr->timestamp, sizeof(msgPtr->timestamp), "17/08/29,18:36:41+22");
+    msgPtr->dataLen = snprintf((char*)msgPtr->data, sizeof(msgPtr->data),
+                               "Message %"PRIu32": the quick brown fox jumps over the lazy dog, "
+                               "then runs back to the farm before the farmer wakes up.", rank);
+    msgPtr->msgLen = msgPtr->dataLen;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check a message read from the store
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckMessage
+(
+    uint32_t    msgId,
+    uint32_t    rank
+)
+{
+    smsStore_Message_t expected;
+    smsStore_Message_t message;
+
+    BuildMessage(rank, &expected);
+    LE_ASSERT_OK(smsStore_Read(msgId, &message));
+    LE_ASSERT(message.dataLen == expected.dataLen);
+    LE_ASSERT(0 == memcmp(message.data, expected.data, expected.dataLen));
+    LE_ASSERT(0 == strcmp(message.senderTel, expected.senderTel));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Benchmark the message store
+ */
+//--------------------------------------------------------------------------------------------------
+static void BenchStore
+(
+    void
+)
+{
+    smsStore_Message_t message;
+    uint32_t firstId = 0;
+    uint32_t msgId;
+    uint32_t logSize;
+    uint32_t size;
+    uint32_t garbage;
+    uint32_t i;
+
+    unlink(STORE_PATH);
+    LE_ASSERT_OK(smsStore_Open(STORE_PATH, MboxNames, NUM_ARRAY_MEMBERS(MboxNames)));
+
+    le_clk_Time_t start = le_clk_GetRelativeTime();
+
+    for (i = 0; i < Messages; i++)
+    {
+        BuildMessage(i, &message);
+        LE_ASSERT_OK(smsStore_Add(&message, 1, &msgId));
+
+        if (0 == i)
+        {
+            firstId = msgId;
+        }
+    }
+
+    double addTime = Elapsed(start);
+    smsStore_Close();
+
+    // Reload the index from the log
+    start = le_clk_GetRelativeTime();
+    LE_ASSERT_OK(smsStore_Open(STORE_PATH, MboxNames, NUM_ARRAY_MEMBERS(MboxNames)));
+    double openTime = Elapsed(start);
+
+    LE_ASSERT(smsStore_GetCount(0) == Messages);
+
+    // Browse, read and mark as read every message
+    start = le_clk_GetRelativeTime();
+
+    for (i = 0, msgId = smsStore_GetFirst(0); msgId; i++, msgId = smsStore_GetNext(0, msgId))
+    {
+        LE_ASSERT_OK(smsStore_Read(msgId, &message));
+        LE_ASSERT_OK(smsStore_SetUnread(msgId, 0, false));
+    }
+
+    double browseTime = Elapsed(start);
+
+    LE_ASSERT(i == Messages);
+    CheckMessage(firstId, 0);
+    CheckMessage(firstId + Messages - 1, Messages - 1);
+    LE_ASSERT(!smsStore_IsUnread(firstId, 0));
+
+    // Delete every other message while browsing
+    start = le_clk_GetRelativeTime();
+
+    for (i = 0, msgId = smsStore_GetFirst(0); msgId; i++, msgId = smsStore_GetNext(0, msgId))
+    {
+        if (i % 2)
+        {
+            LE_ASSERT_OK(smsStore_Remove(msgId, 0));
+        }
+    }
+
+    double deleteTime = Elapsed(start);
+
+    LE_ASSERT(smsStore_GetCount(0) == (Messages + 1) / 2);
+    LE_ASSERT(LE_NOT_FOUND == smsStore_Read(firstId + 1, &message));
+
+    smsStore_GetLogSize(&logSize, &garbage);
+
+    start = le_clk_GetRelativeTime();
+    LE_ASSERT_OK(smsStore_Compact());
+    double compactTime = Elapsed(start);
+
+    uint32_t compactedSize;
+    smsStore_GetLogSize(&compactedSize, &garbage);
+    LE_ASSERT(compactedSize < logSize);
+    LE_ASSERT(0 == garbage);
+
+    // Browsing goes on from a message dropped by the compaction
+    LE_ASSERT(smsStore_GetNext(0, firstId + 1) == firstId + 2);
+    CheckMessage(firstId + 2, 2);
+    LE_ASSERT(!smsStore_IsUnread(firstId + 2, 0));
+
+    // A record torn by a power loss is dropped on the next opening
+    BuildMessage(Messages, &message);
+    LE_ASSERT_OK(smsStore_Add(&message, 1, &msgId));
+    smsStore_GetLogSize(&size, &garbage);
+    smsStore_Close();
+
+    LE_ASSERT(0 == truncate(STORE_PATH, size - 1));
+    LE_ASSERT_OK(smsStore_Open(STORE_PATH, MboxNames, NUM_ARRAY_MEMBERS(MboxNames)));
+    LE_ASSERT(smsStore_GetCount(0) == (Messages + 1) / 2);
+    LE_ASSERT(LE_NOT_FOUND == smsStore_Read(msgId, &message));
+
+    // Delete the remaining messages
+    start = le_clk_GetRelativeTime();
+
+    for (msgId = smsStore_GetFirst(0); msgId; msgId = smsStore_GetFirst(0))
+    {
+        LE_ASSERT_OK(smsStore_Remove(msgId, 0));
+    }
+
+    deleteTime += Elapsed(start);
+
+    LE_ASSERT(0 == smsStore_GetCount(0));
+    smsStore_Close();
+    unlink(STORE_PATH);
+
+    LE_INFO("Store: %"PRIu32" messages added in %.3f s, index loaded in %.3f ms",
+            Messages, addTime, openTime * 1e3);
+    LE_INFO("Store: browse and read %.2f us/message, delete %.2f us/message",
+            browseTime * 1e6 / Messages, deleteTime * 1e6 / Messages);
+    LE_INFO("Store: log compacted from %"PRIu32" to %"PRIu32" bytes in %.3f ms",
+            logSize, compactedSize, compactTime * 1e3);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the path of a message file of the legacy layout
+ */
+//--------------------------------------------------------------------------------------------------
+static void GetLegacyPath
+(
+    uint32_t    msgId,
+    char*       pathPtr,
+    size_t      pathSize
+)
+{
+    snprintf(pathPtr, pathSize, LEGACY_MSG_PATH "%08x.json", (unsigned int)msgId);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Benchmark the layout of earlier versions: the message list is loaded at each step of the
+ * browsing, and a message file and the list are rewritten on each change
+ */
+//--------------------------------------------------------------------------------------------------
+static void BenchLegacy
+(
+    void
+)
+{
+    char path[PATH_MAX];
+    json_error_t error;
+    uint32_t i;
+
+    LE_ASSERT(0 == system("rm -rf " BENCH_PATH "msg " BENCH_PATH "cfg && "
+                          "mkdir -p " BENCH_PATH "msg " BENCH_PATH "cfg"));
+
+    json_t* listPtr = json_array();
+
+    for (i = 1; i <= Messages; i++)
+    {
+        smsStore_Message_t message;
+        char hex[2 * SMSSTORE_DATA_MAX_BYTES + 1];
+
+        BuildMessage(i, &message);
+        le_hex_BinaryToString(message.data, message.dataLen, hex, sizeof(hex));
+
+        json_t* msgPtr = json_pack("{s:s, s:i, s:{s:b}, s:{s:b}, s:s, s:s, s:i, s:s}",
+                                   "imsi", message.imsi,
+                                   "format", (int)message.format,
+                                   "isUnread", MboxNames[0], 1,
+                                   "isDeleted", MboxNames[0], 0,
+                                   "senderTel", message.senderTel,
+                                   "timestamp", message.timestamp,
+                                   "msgLen", (int)message.msgLen,
+                                   "text", hex);
+        LE_ASSERT(msgPtr);
+
+        GetLegacyPath(i, path, sizeof(path));
+        LE_ASSERT(0 == json_dump_file(msgPtr, path, JSON_INDENT(1)));
+        json_decref(msgPtr);
+
+        json_array_append_new(listPtr, json_integer(i));
+    }
+
+    json_t* cfgPtr = json_pack("{s:o}", "msgInBox", listPtr);
+    LE_ASSERT(0 == json_dump_file(cfgPtr, LEGACY_CFG_PATH, JSON_INDENT(1)));
+    json_decref(cfgPtr);
+
+    // Browse, read and mark as read every message
+    le_clk_Time_t start = le_clk_GetRelativeTime();
+
+    for (i = 0; ; i++)
+    {
+        cfgPtr = json_load_file(LEGACY_CFG_PATH, 0, &error);
+        LE_ASSERT(cfgPtr);
+        json_t* idPtr = json_array_get(json_object_get(cfgPtr, "msgInBox"), i);
+        uint32_t msgId = json_integer_value(idPtr);
+        json_decref(cfgPtr);
+
+        if (NULL == idPtr)
+        {
+            break;
+        }
+
+        GetLegacyPath(msgId, path, sizeof(path));
+        json_t* msgPtr = json_load_file(path, 0, &error);
+        LE_ASSERT(msgPtr);
+        LE_ASSERT(json_string_value(json_object_get(msgPtr, "text")));
+        json_object_set_new(json_object_get(msgPtr, "isUnread"), MboxNames[0], json_false());
+        LE_ASSERT(0 == json_dump_file(msgPtr, path, JSON_INDENT(1)));
+        json_decref(msgPtr);
+    }
+
+    double browseTime = Elapsed(start);
+    LE_ASSERT(i == Messages);
+
+    // Delete every message
+    start = le_clk_GetRelativeTime();
+
+    for (i = 1; i <= Messages; i++)
+    {
+        GetLegacyPath(i, path, sizeof(path));
+        json_t* msgPtr = json_load_file(path, 0, &error);
+        LE_ASSERT(msgPtr);
+        json_object_set_new(json_object_get(msgPtr, "isDeleted"), MboxNames[0], json_true());
+        LE_ASSERT(0 == json_dump_file(msgPtr, path, JSON_INDENT(1)));
+        json_decref(msgPtr);
+
+        cfgPtr = json_load_file(LEGACY_CFG_PATH, 0, &error);
+        LE_ASSERT(cfgPtr);
+        LE_ASSERT(0 == json_array_remove(json_object_get(cfgPtr, "msgInBox"), 0));
+        LE_ASSERT(0 == json_dump_file(cfgPtr, LEGACY_CFG_PATH, JSON_INDENT(1)));
+        json_decref(cfgPtr);
+
+        unlink(path);
+    }
+
+    double deleteTime = Elapsed(start);
+
+    LE_ASSERT(0 == system("rm -rf " BENCH_PATH "msg " BENCH_PATH "cfg"));
+
+    LE_INFO("Jansson files: browse and read %.2f us/message, delete %.2f us/message",
+            browseTime * 1e6 / Messages, deleteTime * 1e6 / Messages);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Main of the test
+ */
+//--------------------------------------------------------------------------------------------------
+COMPONENT_INIT
+{
+    LE_INFO("====== SMS Inbox message store benchmark Start ======");
+
+    if (le_arg_NumArgs() >= 1)
+    {
+        Messages = strtoul(le_arg_GetArg(0), NULL, 10);
+        LE_ASSERT(Messages > 1);
+    }
+
+    LE_ASSERT(0 == system("mkdir -p " BENCH_PATH));
+
+    BenchStore();
+    BenchLegacy();
+
+    LE_INFO("====== SMS Inbox message store benchmark PASSED ======");
+
+    exit(EXIT_SUCCESS);
+}
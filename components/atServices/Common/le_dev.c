@@ -343,6 +343,115 @@ int32_t le_dev_Write
     return currentSize;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to write several buffers on device (or port) at once
+ *
+ * When the device is non-blocking and not writable, the function waits for it to become writable
+ * for up to timeoutMs milliseconds in total, then returns what has been written so far.
+ *
+ * @return written byte number, or -1 on error
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+ssize_t le_dev_WriteVector
+(
+    Device_t*           devicePtr,    ///< device pointer
+    const struct iovec* iovPtr,       ///< Buffers to write
+    int                 iovCount,     ///< Number of buffers
+    uint32_t            timeoutMs     ///< Time to wait for the device to be writable (0: no wait)
+)
+{
+    ssize_t amount = 0;
+    size_t offset = 0;
+    le_clk_Time_t deadline = { 0, 0 };
+    int i;
+
+    LE_FATAL_IF(devicePtr->fd==-1,"Write Handle error\n");
+
+    if (le_log_GetFilterLevel() == LE_LOG_DEBUG)
+    {
+        for (i = 0; i < iovCount; i++)
+        {
+            PrintBuffer(devicePtr->fd, iovPtr[i].iov_base, iovPtr[i].iov_len);
+        }
+    }
+
+    // Skip the buffers, then the part of the current buffer, already written
+    while (iovCount > 0)
+    {
+        ssize_t sizeWritten;
+
+        if (offset >= iovPtr->iov_len)
+        {
+            offset -= iovPtr->iov_len;
+            iovPtr++;
+            iovCount--;
+            continue;
+        }
+
+#if LE_CONFIG_LINUX
+        if (offset)
+        {
+            sizeWritten = le_fd_Write(devicePtr->fd,
+                                      (uint8_t*)iovPtr->iov_base + offset,
+                                      iovPtr->iov_len - offset);
+        }
+        else
+        {
+            sizeWritten = writev(devicePtr->fd, iovPtr, (iovCount < IOV_MAX) ? iovCount : IOV_MAX);
+        }
+#else
+        sizeWritten = le_fd_Write(devicePtr->fd,
+                                  (uint8_t*)iovPtr->iov_base + offset,
+                                  iovPtr->iov_len - offset);
+#endif
+
+        if (sizeWritten < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            if (errno == EAGAIN)
+            {
+                if (0 == timeoutMs)
+                {
+                    break;
+                }
+
+                le_clk_Time_t now = le_clk_GetRelativeTime();
+
+                if ((0 == deadline.sec) && (0 == deadline.usec))
+                {
+                    le_clk_Time_t timeout = { timeoutMs / 1000, (timeoutMs % 1000) * 1000 };
+                    deadline = le_clk_Add(now, timeout);
+                }
+                else if (!le_clk_GreaterThan(deadline, now))
+                {
+                    LE_WARN("Device not writable for %"PRIu32" ms", timeoutMs);
+                    break;
+                }
+#if LE_CONFIG_LINUX
+                le_clk_Time_t remaining = le_clk_Sub(deadline, now);
+                struct pollfd pollFd = { .fd = devicePtr->fd, .events = POLLOUT };
+                poll(&pollFd, 1, (remaining.sec * 1000) + ((remaining.usec + 999) / 1000));
+#endif
+                continue;
+            }
+
+            LE_ERROR("Cannot write on fd: %s", StrError(errno));
+            return -1;
+        }
+
+        amount += sizeWritten;
+        offset += sizeWritten;
+    }
+
+    return amount;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function must be called to monitor the specified file descriptor
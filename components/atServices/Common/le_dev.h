@@ -8,6 +8,8 @@
 #ifndef LEGATO_LE_DEV_INCLUDE_GUARD
 #define LEGATO_LE_DEV_INCLUDE_GUARD
 
+#include <sys/uio.h>
+
 //--------------------------------------------------------------------------------------------------
 /**
  * device structure
@@ -49,6 +51,22 @@ int32_t le_dev_Write
     uint32_t    size          ///< size of buffer
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to write several buffers on device (or port) at once
+ *
+ * @return written byte number, which is less than the total size of the buffers if the device
+ *         did not become writable within timeoutMs, or -1 on error
+ */
+//--------------------------------------------------------------------------------------------------
+ssize_t le_dev_WriteVector
+(
+    Device_t*           devicePtr,    ///< device pointer
+    const struct iovec* iovPtr,       ///< Buffers to write
+    int                 iovCount,     ///< Number of buffers
+    uint32_t            timeoutMs     ///< Time to wait for the device to be writable (0: no wait)
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function must be called to monitor the specified file descriptor in the calling thread event
@@ -106,6 +106,37 @@
 //--------------------------------------------------------------------------------------------------
 #define UNSOLICITED_POOL_SIZE 10
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pattern prefix tree nodes pool size
+ */
+//--------------------------------------------------------------------------------------------------
+#define TRIE_NODE_POOL_SIZE 64
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the largest buffer holding the responses of a command
+ */
+//--------------------------------------------------------------------------------------------------
+#define RSP_BUFFER_MAX_BYTES 65536
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Room of the largest responses buffer kept for the final response: the intermediate responses
+ * are dropped before the final response can not be added anymore.
+ */
+//--------------------------------------------------------------------------------------------------
+#define RSP_FINAL_RESERVED_BYTES (LE_ATDEFS_RESPONSE_MAX_BYTES + 1 + sizeof(uint32_t))
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sizes of the smaller buffers holding the responses of a command.  Most commands only get a few
+ * short lines.
+ */
+//--------------------------------------------------------------------------------------------------
+#define RSP_BUFFER_MEDIUM_BYTES  8192
+#define RSP_BUFFER_TYPICAL_BYTES 1024
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Rx Buffer length
@@ -206,6 +237,54 @@ typedef struct
 }
 RspString_t;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Responses of a command.
+ *
+ * The lines are stored null-terminated one after the other from the start of a single buffer,
+ * and the offset of each line is stored from the end of the buffer backwards, so that any line is
+ * found without walking the others and all of them can be copied at once.  The buffer is replaced
+ * by a larger one when the two parts meet.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    char*    bufferPtr;     ///< Buffer, NULL if there is no line
+    size_t   bufferSize;    ///< Buffer size
+    size_t   usedBytes;     ///< Bytes used by the lines from the start of the buffer
+    uint32_t count;         ///< Number of lines
+}
+RspLines_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Node of a prefix tree of response patterns.
+ *
+ * Patterns sharing a prefix share the nodes of that prefix, so a line is matched against all the
+ * patterns of a tree by reading each of its characters once, whatever the number of patterns.
+ * The root node stands for the empty pattern.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct TrieNode
+{
+    struct TrieNode* childPtr;      ///< First node for the next character
+    struct TrieNode* siblingPtr;    ///< Next node for the same character position
+    void*            valuePtr;      ///< Value of the pattern ending at this node, NULL if none
+    char             character;     ///< Character of this node
+}
+TrieNode_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Prefix tree match function prototype
+ *
+ * @return
+ *      - true to go on with longer matching patterns
+ *      - false to stop
+ */
+//--------------------------------------------------------------------------------------------------
+typedef bool (*TrieMatchFunc_t)(void* valuePtr, void* contextPtr);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Rx Data structure.
@@ -249,7 +328,7 @@ RxParser_t;
  *
  */
 //--------------------------------------------------------------------------------------------------
-typedef struct
+typedef struct Unsolicited
 {
     le_atClient_UnsolicitedResponseHandlerFunc_t handlerPtr;    ///< Unsolicited handler
     void*         contextPtr;                                   ///< User context
@@ -262,6 +341,11 @@ typedef struct
     DeviceContextPtr_t interfacePtr;                            ///< device context
     le_dls_Link_t link;                                         ///< link in Unsolicited List
     le_msg_SessionRef_t sessionRef;                             ///< client session reference
+    uint32_t      order;                                        ///< Position in Unsolicited List
+    struct Unsolicited* samePatternPtr;                         ///< Next subscription to the
+                                                                ///< same pattern
+    le_dls_Link_t progressLink;                                 ///< link in in-progress list
+    le_dls_Link_t matchLink;                                    ///< link in matched list
 }
 Unsolicited_t;
 
@@ -281,7 +365,14 @@ typedef struct DeviceContext
     RxParser_t      rxParser;           ///< Rx buffer parser context
     le_timer_Ref_t  timerRef;           ///< command timer
     le_dls_List_t   atCommandList;      ///< List of command waiting for execution
+    uint32_t        lineCmdCount;       ///< Commands sent on the current command line
+    le_dls_Link_t*  rspCmdLinkPtr;      ///< Command of the line the last intermediate response
+                                        ///< belonged to
+    uint32_t        rspCmdIdx;          ///< Index of that command in the line
     le_dls_List_t   unsolicitedList;    ///< unsolicited command list
+    le_dls_List_t   unsolInProgressList;///< unsolicited responses being received
+    TrieNode_t*     unsolTriePtr;       ///< unsolicited patterns prefix tree
+    bool            unsolTrieStale;     ///< unsolicited list changed since the tree was built
     le_sem_Ref_t    waitingSemaphore;   ///< semaphore used for synchronization
     le_atClient_DeviceRef_t ref;        ///< reference of the device context
     le_msg_SessionRef_t sessionRef;     ///< client session reference
@@ -296,24 +387,37 @@ DeviceContext_t;
 typedef struct AtCmd
 {
     char                   cmd[LE_ATDEFS_COMMAND_MAX_BYTES];    ///< Command to send
+    size_t                 cmdLen;                              ///< Command length
     le_dls_List_t          ExpectintermediateResponseList;      ///< List of string pattern for
                                                                 ///< intermediate response
     le_dls_List_t          expectResponseList;                  ///< List of str  pattern for final
                                                                 ///< response
+    TrieNode_t*            intermediateTriePtr;                 ///< Intermediate patterns tree
+    TrieNode_t*            finalTriePtr;                        ///< Final patterns tree
     char                   text[LE_ATDEFS_TEXT_MAX_BYTES+1];    ///< text to be sent after >
                                                                 ///< +1 for ctrl-z
     size_t                 textSize;                            ///< size of text to send
     DeviceContext_t*       interfacePtr;                        ///< interface to send the command
     uint32_t               timeout;                             ///< command timeout (in ms)
     le_atClient_CmdRef_t   ref;                                 ///< command reference
-    le_dls_List_t          responseList;                        ///< Responses list
+    RspLines_t             responses;                           ///< Responses
     uint32_t               intermediateIndex;                   ///< current index for intermediate
                                                                 ///< reponses reading
-    uint32_t               responsesCount;                      ///< responses count in responseList
+    uint32_t               responsesCount;                      ///< responses count in responses
     le_sem_Ref_t           endSem;                              ///< end treatment semaphore
     le_result_t            result;                              ///< result operation
     le_dls_Link_t          link;                                ///< link in AT commands list
     le_msg_SessionRef_t    sessionRef;                          ///< client session reference
+    bool                   concatenate;                         ///< can share a command line
+    le_atClient_CommandResultHandlerFunc_t handlerFunc;         ///< completion handler, NULL if
+                                                                ///< sent synchronously
+    void*                  handlerContextPtr;                   ///< completion handler context
+    le_thread_Ref_t        callerThreadRef;                     ///< thread to call the completion
+                                                                ///< handler in
+    bool                   pending;                             ///< sent asynchronously and not
+                                                                ///< completed yet
+    bool                   orphaned;                            ///< client session closed while
+                                                                ///< pending
 }
 AtCmd_t;
 
@@ -339,6 +443,13 @@ static le_mem_PoolRef_t  AtCommandPool;
 //--------------------------------------------------------------------------------------------------
 static le_mem_PoolRef_t  RspStringPool;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool for command responses buffers
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t  RspBufferPool;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Pool for unsolicited response
@@ -346,6 +457,13 @@ static le_mem_PoolRef_t  RspStringPool;
 //--------------------------------------------------------------------------------------------------
 static le_mem_PoolRef_t  UnsolicitedPool;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool for pattern prefix tree nodes
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t  TrieNodePool;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Map for AT commands
@@ -380,6 +498,382 @@ static void UpdateTransitionManager(ClientStatePtr_t  parserStatePtr,
 static void SendLine(RxParserPtr_t charParserPtr);
 static void SendData(RxParserPtr_t charParserPtr);
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function returns the offsets of the lines of a responses buffer. Offset of line i is at
+ * index -1-i.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline uint32_t* RspLinesOffsets
+(
+    RspLines_t* rspPtr
+)
+{
+    return (uint32_t*)(rspPtr->bufferPtr + rspPtr->bufferSize);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function adds a line to the responses of a command.
+ *
+ * @return
+ *      - LE_OK when the line has been added
+ *      - LE_OVERFLOW when the responses buffer is full.  Room is always kept for the final
+ *        response, if its size is at most LE_ATDEFS_RESPONSE_MAX_BYTES.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t RspLinesAdd
+(
+    RspLines_t* rspPtr,     ///< [IN] Responses
+    const char* linePtr,    ///< [IN] Line (need not be null-terminated)
+    size_t      lineSize,   ///< [IN] Line size
+    bool        isFinal     ///< [IN] Whether the line is the final response
+)
+{
+    size_t neededBytes = rspPtr->usedBytes + lineSize + 1 +
+                         (rspPtr->count + 1) * sizeof(uint32_t);
+    size_t maxBytes = isFinal ? RSP_BUFFER_MAX_BYTES :
+                                RSP_BUFFER_MAX_BYTES - RSP_FINAL_RESERVED_BYTES;
+
+    if (neededBytes > maxBytes)
+    {
+        return LE_OVERFLOW;
+    }
+
+    if (neededBytes > rspPtr->bufferSize)
+    {
+        size_t newSize = (rspPtr->bufferSize * 2 > neededBytes) ? rspPtr->bufferSize * 2 :
+                                                                  neededBytes;
+
+        if (newSize > RSP_BUFFER_MAX_BYTES)
+        {
+            newSize = RSP_BUFFER_MAX_BYTES;
+        }
+
+        char* newBufferPtr = le_mem_ForceVarAlloc(RspBufferPool, newSize);
+        // Use the whole block, keeping the offsets aligned
+        size_t newBufferSize = le_mem_GetBlockSize(newBufferPtr) & ~(sizeof(uint32_t) - 1);
+
+        if (rspPtr->bufferPtr != NULL)
+        {
+            size_t offsetsBytes = rspPtr->count * sizeof(uint32_t);
+
+            memcpy(newBufferPtr, rspPtr->bufferPtr, rspPtr->usedBytes);
+            memcpy(newBufferPtr + newBufferSize - offsetsBytes,
+                   rspPtr->bufferPtr + rspPtr->bufferSize - offsetsBytes,
+                   offsetsBytes);
+            le_mem_Release(rspPtr->bufferPtr);
+        }
+
+        rspPtr->bufferPtr = newBufferPtr;
+        rspPtr->bufferSize = newBufferSize;
+    }
+
+    memcpy(rspPtr->bufferPtr + rspPtr->usedBytes, linePtr, lineSize);
+    rspPtr->bufferPtr[rspPtr->usedBytes + lineSize] = '\0';
+
+    RspLinesOffsets(rspPtr)[-1 - (int32_t)rspPtr->count] = rspPtr->usedBytes;
+
+    rspPtr->usedBytes += lineSize + 1;
+    rspPtr->count++;
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function returns a line of the responses of a command.
+ *
+ * @return the line, or NULL if there is no line at this index
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* RspLinesGet
+(
+    RspLines_t* rspPtr,     ///< [IN] Responses
+    uint32_t    index       ///< [IN] Line index
+)
+{
+    if (index >= rspPtr->count)
+    {
+        return NULL;
+    }
+
+    return rspPtr->bufferPtr + RspLinesOffsets(rspPtr)[-1 - (int32_t)index];
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function returns the last line of the responses of a command.
+ *
+ * @return the line, or NULL if there is no line
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* RspLinesTail
+(
+    RspLines_t* rspPtr      ///< [IN] Responses
+)
+{
+    return (rspPtr->count > 0) ? RspLinesGet(rspPtr, rspPtr->count - 1) : NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function removes all the responses of a command.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void RspLinesClear
+(
+    RspLines_t* rspPtr      ///< [IN] Responses
+)
+{
+    if (rspPtr->bufferPtr != NULL)
+    {
+        le_mem_Release(rspPtr->bufferPtr);
+    }
+
+    memset(rspPtr, 0, sizeof(RspLines_t));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function allocates a prefix tree node.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static TrieNode_t* NewTrieNode
+(
+    char character
+)
+{
+    TrieNode_t* nodePtr = le_mem_ForceAlloc(TrieNodePool);
+
+    memset(nodePtr, 0, sizeof(TrieNode_t));
+    nodePtr->character = character;
+
+    return nodePtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function adds a pattern to a prefix tree, creating the tree if it is empty.
+ *
+ * @return the node where the pattern ends, to set its value
+ */
+//--------------------------------------------------------------------------------------------------
+static TrieNode_t* AddTriePattern
+(
+    TrieNode_t** rootPtrPtr,    ///< [IN/OUT] Tree root
+    const char*  patternPtr     ///< [IN] Pattern to add
+)
+{
+    if (*rootPtrPtr == NULL)
+    {
+        *rootPtrPtr = NewTrieNode('\0');
+    }
+
+    TrieNode_t* nodePtr = *rootPtrPtr;
+
+    for (; *patternPtr != '\0'; patternPtr++)
+    {
+        TrieNode_t** childPtrPtr = &nodePtr->childPtr;
+
+        while ((*childPtrPtr != NULL) && ((*childPtrPtr)->character != *patternPtr))
+        {
+            childPtrPtr = &(*childPtrPtr)->siblingPtr;
+        }
+
+        if (*childPtrPtr == NULL)
+        {
+            *childPtrPtr = NewTrieNode(*patternPtr);
+        }
+
+        nodePtr = *childPtrPtr;
+    }
+
+    return nodePtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function releases a prefix tree.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void DeleteTrie
+(
+    TrieNode_t* nodePtr
+)
+{
+    while (nodePtr != NULL)
+    {
+        TrieNode_t* siblingPtr = nodePtr->siblingPtr;
+
+        DeleteTrie(nodePtr->childPtr);
+        le_mem_Release(nodePtr);
+
+        nodePtr = siblingPtr;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function looks for the patterns of a prefix tree the line starts with, and calls the match
+ * function for each of them, shortest first.
+ *
+ * @return
+ *      - true if at least one pattern matches
+ *      - false otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+static bool MatchTrie
+(
+    TrieNode_t*     rootPtr,    ///< [IN] Tree root
+    const char*     linePtr,    ///< [IN] Line to match (need not be null-terminated)
+    size_t          lineSize,   ///< [IN] Line size
+    TrieMatchFunc_t matchFunc,  ///< [IN] Function called for each match, NULL to stop at the first
+    void*           contextPtr  ///< [IN] Match function context
+)
+{
+    TrieNode_t* nodePtr = rootPtr;
+    bool matched = false;
+    size_t idx = 0;
+
+    while (nodePtr != NULL)
+    {
+        if (nodePtr->valuePtr != NULL)
+        {
+            matched = true;
+
+            if ((matchFunc == NULL) || !matchFunc(nodePtr->valuePtr, contextPtr))
+            {
+                break;
+            }
+        }
+
+        if (idx == lineSize)
+        {
+            break;
+        }
+
+        nodePtr = nodePtr->childPtr;
+        while ((nodePtr != NULL) && (nodePtr->character != linePtr[idx]))
+        {
+            nodePtr = nodePtr->siblingPtr;
+        }
+        idx++;
+    }
+
+    return matched;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function rebuilds the prefix tree of the unsolicited responses subscribed on a device.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void RebuildUnsolicitedTrie
+(
+    DeviceContext_t* interfacePtr
+)
+{
+    uint32_t order = 0;
+
+    DeleteTrie(interfacePtr->unsolTriePtr);
+    interfacePtr->unsolTriePtr = NULL;
+
+    le_dls_Link_t* linkPtr = le_dls_Peek(&interfacePtr->unsolicitedList);
+
+    while (linkPtr != NULL)
+    {
+        Unsolicited_t *unsolPtr = CONTAINER_OF(linkPtr, Unsolicited_t, link);
+        TrieNode_t* nodePtr = AddTriePattern(&interfacePtr->unsolTriePtr, unsolPtr->unsolRsp);
+
+        unsolPtr->order = order++;
+        unsolPtr->samePatternPtr = NULL;
+
+        // Keep the subscriptions to the same pattern in subscription order.
+        if (nodePtr->valuePtr == NULL)
+        {
+            nodePtr->valuePtr = unsolPtr;
+        }
+        else
+        {
+            Unsolicited_t *lastPtr = nodePtr->valuePtr;
+
+            while (lastPtr->samePatternPtr != NULL)
+            {
+                lastPtr = lastPtr->samePatternPtr;
+            }
+            lastPtr->samePatternPtr = unsolPtr;
+        }
+
+        linkPtr = le_dls_PeekNext(&interfacePtr->unsolicitedList, linkPtr);
+    }
+
+    interfacePtr->unsolTrieStale = false;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function adds an unsolicited response to a list of matched responses, keeping the list in
+ * subscription order.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void QueueUnsolicitedMatch
+(
+    le_dls_List_t* matchListPtr,
+    Unsolicited_t* unsolPtr
+)
+{
+    le_dls_Link_t* linkPtr = le_dls_PeekTail(matchListPtr);
+
+    while ((linkPtr != NULL) &&
+           (CONTAINER_OF(linkPtr, Unsolicited_t, matchLink)->order > unsolPtr->order))
+    {
+        linkPtr = le_dls_PeekPrev(matchListPtr, linkPtr);
+    }
+
+    unsolPtr->matchLink = LE_DLS_LINK_INIT;
+
+    if (linkPtr != NULL)
+    {
+        le_dls_AddAfter(matchListPtr, linkPtr, &unsolPtr->matchLink);
+    }
+    else
+    {
+        le_dls_Stack(matchListPtr, &unsolPtr->matchLink);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Prefix tree match function for unsolicited responses.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static bool MatchUnsolicited
+(
+    void* valuePtr,
+    void* contextPtr
+)
+{
+    Unsolicited_t *unsolPtr;
+
+    for (unsolPtr = valuePtr; unsolPtr != NULL; unsolPtr = unsolPtr->samePatternPtr)
+    {
+        // Responses already in progress have been matched
+        if (!unsolPtr->inProgress)
+        {
+            QueueUnsolicitedMatch(contextPtr, unsolPtr);
+        }
+    }
+
+    return true;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function is used to check if the received data matches with a subscribed unsolicited
@@ -391,57 +885,68 @@ static void CheckUnsolicited
 (
     char* unsolRspPtr,
     size_t stringSize,
-    le_dls_List_t *unsolListPtr
+    DeviceContext_t* interfacePtr
 )
 {
+    le_dls_List_t matchList = LE_DLS_LIST_INIT;
+    le_dls_Link_t* linkPtr;
+
     LE_DEBUG("Start checking unsolicited");
 
-    le_dls_Link_t* linkPtr = le_dls_Peek(unsolListPtr);
+    if (interfacePtr->unsolTrieStale)
+    {
+        RebuildUnsolicitedTrie(interfacePtr);
+    }
 
-    /* Browse all the queue while the string is not found */
+    // The line belongs to the responses in progress, and to the ones it starts
+    linkPtr = le_dls_Peek(&interfacePtr->unsolInProgressList);
     while (linkPtr != NULL)
     {
-        Unsolicited_t *unsolPtr = CONTAINER_OF(linkPtr,
-                                               Unsolicited_t,
-                                                link);
+        QueueUnsolicitedMatch(&matchList, CONTAINER_OF(linkPtr, Unsolicited_t, progressLink));
+        linkPtr = le_dls_PeekNext(&interfacePtr->unsolInProgressList, linkPtr);
+    }
 
-        if ((strncmp(unsolPtr->unsolRsp,unsolRspPtr,strlen(unsolPtr->unsolRsp)) == 0) ||
-            (unsolPtr->inProgress))
-        {
-            LE_DEBUG("unsol found");
-            uint32_t len =
-                (stringSize < LE_ATDEFS_UNSOLICITED_MAX_LEN-strlen(unsolPtr->unsolBuffer)) ?
-                stringSize :
-                LE_ATDEFS_UNSOLICITED_MAX_LEN-strlen(unsolPtr->unsolBuffer);
+    MatchTrie(interfacePtr->unsolTriePtr, unsolRspPtr, stringSize, MatchUnsolicited, &matchList);
+
+    while ((linkPtr = le_dls_Pop(&matchList)) != NULL)
+    {
+        Unsolicited_t *unsolPtr = CONTAINER_OF(linkPtr, Unsolicited_t, matchLink);
+        size_t bufferLen = strlen(unsolPtr->unsolBuffer);
+
+        LE_DEBUG("unsol found");
+        uint32_t len =
+            (stringSize < LE_ATDEFS_UNSOLICITED_MAX_LEN-bufferLen) ?
+            stringSize :
+            LE_ATDEFS_UNSOLICITED_MAX_LEN-bufferLen;
 
-            strncpy(unsolPtr->unsolBuffer+strlen(unsolPtr->unsolBuffer), unsolRspPtr, len);
+        strncpy(unsolPtr->unsolBuffer+bufferLen, unsolRspPtr, len);
+        bufferLen += strnlen(unsolPtr->unsolBuffer+bufferLen, len);
 
+        if (!unsolPtr->inProgress)
+        {
             unsolPtr->inProgress = true;
+            le_dls_Queue(&interfacePtr->unsolInProgressList, &unsolPtr->progressLink);
         }
 
-        if (unsolPtr->inProgress)
+        if ( (unsolPtr->lineCount - unsolPtr->lineCounter) == 1 )
+        {
+            le_dls_Remove(&interfacePtr->unsolInProgressList, &unsolPtr->progressLink);
+            unsolPtr->handlerPtr(unsolPtr->unsolBuffer, unsolPtr->contextPtr );
+            memset(unsolPtr->unsolBuffer,0,LE_ATDEFS_UNSOLICITED_MAX_BYTES);
+            unsolPtr->lineCounter = 0;
+            unsolPtr->inProgress = false;
+        }
+        else
         {
-            if ( (unsolPtr->lineCount - unsolPtr->lineCounter) == 1 )
+            if (LE_ATDEFS_UNSOLICITED_MAX_BYTES - bufferLen > sizeof("\r\n"))
             {
-                unsolPtr->handlerPtr(unsolPtr->unsolBuffer, unsolPtr->contextPtr );
-                memset(unsolPtr->unsolBuffer,0,LE_ATDEFS_UNSOLICITED_MAX_BYTES);
-                unsolPtr->lineCounter = 0;
-                unsolPtr->inProgress = false;
+                snprintf(unsolPtr->unsolBuffer+bufferLen,
+                         sizeof("\r\n") + 1,    // +1 for Null terminator
+                         "\r\n" );
             }
-            else
-            {
-                if (LE_ATDEFS_UNSOLICITED_MAX_BYTES - strlen(unsolPtr->unsolBuffer) > sizeof("\r\n"))
-                {
-                    snprintf(unsolPtr->unsolBuffer+strlen(unsolPtr->unsolBuffer),
-                             sizeof("\r\n") + 1,    // +1 for Null terminator
-                             "\r\n" );
-                }
 
-                unsolPtr->lineCounter++;
-            }
+            unsolPtr->lineCounter++;
         }
-
-        linkPtr = le_dls_PeekNext(unsolListPtr, linkPtr);
     }
 
     LE_DEBUG("Stop checking unsolicited");
@@ -653,6 +1158,39 @@ static void RxNewData
     LE_DEBUG("read finished");
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function calls the completion handler of an AT command sent asynchronously. It is called in
+ * the thread that sent the command.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void CallResultHandler
+(
+    void* param1Ptr,
+    void* param2Ptr
+)
+{
+    AtCmd_t* cmdPtr = param1Ptr;
+    const char* finalRspPtr = NULL;
+
+    cmdPtr->pending = false;
+
+    if (cmdPtr->orphaned)
+    {
+        le_mem_Release(cmdPtr);
+        return;
+    }
+
+    if (cmdPtr->result == LE_OK)
+    {
+        finalRspPtr = RspLinesTail(&cmdPtr->responses);
+    }
+
+    cmdPtr->handlerFunc(cmdPtr->ref, cmdPtr->result, (finalRspPtr != NULL) ? finalRspPtr : "",
+                        cmdPtr->handlerContextPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Device thread destructor.
@@ -675,12 +1213,30 @@ static void DestroyDeviceThread
         le_mem_Release(unsolPtr);
     }
 
+    // The commands still queued belong to their senders: complete them, so that no sender waits
+    // forever for a response. Orphaned commands are released by CallResultHandler().
     while ((linkPtr=le_dls_Pop(&interfacePtr->atCommandList)) != NULL)
     {
         AtCmd_t* atCmdPtr = CONTAINER_OF(linkPtr, AtCmd_t, link);
-        le_mem_Release(atCmdPtr);
+
+        atCmdPtr->result = LE_TERMINATED;
+
+        if (atCmdPtr->handlerFunc != NULL)
+        {
+            le_event_QueueFunctionToThread(atCmdPtr->callerThreadRef,
+                                           CallResultHandler,
+                                           (void*) atCmdPtr,
+                                           (void*) NULL);
+        }
+        else
+        {
+            le_sem_Post(atCmdPtr->endSem);
+        }
     }
 
+    DeleteTrie(interfacePtr->unsolTriePtr);
+    interfacePtr->unsolTriePtr = NULL;
+
     if (interfacePtr->timerRef)
     {
         le_timer_Delete(interfacePtr->timerRef);
@@ -777,59 +1333,191 @@ static void UpdateTransitionManager
  *
  */
 //--------------------------------------------------------------------------------------------------
-static void StopTimer
+static void StopTimer
+(
+    DeviceContext_t* interfacePtr
+)
+{
+    le_timer_Stop(interfacePtr->timerRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function completes the commands sent on the current command line, and sends the next
+ * command.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void CompleteCommandLine
+(
+    DeviceContext_t* interfacePtr,
+    le_result_t      result,
+    ClientEvent_t    input
+)
+{
+    ClientStatePtr_t clientStatePtr = &interfacePtr->clientState;
+    char finalRsp[LE_ATDEFS_RESPONSE_MAX_BYTES] = "";
+    uint32_t count = interfacePtr->lineCmdCount;
+    bool first = true;
+    le_dls_Link_t* linkPtr;
+
+    interfacePtr->lineCmdCount = 0;
+    interfacePtr->rspCmdLinkPtr = NULL;
+
+    while ((count-- > 0) && ((linkPtr = le_dls_Pop(&interfacePtr->atCommandList)) != NULL))
+    {
+        AtCmd_t* cmdPtr = CONTAINER_OF(linkPtr, AtCmd_t, link);
+
+        // The final response has been added to the first command of the line only. Copy it before
+        // completing the command, as a synchronous sender may delete it right away.
+        if (result == LE_OK)
+        {
+            if (first)
+            {
+                const char* rspPtr = RspLinesTail(&cmdPtr->responses);
+
+                if (rspPtr != NULL)
+                {
+                    le_utf8_Copy(finalRsp, rspPtr, sizeof(finalRsp), NULL);
+                }
+            }
+            else if (RspLinesAdd(&cmdPtr->responses, finalRsp, strlen(finalRsp), true) != LE_OK)
+            {
+                LE_ERROR("Too many responses for %s", cmdPtr->cmd);
+            }
+        }
+        first = false;
+
+        cmdPtr->result = result;
+
+        if (cmdPtr->handlerFunc != NULL)
+        {
+            le_event_QueueFunctionToThread(cmdPtr->callerThreadRef,
+                                           CallResultHandler,
+                                           (void*) cmdPtr,
+                                           (void*) NULL);
+        }
+        else
+        {
+            le_sem_Post(cmdPtr->endSem);
+        }
+    }
+
+    UpdateTransitionManager(clientStatePtr,input,WaitingState);
+
+    // Send the next command
+    (clientStatePtr->curState)(clientStatePtr,EVENT_SENDCMD);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Timer handler (called when the AT command timeout is reached)
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void TimerHandler
+(
+    le_timer_Ref_t timerRef
+)
+{
+    DeviceContext_t* interfacePtr = le_timer_GetContextPtr(timerRef);
+    le_dls_Link_t* linkPtr = le_dls_Peek(&interfacePtr->atCommandList);
+
+    if (linkPtr != NULL)
+    {
+        AtCmd_t* atCmdPtr = CONTAINER_OF(linkPtr, AtCmd_t, link);
+
+        LE_ERROR("Timeout when sending %s (%"PRIu32" command(s)), timeout = %"PRIu32" ms",
+                 atCmdPtr->cmd, interfacePtr->lineCmdCount,
+                 le_timer_GetMsInterval(timerRef));
+    }
+
+    CompleteCommandLine(interfacePtr, LE_TIMEOUT, EVENT_SENDCMD);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to start the timer of a command
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void StartTimer
 (
-    AtCmd_t* cmdPtr
+    DeviceContext_t* interfacePtr,
+    uint32_t         timeout        ///< [IN] Timeout of the command line (in ms)
 )
 {
-    le_timer_Stop(cmdPtr->interfacePtr->timerRef);
+    le_timer_SetHandler(interfacePtr->timerRef,
+                        TimerHandler);
+
+    le_timer_SetContextPtr(interfacePtr->timerRef,
+                           interfacePtr);
+
+    le_timer_SetMsInterval(interfacePtr->timerRef,timeout);
+
+    le_timer_Start(interfacePtr->timerRef);
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Timer handler (called when the AT command timeout is reached)
+ * This function checks whether a command is an extended command ("AT+...").
  *
  */
 //--------------------------------------------------------------------------------------------------
-static void TimerHandler
+static bool IsExtendedCommand
 (
-    le_timer_Ref_t timerRef
+    AtCmd_t* cmdPtr
 )
 {
-    AtCmd_t* atCmdPtr = le_timer_GetContextPtr(timerRef);
-
-    LE_ERROR("Timeout when sending %s, timeout = %d",  atCmdPtr->cmd, atCmdPtr->timeout);
-    atCmdPtr->result = LE_TIMEOUT;
-    le_dls_Pop(&atCmdPtr->interfacePtr->atCommandList);
-    le_sem_Post(atCmdPtr->endSem);
-    ClientStatePtr_t clientStatePtr = &atCmdPtr->interfacePtr->clientState;
-
-    UpdateTransitionManager(clientStatePtr,EVENT_SENDCMD,WaitingState);
-
-    // Send the next command
-    (clientStatePtr->curState)(clientStatePtr,EVENT_SENDCMD);
+    return (cmdPtr->cmdLen > 3) && (strncasecmp(cmdPtr->cmd, "AT+", 3) == 0);
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * This function must be called to start the timer of a command
+ * This function checks whether a command can be sent on the same command line as the command
+ * queued before it.
  *
+ * @return
+ *      - TRUE if the commands can be concatenated
+ *      - FALSE otherwise
  */
 //--------------------------------------------------------------------------------------------------
-static void StartTimer
+static bool CanConcatenate
 (
-    AtCmd_t* cmdPtr
+    AtCmd_t* prevPtr,   ///< [IN] Last command of the line
+    AtCmd_t* nextPtr    ///< [IN] Command to append
 )
 {
-    le_timer_SetHandler(cmdPtr->interfacePtr->timerRef,
-                        TimerHandler);
+    if ((!prevPtr->concatenate) || (!nextPtr->concatenate) ||
+        (prevPtr->textSize != 0) || (nextPtr->textSize != 0) ||
+        (!IsExtendedCommand(prevPtr)) || (!IsExtendedCommand(nextPtr)))
+    {
+        return false;
+    }
+
+    // A command taking any line as intermediate response would take the responses of the next one
+    if (MatchTrie(prevPtr->intermediateTriePtr, "", 0, NULL, NULL))
+    {
+        return false;
+    }
+
+    // The final response of the line completes all of its commands
+    le_dls_Link_t* prevLinkPtr = le_dls_Peek(&prevPtr->expectResponseList);
+    le_dls_Link_t* nextLinkPtr = le_dls_Peek(&nextPtr->expectResponseList);
 
-    le_timer_SetContextPtr(cmdPtr->interfacePtr->timerRef,
-                           cmdPtr);
+    while ((prevLinkPtr != NULL) && (nextLinkPtr != NULL))
+    {
+        if (strcmp(CONTAINER_OF(prevLinkPtr, RspString_t, link)->line,
+                   CONTAINER_OF(nextLinkPtr, RspString_t, link)->line) != 0)
+        {
+            return false;
+        }
 
-    le_timer_SetMsInterval(cmdPtr->interfacePtr->timerRef,cmdPtr->timeout);
+        prevLinkPtr = le_dls_PeekNext(&prevPtr->expectResponseList, prevLinkPtr);
+        nextLinkPtr = le_dls_PeekNext(&nextPtr->expectResponseList, nextLinkPtr);
+    }
 
-    le_timer_Start(cmdPtr->interfacePtr->timerRef);
+    return (prevLinkPtr == NULL) && (nextLinkPtr == NULL);
 }
 
 
@@ -847,9 +1535,11 @@ static bool CheckResponse
 (
     char*          receivedRspPtr,   ///< [IN] Received line pointer
     size_t         lineSize,         ///< [IN] Received line size
-    le_dls_List_t* responseListPtr,  ///< [IN] List of response strings of the command
-    le_dls_List_t* resultListPtr,    ///< [OUT] List of matched strings after comparison
-    char*          cmdNamePtr        ///< [IN] Command name pointer
+    TrieNode_t*    responseTriePtr,  ///< [IN] Prefix tree of response strings of the command
+    RspLines_t*    resultPtr,        ///< [OUT] Matched lines after comparison
+    const char*    cmdNamePtr,       ///< [IN] Command name pointer
+    size_t         cmdNameLen,       ///< [IN] Command name length
+    bool           isFinal           ///< [IN] Whether the response strings are the final ones
 )
 {
     LE_DEBUG("Start checking response");
@@ -859,48 +1549,38 @@ static bool CheckResponse
         return false;
     }
 
-    le_dls_Link_t* linkPtr = le_dls_Peek(responseListPtr);
+    LE_DEBUG("Command: %s, size: %zu", cmdNamePtr, cmdNameLen);
+    LE_DEBUG("Received response: %.*s, size: %zu", (int)lineSize, receivedRspPtr, lineSize);
 
-    LE_DEBUG("Command: %s, size: %zu", cmdNamePtr, strlen(cmdNamePtr));
-    LE_DEBUG("Received response: %s, size: %zu", receivedRspPtr, lineSize);
-
-    if (strncmp(cmdNamePtr, receivedRspPtr, strlen(cmdNamePtr)) == 0)
+    if (strncmp(cmdNamePtr, receivedRspPtr, cmdNameLen) == 0)
     {
         LE_DEBUG("Found command echo in response");
         return false;
     }
 
-    /* Browse all the queue while the string is not found */
-    while (linkPtr != NULL)
+    if (MatchTrie(responseTriePtr, receivedRspPtr, lineSize, NULL, NULL))
     {
-        RspString_t* currStringPtr = CONTAINER_OF(linkPtr,
-                                                  RspString_t,
-                                                  link);
-        LE_DEBUG("Item: %s, size: %zu", currStringPtr->line, strlen(currStringPtr->line));
+        LE_DEBUG("Rsp matched, size: %zu", lineSize);
 
-        if ((strlen(currStringPtr->line) == 0) ||
-           ((lineSize >= strlen(currStringPtr->line)) &&
-           (strncmp(currStringPtr->line, receivedRspPtr, strlen(currStringPtr->line)) == 0)))
+        if(lineSize>LE_ATDEFS_RESPONSE_MAX_BYTES)
         {
-            LE_DEBUG("Rsp matched, size: %zu", lineSize);
-
-            RspString_t* newStringPtr = le_mem_ForceAlloc(RspStringPool);
-            memset(newStringPtr, 0, sizeof(RspString_t));
-
-            if(lineSize>LE_ATDEFS_RESPONSE_MAX_BYTES)
+            if (!isFinal)
             {
                 LE_ERROR("String too long");
-                le_mem_Release(newStringPtr);
                 return false;
             }
 
-            strncpy(newStringPtr->line, receivedRspPtr, lineSize);
-            newStringPtr->link = LE_DLS_LINK_INIT;
-            le_dls_Queue(resultListPtr, &(newStringPtr->link));
-            return true;
+            // The command must complete anyway
+            LE_ERROR("Final response too long, truncated");
+            lineSize = LE_ATDEFS_RESPONSE_MAX_BYTES;
         }
 
-        linkPtr = le_dls_PeekNext(responseListPtr, linkPtr);
+        if (RspLinesAdd(resultPtr, receivedRspPtr, lineSize, isFinal) != LE_OK)
+        {
+            LE_ERROR("Too many responses (%"PRIu32")", resultPtr->count);
+            return false;
+        }
+        return true;
     }
 
     LE_DEBUG("Stop checking response");
@@ -961,27 +1641,42 @@ static void SendingState
             int32_t newCRLF = parserPtr->idx-2;
             size_t lineSize = newCRLF - parserPtr->idxLastCrLf;
 
-            if (CheckResponse((char*)&(parserPtr->buffer[parserPtr->idxLastCrLf]), lineSize,
-                              &(cmdPtr->expectResponseList), &(cmdPtr->responseList),
-                              cmdPtr->cmd))
+            char* linePtr = (char*)&(parserPtr->buffer[parserPtr->idxLastCrLf]);
+
+            if (CheckResponse(linePtr, lineSize,
+                              cmdPtr->finalTriePtr, &(cmdPtr->responses),
+                              cmdPtr->cmd, cmdPtr->cmdLen, true))
             {
                 LE_DEBUG("Final command found");
 
-                le_dls_Pop(&interfacePtr->atCommandList);
-
-                cmdPtr->result = LE_OK;
-                StopTimer(cmdPtr);
-                le_sem_Post(cmdPtr->endSem);
-
-                UpdateTransitionManager(clientStatePtr,input,WaitingState);
-                // Send the next command
-                (clientStatePtr->curState)(clientStatePtr,EVENT_SENDCMD);
+                StopTimer(interfacePtr);
+                CompleteCommandLine(interfacePtr, LE_OK, input);
                 return;
             }
 
-            CheckResponse((char*)&(parserPtr->buffer[parserPtr->idxLastCrLf]), lineSize,
-                          &(cmdPtr->ExpectintermediateResponseList), &(cmdPtr->responseList),
-                          cmdPtr->cmd);
+            // The commands of a line answer in turn: look for the command the line belongs to
+            // from the one the previous intermediate response belonged to.
+            le_dls_Link_t* rspLinkPtr = interfacePtr->rspCmdLinkPtr;
+            uint32_t idx;
+
+            for (idx = interfacePtr->rspCmdIdx;
+                 (idx < interfacePtr->lineCmdCount) && (rspLinkPtr != NULL);
+                 idx++)
+            {
+                AtCmd_t* rspCmdPtr = CONTAINER_OF(rspLinkPtr, AtCmd_t, link);
+
+                // The echo of the line starts with its first command
+                if (CheckResponse(linePtr, lineSize,
+                                  rspCmdPtr->intermediateTriePtr, &(rspCmdPtr->responses),
+                                  cmdPtr->cmd, cmdPtr->cmdLen, false))
+                {
+                    interfacePtr->rspCmdLinkPtr = rspLinkPtr;
+                    interfacePtr->rspCmdIdx = idx;
+                    break;
+                }
+
+                rspLinkPtr = le_dls_PeekNext(&interfacePtr->atCommandList, rspLinkPtr);
+            }
             break;
         }
         default:
@@ -1023,20 +1718,51 @@ static void WaitingState
             }
 
             AtCmd_t* cmdPtr = CONTAINER_OF(linkPtr, AtCmd_t, link);
+            AtCmd_t* lastPtr = cmdPtr;
+            char atCommand[LE_ATDEFS_COMMAND_MAX_BYTES + 1];    // +1 for '\r'
+            size_t len = cmdPtr->cmdLen;
+            uint32_t timeout = cmdPtr->timeout;
+
+            memcpy(atCommand, cmdPtr->cmd, len);
+            interfacePtr->lineCmdCount = 1;
+            interfacePtr->rspCmdLinkPtr = linkPtr;
+            interfacePtr->rspCmdIdx = 0;
+
+            // Append the next queued commands that can share the command line, without their "AT"
+            linkPtr = le_dls_PeekNext(&(interfacePtr->atCommandList), linkPtr);
 
-            if (cmdPtr->timeout > 0)
+            while (linkPtr != NULL)
             {
-                StartTimer(cmdPtr);
+                AtCmd_t* nextPtr = CONTAINER_OF(linkPtr, AtCmd_t, link);
+
+                if ((!CanConcatenate(lastPtr, nextPtr)) ||
+                    (len + 1 + nextPtr->cmdLen - 2 > LE_ATDEFS_COMMAND_MAX_LEN))
+                {
+                    break;
+                }
+
+                atCommand[len++] = ';';
+                memcpy(atCommand + len, nextPtr->cmd + 2, nextPtr->cmdLen - 2);
+                len += nextPtr->cmdLen - 2;
+
+                // The modem executes the commands of the line one after the other
+                timeout = ((timeout > 0) && (nextPtr->timeout > 0)) ? timeout + nextPtr->timeout : 0;
+
+                interfacePtr->lineCmdCount++;
+                lastPtr = nextPtr;
+                linkPtr = le_dls_PeekNext(&(interfacePtr->atCommandList), linkPtr);
             }
 
-            uint32_t len = strlen(cmdPtr->cmd)+2;
-            char atCommand[len];
-            memset(atCommand, 0, len);
-            snprintf(atCommand, len, "%s\r", cmdPtr->cmd);
+            atCommand[len++] = '\r';
+
+            if (timeout > 0)
+            {
+                StartTimer(interfacePtr, timeout);
+            }
 
             le_dev_Write(&(interfacePtr->device),
                            (uint8_t*) atCommand,
-                           len-1);
+                           len);
 
             UpdateTransitionManager(clientStatePtr,input,SendingState);
 
@@ -1051,7 +1777,7 @@ static void WaitingState
 
             CheckUnsolicited((char*)&(parserPtr->buffer[parserPtr->idxLastCrLf]),
                               lineSize,
-                              &interfacePtr->unsolicitedList);
+                              interfacePtr);
             break;
         }
         default:
@@ -1213,11 +1939,22 @@ static void SendCommand
 )
 {
     DeviceContext_t* interfacePtr = param1Ptr;
+    AtCmd_t* cmdPtr = param2Ptr;
 
     if (interfacePtr)
     {
         ClientState_t* clientState = &interfacePtr->clientState;
-        (clientState->curState)(clientState,EVENT_SENDCMD);
+
+        if (cmdPtr)
+        {
+            le_dls_Queue(&interfacePtr->atCommandList, &cmdPtr->link);
+        }
+
+        // Otherwise the command is sent when the current one completes
+        if (clientState->curState == WaitingState)
+        {
+            (clientState->curState)(clientState,EVENT_SENDCMD);
+        }
     }
 }
 
@@ -1236,9 +1973,11 @@ static void AtCmdPoolDestructor
 
     LE_DEBUG("Destroy AT command %s", oldPtr->cmd);
 
-    ReleaseRspStringList(&(oldPtr->responseList));
+    RspLinesClear(&(oldPtr->responses));
     ReleaseRspStringList(&(oldPtr->expectResponseList));
     ReleaseRspStringList(&(oldPtr->ExpectintermediateResponseList));
+    DeleteTrie(oldPtr->finalTriePtr);
+    DeleteTrie(oldPtr->intermediateTriePtr);
 
     le_ref_DeleteRef(CmdRefMap, oldPtr->ref);
 }
@@ -1293,44 +2032,18 @@ static void UnsolicitedPoolDestructor
         le_dls_Remove(listPtr, linkPtr);
     }
 
-    // Delete the reference for unsolicited structure pointer.
-    le_ref_DeleteRef(UnsolRefMap, unsolicitedPtr->ref);
-}
-
-//--------------------------------------------------------------------------------------------------
-/**
- * This function is used to get the intermediate response at specified index
- *
- */
-//--------------------------------------------------------------------------------------------------
-static char* GetIntermediateResponse
-(
-    le_dls_List_t* responseListPtr,
-    uint32_t       index
-)
-{
-    le_dls_Link_t* linkPtr;
-
-    uint32_t i;
+    listPtr = &unsolicitedPtr->interfacePtr->unsolInProgressList;
+    linkPtr = &unsolicitedPtr->progressLink;
 
-    linkPtr = le_dls_Peek(responseListPtr);
-
-    for(i=0;i<index;i++)
+    if ( le_dls_IsInList(listPtr, linkPtr) )
     {
-        linkPtr = le_dls_PeekNext(responseListPtr, linkPtr);
+        le_dls_Remove(listPtr, linkPtr);
     }
-    if (linkPtr)
-    {
-        RspString_t* rspPtr;
 
-        rspPtr = CONTAINER_OF(linkPtr, RspString_t, link);
+    unsolicitedPtr->interfacePtr->unsolTrieStale = true;
 
-        return rspPtr->line;
-    }
-    else
-    {
-        return NULL;
-    }
+    // Delete the reference for unsolicited structure pointer.
+    le_ref_DeleteRef(UnsolRefMap, unsolicitedPtr->ref);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1373,7 +2086,6 @@ le_atClient_CmdRef_t le_atClient_Create
     cmdPtr->interfacePtr                    = NULL;
     cmdPtr->ref                             = le_ref_CreateRef(CmdRefMap, cmdPtr);
     cmdPtr->intermediateIndex               = 0;
-    cmdPtr->responseList                    = LE_DLS_LIST_INIT;
     cmdPtr->link                            = LE_DLS_LINK_INIT;
     cmdPtr->sessionRef                      = le_atClient_GetClientSessionRef();
 
@@ -1446,6 +2158,12 @@ le_result_t le_atClient_Delete
         return LE_BAD_PARAMETER;
     }
 
+    if (cmdPtr->pending)
+    {
+        LE_ERROR("Command %s not completed", cmdPtr->cmd);
+        return LE_BUSY;
+    }
+
     le_mem_Release(cmdPtr);
 
     return LE_OK;
@@ -1479,6 +2197,7 @@ le_result_t le_atClient_SetCommand
     }
 
     le_utf8_Copy(cmdPtr->cmd, commandPtr, sizeof(cmdPtr->cmd), NULL);
+    cmdPtr->cmdLen = strlen(cmdPtr->cmd);
     return LE_OK;
 }
 
@@ -1537,6 +2256,8 @@ le_result_t le_atClient_SetIntermediateResponse
             newStringPtr->link = LE_DLS_LINK_INIT;
 
             le_dls_Queue(&(cmdPtr->ExpectintermediateResponseList), &(newStringPtr->link));
+            AddTriePattern(&cmdPtr->intermediateTriePtr, newStringPtr->line)->valuePtr =
+                newStringPtr;
 
             interPtr = strtok_r(NULL, "|", &savePtr);
         }
@@ -1547,7 +2268,8 @@ le_result_t le_atClient_SetIntermediateResponse
         memset(newStringPtr, 0, sizeof(RspString_t));
         newStringPtr->link = LE_DLS_LINK_INIT;
         le_dls_Queue(&(cmdPtr->ExpectintermediateResponseList), &(newStringPtr->link));
-
+        AddTriePattern(&cmdPtr->intermediateTriePtr, newStringPtr->line)->valuePtr =
+            newStringPtr;
     }
 
     return LE_OK;
@@ -1608,6 +2330,7 @@ le_result_t le_atClient_SetFinalResponse
             newStringPtr->link = LE_DLS_LINK_INIT;
 
             le_dls_Queue(&(cmdPtr->expectResponseList),&(newStringPtr->link));
+            AddTriePattern(&cmdPtr->finalTriePtr, newStringPtr->line)->valuePtr = newStringPtr;
 
             respPtr = strtok_r(NULL, "|", &savePtr);
         }
@@ -1686,6 +2409,48 @@ le_result_t le_atClient_SetTimeout
     return LE_OK;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function checks that an AT command is complete and prepares it to be sent.
+ *
+ * @return
+ *      - LE_FAULT when the command is not complete
+ *      - LE_OK when function succeed
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t PrepareCommand
+(
+    le_atClient_CmdRef_t cmdRef,
+    AtCmd_t*             cmdPtr
+)
+{
+    if (cmdPtr->interfacePtr == NULL)
+    {
+        LE_ERROR("no device set");
+        return LE_FAULT;
+    }
+
+    if (le_dls_NumLinks(&cmdPtr->expectResponseList) == 0)
+    {
+        LE_ERROR("no final responses set");
+        return LE_FAULT;
+    }
+
+    if (le_dls_NumLinks(&cmdPtr->ExpectintermediateResponseList) == 0)
+    {
+        if (le_atClient_SetIntermediateResponse(cmdRef,"") != LE_OK)
+        {
+            LE_ERROR("Can't set intermediate rsp");
+            return LE_FAULT;
+        }
+    }
+
+    RspLinesClear(&cmdPtr->responses);
+    cmdPtr->link = LE_DLS_LINK_INIT;
+
+    return LE_OK;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function must be called to send an AT Command and wait for response.
@@ -1712,36 +2477,25 @@ le_result_t le_atClient_Send
         return LE_BAD_PARAMETER;
     }
 
-    if (cmdPtr->interfacePtr == NULL)
+    if (cmdPtr->pending)
     {
-        LE_ERROR("no device set");
+        LE_ERROR("Command %s not completed", cmdPtr->cmd);
         return LE_FAULT;
     }
 
-    if (le_dls_NumLinks(&cmdPtr->expectResponseList) == 0)
+    if (PrepareCommand(cmdRef, cmdPtr) != LE_OK)
     {
-        LE_ERROR("no final responses set");
         return LE_FAULT;
     }
 
-    if (le_dls_NumLinks(&cmdPtr->ExpectintermediateResponseList) == 0)
-    {
-        if (le_atClient_SetIntermediateResponse(cmdRef,"") != LE_OK)
-        {
-            LE_ERROR("Can't set intermediate rsp");
-            return LE_FAULT;
-        }
-    }
-
+    cmdPtr->concatenate = false;
+    cmdPtr->handlerFunc = NULL;
     cmdPtr->endSem = le_sem_Create("ResultSignal",0);
-    le_dls_Queue(&cmdPtr->interfacePtr->atCommandList, &cmdPtr->link);
-
-    ReleaseRspStringList(&cmdPtr->responseList);
 
     le_event_QueueFunctionToThread(cmdPtr->interfacePtr->threadRef,
                                                 SendCommand,
                                                 (void*) cmdPtr->interfacePtr,
-                                                (void*) NULL);
+                                                (void*) cmdPtr);
 
     le_sem_Wait(cmdPtr->endSem);
 
@@ -1750,6 +2504,73 @@ le_result_t le_atClient_Send
     return cmdPtr->result;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to queue an AT Command to be sent, without waiting for its
+ * response. The handler is called when the command has completed.
+ *
+ * @return
+ *      - LE_FAULT when function failed
+ *      - LE_BUSY when the command has already been sent and has not completed yet
+ *      - LE_OK when the command has been queued
+ *
+ * @note If the AT Command reference is invalid, a fatal error occurs,
+ *       the function won't return.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_atClient_SendAsync
+(
+    le_atClient_CmdRef_t cmdRef,
+        ///< [IN] AT Command
+
+    bool concatenate,
+        ///< [IN] Allow sending the command on the same command line as other queued commands
+
+    le_atClient_CommandResultHandlerFunc_t handlerPtr,
+        ///< [IN] Completion handler
+
+    void* contextPtr
+        ///< [IN]
+)
+{
+    AtCmd_t* cmdPtr = le_ref_Lookup(CmdRefMap, cmdRef);
+    if (cmdPtr == NULL)
+    {
+        LE_KILL_CLIENT("Invalid reference (%p) provided!", cmdRef);
+        return LE_BAD_PARAMETER;
+    }
+
+    if (handlerPtr == NULL)
+    {
+        LE_KILL_CLIENT("Invalid handlerPtr (%p) provided!", handlerPtr);
+        return LE_BAD_PARAMETER;
+    }
+
+    if (cmdPtr->pending)
+    {
+        LE_ERROR("Command %s not completed", cmdPtr->cmd);
+        return LE_BUSY;
+    }
+
+    if (PrepareCommand(cmdRef, cmdPtr) != LE_OK)
+    {
+        return LE_FAULT;
+    }
+
+    cmdPtr->concatenate = concatenate;
+    cmdPtr->handlerFunc = handlerPtr;
+    cmdPtr->handlerContextPtr = contextPtr;
+    cmdPtr->callerThreadRef = le_thread_GetCurrent();
+    cmdPtr->pending = true;
+
+    le_event_QueueFunctionToThread(cmdPtr->interfacePtr->threadRef,
+                                   SendCommand,
+                                   (void*) cmdPtr->interfacePtr,
+                                   (void*) cmdPtr);
+
+    return LE_OK;
+}
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -1783,12 +2604,12 @@ le_result_t le_atClient_GetFirstIntermediateResponse
         return LE_BAD_PARAMETER;
     }
 
-    cmdPtr->responsesCount = le_dls_NumLinks(&cmdPtr->responseList);
+    cmdPtr->responsesCount = cmdPtr->responses.count;
     cmdPtr->intermediateIndex = 0;
 
     if (cmdPtr->responsesCount > 1)
     {
-        char* firstLinePtr = GetIntermediateResponse(&cmdPtr->responseList,0);
+        const char* firstLinePtr = RspLinesGet(&cmdPtr->responses, 0);
 
         if (firstLinePtr)
         {
@@ -1836,8 +2657,7 @@ le_result_t le_atClient_GetNextIntermediateResponse
 
     if (cmdPtr->intermediateIndex < cmdPtr->responsesCount-1)
     {
-        char* firstLinePtr = GetIntermediateResponse(&cmdPtr->responseList,
-                                                     cmdPtr->intermediateIndex);
+        const char* firstLinePtr = RspLinesGet(&cmdPtr->responses, cmdPtr->intermediateIndex);
 
         if (firstLinePtr)
         {
@@ -1880,21 +2700,121 @@ le_result_t le_atClient_GetFinalResponse
         return LE_BAD_PARAMETER;
     }
 
-    le_dls_Link_t* linkPtr;
-    RspString_t* rspPtr;
+    const char* rspPtr = RspLinesTail(&cmdPtr->responses);
+
+    if (rspPtr == NULL)
+    {
+        return LE_FAULT;
+    }
+
+    snprintf(finalRspPtr, finalRspNumElements, "%s", rspPtr);
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function is used to get the intermediate responses, as many as fit in the buffer, with a
+ * single call.
+ *
+ * At least one response is copied: if the first one doesn't fit in the buffer, it is truncated to
+ * fit, as by le_atClient_GetNextIntermediateResponse(), and counted as copied. So the next call,
+ * from firstIndex + count, always makes progress.
+ *
+ * @return
+ *      - LE_NOT_FOUND when there is no intermediate response at this index
+ *      - LE_OVERFLOW when the buffer is full and more intermediate responses are available; they
+ *        are got by calling the function again from the index of the first one not copied
+ *      - LE_FAULT when the buffer is empty
+ *      - LE_OK when all the intermediate responses from this index have been copied
+ *
+ * @note If the AT Command reference is invalid, a fatal error occurs,
+ *       the function won't return.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_atClient_GetIntermediateResponses
+(
+    le_atClient_CmdRef_t cmdRef,
+        ///< [IN] AT Command
+
+    uint32_t firstIndex,
+        ///< [IN] Index of the first intermediate response to get
+
+    uint8_t* responsesPtr,
+        ///< [OUT] Intermediate responses, null-terminated, one after the other
+
+    size_t* responsesSizePtr,
+        ///< [INOUT]
+
+    uint32_t* countPtr
+        ///< [OUT] Number of intermediate responses copied
+)
+{
+    AtCmd_t* cmdPtr = le_ref_Lookup(CmdRefMap, cmdRef);
+    if (cmdPtr == NULL)
+    {
+        LE_KILL_CLIENT("Invalid reference (%p) provided!", cmdRef);
+        return LE_BAD_PARAMETER;
+    }
+
+    RspLines_t* rspPtr = &cmdPtr->responses;
+    uint32_t* offsetsPtr = RspLinesOffsets(rspPtr);
+    // The last line is the final response
+    uint32_t endIndex = (rspPtr->count > 0) ? rspPtr->count - 1 : 0;
+
+    *countPtr = 0;
+
+    if (firstIndex >= endIndex)
+    {
+        *responsesSizePtr = 0;
+        return LE_NOT_FOUND;
+    }
+
+    // The lines are contiguous: look for the last one that fits, the next line starting where it
+    // ends.
+    uint32_t startOffset = offsetsPtr[-1 - (int32_t)firstIndex];
+    uint32_t lowIndex = firstIndex;
+    uint32_t highIndex = endIndex;
+
+    while (lowIndex < highIndex)
+    {
+        uint32_t midIndex = highIndex - (highIndex - lowIndex) / 2;
+
+        if (offsetsPtr[-1 - (int32_t)midIndex] - startOffset <= *responsesSizePtr)
+        {
+            lowIndex = midIndex;
+        }
+        else
+        {
+            highIndex = midIndex - 1;
+        }
+    }
 
-    if ((linkPtr = le_dls_PeekTail(&cmdPtr->responseList)) != NULL)
+    size_t size = offsetsPtr[-1 - (int32_t)lowIndex] - startOffset;
+
+    if (lowIndex > firstIndex)
+    {
+        memcpy(responsesPtr, rspPtr->bufferPtr + startOffset, size);
+    }
+    else if (*responsesSizePtr > 0)
     {
-        rspPtr = CONTAINER_OF(linkPtr, RspString_t, link);
+        // The first response doesn't fit: truncate it, so that the caller can go on to the next
+        le_utf8_Copy((char*)responsesPtr, rspPtr->bufferPtr + startOffset, *responsesSizePtr,
+                     &size);
+        size++;
+        lowIndex++;
     }
     else
     {
+        LE_ERROR("Empty responses buffer");
+        *responsesSizePtr = 0;
         return LE_FAULT;
     }
 
-    snprintf(finalRspPtr, finalRspNumElements, "%s", rspPtr->line);
+    *responsesSizePtr = size;
+    *countPtr = lowIndex - firstIndex;
 
-    return LE_OK;
+    return (lowIndex == endIndex) ? LE_OK : LE_OVERFLOW;
 }
 
 
@@ -2053,8 +2973,14 @@ le_atClient_UnsolicitedResponseHandlerRef_t le_atClient_AddUnsolicitedResponseHa
     unsolicitedPtr->link = LE_DLS_LINK_INIT;
     unsolicitedPtr->sessionRef = le_atClient_GetClientSessionRef();
 
+    unsolicitedPtr->progressLink = LE_DLS_LINK_INIT;
+    unsolicitedPtr->matchLink = LE_DLS_LINK_INIT;
+
     le_dls_Queue(&interfacePtr->unsolicitedList, &unsolicitedPtr->link);
 
+    // The device thread rebuilds its prefix tree before matching the next line.
+    interfacePtr->unsolTrieStale = true;
+
     return unsolicitedPtr->ref;
 }
 
@@ -2120,7 +3046,15 @@ static void CloseSessionEventHandler
         {
             if (sessionRef == cmdPtr->sessionRef)
             {
-                le_mem_Release(cmdPtr);
+                // A command still queued is released once it has completed
+                if (cmdPtr->pending)
+                {
+                    cmdPtr->orphaned = true;
+                }
+                else
+                {
+                    le_mem_Release(cmdPtr);
+                }
             }
         }
     }
@@ -2250,6 +3184,18 @@ COMPONENT_INIT
     le_mem_SetDestructor(UnsolicitedPool,UnsolicitedPoolDestructor);
     UnsolRefMap = le_ref_CreateMap("UnsolRefMap", UNSOLICITED_POOL_SIZE);
 
+    // Responses buffers pool allocation. Most commands get a few short lines, so most buffers are
+    // allocated from sub-pools.
+    RspBufferPool = le_mem_CreatePool("AtRspBufferPool", RSP_BUFFER_MAX_BYTES);
+    RspBufferPool = le_mem_CreateReducedPool(RspBufferPool, "AtRspMediumBufferPool",
+                                             0, RSP_BUFFER_MEDIUM_BYTES);
+    RspBufferPool = le_mem_CreateReducedPool(RspBufferPool, "AtRspSmallBufferPool",
+                                             CMD_POOL_SIZE, RSP_BUFFER_TYPICAL_BYTES);
+
+    // Pattern prefix tree nodes pool allocation
+    TrieNodePool = le_mem_CreatePool("AtTrieNodePool",sizeof(TrieNode_t));
+    le_mem_ExpandPool(TrieNodePool,TRIE_NODE_POOL_SIZE);
+
     // Add a handler to the close session service
     le_msg_AddServiceCloseHandler(
         le_atClient_GetServiceRef(), CloseSessionEventHandler, NULL);
@@ -35,10 +35,32 @@
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Command parameters pool size
+ * Maximum number of parameters of a received AT command
  */
 //--------------------------------------------------------------------------------------------------
-#define PARAM_POOL_SIZE       20
+#define PARAM_MAX_NUMBER      LE_ATDEFS_COMMAND_MAX_LEN
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of slots of the command name table (power of 2).  The table holds up to half as many
+ * commands as it has slots; above that, commands are looked up in CmdHashMap.
+ */
+//--------------------------------------------------------------------------------------------------
+#define CMD_NAME_TABLE_MAX_SIZE     512
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of buckets used to build the command name table, relative to its number of slots
+ */
+//--------------------------------------------------------------------------------------------------
+#define CMD_NAME_SLOTS_PER_BUCKET   4
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Largest displacement tried for a bucket of the command name table before growing the table
+ */
+//--------------------------------------------------------------------------------------------------
+#define CMD_NAME_DISP_MAX           UINT16_MAX
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -54,6 +76,21 @@
 //--------------------------------------------------------------------------------------------------
 #define RSP_STRING_TYPICAL_BYTES 24
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the output buffer of a device, where responses are coalesced before being written
+ */
+//--------------------------------------------------------------------------------------------------
+#define RSP_OUTPUT_BUFFER_BYTES 4096
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum time to wait for a device to become writable, when responses can't be kept in its
+ * output buffer
+ */
+//--------------------------------------------------------------------------------------------------
+#define RSP_WRITE_TIMEOUT_MS 1000
+
 //--------------------------------------------------------------------------------------------------
 /**
  * User-defined error strings pool size
@@ -75,6 +112,7 @@
 //--------------------------------------------------------------------------------------------------
 #define AT_TOKEN_EQUAL  '='
 #define AT_TOKEN_CR     0x0D
+#define AT_TOKEN_BACKSPACE 0x7F
 #define AT_TOKEN_QUESTIONMARK  '?'
 #define AT_TOKEN_SEMICOLON ';'
 #define AT_TOKEN_COMMA ','
@@ -222,13 +260,6 @@ static le_mem_PoolRef_t    DevicesPool;
 //--------------------------------------------------------------------------------------------------
 static le_mem_PoolRef_t  AtCommandsPool;
 
-//--------------------------------------------------------------------------------------------------
-/**
- * Pool for parameter string
- */
-//--------------------------------------------------------------------------------------------------
-static le_mem_PoolRef_t  ParamStringPool;
-
 //--------------------------------------------------------------------------------------------------
 /**
  * Pool for response
@@ -514,19 +545,6 @@ typedef struct
 }
 UserErrorCode_t;
 
-//--------------------------------------------------------------------------------------------------
-/**
- * structure used to describe a parameter.
- *
- */
-//--------------------------------------------------------------------------------------------------
-typedef struct
-{
-    char            param[LE_ATDEFS_PARAMETER_MAX_BYTES];   ///< string value
-    le_dls_Link_t   link;                                   ///< link for list
-}
-ParamString_t;
-
 //--------------------------------------------------------------------------------------------------
 /**
  * AT command response structure.
@@ -617,9 +635,10 @@ typedef struct
 {
     le_atServer_CmdRef_t    cmdRef;                                 ///< cmd refrence
     char*                   cmdName;                                ///< Command to send
+    size_t                  cmdNameLen;                             ///< Command name length
+    uint32_t                cmdNameHash;                            ///< Command name hash
     le_atServer_AvailableDevice_t availableDevice;                  ///< device to send unsol rsp
     le_atServer_Type_t      type;                                   ///< cmd type
-    le_dls_List_t           paramList;                              ///< parameters list
     bool                    processing;                             ///< is command processing
     le_atServer_DeviceRef_t deviceRef;                              ///< device refrence
     bool                    bridgeCmd;                              ///< is command created by the
@@ -653,9 +672,39 @@ typedef struct
     char*                   lastCharPtr;                            ///< last received character
                                                                     ///< position in foundCmd buffer
     ATCmdSubscribed_t*      currentCmdPtr;                          ///< current command context
+    char                    paramBuf[LE_ATDEFS_COMMAND_MAX_BYTES];  ///< parameters of the
+                                                                    ///< current command
+    uint32_t                paramBufUsed;                           ///< used bytes in paramBuf
+    uint16_t                paramOffset[PARAM_MAX_NUMBER];          ///< parameter positions in
+                                                                    ///< paramBuf
+    uint32_t                paramCount;                             ///< number of parameters
 }
 CmdParser_t;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Command name table.
+ *
+ * Registered commands are placed in it with a perfect hash (hash and displace): the name hash
+ * selects a bucket, and the displacement of the bucket, chosen when the table is built so that
+ * no two commands share a slot, selects the slot.  A lookup thus compares a single command name.
+ * The table is rebuilt on the first lookup after the registered commands have changed.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    ATCmdSubscribed_t* slot[CMD_NAME_TABLE_MAX_SIZE];                           ///< commands
+    uint16_t           disp[CMD_NAME_TABLE_MAX_SIZE/CMD_NAME_SLOTS_PER_BUCKET]; ///< displacement
+                                                                                ///< of buckets
+    uint32_t           slotMask;                                                ///< slots - 1
+    uint32_t           bucketMask;                                              ///< buckets - 1
+    bool               stale;                                                   ///< commands
+                                                                                ///< changed
+    bool               valid;                                                   ///< table built
+}
+CmdNameTable_t;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Final response structure.
@@ -720,6 +769,12 @@ typedef struct
     le_msg_SessionRef_t     sessionRef;                           ///< session reference
     bool                    suspended;                            ///< is device in data mode
     bool                    echo;                                 ///< is echo enabled
+    char                    outBuf[RSP_OUTPUT_BUFFER_BYTES];      ///< responses not written yet
+    size_t                  outLen;                               ///< used bytes in outBuf
+    bool                    flushQueued;                          ///< is a flush queued to the
+                                                                  ///< event loop
+    bool                    outBlocked;                           ///< is the device not writable
+                                                                  ///< (POLLOUT monitored)
 #if LE_CONFIG_ATSERVER_TEXT_API
     Text_t                  text;                                 ///< text data
 #endif
@@ -778,22 +833,6 @@ LE_MEM_DEFINE_STATIC_POOL(AtServerCommandStringsPool,
 static le_mem_PoolRef_t AtCommandStringsPool;
 
 
-//--------------------------------------------------------------------------------------------------
-/**
- * Static pool for parameter string
- */
-//--------------------------------------------------------------------------------------------------
-LE_MEM_DEFINE_STATIC_POOL(ParamString,
-                          PARAM_POOL_SIZE,
-                          sizeof(ParamString_t));
-
-//--------------------------------------------------------------------------------------------------
-/**
- * Pool for parameter string
- */
-//--------------------------------------------------------------------------------------------------
-static le_mem_PoolRef_t  ParamStringPool;
-
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -890,6 +929,13 @@ LE_HASHMAP_DEFINE_STATIC(CmdHashMap, CMD_POOL_SIZE);
 //--------------------------------------------------------------------------------------------------
 static le_hashmap_Ref_t   CmdHashMap;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Table of the registered AT commands used by the parser
+ */
+//--------------------------------------------------------------------------------------------------
+static CmdNameTable_t CmdNameTable;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Event ID for new AT command registration.
@@ -920,6 +966,7 @@ static le_result_t ParseBasicEnd(CmdParser_t* cmdParserPtr);
 static le_result_t ParseNone(CmdParser_t* cmdParserPtr);
 static le_result_t ParseBasicParam(CmdParser_t* cmdParserPtr);
 static void ParseAtCmd(DeviceContext_t* devPtr);
+static void RxNewData(int fd, short events);
 
 CmdParserFunc_t CmdParserTab[PARSE_MAX][PARSE_MAX] =
 {
@@ -1035,6 +1082,348 @@ CmdParserFunc_t CmdParserTab[PARSE_MAX][PARSE_MAX] =
                          }
 };
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hash an AT command name (FNV-1a).
+ *
+ * @return
+ *      The hash of the name.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t HashCmdName
+(
+    const char* namePtr,    ///< [IN] Command name, not necessarily null-terminated
+    size_t      len         ///< [IN] Length of the command name
+)
+{
+    uint32_t hash = 2166136261u;
+
+    while (len--)
+    {
+        hash ^= (uint8_t)*namePtr++;
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mix the bits of a hash (MurmurHash3 finalizer), so that its low bits can be used as an index.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t MixHash
+(
+    uint32_t hash
+)
+{
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6Bu;
+    hash ^= hash >> 13;
+    hash *= 0xC2B2AE35u;
+    hash ^= hash >> 16;
+
+    return hash;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the command name table bucket of a command name hash.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline uint32_t CmdNameBucket
+(
+    uint32_t hash
+)
+{
+    return MixHash(hash) & CmdNameTable.bucketMask;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the command name table slot of a command name hash for a given displacement.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline uint32_t CmdNameSlot
+(
+    uint32_t hash,
+    uint32_t disp
+)
+{
+    return MixHash(hash + (disp + 1) * 0x9E3779B9u) & CmdNameTable.slotMask;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Find a displacement placing all the commands of a bucket in free slots of the command name
+ * table, and place them.
+ *
+ * @return
+ *      - true if the commands have been placed.
+ *      - false if no displacement up to CMD_NAME_DISP_MAX fits.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool PlaceCmdNameBucket
+(
+    ATCmdSubscribed_t** cmdsPtr,    ///< [IN] Commands of the bucket
+    uint32_t            count,      ///< [IN] Number of commands of the bucket
+    uint32_t            bucket      ///< [IN] Bucket
+)
+{
+    uint32_t slots[count];
+    uint32_t disp;
+    uint32_t i, j;
+
+    for (disp = 0; disp <= CMD_NAME_DISP_MAX; disp++)
+    {
+        for (i = 0; i < count; i++)
+        {
+            slots[i] = CmdNameSlot(cmdsPtr[i]->cmdNameHash, disp);
+
+            if (CmdNameTable.slot[slots[i]])
+            {
+                break;
+            }
+
+            for (j = 0; (j < i) && (slots[j] != slots[i]); j++)
+            {
+            }
+
+            if (j < i)
+            {
+                break;
+            }
+        }
+
+        if (i == count)
+        {
+            for (i = 0; i < count; i++)
+            {
+                CmdNameTable.slot[slots[i]] = cmdsPtr[i];
+            }
+            CmdNameTable.disp[bucket] = disp;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Place commands in a command name table of a given size.
+ *
+ * @return
+ *      - true if all the commands have been placed.
+ *      - false if the table is too small.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool PlaceCmdNames
+(
+    ATCmdSubscribed_t** cmdsPtr,    ///< [IN] Commands
+    uint32_t            count,      ///< [IN] Number of commands
+    uint32_t            size        ///< [IN] Number of slots of the table
+)
+{
+    uint32_t bucketCount = size / CMD_NAME_SLOTS_PER_BUCKET;
+    uint16_t bucketSize[bucketCount];
+    static ATCmdSubscribed_t* bucketCmds[CMD_NAME_TABLE_MAX_SIZE/2];
+    uint32_t maxBucketSize = 0;
+    uint32_t i, bucket, n;
+
+    memset(CmdNameTable.slot, 0, sizeof(CmdNameTable.slot));
+    memset(CmdNameTable.disp, 0, sizeof(CmdNameTable.disp));
+    memset(bucketSize, 0, sizeof(bucketSize));
+    CmdNameTable.slotMask = size - 1;
+    CmdNameTable.bucketMask = bucketCount - 1;
+
+    for (i = 0; i < count; i++)
+    {
+        bucket = CmdNameBucket(cmdsPtr[i]->cmdNameHash);
+        bucketSize[bucket]++;
+        if (bucketSize[bucket] > maxBucketSize)
+        {
+            maxBucketSize = bucketSize[bucket];
+        }
+    }
+
+    // Place the largest buckets first, while most of the slots are still free
+    for (n = maxBucketSize; n > 0; n--)
+    {
+        for (bucket = 0; bucket < bucketCount; bucket++)
+        {
+            if (bucketSize[bucket] != n)
+            {
+                continue;
+            }
+
+            uint32_t cmdCount = 0;
+            for (i = 0; i < count; i++)
+            {
+                if (CmdNameBucket(cmdsPtr[i]->cmdNameHash) == bucket)
+                {
+                    bucketCmds[cmdCount++] = cmdsPtr[i];
+                }
+            }
+
+            if (!PlaceCmdNameBucket(bucketCmds, cmdCount, bucket))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Build the command name table from the registered AT commands.  If they do not fit, the table is
+ * left invalid and commands are looked up in CmdHashMap.
+ */
+//--------------------------------------------------------------------------------------------------
+static void BuildCmdNameTable
+(
+    void
+)
+{
+    static ATCmdSubscribed_t* cmds[CMD_NAME_TABLE_MAX_SIZE/2];
+    uint32_t count = 0;
+    uint32_t size;
+
+    CmdNameTable.stale = false;
+    CmdNameTable.valid = false;
+
+    le_hashmap_It_Ref_t iter = le_hashmap_GetIterator(CmdHashMap);
+    while (LE_OK == le_hashmap_NextNode(iter))
+    {
+        if (count >= NUM_ARRAY_MEMBERS(cmds))
+        {
+            LE_WARN("Too many AT commands for the command name table");
+            return;
+        }
+        cmds[count++] = (ATCmdSubscribed_t*)le_hashmap_GetValue(iter);
+    }
+
+    for (size = 2 * CMD_NAME_SLOTS_PER_BUCKET; size < 2 * count; size *= 2)
+    {
+    }
+
+    for (; size <= CMD_NAME_TABLE_MAX_SIZE; size *= 2)
+    {
+        if (PlaceCmdNames(cmds, count, size))
+        {
+            LE_DEBUG("%"PRIu32" AT commands placed in %"PRIu32" slots", count, size);
+            CmdNameTable.valid = true;
+            return;
+        }
+    }
+
+    LE_WARN("Unable to build the command name table");
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Look up a registered AT command by name.
+ *
+ * @return
+ *      - Pointer to the AT command.
+ *      - NULL if the command is not registered.
+ */
+//--------------------------------------------------------------------------------------------------
+static ATCmdSubscribed_t* FindCmd
+(
+    const char* namePtr,    ///< [IN] Command name, not necessarily null-terminated
+    size_t      len         ///< [IN] Length of the command name
+)
+{
+    if (CmdNameTable.stale)
+    {
+        BuildCmdNameTable();
+    }
+
+    if (CmdNameTable.valid)
+    {
+        uint32_t hash = HashCmdName(namePtr, len);
+        uint32_t disp = CmdNameTable.disp[CmdNameBucket(hash)];
+        ATCmdSubscribed_t* cmdPtr = CmdNameTable.slot[CmdNameSlot(hash, disp)];
+
+        if ((cmdPtr) &&
+            (cmdPtr->cmdNameHash == hash) &&
+            (cmdPtr->cmdNameLen == len) &&
+            (memcmp(cmdPtr->cmdName, namePtr, len) == 0))
+        {
+            return cmdPtr;
+        }
+
+        return NULL;
+    }
+
+    char name[len + 1];
+    memcpy(name, namePtr, len);
+    name[len] = '\0';
+
+    return le_hashmap_Get(CmdHashMap, name);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get room for a new parameter of the current AT command in the parameter buffer.
+ *
+ * @return
+ *      - Pointer to the room, to be committed by AddParam().
+ *      - NULL if the parameter buffer is full.
+ */
+//--------------------------------------------------------------------------------------------------
+static char* NewParam
+(
+    CmdParser_t* cmdParserPtr,  ///< [IN] Parser
+    size_t*      sizePtr        ///< [OUT] Size of the room, including the null-terminator
+)
+{
+    size_t size = sizeof(cmdParserPtr->paramBuf) - cmdParserPtr->paramBufUsed;
+
+    if ((size == 0) || (cmdParserPtr->paramCount >= PARAM_MAX_NUMBER))
+    {
+        LE_ERROR("Too many parameters");
+        return NULL;
+    }
+
+    *sizePtr = (size < LE_ATDEFS_PARAMETER_MAX_BYTES) ? size : LE_ATDEFS_PARAMETER_MAX_BYTES;
+
+    return cmdParserPtr->paramBuf + cmdParserPtr->paramBufUsed;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add the parameter written in the room given by NewParam() to the current AT command.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddParam
+(
+    CmdParser_t* cmdParserPtr,  ///< [IN] Parser
+    size_t       len            ///< [IN] Length of the parameter
+)
+{
+    cmdParserPtr->paramBuf[cmdParserPtr->paramBufUsed + len] = '\0';
+    cmdParserPtr->paramOffset[cmdParserPtr->paramCount++] = cmdParserPtr->paramBufUsed;
+    cmdParserPtr->paramBufUsed += len + 1;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove the parameters of the current AT command.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ClearParams
+(
+    CmdParser_t* cmdParserPtr   ///< [IN] Parser
+)
+{
+    cmdParserPtr->paramCount = 0;
+    cmdParserPtr->paramBufUsed = 0;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function is the destructor for ATCmdSubscribed_t struct
@@ -1047,74 +1436,274 @@ static void AtCmdPoolDestructor
 )
 {
     ATCmdSubscribed_t* cmdPtr = commandPtr;
-    le_dls_Link_t* linkPtr;
 
     LE_DEBUG("AT command destructor for '%s'", cmdPtr->cmdName);
 
     // cleanup the hashmap
     le_hashmap_Remove(CmdHashMap, cmdPtr->cmdName);
+    CmdNameTable.stale = true;
     le_mem_Release(cmdPtr->cmdName);
 
-    // cleanup ParamList dls pool
-    while((linkPtr = le_dls_Pop(&cmdPtr->paramList)) != NULL)
+    le_ref_DeleteRef(SubscribedCmdRefMap, cmdPtr->cmdRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Keep in the output buffer of a device the part of some buffers that has not been written, and
+ * write it when the device becomes writable again.  The buffers may start with the output buffer
+ * itself, and what has not been written must fit in it.
+ */
+//--------------------------------------------------------------------------------------------------
+static void KeepUnwritten
+(
+    DeviceContext_t* devPtr,
+    const struct iovec* iovPtr,
+    int iovCount,
+    size_t written
+)
+{
+    size_t outLen = 0;
+    int i;
+
+    for (i = 0; i < iovCount; i++)
     {
-        ParamString_t *paramPtr = CONTAINER_OF(linkPtr,
-                                    ParamString_t,
-                                    link);
-        le_mem_Release(paramPtr);
+        const uint8_t* srcPtr = iovPtr[i].iov_base;
+        size_t len = iovPtr[i].iov_len;
+
+        if (written >= len)
+        {
+            written -= len;
+            continue;
+        }
+
+        srcPtr += written;
+        len -= written;
+        written = 0;
+
+        LE_ASSERT(outLen + len <= sizeof(devPtr->outBuf));
+        memmove(devPtr->outBuf + outLen, srcPtr, len);
+        outLen += len;
     }
 
-    le_ref_DeleteRef(SubscribedCmdRefMap, cmdPtr->cmdRef);
+    devPtr->outLen = outLen;
+
+    // Flow controlled: resume when the device is writable
+    if ((outLen > 0) && (!devPtr->outBlocked) && (devPtr->device.fdMonitor))
+    {
+        devPtr->outBlocked = true;
+        le_dev_EnableFdMonitoring(&devPtr->device, &RxNewData, devPtr, POLLOUT);
+    }
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Send a response on the opened device.
+ * Write the output buffer of a device.
+ *
+ * If the device is not writable, what has not been written is kept in the buffer, and written
+ * when the device becomes writable again.  If wait is set, the device is first given up to
+ * RSP_WRITE_TIMEOUT_MS to take the whole buffer.
  *
  * @return
  *      - LE_OK            The function succeeded.
- *      - LE_FAULT         The function failed to send response.
+ *      - LE_FAULT         The function failed to write the buffer, which is dropped.
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t SendRspString
+static le_result_t FlushOutput
 (
     DeviceContext_t* devPtr,
-    const char* rspPtr
+    bool wait
 )
 {
-    ssize_t strLenWritted;
-    size_t stringLen;
+    if (0 == devPtr->outLen)
+    {
+        return LE_OK;
+    }
 
-    char string[LE_ATDEFS_RESPONSE_MAX_BYTES+4] = {0};
+    struct iovec iov = { .iov_base = devPtr->outBuf, .iov_len = devPtr->outLen };
+    ssize_t written = le_dev_WriteVector(&devPtr->device, &iov, 1,
+                                         wait ? RSP_WRITE_TIMEOUT_MS : 0);
 
-    if ((devPtr->rspState == AT_RSP_FINAL) || (devPtr->rspState == AT_RSP_UNSOLICITED) ||
-        ((devPtr->rspState == AT_RSP_INTERMEDIATE) && devPtr->isFirstIntermediate))
+    if (written < 0)
     {
-        snprintf(string, LE_ATDEFS_RESPONSE_MAX_BYTES+4, "\r\n%s\r\n", rspPtr);
-        devPtr->isFirstIntermediate = false;
+        LE_ERROR("Failed to send data");
+        devPtr->outLen = 0;
+        return LE_FAULT;
     }
-    else
+
+    if (written < devPtr->outLen)
+    {
+        KeepUnwritten(devPtr, &iov, 1, written);
+        return LE_OK;
+    }
+
+    devPtr->outLen = 0;
+
+    if (devPtr->outBlocked)
+    {
+        devPtr->outBlocked = false;
+        le_dev_DisableFdMonitoring(&devPtr->device, POLLOUT);
+    }
+
+    le_fd_Ioctl(devPtr->device.fd, LE_FD_FLUSH, NULL);
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write the output buffer of a device, once the current event has been handled.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DeferredFlush
+(
+    void* param1Ptr,
+    void* param2Ptr
+)
+{
+    DeviceContext_t* devPtr = le_ref_Lookup(DevicesRefMap, param1Ptr);
+
+    if (devPtr)
+    {
+        devPtr->flushQueued = false;
+        FlushOutput(devPtr, false);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write data on a device through its output buffer.
+ *
+ * The data are appended to the buffer, which is written once the current event has been handled
+ * (so that the responses sent while handling an event are written at once), or earlier by
+ * FlushOutput().  If the buffer is full, it is written along with the data with a single writev(),
+ * and what the device doesn't take is kept in the buffer.  Only if that doesn't fit does this wait,
+ * for up to RSP_WRITE_TIMEOUT_MS, for the device to take more.
+ *
+ * @return
+ *      - LE_OK            The function succeeded.
+ *      - LE_FAULT         The function failed to write the data.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t WriteOutput
+(
+    DeviceContext_t* devPtr,
+    const struct iovec* iovPtr,
+    int iovCount
+)
+{
+    size_t size = 0;
+    int i;
+
+    for (i = 0; i < iovCount; i++)
+    {
+        size += iovPtr[i].iov_len;
+    }
+
+    if (devPtr->outLen + size <= sizeof(devPtr->outBuf))
+    {
+        for (i = 0; i < iovCount; i++)
+        {
+            memcpy(devPtr->outBuf + devPtr->outLen, iovPtr[i].iov_base, iovPtr[i].iov_len);
+            devPtr->outLen += iovPtr[i].iov_len;
+        }
+
+        if ((!devPtr->flushQueued) && (!devPtr->outBlocked))
+        {
+            devPtr->flushQueued = true;
+            le_event_QueueFunction(DeferredFlush, devPtr->ref, NULL);
+        }
+        return LE_OK;
+    }
+
+    struct iovec iov[iovCount + 1];
+    struct iovec* restPtr = iov;
+    int restCount = iovCount + 1;
+
+    iov[0].iov_base = devPtr->outBuf;
+    iov[0].iov_len = devPtr->outLen;
+    struct iovec outIov = iov[0];
+    memcpy(&iov[1], iovPtr, iovCount * sizeof(struct iovec));
+    size += devPtr->outLen;
+    devPtr->outLen = 0;
+
+    if (devPtr->outBlocked)
     {
-        snprintf(string, LE_ATDEFS_RESPONSE_MAX_BYTES+2, "%s\r\n", rspPtr);
+        devPtr->outBlocked = false;
+        le_dev_DisableFdMonitoring(&devPtr->device, POLLOUT);
     }
 
-    stringLen = strnlen(string, LE_ATDEFS_RESPONSE_MAX_BYTES);
-    strLenWritted = le_dev_Write(&devPtr->device, (uint8_t*) string, stringLen);
+    ssize_t written = le_dev_WriteVector(&devPtr->device, iov, restCount, 0);
+    ssize_t restWritten = written;
 
-    if (devPtr->rspState != AT_RSP_INTERMEDIATE)
+    if ((written >= 0) && ((size - written) > sizeof(devPtr->outBuf)))
     {
-        le_fd_Ioctl(devPtr->device.fd, LE_FD_FLUSH, NULL);
+        // Too much is left to be kept: wait a bounded time for the device to take more
+        size_t skip = written;
+
+        while (skip >= restPtr->iov_len)
+        {
+            skip -= restPtr->iov_len;
+            restPtr++;
+            restCount--;
+        }
+        restPtr->iov_base = (uint8_t*)restPtr->iov_base + skip;
+        restPtr->iov_len -= skip;
+
+        restWritten = le_dev_WriteVector(&devPtr->device, restPtr, restCount,
+                                         RSP_WRITE_TIMEOUT_MS);
+        written = (restWritten < 0) ? restWritten : written + restWritten;
     }
 
-    if(strLenWritted < stringLen)
+    if ((written < 0) || ((size - written) > sizeof(devPtr->outBuf)))
     {
         LE_ERROR("Failed to send data");
+
+        // Only the new data are dropped: keep what is left of the responses already accepted
+        if (written >= 0)
+        {
+            KeepUnwritten(devPtr, &outIov, 1, written);
+        }
         return LE_FAULT;
     }
-    else
+
+    KeepUnwritten(devPtr, restPtr, restCount, restWritten);
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send a response on the opened device, through its output buffer.
+ *
+ * @return
+ *      - LE_OK            The function succeeded.
+ *      - LE_FAULT         The function failed to send response.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t SendRspString
+(
+    DeviceContext_t* devPtr,
+    const char* rspPtr
+)
+{
+    static char crLf[] = "\r\n";
+    struct iovec iov[3];
+    int iovCount = 0;
+
+    if ((devPtr->rspState == AT_RSP_FINAL) || (devPtr->rspState == AT_RSP_UNSOLICITED) ||
+        ((devPtr->rspState == AT_RSP_INTERMEDIATE) && devPtr->isFirstIntermediate))
     {
-        return LE_OK;
+        iov[iovCount].iov_base = crLf;
+        iov[iovCount++].iov_len = sizeof(crLf) - 1;
+        devPtr->isFirstIntermediate = false;
     }
+
+    iov[iovCount].iov_base = (char*)rspPtr;
+    iov[iovCount++].iov_len = strnlen(rspPtr, LE_ATDEFS_RESPONSE_MAX_BYTES - 1);
+    iov[iovCount].iov_base = crLf;
+    iov[iovCount++].iov_len = sizeof(crLf) - 1;
+
+    return WriteOutput(devPtr, iov, iovCount);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1346,6 +1935,9 @@ end_processing:
         le_mem_Release(rspStringPtr);
     }
 
+    // End of command: write the responses now
+    FlushOutput(devPtr, false);
+
     return res;
 }
 
@@ -1425,6 +2017,7 @@ static void SendUnsolRsp
     if (!devPtr->processing && !devPtr->suspended)
     {
         SendRspString(devPtr, rspStringPtr->resp);
+        FlushOutput(devPtr, false);
         le_mem_Release(rspStringPtr);
     }
     else
@@ -1454,8 +2047,7 @@ static le_result_t CreateModemCommand
         return LE_FAULT;
     }
 
-    cmdParserPtr->currentCmdPtr = le_hashmap_Get(CmdHashMap,
-                                                 atCmdPtr);
+    cmdParserPtr->currentCmdPtr = FindCmd(atCmdPtr, strlen(atCmdPtr));
 
     if ( cmdParserPtr->currentCmdPtr == NULL )
     {
@@ -1500,7 +2092,8 @@ static le_result_t GetAtCmdContext
 
     if (cmdParserPtr->currentCmdPtr == NULL)
     {
-        cmdParserPtr->currentCmdPtr = le_hashmap_Get(CmdHashMap, cmdParserPtr->currentAtCmdPtr);
+        cmdParserPtr->currentCmdPtr = FindCmd(cmdParserPtr->currentAtCmdPtr,
+                                              strlen(cmdParserPtr->currentAtCmdPtr));
 
         if ( cmdParserPtr->currentCmdPtr == NULL )
         {
@@ -1643,11 +2236,16 @@ static le_result_t ParseBasicCmdParam
     CmdParser_t* cmdParserPtr
 )
 {
-    ParamString_t* paramPtr = le_mem_ForceAlloc(ParamStringPool);
-    memset(paramPtr,0,sizeof(ParamString_t));
+    size_t paramSize;
+    char* paramPtr = NewParam(cmdParserPtr, &paramSize);
     uint32_t index = 0;
     bool tokenQuote = false;
 
+    if (NULL == paramPtr)
+    {
+        return LE_OVERFLOW;
+    }
+
     while ( cmdParserPtr->currentCharPtr <= cmdParserPtr->lastCharPtr )
     {
         if ( IS_QUOTE(*cmdParserPtr->currentCharPtr) )
@@ -1664,9 +2262,9 @@ static le_result_t ParseBasicCmdParam
             // If "bridge command", keep the quote
             if ((cmdParserPtr->currentCmdPtr)->bridgeCmd)
             {
-                if (index < sizeof(paramPtr->param) -1)
+                if (index < paramSize -1)
                 {
-                    paramPtr->param[index++] = *cmdParserPtr->currentCharPtr;
+                    paramPtr[index++] = *cmdParserPtr->currentCharPtr;
                 }
                 else
                 {
@@ -1678,9 +2276,9 @@ static le_result_t ParseBasicCmdParam
         {
             if ((tokenQuote) || ( IS_NUMBER(*cmdParserPtr->currentCharPtr) ))
             {
-                if (index < sizeof(paramPtr->param) -1)
+                if (index < paramSize -1)
                 {
-                    paramPtr->param[index++] = *cmdParserPtr->currentCharPtr;
+                    paramPtr[index++] = *cmdParserPtr->currentCharPtr;
                 }
                 else
                 {
@@ -1702,7 +2300,7 @@ static le_result_t ParseBasicCmdParam
     }
 
     cmdParserPtr->currentCmdPtr->type = LE_ATSERVER_TYPE_PARA;
-    le_dls_Queue(&(cmdParserPtr->currentCmdPtr->paramList),&(paramPtr->link));
+    AddParam(cmdParserPtr, index);
 
     return LE_OK;
 }
@@ -1724,11 +2322,16 @@ static le_result_t ParseBasicDCmdParam
 
     int i;
     int index = 0;
-    ParamString_t* paramPtr = le_mem_ForceAlloc(ParamStringPool);
+    size_t paramSize;
+    char* paramPtr = NewParam(cmdParserPtr, &paramSize);
     bool dialingFromPhonebook = false;
-    memset(paramPtr,0,sizeof(ParamString_t));
     bool tokenQuote = false;
 
+    if (NULL == paramPtr)
+    {
+        return LE_OVERFLOW;
+    }
+
     LE_DEBUG("%s", cmdParserPtr->currentCharPtr);
 
     if ( *cmdParserPtr->currentCharPtr == '>' )
@@ -1751,9 +2354,9 @@ static le_result_t ParseBasicDCmdParam
                     tokenQuote = true;
                 }
 
-                if (index < sizeof(paramPtr->param) -1)
+                if (index < paramSize -1)
                 {
-                    paramPtr->param[index++] = *cmdParserPtr->currentCharPtr;
+                    paramPtr[index++] = *cmdParserPtr->currentCharPtr;
                 }
                 else
                 {
@@ -1764,9 +2367,9 @@ static le_result_t ParseBasicDCmdParam
             {
                 if (tokenQuote)
                 {
-                    if (index < sizeof(paramPtr->param) -1)
+                    if (index < paramSize -1)
                     {
-                        paramPtr->param[index++] = *cmdParserPtr->currentCharPtr;
+                        paramPtr[index++] = *cmdParserPtr->currentCharPtr;
                     }
                     else
                     {
@@ -1778,9 +2381,9 @@ static le_result_t ParseBasicDCmdParam
                     if ( (*cmdParserPtr->currentCharPtr == 'i') ||
                          ( *cmdParserPtr->currentCharPtr == 'g') )
                     {
-                        if (index < sizeof(paramPtr->param) -1)
+                        if (index < paramSize -1)
                         {
-                            paramPtr->param[index++] = *cmdParserPtr->currentCharPtr;
+                            paramPtr[index++] = *cmdParserPtr->currentCharPtr;
                         }
                         else
                         {
@@ -1789,9 +2392,9 @@ static le_result_t ParseBasicDCmdParam
                     }
                     else
                     {
-                        if (index < sizeof(paramPtr->param) -1)
+                        if (index < paramSize -1)
                         {
-                            paramPtr->param[index++] = toupper(*cmdParserPtr->currentCharPtr);
+                            paramPtr[index++] = toupper(*cmdParserPtr->currentCharPtr);
                         }
                         else
                         {
@@ -1817,9 +2420,9 @@ static le_result_t ParseBasicDCmdParam
                 {
                     if (*testCharPtr == charTabPtr[i])
                     {
-                        if (index < sizeof(paramPtr->param) -1)
+                        if (index < paramSize -1)
                         {
-                            paramPtr->param[index++] = *testCharPtr;
+                            paramPtr[index++] = *testCharPtr;
                         }
                         else
                         {
@@ -1859,13 +2462,12 @@ static le_result_t ParseBasicDCmdParam
     if (index == 0)
     {
         LE_ERROR("empty phone number");
-        le_mem_Release(paramPtr);
         return LE_FAULT;
     }
 
 end:
     cmdParserPtr->currentCmdPtr->type = LE_ATSERVER_TYPE_PARA;
-    le_dls_Queue(&(cmdParserPtr->currentCmdPtr->paramList),&(paramPtr->link));
+    AddParam(cmdParserPtr, index);
 
     return LE_OK;
 }
@@ -1959,19 +2561,17 @@ static le_result_t ParseBasic
         cmdParserPtr->currentCharPtr++;
     }
 
-    uint32_t len = cmdParserPtr->currentCharPtr-cmdParserPtr->currentAtCmdPtr+1;
+    size_t len = cmdParserPtr->currentCharPtr-cmdParserPtr->currentAtCmdPtr;
     char* initialPosPtr = cmdParserPtr->currentCharPtr;
-    char atCmd[len];
-    memset(atCmd,0,len);
-    strncpy(atCmd, cmdParserPtr->currentAtCmdPtr, len-1);
 
-    while (strlen(atCmd) > 2)
+    // Look for the longest registered command the name starts with
+    while (len > 2)
     {
-        cmdParserPtr->currentCmdPtr = le_hashmap_Get(CmdHashMap, atCmd);
+        cmdParserPtr->currentCmdPtr = FindCmd(cmdParserPtr->currentAtCmdPtr, len);
 
         if ( cmdParserPtr->currentCmdPtr == NULL )
         {
-            atCmd[strlen(atCmd)-1] = '\0';
+            len--;
             cmdParserPtr->currentCharPtr--;
         }
         else
@@ -1991,7 +2591,10 @@ static le_result_t ParseBasic
         //Reset the pointer to its initial value
         cmdParserPtr->currentCharPtr = initialPosPtr;
 
-        strncpy(atCmd, cmdParserPtr->currentAtCmdPtr, len-1);
+        len = initialPosPtr - cmdParserPtr->currentAtCmdPtr;
+        char atCmd[len + 1];
+        memcpy(atCmd, cmdParserPtr->currentAtCmdPtr, len);
+        atCmd[len] = '\0';
 
         if (( CreateModemCommand(cmdParserPtr,
                                  atCmd,
@@ -2048,10 +2651,15 @@ static le_result_t ParseParam
     uint32_t index = 0;
     bool tokenQuote = false;
     bool loop = true;
-    ParamString_t* paramPtr = le_mem_ForceAlloc(ParamStringPool);
-    memset(paramPtr, 0, sizeof(ParamString_t));
+    size_t paramSize;
+    char* paramPtr = NewParam(cmdParserPtr, &paramSize);
+
+    if (NULL == paramPtr)
+    {
+        return LE_OVERFLOW;
+    }
 
-    if (le_dls_NumLinks(&(cmdParserPtr->currentCmdPtr->paramList)) != 0)
+    if (cmdParserPtr->paramCount != 0)
     {
         // bypass comma (not done for the first param)
         cmdParserPtr->currentCharPtr++;
@@ -2070,7 +2678,6 @@ static le_result_t ParseParam
         if (LE_ATDEFS_PARAMETER_MAX_BYTES <= index)
         {
             LE_ERROR("Parameter size exceeds %d bytes", LE_ATDEFS_PARAMETER_MAX_BYTES);
-            le_mem_Release(paramPtr);
             return LE_FAULT;
         }
 
@@ -2088,9 +2695,9 @@ static le_result_t ParseParam
             // If "bridge command", keep the quote
             if ((cmdParserPtr->currentCmdPtr)->bridgeCmd)
             {
-                if (index < sizeof(paramPtr->param) -1)
+                if (index < paramSize -1)
                 {
-                    paramPtr->param[index++] = *cmdParserPtr->currentCharPtr;
+                    paramPtr[index++] = *cmdParserPtr->currentCharPtr;
                 }
                 else
                 {
@@ -2108,9 +2715,9 @@ static le_result_t ParseParam
 
             if ((tokenQuote) || ( IS_PARAM_CHAR(*cmdParserPtr->currentCharPtr) ))
             {
-                if (index < sizeof(paramPtr->param) -1)
+                if (index < paramSize -1)
                 {
-                    paramPtr->param[index++] = *cmdParserPtr->currentCharPtr;
+                    paramPtr[index++] = *cmdParserPtr->currentCharPtr;
                 }
                 else
                 {
@@ -2119,7 +2726,6 @@ static le_result_t ParseParam
             }
             else
             {
-                le_mem_Release(paramPtr);
                 return LE_FAULT;
             }
         }
@@ -2140,7 +2746,7 @@ static le_result_t ParseParam
         }
     }
 
-    le_dls_Queue(&(cmdParserPtr->currentCmdPtr->paramList),&(paramPtr->link));
+    AddParam(cmdParserPtr, index);
 
     return LE_OK;
 }
@@ -2162,15 +2768,20 @@ static le_result_t ParseReadParam
         // into the parameter 0 if exists.
         uint32_t index = 0;
         bool loop = true;
-        ParamString_t* paramPtr = le_mem_ForceAlloc(ParamStringPool);
-        memset(paramPtr, 0, sizeof(ParamString_t));
+        size_t paramSize;
+        char* paramPtr = NewParam(cmdParserPtr, &paramSize);
+
+        if (NULL == paramPtr)
+        {
+            return LE_OVERFLOW;
+        }
 
         // Go through paramater buffers until ";" or last char.
         while (loop)
         {
-            if (index < sizeof(paramPtr->param) -1)
+            if (index < paramSize -1)
             {
-                paramPtr->param[index++] = *cmdParserPtr->currentCharPtr;
+                paramPtr[index++] = *cmdParserPtr->currentCharPtr;
             }
             else
             {
@@ -2186,7 +2797,7 @@ static le_result_t ParseReadParam
                 cmdParserPtr->currentCharPtr--;
             }
         }
-        le_dls_Queue(&(cmdParserPtr->currentCmdPtr->paramList),&(paramPtr->link));
+        AddParam(cmdParserPtr, index);
         return LE_OK;
     }
     return LE_FAULT;
@@ -2283,6 +2894,7 @@ static void ParseAtCmd
     cmdParserPtr->cmdParser = PARSE_CMDNAME;
 
     devPtr->cmdParser.currentCmdPtr = NULL;
+    ClearParams(cmdParserPtr);
 
     devPtr->isFirstIntermediate = true;
 
@@ -2408,16 +3020,7 @@ static void ParseAtCmd
             }
 
             // Incurred error in parsing AT command. Clear all parsed parameters.
-            if (cmdParserPtr->currentCmdPtr)
-            {
-                ATCmdSubscribed_t* cmdPtr = cmdParserPtr->currentCmdPtr;
-                le_dls_Link_t* linkPtr;
-                while ((linkPtr = le_dls_Pop(&cmdPtr->paramList)) != NULL)
-                {
-                    ParamString_t *paraPtr = CONTAINER_OF(linkPtr, ParamString_t, link);
-                    le_mem_Release(paraPtr);
-                }
-            }
+            ClearParams(cmdParserPtr);
 
             const int sizeMax = LE_ATDEFS_RESPONSE_MAX_BYTES;
             strncpy(devPtr->finalRsp.pattern, LE_ATSERVER_CME_ERROR, sizeMax - 1);
@@ -2438,7 +3041,7 @@ static void ParseAtCmd
         {
             (cmdPtr->handlerFunc)( cmdPtr->cmdRef,
                                    cmdPtr->type,
-                                   le_dls_NumLinks(&(cmdPtr->paramList)),
+                                   cmdParserPtr->paramCount,
                                    cmdPtr->handlerContextPtr );
         }
         else
@@ -2447,12 +3050,7 @@ static void ParseAtCmd
             cmdParserPtr->currentCmdPtr->processing = false;
 
             // Clean AT command context, not in use now
-            le_dls_Link_t* linkPtr;
-            while ((linkPtr=le_dls_Pop(&cmdPtr->paramList)) != NULL)
-            {
-                ParamString_t *paraPtr = CONTAINER_OF(linkPtr, ParamString_t, link);
-                le_mem_Release(paraPtr);
-            }
+            ClearParams(cmdParserPtr);
 
             goto sendErrorRsp;
         }
@@ -2471,6 +3069,10 @@ sendErrorRsp:
 /**
  * Parser incoming characters
  *
+ * The characters preceding a command and the characters of a command line are not handled one at
+ * a time: the next 'A', and the next carriage return or backspace, are searched with memchr() and
+ * everything in between is skipped or moved at once.
+ *
  */
 //--------------------------------------------------------------------------------------------------
 static void ParseBuffer
@@ -2478,21 +3080,38 @@ static void ParseBuffer
     DeviceContext_t* devPtr
 )
 {
-    uint32_t i;
+    uint32_t i = devPtr->parseIndex;
 
-    for (i = devPtr->parseIndex; i < devPtr->indexRead; i++)
+    while (i < devPtr->indexRead)
     {
-        char input = devPtr->currentCmd[i];
+        char* startPtr = devPtr->currentCmd + i;
+        size_t remaining = devPtr->indexRead - i;
+        char input = *startPtr;
 
         switch (devPtr->cmdParser.rxState)
         {
             case PARSER_SEARCH_A:
-                if (( input == 'A' ) || ( input == 'a' ))
+            {
+                char* foundPtr = memchr(startPtr, 'A', remaining);
+                char* lowerPtr = memchr(startPtr, 'a',
+                                        foundPtr ? (size_t)(foundPtr - startPtr) : remaining);
+
+                if (lowerPtr)
                 {
-                    devPtr->currentCmd[0] = input;
-                    devPtr->cmdParser.rxState = PARSER_SEARCH_T;
-                    devPtr->parseIndex = 1;
+                    foundPtr = lowerPtr;
                 }
+
+                if (NULL == foundPtr)
+                {
+                    i = devPtr->indexRead;
+                    continue;
+                }
+
+                i = foundPtr - devPtr->currentCmd;
+                devPtr->currentCmd[0] = *foundPtr;
+                devPtr->cmdParser.rxState = PARSER_SEARCH_T;
+                devPtr->parseIndex = 1;
+            }
             break;
             case PARSER_SEARCH_T:
                 switch (input)
@@ -2519,6 +3138,30 @@ static void ParseBuffer
             break;
             case PARSER_SEARCH_CR:
             {
+                // Move the characters up to the next carriage return or backspace at once
+                char* crPtr = memchr(startPtr, AT_TOKEN_CR, remaining);
+                size_t count = crPtr ? (size_t)(crPtr - startPtr) : remaining;
+                char* backspacePtr = memchr(startPtr, AT_TOKEN_BACKSPACE, count);
+
+                if (backspacePtr)
+                {
+                    count = backspacePtr - startPtr;
+                }
+
+                if (devPtr->parseIndex != i)
+                {
+                    memmove(devPtr->currentCmd + devPtr->parseIndex, startPtr, count);
+                }
+                devPtr->parseIndex += count;
+                i += count;
+
+                if (i == devPtr->indexRead)
+                {
+                    continue;
+                }
+
+                input = devPtr->currentCmd[i];
+
                 if ( input == AT_TOKEN_CR )
                 {
                     if (!devPtr->processing)
@@ -2563,14 +3206,9 @@ static void ParseBuffer
                     devPtr->cmdParser.rxState = PARSER_SEARCH_A;
                 }
                 // backspace character
-                else if ( input == 0x7F )
-                {
-                    devPtr->parseIndex--;
-                }
                 else
                 {
-                    devPtr->currentCmd[devPtr->parseIndex] = input;
-                    devPtr->parseIndex++;
+                    devPtr->parseIndex--;
                 }
             }
             break;
@@ -2578,6 +3216,8 @@ static void ParseBuffer
                 LE_ERROR("bad state !!");
             break;
         }
+
+        i++;
     }
 
     devPtr->indexRead = devPtr->parseIndex;
@@ -2623,9 +3263,9 @@ static void ReceiveCmd
     // Echo is activated
     if (devPtr->echo)
     {
-        le_dev_Write(&devPtr->device,
-                    (uint8_t *)(devPtr->currentCmd + devPtr->indexRead),
-                    size);
+        struct iovec iov = { .iov_base = devPtr->currentCmd + devPtr->indexRead,
+                             .iov_len = size };
+        WriteOutput(devPtr, &iov, 1);
     }
 
     devPtr->indexRead += size;
@@ -2861,6 +3501,11 @@ __attribute__((unused)) static void RxNewData
         return;
     }
 
+    if (events & POLLOUT)
+    {
+        FlushOutput(devPtr, false);
+    }
+
     if (events & (POLLIN | POLLPRI))
     {
 #if LE_CONFIG_ATSERVER_TEXT_API
@@ -2879,7 +3524,7 @@ __attribute__((unused)) static void RxNewData
         ReceiveCmd(devPtr);
 #endif
     }
-    else
+    else if (!(events & POLLOUT))
     {
         LE_CRIT("Unexpected event(s) on fd %d (0x%hX).", fd, events);
     }
@@ -2962,6 +3607,7 @@ static le_result_t CloseServer
 
     LE_DEBUG("Stopping device %"PRIi32"", devPtr->device.fd);
 
+    FlushOutput(devPtr, true);
     le_dev_DeleteFdMonitoring(&devPtr->device);
 
 #if LE_CONFIG_LINUX
@@ -3107,6 +3753,9 @@ le_result_t le_atServer_Suspend
         return LE_BAD_PARAMETER;
     }
 
+    // The responses must reach the host before the device is handed over
+    FlushOutput(devPtr, true);
+
     le_dev_DisableFdMonitoring(&devPtr->device, AT_EVENTS);
     devPtr->suspended = true;
 
@@ -3370,10 +4019,12 @@ le_atServer_CmdRef_t le_atServer_Create
 
     cmdPtr->cmdRef = le_ref_CreateRef(SubscribedCmdRefMap, cmdPtr);
 
+    cmdPtr->cmdNameLen = strlen(cmdPtr->cmdName);
+    cmdPtr->cmdNameHash = HashCmdName(cmdPtr->cmdName, cmdPtr->cmdNameLen);
     le_hashmap_Put(CmdHashMap, cmdPtr->cmdName, cmdPtr);
+    CmdNameTable.stale = true;
 
     cmdPtr->availableDevice = LE_ATSERVER_ALL_DEVICES;
-    cmdPtr->paramList = LE_DLS_LIST_INIT;
 
     // NOTE: The 'sessionRef' is NULL if the command is created by bridge device because
     // we are not in IPC command environment. In this case, "sessionRef" is set when the
@@ -3579,34 +4230,25 @@ le_result_t le_atServer_GetParameter
         return LE_FAULT;
     }
 
-    uint32_t numParam = le_dls_NumLinks(&cmdPtr->paramList);
-    uint32_t i;
-    le_dls_Link_t* linkPtr;
+    // Parameters are only available while the command is processed on a device
+    DeviceContext_t* devPtr = NULL;
 
-    if (index >= numParam)
+    if (cmdPtr->deviceRef)
     {
-        return LE_BAD_PARAMETER;
+        devPtr = le_ref_Lookup(DevicesRefMap, cmdPtr->deviceRef);
     }
 
-    linkPtr = le_dls_Peek(&cmdPtr->paramList);
-
-    for(i=0;i<index;i++)
+    if ((NULL == devPtr) ||
+        (devPtr->cmdParser.currentCmdPtr != cmdPtr) ||
+        (index >= devPtr->cmdParser.paramCount))
     {
-        linkPtr = le_dls_PeekNext(&cmdPtr->paramList, linkPtr);
+        return LE_BAD_PARAMETER;
     }
 
-    if (linkPtr)
-    {
-        ParamString_t* paramPtr;
-
-        paramPtr = CONTAINER_OF(linkPtr, ParamString_t, link);
+    snprintf(parameter, parameterNumElements, "%s",
+             devPtr->cmdParser.paramBuf + devPtr->cmdParser.paramOffset[index]);
 
-        snprintf(parameter, parameterNumElements, "%s", paramPtr->param);
-
-        return LE_OK;
-    }
-
-    return LE_FAULT;
+    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -3783,12 +4425,7 @@ le_result_t le_atServer_SendFinalResponse
     }
 
     // clean AT command context, not in use now
-    le_dls_Link_t* linkPtr;
-    while ((linkPtr = le_dls_Pop(&cmdPtr->paramList)) != NULL)
-    {
-        ParamString_t *paraPtr = CONTAINER_OF(linkPtr, ParamString_t, link);
-        le_mem_Release(paraPtr);
-    }
+    ClearParams(&devPtr->cmdParser);
 
     cmdPtr->deviceRef = NULL;
     cmdPtr->processing = false;
@@ -3863,12 +4500,7 @@ le_result_t le_atServer_SendFinalResultCode
     }
 
     // Clean AT command context, not in use now
-    le_dls_Link_t* linkPtr;
-    while ((linkPtr=le_dls_Pop(&cmdPtr->paramList)) != NULL)
-    {
-        ParamString_t *paraPtr = CONTAINER_OF(linkPtr, ParamString_t, link);
-        le_mem_Release(paraPtr);
-    }
+    ClearParams(&devPtr->cmdParser);
 
     cmdPtr->deviceRef = NULL;
     cmdPtr->processing = false;
@@ -4356,6 +4988,7 @@ le_result_t le_atServer_GetTextAsync
     devPtr->text.cmdRef = cmdRef;
 
     // @TODO: Rework the write operation if this function is ever needed for RTOS
+    FlushOutput(devPtr, true);
     le_dev_Write(&devPtr->device, (uint8_t *)TEXT_PROMPT, TEXT_PROMPT_LEN);
 
     return LE_OK;
@@ -4454,11 +5087,6 @@ COMPONENT_INIT
                                                     0, CMD_STRING_TYPICAL_BYTES);
 
 
-    // Parameters pool allocation
-    ParamStringPool = le_mem_InitStaticPool(ParamString,
-                                            PARAM_POOL_SIZE,
-                                            sizeof(ParamString_t));
-
     // Parameters pool allocation
     RspStringPool = le_mem_InitStaticPool(RspString,
                                           RSP_POOL_SIZE,
@@ -33,6 +33,13 @@ static le_log_TraceRef_t TraceRef;
 # define min(a, b) ((a)<(b) ? (a) : (b))
 #endif
 
+/* 8 septets are packed in a word of 7 bytes */
+#define SEPTETS_PER_WORD    8
+#define BYTES_PER_WORD      7
+
+/* After words with an escape, up to (SEPTETS_PER_WORD << 3) chars are converted one by one */
+#define MAX_WORD_MISSES     3
+
 /* C.S0005-D v2.0 Table 2.7.1.3.2.4-4. Representation of DTMF Digits */
 static const char *DtmfChars = "D1234567890*#ABC";
 
@@ -92,6 +99,14 @@ static const char *DtmfChars = "D1234567890*#ABC";
 #define TYPE_OF_ADDRESS_UNKNOWN         0x81
 #define TYPE_OF_ADDRESS_INTERNATIONAL   0x91
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Information Element Identifiers of the User Data Header (cf. 3GPP TS 23.040 section 9.2.3.24)
+ */
+//--------------------------------------------------------------------------------------------------
+#define UDH_IEI_CONCAT_8BIT_REF         0x00
+#define UDH_IEI_CONCAT_16BIT_REF        0x08
+
 /****************************************************************************
  * This lookup table converts from ISO-8859-1 8-bit ASCII to the
  * 7 bit "default alphabet" as defined in ETSI GSM 03.38
@@ -522,6 +537,144 @@ const uint8_t Ascii7to8[] = {
 
 };
 
+/****************************************************************************
+ *  This lookup table converts the character following an escape (decimal 27)
+ *   in the 7 bit "default alphabet" to a standard ISO-8859-1 8-bit ASCII,
+ *   i.e. the double bytes listed at the end of the previous table.
+ *
+ *   The other escaped characters are replaced by the NPC8-character.
+ ****************************************************************************/
+static const uint8_t Ascii7to8Ext[] = {
+    NPC8,       /*  0                                               */
+    NPC8,       /*  1                                               */
+    NPC8,       /*  2                                               */
+    NPC8,       /*  3                                               */
+    NPC8,       /*  4                                               */
+    NPC8,       /*  5                                               */
+    NPC8,       /*  6                                               */
+    NPC8,       /*  7                                               */
+    NPC8,       /*  8                                               */
+    NPC8,       /*  9                                               */
+    12,         /*  10        FORM FEED                             */
+    NPC8,       /*  11                                              */
+    NPC8,       /*  12                                              */
+    NPC8,       /*  13                                              */
+    NPC8,       /*  14                                              */
+    NPC8,       /*  15                                              */
+    NPC8,       /*  16                                              */
+    NPC8,       /*  17                                              */
+    NPC8,       /*  18                                              */
+    NPC8,       /*  19                                              */
+    '^',        /*  20     ^  CIRCUMFLEX ACCENT                     */
+    NPC8,       /*  21                                              */
+    NPC8,       /*  22                                              */
+    NPC8,       /*  23                                              */
+    NPC8,       /*  24                                              */
+    NPC8,       /*  25                                              */
+    NPC8,       /*  26                                              */
+    NPC8,       /*  27                                              */
+    NPC8,       /*  28                                              */
+    NPC8,       /*  29                                              */
+    NPC8,       /*  30                                              */
+    NPC8,       /*  31                                              */
+    NPC8,       /*  32                                              */
+    NPC8,       /*  33                                              */
+    NPC8,       /*  34                                              */
+    NPC8,       /*  35                                              */
+    NPC8,       /*  36                                              */
+    NPC8,       /*  37                                              */
+    NPC8,       /*  38                                              */
+    NPC8,       /*  39                                              */
+    '{',        /*  40     {  LEFT CURLY BRACKET                    */
+    '}',        /*  41     }  RIGHT CURLY BRACKET                   */
+    NPC8,       /*  42                                              */
+    NPC8,       /*  43                                              */
+    NPC8,       /*  44                                              */
+    NPC8,       /*  45                                              */
+    NPC8,       /*  46                                              */
+    '\\',       /*  47     \  REVERSE SOLIDUS (BACKSLASH)           */
+    NPC8,       /*  48                                              */
+    NPC8,       /*  49                                              */
+    NPC8,       /*  50                                              */
+    NPC8,       /*  51                                              */
+    NPC8,       /*  52                                              */
+    NPC8,       /*  53                                              */
+    NPC8,       /*  54                                              */
+    NPC8,       /*  55                                              */
+    NPC8,       /*  56                                              */
+    NPC8,       /*  57                                              */
+    NPC8,       /*  58                                              */
+    NPC8,       /*  59                                              */
+    '[',        /*  60     [  LEFT SQUARE BRACKET                   */
+    '~',        /*  61     ~  TILDE                                 */
+    ']',        /*  62     ]  RIGHT SQUARE BRACKET                  */
+    NPC8,       /*  63                                              */
+    '|',        /*  64     |  VERTICAL BAR                          */
+    NPC8,       /*  65                                              */
+    NPC8,       /*  66                                              */
+    NPC8,       /*  67                                              */
+    NPC8,       /*  68                                              */
+    NPC8,       /*  69                                              */
+    NPC8,       /*  70                                              */
+    NPC8,       /*  71                                              */
+    NPC8,       /*  72                                              */
+    NPC8,       /*  73                                              */
+    NPC8,       /*  74                                              */
+    NPC8,       /*  75                                              */
+    NPC8,       /*  76                                              */
+    NPC8,       /*  77                                              */
+    NPC8,       /*  78                                              */
+    NPC8,       /*  79                                              */
+    NPC8,       /*  80                                              */
+    NPC8,       /*  81                                              */
+    NPC8,       /*  82                                              */
+    NPC8,       /*  83                                              */
+    NPC8,       /*  84                                              */
+    NPC8,       /*  85                                              */
+    NPC8,       /*  86                                              */
+    NPC8,       /*  87                                              */
+    NPC8,       /*  88                                              */
+    NPC8,       /*  89                                              */
+    NPC8,       /*  90                                              */
+    NPC8,       /*  91                                              */
+    NPC8,       /*  92                                              */
+    NPC8,       /*  93                                              */
+    NPC8,       /*  94                                              */
+    NPC8,       /*  95                                              */
+    NPC8,       /*  96                                              */
+    NPC8,       /*  97                                              */
+    NPC8,       /*  98                                              */
+    NPC8,       /*  99                                              */
+    NPC8,       /*  100                                             */
+    NPC8,       /*  101                                             */
+    NPC8,       /*  102                                             */
+    NPC8,       /*  103                                             */
+    NPC8,       /*  104                                             */
+    NPC8,       /*  105                                             */
+    NPC8,       /*  106                                             */
+    NPC8,       /*  107                                             */
+    NPC8,       /*  108                                             */
+    NPC8,       /*  109                                             */
+    NPC8,       /*  110                                             */
+    NPC8,       /*  111                                             */
+    NPC8,       /*  112                                             */
+    NPC8,       /*  113                                             */
+    NPC8,       /*  114                                             */
+    NPC8,       /*  115                                             */
+    NPC8,       /*  116                                             */
+    NPC8,       /*  117                                             */
+    NPC8,       /*  118                                             */
+    NPC8,       /*  119                                             */
+    NPC8,       /*  120                                             */
+    NPC8,       /*  121                                             */
+    NPC8,       /*  122                                             */
+    NPC8,       /*  123                                             */
+    NPC8,       /*  124                                             */
+    NPC8,       /*  125                                             */
+    NPC8,       /*  126                                             */
+    NPC8        /*  127                                             */
+};
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Dump the PDU
@@ -569,27 +722,83 @@ static inline unsigned int Read7Bits
     return (a|b) & 0x7F;
 }
 
-static inline void Write7Bits
+//--------------------------------------------------------------------------------------------------
+/**
+ * Load a word of 7 bytes (8 septets) from a 7bits array.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline uint64_t Load7Bytes
+(
+    const uint8_t* bufferPtr
+)
+{
+    return  (uint64_t)bufferPtr[0]        |
+           ((uint64_t)bufferPtr[1] << 8)  |
+           ((uint64_t)bufferPtr[2] << 16) |
+           ((uint64_t)bufferPtr[3] << 24) |
+           ((uint64_t)bufferPtr[4] << 32) |
+           ((uint64_t)bufferPtr[5] << 40) |
+           ((uint64_t)bufferPtr[6] << 48);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Store the 7 lower bytes of a word (8 septets) into a 7bits array.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline void Store7Bytes
 (
     uint8_t* bufferPtr,
-    uint8_t  val,
-    uint32_t pos
+    uint64_t word
 )
 {
-    val &= 0x7F;
-    uint8_t idx = pos/8;
+    bufferPtr[0] = word & 0xFF;
+    bufferPtr[1] = (word >> 8) & 0xFF;
+    bufferPtr[2] = (word >> 16) & 0xFF;
+    bufferPtr[3] = (word >> 24) & 0xFF;
+    bufferPtr[4] = (word >> 32) & 0xFF;
+    bufferPtr[5] = (word >> 40) & 0xFF;
+    bufferPtr[6] = (word >> 48) & 0xFF;
+}
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Spread a word of 8 septets into 8 bytes, one septet per byte.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline uint64_t SpreadSeptets
+(
+    uint64_t word
+)
+{
+    return ( word        & 0x000000000000007FULL) |
+           ((word << 1)  & 0x0000000000007F00ULL) |
+           ((word << 2)  & 0x00000000007F0000ULL) |
+           ((word << 3)  & 0x000000007F000000ULL) |
+           ((word << 4)  & 0x0000007F00000000ULL) |
+           ((word << 5)  & 0x00007F0000000000ULL) |
+           ((word << 6)  & 0x007F000000000000ULL) |
+           ((word << 7)  & 0x7F00000000000000ULL);
+}
 
-    if (!(pos&7)) {
-        bufferPtr[idx] = val;
-    }
-    else if ((pos&7) == 1) {
-        bufferPtr[idx] = bufferPtr[idx] | (val<<1);
-    }
-    else {
-        bufferPtr[idx] = bufferPtr[idx] | (val<<(pos&7));
-        bufferPtr[idx+1] = (val>>(8-(pos&7)));
-    }
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gather 8 bytes, one septet per byte, into a word of 8 septets.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline uint64_t GatherSeptets
+(
+    uint64_t bytes
+)
+{
+    return ( bytes       & 0x000000000000007FULL) |
+           ((bytes >> 1) & 0x0000000000003F80ULL) |
+           ((bytes >> 2) & 0x00000000001FC000ULL) |
+           ((bytes >> 3) & 0x000000000FE00000ULL) |
+           ((bytes >> 4) & 0x00000007F0000000ULL) |
+           ((bytes >> 5) & 0x000003F800000000ULL) |
+           ((bytes >> 6) & 0x0001FC0000000000ULL) |
+           ((bytes >> 7) & 0x00FE000000000000ULL);
 }
 
 static inline unsigned int ReadCdma7Bits
@@ -629,6 +838,9 @@ static inline void WriteCdma7Bits
  * Convert an ascii array into a 7bits array
  * length is the number of bytes in the ascii buffer
  *
+ * The septets are gathered in a 64-bit word, written 7 bytes at a time. Words of 8 chars without
+ * escape are converted at once.
+ *
  * @return the size of the a7bit string (in 7bit chars!), or LE_OVERFLOW if a7bitPtr is too small.
  */
 static int32_t Convert8BitsTo7Bits
@@ -641,45 +853,100 @@ static int32_t Convert8BitsTo7Bits
     uint8_t       *a7bitsNumber ///< [OUT] number of char in &7bitsPtr
 )
 {
-    int read;
+    uint64_t word = 0;
+    int bits = 0;
+    int read = pos;
     int write = 0;
     int size = 0;
+    int scalar = 0;
+    int misses = 0;
 
-    for (read = pos; read < length+pos; ++read)
+    while (read < length+pos)
     {
-        uint8_t byte = Ascii8to7[a8bitPtr[read]];
+        uint8_t byte;
 
-        /* Escape */
-        if (byte >= 128)
+        if (scalar)
+        {
+            scalar--;
+        }
+        else if ((read + SEPTETS_PER_WORD) <= (length+pos))
         {
-            if (size>a7bitSize)
+            const uint8_t* srcPtr = &a8bitPtr[read];
+            uint64_t chars =  (uint64_t)Ascii8to7[srcPtr[0]]        |
+                             ((uint64_t)Ascii8to7[srcPtr[1]] << 8)  |
+                             ((uint64_t)Ascii8to7[srcPtr[2]] << 16) |
+                             ((uint64_t)Ascii8to7[srcPtr[3]] << 24) |
+                             ((uint64_t)Ascii8to7[srcPtr[4]] << 32) |
+                             ((uint64_t)Ascii8to7[srcPtr[5]] << 40) |
+                             ((uint64_t)Ascii8to7[srcPtr[6]] << 48) |
+                             ((uint64_t)Ascii8to7[srcPtr[7]] << 56);
+
+            /* Escaped characters are marked by their most significant bit */
+            if (!(chars & 0x8080808080808080ULL))
             {
-                return LE_OVERFLOW;
+                uint64_t septets = GatherSeptets(chars);
+
+                if ((size + BYTES_PER_WORD) > a7bitSize)
+                {
+                    return LE_OVERFLOW;
+                }
+
+                Store7Bytes(&a7bitPtr[size], word | (septets << bits));
+                size += BYTES_PER_WORD;
+                word = septets >> ((BYTES_PER_WORD * 8) - bits);
+                read += SEPTETS_PER_WORD;
+                write += SEPTETS_PER_WORD;
+                misses = 0;
+                continue;
             }
 
-            Write7Bits(a7bitPtr, 0x1B, write*7);
-            write++;
-            byte -= 128;
+            /* Escapes are often close to each other: convert the next chars one by one, for longer
+             * after each miss */
+            scalar = (SEPTETS_PER_WORD << misses) - 1;
+            misses = min(misses + 1, MAX_WORD_MISSES);
         }
 
-        if (size>a7bitSize)
+        byte = Ascii8to7[a8bitPtr[read++]];
+
+        /* Escape */
+        if (byte >= 128)
         {
-            return LE_OVERFLOW;
+            word |= (uint64_t)0x1B << bits;
+            bits += 7;
+            write++;
+            byte -= 128;
         }
 
-        Write7Bits(a7bitPtr, byte, write*7);
+        word |= (uint64_t)byte << bits;
+        bits += 7;
         write++;
 
-        /* Number of 8 bit chars */
-        size = (write * 7);
-        size = (size % 8 != 0) ? (size/8 + 1) : (size/8);
+        if (bits >= (BYTES_PER_WORD * 8))
+        {
+            if ((size + BYTES_PER_WORD) > a7bitSize)
+            {
+                return LE_OVERFLOW;
+            }
+
+            Store7Bytes(&a7bitPtr[size], word);
+            size += BYTES_PER_WORD;
+            word >>= (BYTES_PER_WORD * 8);
+            bits -= (BYTES_PER_WORD * 8);
+        }
     }
 
-    if (size>a7bitSize)
+    /* Number of 8 bit chars */
+    if ((size + ((bits + 7) / 8)) > a7bitSize)
     {
         return LE_OVERFLOW;
     }
 
+    for (; bits > 0; bits -= 8)
+    {
+        a7bitPtr[size++] = word & 0xFF;
+        word >>= 8;
+    }
+
     /* Number of written chars */
     *a7bitsNumber = write;
 
@@ -690,6 +957,8 @@ static int32_t Convert8BitsTo7Bits
  * Convert a 7bit array into a ascii array
  * length is the number of 7bit char in the a7bit buffer
  *
+ * Words of 8 septets (7 bytes) without escape are converted at once, the others char by char.
+ *
  * @return the size of the ascii array, of LE_OVERFLOW if a8bitPtr is too small.
  */
 static int32_t Convert7BitsTo8Bits
@@ -703,72 +972,78 @@ static int32_t Convert7BitsTo8Bits
 {
     int r;
     int w;
+    int scalar = 0;
+    int misses = 0;
 
     w = 0;
     for (r = pos; r < length+pos; r++)
     {
-        uint8_t byte = Read7Bits(a7bitPtr, r*7);
-        byte = Ascii7to8[byte];
+        uint8_t byte;
 
-        if (byte != 27)
+        if (scalar)
+        {
+            scalar--;
+        }
+        else if (((r + SEPTETS_PER_WORD) <= (length+pos)) && ((w + SEPTETS_PER_WORD) <= a8bitSize))
         {
-            if (w < a8bitSize)
+            const uint8_t* bytePtr = &a7bitPtr[(r * 7) / 8];
+            uint32_t shift = (r * 7) & 7;
+            uint64_t word = Load7Bytes(bytePtr);
+
+            if (shift)
             {
-                a8bitPtr[w] = byte;
-                w++;
+                word = (word >> shift) | ((uint64_t)bytePtr[BYTES_PER_WORD] << (56 - shift));
             }
-            else
+
+            word = SpreadSeptets(word);
+
+            /* Look for an escape in the 8 septets at once */
+            uint64_t escapes = word ^ 0x1B1B1B1B1B1B1B1BULL;
+
+            if (!((escapes - 0x0101010101010101ULL) & ~escapes & 0x8080808080808080ULL))
             {
-                return LE_OVERFLOW;
+                uint8_t* destPtr = &a8bitPtr[w];
+
+                destPtr[0] = Ascii7to8[word & 0x7F];
+                destPtr[1] = Ascii7to8[(word >> 8) & 0x7F];
+                destPtr[2] = Ascii7to8[(word >> 16) & 0x7F];
+                destPtr[3] = Ascii7to8[(word >> 24) & 0x7F];
+                destPtr[4] = Ascii7to8[(word >> 32) & 0x7F];
+                destPtr[5] = Ascii7to8[(word >> 40) & 0x7F];
+                destPtr[6] = Ascii7to8[(word >> 48) & 0x7F];
+                destPtr[7] = Ascii7to8[(word >> 56) & 0x7F];
+
+                w += SEPTETS_PER_WORD;
+                r += SEPTETS_PER_WORD - 1;
+                misses = 0;
+                continue;
             }
+
+            /* Escapes are often close to each other: convert the next septets one by one, for
+             * longer after each miss */
+            scalar = (SEPTETS_PER_WORD << misses) - 1;
+            misses = min(misses + 1, MAX_WORD_MISSES);
         }
-        else
+
+        byte = Read7Bits(a7bitPtr, r*7);
+        byte = Ascii7to8[byte];
+
+        if (byte == 27)
         {
             /* If we're escaped then the next byte have a special meaning. */
             r++;
 
-            byte = Read7Bits(a7bitPtr, r*7);
-            if (w < a8bitSize)
-            {
-                switch (byte)
-                {
-                    case 10:
-                        a8bitPtr[w] = 12;
-                        break;
-                    case 20:
-                        a8bitPtr[w] = '^';
-                        break;
-                    case 40:
-                        a8bitPtr[w] = '{';
-                        break;
-                    case 41:
-                        a8bitPtr[w] = '}';
-                        break;
-                    case 47:
-                        a8bitPtr[w] = '\\';
-                        break;
-                    case 60:
-                        a8bitPtr[w] = '[';
-                        break;
-                    case 61:
-                        a8bitPtr[w] = '~';
-                        break;
-                    case 62:
-                        a8bitPtr[w] = ']';
-                        break;
-                    case 64:
-                        a8bitPtr[w] = '|';
-                        break;
-                    default:
-                        a8bitPtr[w] = NPC8;
-                        break;
-                }
-                w++;
-            }
-            else
-            {
-                return LE_OVERFLOW;
-            }
+            byte = Ascii7to8Ext[Read7Bits(a7bitPtr, r*7)];
+        }
+
+        if (w < a8bitSize)
+        {
+            a8bitPtr[w] = byte;
+            w++;
+        }
+        else
+        {
+            return LE_OVERFLOW;
         }
     }
 
@@ -1007,6 +1282,9 @@ static le_result_t DecodeUserDataField
     size_t           destDataSize;
     uint32_t*        destDataLenPtr;
     le_sms_Format_t* formatPtr;
+    // With a User Data Header, the position is just after its length (TP-UDHL), and the header,
+    // TP-UDHL included, is counted in TP-UDL
+    uint8_t          udhSize = tpUdhl ? (tpUdhl + 1) : 0;
 
     switch (smsPtr->type)
     {
@@ -1032,11 +1310,16 @@ static le_result_t DecodeUserDataField
     switch (encoding)
     {
         case SMSPDU_8_BITS:
-            messageLen = tpUdl - tpUdhl;
+            messageLen = tpUdl - udhSize;
+            if (messageLen < 0)
+            {
+                LE_ERROR("the message length %d is < 0 ", messageLen);
+                return LE_FAULT;
+            }
             *formatPtr = LE_SMS_FORMAT_BINARY;
             if (messageLen < destDataSize)
             {
-                memcpy(destDataPtr, &dataPtr[*posPtr], messageLen);
+                memcpy(destDataPtr, &dataPtr[*posPtr + tpUdhl], messageLen);
                 *destDataLenPtr = messageLen;
             }
             else
@@ -1048,16 +1331,19 @@ static le_result_t DecodeUserDataField
             break;
 
         case SMSPDU_7_BITS:
-            messageLen = ((tpUdl * 7) - (tpUdhl * 8)) /7;
+        {
+            // The User Data Header is padded up to a septet boundary
+            int udhSeptets = ((udhSize * 8) + 6) / 7;
+            messageLen = tpUdl - udhSeptets;
             if (messageLen <= 0)
             {
                 LE_ERROR("the message length %d is <= 0 ",messageLen);
                 return LE_FAULT;
             }
-            *posPtr -= ((tpUdhl * 8) + 6) / 7; // translate the pos in 7bits char unit
+            *posPtr -= (udhSize ? 1 : 0); // start of the User Data, TP-UDHL included
             *formatPtr = LE_SMS_FORMAT_TEXT;
             int size = Convert7BitsTo8Bits(&dataPtr[*posPtr],
-                                           0,
+                                           udhSeptets,
                                            messageLen,
                                            destDataPtr,
                                            destDataSize);
@@ -1067,15 +1353,21 @@ static le_result_t DecodeUserDataField
                 return LE_OVERFLOW;
             }
             *destDataLenPtr = size;
-            LE_INFO(" messageLen %d, pos %d, size %d ", messageLen, *posPtr, size);
+            LE_DEBUG(" messageLen %d, pos %d, size %d ", messageLen, *posPtr, size);
             break;
+        }
 
         case SMSPDU_UCS2_16_BITS:
-            messageLen = tpUdl - tpUdhl;
+            messageLen = tpUdl - udhSize;
+            if (messageLen < 0)
+            {
+                LE_ERROR("the message length %d is < 0 ", messageLen);
+                return LE_FAULT;
+            }
             *formatPtr = LE_SMS_FORMAT_UCS2;
             if (messageLen < destDataSize)
             {
-                memcpy(destDataPtr, &dataPtr[*posPtr], messageLen);
+                memcpy(destDataPtr, &dataPtr[*posPtr + tpUdhl], messageLen);
                 *destDataLenPtr = messageLen;
             }
             else
@@ -1159,6 +1451,95 @@ static le_result_t DecodeAddressField
     return LE_OK;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Look for the concatenation information element in a User Data Header (TP-UDH)
+ *
+ * @return true if the PDU is a segment of a concatenated message
+ */
+//--------------------------------------------------------------------------------------------------
+static bool GetConcatenationInfo
+(
+    const uint8_t* udhPtr,      ///< [IN] User Data Header, after its length
+    uint8_t        tpUdhl,      ///< [IN] TP User Data Header Length
+    uint16_t*      refPtr,      ///< [OUT] Reference number of the concatenated message
+    uint8_t*       maxPtr,      ///< [OUT] Number of segments of the concatenated message
+    uint8_t*       seqPtr       ///< [OUT] Sequence number of the segment
+)
+{
+    int pos = 0;
+
+    while ((pos + 2) <= tpUdhl)
+    {
+        uint8_t iei = udhPtr[pos];
+        uint8_t iedl = udhPtr[pos + 1];
+        const uint8_t* iedPtr = &udhPtr[pos + 2];
+
+        if ((pos + 2 + iedl) > tpUdhl)
+        {
+            break;
+        }
+
+        if ((UDH_IEI_CONCAT_8BIT_REF == iei) && (3 == iedl))
+        {
+            *refPtr = iedPtr[0];
+            *maxPtr = iedPtr[1];
+            *seqPtr = iedPtr[2];
+            return true;
+        }
+
+        if ((UDH_IEI_CONCAT_16BIT_REF == iei) && (4 == iedl))
+        {
+            *refPtr = (iedPtr[0] << 8) | iedPtr[1];
+            *maxPtr = iedPtr[2];
+            *seqPtr = iedPtr[3];
+            return true;
+        }
+
+        pos += 2 + iedl;
+    }
+
+    return false;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check the User Data Header of a PDU (TP-UDH)
+ *
+ * The segments of concatenated messages take a quiet path: they are expected in bulk, so only
+ * their reference and sequence numbers are logged.  Their User Data is then decoded after the
+ * header, and their PDU is still available for the application to reassemble the message.
+ *
+ * @return LE_OK            The PDU is a segment of a concatenated message
+ * @return LE_UNSUPPORTED   User Data Header is not supported
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t CheckUserDataHeader
+(
+    const uint8_t*    dataPtr,  ///< [IN] PDU data to decode
+    size_t            dataSize, ///< [IN] PDU data size
+    uint8_t           pos,      ///< [IN] Position of the User Data Header in PDU, after its length
+    uint8_t           tpUdhl    ///< [IN] TP User Data Header Length
+)
+{
+    uint16_t ref;
+    uint8_t max, seq;
+
+    if (((pos + tpUdhl) <= dataSize) &&
+        GetConcatenationInfo(&dataPtr[pos], tpUdhl, &ref, &max, &seq))
+    {
+        LE_DEBUG("Concatenated SMS ref %u, segment %u/%u", ref, seq, max);
+        return LE_OK;
+    }
+
+    // Only dump the part of the header held by the PDU
+    size_t udhSize = ((pos + tpUdhl) <= dataSize) ? tpUdhl : ((pos < dataSize) ? dataSize - pos : 0);
+
+    LE_WARN("Multi part SMS are not available yet");
+    DumpPdu("TP-UDH", &dataPtr[pos-1], udhSize+1);
+    return LE_UNSUPPORTED;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Decode a SMS-DELIVER PDU
@@ -1167,6 +1548,7 @@ static le_result_t DecodeAddressField
 static le_result_t DecodePduDeliver
 (
     const uint8_t*    dataPtr,  ///< [IN] PDU data to decode
+    size_t            dataSize, ///< [IN] PDU data size
     uint8_t           initPos,  ///< [IN] Initial position in PDU
     pa_sms_Message_t* smsPtr    ///< [OUT] Buffer to store decoded data
 )
@@ -1232,9 +1614,11 @@ static le_result_t DecodePduDeliver
 
     if (tpUdhl)
     {
-        LE_WARN("Multi part SMS are not available yet");
-        DumpPdu("TP-UDH", &dataPtr[pos-1], tpUdhl+1);
-        return LE_UNSUPPORTED;
+        result = CheckUserDataHeader(dataPtr, dataSize, pos, tpUdhl);
+        if (LE_OK != result)
+        {
+            return result;
+        }
     }
 
     result = DecodeUserDataField(dataPtr, &pos, encoding, tpUdl, tpUdhl, smsPtr);
@@ -1254,6 +1638,7 @@ static le_result_t DecodePduDeliver
 static le_result_t DecodePduSubmit
 (
     const uint8_t*    dataPtr,  ///< [IN] PDU data to decode
+    size_t            dataSize, ///< [IN] PDU data size
     uint8_t           initPos,  ///< [IN] Initial position in PDU
     pa_sms_Message_t* smsPtr    ///< [OUT] Buffer to store decoded data
 )
@@ -1317,9 +1702,11 @@ static le_result_t DecodePduSubmit
 
     if (tpUdhl)
     {
-        LE_WARN("Multi part SMS are not available yet");
-        DumpPdu("TP-UDH", &dataPtr[pos-1], tpUdhl+1);
-        return LE_UNSUPPORTED;
+        result = CheckUserDataHeader(dataPtr, dataSize, pos, tpUdhl);
+        if (LE_OK != result)
+        {
+            return result;
+        }
     }
 
     result = DecodeUserDataField(dataPtr, &pos, encoding, tpUdl, tpUdhl, smsPtr);
@@ -1529,6 +1916,12 @@ static le_result_t EncodeMessageGsm
                      +1) / 2;
         }
 
+        /* TP-PID: Protocol identifier (1 byte) */
+        WriteByte(pduPtr->data, pos++, 0x00);
+
+        /* TP-DCS: Data Coding Scheme (1 byte) */
+        WriteByte(pduPtr->data, pos++, tpDcs);
+
         if (dataPtr->messageType == PA_SMS_DELIVER)
         {
             int idx;
@@ -1540,12 +1933,6 @@ static le_result_t EncodeMessageGsm
             }
         }
 
-        /* TP-PID: Protocol identifier (1 byte) */
-        WriteByte(pduPtr->data, pos++, 0x00);
-
-        /* TP-DCS: Data Coding Scheme (1 byte) */
-        WriteByte(pduPtr->data, pos++, tpDcs);
-
         if (dataPtr->messageType == PA_SMS_SUBMIT)
         {
             /* TP-VP: Validity Period (0, 1 or 7 bytes) */
@@ -1667,13 +2054,13 @@ static le_result_t DecodeMessageGsm
         case TP_MTI_SMS_DELIVER:
             smsPtr->type = PA_SMS_DELIVER;
             smsPtr->smsDeliver.option = PA_SMS_OPTIONMASK_NO_OPTION;
-            result = DecodePduDeliver(dataPtr, pos, smsPtr);
+            result = DecodePduDeliver(dataPtr, dataSize, pos, smsPtr);
             break;
 
         case TP_MTI_SMS_SUBMIT:
             smsPtr->type = PA_SMS_SUBMIT;
             smsPtr->smsSubmit.option = PA_SMS_OPTIONMASK_NO_OPTION;
-            result = DecodePduSubmit(dataPtr, pos, smsPtr);
+            result = DecodePduSubmit(dataPtr, dataSize, pos, smsPtr);
             break;
 
         case TP_MTI_SMS_STATUS_REPORT:
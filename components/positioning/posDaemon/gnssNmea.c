@@ -0,0 +1,1150 @@
+/**
+ * @file gnssNmea.c
+ *
+ * This file contains the NMEA sentences decoder and the NMEA records ring of the GNSS service.
+ *
+ * The sentence type is identified from its address field before anything else, so the sentences
+ * which are not decoded cost a few comparisons. The checksum is computed a machine word at a time,
+ * and the fields are split with memchr() and converted to fixed-point integers in a single pass,
+ * without any floating point operation nor memory allocation.
+ *
+ * The ring is written by the GNSS service only. Each slot is protected by its own sequence, which
+ * tells the readers which record it holds and whether it is being overwritten, so the readers never
+ * block the service nor each other.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+#include "gnssNmea.h"
+
+//--------------------------------------------------------------------------------------------------
+// Symbol and Enum definitions.
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Length of the address field, including the leading '$'.
+ */
+//--------------------------------------------------------------------------------------------------
+#define ADDRESS_LEN             6
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Length of the checksum field, including the leading '*'.
+ */
+//--------------------------------------------------------------------------------------------------
+#define CHECKSUM_LEN            3
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Shortest sentence: an address field, a single empty field and the checksum field.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SENTENCE_MIN_LEN        (ADDRESS_LEN + 1 + CHECKSUM_LEN)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Longest decimal number, so that its digits cannot overflow.
+ */
+//--------------------------------------------------------------------------------------------------
+#define DECIMAL_MAX_LEN         15
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Highest value which can still be multiplied by 10.
+ */
+//--------------------------------------------------------------------------------------------------
+#define DECIMAL_MAX             (INT64_MAX / 10)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sentence formatter packed into an integer, to identify a sentence with a single comparison.
+ */
+//--------------------------------------------------------------------------------------------------
+#define FORMATTER(a, b, c)      (((uint32_t)(a) << 16) | ((uint32_t)(b) << 8) | (uint32_t)(c))
+
+static_assert(0 == (LE_GNSS_NMEA_RING_SLOTS & (LE_GNSS_NMEA_RING_SLOTS - 1)),
+              "The number of NMEA ring slots must be a power of two");
+
+//--------------------------------------------------------------------------------------------------
+// Data structures.
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fields of a sentence, split one after the other.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const char* fieldPtr;       ///< Current field.
+    size_t      length;         ///< Current field length.
+    uint32_t    index;          ///< Current field number, counted from 1.
+    const char* nextPtr;        ///< Next field, or NULL after the last field.
+    const char* endPtr;         ///< End of the last field.
+}
+Fields_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Prototype of the functions decoding a field of a sentence.
+ *
+ * @return false if the field is malformed.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef bool (*DecodeField_t)
+(
+    const Fields_t*         fieldsPtr,  ///< [IN] Fields, on a field which is not empty.
+    le_gnss_NmeaRecord_t*   recordPtr   ///< [IN/OUT] Record to fill in.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Offsets of the satellites IDs in a GSA record, for fields 3 to 14.
+ */
+//--------------------------------------------------------------------------------------------------
+static const size_t GsaSatIdOffsets[] =
+{
+    offsetof(le_gnss_NmeaGsa_t, satId1),
+    offsetof(le_gnss_NmeaGsa_t, satId2),
+    offsetof(le_gnss_NmeaGsa_t, satId3),
+    offsetof(le_gnss_NmeaGsa_t, satId4),
+    offsetof(le_gnss_NmeaGsa_t, satId5),
+    offsetof(le_gnss_NmeaGsa_t, satId6),
+    offsetof(le_gnss_NmeaGsa_t, satId7),
+    offsetof(le_gnss_NmeaGsa_t, satId8),
+    offsetof(le_gnss_NmeaGsa_t, satId9),
+    offsetof(le_gnss_NmeaGsa_t, satId10),
+    offsetof(le_gnss_NmeaGsa_t, satId11),
+    offsetof(le_gnss_NmeaGsa_t, satId12),
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Offsets of the satellites in a GSV record, for fields 4 to 19.
+ */
+//--------------------------------------------------------------------------------------------------
+static const size_t GsvSatOffsets[] =
+{
+    offsetof(le_gnss_NmeaGsv_t, sat1),
+    offsetof(le_gnss_NmeaGsv_t, sat2),
+    offsetof(le_gnss_NmeaGsv_t, sat3),
+    offsetof(le_gnss_NmeaGsv_t, sat4),
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the slots of an NMEA records ring.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline le_gnss_NmeaSlot_t* GetSlots
+(
+    const le_gnss_NmeaRing_t* ringPtr   ///< [IN] NMEA records ring.
+)
+{
+    return (le_gnss_NmeaSlot_t*)(ringPtr + 1);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute the checksum of a sentence: the exclusive OR of its characters.
+ *
+ * The characters are combined a machine word at a time, then the bytes of the word are folded.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t ComputeChecksum
+(
+    const char* ptr,            ///< [IN] Characters between '$' and '*'.
+    size_t      length          ///< [IN] Number of characters.
+)
+{
+    uint64_t word = 0;
+
+    while (length >= sizeof(word))
+    {
+        uint64_t chunk;
+
+        memcpy(&chunk, ptr, sizeof(chunk));
+        word ^= chunk;
+        ptr += sizeof(chunk);
+        length -= sizeof(chunk);
+    }
+
+    word ^= word >> 32;
+    word ^= word >> 16;
+    word ^= word >> 8;
+
+    uint8_t checksum = (uint8_t)word;
+    while (length--)
+    {
+        checksum ^= (uint8_t)*ptr++;
+    }
+
+    return checksum;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the value of an hexadecimal digit.
+ *
+ * @return The value, or -1 if the character is not an hexadecimal digit.
+ */
+//--------------------------------------------------------------------------------------------------
+static int HexValue
+(
+    char c                      ///< [IN] Character.
+)
+{
+    if ((c >= '0') && (c <= '9'))
+    {
+        return c - '0';
+    }
+    c |= 0x20;
+    if ((c >= 'a') && (c <= 'f'))
+    {
+        return c - 'a' + 10;
+    }
+    return -1;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move to the next field of a sentence.
+ *
+ * @return false after the last field.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline bool NextField
+(
+    Fields_t* fieldsPtr         ///< [IN/OUT] Fields.
+)
+{
+    const char* startPtr = fieldsPtr->nextPtr;
+
+    if (NULL == startPtr)
+    {
+        return false;
+    }
+
+    const char* commaPtr = memchr(startPtr, ',', fieldsPtr->endPtr - startPtr);
+
+    fieldsPtr->fieldPtr = startPtr;
+    fieldsPtr->index++;
+    if (NULL != commaPtr)
+    {
+        fieldsPtr->length = commaPtr - startPtr;
+        fieldsPtr->nextPtr = commaPtr + 1;
+    }
+    else
+    {
+        fieldsPtr->length = fieldsPtr->endPtr - startPtr;
+        fieldsPtr->nextPtr = NULL;
+    }
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse a decimal number into an integer, in the resolution given by its number of decimals.
+ * The extra decimals are truncated.
+ *
+ * @return false if the number is malformed or too large.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool ParseDecimal
+(
+    const char* ptr,            ///< [IN] Number.
+    size_t      length,         ///< [IN] Number length.
+    uint32_t    decimals,       ///< [IN] Number of decimals of the result.
+    int64_t*    valuePtr        ///< [OUT] Number, multiplied by 10 to the power of decimals.
+)
+{
+    const char* endPtr = ptr + length;
+    bool negative = false;
+    bool digits = false;
+    int64_t value = 0;
+
+    if (length > DECIMAL_MAX_LEN)
+    {
+        return false;
+    }
+
+    if ((ptr < endPtr) && (('-' == *ptr) || ('+' == *ptr)))
+    {
+        negative = ('-' == *ptr);
+        ptr++;
+    }
+
+    for (; (ptr < endPtr) && isdigit((unsigned char)*ptr); ptr++)
+    {
+        value = value * 10 + (*ptr - '0');
+        digits = true;
+    }
+
+    if ((ptr < endPtr) && ('.' == *ptr))
+    {
+        for (ptr++; (ptr < endPtr) && isdigit((unsigned char)*ptr); ptr++)
+        {
+            if (decimals)
+            {
+                value = value * 10 + (*ptr - '0');
+                decimals--;
+            }
+            digits = true;
+        }
+    }
+
+    if ((ptr != endPtr) || (!digits))
+    {
+        return false;
+    }
+
+    for (; decimals; decimals--)
+    {
+        if (value > DECIMAL_MAX)
+        {
+            return false;
+        }
+        value *= 10;
+    }
+
+    *valuePtr = negative ? -value : value;
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse a decimal number of the current field, checking its range.
+ *
+ * @return false if the number is malformed or out of range.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool ParseField
+(
+    const Fields_t* fieldsPtr,  ///< [IN] Fields.
+    uint32_t        decimals,   ///< [IN] Number of decimals of the result.
+    int64_t         min,        ///< [IN] Minimum value, in the resolution of the result.
+    int64_t         max,        ///< [IN] Maximum value, in the resolution of the result.
+    int64_t*        valuePtr    ///< [OUT] Number, multiplied by 10 to the power of decimals.
+)
+{
+    return ParseDecimal(fieldsPtr->fieldPtr, fieldsPtr->length, decimals, valuePtr) &&
+           (*valuePtr >= min) && (*valuePtr <= max);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse the single character of the current field.
+ *
+ * @return false if the field has more than one character.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool ParseChar
+(
+    const Fields_t* fieldsPtr,  ///< [IN] Fields.
+    uint8_t*        charPtr     ///< [OUT] Character.
+)
+{
+    if (1 != fieldsPtr->length)
+    {
+        return false;
+    }
+    *charPtr = (uint8_t)fieldsPtr->fieldPtr[0];
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse a UTC time field: hhmmss[.sss].
+ *
+ * @return false if the time is malformed.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool ParseTime
+(
+    const Fields_t* fieldsPtr,      ///< [IN] Fields.
+    uint8_t*        hoursPtr,       ///< [OUT] Hours.
+    uint8_t*        minutesPtr,     ///< [OUT] Minutes.
+    uint8_t*        secondsPtr,     ///< [OUT] Seconds.
+    uint16_t*       millisecondsPtr ///< [OUT] Milliseconds.
+)
+{
+    int64_t value;
+
+    if ((fieldsPtr->length < 6) || ((fieldsPtr->length > 6) && ('.' != fieldsPtr->fieldPtr[6])) ||
+        (!ParseField(fieldsPtr, 3, 0, INT64_C(235960999), &value)))
+    {
+        return false;
+    }
+
+    *millisecondsPtr = value % 1000;
+    value /= 1000;
+    *secondsPtr = value % 100;
+    *minutesPtr = (value / 100) % 100;
+    *hoursPtr = value / 10000;
+
+    return (*secondsPtr <= 60) && (*minutesPtr <= 59);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse a date field: ddmmyy.
+ *
+ * @return false if the date is malformed.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool ParseDate
+(
+    const Fields_t* fieldsPtr,      ///< [IN] Fields.
+    uint16_t*       yearPtr,        ///< [OUT] Year.
+    uint8_t*        monthPtr,       ///< [OUT] Month.
+    uint8_t*        dayPtr          ///< [OUT] Day.
+)
+{
+    int64_t value;
+
+    if ((6 != fieldsPtr->length) || (!ParseField(fieldsPtr, 0, 0, 999999, &value)))
+    {
+        return false;
+    }
+
+    *yearPtr = 2000 + (value % 100);
+    *monthPtr = (value / 100) % 100;
+    *dayPtr = value / 10000;
+
+    return (*monthPtr >= 1) && (*monthPtr <= 12) && (*dayPtr >= 1) && (*dayPtr <= 31);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse a latitude or longitude field: d..dmm.m..m, into degrees.
+ *
+ * @return false if the coordinate is malformed.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool ParseCoordinate
+(
+    const Fields_t* fieldsPtr,      ///< [IN] Fields.
+    int32_t         maxDegrees,     ///< [IN] Maximum number of degrees.
+    int32_t*        coordinatePtr   ///< [OUT] Coordinate in degrees [resolution 1e-6].
+)
+{
+    int64_t value;
+
+    // Degrees and minutes [resolution 1e-6]
+    if (!ParseField(fieldsPtr, 6, 0, (int64_t)maxDegrees * 100000000, &value))
+    {
+        return false;
+    }
+
+    int64_t minutes = value % 100000000;
+    if (minutes >= 60000000)
+    {
+        return false;
+    }
+
+    *coordinatePtr = (value / 100000000) * 1000000 + (minutes + 30) / 60;
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse a hemisphere field, and make the coordinate negative for the given hemisphere.
+ *
+ * @return false if the hemisphere is malformed.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool ParseHemisphere
+(
+    const Fields_t* fieldsPtr,      ///< [IN] Fields.
+    char            positive,       ///< [IN] Hemisphere of the positive coordinates.
+    char            negative,       ///< [IN] Hemisphere of the negative coordinates.
+    int32_t*        coordinatePtr   ///< [IN/OUT] Coordinate.
+)
+{
+    uint8_t hemisphere;
+
+    if (!ParseChar(fieldsPtr, &hemisphere))
+    {
+        return false;
+    }
+    if (negative == hemisphere)
+    {
+        *coordinatePtr = -*coordinatePtr;
+        return true;
+    }
+    return (positive == hemisphere);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse a speed field in knots, into meters/second.
+ *
+ * @return false if the speed is malformed.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool ParseKnots
+(
+    const Fields_t* fieldsPtr,      ///< [IN] Fields.
+    uint32_t*       speedPtr        ///< [OUT] Speed in meters/second [resolution 1e-2].
+)
+{
+    int64_t value;
+
+    if (!ParseField(fieldsPtr, 3, 0, UINT32_MAX, &value))
+    {
+        return false;
+    }
+
+    // 1 knot is 0.514444 meters/second.
+    *speedPtr = (value * 514444 + 5000000) / 10000000;
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse a speed field in kilometers/hour, into meters/second.
+ *
+ * @return false if the speed is malformed.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool ParseKmh
+(
+    const Fields_t* fieldsPtr,      ///< [IN] Fields.
+    uint32_t*       speedPtr        ///< [OUT] Speed in meters/second [resolution 1e-2].
+)
+{
+    int64_t value;
+
+    if (!ParseField(fieldsPtr, 3, 0, UINT32_MAX, &value))
+    {
+        return false;
+    }
+
+    *speedPtr = (value + 18) / 36;
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse a direction field in degrees.
+ *
+ * @return false if the direction is malformed.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool ParseDirection
+(
+    const Fields_t* fieldsPtr,      ///< [IN] Fields.
+    uint32_t*       directionPtr    ///< [OUT] Direction in degrees [resolution 1e-1].
+)
+{
+    int64_t value;
+
+    if (!ParseField(fieldsPtr, 1, 0, 3600, &value))
+    {
+        return false;
+    }
+    *directionPtr = value;
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse a Dilution of Precision field. The DOP is saturated to UINT16_MAX.
+ *
+ * @return false if the DOP is malformed.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool ParseDop
+(
+    const Fields_t* fieldsPtr,      ///< [IN] Fields.
+    uint16_t*       dopPtr          ///< [OUT] DOP [resolution 1e-2].
+)
+{
+    int64_t value;
+
+    if (!ParseField(fieldsPtr, 2, 0, INT64_MAX, &value))
+    {
+        return false;
+    }
+    *dopPtr = (value > UINT16_MAX) ? UINT16_MAX : value;
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse an altitude field in meters.
+ *
+ * @return false if the altitude is malformed.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool ParseAltitude
+(
+    const Fields_t* fieldsPtr,      ///< [IN] Fields.
+    int32_t*        altitudePtr     ///< [OUT] Altitude in meters [resolution 1e-3].
+)
+{
+    int64_t value;
+
+    if (!ParseField(fieldsPtr, 3, INT32_MIN, INT32_MAX, &value))
+    {
+        return false;
+    }
+    *altitudePtr = value;
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse an integer field.
+ *
+ * @return false if the integer is malformed or greater than the maximum.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool ParseUnsigned
+(
+    const Fields_t* fieldsPtr,      ///< [IN] Fields.
+    uint32_t        max,            ///< [IN] Maximum value.
+    uint32_t*       valuePtr        ///< [OUT] Integer.
+)
+{
+    int64_t value;
+
+    if (!ParseField(fieldsPtr, 0, 0, max, &value))
+    {
+        return false;
+    }
+    *valuePtr = value;
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode a field of a GGA sentence.
+ *
+ * @return false if the field is malformed.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool DecodeGgaField
+(
+    const Fields_t*         fieldsPtr,  ///< [IN] Fields, on a field which is not empty.
+    le_gnss_NmeaRecord_t*   recordPtr   ///< [IN/OUT] Record to fill in.
+)
+{
+    le_gnss_NmeaGga_t* ggaPtr = &recordPtr->gga;
+    uint32_t value;
+
+    switch (fieldsPtr->index)
+    {
+        case 1:
+            return ParseTime(fieldsPtr, &ggaPtr->hours, &ggaPtr->minutes, &ggaPtr->seconds,
+                             &ggaPtr->milliseconds);
+        case 2:
+            return ParseCoordinate(fieldsPtr, 90, &ggaPtr->latitude);
+        case 3:
+            return ParseHemisphere(fieldsPtr, 'N', 'S', &ggaPtr->latitude);
+        case 4:
+            return ParseCoordinate(fieldsPtr, 180, &ggaPtr->longitude);
+        case 5:
+            return ParseHemisphere(fieldsPtr, 'E', 'W', &ggaPtr->longitude);
+        case 6:
+            if (!ParseUnsigned(fieldsPtr, UINT8_MAX, &value))
+            {
+                return false;
+            }
+            ggaPtr->quality = value;
+            return true;
+        case 7:
+            if (!ParseUnsigned(fieldsPtr, UINT8_MAX, &value))
+            {
+                return false;
+            }
+            ggaPtr->satsUsedCount = value;
+            return true;
+        case 8:
+            return ParseDop(fieldsPtr, &ggaPtr->hdop);
+        case 9:
+            return ParseAltitude(fieldsPtr, &ggaPtr->altitude);
+        case 11:
+            return ParseAltitude(fieldsPtr, &ggaPtr->geoidSeparation);
+        default:
+            return true;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode a field of a RMC sentence.
+ *
+ * @return false if the field is malformed.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool DecodeRmcField
+(
+    const Fields_t*         fieldsPtr,  ///< [IN] Fields, on a field which is not empty.
+    le_gnss_NmeaRecord_t*   recordPtr   ///< [IN/OUT] Record to fill in.
+)
+{
+    le_gnss_NmeaRmc_t* rmcPtr = &recordPtr->rmc;
+    uint8_t status;
+    uint32_t direction;
+
+    switch (fieldsPtr->index)
+    {
+        case 1:
+            return ParseTime(fieldsPtr, &rmcPtr->hours, &rmcPtr->minutes, &rmcPtr->seconds,
+                             &rmcPtr->milliseconds);
+        case 2:
+            if (!ParseChar(fieldsPtr, &status))
+            {
+                return false;
+            }
+            rmcPtr->valid = ('A' == status);
+            return true;
+        case 3:
+            return ParseCoordinate(fieldsPtr, 90, &rmcPtr->latitude);
+        case 4:
+            return ParseHemisphere(fieldsPtr, 'N', 'S', &rmcPtr->latitude);
+        case 5:
+            return ParseCoordinate(fieldsPtr, 180, &rmcPtr->longitude);
+        case 6:
+            return ParseHemisphere(fieldsPtr, 'E', 'W', &rmcPtr->longitude);
+        case 7:
+            return ParseKnots(fieldsPtr, &rmcPtr->hSpeed);
+        case 8:
+            return ParseDirection(fieldsPtr, &rmcPtr->direction);
+        case 9:
+            return ParseDate(fieldsPtr, &rmcPtr->year, &rmcPtr->month, &rmcPtr->day);
+        case 10:
+            if (!ParseDirection(fieldsPtr, &direction))
+            {
+                return false;
+            }
+            rmcPtr->magneticDeviation = direction;
+            return true;
+        case 11:
+            return ParseHemisphere(fieldsPtr, 'E', 'W', &rmcPtr->magneticDeviation);
+        case 12:
+            return ParseChar(fieldsPtr, &rmcPtr->mode);
+        default:
+            return true;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode a field of a GSA sentence.
+ *
+ * @return false if the field is malformed.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool DecodeGsaField
+(
+    const Fields_t*         fieldsPtr,  ///< [IN] Fields, on a field which is not empty.
+    le_gnss_NmeaRecord_t*   recordPtr   ///< [IN/OUT] Record to fill in.
+)
+{
+    le_gnss_NmeaGsa_t* gsaPtr = &recordPtr->gsa;
+    uint32_t value;
+
+    switch (fieldsPtr->index)
+    {
+        case 1:
+            return ParseChar(fieldsPtr, &gsaPtr->selectionMode);
+        case 2:
+            if (!ParseUnsigned(fieldsPtr, UINT8_MAX, &value))
+            {
+                return false;
+            }
+            gsaPtr->fixType = value;
+            return true;
+        case 15:
+            return ParseDop(fieldsPtr, &gsaPtr->pdop);
+        case 16:
+            return ParseDop(fieldsPtr, &gsaPtr->hdop);
+        case 17:
+            return ParseDop(fieldsPtr, &gsaPtr->vdop);
+        default:
+            break;
+    }
+
+    // Satellites IDs
+    if ((fieldsPtr->index >= 3) && (fieldsPtr->index < 3 + NUM_ARRAY_MEMBERS(GsaSatIdOffsets)))
+    {
+        if (!ParseUnsigned(fieldsPtr, UINT16_MAX, &value))
+        {
+            return false;
+        }
+        *(uint16_t*)((uint8_t*)gsaPtr + GsaSatIdOffsets[fieldsPtr->index - 3]) = value;
+    }
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode a field of a GSV sentence.
+ *
+ * @return false if the field is malformed.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool DecodeGsvField
+(
+    const Fields_t*         fieldsPtr,  ///< [IN] Fields, on a field which is not empty.
+    le_gnss_NmeaRecord_t*   recordPtr   ///< [IN/OUT] Record to fill in.
+)
+{
+    le_gnss_NmeaGsv_t* gsvPtr = &recordPtr->gsv;
+    le_gnss_NmeaSatellite_t* satPtr;
+    uint32_t value;
+
+    switch (fieldsPtr->index)
+    {
+        case 1:
+            if (!ParseUnsigned(fieldsPtr, UINT8_MAX, &value))
+            {
+                return false;
+            }
+            gsvPtr->sentenceCount = value;
+            return true;
+        case 2:
+            if (!ParseUnsigned(fieldsPtr, UINT8_MAX, &value))
+            {
+                return false;
+            }
+            gsvPtr->sentenceNumber = value;
+            return true;
+        case 3:
+            if (!ParseUnsigned(fieldsPtr, UINT8_MAX, &value))
+            {
+                return false;
+            }
+            gsvPtr->satsInViewCount = value;
+            return true;
+        default:
+            break;
+    }
+
+    // Satellites, in blocks of 4 fields
+    uint32_t satField = fieldsPtr->index - 4;
+    if ((fieldsPtr->index < 4) || (satField >= 4 * NUM_ARRAY_MEMBERS(GsvSatOffsets)))
+    {
+        return true;
+    }
+
+    satPtr = (le_gnss_NmeaSatellite_t*)((uint8_t*)gsvPtr + GsvSatOffsets[satField / 4]);
+    switch (satField % 4)
+    {
+        case 0:
+            if (!ParseUnsigned(fieldsPtr, UINT16_MAX, &value))
+            {
+                return false;
+            }
+            satPtr->satId = value;
+            return true;
+        case 1:
+            if (!ParseUnsigned(fieldsPtr, 90, &value))
+            {
+                return false;
+            }
+            satPtr->satElev = value;
+            return true;
+        case 2:
+            if (!ParseUnsigned(fieldsPtr, 359, &value))
+            {
+                return false;
+            }
+            satPtr->satAzim = value;
+            return true;
+        default:
+            if (!ParseUnsigned(fieldsPtr, UINT8_MAX, &value))
+            {
+                return false;
+            }
+            satPtr->satSnr = value;
+            return true;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode a field of a VTG sentence.
+ *
+ * @return false if the field is malformed.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool DecodeVtgField
+(
+    const Fields_t*         fieldsPtr,  ///< [IN] Fields, on a field which is not empty.
+    le_gnss_NmeaRecord_t*   recordPtr   ///< [IN/OUT] Record to fill in.
+)
+{
+    le_gnss_NmeaVtg_t* vtgPtr = &recordPtr->vtg;
+
+    switch (fieldsPtr->index)
+    {
+        case 1:
+            return ParseDirection(fieldsPtr, &vtgPtr->direction);
+        case 3:
+            return ParseDirection(fieldsPtr, &vtgPtr->magneticDirection);
+        case 5:
+            // The speed in km/h, field 7, is more precise when it is set.
+            return ParseKnots(fieldsPtr, &vtgPtr->hSpeed);
+        case 7:
+            return ParseKmh(fieldsPtr, &vtgPtr->hSpeed);
+        case 9:
+            return ParseChar(fieldsPtr, &vtgPtr->mode);
+        default:
+            return true;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+// Internal interface functions
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode an NMEA sentence.
+ *
+ * The sentence starts with '$' and ends with its checksum, the line terminator being excluded.
+ *
+ * @return
+ *  - LE_OK            The sentence is decoded.
+ *  - LE_UNSUPPORTED   The sentence is not a GGA, RMC, GSA, GSV or VTG sentence.
+ *  - LE_FORMAT_ERROR  The sentence is malformed or its checksum is wrong.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gnssNmea_DecodeSentence
+(
+    const char*             sentencePtr,    ///< [IN] NMEA sentence.
+    size_t                  length,         ///< [IN] Sentence length.
+    le_gnss_NmeaRecord_t*   recordPtr       ///< [OUT] Decoded sentence.
+)
+{
+    if ((length < SENTENCE_MIN_LEN) || ('$' != sentencePtr[0]))
+    {
+        return LE_FORMAT_ERROR;
+    }
+
+    // Identify the sentence first, so the other sentences are skipped at once.
+    le_gnss_NmeaSentence_t sentence;
+    DecodeField_t decodeField;
+
+    if (',' != sentencePtr[ADDRESS_LEN])
+    {
+        return LE_UNSUPPORTED;
+    }
+    switch (FORMATTER(sentencePtr[3], sentencePtr[4], sentencePtr[5]))
+    {
+        case FORMATTER('G', 'G', 'A'):
+            sentence = LE_GNSS_NMEA_GGA;
+            decodeField = DecodeGgaField;
+            break;
+        case FORMATTER('R', 'M', 'C'):
+            sentence = LE_GNSS_NMEA_RMC;
+            decodeField = DecodeRmcField;
+            break;
+        case FORMATTER('G', 'S', 'A'):
+            sentence = LE_GNSS_NMEA_GSA;
+            decodeField = DecodeGsaField;
+            break;
+        case FORMATTER('G', 'S', 'V'):
+            sentence = LE_GNSS_NMEA_GSV;
+            decodeField = DecodeGsvField;
+            break;
+        case FORMATTER('V', 'T', 'G'):
+            sentence = LE_GNSS_NMEA_VTG;
+            decodeField = DecodeVtgField;
+            break;
+        default:
+            return LE_UNSUPPORTED;
+    }
+
+    // Check the checksum
+    const char* checksumPtr = sentencePtr + length - CHECKSUM_LEN;
+    int high = HexValue(checksumPtr[1]);
+    int low = HexValue(checksumPtr[2]);
+
+    if (('*' != checksumPtr[0]) || (high < 0) || (low < 0) ||
+        (ComputeChecksum(sentencePtr + 1, length - 1 - CHECKSUM_LEN) != ((high << 4) | low)))
+    {
+        return LE_FORMAT_ERROR;
+    }
+
+    // Decode the fields
+    memset(recordPtr, 0, sizeof(*recordPtr));
+    recordPtr->sentence = sentence;
+    recordPtr->talker[0] = sentencePtr[1];
+    recordPtr->talker[1] = sentencePtr[2];
+
+    Fields_t fields =
+    {
+        .fieldPtr = NULL,
+        .length = 0,
+        .index = 0,
+        .nextPtr = sentencePtr + ADDRESS_LEN + 1,
+        .endPtr = checksumPtr,
+    };
+
+    while (NextField(&fields))
+    {
+        if (0 == fields.length)
+        {
+            continue;
+        }
+        if (!decodeField(&fields, recordPtr))
+        {
+            return LE_FORMAT_ERROR;
+        }
+        if (fields.index < 32)
+        {
+            recordPtr->fields |= (UINT32_C(1) << fields.index);
+        }
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize an empty NMEA records ring of GNSS_NMEA_RING_SIZE bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+void gnssNmea_InitRing
+(
+    le_gnss_NmeaRing_t*     ringPtr         ///< [IN] NMEA records ring.
+)
+{
+    memset(ringPtr, 0, GNSS_NMEA_RING_SIZE);
+    ringPtr->slotCount = LE_GNSS_NMEA_RING_SLOTS;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write a record in the NMEA records ring, overwriting the oldest one.
+ */
+//--------------------------------------------------------------------------------------------------
+void gnssNmea_WriteRecord
+(
+    le_gnss_NmeaRing_t*         ringPtr,    ///< [IN] NMEA records ring.
+    const le_gnss_NmeaRecord_t* recordPtr   ///< [IN] Record to write.
+)
+{
+    // The service is the only writer.
+    uint32_t position = ringPtr->writeCount;
+    le_gnss_NmeaSlot_t* slotPtr = &GetSlots(ringPtr)[position % LE_GNSS_NMEA_RING_SLOTS];
+
+    // Make the sequence odd before the record is modified, so that a reader copying the previous
+    // record of the slot sees it was overwritten.
+    __atomic_store_n(&slotPtr->sequence, 2 * position + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    memcpy(&slotPtr->record, recordPtr, sizeof(*recordPtr));
+    __atomic_store_n(&slotPtr->sequence, 2 * position + 2, __ATOMIC_RELEASE);
+
+    __atomic_store_n(&ringPtr->writeCount, position + 1, __ATOMIC_RELEASE);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the record at a position of the NMEA records ring, and move the position to the next one.
+ *
+ * @return
+ *  - LE_OK            The record is read.
+ *  - LE_NOT_FOUND     No record was written at this position yet.
+ *  - LE_OVERFLOW      The record was overwritten: the position is moved to the oldest record
+ *                     which can still be read.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gnssNmea_ReadRecord
+(
+    const le_gnss_NmeaRing_t*   ringPtr,        ///< [IN] NMEA records ring.
+    uint32_t*                   positionPtr,    ///< [IN/OUT] Position of the record.
+    le_gnss_NmeaRecord_t*       recordPtr       ///< [OUT] Record.
+)
+{
+    uint32_t writeCount = __atomic_load_n(&ringPtr->writeCount, __ATOMIC_ACQUIRE);
+    uint32_t position = *positionPtr;
+
+    if (position == writeCount)
+    {
+        return LE_NOT_FOUND;
+    }
+
+    if ((writeCount - position) <= LE_GNSS_NMEA_RING_SLOTS)
+    {
+        const le_gnss_NmeaSlot_t* slotPtr = &GetSlots(ringPtr)[position % LE_GNSS_NMEA_RING_SLOTS];
+        uint32_t sequence = 2 * position + 2;
+
+        if (__atomic_load_n(&slotPtr->sequence, __ATOMIC_ACQUIRE) == sequence)
+        {
+            memcpy(recordPtr, &slotPtr->record, sizeof(*recordPtr));
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            if (__atomic_load_n(&slotPtr->sequence, __ATOMIC_RELAXED) == sequence)
+            {
+                *positionPtr = position + 1;
+                return LE_OK;
+            }
+        }
+
+        writeCount = __atomic_load_n(&ringPtr->writeCount, __ATOMIC_ACQUIRE);
+    }
+
+    // The oldest slot may already be overwritten by the next record.
+    *positionPtr = (writeCount < LE_GNSS_NMEA_RING_SLOTS) ? 0 :
+                   writeCount - LE_GNSS_NMEA_RING_SLOTS + 1;
+    return LE_OVERFLOW;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode the sentences of an NMEA frame into the NMEA records ring.
+ *
+ * The sentences are separated by line terminators. The sentences which cannot be decoded are
+ * skipped.
+ *
+ * @return The number of records written.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t gnssNmea_DecodeFrame
+(
+    le_gnss_NmeaRing_t*     ringPtr,        ///< [IN] NMEA records ring.
+    const char*             framePtr,       ///< [IN] NMEA frame.
+    size_t                  length          ///< [IN] Frame length.
+)
+{
+    const char* endPtr = framePtr + length;
+    le_gnss_NmeaRecord_t record;
+    uint32_t count = 0;
+
+    while (framePtr < endPtr)
+    {
+        const char* lineEndPtr = memchr(framePtr, '\n', endPtr - framePtr);
+        const char* nextPtr;
+
+        if (NULL == lineEndPtr)
+        {
+            lineEndPtr = endPtr;
+            nextPtr = endPtr;
+        }
+        else
+        {
+            nextPtr = lineEndPtr + 1;
+        }
+        if ((lineEndPtr > framePtr) && ('\r' == lineEndPtr[-1]))
+        {
+            lineEndPtr--;
+        }
+
+        if (LE_OK == gnssNmea_DecodeSentence(framePtr, lineEndPtr - framePtr, &record))
+        {
+            gnssNmea_WriteRecord(ringPtr, &record);
+            count++;
+        }
+
+        framePtr = nextPtr;
+    }
+
+    return count;
+}
@@ -0,0 +1,101 @@
+/**
+ * @file gnssNmea.h
+ *
+ * NMEA sentences decoder and NMEA records ring of the GNSS service.
+ *
+ * The decoder works in place on the NMEA text and does not allocate any memory. The ring has a
+ * single writer, the GNSS service, and any number of readers which do not take any lock.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#ifndef LEGATO_GNSS_NMEA_INCLUDE_GUARD
+#define LEGATO_GNSS_NMEA_INCLUDE_GUARD
+
+#include "legato.h"
+#include "interfaces.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the NMEA records ring, header included.
+ */
+//--------------------------------------------------------------------------------------------------
+#define GNSS_NMEA_RING_SIZE     (sizeof(le_gnss_NmeaRing_t) +                                   \
+                                 LE_GNSS_NMEA_RING_SLOTS * sizeof(le_gnss_NmeaSlot_t))
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode an NMEA sentence.
+ *
+ * The sentence starts with '$' and ends with its checksum, the line terminator being excluded.
+ *
+ * @return
+ *  - LE_OK            The sentence is decoded.
+ *  - LE_UNSUPPORTED   The sentence is not a GGA, RMC, GSA, GSV or VTG sentence.
+ *  - LE_FORMAT_ERROR  The sentence is malformed or its checksum is wrong.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gnssNmea_DecodeSentence
+(
+    const char*             sentencePtr,    ///< [IN] NMEA sentence.
+    size_t                  length,         ///< [IN] Sentence length.
+    le_gnss_NmeaRecord_t*   recordPtr       ///< [OUT] Decoded sentence.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize an empty NMEA records ring of GNSS_NMEA_RING_SIZE bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+void gnssNmea_InitRing
+(
+    le_gnss_NmeaRing_t*     ringPtr         ///< [IN] NMEA records ring.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write a record in the NMEA records ring, overwriting the oldest one.
+ */
+//--------------------------------------------------------------------------------------------------
+void gnssNmea_WriteRecord
+(
+    le_gnss_NmeaRing_t*         ringPtr,    ///< [IN] NMEA records ring.
+    const le_gnss_NmeaRecord_t* recordPtr   ///< [IN] Record to write.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the record at a position of the NMEA records ring, and move the position to the next one.
+ *
+ * @return
+ *  - LE_OK            The record is read.
+ *  - LE_NOT_FOUND     No record was written at this position yet.
+ *  - LE_OVERFLOW      The record was overwritten: the position is moved to the oldest record
+ *                     which can still be read.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gnssNmea_ReadRecord
+(
+    const le_gnss_NmeaRing_t*   ringPtr,        ///< [IN] NMEA records ring.
+    uint32_t*                   positionPtr,    ///< [IN/OUT] Position of the record.
+    le_gnss_NmeaRecord_t*       recordPtr       ///< [OUT] Record.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode the sentences of an NMEA frame into the NMEA records ring.
+ *
+ * The sentences are separated by line terminators. The sentences which cannot be decoded are
+ * skipped.
+ *
+ * @return The number of records written.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t gnssNmea_DecodeFrame
+(
+    le_gnss_NmeaRing_t*     ringPtr,        ///< [IN] NMEA records ring.
+    const char*             framePtr,       ///< [IN] NMEA frame.
+    size_t                  length          ///< [IN] Frame length.
+);
+
+#endif // LEGATO_GNSS_NMEA_INCLUDE_GUARD
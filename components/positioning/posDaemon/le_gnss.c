@@ -13,6 +13,7 @@
 #include "interfaces.h"
 #include "pa_gnss.h"
 #include "le_gnss_local.h"
+#include "gnssNmea.h"
 
 
 //--------------------------------------------------------------------------------------------------
@@ -24,11 +25,42 @@
 /// Maximum expected position handlers
 #define GNSS_POSITION_HANDLER_HIGH       1
 
+/// Maximum expected position report handlers
+#define GNSS_POSITION_REPORT_HANDLER_HIGH    1
+
 /// Some platforms don't define O_CLOEXEC.  If not defined, define it as 0 (no effect)
 #ifndef O_CLOEXEC
 #define O_CLOEXEC 0
 #endif
 
+#ifdef LE_CONFIG_LINUX
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+/// Older C libraries don't define the memfd_create() flags and the file seals.
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC 0x0001U
+#endif
+#ifndef MFD_ALLOW_SEALING
+#define MFD_ALLOW_SEALING 0x0002U
+#endif
+#ifndef F_ADD_SEALS
+#define F_ADD_SEALS (1024 + 9)
+#endif
+#ifndef F_SEAL_SEAL
+#define F_SEAL_SEAL 0x0001
+#endif
+#ifndef F_SEAL_SHRINK
+#define F_SEAL_SHRINK 0x0002
+#endif
+#ifndef F_SEAL_GROW
+#define F_SEAL_GROW 0x0004
+#endif
+#ifndef F_SEAL_FUTURE_WRITE
+#define F_SEAL_FUTURE_WRITE 0x0010
+#endif
+#endif
+
 //--------------------------------------------------------------------------------------------------
 /**
  * NMEA node path definition
@@ -203,6 +235,21 @@ typedef struct le_gnss_PositionHandler
 }
 le_gnss_PositionHandler_t;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Position report's Handler structure.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_gnss_PositionReportHandlerFunc_t handlerFuncPtr;     ///< The handler function address.
+    void*                               handlerContextPtr;  ///< The handler function context.
+    le_msg_SessionRef_t                 sessionRef;         ///< Store message session reference.
+    le_dls_Link_t                       link;               ///< Object node link
+}
+le_gnss_PositionReportHandler_t;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Position sample request objet structure.
@@ -284,6 +331,15 @@ static le_event_HandlerRef_t PaHandlerRef = NULL;
 //--------------------------------------------------------------------------------------------------
 static le_event_HandlerRef_t PaNmeaHandlerRef = NULL;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * true if the NMEA frames of the PA are written to the NMEA FIFO by Legato.  When the NMEA node is
+ * a character device managed by the firmware, the PA NMEA handler is only subscribed to feed the
+ * NMEA records ring.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsNmeaPipeManaged = false;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Number of position Handler functions that own position samples.
@@ -300,6 +356,65 @@ static int32_t NumOfPositionHandlers = 0;
 //--------------------------------------------------------------------------------------------------
 static le_dls_List_t PositionHandlerList = LE_DLS_LIST_INIT;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Static memory pool for position report handlers
+ */
+//--------------------------------------------------------------------------------------------------
+LE_MEM_DEFINE_STATIC_POOL(PositionReportHandler,
+                          GNSS_POSITION_REPORT_HANDLER_HIGH,
+                          sizeof(le_gnss_PositionReportHandler_t));
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Memory Pool for position report handlers.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t   PositionReportHandlerPoolRef;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create and initialize the position report handlers list.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static le_dls_List_t PositionReportHandlerList = LE_DLS_LIST_INIT;
+
+#ifdef LE_CONFIG_LINUX
+//--------------------------------------------------------------------------------------------------
+/**
+ * Latest fix shared with the clients, or NULL until a client opens it.
+ *
+ * It is kept until the service exits, as clients may still have it mapped.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_gnss_LatestFix_t* LatestFixPtr = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * File descriptor of the latest fix shared memory.
+ */
+//--------------------------------------------------------------------------------------------------
+static int LatestFixFd = -1;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * NMEA records ring shared with the clients, or NULL until a client opens it.
+ *
+ * It is kept until the service exits, as clients may still have it mapped.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_gnss_NmeaRing_t* NmeaRingPtr = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * File descriptor of the NMEA records ring shared memory.
+ */
+//--------------------------------------------------------------------------------------------------
+static int NmeaRingFd = -1;
+#endif
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Memory Pool for position samples.
@@ -752,6 +867,19 @@ static void PaNmeaHandler
 {
     LE_DEBUG("NMEA Handler %s", nmeaPtr);
 
+#ifdef LE_CONFIG_LINUX
+    if (NULL != NmeaRingPtr)
+    {
+        gnssNmea_DecodeFrame(NmeaRingPtr, nmeaPtr, strlen(nmeaPtr));
+    }
+#endif
+
+    if (!IsNmeaPipeManaged)
+    {
+        le_mem_Release(nmeaPtr);
+        return;
+    }
+
     // Open the NMEA FIFO pipe
     le_result_t resultNmeaPipe = OpenNmeaPipe();
     if ((resultNmeaPipe != LE_OK) && (resultNmeaPipe != LE_DUPLICATE))
@@ -1130,6 +1258,320 @@ static le_result_t ConvertPositionData
     return LE_OK;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert a value given with 3 decimal places to the selected resolution.
+ *
+ * An unknown resolution is treated as a resolution of 3 decimal places (default).
+ */
+//--------------------------------------------------------------------------------------------------
+static int32_t ConvertToResolution
+(
+    int32_t value,                      ///< [IN] Value with 3 decimal places.
+    le_gnss_Resolution_t resolution     ///< [IN] Resolution to convert to.
+)
+{
+    switch(resolution)
+    {
+        case LE_GNSS_RES_ZERO_DECIMAL:
+             return value / 1000;
+        case LE_GNSS_RES_ONE_DECIMAL:
+             return value / 100;
+        case LE_GNSS_RES_TWO_DECIMAL:
+             return value / 10;
+        case LE_GNSS_RES_THREE_DECIMAL:
+        default:
+             return value;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert a DOP value to the selected resolution for a position report.
+ *
+ * @return true if the DOP is valid and fits a uint16_t once converted.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool ConvertReportDop
+(
+    bool dopValid,                      ///< [IN] Whether the sample's DOP is set.
+    uint32_t dop,                       ///< [IN] Sample's DOP with 3 decimal places.
+    le_gnss_Resolution_t resolution,    ///< [IN] Client DOP resolution.
+    uint16_t* dopPtr                    ///< [OUT] Converted DOP, UINT16_MAX if invalid.
+)
+{
+    if (dopValid)
+    {
+        uint32_t value = (uint32_t)ConvertToResolution((int32_t)dop, resolution);
+        if (!(value >> 16))
+        {
+            *dopPtr = (uint16_t)value;
+            return true;
+        }
+    }
+
+    *dopPtr = UINT16_MAX;
+    return false;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fill a position report with a position sample's data, in a client's resolutions.
+ *
+ * The report holds the same values as the le_gnss_Get... functions called by that client.
+ */
+//--------------------------------------------------------------------------------------------------
+static void GetPositionReportData
+(
+    const le_gnss_PositionSample_t* samplePtr,  ///< [IN] Position sample.
+    const le_gnss_Client_t* clientPtr,          ///< [IN] Client, NULL for default resolutions.
+    le_gnss_PositionReport_t* reportPtr         ///< [OUT] Position report.
+)
+{
+    le_gnss_Client_t defaultClient;
+    uint32_t validity = 0;
+
+    if (NULL == clientPtr)
+    {
+        InitClientRequest(&defaultClient);
+        clientPtr = &defaultClient;
+    }
+
+    memset(reportPtr, 0, sizeof(*reportPtr));
+    reportPtr->fixState = samplePtr->fixState;
+
+    if (samplePtr->latitudeValid && samplePtr->longitudeValid)
+    {
+        validity |= LE_GNSS_REPORT_LOCATION;
+        reportPtr->latitude = samplePtr->latitude;
+        reportPtr->longitude = samplePtr->longitude;
+    }
+    else
+    {
+        reportPtr->latitude = INT32_MAX;
+        reportPtr->longitude = INT32_MAX;
+    }
+    reportPtr->hAccuracy = INT32_MAX;
+    if (samplePtr->hAccuracyValid)
+    {
+        validity |= LE_GNSS_REPORT_H_ACCURACY;
+        reportPtr->hAccuracy = samplePtr->hAccuracy;
+    }
+    reportPtr->altitude = INT32_MAX;
+    if (samplePtr->altitudeValid)
+    {
+        validity |= LE_GNSS_REPORT_ALTITUDE;
+        reportPtr->altitude = samplePtr->altitude;
+    }
+    reportPtr->altitudeOnWgs84 = INT32_MAX;
+    if (samplePtr->altitudeOnWgs84Valid)
+    {
+        validity |= LE_GNSS_REPORT_ALTITUDE_WGS84;
+        reportPtr->altitudeOnWgs84 = samplePtr->altitudeOnWgs84;
+    }
+    reportPtr->vAccuracy = INT32_MAX;
+    if (samplePtr->vAccuracyValid)
+    {
+        validity |= LE_GNSS_REPORT_V_ACCURACY;
+        reportPtr->vAccuracy = ConvertToResolution(samplePtr->vAccuracy,
+                                                   clientPtr->vAccuracyResolution);
+    }
+
+    reportPtr->hSpeed = UINT32_MAX;
+    if (samplePtr->hSpeedValid)
+    {
+        validity |= LE_GNSS_REPORT_H_SPEED;
+        reportPtr->hSpeed = samplePtr->hSpeed;
+    }
+    reportPtr->hSpeedAccuracy = UINT32_MAX;
+    if (samplePtr->hSpeedAccuracyValid)
+    {
+        validity |= LE_GNSS_REPORT_H_SPEED_ACCURACY;
+        reportPtr->hSpeedAccuracy = (uint32_t)ConvertToResolution(samplePtr->hSpeedAccuracy,
+                                                          clientPtr->hSpeedAccuracyResolution);
+    }
+    reportPtr->vSpeed = INT32_MAX;
+    if (samplePtr->vSpeedValid)
+    {
+        validity |= LE_GNSS_REPORT_V_SPEED;
+        reportPtr->vSpeed = samplePtr->vSpeed;
+    }
+    reportPtr->vSpeedAccuracy = INT32_MAX;
+    if (samplePtr->vSpeedAccuracyValid)
+    {
+        validity |= LE_GNSS_REPORT_V_SPEED_ACCURACY;
+        reportPtr->vSpeedAccuracy = ConvertToResolution(samplePtr->vSpeedAccuracy,
+                                                        clientPtr->vSpeedAccuracyResolution);
+    }
+    reportPtr->direction = UINT32_MAX;
+    if (samplePtr->directionValid)
+    {
+        validity |= LE_GNSS_REPORT_DIRECTION;
+        reportPtr->direction = samplePtr->direction;
+    }
+    reportPtr->directionAccuracy = UINT32_MAX;
+    if (samplePtr->directionAccuracyValid)
+    {
+        validity |= LE_GNSS_REPORT_DIRECTION_ACCURACY;
+        reportPtr->directionAccuracy = samplePtr->directionAccuracy;
+    }
+    reportPtr->magneticDeviation = INT32_MAX;
+    if (samplePtr->magneticDeviationValid)
+    {
+        validity |= LE_GNSS_REPORT_MAGNETIC_DEVIATION;
+        reportPtr->magneticDeviation = samplePtr->magneticDeviation;
+    }
+
+    // Date and time are left to 0 when they are not set.
+    if (samplePtr->dateValid)
+    {
+        validity |= LE_GNSS_REPORT_DATE;
+        reportPtr->year = samplePtr->year;
+        reportPtr->month = samplePtr->month;
+        reportPtr->day = samplePtr->day;
+    }
+    if (samplePtr->timeValid)
+    {
+        validity |= LE_GNSS_REPORT_TIME;
+        reportPtr->hours = samplePtr->hours;
+        reportPtr->minutes = samplePtr->minutes;
+        reportPtr->seconds = samplePtr->seconds;
+        reportPtr->milliseconds = samplePtr->milliseconds;
+        reportPtr->epochTime = samplePtr->epochTime;
+    }
+    if (samplePtr->gpsTimeValid)
+    {
+        validity |= LE_GNSS_REPORT_GPS_TIME;
+        reportPtr->gpsWeek = samplePtr->gpsWeek;
+        reportPtr->gpsTimeOfWeek = samplePtr->gpsTimeOfWeek;
+    }
+    reportPtr->timeAccuracy = UINT32_MAX;
+    if (samplePtr->timeAccuracyValid)
+    {
+        validity |= LE_GNSS_REPORT_TIME_ACCURACY;
+        reportPtr->timeAccuracy = samplePtr->timeAccuracy;
+    }
+    reportPtr->leapSeconds = UINT8_MAX;
+    if (samplePtr->leapSecondsValid)
+    {
+        validity |= LE_GNSS_REPORT_LEAP_SECONDS;
+        reportPtr->leapSeconds = samplePtr->leapSeconds;
+    }
+    reportPtr->positionLatency = UINT32_MAX;
+    if (samplePtr->positionLatencyValid)
+    {
+        validity |= LE_GNSS_REPORT_POSITION_LATENCY;
+        reportPtr->positionLatency = samplePtr->positionLatency;
+    }
+
+    if (ConvertReportDop(samplePtr->hdopValid, samplePtr->hdop, clientPtr->dopResolution,
+                         &reportPtr->hdop))
+    {
+        validity |= LE_GNSS_REPORT_HDOP;
+    }
+    if (ConvertReportDop(samplePtr->vdopValid, samplePtr->vdop, clientPtr->dopResolution,
+                         &reportPtr->vdop))
+    {
+        validity |= LE_GNSS_REPORT_VDOP;
+    }
+    if (ConvertReportDop(samplePtr->pdopValid, samplePtr->pdop, clientPtr->dopResolution,
+                         &reportPtr->pdop))
+    {
+        validity |= LE_GNSS_REPORT_PDOP;
+    }
+    if (ConvertReportDop(samplePtr->gdopValid, samplePtr->gdop, clientPtr->dopResolution,
+                         &reportPtr->gdop))
+    {
+        validity |= LE_GNSS_REPORT_GDOP;
+    }
+    if (ConvertReportDop(samplePtr->tdopValid, samplePtr->tdop, clientPtr->dopResolution,
+                         &reportPtr->tdop))
+    {
+        validity |= LE_GNSS_REPORT_TDOP;
+    }
+
+    reportPtr->satsInViewCount = UINT8_MAX;
+    if (samplePtr->satsInViewCountValid)
+    {
+        validity |= LE_GNSS_REPORT_SATS_IN_VIEW;
+        reportPtr->satsInViewCount = samplePtr->satsInViewCount;
+    }
+    reportPtr->satsTrackingCount = UINT8_MAX;
+    if (samplePtr->satsTrackingCountValid)
+    {
+        validity |= LE_GNSS_REPORT_SATS_TRACKING;
+        reportPtr->satsTrackingCount = samplePtr->satsTrackingCount;
+    }
+    reportPtr->satsUsedCount = UINT8_MAX;
+    if (samplePtr->satsUsedCountValid)
+    {
+        validity |= LE_GNSS_REPORT_SATS_USED;
+        reportPtr->satsUsedCount = samplePtr->satsUsedCount;
+    }
+    if (samplePtr->satInfoValid)
+    {
+        validity |= LE_GNSS_REPORT_SAT_INFO;
+    }
+
+    reportPtr->validity = (le_gnss_ReportValidity_t)validity;
+}
+
+#ifdef LE_CONFIG_LINUX
+//--------------------------------------------------------------------------------------------------
+/**
+ * Publish the last position sample in the latest fix shared with the clients.
+ *
+ * The sequence is odd while the report is written, so that readers copying the report at the same
+ * time retry.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PublishLatestFix
+(
+    void
+)
+{
+    le_gnss_PositionReport_t report;
+    uint32_t sequence = LatestFixPtr->sequence;
+
+    // Build the report first to keep the update window short.
+    GetPositionReportData(&LastPositionSample, NULL, &report);
+
+    __atomic_store_n(&LatestFixPtr->sequence, sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    memcpy(&LatestFixPtr->report, &report, sizeof(report));
+    __atomic_store_n(&LatestFixPtr->sequence, sequence + 2, __ATOMIC_RELEASE);
+}
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Call the position report handlers with the last position sample, each in the resolutions of its
+ * client session.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReportPositionToHandlers
+(
+    void
+)
+{
+    le_gnss_PositionReport_t report;
+    le_dls_Link_t* linkPtr = le_dls_Peek(&PositionReportHandlerList);
+
+    while (NULL != linkPtr)
+    {
+        le_gnss_PositionReportHandler_t* handlerNodePtr =
+                        CONTAINER_OF(linkPtr, le_gnss_PositionReportHandler_t, link);
+
+        // The handler may remove itself: move to the next node first.
+        linkPtr = le_dls_PeekNext(&PositionReportHandlerList, linkPtr);
+
+        GetPositionReportData(&LastPositionSample,
+                              FindClientSessionReference(handlerNodePtr->sessionRef),
+                              &report);
+        handlerNodePtr->handlerFuncPtr(&report, handlerNodePtr->handlerContextPtr);
+    }
+}
+
 //--------------------------------------------------------------------------------------------------
 // APIs.
 //--------------------------------------------------------------------------------------------------
@@ -1162,6 +1604,15 @@ static void PaPositionHandler
     // Get the position sample data from the PA position data report
     GetPosSampleData(&LastPositionSample, positionPtr);
 
+#ifdef LE_CONFIG_LINUX
+    if (NULL != LatestFixPtr)
+    {
+        PublishLatestFix();
+    }
+#endif
+
+    ReportPositionToHandlers();
+
     if(!NumOfPositionHandlers)
     {
         LE_DEBUG("No positioning handlers, exit Handler Function");
@@ -1299,6 +1750,21 @@ static void CloseSessionEventHandler
         result = le_ref_NextNode(iterRef);
     }
 
+    // Remove the position report handlers of the closed client session.
+    le_dls_Link_t* linkPtr = le_dls_Peek(&PositionReportHandlerList);
+    while (NULL != linkPtr)
+    {
+        le_gnss_PositionReportHandler_t* handlerNodePtr =
+                        CONTAINER_OF(linkPtr, le_gnss_PositionReportHandler_t, link);
+
+        linkPtr = le_dls_PeekNext(&PositionReportHandlerList, linkPtr);
+        if (handlerNodePtr->sessionRef == sessionRef)
+        {
+            le_gnss_RemovePositionReportHandler(
+                                    (le_gnss_PositionReportHandlerRef_t)handlerNodePtr);
+        }
+    }
+
     iterRef = le_ref_GetIterator(ClientRequestRefMap);
     result = le_ref_NextNode(iterRef);
     while (LE_OK == result)
@@ -1425,6 +1891,11 @@ le_result_t gnss_Init
                                                    sizeof(le_gnss_PositionHandler_t));
     le_mem_SetDestructor(PositionHandlerPoolRef, PositionHandlerDestructor);
 
+    // Create a pool for Position report Handler objects
+    PositionReportHandlerPoolRef = le_mem_InitStaticPool(PositionReportHandler,
+                                                       GNSS_POSITION_REPORT_HANDLER_HIGH,
+                                                       sizeof(le_gnss_PositionReportHandler_t));
+
     // Create a pool for Position Sample objects
     PositionSamplePoolRef = le_mem_InitStaticPool(PositionSample,
                                                   GNSS_POSITION_SAMPLE_MAX,
@@ -1473,6 +1944,7 @@ le_result_t gnss_Init
     // That node is a FIFO (named pipe): it will be managed from Legato (User space).
     if ((resultStat == 0) && (S_ISFIFO(nmeaFileStat.st_mode))) // FIFO (named pipe)
     {
+         IsNmeaPipeManaged = true;
          if ((PaNmeaHandlerRef=pa_gnss_AddNmeaHandler(PaNmeaHandler)) == NULL)
          {
              LE_ERROR("Failed to add PA NMEA handler!");
@@ -1488,6 +1960,7 @@ le_result_t gnss_Init
     else if(resultStat == -1) // No such file or directory
 #endif
     {
+        IsNmeaPipeManaged = true;
         if ((PaNmeaHandlerRef=pa_gnss_AddNmeaHandler(PaNmeaHandler)) != NULL)
         {
             // Create NMEA device folder
@@ -1507,6 +1980,55 @@ le_result_t gnss_Init
     return result;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Subscribe to the PA position data, if not already done.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SubscribePaPositionHandler
+(
+    void
+)
+{
+    if (NULL == PaHandlerRef)
+    {
+        if ((PaHandlerRef=pa_gnss_AddPositionDataHandler(PaPositionHandler)) == NULL)
+        {
+            LE_ERROR("Failed to add PA position Data handler!");
+        }
+        else
+        {
+            LE_DEBUG("PaHandlerRef %p subscribed", PaHandlerRef);
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unsubscribe from the PA position data once there are no position handlers, position report
+ * handlers or shared latest fix left.
+ */
+//--------------------------------------------------------------------------------------------------
+static void UnsubscribePaPositionHandler
+(
+    void
+)
+{
+    if ((0 != NumOfPositionHandlers) || (!le_dls_IsEmpty(&PositionReportHandlerList)))
+    {
+        return;
+    }
+#ifdef LE_CONFIG_LINUX
+    if (NULL != LatestFixPtr)
+    {
+        return;
+    }
+#endif
+
+    pa_gnss_RemovePositionDataHandler(PaHandlerRef);
+    PaHandlerRef = NULL;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function must be called to register an handler for position notifications.
@@ -1536,17 +2058,7 @@ le_gnss_PositionHandlerRef_t le_gnss_AddPositionHandler
     LE_DEBUG("handler %p", handlerPtr);
 
     // Subscribe to PA position Data handler
-    if (NULL == PaHandlerRef)
-    {
-        if ((PaHandlerRef=pa_gnss_AddPositionDataHandler(PaPositionHandler)) == NULL)
-        {
-            LE_ERROR("Failed to add PA position Data handler!");
-        }
-        else
-        {
-            LE_DEBUG("PaHandlerRef %p subscribed", PaHandlerRef);
-        }
-    }
+    SubscribePaPositionHandler();
 
     // Update the position handler list with that new handler
     le_dls_Queue(&PositionHandlerList, &(positionHandlerPtr->link));
@@ -1598,11 +2110,72 @@ void le_gnss_RemovePositionHandler
         } while (linkPtr != NULL);
     }
 
-    if(NumOfPositionHandlers == 0)
+    UnsubscribePaPositionHandler();
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to register an handler for position reports.
+ *
+ *  - A handler reference, which is only needed for later removal of the handler.
+ *
+ * @note Doesn't return on failure, so there's no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+le_gnss_PositionReportHandlerRef_t le_gnss_AddPositionReportHandler
+(
+    le_gnss_PositionReportHandlerFunc_t handlerPtr,     ///< [IN] The handler function.
+    void*                               contextPtr      ///< [IN] The context pointer
+)
+{
+    le_gnss_PositionReportHandler_t* reportHandlerPtr;
+
+    LE_FATAL_IF((NULL == handlerPtr), "handlerPtr pointer is NULL !");
+
+    reportHandlerPtr = le_mem_ForceAlloc(PositionReportHandlerPoolRef);
+    reportHandlerPtr->link = LE_DLS_LINK_INIT;
+    reportHandlerPtr->handlerFuncPtr = handlerPtr;
+    reportHandlerPtr->handlerContextPtr = contextPtr;
+    reportHandlerPtr->sessionRef = le_gnss_GetClientSessionRef();
+
+    SubscribePaPositionHandler();
+
+    le_dls_Queue(&PositionReportHandlerList, &(reportHandlerPtr->link));
+
+    LE_DEBUG("Position report handler %p added", handlerPtr);
+
+    return (le_gnss_PositionReportHandlerRef_t)reportHandlerPtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to remove a handler for position reports.
+ *
+ * @note Doesn't return on failure, so there's no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_gnss_RemovePositionReportHandler
+(
+    le_gnss_PositionReportHandlerRef_t handlerRef   ///< [IN] The handler reference.
+)
+{
+    le_dls_Link_t* linkPtr = le_dls_Peek(&PositionReportHandlerList);
+
+    while (NULL != linkPtr)
     {
-        pa_gnss_RemovePositionDataHandler(PaHandlerRef);
-        PaHandlerRef = NULL;
+        le_gnss_PositionReportHandler_t* reportHandlerPtr =
+                        CONTAINER_OF(linkPtr, le_gnss_PositionReportHandler_t, link);
+
+        if ((le_gnss_PositionReportHandlerRef_t)reportHandlerPtr == handlerRef)
+        {
+            le_dls_Remove(&PositionReportHandlerList, linkPtr);
+            le_mem_Release(reportHandlerPtr);
+            break;
+        }
+        linkPtr = le_dls_PeekNext(&PositionReportHandlerList, linkPtr);
     }
+
+    UnsubscribePaPositionHandler();
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -3263,6 +3836,355 @@ void le_gnss_ReleaseSampleRef
     le_mem_Release(positionSampleRequestNodePtr);
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get all the data of a position sample in one call.
+ *
+ * @return
+ *  - LE_FAULT         Function failed to find the positionSample.
+ *  - LE_OK            Function succeeded.
+ *
+ * @note The satellites list holds the entries up to the last configured satellite.
+ *
+ * @note If the caller is passing an invalid Position sample reference or null pointers into this
+ *       function, it is a fatal error, the function will not return.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_gnss_GetPositionReport
+(
+    le_gnss_SampleRef_t positionSampleRef,
+        ///< [IN] Position sample's reference.
+    le_gnss_PositionReport_t* reportPtr,
+        ///< [OUT] Position report.
+    le_gnss_SatelliteReport_t* satellitesPtr,
+        ///< [OUT] Satellites list.
+    size_t* satellitesNumElementsPtr
+        ///< [INOUT] Size of the satellites list.
+)
+{
+    le_gnss_PositionSampleRequest_t* positionSampleRequestNodePtr
+                                            = le_ref_Lookup(PositionSampleMap,positionSampleRef);
+
+    // Check input pointers
+    if ((NULL == reportPtr) || (NULL == satellitesPtr) || (NULL == satellitesNumElementsPtr))
+    {
+        LE_KILL_CLIENT("Invalid pointers provided!");
+        return LE_FAULT;
+    }
+
+    // Check position sample's reference
+    le_result_t result = ValidatePositionSamplePtr(positionSampleRequestNodePtr);
+    if (LE_OK != result)
+    {
+        return result;
+    }
+
+    const le_gnss_PositionSample_t* samplePtr = positionSampleRequestNodePtr->positionSampleNodePtr;
+
+    GetPositionReportData(samplePtr,
+                          FindClientSessionReference(le_gnss_GetClientSessionRef()),
+                          reportPtr);
+
+    // Only send the satellites up to the last configured one.
+    size_t satCount = 0;
+    if (samplePtr->satInfoValid)
+    {
+        size_t i;
+        size_t maxCount = (*satellitesNumElementsPtr < LE_GNSS_SV_INFO_MAX_LEN) ?
+                          *satellitesNumElementsPtr : LE_GNSS_SV_INFO_MAX_LEN;
+
+        for (i = 0; i < maxCount; i++)
+        {
+            if (0 != samplePtr->satInfo[i].satId)
+            {
+                satCount = i + 1;
+            }
+        }
+        for (i = 0; i < satCount; i++)
+        {
+            satellitesPtr[i].satId = samplePtr->satInfo[i].satId;
+            satellitesPtr[i].satConst = samplePtr->satInfo[i].satConst;
+            satellitesPtr[i].satUsed = samplePtr->satsUsedCountValid ?
+                                       samplePtr->satInfo[i].satUsed : false;
+            satellitesPtr[i].satSnr = samplePtr->satInfo[i].satSnr;
+            satellitesPtr[i].satAzim = samplePtr->satInfo[i].satAzim;
+            satellitesPtr[i].satElev = samplePtr->satInfo[i].satElev;
+        }
+    }
+    *satellitesNumElementsPtr = satCount;
+
+    return LE_OK;
+}
+
+#ifdef LE_CONFIG_LINUX
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a shared memory for the clients to read.
+ *
+ * The memory is only readable through the file system, so a client cannot reopen it for writing
+ * through /proc/self/fd.
+ *
+ * @return The file descriptor of the memory, or -1 on failure (errno is set).
+ */
+//--------------------------------------------------------------------------------------------------
+static int CreateSharedMemory
+(
+    const char* namePtr,    ///< [IN] Name of the memory.
+    size_t      size        ///< [IN] Size of the memory.
+)
+{
+#ifdef SYS_memfd_create
+    int fd = syscall(SYS_memfd_create, namePtr, MFD_CLOEXEC | MFD_ALLOW_SEALING);
+#else
+    int fd = -1;
+    errno = ENOSYS;
+#endif
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    if ((0 != fchmod(fd, S_IRUSR | S_IRGRP | S_IROTH)) || (0 != ftruncate(fd, size)))
+    {
+        int savedErrno = errno;
+        close(fd);
+        errno = savedErrno;
+        return -1;
+    }
+
+    return fd;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Seal a shared memory once the service has mapped it for writing.
+ *
+ * The permissions do not stop a privileged client: the seals forbid any new writable mapping,
+ * write or size change of the memory, while the mapping of the service stays writable.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SealSharedMemory
+(
+    int fd                  ///< [IN] File descriptor of the memory.
+)
+{
+    if (0 != fcntl(fd, F_ADD_SEALS, F_SEAL_FUTURE_WRITE | F_SEAL_SHRINK | F_SEAL_GROW |
+                                    F_SEAL_SEAL))
+    {
+        // Older kernels do not have F_SEAL_FUTURE_WRITE.
+        LE_WARN("Cannot seal the shared memory (%m), only the permissions protect it.");
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create the latest fix shared with the clients, and publish the last position sample in it.
+ *
+ * The memory is created by the service, so the clients bound to the service are allowed to read it.
+ *
+ * @return
+ *  - LE_OK            The latest fix is created.
+ *  - LE_UNAVAILABLE   Shared memory is not available.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t CreateLatestFix
+(
+    void
+)
+{
+    int fd = CreateSharedMemory("gnssLatestFix", sizeof(le_gnss_LatestFix_t));
+    if (fd < 0)
+    {
+        LE_WARN("Cannot create the latest fix (%m).");
+        return LE_UNAVAILABLE;
+    }
+
+    le_gnss_LatestFix_t* latestFixPtr = mmap(NULL, sizeof(le_gnss_LatestFix_t),
+                                             PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (MAP_FAILED == latestFixPtr)
+    {
+        LE_ERROR("Cannot map the latest fix (%m).");
+        close(fd);
+        return LE_UNAVAILABLE;
+    }
+
+    SealSharedMemory(fd);
+
+    LatestFixFd = fd;
+    LatestFixPtr = latestFixPtr;
+    PublishLatestFix();
+
+    // The latest fix is updated from the PA position data.
+    SubscribePaPositionHandler();
+
+    return LE_OK;
+}
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the latest position fix shared by the GNSS service.
+ *
+ * Each client gets its own read-only file descriptor on the same shared memory, which is updated
+ * once per position whatever the number of clients.
+ *
+ * @return
+ *  - LE_OK            The latest fix file descriptor is returned.
+ *  - LE_UNAVAILABLE   The latest fix is not available on this platform.
+ *  - LE_FAULT         The function failed.
+ *
+ * @note If the caller is passing a null pointer into this function, it is a fatal error, the
+ *       function will not return.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_gnss_OpenLatestFix
+(
+    int* fdPtr
+        ///< [OUT] File descriptor of the latest fix.
+)
+{
+    if (NULL == fdPtr)
+    {
+        LE_KILL_CLIENT("fdPtr is NULL.");
+        return LE_FAULT;
+    }
+    *fdPtr = -1;
+
+#ifdef LE_CONFIG_LINUX
+    if ((NULL == LatestFixPtr) && (LE_OK != CreateLatestFix()))
+    {
+        return LE_UNAVAILABLE;
+    }
+
+    // Reopen the memory read-only, so clients cannot map it for writing. They cannot reopen it for
+    // writing either: the memory is read-only in the file system, and sealed against writes.
+    char path[32];
+    snprintf(path, sizeof(path), "/proc/self/fd/%d", LatestFixFd);
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        LE_ERROR("Cannot open the latest fix (%m).");
+        return LE_FAULT;
+    }
+
+    // The IPC closes our copy of the file descriptor once it is sent.
+    *fdPtr = fd;
+    return LE_OK;
+#else
+    return LE_UNAVAILABLE;
+#endif
+}
+
+#ifdef LE_CONFIG_LINUX
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create the NMEA records ring shared with the clients.
+ *
+ * The memory is created by the service, so the clients bound to the service are allowed to read it.
+ *
+ * @return
+ *  - LE_OK            The NMEA records ring is created.
+ *  - LE_UNAVAILABLE   Shared memory or the PA NMEA frames are not available.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t CreateNmeaRing
+(
+    void
+)
+{
+    int fd = CreateSharedMemory("gnssNmeaRecords", GNSS_NMEA_RING_SIZE);
+    if (fd < 0)
+    {
+        LE_WARN("Cannot create the NMEA records (%m).");
+        return LE_UNAVAILABLE;
+    }
+
+    le_gnss_NmeaRing_t* ringPtr = mmap(NULL, GNSS_NMEA_RING_SIZE, PROT_READ | PROT_WRITE,
+                                       MAP_SHARED, fd, 0);
+    if (MAP_FAILED == ringPtr)
+    {
+        LE_ERROR("Cannot map the NMEA records (%m).");
+        close(fd);
+        return LE_UNAVAILABLE;
+    }
+
+    // The ring is fed by the PA NMEA handler, which is not subscribed at init when the NMEA node
+    // is a character device.
+    if ((NULL == PaNmeaHandlerRef) &&
+        (NULL == (PaNmeaHandlerRef = pa_gnss_AddNmeaHandler(PaNmeaHandler))))
+    {
+        LE_ERROR("Failed to add PA NMEA handler!");
+        munmap(ringPtr, GNSS_NMEA_RING_SIZE);
+        close(fd);
+        return LE_UNAVAILABLE;
+    }
+
+    SealSharedMemory(fd);
+    gnssNmea_InitRing(ringPtr);
+
+    // From now on, the NMEA frames of the PA are decoded into the ring.
+    NmeaRingFd = fd;
+    NmeaRingPtr = ringPtr;
+
+    return LE_OK;
+}
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the NMEA records ring shared by the GNSS service.
+ *
+ * Each client gets its own read-only file descriptor on the same shared memory, in which each NMEA
+ * sentence is decoded once whatever the number of clients.
+ *
+ * @return
+ *  - LE_OK            The NMEA records file descriptor is returned.
+ *  - LE_UNAVAILABLE   The NMEA records are not available on this platform, or the platform does
+ *                     not report the NMEA frames to the service.
+ *  - LE_FAULT         The function failed.
+ *
+ * @note If the caller is passing a null pointer into this function, it is a fatal error, the
+ *       function will not return.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_gnss_OpenNmeaRecords
+(
+    int* fdPtr
+        ///< [OUT] File descriptor of the NMEA records ring.
+)
+{
+    if (NULL == fdPtr)
+    {
+        LE_KILL_CLIENT("fdPtr is NULL.");
+        return LE_FAULT;
+    }
+    *fdPtr = -1;
+
+#ifdef LE_CONFIG_LINUX
+    if ((NULL == NmeaRingPtr) && (LE_OK != CreateNmeaRing()))
+    {
+        return LE_UNAVAILABLE;
+    }
+
+    // Reopen the memory read-only, so clients cannot map it for writing. They cannot reopen it for
+    // writing either: the memory is read-only in the file system, and sealed against writes.
+    char path[32];
+    snprintf(path, sizeof(path), "/proc/self/fd/%d", NmeaRingFd);
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        LE_ERROR("Cannot open the NMEA records (%m).");
+        return LE_FAULT;
+    }
+
+    // The IPC closes our copy of the file descriptor once it is sent.
+    *fdPtr = fd;
+    return LE_OK;
+#else
+    return LE_UNAVAILABLE;
+#endif
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Set the GNSS constellation bit mask
@@ -150,6 +150,9 @@ le_pos_Sample_t;
 typedef struct le_pos_SampleHandler
 {
     le_pos_MovementHandlerFunc_t handlerFuncPtr;      ///< The handler function address.
+    le_pos_MovementSampleHandlerFunc_t dataHandlerFuncPtr; ///< The sample data handler function
+                                                      ///  address, called instead of
+                                                      ///  handlerFuncPtr when set.
     void*                        handlerContextPtr;   ///< The handler function context.
     uint32_t                     acquisitionRate;     ///< The acquisition rate for this handler.
     uint32_t                     horizontalMagnitude; ///< The horizontal magnitude in meters for
@@ -800,6 +803,222 @@ static le_result_t ComputeMove
     return LE_OK;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a GNSS position sample into a position sample.
+ *
+ * The location and altitude are taken from posParamPtr, as they have already been read.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReadGnssSample
+(
+    le_gnss_SampleRef_t     positionSampleRef,  ///< [IN] GNSS position sample reference.
+    const PositionParam_t*  posParamPtr,        ///< [IN] Location and altitude of the sample.
+    le_pos_Sample_t*        samplePtr           ///< [OUT] Position sample.
+)
+{
+    // Direction
+    uint32_t direction;
+    uint32_t directionAccuracy;
+    // the position fix state
+    le_gnss_FixState_t gnssState;
+
+    samplePtr->latitudeValid = CHECK_VALIDITY(posParamPtr->latitude, INT32_MAX);
+    samplePtr->latitude = posParamPtr->latitude;
+
+    samplePtr->longitudeValid = CHECK_VALIDITY(posParamPtr->longitude, INT32_MAX);
+    samplePtr->longitude = posParamPtr->longitude;
+
+    samplePtr->hAccuracyValid = CHECK_VALIDITY(posParamPtr->hAccuracy, INT32_MAX);
+    samplePtr->hAccuracy = posParamPtr->hAccuracy;
+
+    samplePtr->altitudeValid = CHECK_VALIDITY(posParamPtr->altitude, INT32_MAX);
+    samplePtr->altitude = posParamPtr->altitude;
+
+    samplePtr->vAccuracyValid = CHECK_VALIDITY(posParamPtr->vAccuracy, INT32_MAX);
+    samplePtr->vAccuracy = posParamPtr->vAccuracy;
+
+    // Get horizontal speed
+    le_gnss_GetHorizontalSpeed(positionSampleRef, &samplePtr->hSpeed, &samplePtr->hSpeedAccuracy);
+    samplePtr->hSpeedValid = CHECK_VALIDITY(samplePtr->hSpeed, UINT32_MAX);
+    samplePtr->hSpeedAccuracyValid = CHECK_VALIDITY(samplePtr->hSpeedAccuracy, UINT32_MAX);
+
+    // Get vertical speed
+    le_gnss_GetVerticalSpeed(positionSampleRef, &samplePtr->vSpeed, &samplePtr->vSpeedAccuracy);
+    samplePtr->vSpeedValid = CHECK_VALIDITY(samplePtr->vSpeed, INT32_MAX);
+    samplePtr->vSpeedAccuracyValid = CHECK_VALIDITY(samplePtr->vSpeedAccuracy, INT32_MAX);
+
+    // Heading not supported by GNSS engine
+    samplePtr->headingValid = false;
+    samplePtr->heading = UINT32_MAX;
+    samplePtr->headingAccuracyValid = false;
+    samplePtr->headingAccuracy = UINT32_MAX;
+
+    // Get direction
+    le_gnss_GetDirection(positionSampleRef, &direction, &directionAccuracy);
+    samplePtr->directionValid = CHECK_VALIDITY(direction, UINT32_MAX);
+    samplePtr->direction = direction;
+    samplePtr->directionAccuracyValid = CHECK_VALIDITY(directionAccuracy, UINT32_MAX);
+    samplePtr->directionAccuracy = directionAccuracy;
+
+    // Get UTC time
+    samplePtr->dateValid = (LE_OK == le_gnss_GetDate(positionSampleRef, &samplePtr->year,
+                                                     &samplePtr->month, &samplePtr->day));
+
+    samplePtr->timeValid = (LE_OK == le_gnss_GetTime(positionSampleRef, &samplePtr->hours,
+                                                     &samplePtr->minutes, &samplePtr->seconds,
+                                                     &samplePtr->milliseconds));
+
+    // Get UTC leap seconds in advance
+    samplePtr->leapSecondsValid = (LE_OK == le_gnss_GetGpsLeapSeconds(positionSampleRef,
+                                                                      &samplePtr->leapSeconds));
+
+    // Get position fix state
+    if (LE_OK != le_gnss_GetPositionState(positionSampleRef, &gnssState))
+    {
+        samplePtr->fixState = LE_POS_STATE_UNKNOWN;
+        LE_ERROR("Failed to get a position fix");
+    }
+    else
+    {
+        samplePtr->fixState = (le_pos_FixState_t)gnssState;
+    }
+
+    samplePtr->link = LE_DLS_LINK_INIT;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the data of a position sample, as returned by the accessor functions.
+ */
+//--------------------------------------------------------------------------------------------------
+static void GetSampleData
+(
+    const le_pos_Sample_t*  samplePtr,  ///< [IN] Position sample.
+    le_pos_SampleData_t*    dataPtr     ///< [OUT] Position sample's data.
+)
+{
+    le_pos_SampleValidity_t validity = 0;
+
+    dataPtr->fixState = samplePtr->fixState;
+
+    if (samplePtr->latitudeValid && samplePtr->longitudeValid)
+    {
+        validity |= LE_POS_SAMPLE_LOCATION;
+    }
+    dataPtr->latitude = samplePtr->latitudeValid ? samplePtr->latitude : INT32_MAX;
+    dataPtr->longitude = samplePtr->longitudeValid ? samplePtr->longitude : INT32_MAX;
+
+    dataPtr->hAccuracy = INT32_MAX;
+    if (samplePtr->hAccuracyValid)
+    {
+        validity |= LE_POS_SAMPLE_H_ACCURACY;
+        dataPtr->hAccuracy = ConvertDistance(samplePtr->hAccuracy, H_ACCURACY);
+    }
+
+    dataPtr->altitude = INT32_MAX;
+    if (samplePtr->altitudeValid)
+    {
+        validity |= LE_POS_SAMPLE_ALTITUDE;
+        dataPtr->altitude = ConvertDistance(samplePtr->altitude, ALTITUDE);
+    }
+
+    dataPtr->vAccuracy = INT32_MAX;
+    if (samplePtr->vAccuracyValid)
+    {
+        validity |= LE_POS_SAMPLE_V_ACCURACY;
+        dataPtr->vAccuracy = ConvertDistance(samplePtr->vAccuracy, V_ACCURACY);
+    }
+
+    dataPtr->hSpeed = UINT32_MAX;
+    if (samplePtr->hSpeedValid)
+    {
+        validity |= LE_POS_SAMPLE_H_SPEED;
+        dataPtr->hSpeed = samplePtr->hSpeed/100;
+    }
+
+    dataPtr->hSpeedAccuracy = UINT32_MAX;
+    if (samplePtr->hSpeedAccuracyValid)
+    {
+        validity |= LE_POS_SAMPLE_H_SPEED_ACCURACY;
+        dataPtr->hSpeedAccuracy = samplePtr->hSpeedAccuracy/10;
+    }
+
+    dataPtr->vSpeed = INT32_MAX;
+    if (samplePtr->vSpeedValid)
+    {
+        validity |= LE_POS_SAMPLE_V_SPEED;
+        dataPtr->vSpeed = samplePtr->vSpeed/100;
+    }
+
+    dataPtr->vSpeedAccuracy = INT32_MAX;
+    if (samplePtr->vSpeedAccuracyValid)
+    {
+        validity |= LE_POS_SAMPLE_V_SPEED_ACCURACY;
+        dataPtr->vSpeedAccuracy = samplePtr->vSpeedAccuracy/10;
+    }
+
+    dataPtr->heading = UINT32_MAX;
+    if (samplePtr->headingValid)
+    {
+        validity |= LE_POS_SAMPLE_HEADING;
+        dataPtr->heading = samplePtr->heading;
+    }
+
+    dataPtr->headingAccuracy = UINT32_MAX;
+    if (samplePtr->headingAccuracyValid)
+    {
+        validity |= LE_POS_SAMPLE_HEADING_ACCURACY;
+        dataPtr->headingAccuracy = samplePtr->headingAccuracy;
+    }
+
+    dataPtr->direction = UINT32_MAX;
+    if (samplePtr->directionValid)
+    {
+        validity |= LE_POS_SAMPLE_DIRECTION;
+        dataPtr->direction = samplePtr->direction/10;
+    }
+
+    dataPtr->directionAccuracy = UINT32_MAX;
+    if (samplePtr->directionAccuracyValid)
+    {
+        validity |= LE_POS_SAMPLE_DIRECTION_ACCURACY;
+        dataPtr->directionAccuracy = samplePtr->directionAccuracy/10;
+    }
+
+    if (samplePtr->dateValid)
+    {
+        validity |= LE_POS_SAMPLE_DATE;
+        dataPtr->year = samplePtr->year;
+        dataPtr->month = samplePtr->month;
+        dataPtr->day = samplePtr->day;
+    }
+    else
+    {
+        dataPtr->year = 0;
+        dataPtr->month = 0;
+        dataPtr->day = 0;
+    }
+
+    if (samplePtr->timeValid)
+    {
+        validity |= LE_POS_SAMPLE_TIME;
+        dataPtr->hours = samplePtr->hours;
+        dataPtr->minutes = samplePtr->minutes;
+        dataPtr->seconds = samplePtr->seconds;
+        dataPtr->milliseconds = samplePtr->milliseconds;
+    }
+    else
+    {
+        dataPtr->hours = 0;
+        dataPtr->minutes = 0;
+        dataPtr->seconds = 0;
+        dataPtr->milliseconds = 0;
+    }
+
+    dataPtr->validity = validity;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * The main position Sample Handler.
@@ -821,29 +1040,10 @@ static void PosSampleHandlerfunc
     bool        altitudeValid = false;
     int32_t     altitude;
     int32_t     vAccuracy;
-    // Horizontal speed
-    uint32_t hSpeed;
-    uint32_t hSpeedAccuracy;
-    // Vertical speed
-    int32_t vSpeed;
-    int32_t vSpeedAccuracy;
-    // Direction
-    uint32_t direction;
-    uint32_t directionAccuracy;
-    // Date parameters
-    uint16_t year;
-    uint16_t month;
-    uint16_t day;
-    // Time parameters
-    uint16_t hours;
-    uint16_t minutes;
-    uint16_t seconds;
-    uint16_t milliseconds;
-    // Leap seconds in advance
-    uint8_t leapSeconds;
     PositionParam_t posParam;
-    // the position fix state
-    le_gnss_FixState_t gnssState;
+    // Sample reported to the handlers
+    le_pos_Sample_t sample;
+    bool            sampleRead = false;
 
     // Positioning sample parameters
     le_pos_SampleHandler_t* posSampleHandlerNodePtr;
@@ -940,123 +1140,46 @@ static void PosSampleHandlerfunc
              ((0 == posSampleHandlerNodePtr->verticalMagnitude)
              && (0 == posSampleHandlerNodePtr->horizontalMagnitude)))
         {
-            // Create the position sample node.
-            posSampleRequestPtr = le_mem_ForceAlloc(PosSampleRequestPoolRef);
-            posSampleRequestPtr->posSampleNodePtr
-                                = (le_pos_Sample_t*)le_mem_ForceAlloc(PosSamplePoolRef);
-            posSampleRequestPtr->posSampleNodePtr->latitudeValid
-                                = CHECK_VALIDITY(latitude,INT32_MAX);
-            posSampleRequestPtr->posSampleNodePtr->latitude = latitude;
-
-            posSampleRequestPtr->posSampleNodePtr->longitudeValid
-                                = CHECK_VALIDITY(longitude,INT32_MAX);
-            posSampleRequestPtr->posSampleNodePtr->longitude = longitude;
-
-            posSampleRequestPtr->posSampleNodePtr->hAccuracyValid
-                                = CHECK_VALIDITY(hAccuracy,INT32_MAX);
-            posSampleRequestPtr->posSampleNodePtr->hAccuracy = hAccuracy;
-
-            posSampleRequestPtr->posSampleNodePtr->altitudeValid
-                                = CHECK_VALIDITY(altitude,INT32_MAX);
-            posSampleRequestPtr->posSampleNodePtr->altitude = altitude;
-
-            posSampleRequestPtr->posSampleNodePtr->vAccuracyValid
-                                = CHECK_VALIDITY(vAccuracy,INT32_MAX);
-            posSampleRequestPtr->posSampleNodePtr->vAccuracy = vAccuracy;
-
-            // Get horizontal speed
-            le_gnss_GetHorizontalSpeed(positionSampleRef, &hSpeed, &hSpeedAccuracy);
-            posSampleRequestPtr->posSampleNodePtr->hSpeedValid
-                                    = CHECK_VALIDITY(hSpeed,UINT32_MAX);
-            posSampleRequestPtr->posSampleNodePtr->hSpeed = hSpeed;
-            posSampleRequestPtr->posSampleNodePtr->hSpeedAccuracyValid =
-                                                CHECK_VALIDITY(hSpeedAccuracy,UINT32_MAX);
-            posSampleRequestPtr->posSampleNodePtr->hSpeedAccuracy = hSpeedAccuracy;
-
-            // Get vertical speed
-            le_gnss_GetVerticalSpeed(positionSampleRef, &vSpeed, &vSpeedAccuracy);
-            posSampleRequestPtr->posSampleNodePtr->vSpeedValid
-                                = CHECK_VALIDITY(vSpeed,INT32_MAX);
-            posSampleRequestPtr->posSampleNodePtr->vSpeed = vSpeed;
-            posSampleRequestPtr->posSampleNodePtr->vSpeedAccuracyValid =
-                                                CHECK_VALIDITY(vSpeedAccuracy,INT32_MAX);
-            posSampleRequestPtr->posSampleNodePtr->vSpeedAccuracy = vSpeedAccuracy;
-
-            // Heading not supported by GNSS engine
-            posSampleRequestPtr->posSampleNodePtr->headingValid = false;
-            posSampleRequestPtr->posSampleNodePtr->heading = UINT32_MAX;
-            posSampleRequestPtr->posSampleNodePtr->headingAccuracyValid = false;
-            posSampleRequestPtr->posSampleNodePtr->headingAccuracy = UINT32_MAX;
-
-            // Get direction
-            le_gnss_GetDirection(positionSampleRef, &direction, &directionAccuracy);
-
-            posSampleRequestPtr->posSampleNodePtr->directionValid
-                                = CHECK_VALIDITY(direction,UINT32_MAX);
-            posSampleRequestPtr->posSampleNodePtr->direction = direction;
-            posSampleRequestPtr->posSampleNodePtr->directionAccuracyValid =
-                                            CHECK_VALIDITY(directionAccuracy,UINT32_MAX);
-            posSampleRequestPtr->posSampleNodePtr->directionAccuracy = directionAccuracy;
-
-            // Get UTC time
-            if (LE_OK == le_gnss_GetDate(positionSampleRef, &year, &month, &day))
+            // The sample is read once, for the first handler to notify
+            if (!sampleRead)
             {
-                posSampleRequestPtr->posSampleNodePtr->dateValid = true;
+                ReadGnssSample(positionSampleRef, &posParam, &sample);
+                sampleRead = true;
             }
-            else
-            {
-                posSampleRequestPtr->posSampleNodePtr->dateValid = false;
-            }
-            posSampleRequestPtr->posSampleNodePtr->year = year;
-            posSampleRequestPtr->posSampleNodePtr->month = month;
-            posSampleRequestPtr->posSampleNodePtr->day = day;
 
-            if (LE_OK == le_gnss_GetTime(positionSampleRef, &hours, &minutes, &seconds,
-                                         &milliseconds))
-            {
-                posSampleRequestPtr->posSampleNodePtr->timeValid = true;
-            }
-            else
-            {
-                posSampleRequestPtr->posSampleNodePtr->timeValid = false;
-            }
-            posSampleRequestPtr->posSampleNodePtr->hours = hours;
-            posSampleRequestPtr->posSampleNodePtr->minutes = minutes;
-            posSampleRequestPtr->posSampleNodePtr->seconds = seconds;
-            posSampleRequestPtr->posSampleNodePtr->milliseconds = milliseconds;
+            // Save the information reported to the handler function
+            posSampleHandlerNodePtr->lastLat = latitude;
+            posSampleHandlerNodePtr->lastLong = longitude;
+            posSampleHandlerNodePtr->lastAlt = altitude;
 
-            // Get UTC leap seconds in advance
-            if (LE_OK == le_gnss_GetGpsLeapSeconds(positionSampleRef, &leapSeconds))
+            if (posSampleHandlerNodePtr->dataHandlerFuncPtr)
             {
-               posSampleRequestPtr->posSampleNodePtr->leapSecondsValid = true;
-            }
-            else
-            {
-                posSampleRequestPtr->posSampleNodePtr->leapSecondsValid = false;
-            }
-            posSampleRequestPtr->posSampleNodePtr->leapSeconds = leapSeconds;
+                le_pos_SampleData_t data;
 
-            // Get position fix state
-            if (LE_OK != le_gnss_GetPositionState(positionSampleRef, &gnssState))
-            {
-                posSampleRequestPtr->posSampleNodePtr->fixState = LE_POS_STATE_UNKNOWN;
-                LE_ERROR("Failed to get a position fix");
-            }
-            else
-            {
-                posSampleRequestPtr->posSampleNodePtr->fixState = (le_pos_FixState_t)gnssState;
+                GetSampleData(&sample, &data);
+
+                LE_DEBUG("Report sample data to the corresponding handler (handler %p)",
+                         posSampleHandlerNodePtr->dataHandlerFuncPtr);
+
+                // Call the client's handler: the sample is given by value, nothing to release
+                posSampleHandlerNodePtr->dataHandlerFuncPtr(&data,
+                                                   posSampleHandlerNodePtr->handlerContextPtr);
+
+                // Move to the next node.
+                linkPtr = le_dls_PeekNext(&PosSampleHandlerList, linkPtr);
+                continue;
             }
 
+            // Create the position sample node.
+            posSampleRequestPtr = le_mem_ForceAlloc(PosSampleRequestPoolRef);
+            posSampleRequestPtr->posSampleNodePtr
+                                = (le_pos_Sample_t*)le_mem_ForceAlloc(PosSamplePoolRef);
+            *posSampleRequestPtr->posSampleNodePtr = sample;
             posSampleRequestPtr->posSampleNodePtr->link = LE_DLS_LINK_INIT;
 
             // Add the node to the queue of the list by passing in the node's link.
             le_dls_Queue(&PosSampleList, &(posSampleRequestPtr->posSampleNodePtr->link));
 
-            // Save the information reported to the handler function
-            posSampleHandlerNodePtr->lastLat = latitude;
-            posSampleHandlerNodePtr->lastLong = longitude;
-            posSampleHandlerNodePtr->lastAlt = altitude;
-
             LE_DEBUG("Report sample %p to the corresponding handler (handler %p)",
                      posSampleRequestPtr->posSampleNodePtr,
                      posSampleHandlerNodePtr->handlerFuncPtr);
@@ -1380,38 +1503,30 @@ void le_posCtrl_Release
 
 //--------------------------------------------------------------------------------------------------
 /**
- * This function must be called to register an handler for movement notifications.
+ * Register an handler for movement notifications, given either a position sample reference
+ * (handlerPtr) or the position sample's data (dataHandlerPtr).
  *
- * @return A handler reference, which is only needed for later removal of the handler.
- *
- * @note Doesn't return on failure, so there's no need to check the return value for errors.
+ * @return A handler reference, or NULL on failure.
  */
 //--------------------------------------------------------------------------------------------------
-le_pos_MovementHandlerRef_t le_pos_AddMovementHandler
+static le_pos_SampleHandler_t* AddSampleHandler
 (
-    uint32_t                     horizontalMagnitude, ///< [IN] The horizontal magnitude in meters.
-                                                      ///       0 means that I don't care about
-                                                      ///       changes in the latitude and
-                                                      ///       longitude.
-    uint32_t                     verticalMagnitude,   ///< [IN] The vertical magnitude in meters.
-                                                      ///       0 means that I don't care about
-                                                      ///       changes in the altitude.
-    le_pos_MovementHandlerFunc_t handlerPtr,          ///< [IN] The handler function.
-    void*                        contextPtr           ///< [IN] The context pointer
+    uint32_t                           horizontalMagnitude, ///< [IN] The horizontal magnitude in
+                                                            ///       meters.
+    uint32_t                           verticalMagnitude,   ///< [IN] The vertical magnitude in
+                                                            ///       meters.
+    le_pos_MovementHandlerFunc_t       handlerPtr,          ///< [IN] The handler function.
+    le_pos_MovementSampleHandlerFunc_t dataHandlerPtr,      ///< [IN] The data handler function.
+    void*                              contextPtr           ///< [IN] The context pointer
 )
 {
     le_pos_SampleHandler_t*  posSampleHandlerNodePtr=NULL;
 
-    if (NULL == handlerPtr)
-    {
-        LE_KILL_CLIENT("handlerPtr pointer is NULL!");
-        return NULL;
-    }
-
     // Create the position sample handler node.
     posSampleHandlerNodePtr = (le_pos_SampleHandler_t*)le_mem_ForceAlloc(PosSampleHandlerPoolRef);
     posSampleHandlerNodePtr->link = LE_DLS_LINK_INIT;
     posSampleHandlerNodePtr->handlerFuncPtr = handlerPtr;
+    posSampleHandlerNodePtr->dataHandlerFuncPtr = dataHandlerPtr;
     posSampleHandlerNodePtr->handlerContextPtr = contextPtr;
     posSampleHandlerNodePtr->acquisitionRate =
                                         CalculateAcquisitionRate(SUPPOSED_AVERAGE_SPEED,
@@ -1458,19 +1573,17 @@ le_pos_MovementHandlerRef_t le_pos_AddMovementHandler
     le_dls_Queue(&PosSampleHandlerList, &(posSampleHandlerNodePtr->link));
     NumOfHandlers++;
 
-    return (le_pos_MovementHandlerRef_t)posSampleHandlerNodePtr;
+    return posSampleHandlerNodePtr;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * This function must be called to remove a handler for movement notifications.
- *
- * @note Doesn't return on failure, so there's no need to check the return value for errors.
+ * Remove a handler for movement notifications.
  */
 //--------------------------------------------------------------------------------------------------
-void le_pos_RemoveMovementHandler
+static void RemoveSampleHandler
 (
-    le_pos_MovementHandlerRef_t    handlerRef ///< [IN] The handler reference.
+    le_pos_SampleHandler_t* handlerPtr  ///< [IN] The handler.
 )
 {
     le_pos_SampleHandler_t* posSampleHandlerNodePtr;
@@ -1486,7 +1599,7 @@ void le_pos_RemoveMovementHandler
                                                                             le_pos_SampleHandler_t,
                                                                             link);
             // Check the node.
-            if ((le_pos_MovementHandlerRef_t)posSampleHandlerNodePtr == handlerRef)
+            if (posSampleHandlerNodePtr == handlerPtr)
             {
                 // Remove the node.
                 le_mem_Release(posSampleHandlerNodePtr);
@@ -1508,6 +1621,103 @@ void le_pos_RemoveMovementHandler
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to register an handler for movement notifications.
+ *
+ * @return A handler reference, which is only needed for later removal of the handler.
+ *
+ * @note Doesn't return on failure, so there's no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+le_pos_MovementHandlerRef_t le_pos_AddMovementHandler
+(
+    uint32_t                     horizontalMagnitude, ///< [IN] The horizontal magnitude in meters.
+                                                      ///       0 means that I don't care about
+                                                      ///       changes in the latitude and
+                                                      ///       longitude.
+    uint32_t                     verticalMagnitude,   ///< [IN] The vertical magnitude in meters.
+                                                      ///       0 means that I don't care about
+                                                      ///       changes in the altitude.
+    le_pos_MovementHandlerFunc_t handlerPtr,          ///< [IN] The handler function.
+    void*                        contextPtr           ///< [IN] The context pointer
+)
+{
+    if (NULL == handlerPtr)
+    {
+        LE_KILL_CLIENT("handlerPtr pointer is NULL!");
+        return NULL;
+    }
+
+    return (le_pos_MovementHandlerRef_t)AddSampleHandler(horizontalMagnitude, verticalMagnitude,
+                                                         handlerPtr, NULL, contextPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to remove a handler for movement notifications.
+ *
+ * @note Doesn't return on failure, so there's no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_pos_RemoveMovementHandler
+(
+    le_pos_MovementHandlerRef_t    handlerRef ///< [IN] The handler reference.
+)
+{
+    RemoveSampleHandler((le_pos_SampleHandler_t*)handlerRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to register an handler for movement notifications, given the
+ * complete position sample's data.
+ *
+ * @return A handler reference, which is only needed for later removal of the handler.
+ *
+ * @note Doesn't return on failure, so there's no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+le_pos_MovementSampleHandlerRef_t le_pos_AddMovementSampleHandler
+(
+    uint32_t                     horizontalMagnitude, ///< [IN] The horizontal magnitude in meters.
+                                                      ///       0 means that I don't care about
+                                                      ///       changes in the latitude and
+                                                      ///       longitude.
+    uint32_t                     verticalMagnitude,   ///< [IN] The vertical magnitude in meters.
+                                                      ///       0 means that I don't care about
+                                                      ///       changes in the altitude.
+    le_pos_MovementSampleHandlerFunc_t handlerPtr,    ///< [IN] The handler function.
+    void*                        contextPtr           ///< [IN] The context pointer
+)
+{
+    if (NULL == handlerPtr)
+    {
+        LE_KILL_CLIENT("handlerPtr pointer is NULL!");
+        return NULL;
+    }
+
+    return (le_pos_MovementSampleHandlerRef_t)AddSampleHandler(horizontalMagnitude,
+                                                               verticalMagnitude,
+                                                               NULL, handlerPtr, contextPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to remove a handler for movement notifications given the position
+ * sample's data.
+ *
+ * @note Doesn't return on failure, so there's no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_pos_RemoveMovementSampleHandler
+(
+    le_pos_MovementSampleHandlerRef_t handlerRef ///< [IN] The handler reference.
+)
+{
+    RemoveSampleHandler((le_pos_SampleHandler_t*)handlerRef);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Get the position sample's 2D location (latitude, longitude,
@@ -2164,6 +2374,45 @@ void le_pos_sample_Release
     le_mem_Release(posSampleRequestPtr);
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get all the data of the position sample at once.
+ *
+ * @return LE_FAULT         Function failed to find the positionSample.
+ * @return LE_OK            Function succeeded. dataPtr->validity tells which fields are set.
+ * @return LE_BAD_PARAMETER Invalid reference provided.
+ *
+ * @note If the caller is passing an invalid Position reference into this function,
+ *       it is a fatal error, the function will not return.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_pos_sample_GetData
+(
+    le_pos_SampleRef_t    positionSampleRef,   ///< [IN] The position sample's reference.
+    le_pos_SampleData_t*  dataPtr              ///< [OUT] Position sample's data.
+)
+{
+    PosSampleRequest_t* posSampleRequestPtr = le_ref_Lookup(PosSampleMap,positionSampleRef);
+    if (NULL == posSampleRequestPtr)
+    {
+        LE_KILL_CLIENT("Invalid reference (%p) provided!", positionSampleRef);
+        return LE_BAD_PARAMETER;
+    }
+
+    if (posSampleRequestPtr->posSampleNodePtr == NULL)
+    {
+        LE_KILL_CLIENT("Invalid reference (%p) provided!",positionSampleRef);
+        return LE_FAULT;
+    }
+
+    if (dataPtr)
+    {
+        GetSampleData(posSampleRequestPtr->posSampleNodePtr, dataPtr);
+    }
+
+    return LE_OK;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Get the 2D location's data (Latitude, Longitude, Horizontal
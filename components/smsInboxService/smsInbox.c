@@ -2,27 +2,29 @@
 /**
  *  SMS Inbox Server
  *
- * When the service is activated, or when a SMS is received, the SMS is copied from the SIM to a
- * specific folder (SMSINBOX_PATH/MSG_PATH).
+ * When the service is activated, or when a SMS is received, the SMS is copied from the SIM to the
+ * message store (SMSINBOX_PATH/STORE_FILE) and added to the message box of each application.
  *
- * Each SMS is copied into a dedicated file (named with a unique message identifier). The data
- * are stored using the Jannsson representation: Each data (imsi, SMS format, message length,
- * text/pdu, sender telephone number, timestamp, read/unread) are recorded with a key to retrieve
- * each value.
+ * The message store is an append-only log, indexed in memory (see smsStore.c): browsing a message
+ * box, reading a message, marking it as read or deleting it does not rewrite any file. Each
+ * application using the SMS Inbox Server possesses a message box, holding up to a configured number
+ * of messages, with its own read/unread status of each message. A message is deleted once no
+ * message box holds it anymore.
  *
- * Each application using the SMS Inbox Server possesses a configuration file in
- * SMSINBOX_PATH/CONF_PATH directory (also encoding using Jansson format): this file is used to
- * store the message identifier contained in the application mailbox. It is updated each time is new
- * SMS is received.
+ * Earlier versions stored each SMS in a dedicated Jansson file of the SMSINBOX_PATH/MSG_PATH
+ * directory, and the messages of each message box in a Jansson file of the SMSINBOX_PATH/CONF_PATH
+ * directory. These files are imported into the message store when it is loaded, and then removed.
  *
  *  Copyright (C) Sierra Wireless Inc.
  */
 // -------------------------------------------------------------------------------------------------
 
+
 #include "legato.h"
 #include "interfaces.h"
 #include "mdmCfgEntries.h"
 #include "le_smsInbox.h"
+#include "smsStore.h"
 
 #include "le_print.h"
 #include "le_hex.h"
@@ -54,6 +56,13 @@
 //--------------------------------------------------------------------------------------------------
 #define FILE_EXTENSION ".json"
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Message store file name.
+ */
+//--------------------------------------------------------------------------------------------------
+#define STORE_FILE "msgStore.log"
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Json keys.
@@ -76,7 +85,7 @@
  * Maximum number of user applications.
  */
 //--------------------------------------------------------------------------------------------------
-#define MAX_APPS 16
+#define MAX_APPS SMSSTORE_MBOX_MAX
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -139,41 +148,10 @@ typedef uint32_t MessageId_t;
 //--------------------------------------------------------------------------------------------------
 typedef struct
 {
-    json_t* jsonObjPtr;
-    json_t* jsonArrayPtr;
-    uint32_t currentMessageIndex;
-    uint32_t maxIndex;
+    MessageId_t currentMessageId;   ///< Last message returned, 0 when the browsing is over
 }
 BrowseCtx_t;
 
-//--------------------------------------------------------------------------------------------------
-/**
- * Entry description structure.
- *
- */
-//--------------------------------------------------------------------------------------------------
-typedef struct
-{
-    enum
-    {
-        DESC_INT,
-        DESC_STRING,
-        DESC_BOOL
-    }                               type;       ///< Union type (string or integer
-    union
-    {
-        struct
-        {
-            char*   strPtr;                     ///< String
-            size_t  lenStr;                     ///< Length of the string
-        }                  str;                 ///< Value for string
-        uint32_t           val;                 ///< Value for integer
-        bool               boolVal;             ///< Boolean value
-    }                               uVal;       ///< Union type
-}
-EntryDesc_t;
-
-
 //--------------------------------------------------------------------------------------------------
 /**
  * message box object structure.
@@ -313,11 +291,11 @@ static char SimImsi[LE_SIM_IMSI_BYTES];
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Next message Identifier
+ * Message store loading status
  *
  */
 //--------------------------------------------------------------------------------------------------
-static MessageId_t NextMessageId = 1;
+static bool StoreLoaded;
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -334,128 +312,6 @@ static le_mem_PoolRef_t SmsInboxHandlerPoolRef;
 //--------------------------------------------------------------------------------------------------
 static le_ref_MapRef_t ActivationRequestRefMap;
 
-//--------------------------------------------------------------------------------------------------
-/**
- * Add a boolean value of a key in a Jason object
- *
- */
-//--------------------------------------------------------------------------------------------------
-static le_result_t AddBooleanKeyInJsonObject
-(
-    json_t *jsonObjPtr, ///<[IN] json object
-    const char* key,    ///<[IN] Key to be added
-    bool value          ///<[IN] Value to be added
-)
-{
-    json_t *jsonBoolPtr;
-    int ret = -1;
-
-    if ( value == true )
-    {
-        jsonBoolPtr = json_true();
-    }
-    else
-    {
-        jsonBoolPtr = json_false();
-    }
-
-    if (jsonBoolPtr)
-    {
-        ret = json_object_set_new(jsonObjPtr, key, jsonBoolPtr);
-    }
-    else
-    {
-        LE_ERROR("Error during set of the key %s", key);
-    }
-
-    if (ret == 0)
-    {
-        return LE_OK;
-    }
-    else
-    {
-        return LE_FAULT;
-    }
-}
-
-
-//--------------------------------------------------------------------------------------------------
-/**
- * Add an integer value of a key in a Jason object
- *
- */
-//--------------------------------------------------------------------------------------------------
-static le_result_t AddIntegerKeyInJsonObject
-(
-    json_t *jsonObjPtr, ///<[IN] json object
-    const char* key,    ///<[IN] Key to be added
-    int  value          ///<[IN] Value to be added
-)
-{
-    json_t *jsonIntPtr = json_integer(value);
-    int ret = -1;
-
-    if (jsonIntPtr)
-    {
-        if (json_is_array(jsonObjPtr))
-        {
-            ret = json_array_append_new(jsonObjPtr, jsonIntPtr);
-        }
-        else
-        {
-            ret = json_object_set_new(jsonObjPtr, key, jsonIntPtr);
-        }
-    }
-    else
-    {
-        LE_ERROR("Error during set of the key %s", key);
-    }
-
-    if (ret == 0)
-    {
-        return LE_OK;
-    }
-    else
-    {
-        return LE_FAULT;
-    }
-}
-
-//--------------------------------------------------------------------------------------------------
-/**
- * Add a string value of a key in a Jason object
- *
- */
-//--------------------------------------------------------------------------------------------------
-static le_result_t AddStringKeyInJsonObject
-(
-    json_t *jsonObjPtr, ///<[IN] json object
-    const char* key,    ///<[IN] Key to be added
-    char* string        ///<[IN] String to be added
-)
-{
-    json_t * jsonStrPtr = json_string(string);
-    int ret = -1;
-
-    if (jsonStrPtr)
-    {
-        ret = json_object_set_new(jsonObjPtr, key, jsonStrPtr);
-    }
-    else
-    {
-        LE_ERROR("Error during set of the key %s", key);
-    }
-
-    if (ret == 0)
-    {
-        return LE_OK;
-    }
-    else
-    {
-        return LE_FAULT;
-    }
-}
-
 //--------------------------------------------------------------------------------------------------
 /**
  * Get the SMSInbox directory path length
@@ -520,1018 +376,690 @@ static void GetSMSInboxConfigPath
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Modify Json object
+ * Get the message store index of a message box
  *
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t ModifyJsonObj
+static uint8_t GetMboxIndex
 (
-    json_t* jsonObjPtr,         ///<[IN] Json object (root object)
-    json_t* jsonValPtr,         ///<[IN] Json value to be modified
-    char*   key,                ///<[IN] Key to modify
-    EntryDesc_t * modifPtr      ///<[IN] Requested modification
+    MboxCtx_t* mboxCtxPtr   ///<[IN] message box
 )
 {
-    int res = 0;
+    return (uint8_t) (mboxCtxPtr - Apps);
+}
 
-    if (jsonValPtr == NULL)
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if a message belongs to a message box
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t CheckMessageIdInMbox
+(
+    MboxCtx_t* mboxCtxPtr,  ///<[IN] message box
+    MessageId_t messageId   ///<[IN] Message identifier
+)
+{
+    if (smsStore_IsInMbox(messageId, GetMboxIndex(mboxCtxPtr)))
     {
-        LE_ERROR("NULL jsonValPtr");
-        return LE_FAULT;
+        return LE_OK;
     }
 
-    switch (modifPtr->type)
-    {
-        case DESC_STRING:
-            // check the type
-            if (json_is_string(jsonValPtr) == false)
-            {
-                LE_ERROR("Bad key format");
-                res = -1;
-            }
-
-            if ( res == 0 )
-            {
-                res = json_string_set(jsonValPtr, modifPtr->uVal.str.strPtr);
-            }
-        break;
-        case DESC_INT:
-            // check the type
-            if (json_is_integer(jsonValPtr) == false )
-            {
-                LE_ERROR("Bad key format");
-                res = -1;
-            }
-
-            if ( res == 0 )
-            {
-                res = json_integer_set(jsonValPtr, modifPtr->uVal.val);
-            }
-        break;
-        case DESC_BOOL:
-            // check the type
-            if ( (json_is_true(jsonValPtr) != true) && (json_is_false(jsonValPtr) != true) )
-            {
-                LE_ERROR("Bad key format");
-                res = -1;
-            }
+    LE_ERROR("Bad msg id or mbox name");
+    return LE_FAULT;
+}
 
-            if (( res == 0 ) &&
-                (AddBooleanKeyInJsonObject(jsonObjPtr, key, modifPtr->uVal.boolVal) != LE_OK))
-            {
-                res = -1;
-            }
-        break;
-        default:
-            res = -1;
-        break;
-    }
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a message from the message store
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReadMsgEntry
+(
+    MessageId_t messageId,          ///<[IN] Message identifier
+    smsStore_Message_t* msgPtr      ///<[OUT] Message
+)
+{
+    le_result_t res = smsStore_Read(messageId, msgPtr);
 
-    if (res < 0)
+    if (res != LE_OK)
     {
-        LE_ERROR(("Update error %d"), modifPtr->type);
+        LE_ERROR("Unable to read message %d: %d", (int) messageId, res);
         return LE_FAULT;
     }
-    else
-    {
-        LE_DEBUG("ModifyJsonObj OK");
-        return LE_OK;
-    }
 
+    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Modify message file
+ * Get a string of a message
  *
+ * @return
+ *  - LE_OK            The string is copied.
+ *  - LE_OVERFLOW      The buffer is too small.
+ *  - LE_FAULT         The message does not have this string.
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t ModifyMsgEntry
+static le_result_t GetMsgString
 (
-    MessageId_t messageId,      ///<[IN] Message identifier to be modified
-    char* keyPtr[],              ///<[IN] Key to modify
-    uint8_t nbKey,              ///<[IN] Number of elements in keyPtr
-    EntryDesc_t * modifPtr      ///<[IN] Requested modification
+    const smsStore_Message_t* msgPtr,   ///<[IN] Message
+    uint32_t field,                     ///<[IN] Optional field of the string, 0 if it is mandatory
+    const char* strPtr,                 ///<[IN] String of the message
+    char* bufferPtr,                    ///<[OUT] Buffer
+    size_t bufferSize                   ///<[IN] Buffer size
 )
 {
-    uint16_t pathLen = GetSMSInboxMessagePathLen();
-    char path[pathLen];
-    memset(path, 0, pathLen);
-    json_error_t error;
-    le_result_t res;
-    int indexKey = -1;
-
-    GetSMSInboxMessagePath(messageId, path, pathLen);
-
-    LE_DEBUG("ModifyMsgEntry: messageId %d, path %s",messageId, path);
-
-    json_t* jsonRootPtr = json_load_file(path, 0, &error);
-
-    if ( jsonRootPtr == NULL )
+    if (field && !(msgPtr->fields & field))
     {
-        LE_ERROR("Json decoder error %s", error.text);
+        LE_ERROR("No such field %d", (int) field);
         return LE_FAULT;
     }
 
-    json_t* jsonValPtr = jsonRootPtr;
-    json_t* jsonSubObjPtr = jsonRootPtr;
-
-    while ( ( json_is_object(jsonValPtr) == true ) && ( nbKey > indexKey ) )
+    if (le_utf8_Copy(bufferPtr, strPtr, bufferSize, NULL) != LE_OK)
     {
-        indexKey++;
-        jsonSubObjPtr = jsonValPtr;
-        jsonValPtr = json_object_get(jsonSubObjPtr, keyPtr[indexKey]);
+        LE_ERROR("String too long");
+        return LE_OVERFLOW;
     }
 
-    if ( !jsonValPtr )
-    {
-        if ((indexKey > -1) && (indexKey < nbKey))
-        {
-            LE_ERROR("Unable to get the object %s", keyPtr[indexKey]);
-        }
-        else
-        {
-            LE_ERROR("IndexKey: %d is out of range", indexKey);
-        }
+    return LE_OK;
+}
 
-        res = LE_FAULT;
-    }
-    else
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the payload of a message
+ *
+ * @return
+ *  - LE_OK            The payload is copied.
+ *  - LE_OVERFLOW      The buffer is too small.
+ *  - LE_FAULT         The message has no payload in this format.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t GetMsgData
+(
+    const smsStore_Message_t* msgPtr,   ///<[IN] Message
+    le_sms_Format_t format,             ///<[IN] Expected message format
+    uint8_t* bufferPtr,                 ///<[OUT] Buffer
+    size_t bufferSize,                  ///<[IN] Buffer size
+    size_t* lenPtr                      ///<[OUT] Payload length
+)
+{
+    if ((msgPtr->format != format) || !(msgPtr->fields & SMSSTORE_FIELD_DATA))
     {
-        if ((indexKey > -1) && (indexKey < nbKey))
-        {
-            res = ModifyJsonObj(jsonSubObjPtr, jsonValPtr, keyPtr[indexKey], modifPtr);
-        }
-        else
-        {
-            LE_ERROR("IndexKey: %d is out of range", indexKey);
-            res = LE_FAULT;
-        }
+        LE_ERROR("Bad format %d", (int) msgPtr->format);
+        return LE_FAULT;
     }
 
-    if ( res == LE_OK )
+    if (msgPtr->dataLen > bufferSize)
     {
-        if (json_dump_file(jsonRootPtr, path, JSON_INDENT(1) | JSON_PRESERVE_ORDER) < 0)
-        {
-            LE_ERROR("Json error");
-            res = LE_FAULT;
-        }
-    }
-    else
-    {
-        LE_ERROR("Something was wrong in ModifyJsonObj");
+        LE_ERROR("Payload too long");
+        return LE_OVERFLOW;
     }
 
-    json_decref(jsonRootPtr);
+    memcpy(bufferPtr, msgPtr->data, msgPtr->dataLen);
+    *lenPtr = msgPtr->dataLen;
 
-    return res;
+    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Read Json object
+ * Encode a message for the message store
  *
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t ReadJsonObj
+static void EncodeMessage
 (
-    json_t* jsonValPtr,         ///<[IN] Json value to be read
-    char* keyPtr[],             ///<[IN] Key to read
-    uint8_t nbKey,              ///<[IN] Number of elements in keyPtr
-    EntryDesc_t * decodePtr     ///<[OUT] Decoding result
+    le_sms_MsgRef_t msgRef,         ///<[IN] SMS to be encoded
+    smsStore_Message_t* msgPtr      ///<[OUT] Encoded message
 )
 {
-    le_result_t res = LE_OK;
+    memset(msgPtr, 0, sizeof(smsStore_Message_t));
 
-    if ( jsonValPtr == NULL )
-    {
-        LE_ERROR("No information");
-        return LE_FAULT;
-    }
+    // Add imsi
+    le_utf8_Copy(msgPtr->imsi, SimImsi, sizeof(msgPtr->imsi), NULL);
+
+    // Add sms format
+    le_sms_Format_t format = le_sms_GetFormat(msgRef);
+    msgPtr->format = format;
 
-    switch json_typeof(jsonValPtr)
+    switch ( format )
     {
-        case JSON_STRING:
+        case LE_SMS_FORMAT_TEXT:
+        case LE_SMS_FORMAT_BINARY:
         {
-            if ( decodePtr->type != DESC_STRING )
+            // Add phone number
+            le_result_t result = le_sms_GetSenderTel(msgRef,
+                                                     msgPtr->senderTel,
+                                                     sizeof(msgPtr->senderTel));
+
+            if (result != LE_OK)
             {
-                LE_ERROR("Bad format %d", decodePtr->type);
-                res = LE_FAULT;
+                LE_ERROR("Unable to get the tel number %d", result);
             }
-
-            if (res == LE_OK)
+            else
             {
-                const char* strPtr = json_string_value((const json_t *)jsonValPtr);
+                LE_DEBUG("Tel num: %s", msgPtr->senderTel);
+                msgPtr->fields |= SMSSTORE_FIELD_SENDERTEL;
+            }
 
-                if ( strlen(strPtr) >= decodePtr->uVal.str.lenStr )
-                {
-                    LE_ERROR("String too long");
-                    res = LE_OVERFLOW;
-                }
-                else
-                {
-                    strncpy(decodePtr->uVal.str.strPtr, strPtr, decodePtr->uVal.str.lenStr);
-                    decodePtr->uVal.str.lenStr = strlen(strPtr);
-                }
+            // Add timestamp
+            result = le_sms_GetTimeStamp(msgRef, msgPtr->timestamp, sizeof(msgPtr->timestamp));
+
+            if (result != LE_OK)
+            {
+                LE_ERROR("Unable to get the timestamp %d", result);
             }
-        }
-        break;
-        case JSON_INTEGER:
-        {
-            if ( decodePtr->type != DESC_INT )
+            else
+            {
+                LE_DEBUG("Timestamp: %s", msgPtr->timestamp);
+                msgPtr->fields |= SMSSTORE_FIELD_TIMESTAMP;
+            }
+
+            msgPtr->msgLen = le_sms_GetUserdataLen(msgRef);
+
+            size_t len = sizeof(msgPtr->data);
+
+            if (format == LE_SMS_FORMAT_TEXT)
             {
-                LE_ERROR("Bad format %d", decodePtr->type);
-                res = LE_FAULT;
+                // Get text, stored without its terminating '\0'
+                result = le_sms_GetText(msgRef, (char*) msgPtr->data, len);
+                len = strnlen((char*) msgPtr->data, len);
             }
             else
             {
-                decodePtr->uVal.val = json_integer_value((const json_t *)jsonValPtr);
+                // Get binary
+                result = le_sms_GetBinary(msgRef, msgPtr->data, &len);
             }
-        }
-        break;
-        case JSON_TRUE:
-        case JSON_FALSE:
-        {
-            if ( decodePtr->type != DESC_BOOL )
+
+            if (result != LE_OK)
             {
-                LE_ERROR("Bad format %d", decodePtr->type);
-                res = LE_FAULT;
+                LE_ERROR("Unable to get payload %d", result);
+                msgPtr->msgLen = 0;
             }
             else
             {
-                decodePtr->uVal.boolVal = json_is_true((const json_t *)jsonValPtr);
+                msgPtr->dataLen = len;
+                msgPtr->fields |= SMSSTORE_FIELD_DATA;
             }
         }
         break;
-        case JSON_OBJECT:
+
+        case LE_SMS_FORMAT_PDU:
         {
-            // if key-value is an object, read the next key
-            if (nbKey >= 1)
-            {
-                json_t* jsonSubValPtr = json_object_get(jsonValPtr, keyPtr[0]);
+            msgPtr->msgLen = le_sms_GetPDULen(msgRef);
 
-                if ( jsonSubValPtr )
-                {
-                    res = ReadJsonObj(jsonSubValPtr, &keyPtr[1], nbKey-1,  decodePtr );
-                }
-                else
-                {
-                    LE_ERROR("Bad format");
-                    res = LE_FAULT;
-                }
+            // Add pdu
+            size_t len = sizeof(msgPtr->data);
+            le_result_t result = le_sms_GetPDU(msgRef, msgPtr->data, &len);
+
+            if (result != LE_OK)
+            {
+                LE_ERROR("Unable to get pdu %d", result);
+                msgPtr->msgLen = 0;
             }
             else
             {
-                LE_ERROR("Key error");
-                res = LE_FAULT;
+                msgPtr->dataLen = len;
+                msgPtr->fields |= SMSSTORE_FIELD_DATA;
+                LE_DEBUG("PDU format OK");
             }
         }
         break;
-        case JSON_ARRAY:
-        case JSON_REAL:
-        case JSON_NULL:
+        case LE_SMS_FORMAT_UNKNOWN:
         default:
-            LE_ERROR("Bad json_typeof");
-            res = LE_FAULT;
-        break;
+            LE_ERROR("Bad format %d", format);
     }
-
-    return res;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Read Application's config file
+ * Store a new message, and add it in the message box of each application
  *
+ * The oldest messages of a full message box are removed from it.
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t GetMsgListFromMbox
+static le_result_t StoreMessage
 (
-    char* pathPtr,              ///<[IN] Application's config file path
-    json_t **jsonRootObjPtr,    ///<[OUT] json root object
-    json_t **jsonArrayPtr       ///<[OUT] messages in box list
+    le_sms_MsgRef_t msgRef,     ///<[IN] SMS to be stored
+    MessageId_t *msgPtr         ///<[OUT] created messageId
 )
 {
-    json_error_t error;
-    *jsonRootObjPtr = json_load_file(pathPtr, 0, &error);
+    smsStore_Message_t message;
+    uint32_t mboxMask = 0;
+    int i;
 
-    if ( !(*jsonRootObjPtr) )
-    {
-        // File doesn't exist, create objects
-        *jsonRootObjPtr = json_object();
+    EncodeMessage(msgRef, &message);
 
-        if ( !(*jsonRootObjPtr) )
+    // For all the applications
+    for (i = 0; i < MAX_APPS; i++)
+    {
+        if ( Apps[i].namePtr && strlen(Apps[i].namePtr) && Apps[i].inboxSize )
         {
-            LE_ERROR("Json error");
-            return LE_FAULT;
-        }
-    }
+            while (smsStore_GetCount(i) >= Apps[i].inboxSize)
+            {
+                // delete older entry
+                MessageId_t messageId = smsStore_GetFirst(i);
 
-    *jsonArrayPtr = json_object_get(*jsonRootObjPtr, JSON_MSGINBOX);
+                LE_DEBUG("Remove messageId %d from %s", (int) messageId, Apps[i].namePtr);
 
-    if ( !(*jsonArrayPtr) )
-    {
-        // Array doesn't exist, create it
-        *jsonArrayPtr = json_array();
+                if (smsStore_Remove(messageId, i) != LE_OK)
+                {
+                    LE_ERROR("Can't remove entry %08x", (int) messageId);
+                    break;
+                }
+            }
 
-        if (!(*jsonArrayPtr))
-        {
-            json_decref(*jsonRootObjPtr);
-            LE_ERROR("Json error");
-            return LE_FAULT;
+            mboxMask |= (1 << i);
         }
+    }
 
-        if ( json_object_set(*jsonRootObjPtr, JSON_MSGINBOX, *jsonArrayPtr) < 0 )
-        {
-            json_decref(*jsonRootObjPtr);
-            LE_ERROR("Json error");
-            return LE_FAULT;
-        }
+    if (smsStore_Add(&message, mboxMask, msgPtr) != LE_OK)
+    {
+        LE_ERROR("Unable to store the message");
+        return LE_FAULT;
     }
 
+    LE_DEBUG("New entry: %08x", (int) *msgPtr);
+
     return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Remove a message from the application's cfg file
+ * Convert the file name string in hexa
  *
+ * @return
+ *      - Positive integer corresponding to the hexadecimal input string
+ *      - -1 in case of error
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t DeleteMsgInAppCfg
+static MessageId_t GetMessageId
 (
-    char *appNamePtr,               ///<[IN] application name
-    MessageId_t deleteMessageId     ///<[IN] message to delete
+    char* fileNamePtr  ///<[IN] file name to be converted
 )
 {
-    uint32_t pathLen = GetSMSInboxConfigPathLen(appNamePtr);
-    char path[pathLen];
-    memset(path, 0, pathLen);
-    GetSMSInboxConfigPath(appNamePtr, path, pathLen);
-    json_t *jsonObjPtr;
-    json_t *jsonArrayPtr;
-
-    LE_DEBUG("DeleteMessageId %d, path %s",deleteMessageId, path);
-
-    if (GetMsgListFromMbox(path, &jsonObjPtr, &jsonArrayPtr) != LE_OK)
-    {
-       LE_ERROR("No message");
-       return LE_FAULT;
-    }
-
-    int i;
-    MessageId_t messageId;
+    char *savePtr;
 
-    for (i=0; i < json_array_size(jsonArrayPtr); i++)
+    if(NULL != fileNamePtr)
     {
-        json_t * jsonIntegerPtr = json_array_get(jsonArrayPtr, i);
-
-        if (jsonIntegerPtr)
-        {
-            messageId = json_integer_value(jsonIntegerPtr);
+        char *str = strtok_r(fileNamePtr,".", &savePtr);
 
-            if (messageId == deleteMessageId)
-            {
-                LE_DEBUG("Remove %d", (int) messageId);
-                json_array_remove(jsonArrayPtr, i);
-            }
-        }
-        else
+        if (NULL == str)
         {
-            LE_ERROR("Json error");
+            LE_ERROR("Unable to find . in the file name");
+            return -1;
         }
+        return le_hex_HexaToInteger(str);
     }
-
-    le_result_t res = LE_OK;
-    if ( json_dump_file(jsonObjPtr, path, JSON_INDENT(1) | JSON_PRESERVE_ORDER) < 0 )
+    else
     {
-        res = LE_FAULT;
-        LE_ERROR("Json_dump_file error");
+        LE_ERROR("Provided file name pointer is NULL");
+        return -1;
     }
-
-    json_decref(jsonObjPtr);
-
-    return res;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Check if a message belongs to a message box
+ * Create a directory
  *
  */
 //--------------------------------------------------------------------------------------------------
-
-static le_result_t CheckMessageIdInMbox
+static le_result_t MkdirCreate
 (
-    char* mboxName,
-    MessageId_t messageId
+    const char* path    ///<[IN] path for directory creation
 )
 {
-    json_t *jsonRootObjPtr;
-    json_t *jsonArrayPtr;
-    uint32_t pathLen = GetSMSInboxConfigPathLen(mboxName);
-    char path[pathLen];
-    GetSMSInboxConfigPath(mboxName, path, pathLen);
-
-    if ( GetMsgListFromMbox(path, &jsonRootObjPtr, &jsonArrayPtr) != LE_OK )
-    {
-        LE_ERROR("Error in GetMsgListFromMbox");
-        return LE_FAULT;
-    }
-
-    int i = 0;
-
-    while (i < json_array_size(jsonArrayPtr))
+    int status = mkdir(path, S_IRWXU|S_IRWXG);
+    if (0 != status)
     {
-        json_t * jsonIntegerPtr = json_array_get(jsonArrayPtr, i);
-        MessageId_t msgId = 0;
-
-        if (jsonIntegerPtr)
-        {
-            msgId = json_integer_value(jsonIntegerPtr);
-        }
-        else
+        if (EEXIST != errno)
         {
-            LE_ERROR("Json error");
-            json_decref(jsonRootObjPtr);
+            LE_ERROR("Unable to create directory %s: %m", path);
             return LE_FAULT;
         }
-
-        LE_DEBUG("MessageId %d, msgId %d, i %d", messageId, msgId, i);
-        if (msgId == messageId)
-        {
-            json_decref(jsonRootObjPtr);
-            return LE_OK;
-        }
-
-        i++;
     }
-
-    LE_ERROR("Bad msg id or mbox name");
-    json_decref(jsonRootObjPtr);
-    return LE_FAULT;
+    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Decode message file
+ * Init the SMSInBox directory
  *
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t DecodeMsgEntry
+static void InitSmsInBoxDirectory
 (
-    char* mboxName,                      ///<[IN] mbox name
-    MessageId_t messageId,               ///<[IN] Message identifier to decode
-    char* keyPtr[],                      ///<[IN] Key to retrieve
-    uint8_t nbKey,                       ///<[IN] Number of elements in keyPtr
-    EntryDesc_t * decodePtr              ///<[IN/OUT] Decoding result
+    void
 )
 {
+    LE_DEBUG("InitSmsInBoxDirectory");
+
+    // create directories
+    if (LE_OK != MkdirCreate(SMSINBOX_PATH))
+    {
+        return;
+    }
+
+    // The configuration and message directories receive the files of earlier versions
     uint16_t pathLen = GetSMSInboxMessagePathLen();
     char path[pathLen];
     memset(path, 0, pathLen);
-    json_error_t error;
-    le_result_t res = LE_OK;
-
-    GetSMSInboxMessagePath(messageId, path, pathLen);
-
-    json_t* jsonRootPtr = json_load_file(path, JSON_REJECT_DUPLICATES, &error);
+    snprintf(path, pathLen, "%s%s", SMSINBOX_PATH, CONF_PATH);
 
-    if ( jsonRootPtr == NULL )
+    if (LE_OK != MkdirCreate(path))
     {
-        LE_ERROR("Json decoder error %s mboxName %s", error.text, mboxName);
-        DeleteMsgInAppCfg(mboxName, messageId);
-        return LE_FAULT;
+        return;
     }
 
-    res = ReadJsonObj(jsonRootPtr, keyPtr, nbKey, decodePtr);
-
-    json_decref(jsonRootPtr);
+    memset(path, 0, pathLen);
+    snprintf(path, pathLen, "%s%s", SMSINBOX_PATH, MSG_PATH);
 
-    return res;
+    MkdirCreate(path);
 }
 
-
 //--------------------------------------------------------------------------------------------------
 /**
- * Check if an application requested the deletion of a message
+ * Get a string of a legacy message file
  *
+ * @return true if the key exists
  */
 //--------------------------------------------------------------------------------------------------
-static bool IsDeleted
+static bool GetLegacyString
 (
-    MessageId_t messageId,  ///<[IN] Message identifier
-    char* appNamePtr        ///<[IN] Application name
+    json_t* jsonRootPtr,    ///<[IN] Json root object
+    const char* key,        ///<[IN] Key to read
+    char* strPtr,           ///<[OUT] String
+    size_t strSize          ///<[IN] String size
 )
 {
-    EntryDesc_t decode;
-    decode.type = DESC_BOOL;
-    char* key[2] = {JSON_ISDELETED, appNamePtr};
+    const char* valuePtr = json_string_value(json_object_get(jsonRootPtr, key));
 
-    if (DecodeMsgEntry(appNamePtr, messageId, key, 2, &decode) == LE_OK)
+    if (NULL == valuePtr)
     {
-        LE_DEBUG("Decode.uVal.boolVal %d", decode.uVal.boolVal);
-        return decode.uVal.boolVal;
-    }
-    else
-    {
-        // if error, delete the message
-        return true;
+        return false;
     }
-}
-
-//--------------------------------------------------------------------------------------------------
-/**
- * Perform the deleteion
- *
- */
-//--------------------------------------------------------------------------------------------------
-static void PerformDeletion
-(
-    MessageId_t messageId   ///<[IN] Message identifier
-)
-{
-    int i;
-    bool deleted = true;
 
-    for (i=0; i < MAX_APPS; i++)
+    if (le_utf8_Copy(strPtr, valuePtr, strSize, NULL) != LE_OK)
     {
-        if ( Apps[i].namePtr && (strlen(Apps[i].namePtr) != 0) )
-        {
-            deleted &= IsDeleted(messageId, Apps[i].namePtr);
-        }
+        LE_WARN("Key %s truncated", key);
     }
 
-    // All applications mark this message to be delteted => erase physically the message
-    if (deleted)
-    {
-        uint16_t pathLen = GetSMSInboxMessagePathLen();
-        char path[pathLen];
-        memset(path, 0, pathLen);
-
-        GetSMSInboxMessagePath(messageId, path, pathLen);
-
-        LE_DEBUG("Delete messageId %d, path %s",messageId, path);
-        unlink(path);
-    }
+    return true;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Add a message in the application's cfg file
+ * Import a legacy message file into the message store
  *
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t AddMsgInAppCfg
+static le_result_t ImportLegacyMessage
 (
-    MboxCtx_t* appsPtr,         ///<[IN] application config
-    MessageId_t messageId     ///<[IN] message to add
+    MessageId_t messageId,      ///<[IN] Message identifier
+    json_t* jsonRootPtr,        ///<[IN] Json root object of the message file
+    json_t* jsonArrayPtr[]      ///<[IN] Messages in box list of each application, or NULL
 )
 {
-    uint32_t pathLen = GetSMSInboxConfigPathLen(appsPtr->namePtr);
-    char path[pathLen];
-    GetSMSInboxConfigPath(appsPtr->namePtr, path, pathLen);
-    json_t* jsonMsgIdPtr = NULL;
-    json_t* jsonPtr;
-    json_t* jsonArrayPtr;
-
-    if ( GetMsgListFromMbox (path, &jsonPtr, &jsonArrayPtr) != LE_OK )
-    {
-        LE_ERROR("Message %s not found", path);
-        return LE_FAULT;
-    }
-    LE_DEBUG("Add messageId %d, path %s, array Size %zu", messageId,
-                                                          path,
-                                                          json_array_size(jsonArrayPtr) );
-
-    if ( json_array_size(jsonArrayPtr) == appsPtr->inboxSize )
-    {
-        // delete older entry
-        jsonMsgIdPtr = json_array_get(jsonArrayPtr, 0);
-        MessageId_t messageId = 0;
-
-        if (jsonMsgIdPtr)
-        {
-            messageId = json_integer_value(jsonMsgIdPtr);
-        }
+    smsStore_Message_t message;
+    uint32_t mboxMask = 0;
+    uint32_t unreadMask = 0;
+    const char* dataKeyPtr = NULL;
+    int i;
 
-        if (messageId != 0)
-        {
-            json_array_remove(jsonArrayPtr, 0);
+    memset(&message, 0, sizeof(message));
 
-            EntryDesc_t modif;
-            modif.type = DESC_BOOL;
-            modif.uVal.boolVal = true;
-            char* key[2]={JSON_ISDELETED, appsPtr->namePtr};
+    json_t* jsonValPtr = json_object_get(jsonRootPtr, JSON_FORMAT);
+    message.format = json_is_integer(jsonValPtr) ? json_integer_value(jsonValPtr)
+                                                 : LE_SMS_FORMAT_UNKNOWN;
+    message.msgLen = json_integer_value(json_object_get(jsonRootPtr, JSON_MSGLEN));
 
-            if (ModifyMsgEntry(messageId, key, 2, &modif) != LE_OK)
-            {
-                LE_ERROR("Can't modify entry %08x, path %s", (int) messageId, path);
-            }
+    GetLegacyString(jsonRootPtr, JSON_IMSI, message.imsi, sizeof(message.imsi));
 
-            PerformDeletion(messageId);
-        }
-        else
-        {
-            json_decref(jsonPtr);
-            LE_ERROR("Json error");
-            return LE_FAULT;
-        }
-    }
-
-    if (AddIntegerKeyInJsonObject(jsonArrayPtr, NULL, messageId) != LE_OK)
+    if (GetLegacyString(jsonRootPtr, JSON_SENDERTEL, message.senderTel, sizeof(message.senderTel)))
     {
-        json_decref(jsonPtr);
-        LE_ERROR("Json error");
-        return LE_FAULT;
+        message.fields |= SMSSTORE_FIELD_SENDERTEL;
     }
 
-    if ( json_dump_file(jsonPtr, path, JSON_INDENT(1) | JSON_PRESERVE_ORDER) < 0 )
+    if (GetLegacyString(jsonRootPtr, JSON_TIMESTAMP, message.timestamp, sizeof(message.timestamp)))
     {
-        json_decref(jsonPtr);
-        LE_ERROR("Json error");
-        return LE_FAULT;
+        message.fields |= SMSSTORE_FIELD_TIMESTAMP;
     }
 
-    json_decref(jsonPtr);
-
-    // Use for the first initialization
-    if (jsonArrayPtr->refcount > 0)
+    switch (message.format)
     {
-        json_decref(jsonArrayPtr);
-    }
-
-    return LE_OK;
-}
-
-
-
-//--------------------------------------------------------------------------------------------------
-/**
- * Encode Json file
- *
- */
-//--------------------------------------------------------------------------------------------------
-static le_result_t EncodeMsgEntry
-(
-    uint32_t fd,            ///<[IN] file descriptor
-    le_sms_MsgRef_t msgRef  ///<[IN] SMS to be encoding
-)
-{
-    json_t *jsonRootPtr = json_object();
-
-    if (!jsonRootPtr)
-    {
-        LE_ERROR("Json error");
-        return LE_FAULT;
+        case LE_SMS_FORMAT_TEXT:
+            dataKeyPtr = JSON_TEXT;
+            break;
+        case LE_SMS_FORMAT_BINARY:
+            dataKeyPtr = JSON_BIN;
+            break;
+        case LE_SMS_FORMAT_PDU:
+            dataKeyPtr = JSON_PDU;
+            break;
+        default:
+            break;
     }
 
-    // Add imsi in json file
-    AddStringKeyInJsonObject(jsonRootPtr, JSON_IMSI, SimImsi);
-
-    // Add sms format in json file
-    le_sms_Format_t format = le_sms_GetFormat(msgRef);
-    AddIntegerKeyInJsonObject(jsonRootPtr, JSON_FORMAT, (int) format);
+    // Payloads were converted in hexadecimal strings
+    const char* hexPtr = dataKeyPtr ? json_string_value(json_object_get(jsonRootPtr, dataKeyPtr))
+                                    : NULL;
 
-    // Unread by default for all applications
-    json_t *jsonUnreadPtr = json_object();
-    int i;
-    for (i=0; i < MAX_APPS; i++)
+    if (hexPtr)
     {
-        if ( Apps[i].namePtr && (strlen(Apps[i].namePtr) != 0) )
-        {
-            AddBooleanKeyInJsonObject(jsonUnreadPtr, Apps[i].namePtr, true);
-        }
-    }
-
-    json_object_set_new(jsonRootPtr, JSON_ISUNREAD, jsonUnreadPtr);
+        int32_t len = le_hex_StringToBinary(hexPtr, strlen(hexPtr),
+                                            message.data, sizeof(message.data));
 
-    // Undeleted by default for all applications
-    json_t *jsonDeletePtr = json_object();
-    for (i=0; i < MAX_APPS; i++)
-    {
-        if ( Apps[i].namePtr && (strlen(Apps[i].namePtr) != 0) )
+        if (len < 0)
         {
-            AddBooleanKeyInJsonObject(jsonDeletePtr, Apps[i].namePtr, false);
+            LE_ERROR("Bad payload in message %08x", (int) messageId);
         }
-    }
-
-    json_object_set_new(jsonRootPtr, JSON_ISDELETED, jsonDeletePtr);
-
-    switch ( format )
-    {
-        case LE_SMS_FORMAT_TEXT:
-        case LE_SMS_FORMAT_BINARY:
+        else
         {
-            char tel[LE_MDMDEFS_PHONE_NUM_MAX_BYTES];
-            memset(tel, 0, LE_MDMDEFS_PHONE_NUM_MAX_BYTES);
-
-            // Add phone number
-            le_result_t result = le_sms_GetSenderTel(msgRef, tel, LE_MDMDEFS_PHONE_NUM_MAX_BYTES);
-
-            if (result != LE_OK)
-            {
-                LE_ERROR("Unable to get the tel number %d", result);
-            }
-            else
-            {
-                LE_DEBUG("Tel num: %s", tel);
-                AddStringKeyInJsonObject(jsonRootPtr, JSON_SENDERTEL, tel);
-            }
-
-            // Add timestamp
-            char timeStamp[LE_SMS_TIMESTAMP_MAX_BYTES];
-            result = le_sms_GetTimeStamp (msgRef, timeStamp, LE_SMS_TIMESTAMP_MAX_BYTES);
-
-            if (result != LE_OK)
-            {
-                LE_ERROR("Unable to get the timestamp %d", result);
-            }
-            else
-            {
-                LE_DEBUG("Timestamp: %s", timeStamp);
-                AddStringKeyInJsonObject(jsonRootPtr, JSON_TIMESTAMP, timeStamp);
-            }
-
-            size_t len = le_sms_GetUserdataLen(msgRef);
-            AddIntegerKeyInJsonObject(jsonRootPtr, JSON_MSGLEN, len);
-
-            // Add a character for last '\0'
-            len++;
-
-            uint8_t bin[len];
-            memset(bin, 0, len);
-            int32_t strLen = 2*len + 1;
-            char string[strLen];
-            memset(string, 0, strLen);
-            const char* jsonKey;
-
-            if (format == LE_SMS_FORMAT_TEXT)
-            {
-                // Get text
-                result = le_sms_GetText(msgRef, (char*) bin, len);
-                jsonKey = JSON_TEXT;
-            }
-            else
-            {
-                // Get binary
-                result = le_sms_GetBinary(msgRef, bin, &len);
-                jsonKey = JSON_BIN;
-            }
-
-            if (result != LE_OK)
+            // Texts were converted with their terminating '\0'
+            if (message.format == LE_SMS_FORMAT_TEXT)
             {
-                LE_ERROR("Unable to get payload %d", result);
-                AddIntegerKeyInJsonObject(jsonRootPtr, JSON_MSGLEN, 0);
+                len = strnlen((char*) message.data, len);
             }
-            else
-            {
-                // Convert payload in string: json supports only utf-8 characters.
-                // Some extended-ASCII characters can be sent by SMS (such as character with accent)
-                // and can't be convert directly in utf-8. A convertion in string solves this issue.
-                strLen = le_hex_BinaryToString(bin, len, string, strLen);
-                AddStringKeyInJsonObject(jsonRootPtr, jsonKey, string);
 
-            }
+            message.dataLen = len;
+            message.fields |= SMSSTORE_FIELD_DATA;
         }
-        break;
+    }
 
-        case LE_SMS_FORMAT_PDU:
+    for (i = 0; i < MAX_APPS; i++)
+    {
+        if ((NULL == Apps[i].namePtr) || (NULL == jsonArrayPtr[i]))
         {
-            size_t len = le_sms_GetPDULen(msgRef);
-            AddIntegerKeyInJsonObject(jsonRootPtr, JSON_MSGLEN, len);
-            // Add a character for last '\0'
-            len++;
-            uint8_t pdu[len];
-            memset(pdu, 0, len);
-            int32_t strLen = 2*len + 1;
-            char string[strLen];
-            memset(string, 0, strLen);
+            continue;
+        }
 
-            // Add pdu
-            le_result_t result = le_sms_GetPDU(msgRef, pdu, &len);
+        size_t index;
+        bool inMbox = false;
 
-            if (result != LE_OK)
-            {
-                LE_ERROR("Unable to get pdu %d", result);
-                AddIntegerKeyInJsonObject(jsonRootPtr, JSON_MSGLEN, 0);
-            }
-            else
-            {
-                // Convert pdu in string
-                strLen = le_hex_BinaryToString(pdu, len, string, strLen);
-                AddStringKeyInJsonObject(jsonRootPtr, JSON_PDU, string);
-                LE_DEBUG("PDU format OK");
-            }
+        for (index = 0; (index < json_array_size(jsonArrayPtr[i])) && !inMbox; index++)
+        {
+            inMbox = (json_integer_value(json_array_get(jsonArrayPtr[i], index)) == messageId);
         }
-        break;
-        case LE_SMS_FORMAT_UNKNOWN:
-        default:
-            LE_ERROR("Bad format %d", format);
-    }
-
-    // Write json file in the file system
-    char* jsondumpStr = json_dumps( (const json_t *) jsonRootPtr,
-                                    JSON_INDENT(1) | JSON_PRESERVE_ORDER);
-    if (!jsondumpStr)
-    {
-        LE_ERROR("JsondumpStr is NULL");
-        return LE_FAULT;
-    }
 
-    char* restJsondumpStr = jsondumpStr;
-    ssize_t writeSize = strlen(jsondumpStr);
-    ssize_t writtenSize;
+        json_t* jsonDeletedPtr = json_object_get(jsonRootPtr, JSON_ISDELETED);
+        json_t* jsonUnreadPtr = json_object_get(jsonRootPtr, JSON_ISUNREAD);
 
-    do
-    {
-        writtenSize = write( fd, restJsondumpStr, writeSize );
-        if (writtenSize > 0)
+        if (inMbox && !json_is_true(json_object_get(jsonDeletedPtr, Apps[i].namePtr)))
         {
-            writeSize -= writtenSize;
-            restJsondumpStr += writtenSize;
+            mboxMask |= (1 << i);
+
+            if (json_is_true(json_object_get(jsonUnreadPtr, Apps[i].namePtr)))
+            {
+                unreadMask |= (1 << i);
+            }
         }
     }
-    while ((writeSize > 0) && ((writtenSize >= 0) || (EINTR == errno)));
 
-    free(jsondumpStr);
-    json_decref(jsonRootPtr);
+    if (0 == mboxMask)
+    {
+        LE_DEBUG("Message %08x deleted by all applications", (int) messageId);
+        return LE_OK;
+    }
 
-    return LE_OK;
+    return smsStore_Import(messageId, &message, mboxMask, unreadMask);
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Create a new message entry
+ * Import the message and configuration files of earlier versions into the message store
  *
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t CreateMsgEntry
+static void ImportLegacyFiles
 (
-    MessageId_t *msgPtr,    ///<[OUT] create messageId
-    int32_t *fdPtr         ///<[OUT] Created file descriptor
+    void
 )
 {
-    uint16_t pathLen = GetSMSInboxMessagePathLen();
-    char path[pathLen];
-    memset(path, 0, pathLen);
+    json_t* jsonCfgPtr[MAX_APPS] = {NULL};
+    json_t* jsonArrayPtr[MAX_APPS] = {NULL};
+    json_error_t error;
+    bool complete = true;
+    int count = 0;
+    int i;
 
-    GetSMSInboxMessagePath(NextMessageId, path, pathLen);
-    LE_DEBUG("Create entry: NextMessageId %d, path %s",NextMessageId, path);
+    // Load the messages in box list of each application
+    for (i = 0; i < MAX_APPS; i++)
+    {
+        if (Apps[i].namePtr)
+        {
+            uint32_t pathLen = GetSMSInboxConfigPathLen(Apps[i].namePtr);
+            char path[pathLen];
+            GetSMSInboxConfigPath(Apps[i].namePtr, path, pathLen);
 
-    *fdPtr = open( path, O_CREAT | O_RDWR | O_SYNC, S_IRUSR | S_IWUSR );
+            jsonCfgPtr[i] = json_load_file(path, 0, &error);
 
-    if (*fdPtr < 0)
-    {
-        LE_ERROR("No such file: %s: %m", path);
-        return LE_FAULT;
+            if (jsonCfgPtr[i])
+            {
+                jsonArrayPtr[i] = json_object_get(jsonCfgPtr[i], JSON_MSGINBOX);
+            }
+        }
     }
 
-    LE_DEBUG("New entry: %s", path);
+    uint16_t dirLen = GetSMSInboxMessagePathLen();
+    char dirPath[dirLen];
+    snprintf(dirPath, dirLen, "%s%s", SMSINBOX_PATH, MSG_PATH);
 
-    int i;
+    DIR* dirPtr = opendir(dirPath);
+    struct dirent* entryPtr;
 
-    // For all the applications
-    for (i = 0; i < MAX_APPS; i++)
+    while (dirPtr && (NULL != (entryPtr = readdir(dirPtr))))
     {
-        if ( Apps[i].namePtr && strlen(Apps[i].namePtr) )
+        size_t nameLen = strlen(entryPtr->d_name);
+        size_t extLen = strlen(FILE_EXTENSION);
+
+        if ((nameLen <= extLen) ||
+            (0 != strcmp(entryPtr->d_name + nameLen - extLen, FILE_EXTENSION)))
         {
-            AddMsgInAppCfg(&Apps[i], NextMessageId);
+            continue;
         }
-    }
-
-    *msgPtr = NextMessageId;
 
-    NextMessageId++;
+        // Message files are named with the message identifier
+        char name[nameLen + 1];
+        memcpy(name, entryPtr->d_name, nameLen + 1);
+        MessageId_t messageId = GetMessageId(name);
 
-    return LE_OK;
-}
+        if ((0 == messageId) || (-1 == messageId))
+        {
+            LE_ERROR("Unable to get the id of %s", entryPtr->d_name);
+            continue;
+        }
 
-//--------------------------------------------------------------------------------------------------
-/**
- * Convert the file name string in hexa
- *
- * @return
- *      - Positive integer corresponding to the hexadecimal input string
- *      - -1 in case of error
- */
-//--------------------------------------------------------------------------------------------------
-static MessageId_t GetMessageId
-(
-    char* fileNamePtr  ///<[IN] file name to be converted
-)
-{
-    char *savePtr;
+        uint16_t pathLen = GetSMSInboxMessagePathLen();
+        char path[pathLen];
+        GetSMSInboxMessagePath(messageId, path, pathLen);
 
-    if(NULL != fileNamePtr)
-    {
-        char *str = strtok_r(fileNamePtr,".", &savePtr);
+        json_t* jsonRootPtr = json_load_file(path, JSON_REJECT_DUPLICATES, &error);
 
-        if (NULL == str)
+        if (NULL == jsonRootPtr)
         {
-            LE_ERROR("Unable to find . in the file name");
-            return -1;
+            LE_ERROR("Json decoder error %s, path %s", error.text, path);
         }
-        return le_hex_HexaToInteger(str);
+        else
+        {
+            le_result_t res = ImportLegacyMessage(messageId, jsonRootPtr, jsonArrayPtr);
+            json_decref(jsonRootPtr);
+
+            if (res != LE_OK)
+            {
+                // Keep the file, to retry at next start-up
+                LE_ERROR("Unable to import %s", path);
+                complete = false;
+                continue;
+            }
+
+            count++;
+        }
+
+        unlink(path);
     }
-    else
+
+    if (dirPtr)
     {
-        LE_ERROR("Provided file name pointer is NULL");
-        return -1;
+        closedir(dirPtr);
     }
-}
 
-//--------------------------------------------------------------------------------------------------
-/**
- * Create a directory
- *
- */
-//--------------------------------------------------------------------------------------------------
-static le_result_t MkdirCreate
-(
-    const char* path    ///<[IN] path for directory creation
-)
-{
-    int status = mkdir(path, S_IRWXU|S_IRWXG);
-    if (0 != status)
+    for (i = 0; i < MAX_APPS; i++)
     {
-        if (EEXIST != errno)
+        if (jsonCfgPtr[i])
         {
-            LE_ERROR("Unable to create directory %s: %m", path);
-            return LE_FAULT;
+            json_decref(jsonCfgPtr[i]);
+
+            if (complete)
+            {
+                uint32_t pathLen = GetSMSInboxConfigPathLen(Apps[i].namePtr);
+                char path[pathLen];
+                GetSMSInboxConfigPath(Apps[i].namePtr, path, pathLen);
+                unlink(path);
+            }
         }
     }
-    return LE_OK;
+
+    if (count)
+    {
+        LE_INFO("%d messages imported", count);
+    }
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Init the SMSInBox directory
+ * Load the message store on first use
+ *
+ * The store is loaded when the first message box is opened or the first SMS is copied, rather than
+ * at start-up, so that the files of earlier versions put in place meanwhile are imported too.
  *
+ * @return
+ *      - LE_OK on success
+ *      - LE_FAULT the message store is unavailable
  */
 //--------------------------------------------------------------------------------------------------
-static void InitSmsInBoxDirectory
+static le_result_t LoadMessageStore
 (
     void
 )
 {
-    struct dirent **namelist;
-    uint32_t nbSmsEntries;
-
-    LE_DEBUG("InitSmsInBoxDirectory");
-
-    // create directories
-    if (LE_OK != MkdirCreate(SMSINBOX_PATH))
-    {
-        return;
-    }
-
-    uint16_t pathLen = GetSMSInboxMessagePathLen();
-    char path[pathLen];
-    memset(path, 0, pathLen);
-    snprintf(path, pathLen, "%s%s", SMSINBOX_PATH, CONF_PATH);
-
-    if (LE_OK != MkdirCreate(path))
+    if (StoreLoaded)
     {
-        return;
+        return LE_OK;
     }
 
-    memset(path, 0, pathLen);
-    snprintf(path, pathLen, "%s%s", SMSINBOX_PATH, MSG_PATH);
-
-    if (LE_OK != MkdirCreate(path))
+    if (smsStore_Open(SMSINBOX_PATH STORE_FILE, le_smsInbox_mboxName, le_smsInbox_NbMbx) != LE_OK)
     {
-        return;
+        LE_ERROR("Unable to open the message store");
+        return LE_FAULT;
     }
 
-    nbSmsEntries = scandir(path, &namelist, NULL, alphasort);
-    if ( nbSmsEntries > 2 )
-    {
-        uint8_t len = strlen(namelist[nbSmsEntries-1]->d_name);
-        char name[len+1];
-        MessageId_t id;
-
-        memset(name, 0, len+1);
-        strncpy(name, namelist[nbSmsEntries-1]->d_name, len);
-
-        id = GetMessageId(name);
-        if (-1 == id)
-        {
-            LE_ERROR("Unable to get the id of %s", name);
-            return;
-        }
-
-        NextMessageId = ++id;
-
-        LE_DEBUG("NextMessageId %d", (int) NextMessageId);
-    }
+    StoreLoaded = true;
 
-    while (nbSmsEntries--)
-    {
-        free(namelist[nbSmsEntries]);
-    }
+    ImportLegacyFiles();
 
-    free(namelist);
+    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1545,9 +1073,13 @@ static void MoveSmsFromSimToFolder
     void
 )
 {
-    int32_t fd;
     le_result_t result = LE_OK;
 
+    if (LoadMessageStore() != LE_OK)
+    {
+        return;
+    }
+
     le_sms_MsgListRef_t msgListRef = le_sms_CreateRxMsgList();
 
     if (!msgListRef)
@@ -1562,18 +1094,7 @@ static void MoveSmsFromSimToFolder
     {
         MessageId_t msgId;
 
-        result = CreateMsgEntry(&msgId, &fd);
-
-        if (result == LE_OK)
-        {
-            if ( EncodeMsgEntry(fd, smsRef) != LE_OK )
-            {
-                LE_ERROR("Encoding issue");
-            }
-
-            close(fd);
-        }
-        else
+        if (StoreMessage(smsRef, &msgId) != LE_OK)
         {
             LE_ERROR("Error during new entry creation");
         }
@@ -1602,22 +1123,16 @@ static void NewSmsMsgHandler
     void*           contextPtr
 )
 {
-    int32_t fd;
     le_result_t result;
     MessageId_t msgId;
 
     LE_DEBUG("Receive new message");
 
-    result = CreateMsgEntry(&msgId, &fd);
+    result = LoadMessageStore();
 
     if (result == LE_OK)
     {
-        result = EncodeMsgEntry(fd, msgRef);
-        close(fd);
-    }
-    else
-    {
-        LE_ERROR("CreateMsgEntry error");
+        result = StoreMessage(msgRef, &msgId);
     }
 
     if (result == LE_OK)
@@ -1630,7 +1145,7 @@ static void NewSmsMsgHandler
     }
     else
     {
-        LE_ERROR("EncodeMsgEntry error");
+        LE_ERROR("StoreMessage error");
     }
 }
 
@@ -1868,6 +1383,11 @@ SmsInbox_SessionRef_t SmsInbox_Open
         return NULL;
     }
 
+    if (LoadMessageStore() != LE_OK)
+    {
+        return NULL;
+    }
+
     int i;
 
     for (i=0; i < MAX_APPS; i++)
@@ -2040,30 +1560,19 @@ void SmsInbox_DeleteMsg
         return;
     }
 
-    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, msgId) != LE_OK)
+    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, msgId) != LE_OK)
     {
         LE_ERROR("Message not included into the mbox");
         return;
     }
 
     MessageId_t messageId = (MessageId_t) msgId;
-    EntryDesc_t modif;
-    modif.type = DESC_BOOL;
-    modif.uVal.boolVal = true;
-    char* key[2]={JSON_ISDELETED, clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr};
-
-    if (ModifyMsgEntry(messageId, key, 2, &modif) != LE_OK)
-    {
-        LE_ERROR("ModifyMsgEntry error");
-    }
 
-    if (DeleteMsgInAppCfg(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, messageId)
-                          != LE_OK)
+    if (smsStore_Remove(messageId, GetMboxIndex(clientRequestPtr->mboxSessionPtr->mboxCtxPtr))
+        != LE_OK)
     {
-        LE_ERROR("DeleteMsgInAppCfg error");
+        LE_ERROR("smsStore_Remove error");
     }
-
-    PerformDeletion(messageId);
 }
 
 
@@ -2111,7 +1620,7 @@ le_result_t SmsInbox_GetImsi
         return LE_BAD_PARAMETER;
     }
 
-    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, msgId) != LE_OK)
+    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, msgId) != LE_OK)
     {
         LE_ERROR("Message not included into the mbox");
         return LE_BAD_PARAMETER;
@@ -2127,14 +1636,14 @@ le_result_t SmsInbox_GetImsi
         return LE_OVERFLOW;
     }
 
-    EntryDesc_t decode;
-    decode.type = DESC_STRING;
-    decode.uVal.str.strPtr = imsiPtr;
-    decode.uVal.str.lenStr = imsiNumElements;
-    char* key[1] = {JSON_IMSI};
+    smsStore_Message_t message;
+
+    if ((res = ReadMsgEntry(messageId, &message)) != LE_OK)
+    {
+        return res;
+    }
 
-    if ((res = DecodeMsgEntry(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr,
-                              messageId, key, 1, &decode)) == LE_OK)
+    if ((res = GetMsgString(&message, 0, message.imsi, imsiPtr, imsiNumElements)) == LE_OK)
     {
         SmsInbox_MarkRead(sessionRef, msgId);
     }
@@ -2178,22 +1687,19 @@ le_sms_Format_t SmsInbox_GetFormat
         return 0;
     }
 
-    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, msgId) != LE_OK)
+    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, msgId) != LE_OK)
     {
         LE_ERROR("Message not included into the mbox");
         return 0;
     }
 
     MessageId_t messageId = (MessageId_t) msgId;
-    EntryDesc_t decode;
-    decode.type = DESC_INT;
-    char* key[1] = {JSON_FORMAT};
+    smsStore_Message_t message;
 
-    if (DecodeMsgEntry(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, messageId, key, 1,
-                      &decode) == LE_OK)
+    if (ReadMsgEntry(messageId, &message) == LE_OK)
     {
         SmsInbox_MarkRead(sessionRef, msgId);
-        return decode.uVal.val;
+        return message.format;
     }
     else
     {
@@ -2243,7 +1749,7 @@ le_result_t SmsInbox_GetSenderTel
         return LE_BAD_PARAMETER;
     }
 
-    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, msgId) != LE_OK)
+    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, msgId) != LE_OK)
     {
         LE_ERROR("Message not included into the mbox");
         return LE_BAD_PARAMETER;
@@ -2251,15 +1757,16 @@ le_result_t SmsInbox_GetSenderTel
 
     MessageId_t messageId = (MessageId_t) msgId;
     le_result_t res;
-    EntryDesc_t decode;
-    decode.type = DESC_STRING;
-    decode.uVal.str.strPtr = telPtr;
-    decode.uVal.str.lenStr = telNumElements;
+    smsStore_Message_t message;
     memset(telPtr, 0, telNumElements);
-    char* key[1] = {JSON_SENDERTEL};
 
-    if ((res = DecodeMsgEntry(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, messageId, key,
-                              1, &decode)) == LE_OK)
+    if ((res = ReadMsgEntry(messageId, &message)) != LE_OK)
+    {
+        return res;
+    }
+
+    if ((res = GetMsgString(&message, SMSSTORE_FIELD_SENDERTEL, message.senderTel,
+                            telPtr, telNumElements)) == LE_OK)
     {
         SmsInbox_MarkRead(sessionRef, msgId);
     }
@@ -2313,23 +1820,24 @@ le_result_t SmsInbox_GetTimeStamp
         return LE_BAD_PARAMETER;
     }
 
-    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, msgId) != LE_OK)
+    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, msgId) != LE_OK)
     {
         LE_ERROR("Message not included into the mbox");
         return LE_BAD_PARAMETER;
     }
 
     MessageId_t messageId = (MessageId_t) msgId;
-    EntryDesc_t decode;
-    decode.type = DESC_STRING;
-    decode.uVal.str.strPtr = timestampPtr;
-    decode.uVal.str.lenStr = timestampNumElements;
+    smsStore_Message_t message;
     memset(timestampPtr, 0, timestampNumElements);
-    char* key[1] = {JSON_TIMESTAMP};
     le_result_t res;
 
-    if ( (res = DecodeMsgEntry(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, messageId,
-                               key, 1, &decode)) == LE_OK )
+    if ((res = ReadMsgEntry(messageId, &message)) != LE_OK)
+    {
+        return res;
+    }
+
+    if ( (res = GetMsgString(&message, SMSSTORE_FIELD_TIMESTAMP, message.timestamp,
+                             timestampPtr, timestampNumElements)) == LE_OK )
     {
         SmsInbox_MarkRead(sessionRef, msgId);
     }
@@ -2370,28 +1878,20 @@ size_t SmsInbox_GetMsgLen
         return LE_BAD_PARAMETER;
     }
 
-    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, msgId) != LE_OK)
+    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, msgId) != LE_OK)
     {
         LE_ERROR("Message not included into the mbox");
         return LE_BAD_PARAMETER;
     }
 
     MessageId_t messageId = (MessageId_t) msgId;
+    smsStore_Message_t message;
 
-    EntryDesc_t decode;
-    decode.type = DESC_INT;
-    char* key[1] = {JSON_MSGLEN};
-    le_result_t res;
-
-    if ( (res = DecodeMsgEntry(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr,
-                                messageId,
-                                key,
-                                1,
-                                &decode)) == LE_OK )
+    if (ReadMsgEntry(messageId, &message) == LE_OK)
     {
         SmsInbox_MarkRead(sessionRef, msgId);
 
-        return decode.uVal.val;
+        return message.msgLen;
     }
     else
     {
@@ -2442,37 +1942,34 @@ le_result_t SmsInbox_GetText
         return LE_BAD_PARAMETER;
     }
 
-    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, msgId) != LE_OK)
+    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, msgId) != LE_OK)
     {
         LE_ERROR("Message not included into the mbox");
         return LE_BAD_PARAMETER;
     }
 
     MessageId_t messageId = (MessageId_t) msgId;
-    EntryDesc_t decode;
+    smsStore_Message_t message;
     le_result_t res;
-    size_t len = 2*textNumElements+1;
-    char tmpTextPtr[len];
-    memset(tmpTextPtr, 0, len);
+    size_t len;
     memset(textPtr, 0, textNumElements);
 
-    decode.type = DESC_STRING;
-    decode.uVal.str.strPtr = tmpTextPtr;
-    decode.uVal.str.lenStr = len;
-    char* key[1] = {JSON_TEXT};
+    if ((res = ReadMsgEntry(messageId, &message)) != LE_OK)
+    {
+        return res;
+    }
+
+    if (textNumElements == 0)
+    {
+        return LE_OVERFLOW;
+    }
 
-    res = DecodeMsgEntry(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, messageId, key, 1,
-                         &decode);
+    // Keep room for the terminating '\0'
+    res = GetMsgData(&message, LE_SMS_FORMAT_TEXT, (uint8_t*) textPtr, textNumElements - 1, &len);
 
     if ( res == LE_OK )
     {
-        if ( le_hex_StringToBinary(tmpTextPtr,
-                                   decode.uVal.str.lenStr,
-                                   (uint8_t*) textPtr,
-                                   textNumElements ) < 0 )
-        {
-            return LE_FAULT;
-        }
+        textPtr[len] = '\0';
 
         SmsInbox_MarkRead(sessionRef, msgId);
     }
@@ -2529,7 +2026,7 @@ le_result_t SmsInbox_GetBinary
         return LE_BAD_PARAMETER;
     }
 
-    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, msgId) != LE_OK)
+    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, msgId) != LE_OK)
     {
         LE_ERROR("Message not included into the mbox");
         return LE_BAD_PARAMETER;
@@ -2537,34 +2034,19 @@ le_result_t SmsInbox_GetBinary
 
     MessageId_t messageId = (MessageId_t) msgId;
     le_result_t res;
-    EntryDesc_t decode;
-    size_t len = 2*(*binNumElementsPtr)+1;
-    char tmpBinPtr[len];
-    memset(tmpBinPtr, 0, len);
+    smsStore_Message_t message;
     memset(binPtr, 0, *binNumElementsPtr);
 
-    decode.type = DESC_STRING;
-    decode.uVal.str.strPtr = tmpBinPtr;
-    decode.uVal.str.lenStr = len;
-    char* key[1] = {JSON_BIN};
+    if ((res = ReadMsgEntry(messageId, &message)) != LE_OK)
+    {
+        return res;
+    }
 
-    res = DecodeMsgEntry(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, messageId,
-                         key, 1, &decode);
+    res = GetMsgData(&message, LE_SMS_FORMAT_BINARY, binPtr, *binNumElementsPtr,
+                     binNumElementsPtr);
 
     if ( res == LE_OK )
     {
-        int32_t binNumElements = le_hex_StringToBinary(tmpBinPtr,
-                                                    decode.uVal.str.lenStr,
-                                                    binPtr,
-                                                    *binNumElementsPtr);
-
-        if ( binNumElements < 0 )
-        {
-            return LE_FAULT;
-        }
-
-        *binNumElementsPtr = binNumElements;
-
         SmsInbox_MarkRead(sessionRef, msgId);
     }
 
@@ -2624,7 +2106,7 @@ le_result_t SmsInbox_GetPdu
         return 0;
     }
 
-    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, msgId) != LE_OK)
+    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, msgId) != LE_OK)
     {
         LE_ERROR("Message not included into the mbox");
         return 0;
@@ -2632,34 +2114,18 @@ le_result_t SmsInbox_GetPdu
 
     MessageId_t messageId = (MessageId_t) msgId;
     le_result_t res;
-    EntryDesc_t decode;
-    size_t len = 2*(*pduNumElementsPtr)+1;
-    char tmpPduPtr[len];
-    memset(tmpPduPtr, 0, len);
+    smsStore_Message_t message;
     memset(pduPtr, 0, *pduNumElementsPtr);
 
-    decode.type = DESC_STRING;
-    decode.uVal.str.strPtr = tmpPduPtr;
-    decode.uVal.str.lenStr = len;
-    char* key[1] = {JSON_PDU};
+    if ((res = ReadMsgEntry(messageId, &message)) != LE_OK)
+    {
+        return res;
+    }
 
-    res = DecodeMsgEntry(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, messageId, key, 1,
-                         &decode);
+    res = GetMsgData(&message, LE_SMS_FORMAT_PDU, pduPtr, *pduNumElementsPtr, pduNumElementsPtr);
 
     if ( res == LE_OK )
     {
-        int32_t pduNumElements = le_hex_StringToBinary(tmpPduPtr,
-                                                    decode.uVal.str.lenStr,
-                                                    pduPtr,
-                                                    *pduNumElementsPtr);
-
-        if ( pduNumElements < 0 )
-        {
-            return LE_FAULT;
-        }
-
-        *pduNumElementsPtr = pduNumElements;
-
         SmsInbox_MarkRead(sessionRef, msgId);
     }
 
@@ -2698,75 +2164,17 @@ uint32_t SmsInbox_GetFirst
         return 0;
     }
 
-    uint32_t pathLen = GetSMSInboxConfigPathLen(clientRequestPtr->
-                                                mboxSessionPtr->mboxCtxPtr->namePtr);
-    char path[pathLen];
-    memset(path, 0, pathLen);
-    GetSMSInboxConfigPath(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, path, pathLen);
-    le_result_t res = LE_OK;
-    MessageId_t messageId=0;
-
-    if ( GetMsgListFromMbox(path,
-                        &clientRequestPtr->mboxSessionPtr->browseCtx.jsonObjPtr,
-                        &clientRequestPtr->mboxSessionPtr->browseCtx.jsonArrayPtr) != LE_OK )
-    {
-        LE_ERROR("Error in GetMsgListFromMbox");
-        return 0;
-    }
-
-    clientRequestPtr->mboxSessionPtr->browseCtx.maxIndex =
-                      json_array_size(clientRequestPtr->mboxSessionPtr->browseCtx.jsonArrayPtr);
+    BrowseCtx_t* browseCtxPtr = &clientRequestPtr->mboxSessionPtr->browseCtx;
 
-    LE_DEBUG("MaxIndex %d", clientRequestPtr->mboxSessionPtr->browseCtx.maxIndex);
-
-    if ( clientRequestPtr->mboxSessionPtr->browseCtx.maxIndex > 0 )
-    {
-        json_t * jsonIntegerPtr =
-                 json_array_get(clientRequestPtr->mboxSessionPtr->browseCtx.jsonArrayPtr, 0);
-
-        if (jsonIntegerPtr)
-        {
-            messageId = json_integer_value(jsonIntegerPtr);
-        }
-        else
-        {
-            LE_ERROR("Json error");
-            res = LE_FAULT;
-        }
+    browseCtxPtr->currentMessageId =
+                      smsStore_GetFirst(GetMboxIndex(clientRequestPtr->mboxSessionPtr->mboxCtxPtr));
 
-        if (messageId)
-        {
-            clientRequestPtr->mboxSessionPtr->browseCtx.currentMessageIndex = 1;
-        }
-        else
-        {
-            LE_ERROR("Json error");
-            res = LE_FAULT;
-        }
-    }
-    else
+    if (0 == browseCtxPtr->currentMessageId)
     {
-        res = LE_FAULT;
         LE_DEBUG("Empty mbox");
     }
 
-    if (res == LE_FAULT)
-    {
-        if (clientRequestPtr->mboxSessionPtr->browseCtx.jsonObjPtr)
-        {
-            json_decref(clientRequestPtr->mboxSessionPtr->browseCtx.jsonObjPtr);
-        }
-
-        memset(&clientRequestPtr->mboxSessionPtr->browseCtx, 0, sizeof(BrowseCtx_t));
-
-        return 0;
-    }
-    else
-    {
-        return messageId;
-    }
-
-    return 0;
+    return browseCtxPtr->currentMessageId;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -2794,60 +2202,29 @@ uint32_t SmsInbox_GetNext
         return LE_BAD_PARAMETER;
     }
 
-    while(clientRequestPtr->mboxSessionPtr->browseCtx.maxIndex !=
-          clientRequestPtr->mboxSessionPtr->browseCtx.currentMessageIndex)
+    if (clientRequestPtr->mboxSessionPtr == NULL)
     {
-        LE_DEBUG("CurrentIndex %d, maxIndex %d", clientRequestPtr->
-                                                 mboxSessionPtr->browseCtx.currentMessageIndex,
-                                                 clientRequestPtr->
-                                                 mboxSessionPtr->browseCtx.maxIndex);
-
-        json_t * jsonIntegerPtr = json_array_get(clientRequestPtr->
-                                                 mboxSessionPtr->browseCtx.jsonArrayPtr,
-                                                 clientRequestPtr->
-                                                 mboxSessionPtr->browseCtx.currentMessageIndex);
-
-        if (jsonIntegerPtr)
-        {
-            MessageId_t messageId = json_integer_value(jsonIntegerPtr);
-
-            if (messageId > 0)
-            {
-                clientRequestPtr->mboxSessionPtr->browseCtx.currentMessageIndex++;
-
-                // Check if the message exist (it may be deleted since the GetFirst call)
-                uint16_t pathLen = GetSMSInboxMessagePathLen();
-                char path[pathLen];
-                memset(path, 0, pathLen);
-                GetSMSInboxMessagePath(messageId, path, pathLen);
-                int32_t fd = open(path, O_RDWR);
+        LE_ERROR("Bad mbox reference");
+        return 0;
+    }
 
-                if (fd >= 0)
-                {
-                    // message is still existing
-                    close(fd);
-                    return messageId;
-                }
+    BrowseCtx_t* browseCtxPtr = &clientRequestPtr->mboxSessionPtr->browseCtx;
 
-                // else continue the parsing
-            }
-            else
-            {
-                LE_ERROR("Json error");
-            }
-        }
-        else
-        {
-            LE_ERROR("Json error");
-        }
+    if (browseCtxPtr->currentMessageId)
+    {
+        // The current message may have been deleted since: the store returns the message
+        // following it anyway
+        browseCtxPtr->currentMessageId =
+                  smsStore_GetNext(GetMboxIndex(clientRequestPtr->mboxSessionPtr->mboxCtxPtr),
+                                   browseCtxPtr->currentMessageId);
     }
 
-    // Parsing end => free the memory
-    LE_DEBUG("No more messages");
-    json_decref(clientRequestPtr->mboxSessionPtr->browseCtx.jsonObjPtr);
-    memset(&clientRequestPtr->mboxSessionPtr->browseCtx, 0, sizeof(BrowseCtx_t));
+    if (0 == browseCtxPtr->currentMessageId)
+    {
+        LE_DEBUG("No more messages");
+    }
 
-    return 0;
+    return browseCtxPtr->currentMessageId;
 }
 //--------------------------------------------------------------------------------------------------
 /**
@@ -2886,27 +2263,15 @@ bool SmsInbox_IsUnread
         return LE_BAD_PARAMETER;
     }
 
-    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, msgId) != LE_OK)
+    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, msgId) != LE_OK)
     {
         LE_ERROR("Message not included into the mbox");
         return LE_BAD_PARAMETER;
     }
 
     MessageId_t messageId = (MessageId_t) msgId;
-    EntryDesc_t decode;
-    decode.type = DESC_BOOL;
-    char* key[] = {JSON_ISUNREAD, clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr};
 
-    if (DecodeMsgEntry(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, messageId, key, 2,
-                       &decode) == LE_OK)
-    {
-        return decode.uVal.boolVal;
-    }
-    else
-    {
-        LE_ERROR("Error in DecodeMsgEntry");
-        return false;
-    }
+    return smsStore_IsUnread(messageId, GetMboxIndex(clientRequestPtr->mboxSessionPtr->mboxCtxPtr));
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -2941,21 +2306,18 @@ void SmsInbox_MarkRead
         return;
     }
 
-    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, msgId) != LE_OK)
+    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, msgId) != LE_OK)
     {
         LE_ERROR("Message not included into the mbox");
         return;
     }
 
     MessageId_t messageId = (MessageId_t) msgId;
-    EntryDesc_t modif;
-    modif.type = DESC_BOOL;
-    modif.uVal.boolVal = false;
-    char* key[2]={JSON_ISUNREAD, clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr};
 
-    if (ModifyMsgEntry(messageId, key, 2, &modif) != LE_OK)
+    if (smsStore_SetUnread(messageId, GetMboxIndex(clientRequestPtr->mboxSessionPtr->mboxCtxPtr),
+                           false) != LE_OK)
     {
-        LE_ERROR("Error in ModifyMsgEntry");
+        LE_ERROR("Error in smsStore_SetUnread");
     }
 }
 
@@ -2991,21 +2353,18 @@ void SmsInbox_MarkUnread
         return;
     }
 
-    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, msgId) != LE_OK)
+    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, msgId) != LE_OK)
     {
         LE_ERROR("Message not included into the mbox");
         return;
     }
 
     MessageId_t messageId = (MessageId_t) msgId;
-    EntryDesc_t modif;
-    modif.type = DESC_BOOL;
-    modif.uVal.boolVal = true;
-    char* key[2]={JSON_ISUNREAD, clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr};
 
-    if (ModifyMsgEntry(messageId, key, 2, &modif) != LE_OK)
+    if (smsStore_SetUnread(messageId, GetMboxIndex(clientRequestPtr->mboxSessionPtr->mboxCtxPtr),
+                           true) != LE_OK)
     {
-        LE_ERROR("Error in ModifyMsgEntry");
+        LE_ERROR("Error in smsStore_SetUnread");
     }
 }
 
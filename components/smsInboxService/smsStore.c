@@ -0,0 +1,1465 @@
+/**
+ * @file smsStore.c
+ *
+ * Message store of the SMS Inbox service.
+ *
+ * The messages are kept in an append-only log. A record of the log holds either a whole message or
+ * an update of the message boxes holding a message and of its unread flags, the last record of a
+ * message giving its current state. A message held by no message box anymore is deleted.
+ *
+ * The log is read back once when the store is opened to build an index in memory: a hashmap gives
+ * the offset of the message record and the current flags of each message, and a list keeps the
+ * messages in identifier order, which is their arrival order. Browsing a message box, marking a
+ * message or deleting it only uses the index and appends a small record; the log is read only to
+ * get the content of a message.
+ *
+ * The records of deleted messages and the superseded updates are dropped by compacting the log: the
+ * live messages are copied, with their current flags, into a new log which then replaces the old
+ * one. The compaction is run a few seconds after the obsolete records outweigh the live ones.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+#include "smsStore.h"
+
+//--------------------------------------------------------------------------------------------------
+// Symbols and enums.
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Log magic number ("SMS1").
+ */
+//--------------------------------------------------------------------------------------------------
+#define LOG_MAGIC                   0x31534D53
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Suffix of the log written by a compaction.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LOG_TMP_SUFFIX              ".tmp"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum length of a message box name in the log header.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MBOX_NAME_MAX_BYTES         32
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record types.
+ */
+//--------------------------------------------------------------------------------------------------
+#define RECORD_MESSAGE              1   ///< Whole message.
+#define RECORD_FLAGS                2   ///< Message boxes and unread flags of a message.
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Length of a message record payload without data.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MESSAGE_HEADER_BYTES        offsetof(smsStore_Message_t, data)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initial size of the index.
+ */
+//--------------------------------------------------------------------------------------------------
+#define INDEX_CAPACITY              1024
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Obsolete bytes of the log above which it is compacted, if they also outweigh the live ones.
+ */
+//--------------------------------------------------------------------------------------------------
+#define COMPACTION_MIN_GARBAGE      (64 * 1024)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delay before compacting the log, so that a burst of deletions leads to a single compaction.
+ */
+//--------------------------------------------------------------------------------------------------
+#define COMPACTION_DELAY_MS         5000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the buffer the compacted log is written from.
+ */
+//--------------------------------------------------------------------------------------------------
+#define COMPACTION_BUFFER_BYTES     (16 * 1024)
+
+//--------------------------------------------------------------------------------------------------
+// Data structures.
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Log header.
+ *
+ * The message boxes are designated by a bit in the records; the header keeps the name of the message
+ * box of each bit, so that the records still apply if the table of message boxes changes.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t    magic;                                          ///< LOG_MAGIC.
+    uint32_t    nextMsgId;                                      ///< Next message identifier.
+    char        mboxName[SMSSTORE_MBOX_MAX][MBOX_NAME_MAX_BYTES]; ///< Message box of each bit.
+}
+LogHeader_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record header.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t    crc;        ///< CRC32 of the rest of the record.
+    uint32_t    msgId;      ///< Message identifier.
+    uint16_t    mboxMask;   ///< Message boxes holding the message.
+    uint16_t    unreadMask; ///< Message boxes where the message is unread.
+    uint16_t    type;       ///< Record type.
+    uint16_t    length;     ///< Payload length.
+}
+RecordHeader_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    RecordHeader_t  header;                                 ///< Record header.
+    uint8_t         payload[sizeof(smsStore_Message_t)];    ///< Message, for RECORD_MESSAGE.
+}
+Record_t;
+
+static_assert(SMSSTORE_MBOX_MAX <= 16, "Message box masks are 16-bit");
+static_assert(sizeof(smsStore_Message_t) <= UINT16_MAX, "Record length is 16-bit");
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Index entry of a message.
+ *
+ * A deleted message keeps its entry, without any message box, until the next compaction.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t        msgId;      ///< Message identifier, key of the index.
+    uint32_t        offset;     ///< Offset of the message record in the log.
+    uint16_t        length;     ///< Payload length of the message record.
+    uint16_t        mboxMask;   ///< Message boxes holding the message.
+    uint16_t        unreadMask; ///< Message boxes where the message is unread.
+    le_dls_Link_t   link;       ///< Link in the list of messages, in identifier order.
+}
+Entry_t;
+
+//--------------------------------------------------------------------------------------------------
+// Static declarations.
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Log file path and descriptor.
+ */
+//--------------------------------------------------------------------------------------------------
+static char LogPath[PATH_MAX - sizeof(LOG_TMP_SUFFIX)];
+static int  LogFd = -1;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Log size, and bytes of the message records of the messages which are not deleted.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t LogSize;
+static uint32_t LiveSize;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Next message identifier.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t NextMsgId = 1;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Message boxes names and number of messages.
+ */
+//--------------------------------------------------------------------------------------------------
+static char     MboxName[SMSSTORE_MBOX_MAX][MBOX_NAME_MAX_BYTES];
+static uint8_t  MboxCount;
+static uint32_t MboxMsgCount[SMSSTORE_MBOX_MAX];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Index: entries by message identifier, and list of the entries in identifier order.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t EntryPool;
+static le_hashmap_Ref_t EntryMap;
+static le_dls_List_t    EntryList = LE_DLS_LIST_INIT;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Timer delaying the compaction.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_timer_Ref_t CompactionTimer;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute the CRC of a record.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t ComputeCrc
+(
+    const Record_t* recordPtr   ///< [IN] Record.
+)
+{
+    uint32_t crc = le_crc_Crc32((uint8_t*)&recordPtr->header.msgId,
+                                sizeof(RecordHeader_t) - offsetof(RecordHeader_t, msgId),
+                                LE_CRC_START_CRC32);
+
+    return le_crc_Crc32((uint8_t*)recordPtr->payload, recordPtr->header.length, crc);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the entry of a message.
+ *
+ * @return The entry, NULL if the message is not in the index.
+ */
+//--------------------------------------------------------------------------------------------------
+static Entry_t* FindEntry
+(
+    uint32_t msgId  ///< [IN] Message identifier.
+)
+{
+    return le_hashmap_Get(EntryMap, &msgId);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the entry of a message held by a message box.
+ *
+ * @return The entry, NULL if the message box does not hold the message.
+ */
+//--------------------------------------------------------------------------------------------------
+static Entry_t* FindMboxEntry
+(
+    uint32_t    msgId,  ///< [IN] Message identifier.
+    uint8_t     mbox    ///< [IN] Message box.
+)
+{
+    if (mbox >= MboxCount)
+    {
+        return NULL;
+    }
+
+    Entry_t* entryPtr = FindEntry(msgId);
+
+    if ((NULL == entryPtr) || !(entryPtr->mboxMask & (1 << mbox)))
+    {
+        return NULL;
+    }
+
+    return entryPtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create the entry of a message, and insert it in the index.
+ */
+//--------------------------------------------------------------------------------------------------
+static Entry_t* CreateEntry
+(
+    uint32_t msgId  ///< [IN] Message identifier.
+)
+{
+    Entry_t* entryPtr = le_mem_ForceAlloc(EntryPool);
+    memset(entryPtr, 0, sizeof(Entry_t));
+    entryPtr->msgId = msgId;
+    entryPtr->link = LE_DLS_LINK_INIT;
+
+    // Messages are nearly always created in identifier order: look for the place from the tail.
+    le_dls_Link_t* linkPtr = le_dls_PeekTail(&EntryList);
+
+    while ((NULL != linkPtr) && (CONTAINER_OF(linkPtr, Entry_t, link)->msgId > msgId))
+    {
+        linkPtr = le_dls_PeekPrev(&EntryList, linkPtr);
+    }
+
+    if (NULL != linkPtr)
+    {
+        le_dls_AddAfter(&EntryList, linkPtr, &entryPtr->link);
+    }
+    else
+    {
+        le_dls_Stack(&EntryList, &entryPtr->link);
+    }
+
+    le_hashmap_Put(EntryMap, &entryPtr->msgId, entryPtr);
+
+    return entryPtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove the entry of a message from the index.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DeleteEntry
+(
+    Entry_t* entryPtr   ///< [IN] Entry.
+)
+{
+    le_hashmap_Remove(EntryMap, &entryPtr->msgId);
+    le_dls_Remove(&EntryList, &entryPtr->link);
+    le_mem_Release(entryPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the flags of a message, and update the message box counters and the live log size.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SetFlags
+(
+    Entry_t*    entryPtr,   ///< [IN] Entry.
+    uint16_t    mboxMask,   ///< [IN] Message boxes holding the message.
+    uint16_t    unreadMask  ///< [IN] Message boxes where the message is unread.
+)
+{
+    uint16_t changedMask = entryPtr->mboxMask ^ mboxMask;
+    uint8_t mbox;
+
+    for (mbox = 0; changedMask; mbox++, changedMask >>= 1)
+    {
+        if (changedMask & 1)
+        {
+            if (mboxMask & (1 << mbox))
+            {
+                MboxMsgCount[mbox]++;
+            }
+            else
+            {
+                MboxMsgCount[mbox]--;
+            }
+        }
+    }
+
+    uint32_t recordSize = sizeof(RecordHeader_t) + entryPtr->length;
+
+    if (entryPtr->mboxMask && !mboxMask)
+    {
+        LiveSize -= recordSize;
+    }
+    else if (!entryPtr->mboxMask && mboxMask)
+    {
+        LiveSize += recordSize;
+    }
+
+    entryPtr->mboxMask = mboxMask;
+    entryPtr->unreadMask = unreadMask & mboxMask;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compaction timer handler.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CompactionTimerHandler
+(
+    le_timer_Ref_t timerRef ///< [IN] Timer.
+)
+{
+    smsStore_Compact();
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start the compaction timer if the obsolete records outweigh the live ones.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ScheduleCompaction
+(
+    void
+)
+{
+    uint32_t garbage = LogSize - sizeof(LogHeader_t) - LiveSize;
+
+    if ((garbage >= COMPACTION_MIN_GARBAGE) && (garbage > LiveSize) &&
+        !le_timer_IsRunning(CompactionTimer))
+    {
+        LE_DEBUG("%"PRIu32" obsolete bytes in the log", garbage);
+        le_timer_Start(CompactionTimer);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write a buffer to a file.
+ *
+ * @return
+ *  - LE_OK            The buffer is written.
+ *  - LE_FAULT         The buffer cannot be written.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t WriteAll
+(
+    int         fd,         ///< [IN] File descriptor.
+    const void* bufferPtr,  ///< [IN] Buffer.
+    size_t      size        ///< [IN] Buffer size.
+)
+{
+    const uint8_t* bytePtr = bufferPtr;
+
+    while (size > 0)
+    {
+        ssize_t written = write(fd, bytePtr, size);
+
+        if (written < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+
+            LE_ERROR("Cannot write %s: %m", LogPath);
+            return LE_FAULT;
+        }
+
+        bytePtr += written;
+        size -= written;
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Flush the directory of the log, so a log created or renamed in it survives a power loss.
+ *
+ * @return
+ *  - LE_OK            The directory is flushed.
+ *  - LE_FAULT         The directory cannot be flushed.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t SyncLogDir
+(
+    void
+)
+{
+    char dirPath[sizeof(LogPath)];
+
+    le_utf8_Copy(dirPath, LogPath, sizeof(dirPath), NULL);
+
+    char* separatorPtr = strrchr(dirPath, '/');
+
+    if (NULL == separatorPtr)
+    {
+        le_utf8_Copy(dirPath, ".", sizeof(dirPath), NULL);
+    }
+    else
+    {
+        // Keep the separator of the root directory
+        separatorPtr[(separatorPtr == dirPath) ? 1 : 0] = '\0';
+    }
+
+    int fd = open(dirPath, O_RDONLY | O_DIRECTORY);
+
+    if ((fd < 0) || (0 != fsync(fd)))
+    {
+        LE_ERROR("Cannot flush %s: %m", dirPath);
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        return LE_FAULT;
+    }
+
+    close(fd);
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fill in the log header.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FillHeader
+(
+    LogHeader_t* headerPtr  ///< [OUT] Log header.
+)
+{
+    memset(headerPtr, 0, sizeof(LogHeader_t));
+    headerPtr->magic = LOG_MAGIC;
+    headerPtr->nextMsgId = NextMsgId;
+    memcpy(headerPtr->mboxName, MboxName, sizeof(MboxName));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a record to the log.
+ *
+ * The header of the record is filled in, except for its identifier. A message record is flushed to
+ * the storage, as the message is deleted from the SIM once stored.
+ *
+ * @return
+ *  - LE_OK            The record is written.
+ *  - LE_FAULT         The record cannot be written, the log is unchanged.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t AppendRecord
+(
+    Record_t*   recordPtr,  ///< [IN] Record, the header being filled in.
+    uint16_t    type,       ///< [IN] Record type.
+    uint16_t    length,     ///< [IN] Payload length.
+    uint16_t    mboxMask,   ///< [IN] Message boxes holding the message.
+    uint16_t    unreadMask, ///< [IN] Message boxes where the message is unread.
+    uint32_t*   offsetPtr   ///< [OUT] Offset of the record in the log.
+)
+{
+    recordPtr->header.type = type;
+    recordPtr->header.length = length;
+    recordPtr->header.mboxMask = mboxMask;
+    recordPtr->header.unreadMask = unreadMask & mboxMask;
+    recordPtr->header.crc = ComputeCrc(recordPtr);
+
+    size_t size = sizeof(RecordHeader_t) + length;
+
+    if ((LE_OK != WriteAll(LogFd, recordPtr, size)) ||
+        ((RECORD_MESSAGE == type) && (0 != fdatasync(LogFd))))
+    {
+        // Drop a partially written record, so that the following ones can be read back
+        if (0 != ftruncate(LogFd, LogSize))
+        {
+            LE_ERROR("Cannot truncate %s: %m", LogPath);
+        }
+        return LE_FAULT;
+    }
+
+    *offsetPtr = LogSize;
+    LogSize += size;
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a flags record to the log, and apply it to the index.
+ *
+ * @return
+ *  - LE_OK            The flags are changed.
+ *  - LE_FAULT         The record cannot be written.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t WriteFlags
+(
+    Entry_t*    entryPtr,   ///< [IN] Entry.
+    uint16_t    mboxMask,   ///< [IN] Message boxes holding the message.
+    uint16_t    unreadMask  ///< [IN] Message boxes where the message is unread.
+)
+{
+    Record_t record;
+    uint32_t offset;
+
+    record.header.msgId = entryPtr->msgId;
+
+    if (LE_OK != AppendRecord(&record, RECORD_FLAGS, 0, mboxMask, unreadMask, &offset))
+    {
+        return LE_FAULT;
+    }
+
+    SetFlags(entryPtr, mboxMask, unreadMask);
+    ScheduleCompaction();
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a message record to the log, and add it to the index or replace the indexed one.
+ *
+ * @return
+ *  - LE_OK            The message is written.
+ *  - LE_BAD_PARAMETER The message is invalid.
+ *  - LE_FAULT         The record cannot be written.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t WriteMessage
+(
+    uint32_t                    msgId,      ///< [IN] Message identifier.
+    const smsStore_Message_t*   msgPtr,     ///< [IN] Message.
+    uint16_t                    mboxMask,   ///< [IN] Message boxes holding the message.
+    uint16_t                    unreadMask  ///< [IN] Message boxes where the message is unread.
+)
+{
+    if (msgPtr->dataLen > SMSSTORE_DATA_MAX_BYTES)
+    {
+        LE_ERROR("Message %"PRIu32" too long: %"PRIu32" bytes", msgId, msgPtr->dataLen);
+        return LE_BAD_PARAMETER;
+    }
+
+    Record_t record;
+    uint16_t length = MESSAGE_HEADER_BYTES + msgPtr->dataLen;
+    uint32_t offset;
+
+    record.header.msgId = msgId;
+    memcpy(record.payload, msgPtr, length);
+
+    if (LE_OK != AppendRecord(&record, RECORD_MESSAGE, length, mboxMask, unreadMask, &offset))
+    {
+        return LE_FAULT;
+    }
+
+    Entry_t* entryPtr = FindEntry(msgId);
+
+    if (NULL != entryPtr)
+    {
+        // The previous message record becomes obsolete
+        SetFlags(entryPtr, 0, 0);
+    }
+    else
+    {
+        entryPtr = CreateEntry(msgId);
+    }
+
+    entryPtr->offset = offset;
+    entryPtr->length = length;
+    SetFlags(entryPtr, mboxMask, unreadMask);
+    ScheduleCompaction();
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create an empty log.
+ *
+ * @return
+ *  - LE_OK            The log is created.
+ *  - LE_FAULT         The log cannot be created.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t CreateLog
+(
+    void
+)
+{
+    LogHeader_t header;
+
+    LogFd = open(LogPath, O_RDWR | O_CREAT | O_TRUNC | O_APPEND, S_IRUSR | S_IWUSR);
+    if (LogFd < 0)
+    {
+        LE_ERROR("Cannot create %s: %m", LogPath);
+        return LE_FAULT;
+    }
+
+    FillHeader(&header);
+
+    if ((LE_OK != WriteAll(LogFd, &header, sizeof(header))) || (0 != fdatasync(LogFd)))
+    {
+        close(LogFd);
+        LogFd = -1;
+        return LE_FAULT;
+    }
+
+    LogSize = sizeof(header);
+
+    // An empty log is created again if it is lost, so the new entry is not required to be flushed.
+    SyncLogDir();
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a record from the log being loaded.
+ *
+ * @return
+ *  - LE_OK            The record is read.
+ *  - LE_NOT_FOUND     The end of the log is reached.
+ *  - LE_FORMAT_ERROR  The record is invalid, or partially written.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReadRecord
+(
+    FILE*       filePtr,    ///< [IN] Log.
+    Record_t*   recordPtr   ///< [OUT] Record.
+)
+{
+    size_t size = fread(&recordPtr->header, 1, sizeof(RecordHeader_t), filePtr);
+
+    if (0 == size)
+    {
+        return LE_NOT_FOUND;
+    }
+
+    if (sizeof(RecordHeader_t) != size)
+    {
+        return LE_FORMAT_ERROR;
+    }
+
+    uint16_t length = recordPtr->header.length;
+
+    switch (recordPtr->header.type)
+    {
+        case RECORD_MESSAGE:
+            if ((length < MESSAGE_HEADER_BYTES) || (length > sizeof(recordPtr->payload)))
+            {
+                return LE_FORMAT_ERROR;
+            }
+            break;
+
+        case RECORD_FLAGS:
+            if (0 != length)
+            {
+                return LE_FORMAT_ERROR;
+            }
+            break;
+
+        default:
+            return LE_FORMAT_ERROR;
+    }
+
+    if ((0 == recordPtr->header.msgId) ||
+        (fread(recordPtr->payload, 1, length, filePtr) != length) ||
+        (ComputeCrc(recordPtr) != recordPtr->header.crc))
+    {
+        return LE_FORMAT_ERROR;
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert the message boxes of a record to the current table of message boxes.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint16_t RemapMask
+(
+    uint16_t        mask,       ///< [IN] Message boxes of the record.
+    const uint16_t* remapPtr    ///< [IN] Current mask of each message box of the log.
+)
+{
+    uint16_t remapped = 0;
+    uint8_t bit;
+
+    for (bit = 0; mask; bit++, mask >>= 1)
+    {
+        if (mask & 1)
+        {
+            remapped |= remapPtr[bit];
+        }
+    }
+
+    return remapped;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Load the log, and build the index.
+ *
+ * @return
+ *  - LE_OK            The log is loaded.
+ *  - LE_FAULT         The log cannot be loaded.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t LoadLog
+(
+    void
+)
+{
+    FILE* filePtr = fopen(LogPath, "r");
+
+    if (NULL == filePtr)
+    {
+        if (ENOENT != errno)
+        {
+            LE_ERROR("Cannot open %s: %m", LogPath);
+            return LE_FAULT;
+        }
+
+        return CreateLog();
+    }
+
+    LogHeader_t header;
+
+    if ((fread(&header, sizeof(header), 1, filePtr) != 1) || (LOG_MAGIC != header.magic))
+    {
+        LE_ERROR("Invalid log %s, creating a new one", LogPath);
+        fclose(filePtr);
+        return CreateLog();
+    }
+
+    // Map the message boxes of the log to the current ones
+    uint16_t remap[SMSSTORE_MBOX_MAX];
+    bool mboxChanged = false;
+    int bit;
+    int mbox;
+
+    for (bit = 0; bit < SMSSTORE_MBOX_MAX; bit++)
+    {
+        header.mboxName[bit][MBOX_NAME_MAX_BYTES - 1] = '\0';
+        remap[bit] = 0;
+
+        if (0 != strcmp(header.mboxName[bit], MboxName[bit]))
+        {
+            mboxChanged = true;
+        }
+
+        for (mbox = 0; (mbox < MboxCount) && ('\0' != header.mboxName[bit][0]); mbox++)
+        {
+            if (0 == strcmp(header.mboxName[bit], MboxName[mbox]))
+            {
+                remap[bit] = 1 << mbox;
+                break;
+            }
+        }
+    }
+
+    NextMsgId = header.nextMsgId;
+
+    Record_t record;
+    uint32_t offset = sizeof(header);
+    le_result_t result;
+
+    while (LE_OK == (result = ReadRecord(filePtr, &record)))
+    {
+        Entry_t* entryPtr = FindEntry(record.header.msgId);
+        uint16_t mboxMask = record.header.mboxMask;
+        uint16_t unreadMask = record.header.unreadMask;
+
+        if (mboxChanged)
+        {
+            mboxMask = RemapMask(mboxMask, remap);
+            unreadMask = RemapMask(unreadMask, remap);
+        }
+
+        if (RECORD_MESSAGE == record.header.type)
+        {
+            if (NULL == entryPtr)
+            {
+                entryPtr = CreateEntry(record.header.msgId);
+            }
+
+            entryPtr->offset = offset;
+            entryPtr->length = record.header.length;
+        }
+
+        // The counters are computed once the whole log is loaded
+        if (NULL != entryPtr)
+        {
+            entryPtr->mboxMask = mboxMask;
+            entryPtr->unreadMask = unreadMask & mboxMask;
+        }
+
+        if (record.header.msgId >= NextMsgId)
+        {
+            NextMsgId = record.header.msgId + 1;
+        }
+
+        offset += sizeof(RecordHeader_t) + record.header.length;
+    }
+
+    fclose(filePtr);
+
+    LogFd = open(LogPath, O_RDWR | O_APPEND);
+    if (LogFd < 0)
+    {
+        LE_ERROR("Cannot open %s: %m", LogPath);
+        return LE_FAULT;
+    }
+
+    if (LE_FORMAT_ERROR == result)
+    {
+        LE_WARN("Invalid record at offset %"PRIu32" of %s, dropping the end of the log",
+                offset, LogPath);
+
+        if (0 != ftruncate(LogFd, offset))
+        {
+            LE_ERROR("Cannot truncate %s: %m", LogPath);
+        }
+    }
+
+    LogSize = offset;
+
+    // Drop the deleted messages and count the messages of each message box
+    le_dls_Link_t* linkPtr = le_dls_Peek(&EntryList);
+
+    while (NULL != linkPtr)
+    {
+        Entry_t* entryPtr = CONTAINER_OF(linkPtr, Entry_t, link);
+        uint16_t mboxMask = entryPtr->mboxMask;
+
+        linkPtr = le_dls_PeekNext(&EntryList, linkPtr);
+
+        if (0 == mboxMask)
+        {
+            DeleteEntry(entryPtr);
+            continue;
+        }
+
+        entryPtr->mboxMask = 0;
+        SetFlags(entryPtr, mboxMask, entryPtr->unreadMask);
+    }
+
+    LE_INFO("%zu messages loaded from %s", le_hashmap_Size(EntryMap), LogPath);
+
+    // Rewrite the log so that its header matches the current message boxes
+    if (mboxChanged && (LE_OK != smsStore_Compact()))
+    {
+        smsStore_Close();
+        return LE_FAULT;
+    }
+
+    ScheduleCompaction();
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open the store, creating its log if needed.
+ *
+ * The log is read back to build the index. A record partially written when the device went down
+ * is discarded.
+ *
+ * @return
+ *  - LE_OK            The store is open.
+ *  - LE_FAULT         The log cannot be opened or created.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t smsStore_Open
+(
+    const char*         pathPtr,        ///< [IN] Log file path.
+    const char* const*  mboxNamePtr,    ///< [IN] Message box names.
+    uint8_t             mboxCount       ///< [IN] Number of message boxes.
+)
+{
+    LE_ASSERT(LogFd < 0);
+    LE_ASSERT(mboxCount <= SMSSTORE_MBOX_MAX);
+
+    if (LE_OK != le_utf8_Copy(LogPath, pathPtr, sizeof(LogPath), NULL))
+    {
+        LE_ERROR("Log path too long: %s", pathPtr);
+        return LE_FAULT;
+    }
+
+    if (NULL == EntryPool)
+    {
+        EntryPool = le_mem_CreatePool("SmsStoreEntryPool", sizeof(Entry_t));
+        EntryMap = le_hashmap_Create("SmsStoreIndex", INDEX_CAPACITY,
+                                     le_hashmap_HashUInt32, le_hashmap_EqualsUInt32);
+
+        CompactionTimer = le_timer_Create("SmsStoreCompaction");
+        le_timer_SetMsInterval(CompactionTimer, COMPACTION_DELAY_MS);
+        le_timer_SetHandler(CompactionTimer, CompactionTimerHandler);
+    }
+
+    memset(MboxName, 0, sizeof(MboxName));
+
+    for (MboxCount = 0; MboxCount < mboxCount; MboxCount++)
+    {
+        // A truncated name still designates the same message box
+        le_utf8_Copy(MboxName[MboxCount], mboxNamePtr[MboxCount], MBOX_NAME_MAX_BYTES, NULL);
+    }
+
+    return LoadLog();
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close the store and release its index.
+ */
+//--------------------------------------------------------------------------------------------------
+void smsStore_Close
+(
+    void
+)
+{
+    if (LogFd < 0)
+    {
+        return;
+    }
+
+    le_timer_Stop(CompactionTimer);
+    close(LogFd);
+    LogFd = -1;
+
+    le_hashmap_RemoveAll(EntryMap);
+
+    le_dls_Link_t* linkPtr;
+
+    while (NULL != (linkPtr = le_dls_Pop(&EntryList)))
+    {
+        le_mem_Release(CONTAINER_OF(linkPtr, Entry_t, link));
+    }
+
+    LogSize = 0;
+    LiveSize = 0;
+    NextMsgId = 1;
+    memset(MboxMsgCount, 0, sizeof(MboxMsgCount));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a new message to message boxes, as unread.
+ *
+ * @return
+ *  - LE_OK            The message is added.
+ *  - LE_FAULT         The message cannot be written.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t smsStore_Add
+(
+    const smsStore_Message_t*   msgPtr,     ///< [IN] Message.
+    uint32_t                    mboxMask,   ///< [IN] Message boxes holding the message.
+    uint32_t*                   msgIdPtr    ///< [OUT] Identifier given to the message.
+)
+{
+    if (0 == NextMsgId)
+    {
+        NextMsgId = 1;
+    }
+
+    if (LE_OK != WriteMessage(NextMsgId, msgPtr, mboxMask, mboxMask))
+    {
+        return LE_FAULT;
+    }
+
+    *msgIdPtr = NextMsgId++;
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Import a message with a given identifier, replacing the message with the same identifier if any.
+ *
+ * @return
+ *  - LE_OK            The message is imported.
+ *  - LE_BAD_PARAMETER The identifier is invalid.
+ *  - LE_FAULT         The message cannot be written.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t smsStore_Import
+(
+    uint32_t                    msgId,      ///< [IN] Message identifier.
+    const smsStore_Message_t*   msgPtr,     ///< [IN] Message.
+    uint32_t                    mboxMask,   ///< [IN] Message boxes holding the message.
+    uint32_t                    unreadMask  ///< [IN] Message boxes where it is unread.
+)
+{
+    if (0 == msgId)
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    le_result_t result = WriteMessage(msgId, msgPtr, mboxMask, unreadMask);
+
+    if ((LE_OK == result) && (msgId >= NextMsgId))
+    {
+        NextMsgId = msgId + 1;
+    }
+
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a message.
+ *
+ * @return
+ *  - LE_OK            The message is read.
+ *  - LE_NOT_FOUND     The message does not exist.
+ *  - LE_FAULT         The message cannot be read.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t smsStore_Read
+(
+    uint32_t            msgId,      ///< [IN] Message identifier.
+    smsStore_Message_t* msgPtr      ///< [OUT] Message.
+)
+{
+    Entry_t* entryPtr = FindEntry(msgId);
+
+    if ((NULL == entryPtr) || (0 == entryPtr->mboxMask))
+    {
+        return LE_NOT_FOUND;
+    }
+
+    Record_t record;
+    ssize_t size = sizeof(RecordHeader_t) + entryPtr->length;
+
+    if ((pread(LogFd, &record, size, entryPtr->offset) != size) ||
+        (record.header.msgId != msgId) || (RECORD_MESSAGE != record.header.type))
+    {
+        LE_ERROR("Cannot read message %"PRIu32" at offset %"PRIu32, msgId, entryPtr->offset);
+        return LE_FAULT;
+    }
+
+    memcpy(msgPtr, record.payload, entryPtr->length);
+
+    if (msgPtr->dataLen != entryPtr->length - MESSAGE_HEADER_BYTES)
+    {
+        LE_ERROR("Invalid message %"PRIu32, msgId);
+        return LE_FAULT;
+    }
+
+    msgPtr->imsi[sizeof(msgPtr->imsi) - 1] = '\0';
+    msgPtr->senderTel[sizeof(msgPtr->senderTel) - 1] = '\0';
+    msgPtr->timestamp[sizeof(msgPtr->timestamp) - 1] = '\0';
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether a message box holds a message.
+ */
+//--------------------------------------------------------------------------------------------------
+bool smsStore_IsInMbox
+(
+    uint32_t    msgId,      ///< [IN] Message identifier.
+    uint8_t     mbox        ///< [IN] Message box.
+)
+{
+    return (NULL != FindMboxEntry(msgId, mbox));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether a message is unread in a message box.
+ */
+//--------------------------------------------------------------------------------------------------
+bool smsStore_IsUnread
+(
+    uint32_t    msgId,      ///< [IN] Message identifier.
+    uint8_t     mbox        ///< [IN] Message box.
+)
+{
+    Entry_t* entryPtr = FindMboxEntry(msgId, mbox);
+
+    return (NULL != entryPtr) && (entryPtr->unreadMask & (1 << mbox));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mark a message as read or unread in a message box.
+ *
+ * @return
+ *  - LE_OK            The message is marked.
+ *  - LE_NOT_FOUND     The message box does not hold the message.
+ *  - LE_FAULT         The change cannot be written.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t smsStore_SetUnread
+(
+    uint32_t    msgId,      ///< [IN] Message identifier.
+    uint8_t     mbox,       ///< [IN] Message box.
+    bool        isUnread    ///< [IN] True to mark the message as unread.
+)
+{
+    Entry_t* entryPtr = FindMboxEntry(msgId, mbox);
+
+    if (NULL == entryPtr)
+    {
+        return LE_NOT_FOUND;
+    }
+
+    uint16_t unreadMask = entryPtr->unreadMask;
+
+    if (isUnread)
+    {
+        unreadMask |= (1 << mbox);
+    }
+    else
+    {
+        unreadMask &= ~(1 << mbox);
+    }
+
+    // Reading a message marks it as read every time: only log actual changes
+    if (unreadMask == entryPtr->unreadMask)
+    {
+        return LE_OK;
+    }
+
+    return WriteFlags(entryPtr, entryPtr->mboxMask, unreadMask);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove a message from a message box. The message is deleted once no message box holds it.
+ *
+ * @return
+ *  - LE_OK            The message is removed.
+ *  - LE_NOT_FOUND     The message box does not hold the message.
+ *  - LE_FAULT         The change cannot be written.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t smsStore_Remove
+(
+    uint32_t    msgId,      ///< [IN] Message identifier.
+    uint8_t     mbox        ///< [IN] Message box.
+)
+{
+    Entry_t* entryPtr = FindMboxEntry(msgId, mbox);
+
+    if (NULL == entryPtr)
+    {
+        return LE_NOT_FOUND;
+    }
+
+    return WriteFlags(entryPtr, entryPtr->mboxMask & ~(1 << mbox), entryPtr->unreadMask);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of messages of a message box.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t smsStore_GetCount
+(
+    uint8_t     mbox        ///< [IN] Message box.
+)
+{
+    if (mbox >= MboxCount)
+    {
+        return 0;
+    }
+
+    return MboxMsgCount[mbox];
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the first message of a message box from a link of the list of messages.
+ *
+ * @return The message identifier, 0 if there are no more messages.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t FindMboxMessage
+(
+    le_dls_Link_t*  linkPtr,    ///< [IN] First link to look at.
+    uint8_t         mbox        ///< [IN] Message box.
+)
+{
+    if (mbox >= MboxCount)
+    {
+        return 0;
+    }
+
+    while (NULL != linkPtr)
+    {
+        Entry_t* entryPtr = CONTAINER_OF(linkPtr, Entry_t, link);
+
+        if (entryPtr->mboxMask & (1 << mbox))
+        {
+            return entryPtr->msgId;
+        }
+
+        linkPtr = le_dls_PeekNext(&EntryList, linkPtr);
+    }
+
+    return 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the oldest message of a message box.
+ *
+ * @return The message identifier, 0 if the message box is empty.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t smsStore_GetFirst
+(
+    uint8_t     mbox        ///< [IN] Message box.
+)
+{
+    return FindMboxMessage(le_dls_Peek(&EntryList), mbox);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the message of a message box following a given message, which may have been deleted since.
+ *
+ * @return The message identifier, 0 if there are no more messages.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t smsStore_GetNext
+(
+    uint8_t     mbox,       ///< [IN] Message box.
+    uint32_t    msgId       ///< [IN] Previous message identifier.
+)
+{
+    Entry_t* entryPtr = FindEntry(msgId);
+    le_dls_Link_t* linkPtr;
+
+    if (NULL != entryPtr)
+    {
+        linkPtr = le_dls_PeekNext(&EntryList, &entryPtr->link);
+    }
+    else
+    {
+        // The entry was dropped by a compaction: look for the following identifier
+        linkPtr = le_dls_Peek(&EntryList);
+
+        while ((NULL != linkPtr) && (CONTAINER_OF(linkPtr, Entry_t, link)->msgId <= msgId))
+        {
+            linkPtr = le_dls_PeekNext(&EntryList, linkPtr);
+        }
+    }
+
+    return FindMboxMessage(linkPtr, mbox);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compact the log, dropping the records of deleted messages and the superseded updates.
+ *
+ * The store compacts its log by itself once enough of it is obsolete.
+ *
+ * @return
+ *  - LE_OK            The log is compacted.
+ *  - LE_FAULT         The log cannot be compacted, the current one is kept.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t smsStore_Compact
+(
+    void
+)
+{
+    static uint8_t buffer[COMPACTION_BUFFER_BYTES];
+    char tmpPath[PATH_MAX];
+    LogHeader_t header;
+    Record_t record;
+    size_t used = sizeof(header);
+    le_result_t result = LE_OK;
+
+    if (LogFd < 0)
+    {
+        return LE_FAULT;
+    }
+
+    le_timer_Stop(CompactionTimer);
+
+    snprintf(tmpPath, sizeof(tmpPath), "%s%s", LogPath, LOG_TMP_SUFFIX);
+
+    // The new log is opened for appending right away, to be used as soon as it is renamed
+    int fd = open(tmpPath, O_RDWR | O_CREAT | O_TRUNC | O_APPEND, S_IRUSR | S_IWUSR);
+    if (fd < 0)
+    {
+        LE_ERROR("Cannot create %s: %m", tmpPath);
+        return LE_FAULT;
+    }
+
+    FillHeader(&header);
+    memcpy(buffer, &header, sizeof(header));
+
+    le_dls_Link_t* linkPtr;
+
+    for (linkPtr = le_dls_Peek(&EntryList);
+         NULL != linkPtr;
+         linkPtr = le_dls_PeekNext(&EntryList, linkPtr))
+    {
+        Entry_t* entryPtr = CONTAINER_OF(linkPtr, Entry_t, link);
+        ssize_t size = sizeof(RecordHeader_t) + entryPtr->length;
+
+        if (0 == entryPtr->mboxMask)
+        {
+            continue;
+        }
+
+        if ((pread(LogFd, &record, size, entryPtr->offset) != size) ||
+            (record.header.msgId != entryPtr->msgId))
+        {
+            LE_ERROR("Cannot read message %"PRIu32, entryPtr->msgId);
+            result = LE_FAULT;
+            break;
+        }
+
+        // Fold the current flags into the message record
+        record.header.mboxMask = entryPtr->mboxMask;
+        record.header.unreadMask = entryPtr->unreadMask;
+        record.header.crc = ComputeCrc(&record);
+
+        if (used + size > sizeof(buffer))
+        {
+            if (LE_OK != (result = WriteAll(fd, buffer, used)))
+            {
+                break;
+            }
+            used = 0;
+        }
+
+        memcpy(buffer + used, &record, size);
+        used += size;
+    }
+
+    if ((LE_OK != result) || (LE_OK != WriteAll(fd, buffer, used)) || (0 != fdatasync(fd)) ||
+        (0 != rename(tmpPath, LogPath)))
+    {
+        LE_ERROR("Cannot compact %s", LogPath);
+        close(fd);
+        unlink(tmpPath);
+        return LE_FAULT;
+    }
+
+    close(LogFd);
+    LogFd = fd;
+
+    // Both logs hold the messages, so the compaction is kept even if the rename is not flushed yet:
+    // it is at worst redone after a power loss.
+    SyncLogDir();
+
+    // Update the index the same way the records were copied
+    uint32_t oldSize = LogSize;
+    LogSize = sizeof(header);
+
+    linkPtr = le_dls_Peek(&EntryList);
+
+    while (NULL != linkPtr)
+    {
+        Entry_t* entryPtr = CONTAINER_OF(linkPtr, Entry_t, link);
+
+        linkPtr = le_dls_PeekNext(&EntryList, linkPtr);
+
+        if (0 == entryPtr->mboxMask)
+        {
+            DeleteEntry(entryPtr);
+            continue;
+        }
+
+        entryPtr->offset = LogSize;
+        LogSize += sizeof(RecordHeader_t) + entryPtr->length;
+    }
+
+    LE_INFO("Log compacted from %"PRIu32" to %"PRIu32" bytes", oldSize, LogSize);
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the size of the log, and how much of it is obsolete.
+ */
+//--------------------------------------------------------------------------------------------------
+void smsStore_GetLogSize
+(
+    uint32_t*   sizePtr,        ///< [OUT] Log size in bytes.
+    uint32_t*   garbagePtr      ///< [OUT] Obsolete bytes.
+)
+{
+    *sizePtr = LogSize;
+    *garbagePtr = LogSize - sizeof(LogHeader_t) - LiveSize;
+}
@@ -0,0 +1,257 @@
+/**
+ * @file smsStore.h
+ *
+ * Message store of the SMS Inbox service.
+ *
+ * The messages are kept in an append-only log, indexed in memory. The message boxes are designated
+ * by their index in the table of message box names given when the store is opened.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#ifndef LEGATO_SMS_STORE_INCLUDE_GUARD
+#define LEGATO_SMS_STORE_INCLUDE_GUARD
+
+#include "legato.h"
+#include "interfaces.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of message boxes.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SMSSTORE_MBOX_MAX           16
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum length of a message payload: text, binary data or PDU.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SMSSTORE_DATA_MAX_BYTES     LE_SMS_PDU_MAX_BYTES
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Optional fields of a message.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SMSSTORE_FIELD_SENDERTEL    0x01    ///< senderTel is set.
+#define SMSSTORE_FIELD_TIMESTAMP    0x02    ///< timestamp is set.
+#define SMSSTORE_FIELD_DATA         0x04    ///< data is set.
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stored message.
+ *
+ * Only the first dataLen bytes of data are stored.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t    format;                                 ///< le_sms_Format_t of the message.
+    uint32_t    fields;                                 ///< Optional fields which are set.
+    uint32_t    msgLen;                                 ///< Length reported for the message.
+    uint32_t    dataLen;                                ///< Length of the payload.
+    char        imsi[LE_SIM_IMSI_BYTES];                ///< IMSI of the receiver SIM.
+    char        senderTel[LE_MDMDEFS_PHONE_NUM_MAX_BYTES]; ///< Sender telephone number.
+    char        timestamp[LE_SMS_TIMESTAMP_MAX_BYTES];  ///< Message time stamp.
+    uint8_t     data[SMSSTORE_DATA_MAX_BYTES];          ///< Text (without '\0'), binary or PDU.
+}
+smsStore_Message_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open the store, creating its log if needed.
+ *
+ * The log is read back to build the index. A record partially written when the device went down
+ * is discarded.
+ *
+ * @return
+ *  - LE_OK            The store is open.
+ *  - LE_FAULT         The log cannot be opened or created.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t smsStore_Open
+(
+    const char*         pathPtr,        ///< [IN] Log file path.
+    const char* const*  mboxNamePtr,    ///< [IN] Message box names.
+    uint8_t             mboxCount       ///< [IN] Number of message boxes.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close the store and release its index.
+ */
+//--------------------------------------------------------------------------------------------------
+void smsStore_Close
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a new message to message boxes, as unread.
+ *
+ * @return
+ *  - LE_OK            The message is added.
+ *  - LE_FAULT         The message cannot be written.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t smsStore_Add
+(
+    const smsStore_Message_t*   msgPtr,     ///< [IN] Message.
+    uint32_t                    mboxMask,   ///< [IN] Message boxes holding the message.
+    uint32_t*                   msgIdPtr    ///< [OUT] Identifier given to the message.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Import a message with a given identifier, replacing the message with the same identifier if any.
+ *
+ * @return
+ *  - LE_OK            The message is imported.
+ *  - LE_BAD_PARAMETER The identifier is invalid.
+ *  - LE_FAULT         The message cannot be written.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t smsStore_Import
+(
+    uint32_t                    msgId,      ///< [IN] Message identifier.
+    const smsStore_Message_t*   msgPtr,     ///< [IN] Message.
+    uint32_t                    mboxMask,   ///< [IN] Message boxes holding the message.
+    uint32_t                    unreadMask  ///< [IN] Message boxes where it is unread.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a message.
+ *
+ * @return
+ *  - LE_OK            The message is read.
+ *  - LE_NOT_FOUND     The message does not exist.
+ *  - LE_FAULT         The message cannot be read.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t smsStore_Read
+(
+    uint32_t            msgId,      ///< [IN] Message identifier.
+    smsStore_Message_t* msgPtr      ///< [OUT] Message.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether a message box holds a message.
+ */
+//--------------------------------------------------------------------------------------------------
+bool smsStore_IsInMbox
+(
+    uint32_t    msgId,      ///< [IN] Message identifier.
+    uint8_t     mbox        ///< [IN] Message box.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether a message is unread in a message box.
+ */
+//--------------------------------------------------------------------------------------------------
+bool smsStore_IsUnread
+(
+    uint32_t    msgId,      ///< [IN] Message identifier.
+    uint8_t     mbox        ///< [IN] Message box.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mark a message as read or unread in a message box.
+ *
+ * @return
+ *  - LE_OK            The message is marked.
+ *  - LE_NOT_FOUND     The message box does not hold the message.
+ *  - LE_FAULT         The change cannot be written.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t smsStore_SetUnread
+(
+    uint32_t    msgId,      ///< [IN] Message identifier.
+    uint8_t     mbox,       ///< [IN] Message box.
+    bool        isUnread    ///< [IN] True to mark the message as unread.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove a message from a message box. The message is deleted once no message box holds it.
+ *
+ * @return
+ *  - LE_OK            The message is removed.
+ *  - LE_NOT_FOUND     The message box does not hold the message.
+ *  - LE_FAULT         The change cannot be written.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t smsStore_Remove
+(
+    uint32_t    msgId,      ///< [IN] Message identifier.
+    uint8_t     mbox        ///< [IN] Message box.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of messages of a message box.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t smsStore_GetCount
+(
+    uint8_t     mbox        ///< [IN] Message box.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the oldest message of a message box.
+ *
+ * @return The message identifier, 0 if the message box is empty.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t smsStore_GetFirst
+(
+    uint8_t     mbox        ///< [IN] Message box.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the message of a message box following a given message, which may have been deleted since.
+ *
+ * @return The message identifier, 0 if there are no more messages.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t smsStore_GetNext
+(
+    uint8_t     mbox,       ///< [IN] Message box.
+    uint32_t    msgId       ///< [IN] Previous message identifier.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compact the log, dropping the records of deleted messages and the superseded updates.
+ *
+ * The store compacts its log by itself once enough of it is obsolete.
+ *
+ * @return
+ *  - LE_OK            The log is compacted.
+ *  - LE_FAULT         The log cannot be compacted, the current one is kept.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t smsStore_Compact
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the size of the log, and how much of it is obsolete.
+ */
+//--------------------------------------------------------------------------------------------------
+void smsStore_GetLogSize
+(
+    uint32_t*   sizePtr,        ///< [OUT] Log size in bytes.
+    uint32_t*   garbagePtr      ///< [OUT] Obsolete bytes.
+);
+
+#endif // LEGATO_SMS_STORE_INCLUDE_GUARD
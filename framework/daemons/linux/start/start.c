@@ -30,6 +30,7 @@
 #include "start.h"
 #include "pa_start.h"
 
+#include "bootTrace.h"
 #include "daemon.h"
 #include "dir.h"
 #include "file.h"
@@ -1351,6 +1352,8 @@ static int TryToRun
 {
 
     // Start the Supervisor.
+    bootTrace_Record(BOOT_TRACE_MARK, "launch supervisor");
+
     pid_t supervisorPid = fork();
     if (supervisorPid == 0)
     {
@@ -2158,11 +2161,16 @@ int main
 
     daemon_Daemonize(5000); // 5 second timeout in case older supervisor is installed.
 
+    // Start recording the boot timeline.
+    bootTrace_Reset();
+
     LE_INFO("Loading platform adaptor");
+    bootTrace_Record(BOOT_TRACE_BEGIN, "platform adaptor");
     LoadPa();
 
     LE_INFO("Initializing platform adaptor");
     pa_start_Init();
+    bootTrace_Record(BOOT_TRACE_END, "platform adaptor");
 
     LE_INFO("Installing/launching the system.");
     while(1)
@@ -2171,7 +2179,9 @@ int main
         {
             // Verify and install the current system.
             // R/O system are always ready. So, nothing to do for them.
+            bootTrace_Record(BOOT_TRACE_BEGIN, "check system");
             CheckAndInstallCurrentSystem();
+            bootTrace_Record(BOOT_TRACE_END, "check system");
         }
 
         // Fix ld.so.conf in case the system is still running an older version of start
@@ -2180,6 +2190,9 @@ int main
 
         // Run the current system.
         Launch(isReadOnly);
+
+        // The framework is going to be started again; record a new timeline for it.
+        bootTrace_Reset();
     }
 
     return 0;
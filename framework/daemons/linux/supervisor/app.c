@@ -355,6 +355,14 @@ typedef struct app_Ref
     le_sls_List_t   additionalLinks;    // List of additional links that are temporarily added to
                                         // the app.
     le_sls_List_t   reqModuleName;      // List of required kernel module names
+    bool            sandboxReady;       // true if app_PrepareSandbox() has set up the runtime
+                                        // area for the next app_Start().
+    char            sandboxHash[LIMIT_MAX_APP_HASH_BYTES]; // Hash of the app version whose runtime
+                                        // area is cached in cachedLinks.  Empty if none is.
+    uint64_t        sandboxCfgHash;     // Hash of the config the cached runtime area was built
+                                        // from (see GetSandboxConfigHash()).
+    le_sls_List_t   cachedLinks;        // Links of the cached runtime area (CachedLink_t).
+    bool            isCachingLinks;     // true while SetupAppArea() records into cachedLinks.
 }
 App_t;
 
@@ -388,6 +396,42 @@ FileLinkNode_t;
 static le_mem_PoolRef_t FileLinkNodePool;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Expected length of the two paths of a cached link.  Longer ones come from the parent pool.
+ */
+//--------------------------------------------------------------------------------------------------
+#define CACHED_LINK_PATHS_BYTES         128
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A link that SetupAppArea() created, or found already in place, in the app's runtime area.
+ *
+ * While the app's hash stays the same and these links are still in place, a restart of the app
+ * can reuse its runtime area instead of walking the bundled and required files in the config tree
+ * again.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_sls_Link_t link;                     ///< Link in the app's list of cached links.
+    size_t destOffset;                      ///< Offset of the destination path in paths.
+    char paths[];                           ///< Source path, then absolute destination path.
+}
+CachedLink_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The memory pools for cached links.  Links are allocated from the reduced pool, which falls back
+ * on its parent for long paths.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t CachedLinkPool;
+static le_mem_PoolRef_t CachedLinkReducedPool;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Prototype for process stopped handler.
@@ -1449,23 +1493,28 @@ static le_result_t SetSmackRules
     char appLabel[LIMIT_MAX_SMACK_LABEL_BYTES];
     smack_GetAppLabel(appRef->name, appLabel, sizeof(appLabel));
 
+    // Load all the app's rules into the kernel together.
+    smack_StartRuleBatch();
+
     SetDefaultSmackRules(appRef, appLabel);
 
     SetSmackRulesForBindings(appRef, appLabel);
 
     le_result_t result = SetDefaultDevicePermissions(appRef);
-    if (result != LE_OK)
+
+    if (result == LE_OK)
     {
-        return result;
+        result = SetPermissionForRequired(appRef);
     }
 
-    result = SetPermissionForRequired(appRef);
-    if (result != LE_OK)
+    if (result == LE_OK)
     {
-        return result;
+        result = SetCfgDevicePermissions(appRef);
     }
 
-    return SetCfgDevicePermissions(appRef);
+    smack_CommitRuleBatch();
+
+    return result;
 }
 
 
@@ -1920,6 +1969,265 @@ static bool DoesLinkExist
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Empties an application's runtime area cache.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ClearSandboxCache
+(
+    app_Ref_t appRef                    ///< [IN] Application reference.
+)
+{
+    le_sls_Link_t* linkPtr;
+
+    while ((linkPtr = le_sls_Pop(&(appRef->cachedLinks))) != NULL)
+    {
+        le_mem_Release(CONTAINER_OF(linkPtr, CachedLink_t, link));
+    }
+
+    appRef->sandboxHash[0] = '\0';
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Records a link of the runtime area while SetupAppArea() is building it.  Does nothing at other
+ * times, so links added with app_AddLink() are never cached.
+ *
+ * Links to shared memory in /dev/shm also relabel their source, which has to be redone on every
+ * start, so they stop the runtime area from being cached at all.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CacheLink
+(
+    app_Ref_t appRef,                   ///< [IN] Application reference.
+    const char* srcPtr,                 ///< [IN] Source path.
+    const char* destPath                ///< [IN] Absolute destination path.
+)
+{
+    if (!appRef->isCachingLinks)
+    {
+        return;
+    }
+
+    if (le_path_IsEquivalent("/dev/shm", srcPtr, "/") ||
+        le_path_IsSubpath("/dev/shm", srcPtr, "/"))
+    {
+        LE_DEBUG("App '%s' imports '%s'; not caching its runtime area.", appRef->name, srcPtr);
+        appRef->isCachingLinks = false;
+        return;
+    }
+
+    size_t srcSize = strlen(srcPtr) + 1;
+    size_t destSize = strlen(destPath) + 1;
+
+    CachedLink_t* cachedLinkPtr = le_mem_ForceVarAlloc(CachedLinkReducedPool,
+                                                       sizeof(CachedLink_t) + srcSize + destSize);
+    cachedLinkPtr->link = LE_SLS_LINK_INIT;
+    cachedLinkPtr->destOffset = srcSize;
+    memcpy(cachedLinkPtr->paths, srcPtr, srcSize);
+    memcpy(cachedLinkPtr->paths + srcSize, destPath, destSize);
+
+    le_sls_Queue(&(appRef->cachedLinks), &(cachedLinkPtr->link));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds a block of bytes to a 64-bit FNV-1a hash.
+ *
+ * @return
+ *      The updated hash.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t HashBytes
+(
+    uint64_t hash,                      ///< [IN] Hash so far.
+    const void* dataPtr,                ///< [IN] Bytes to add.
+    size_t size                         ///< [IN] Number of bytes.
+)
+{
+    const uint8_t* bytePtr = dataPtr;
+
+    while (size-- > 0)
+    {
+        hash = (hash ^ *bytePtr++) * UINT64_C(0x100000001b3);
+    }
+
+    return hash;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds the config node an iterator is on, and all of the nodes below it, to a hash.  The names,
+ * types and values of the nodes are hashed, so that any change to them changes the hash.
+ *
+ * @return
+ *      The updated hash.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t HashConfigNode
+(
+    uint64_t hash,                      ///< [IN] Hash so far.
+    le_cfg_IteratorRef_t cfgIter        ///< [IN] Iterator on the node to hash.
+)
+{
+    char buffer[LIMIT_MAX_PATH_BYTES] = "";
+    le_cfg_nodeType_t type = le_cfg_GetNodeType(cfgIter, "");
+
+    // Truncated names or values are hashed as they are.
+    le_cfg_GetNodeName(cfgIter, "", buffer, sizeof(buffer));
+    hash = HashBytes(hash, buffer, strlen(buffer) + 1);
+    hash = HashBytes(hash, &type, sizeof(type));
+
+    switch (type)
+    {
+        case LE_CFG_TYPE_STEM:
+            if (le_cfg_GoToFirstChild(cfgIter) == LE_OK)
+            {
+                do
+                {
+                    hash = HashConfigNode(hash, cfgIter);
+                }
+                while (le_cfg_GoToNextSibling(cfgIter) == LE_OK);
+
+                le_cfg_GoToParent(cfgIter);
+            }
+            break;
+
+        case LE_CFG_TYPE_STRING:
+            le_cfg_GetString(cfgIter, "", buffer, sizeof(buffer), "");
+            hash = HashBytes(hash, buffer, strlen(buffer) + 1);
+            break;
+
+        case LE_CFG_TYPE_BOOL:
+        {
+            bool value = le_cfg_GetBool(cfgIter, "", false);
+            hash = HashBytes(hash, &value, sizeof(value));
+            break;
+        }
+
+        case LE_CFG_TYPE_INT:
+        {
+            int32_t value = le_cfg_GetInt(cfgIter, "", 0);
+            hash = HashBytes(hash, &value, sizeof(value));
+            break;
+        }
+
+        case LE_CFG_TYPE_FLOAT:
+        {
+            double value = le_cfg_GetFloat(cfgIter, "", 0.0);
+            hash = HashBytes(hash, &value, sizeof(value));
+            break;
+        }
+
+        default:
+            break;
+    }
+
+    return hash;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets a hash of the parts of an application's config that its runtime area is built from: the
+ * bundled and required files, directories and devices.  These can be changed in the config tree
+ * without reinstalling the app, which does not change the app's hash.
+ *
+ * @return
+ *      The hash.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t GetSandboxConfigHash
+(
+    app_Ref_t appRef                    ///< [IN] Application reference.
+)
+{
+    uint64_t hash = UINT64_C(0xcbf29ce484222325);
+
+    le_cfg_IteratorRef_t appCfg = le_cfg_CreateReadTxn(appRef->cfgPathRoot);
+
+    le_cfg_GoToNode(appCfg, CFG_NODE_BUNDLES);
+    hash = HashConfigNode(hash, appCfg);
+
+    le_cfg_GoToParent(appCfg);
+    le_cfg_GoToNode(appCfg, CFG_NODE_REQUIRES);
+    hash = HashConfigNode(hash, appCfg);
+
+    le_cfg_CancelTxn(appCfg);
+
+    return HashBytes(hash, &(appRef->sandboxed), sizeof(appRef->sandboxed));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks whether an application's cached runtime area can be reused as it is.  This is the case if
+ * the app has not been updated since the runtime area was built, the config that the runtime area
+ * is built from has not changed, and all of the links are still in place.
+ *
+ * @return
+ *      true if the cached runtime area is still valid.
+ *      false otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsSandboxCacheValid
+(
+    app_Ref_t appRef                    ///< [IN] Application reference.
+)
+{
+    if (appRef->sandboxHash[0] == '\0')
+    {
+        return false;
+    }
+
+    char hash[LIMIT_MAX_APP_HASH_BYTES];
+
+    if ( (le_appInfo_GetHash(appRef->name, hash, sizeof(hash)) != LE_OK) ||
+         (strcmp(hash, appRef->sandboxHash) != 0) )
+    {
+        LE_INFO("App '%s' has changed since its runtime area was set up.", appRef->name);
+        return false;
+    }
+
+    if (GetSandboxConfigHash(appRef) != appRef->sandboxCfgHash)
+    {
+        LE_INFO("The config of app '%s' has changed since its runtime area was set up.",
+                appRef->name);
+        return false;
+    }
+
+    if (appRef->sandboxed && !fs_IsMountPoint(appRef->workingDir))
+    {
+        return false;
+    }
+
+    le_sls_Link_t* linkPtr = le_sls_Peek(&(appRef->cachedLinks));
+
+    while (linkPtr != NULL)
+    {
+        CachedLink_t* cachedLinkPtr = CONTAINER_OF(linkPtr, CachedLink_t, link);
+        const char* srcPtr = cachedLinkPtr->paths;
+        const char* destPath = cachedLinkPtr->paths + cachedLinkPtr->destOffset;
+
+        struct stat srcStat;
+
+        if ( (stat(srcPtr, &srcStat) == -1) || !DoesLinkExist(appRef, &srcStat, destPath) )
+        {
+            LE_INFO("Link '%s' to '%s' in app '%s' is gone.", srcPtr, destPath, appRef->name);
+            return false;
+        }
+
+        linkPtr = le_sls_PeekNext(&(appRef->cachedLinks), linkPtr);
+    }
+
+    return true;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Create a directory link from the source to the destination.  The source is always assumed to be
@@ -1973,6 +2281,7 @@ static le_result_t CreateDirLink
     if (DoesLinkExist(appRef, &srcStat, destPath))
     {
         LE_INFO("Skipping directory link '%s' to '%s': Already exists", srcPtr, destPath);
+        CacheLink(appRef, srcPtr, destPath);
         return LE_OK;
     }
 
@@ -2005,6 +2314,7 @@ static le_result_t CreateDirLink
     }
 
     LE_INFO("Created directory link '%s' to '%s'.", srcPtr, destPath);
+    CacheLink(appRef, srcPtr, destPath);
 
     return LE_OK;
 
@@ -2074,6 +2384,7 @@ static le_result_t CreateFileLink
             LE_ERROR("Couldn't set SMACK label to '*' for %s", srcPtr);
             goto failure;
         }
+        CacheLink(appRef, srcPtr, destPath);
         return LE_OK;
     }
 
@@ -2081,6 +2392,7 @@ static le_result_t CreateFileLink
     if (DoesLinkExist(appRef, &srcStat, destPath))
     {
         LE_INFO("Skipping file link '%s' to '%s': Already exists", srcPtr, destPath);
+        CacheLink(appRef, srcPtr, destPath);
         return LE_OK;
     }
 
@@ -2151,6 +2463,7 @@ static le_result_t CreateFileLink
     }
 
     LE_INFO("Created file link '%s' to '%s'.", srcPtr, destPath);
+    CacheLink(appRef, srcPtr, destPath);
 
     return LE_OK;
 
@@ -3092,6 +3405,11 @@ void app_Init
 {
     AppPool = le_mem_CreatePool("Apps", sizeof(App_t));
     FileLinkNodePool = le_mem_CreatePool("Links", sizeof(FileLinkNode_t));
+    CachedLinkPool = le_mem_CreatePool("CachedLinks",
+                                       sizeof(CachedLink_t) + (2 * LIMIT_MAX_PATH_BYTES));
+    CachedLinkReducedPool = le_mem_CreateReducedPool(CachedLinkPool, "CachedLinksReduced", 0,
+                                                     sizeof(CachedLink_t) +
+                                                     CACHED_LINK_PATHS_BYTES);
     ProcContainerPool = le_mem_CreatePool("ProcContainers", sizeof(ProcContainer_t));
     ReqModStringPool = le_mem_CreatePool("Required Modules", sizeof(ModNameNode_t));
 
@@ -3252,6 +3570,11 @@ app_Ref_t app_Create
     appPtr->additionalLinks = LE_SLS_LIST_INIT;
     appPtr->state = APP_STATE_STOPPED;
     appPtr->killTimer = NULL;
+    appPtr->sandboxReady = false;
+    appPtr->sandboxHash[0] = '\0';
+    appPtr->sandboxCfgHash = 0;
+    appPtr->cachedLinks = LE_SLS_LIST_INIT;
+    appPtr->isCachingLinks = false;
 
     LE_INFO("Creating app '%s'", appPtr->name);
 
@@ -3447,6 +3770,8 @@ void app_Delete
         le_timer_Delete(appRef->killTimer);
     }
 
+    ClearSandboxCache(appRef);
+
     // Release app.
     le_mem_Release(appRef);
 }
@@ -3454,49 +3779,76 @@ void app_Delete
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Starts an application.
+ * Sets up the application execution area in the file system, or reuses the one left behind by the
+ * previous run of the app if it is still valid.
+ *
+ * A successful full set up is cached against the app's hash and the hash of its bundled and
+ * required items in the config tree, so that restarting the same version of the app with the same
+ * config does not have to go through all of its bundled and required files again.
  *
  * @return
  *      LE_OK if successful.
  *      LE_FAULT if there was an error.
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t app_Start
+static le_result_t SetupCachedAppArea
 (
-    app_Ref_t appRef                    ///< [IN] Reference to the application to start.
+    app_Ref_t appRef                    ///< [IN] The application reference.
 )
 {
-    LE_INFO("Starting app '%s'", appRef->name);
+    if (IsSandboxCacheValid(appRef))
+    {
+        LE_INFO("Reusing the runtime area of app '%s'.", appRef->name);
+        return LE_OK;
+    }
 
-    bool moduleLoadFailed = false;
+    ClearSandboxCache(appRef);
 
-    if (appRef->state == APP_STATE_RUNNING)
-    {
-        LE_ERROR("Application '%s' is already running.", appRef->name);
+    char hash[LIMIT_MAX_APP_HASH_BYTES];
+    appRef->isCachingLinks = (le_appInfo_GetHash(appRef->name, hash, sizeof(hash)) == LE_OK);
 
-        return LE_FAULT;
-    }
+    // Hash the config before the set up, so that a change made while it runs invalidates the cache.
+    uint64_t cfgHash = GetSandboxConfigHash(appRef);
 
-    if (framework_IsStopping())
+    le_result_t result = SetupAppArea(appRef);
+
+    if ((result == LE_OK) && appRef->isCachingLinks)
     {
-        LE_ERROR("App '%s' cannot be started because framework is shutting down.",
-                 appRef->name);
-        return LE_FAULT;
+        LE_ASSERT(le_utf8_Copy(appRef->sandboxHash, hash, sizeof(appRef->sandboxHash), NULL)
+                  == LE_OK);
+        appRef->sandboxCfgHash = cfgHash;
     }
-
-    // Install the required kernel modules
-    if (GetKernelModules(appRef) != LE_OK)
+    else
     {
-        LE_ERROR("Error in installing dependent kernel modules for app '%s'", appRef->name);
-        moduleLoadFailed = true;
+        ClearSandboxCache(appRef);
     }
 
-    appRef->state = APP_STATE_RUNNING;
+    appRef->isCachingLinks = false;
 
-    // Set SMACK rules for this app.
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets the SMACK rules for an application and sets up its runtime area in the file system,
+ * including the /tmp of a sandboxed app.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t SetupRuntimeArea
+(
+    app_Ref_t appRef                    ///< [IN] The application reference.
+)
+{
+    // Set SMACK rules for this app.  These are revoked whenever the app stops, so they are set
+    // again even when the runtime area is reused.
     // Setup the runtime area in the file system.
     if ( (SetSmackRules(appRef) != LE_OK) ||
-         (SetupAppArea(appRef) != LE_OK) )
+         (SetupCachedAppArea(appRef) != LE_OK) )
     {
         LE_ERROR("Failed to set Smack rules or set up app area.");
         return LE_FAULT;
@@ -3522,6 +3874,115 @@ le_result_t app_Start
         }
     }
 
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets up an application's SMACK rules and runtime area ahead of app_Start(), so that this file
+ * system work can be done on a helper thread.  The next app_Start() then only has to start the
+ * processes.
+ *
+ * Apps that require kernel modules are not prepared here because their device permissions can
+ * only be set once app_Start() has loaded the modules.
+ *
+ * @note This may be called from any thread that is connected to the config tree, as long as the
+ *       app is not started, stopped or deleted at the same time.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_UNSUPPORTED if the app requires kernel modules (nothing was done).
+ *      LE_FAULT if there was an error.  app_Start() will then retry the set up.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t app_PrepareSandbox
+(
+    app_Ref_t appRef                    ///< [IN] Reference to the application to prepare.
+)
+{
+    le_cfg_IteratorRef_t iter = le_cfg_CreateReadTxn(appRef->cfgPathRoot);
+    bool hasModules = !le_cfg_IsEmpty(iter, CFG_NODE_REQUIRES "/" CFG_NODE_KERNELMODULES);
+    le_cfg_CancelTxn(iter);
+
+    if (hasModules)
+    {
+        return LE_UNSUPPORTED;
+    }
+
+    le_result_t result = SetupRuntimeArea(appRef);
+
+    appRef->sandboxReady = (result == LE_OK);
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Forgets the cached runtime area of an application, so that the next app_Start() sets it up
+ * from the config tree again.  Called when a new version of the app is installed.
+ */
+//--------------------------------------------------------------------------------------------------
+void app_InvalidateSandboxCache
+(
+    app_Ref_t appRef                    ///< [IN] Reference to the application.
+)
+{
+    ClearSandboxCache(appRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Starts an application.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t app_Start
+(
+    app_Ref_t appRef                    ///< [IN] Reference to the application to start.
+)
+{
+    LE_INFO("Starting app '%s'", appRef->name);
+
+    bool moduleLoadFailed = false;
+
+    if (appRef->state == APP_STATE_RUNNING)
+    {
+        LE_ERROR("Application '%s' is already running.", appRef->name);
+
+        return LE_FAULT;
+    }
+
+    if (framework_IsStopping())
+    {
+        LE_ERROR("App '%s' cannot be started because framework is shutting down.",
+                 appRef->name);
+        return LE_FAULT;
+    }
+
+    // Install the required kernel modules
+    if (GetKernelModules(appRef) != LE_OK)
+    {
+        LE_ERROR("Error in installing dependent kernel modules for app '%s'", appRef->name);
+        moduleLoadFailed = true;
+    }
+
+    appRef->state = APP_STATE_RUNNING;
+
+    // Set up the runtime area, unless app_PrepareSandbox() has already done it.
+    bool sandboxReady = appRef->sandboxReady;
+    appRef->sandboxReady = false;
+
+    if (!sandboxReady && (SetupRuntimeArea(appRef) != LE_OK))
+    {
+        return LE_FAULT;
+    }
+
     // Start all the processes in the application.
     le_dls_Link_t* procLinkPtr = le_dls_Peek(&(appRef->procs));
 
@@ -3594,6 +4055,7 @@ void app_Stop
     LE_INFO("Stopping app '%s'", appRef->name);
 
     CleanupAppSmackSettings(appRef);
+    appRef->sandboxReady = false;
 
     if (appRef->state == APP_STATE_STOPPED)
     {
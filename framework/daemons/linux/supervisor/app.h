@@ -156,6 +156,39 @@ void app_Delete
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets up an application's SMACK rules and runtime area ahead of app_Start(), so that this file
+ * system work can be done on a helper thread.  The next app_Start() then only has to start the
+ * processes.
+ *
+ * @note This may be called from any thread that is connected to the config tree, as long as the
+ *       app is not started, stopped or deleted at the same time.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_UNSUPPORTED if the app requires kernel modules (nothing was done).
+ *      LE_FAULT if there was an error.  app_Start() will then retry the set up.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t app_PrepareSandbox
+(
+    app_Ref_t appRef                    ///< [IN] Reference to the application to prepare.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Forgets the cached runtime area of an application, so that the next app_Start() sets it up
+ * from the config tree again.  Called when a new version of the app is installed.
+ */
+//--------------------------------------------------------------------------------------------------
+void app_InvalidateSandboxCache
+(
+    app_Ref_t appRef                    ///< [IN] Reference to the application.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Starts an application.
@@ -23,6 +23,10 @@
  * When an inactive app is started, the app container is moved from the list of inactive apps to
  * the list of active apps.
  *
+ * apps_AutoStart() launches apps in dependency order, preparing the sandboxes of independent apps
+ * concurrently on helper threads.  While an app's sandbox is being prepared its container is on
+ * neither list, and requests to start the app or get a reference to it fail with LE_DUPLICATE.
+ *
  * An app can be stopped by either an IPC call, a shutdown of the framework or when the app
  * terminates either normally or due to a fault action.
  *
@@ -73,6 +77,7 @@
 #include "cgroups.h"
 #include "file.h"
 #include "installer.h"
+#include "bootTrace.h"
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -144,6 +149,23 @@ static apps_ShutdownHandler_t AllAppsShutdownHandler = NULL;
 struct AppContainer;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Timings of the last start of an app, as reported by le_appCtrl_GetStartTimes().
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    bool            isValid;      ///< true if the app has been started since the Supervisor started.
+    le_clk_Time_t   requestTime;  ///< When the start was requested (relative time).
+    uint32_t        waitMs;       ///< Time waiting for dependencies and for a helper thread.
+    uint32_t        sandboxMs;    ///< Time setting up the sandbox on a helper thread.
+    uint32_t        launchMs;     ///< Time spent in app_Start() on the main thread.
+    uint32_t        totalMs;      ///< Time from the request until the processes were launched.
+}
+AppStartTimes_t;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Prototype for app stopped handler.
@@ -176,6 +198,7 @@ typedef struct AppContainer
     void* traceAttachContextPtr;          ///< Context for the client's trace attach handler.
     le_timer_Ref_t CheckAppStopTimer;     ///< Timer for waiting APP stop
     int AppStopTryCount;                  ///< Counter number for retrying to mark the stopped APP
+    AppStartTimes_t startTimes;           ///< Timings of the last start.
 }
 AppContainer_t;
 
@@ -220,6 +243,134 @@ static le_dls_List_t ActiveAppsList = LE_DLS_LIST_INIT;
 static le_dls_List_t InactiveAppsList = LE_DLS_LIST_INIT;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * The name of the node in an app's config that lists other apps (as child node names) that must be
+ * launched before this app is auto-started.  It is set from the .adef "startAfter" section.  Apps
+ * that this app has IPC bindings to are always launched first, so this is only needed for
+ * dependencies that are not expressed as bindings.
+ */
+//--------------------------------------------------------------------------------------------------
+#define CFG_NODE_START_AFTER                "startAfter"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The name of the node in an app's config that contains its IPC bindings.
+ */
+//--------------------------------------------------------------------------------------------------
+#define CFG_NODE_BINDINGS                   "bindings"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of helper threads that the start scheduler uses to prepare app sandboxes.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_START_THREADS                   16
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * States of an app in the start scheduler.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    START_WAITING,      ///< Waiting for the apps it depends on to be launched.
+    START_PREPARING,    ///< Sandbox being prepared on a helper thread.
+    START_DONE          ///< Launched (or failed to).
+}
+StartState_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * An app to be auto-started by the start scheduler.  These only exist while apps_AutoStart() is
+ * in progress.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_dls_Link_t   link;                           ///< Link in the StartList.
+    char            appName[LIMIT_MAX_APP_NAME_BYTES]; ///< Name of the app.
+    StartState_t    state;                          ///< Scheduling state.
+    size_t          waitCount;                      ///< Number of apps yet to be launched first.
+    le_sls_List_t   dependents;                     ///< Apps that wait for this one (StartEdge_t).
+    struct AppContainer* appContainerPtr;           ///< App container.  While the app is being
+                                                    ///< prepared it is on neither app list.
+    size_t          threadIndex;                    ///< Helper thread preparing the app.
+}
+StartNode_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Dependency edge in the start scheduler's graph.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_sls_Link_t   link;           ///< Link in the dependency's list of dependents.
+    StartNode_t*    nodePtr;        ///< The app that waits.
+}
+StartEdge_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Memory pools for the start scheduler.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t StartNodePool;
+static le_mem_PoolRef_t StartEdgePool;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Apps being auto-started, in config tree order.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_dls_List_t StartList = LE_DLS_LIST_INIT;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * When apps_AutoStart() was called.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_clk_Time_t AutoStartTime;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Helper threads that prepare sandboxes, and whether each one is currently busy.  The number of
+ * threads is set by LE_CONFIG_SUPERV_APP_START_THREADS.  With no threads, apps are prepared and
+ * launched on the main thread, one after another in dependency order.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_thread_Ref_t StartThreads[MAX_START_THREADS];
+static bool StartThreadBusy[MAX_START_THREADS];
+static size_t StartThreadCount = 0;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The Supervisor's main thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_thread_Ref_t MainThreadRef;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of apps that are currently being prepared on a helper thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t StartsInProgress = 0;
+
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Application Process object container.
@@ -381,6 +532,25 @@ static void DeactivateAppContainer
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the number of milliseconds elapsed since a relative time.
+ *
+ * @return
+ *      The elapsed time in milliseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t GetElapsedMs
+(
+    le_clk_Time_t since             ///< [IN] Relative time to measure from.
+)
+{
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), since);
+
+    return (uint32_t)((elapsed.sec * 1000) + (elapsed.usec / 1000));
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Restarts an application.
@@ -396,7 +566,18 @@ static void RestartApp
     appContainerPtr->stopHandler = DeactivateAppContainer;
 
     // Restart the app.
-    if (app_Start(appContainerPtr->appRef) == LE_OK)
+    le_clk_Time_t launchTime = le_clk_GetRelativeTime();
+
+    le_result_t result = app_Start(appContainerPtr->appRef);
+
+    appContainerPtr->startTimes.requestTime = launchTime;
+    appContainerPtr->startTimes.waitMs = 0;
+    appContainerPtr->startTimes.sandboxMs = 0;
+    appContainerPtr->startTimes.launchMs = GetElapsedMs(launchTime);
+    appContainerPtr->startTimes.totalMs = appContainerPtr->startTimes.launchMs;
+    appContainerPtr->startTimes.isValid = true;
+
+    if (result == LE_OK)
     {
         LE_INFO("Application '%s' restarted.", app_GetName(appContainerPtr->appRef));
     }
@@ -554,6 +735,39 @@ static AppContainer_t* GetActiveAppWithProc
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks whether an app's sandbox is being prepared by the start scheduler.  Such an app's
+ * container is on neither app list until the app is launched.
+ *
+ * @return
+ *      true if the app is being prepared.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsAppStarting
+(
+    const char* appNamePtr          ///< [IN] Name of the application.
+)
+{
+    le_dls_Link_t* linkPtr = le_dls_Peek(&StartList);
+
+    while (linkPtr != NULL)
+    {
+        StartNode_t* nodePtr = CONTAINER_OF(linkPtr, StartNode_t, link);
+
+        if ( (nodePtr->state == START_PREPARING) &&
+             (strncmp(nodePtr->appName, appNamePtr, LIMIT_MAX_APP_NAME_BYTES) == 0) )
+        {
+            return true;
+        }
+
+        linkPtr = le_dls_PeekNext(&StartList, linkPtr);
+    }
+
+    return false;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Create the app container if necessary.  This function searches for the app container in the
@@ -562,6 +776,7 @@ static AppContainer_t* GetActiveAppWithProc
  * @return
  *  - LE_OK if successful.
  *  - LE_NOT_FOUND if the app is not installed (no container created).
+ *  - LE_DUPLICATE if the app is being auto-started (container not available yet).
  *  - LE_FAULT if there was some other error (check logs).
  */
 //--------------------------------------------------------------------------------------------------
@@ -571,6 +786,14 @@ static le_result_t CreateApp
     AppContainer_t** containerPtrPtr ///< [OUT] Ptr to the app container, or NULL if not created.
 )
 {
+    if (IsAppStarting(appNamePtr))
+    {
+        LE_ERROR("Application '%s' is being started.", appNamePtr);
+
+        *containerPtrPtr = NULL;
+        return LE_DUPLICATE;
+    }
+
     // Check active list.
     *containerPtrPtr = GetActiveApp(appNamePtr);
 
@@ -632,6 +855,7 @@ static le_result_t CreateApp
     containerPtr->traceAttachContextPtr = NULL;
     containerPtr->CheckAppStopTimer = NULL;
     containerPtr->AppStopTryCount = 0;
+    containerPtr->startTimes.isValid = false;
 
     // Add this app to the inactive list.
     le_dls_Queue(&InactiveAppsList, &(containerPtr->link));
@@ -668,8 +892,15 @@ static le_result_t StartApp
     appContainerPtr->isActive = true;
 
     // Start the app.
+    le_clk_Time_t launchTime = le_clk_GetRelativeTime();
 
+    bootTrace_Record(BOOT_TRACE_BEGIN, "launch %s", app_GetName(appContainerPtr->appRef));
     le_result_t result = app_Start(appContainerPtr->appRef);
+    bootTrace_Record(BOOT_TRACE_END, "launch %s", app_GetName(appContainerPtr->appRef));
+
+    appContainerPtr->startTimes.launchMs = GetElapsedMs(launchTime);
+    appContainerPtr->startTimes.totalMs = GetElapsedMs(appContainerPtr->startTimes.requestTime);
+    appContainerPtr->startTimes.isValid = true;
 
     switch(result)
     {
@@ -719,7 +950,7 @@ static le_result_t StartApp
  *
  * @return
  *      LE_OK if successfully launched the app.
- *      LE_DUPLICATE if the app is already running.
+ *      LE_DUPLICATE if the app is already running or being auto-started.
  *      LE_NOT_FOUND if the app is not installed.
  *      LE_FAULT if the app could not be launched.
  */
@@ -743,11 +974,387 @@ static le_result_t LaunchApp
         return LE_DUPLICATE;
     }
 
+    appContainerPtr->startTimes.requestTime = le_clk_GetRelativeTime();
+    appContainerPtr->startTimes.waitMs = 0;
+    appContainerPtr->startTimes.sandboxMs = 0;
+
     // Start the app.
     return StartApp(appContainerPtr);
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Makes an app wait for another app to be launched first, if that other app is being auto-started
+ * too.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddStartDependency
+(
+    StartNode_t* nodePtr,           ///< [IN] App that waits.
+    const char* depNamePtr          ///< [IN] Name of the app to wait for.
+)
+{
+    if ( (depNamePtr[0] == '\0') ||
+         (strncmp(depNamePtr, nodePtr->appName, LIMIT_MAX_APP_NAME_BYTES) == 0) )
+    {
+        return;
+    }
+
+    le_dls_Link_t* linkPtr = le_dls_Peek(&StartList);
+
+    while (linkPtr != NULL)
+    {
+        StartNode_t* depNodePtr = CONTAINER_OF(linkPtr, StartNode_t, link);
+
+        if (strncmp(depNodePtr->appName, depNamePtr, LIMIT_MAX_APP_NAME_BYTES) == 0)
+        {
+            // Ignore duplicates (e.g., several bindings to the same server app).
+            le_sls_Link_t* edgeLinkPtr = le_sls_Peek(&(depNodePtr->dependents));
+
+            while (edgeLinkPtr != NULL)
+            {
+                if (CONTAINER_OF(edgeLinkPtr, StartEdge_t, link)->nodePtr == nodePtr)
+                {
+                    return;
+                }
+
+                edgeLinkPtr = le_sls_PeekNext(&(depNodePtr->dependents), edgeLinkPtr);
+            }
+
+            StartEdge_t* edgePtr = le_mem_ForceAlloc(StartEdgePool);
+            edgePtr->link = LE_SLS_LINK_INIT;
+            edgePtr->nodePtr = nodePtr;
+
+            le_sls_Queue(&(depNodePtr->dependents), &(edgePtr->link));
+            nodePtr->waitCount++;
+
+            return;
+        }
+
+        linkPtr = le_dls_PeekNext(&StartList, linkPtr);
+    }
+
+    // Not being auto-started, so there is nothing to wait for.
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads an app's IPC bindings and declared start order from the config tree and adds them to the
+ * start scheduler's dependency graph.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddStartDependencies
+(
+    StartNode_t* nodePtr            ///< [IN] App to add the dependencies of.
+)
+{
+    char configPath[LIMIT_MAX_PATH_BYTES] = { 0 };
+
+    LE_ASSERT(le_path_Concat("/", configPath, sizeof(configPath),
+                             CFG_NODE_APPS_LIST, nodePtr->appName, (char*)NULL) == LE_OK);
+
+    le_cfg_IteratorRef_t appCfg = le_cfg_CreateReadTxn(configPath);
+
+    // Server apps that this app is bound to.
+    le_cfg_GoToNode(appCfg, CFG_NODE_BINDINGS);
+
+    if (le_cfg_GoToFirstChild(appCfg) == LE_OK)
+    {
+        do
+        {
+            char serverName[LIMIT_MAX_APP_NAME_BYTES];
+
+            if (le_cfg_GetString(appCfg, "app", serverName, sizeof(serverName), "") == LE_OK)
+            {
+                AddStartDependency(nodePtr, serverName);
+            }
+        }
+        while (le_cfg_GoToNextSibling(appCfg) == LE_OK);
+
+        le_cfg_GoToParent(appCfg);
+    }
+
+    le_cfg_GoToParent(appCfg);
+
+    // Apps that this app is declared to start after.
+    le_cfg_GoToNode(appCfg, CFG_NODE_START_AFTER);
+
+    if (le_cfg_GoToFirstChild(appCfg) == LE_OK)
+    {
+        do
+        {
+            char depName[LIMIT_MAX_APP_NAME_BYTES];
+
+            if (le_cfg_GetNodeName(appCfg, "", depName, sizeof(depName)) == LE_OK)
+            {
+                AddStartDependency(nodePtr, depName);
+            }
+        }
+        while (le_cfg_GoToNextSibling(appCfg) == LE_OK);
+    }
+
+    le_cfg_CancelTxn(appCfg);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Marks a scheduled app as done and releases the apps that were waiting for it.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReleaseDependents
+(
+    StartNode_t* nodePtr            ///< [IN] App that was launched (or failed to).
+)
+{
+    nodePtr->state = START_DONE;
+
+    le_sls_Link_t* linkPtr;
+
+    while ((linkPtr = le_sls_Pop(&(nodePtr->dependents))) != NULL)
+    {
+        StartEdge_t* edgePtr = CONTAINER_OF(linkPtr, StartEdge_t, link);
+
+        edgePtr->nodePtr->waitCount--;
+
+        le_mem_Release(edgePtr);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Body of the start helper threads.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* StartThreadMain
+(
+    void* contextPtr                ///< [IN] Not used.
+)
+{
+    // Setting up a sandbox reads and writes the config tree.
+    le_cfg_ConnectService();
+
+    le_event_RunLoop();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Launches the auto-start apps whose dependencies have been launched.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ScheduleApps
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Launches an app whose sandbox has been prepared by a helper thread.  Queued to the main thread
+ * by PrepareSandbox().
+ */
+//--------------------------------------------------------------------------------------------------
+static void SandboxPrepared
+(
+    void* param1Ptr,                ///< [IN] Start node of the app.
+    void* param2Ptr                 ///< [IN] Not used.
+)
+{
+    StartNode_t* nodePtr = param1Ptr;
+    AppContainer_t* appContainerPtr = nodePtr->appContainerPtr;
+
+    StartThreadBusy[nodePtr->threadIndex] = false;
+    StartsInProgress--;
+
+    // Put the container back where StartApp() expects it.
+    le_dls_Queue(&InactiveAppsList, &(appContainerPtr->link));
+
+    if (!framework_IsStopping())
+    {
+        // No need to check the return code because there is nothing we can do about errors.
+        StartApp(appContainerPtr);
+    }
+
+    ReleaseDependents(nodePtr);
+
+    ScheduleApps();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Prepares an app's sandbox.  Queued to a start helper thread by ScheduleApps().
+ */
+//--------------------------------------------------------------------------------------------------
+static void PrepareSandbox
+(
+    void* param1Ptr,                ///< [IN] Start node of the app.
+    void* param2Ptr                 ///< [IN] Not used.
+)
+{
+    StartNode_t* nodePtr = param1Ptr;
+    AppContainer_t* appContainerPtr = nodePtr->appContainerPtr;
+
+    le_clk_Time_t prepareTime = le_clk_GetRelativeTime();
+
+    bootTrace_Record(BOOT_TRACE_BEGIN, "sandbox %s", nodePtr->appName);
+
+    // On failure app_Start() will try again and report the error.
+    if (app_PrepareSandbox(appContainerPtr->appRef) == LE_OK)
+    {
+        appContainerPtr->startTimes.sandboxMs = GetElapsedMs(prepareTime);
+    }
+
+    bootTrace_Record(BOOT_TRACE_END, "sandbox %s", nodePtr->appName);
+
+    le_event_QueueFunctionToThread(MainThreadRef, SandboxPrepared, nodePtr, NULL);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Releases the start scheduler's nodes once all the apps have been launched.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FinishAutoStart
+(
+    void
+)
+{
+    size_t appCount = 0;
+    le_dls_Link_t* linkPtr;
+
+    while ((linkPtr = le_dls_Pop(&StartList)) != NULL)
+    {
+        le_mem_Release(CONTAINER_OF(linkPtr, StartNode_t, link));
+        appCount++;
+    }
+
+    LE_INFO("Auto-started %zu apps in %u ms.", appCount, GetElapsedMs(AutoStartTime));
+
+    bootTrace_Record(BOOT_TRACE_END, "app auto-start");
+    bootTrace_Complete();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Launches the auto-start apps whose dependencies have been launched, handing their sandbox
+ * preparation to idle helper threads.  Called again each time a helper thread finishes.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ScheduleApps
+(
+    void
+)
+{
+    while (true)
+    {
+        // Find the first app, in config order, that isn't waiting for anything.
+        StartNode_t* readyNodePtr = NULL;
+        StartNode_t* firstWaitingPtr = NULL;
+        le_dls_Link_t* linkPtr = le_dls_Peek(&StartList);
+
+        while (linkPtr != NULL)
+        {
+            StartNode_t* nodePtr = CONTAINER_OF(linkPtr, StartNode_t, link);
+
+            if (nodePtr->state == START_WAITING)
+            {
+                if (firstWaitingPtr == NULL)
+                {
+                    firstWaitingPtr = nodePtr;
+                }
+
+                if (nodePtr->waitCount == 0)
+                {
+                    readyNodePtr = nodePtr;
+                    break;
+                }
+            }
+
+            linkPtr = le_dls_PeekNext(&StartList, linkPtr);
+        }
+
+        if (readyNodePtr == NULL)
+        {
+            if (StartsInProgress > 0)
+            {
+                // Wait for a helper thread to finish.
+                return;
+            }
+
+            if (firstWaitingPtr == NULL)
+            {
+                FinishAutoStart();
+                return;
+            }
+
+            // Everything left waits on something else that is left, so there's a loop.
+            LE_WARN("Auto-start apps have a dependency loop.  Starting '%s' anyway.",
+                    firstWaitingPtr->appName);
+
+            readyNodePtr = firstWaitingPtr;
+        }
+
+        // Find an idle helper thread.
+        size_t threadIndex = 0;
+
+        while ( (threadIndex < StartThreadCount) && StartThreadBusy[threadIndex] )
+        {
+            threadIndex++;
+        }
+
+        if ( (StartThreadCount > 0) && (threadIndex == StartThreadCount) )
+        {
+            return;
+        }
+
+        AppContainer_t* appContainerPtr;
+
+        if ( (CreateApp(readyNodePtr->appName, &appContainerPtr) != LE_OK) ||
+             appContainerPtr->isActive )
+        {
+            // Either not properly installed (already logged) or someone started it already.
+            ReleaseDependents(readyNodePtr);
+            continue;
+        }
+
+        readyNodePtr->appContainerPtr = appContainerPtr;
+
+        appContainerPtr->startTimes.requestTime = AutoStartTime;
+        appContainerPtr->startTimes.waitMs = GetElapsedMs(AutoStartTime);
+        appContainerPtr->startTimes.sandboxMs = 0;
+
+        if (StartThreadCount == 0)
+        {
+            // No need to check the return code because there is nothing we can do about errors.
+            StartApp(appContainerPtr);
+            ReleaseDependents(readyNodePtr);
+            continue;
+        }
+
+        // Hide the container from the app lists while a helper thread works on it.
+        le_dls_Remove(&InactiveAppsList, &(appContainerPtr->link));
+
+        readyNodePtr->state = START_PREPARING;
+        readyNodePtr->threadIndex = threadIndex;
+        StartThreadBusy[threadIndex] = true;
+        StartsInProgress++;
+
+        le_event_QueueFunctionToThread(StartThreads[threadIndex],
+                                       PrepareSandbox,
+                                       readyNodePtr,
+                                       NULL);
+    }
+}
+
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Handle application fault.  Gets the application fault action for the process that terminated
@@ -848,6 +1455,27 @@ static void DeletesInactiveApp
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Drops the cached runtime area of an active app that has just been (re)installed.  Inactive apps
+ * are deleted by DeletesInactiveApp() instead.
+ */
+//--------------------------------------------------------------------------------------------------
+static void InvalidateSandboxCache
+(
+    const char* appName,  ///< App being installed.
+    void* contextPtr      ///< Context for this function.  Not used.
+)
+{
+    AppContainer_t* appContainerPtr = GetActiveApp(appName);
+
+    if (appContainerPtr != NULL)
+    {
+        app_InvalidateSandboxCache(appContainerPtr->appRef);
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Deletes all inactive app objects.
@@ -1277,6 +1905,8 @@ void apps_Init
     // Create memory pools.
     AppContainerPool = le_mem_CreatePool("appContainers", sizeof(AppContainer_t));
     AppProcContainerPool = le_mem_CreatePool("appProcContainers", sizeof(AppProcContainer_t));
+    StartNodePool = le_mem_CreatePool("appStartNodes", sizeof(StartNode_t));
+    StartEdgePool = le_mem_CreatePool("appStartEdges", sizeof(StartEdge_t));
 
     AppProcMap = le_ref_CreateMap("AppProcs", 5);
     AppMap = le_ref_CreateMap("App", 5);
@@ -1284,6 +1914,7 @@ void apps_Init
 
     le_instStat_AddAppUninstallEventHandler(DeletesInactiveApp, NULL);
     le_instStat_AddAppInstallEventHandler(DeletesInactiveApp, NULL);
+    le_instStat_AddAppInstallEventHandler(InvalidateSandboxCache, NULL);
 
     le_msg_AddServiceCloseHandler(le_appProc_GetServiceRef(), DeleteClientAppProcs, NULL);
 
@@ -1368,6 +1999,12 @@ void apps_SetShutdownHandler
 //--------------------------------------------------------------------------------------------------
 /**
  * Start all applications marked as 'auto' start.
+ *
+ * Apps are launched in dependency order: an app is launched only after the apps it has IPC bindings
+ * to, and the apps listed in its startAfter node, have been launched.  Independent apps have their
+ * sandboxes prepared concurrently on helper threads, and are then launched on the main thread.
+ * This function returns once the first apps have been scheduled; the rest follow from the event
+ * loop.
  */
 //--------------------------------------------------------------------------------------------------
 void apps_AutoStart
@@ -1375,6 +2012,11 @@ void apps_AutoStart
     void
 )
 {
+    AutoStartTime = le_clk_GetRelativeTime();
+    MainThreadRef = le_thread_GetCurrent();
+
+    bootTrace_Record(BOOT_TRACE_BEGIN, "app auto-start");
+
     // Read the list of applications from the config tree.
     le_cfg_IteratorRef_t appCfg = le_cfg_CreateReadTxn(CFG_NODE_APPS_LIST);
 
@@ -1384,6 +2026,9 @@ void apps_AutoStart
 
         le_cfg_CancelTxn(appCfg);
 
+        bootTrace_Record(BOOT_TRACE_END, "app auto-start");
+        bootTrace_Complete();
+
         return;
     }
 
@@ -1393,25 +2038,59 @@ void apps_AutoStart
         if (!le_cfg_GetBool(appCfg, CFG_NODE_START_MANUAL, false))
         {
             // Get the app name.
-            char appName[LIMIT_MAX_APP_NAME_BYTES];
+            StartNode_t* nodePtr = le_mem_ForceAlloc(StartNodePool);
 
-            if (le_cfg_GetNodeName(appCfg, "", appName, sizeof(appName)) == LE_OVERFLOW)
+            if (le_cfg_GetNodeName(appCfg, "", nodePtr->appName, sizeof(nodePtr->appName))
+                == LE_OVERFLOW)
             {
                 LE_ERROR("AppName buffer was too small, name truncated to '%s'.  "
                          "Max app name in bytes, %d.  Application not launched.",
-                         appName, LIMIT_MAX_APP_NAME_BYTES);
+                         nodePtr->appName, LIMIT_MAX_APP_NAME_BYTES);
+
+                le_mem_Release(nodePtr);
             }
             else
             {
-                // Launch the application now.  No need to check the return code because there is
-                // nothing we can do about errors.
-                LaunchApp(appName);
+                nodePtr->link = LE_DLS_LINK_INIT;
+                nodePtr->state = START_WAITING;
+                nodePtr->waitCount = 0;
+                nodePtr->dependents = LE_SLS_LIST_INIT;
+                nodePtr->appContainerPtr = NULL;
+                nodePtr->threadIndex = 0;
+
+                le_dls_Queue(&StartList, &(nodePtr->link));
             }
         }
     }
     while (le_cfg_GoToNextSibling(appCfg) == LE_OK);
 
     le_cfg_CancelTxn(appCfg);
+
+    // Build the dependency graph.
+    le_dls_Link_t* linkPtr = le_dls_Peek(&StartList);
+
+    while (linkPtr != NULL)
+    {
+        AddStartDependencies(CONTAINER_OF(linkPtr, StartNode_t, link));
+
+        linkPtr = le_dls_PeekNext(&StartList, linkPtr);
+    }
+
+    // Create the helper threads, if they haven't been already.
+    while (StartThreadCount < LE_CONFIG_SUPERV_APP_START_THREADS)
+    {
+        char threadName[LIMIT_MAX_THREAD_NAME_BYTES];
+
+        snprintf(threadName, sizeof(threadName), "appStart%zu", StartThreadCount);
+
+        StartThreads[StartThreadCount] = le_thread_Create(threadName, StartThreadMain, NULL);
+        StartThreadBusy[StartThreadCount] = false;
+        le_thread_Start(StartThreads[StartThreadCount]);
+
+        StartThreadCount++;
+    }
+
+    ScheduleApps();
 }
 
 
@@ -2120,6 +2799,57 @@ void le_appCtrl_Stop
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the timings of the last start of an app.  This function is called by the event loop when a
+ * separate process requests them.
+ *
+ * @note
+ *   The result code for this command should be sent back to the requesting process via
+ *   le_appCtrl_GetStartTimesRespond(). The possible result codes are:
+ *
+ *      LE_OK if successful.
+ *      LE_NOT_FOUND if the app has not been started since the Supervisor started.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_appCtrl_GetStartTimes
+(
+    le_appCtrl_ServerCmdRef_t cmdRef,   ///< [IN] Command reference that must be passed to this
+                                        ///       command's response function.
+    const char* appName                 ///< [IN] Name of the application.
+)
+{
+    if (!IsAppNameValid(appName))
+    {
+        LE_KILL_CLIENT("Invalid app name.");
+        le_appCtrl_GetStartTimesRespond(cmdRef, LE_FAULT, 0, 0, 0, 0);
+        return;
+    }
+
+    AppContainer_t* appContainerPtr = GetActiveApp(appName);
+
+    if (appContainerPtr == NULL)
+    {
+        appContainerPtr = GetInactiveApp(appName);
+    }
+
+    if ( (appContainerPtr == NULL) || !appContainerPtr->startTimes.isValid )
+    {
+        le_appCtrl_GetStartTimesRespond(cmdRef, LE_NOT_FOUND, 0, 0, 0, 0);
+        return;
+    }
+
+    const AppStartTimes_t* timesPtr = &(appContainerPtr->startTimes);
+
+    le_appCtrl_GetStartTimesRespond(cmdRef,
+                                    LE_OK,
+                                    timesPtr->waitMs,
+                                    timesPtr->sandboxMs,
+                                    timesPtr->launchMs,
+                                    timesPtr->totalMs);
+}
+
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -14,6 +14,7 @@
 #include "smack.h"
 #include "sysPaths.h"
 #include "wait.h"
+#include "bootTrace.h"
 
 
 //--------------------------------------------------------------------------------------------------
@@ -325,7 +326,11 @@ void fwDaemons_Start
 
     for (i = 0; i < NUM_ARRAY_MEMBERS(FrameworkDaemons); i++)
     {
+        const char* daemonNamePtr = le_path_GetBasenamePtr(FrameworkDaemons[i].path, "/");
+
+        bootTrace_Record(BOOT_TRACE_BEGIN, "daemon %s", daemonNamePtr);
         StartDaemon(&(FrameworkDaemons[i]));
+        bootTrace_Record(BOOT_TRACE_END, "daemon %s", daemonNamePtr);
     }
 
     LE_INFO("All framework daemons ready.");
@@ -90,6 +90,21 @@
 #define ARRAY_LENGTH(array) (sizeof(array)/sizeof(array[0]))
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * State of a module in the boot-time module loader.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    BOOT_LOAD_NONE = 0,     ///< Module is not loaded at boot.
+    BOOT_LOAD_WAITING,      ///< Waiting for its required modules to be loaded.
+    BOOT_LOAD_QUEUED,       ///< Handed to a loader thread.
+    BOOT_LOAD_DONE          ///< Loaded, already loaded, or failed.
+}
+BootLoadState_t;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Legato kernel module object.
@@ -122,6 +137,8 @@ typedef struct
                                                              // traversing to detect cycle
     bool               recurStack;                           // Track recursion stack while
                                                              // traversing to detect cycle
+    BootLoadState_t    bootLoadState;                        // State in the boot-time loader
+    le_result_t        bootLoadResult;                       // Result of loading at boot
 }
 KModuleObj_t;
 
@@ -157,6 +174,39 @@ static le_dls_List_t ModuleAlphaOrderList = LE_DLS_LIST_INIT;
 static le_sls_List_t CyclicDependencyList = LE_SLS_LIST_INIT;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of threads loading kernel modules at boot.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_LOAD_THREADS 16
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queues between the boot-time module loader and its threads.  Modules are linked into these lists
+ * through their dependencyLink.
+ */
+//--------------------------------------------------------------------------------------------------
+static struct {
+    le_dls_List_t       readyList;         // modules waiting for a loader thread
+    le_dls_List_t       doneList;          // modules loaded by a loader thread
+    le_sem_Ref_t        readySem;          // posted for each module queued on readyList
+    le_sem_Ref_t        doneSem;           // posted for each module queued on doneList
+} BootLoader;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mutex protecting the boot loader queues and the use counts of system dependency modules, which
+ * are accessed by the loader threads.
+ */
+//--------------------------------------------------------------------------------------------------
+static pthread_mutex_t Mutex = PTHREAD_MUTEX_INITIALIZER;
+#define LOCK    LE_ASSERT(pthread_mutex_lock(&Mutex) == 0);
+#define UNLOCK  LE_ASSERT(pthread_mutex_unlock(&Mutex) == 0);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Free list of module parameters starting from argv[2]
@@ -929,6 +979,8 @@ static void ModuleInsert(char *modName)
     m->isCyclicDependency = false;
     m->visited = false;
     m->recurStack = false;
+    m->bootLoadState = BOOT_LOAD_NONE;
+    m->bootLoadResult = LE_OK;
 
     ModuleGetLoad(m);            /* Read load from configTree */
     ModuleGetIsOptional(m);      /* Read if the module is optional from configTree */
@@ -1023,6 +1075,189 @@ static le_result_t TraverseDependencyInsert
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Insert a Legato kernel module with its parameters.
+ *
+ * The module file is handed to the kernel directly with finit_module(), which saves forking and
+ * exec'ing insmod.  insmod is only used if the kernel does not support finit_module().
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t InsertModuleFile(KModuleObj_t *mod)
+{
+#ifdef SYS_finit_module
+    /* Parameters are passed to the kernel as one string, separated by spaces. */
+    char params[LE_CFG_STR_LEN_BYTES] = "";
+    int i;
+
+    for (i = 2; i < mod->argc; i++)
+    {
+        if (   ((i > 2) && (le_utf8_Append(params, " ", sizeof(params), NULL) != LE_OK))
+            || (le_utf8_Append(params, mod->argv[i], sizeof(params), NULL) != LE_OK) )
+        {
+            LE_ERROR("Parameters of module '%s' are too long.", mod->name);
+            return LE_FAULT;
+        }
+    }
+
+    LE_INFO("Insert '%s' %s", mod->path, params);
+
+    int fd;
+    while (((fd = open(mod->path, O_RDONLY | O_CLOEXEC)) == -1) && (errno == EINTR)) {}
+
+    if (fd == -1)
+    {
+        LE_CRIT("Could not open module '%s'. (%m)", mod->path);
+        return LE_FAULT;
+    }
+
+    int rc = syscall(SYS_finit_module, fd, params, 0);
+    int savedErrno = errno;
+
+    fd_Close(fd);
+
+    if (rc == 0)
+    {
+        return LE_OK;
+    }
+
+    if (savedErrno == EEXIST)
+    {
+        LE_INFO("Module '%s' is already loaded.", mod->name);
+        return LE_OK;
+    }
+
+    if (savedErrno != ENOSYS)
+    {
+        errno = savedErrno;
+        LE_CRIT("Could not insert module '%s'. (%m)", mod->path);
+        return LE_FAULT;
+    }
+#endif
+
+    mod->argv[0] = INSMOD_COMMAND;
+
+    return ExecuteCommand(mod->argv, mod->argc, NULL);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Load a single kernel module whose required modules are already loaded.
+ * modprobe the system dependency modules and insert the Legato kernel module, or run its install
+ * script if it has one.
+ *
+ * @note This may be called from a module loader thread.
+ *
+ * @return
+ *      LE_OK if the module was loaded, or if it is optional and failed to load.
+ *      Otherwise an error code.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t LoadModule(KModuleObj_t *mod)
+{
+    le_result_t result;
+    ProcModules_t procModules;
+    le_sls_Link_t *depModNameLinkPtr = le_sls_Peek(&(mod->dependsModuleName));
+
+    while (depModNameLinkPtr != NULL)
+    {
+        /* Install dependency system modules if any before installing the Legato module */
+        DepModNameNode_t* depModNameNodePtr = CONTAINER_OF(depModNameLinkPtr,
+                                                           DepModNameNode_t, link);
+        char *depargv[] = {MODPROBE_COMMAND, depModNameNodePtr->modName, NULL};
+
+        result = ExecuteCommand(depargv, ARRAY_LENGTH(depargv)-1, NULL);
+        if (result != LE_OK)
+        {
+            LE_CRIT("Command '%s' '%s' execution failed.", depargv[0], depargv[1]);
+            return result;
+        }
+
+        LOCK
+        DepModNameNode_t *depModPtr = le_hashmap_Get(KModuleHandler.dependModuleTable,
+                                                     depModNameNodePtr->modName);
+        if (depModPtr != NULL)
+        {
+            depModPtr->useCount++;
+        }
+        UNLOCK
+
+        if (depModPtr == NULL)
+        {
+            LE_ERROR("Lookup for module '%s' failed.", depModNameNodePtr->modName);
+            return LE_NOT_FOUND;
+        }
+
+        depModNameLinkPtr = le_sls_PeekNext(&(mod->dependsModuleName), depModNameLinkPtr);
+    }
+
+    /* If install script is provided, execute the script otherwise insert the module */
+    if (strcmp(mod->installScript, "") != 0)
+    {
+        char *scriptargv[] = {mod->installScript, mod->path, NULL};
+
+        result = ExecuteCommand(scriptargv, ARRAY_LENGTH(scriptargv)-1, NULL);
+        if (result != LE_OK)
+        {
+            LE_CRIT("Install script '%s' execution failed", mod->installScript);
+
+            if (mod->isOptional)
+            {
+                return LE_OK;
+            }
+            return result;
+        }
+
+        /* Read module load status from /proc/modules */
+        procModules =  CheckProcModules(mod->name);
+
+        if (procModules.loadStatus != STATUS_INSTALLED)
+        {
+            LE_INFO("Module '%s' not in 'Live' state, wait for 10 seconds.", mod->name);
+            sleep(10);
+
+            /* If the module is not in live state, wait for 10 seconds to see if the
+             * module recovers to live state, otherwise restart the system.
+             */
+            if (procModules.loadStatus != STATUS_INSTALLED)
+            {
+                if (mod->isOptional)
+                {
+                    LE_INFO(
+                        "Module '%s' not in 'Live' state and is optional. "
+                        "Skip restarting system.",
+                        mod->name);
+                    return LE_OK;
+                }
+
+                LE_CRIT("Module '%s' not in 'Live' state. Restart system ...", mod->name);
+                return LE_FAULT;
+            }
+        }
+    }
+    else
+    {
+        result = InsertModuleFile(mod);
+        if (result != LE_OK)
+        {
+            if (mod->isOptional)
+            {
+                LE_INFO("Ignoring failure. "
+                         "Module '%s' failed to load and is an optional module.", mod->name);
+                return LE_OK;
+            }
+            return result;
+        }
+    }
+
+    mod->moduleLoadStatus = STATUS_INSTALLED;
+    LE_INFO("New kernel module '%s'", mod->name);
+
+    return LE_OK;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Install each kernel module.
@@ -1035,7 +1270,6 @@ static le_result_t InstallEachKernelModule(KModuleObj_t *m, bool enableUseCount)
     le_dls_Link_t *listLink;
     /* The ordered list of required kernel modules to install */
     le_dls_List_t ModuleInsertList = LE_DLS_LIST_INIT;
-    ProcModules_t procModules;
 
     result = TraverseDependencyInsert(&ModuleInsertList, m, enableUseCount);
     if (result != LE_OK)
@@ -1061,97 +1295,11 @@ static le_result_t InstallEachKernelModule(KModuleObj_t *m, bool enableUseCount)
 
         if (mod->moduleLoadStatus != STATUS_INSTALLED)
         {
-            le_sls_Link_t *depModNameLinkPtr = le_sls_Peek(&(mod->dependsModuleName));
-
-            while (depModNameLinkPtr != NULL)
-            {
-                /* Install dependency system modules if any before installing the Legato module */
-                DepModNameNode_t* depModNameNodePtr = CONTAINER_OF(depModNameLinkPtr,
-                                                                   DepModNameNode_t, link);
-                char *depargv[] = {MODPROBE_COMMAND, depModNameNodePtr->modName, NULL};
-
-                result = ExecuteCommand(depargv, ARRAY_LENGTH(depargv)-1, NULL);
-                if (result != LE_OK)
-                {
-                    LE_CRIT("Command '%s' '%s' execution failed.", depargv[0], depargv[1]);
-                    return result;
-                }
-
-                DepModNameNode_t *depModPtr = le_hashmap_Get(KModuleHandler.dependModuleTable,
-                                                             depModNameNodePtr->modName);
-                if (depModPtr == NULL)
-                {
-                    LE_ERROR("Lookup for module '%s' failed.", depModNameNodePtr->modName);
-                    return LE_NOT_FOUND;
-                }
-
-                depModPtr->useCount++;
-                depModNameLinkPtr = le_sls_PeekNext(&(mod->dependsModuleName), depModNameLinkPtr);
-            }
-
-            /* If install script is provided, execute the script otherwise execute insmod */
-            if (strcmp(mod->installScript, "") != 0)
+            result = LoadModule(mod);
+            if (result != LE_OK)
             {
-                char *scriptargv[] = {mod->installScript, mod->path, NULL};
-
-                result = ExecuteCommand(scriptargv, ARRAY_LENGTH(scriptargv)-1, NULL);
-                if (result != LE_OK)
-                {
-                    LE_CRIT("Install script '%s' execution failed", mod->installScript);
-
-                    if (mod->isOptional)
-                    {
-                        continue;
-                    }
-                    return result;
-                }
-
-                /* Read module load status from /proc/modules */
-                procModules =  CheckProcModules(mod->name);
-
-                if (procModules.loadStatus != STATUS_INSTALLED)
-                {
-                    LE_INFO("Module '%s' not in 'Live' state, wait for 10 seconds.", mod->name);
-                    sleep(10);
-
-                    /* If the module is not in live state, wait for 10 seconds to see if the
-                     * module recovers to live state, otherwise restart the system.
-                     */
-                    if (procModules.loadStatus != STATUS_INSTALLED)
-                    {
-                        if (mod->isOptional)
-                        {
-                            LE_INFO(
-                                "Module '%s' not in 'Live' state and is optional. "
-                                "Skip restarting system.",
-                                mod->name);
-                            continue;
-                        }
-
-                        LE_CRIT("Module '%s' not in 'Live' state. Restart system ...", mod->name);
-                        return LE_FAULT;
-                    }
-                }
+                return result;
             }
-            else
-            {
-                mod->argv[0] = INSMOD_COMMAND;
-
-                result = ExecuteCommand(mod->argv, mod->argc, NULL);
-                if (result != LE_OK)
-                {
-                    if (mod->isOptional)
-                    {
-                        LE_INFO("Ignoring failure. "
-                                 "Module '%s' failed to load and is an optional module.", mod->name);
-                        continue;
-                    }
-                    return result;
-                }
-            }
-
-            mod->moduleLoadStatus = STATUS_INSTALLED;
-            LE_INFO("New kernel module '%s'", mod->name);
         }
     }
     return LE_OK;
@@ -1241,9 +1389,219 @@ static void setIsRequiredModule()
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read /proc/modules once and mark the modules that are already live as installed, so that the
+ * boot-time loader does not have to check each of them separately.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReadProcModules(void)
+{
+    FILE* fPtr;
+    char line[500];
+    char scanModName[LE_CFG_STR_LEN_BYTES];
+    char modStatus[10];
+    int size;
+    int usedbyNumMod;
+    char usedbyName[200];
+
+    fPtr = fopen("/proc/modules", "r");
+    if (fPtr == NULL)
+    {
+        LE_CRIT("Error in opening file /proc/modules");
+        return;
+    }
+
+    while (fgets(line, sizeof(line), fPtr))
+    {
+        if (sscanf(line, "%511s %d %d %199s %9s",
+                   scanModName, &size, &usedbyNumMod, usedbyName, modStatus) != 5)
+        {
+            continue;
+        }
+
+        /* Modules in the module table are named after their .ko file */
+        if (le_utf8_Append(scanModName, KERNEL_MODULE_FILE_EXTENSION, sizeof(scanModName), NULL)
+            != LE_OK)
+        {
+            continue;
+        }
+
+        KModuleObj_t *modPtr = le_hashmap_Get(KModuleHandler.moduleTable, scanModName);
+
+        if ((modPtr != NULL) && (strcmp(modStatus, "Live") == 0))
+        {
+            LE_INFO("Module '%s' is already loaded.", modPtr->name);
+            modPtr->moduleLoadStatus = STATUS_INSTALLED;
+        }
+    }
+
+    fclose(fPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Main function of a boot-time module loader thread.  Loads modules from the ready list until it
+ * finds the list empty.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* LoaderThreadMain(void* contextPtr)
+{
+    LE_UNUSED(contextPtr);
+
+    while (1)
+    {
+        le_sem_Wait(BootLoader.readySem);
+
+        LOCK
+        le_dls_Link_t *linkPtr = le_dls_Pop(&BootLoader.readyList);
+        UNLOCK
+
+        if (linkPtr == NULL)
+        {
+            return NULL;
+        }
+
+        KModuleObj_t *mod = CONTAINER_OF(linkPtr, KModuleObj_t, dependencyLink);
+
+        mod->bootLoadResult = LoadModule(mod);
+
+        LOCK
+        le_dls_Queue(&BootLoader.doneList, &(mod->dependencyLink));
+        UNLOCK
+
+        le_sem_Post(BootLoader.doneSem);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if all of the modules that a module requires have been dealt with by the boot-time loader.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsReadyToLoad(KModuleObj_t *m)
+{
+    le_sls_Link_t* modNameLinkPtr = le_sls_Peek(&(m->reqModuleName));
+
+    while (modNameLinkPtr != NULL)
+    {
+        ModNameNode_t* modNameNodePtr = CONTAINER_OF(modNameLinkPtr, ModNameNode_t, link);
+        KModuleObj_t *reqModPtr = le_hashmap_Get(KModuleHandler.moduleTable,
+                                                 modNameNodePtr->modName);
+
+        if ((reqModPtr != NULL) && (reqModPtr->bootLoadState != BOOT_LOAD_DONE))
+        {
+            return false;
+        }
+
+        modNameLinkPtr = le_sls_PeekNext(&(m->reqModuleName), modNameLinkPtr);
+    }
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hand all the modules whose required modules are loaded to the loader threads, or load them
+ * right away if there are no loader threads.
+ *
+ * @return
+ *      Number of modules handed over.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t QueueReadyModules(size_t threadCount)
+{
+    size_t count = 0;
+    le_dls_Link_t* linkPtr = le_dls_Peek(&ModuleAlphaOrderList);
+
+    while (linkPtr != NULL)
+    {
+        KModuleObj_t *modPtr = CONTAINER_OF(linkPtr, KModuleObj_t, alphabeticalLink);
+
+        if ((modPtr->bootLoadState == BOOT_LOAD_WAITING) && IsReadyToLoad(modPtr))
+        {
+            modPtr->bootLoadState = BOOT_LOAD_QUEUED;
+            count++;
+
+            if (threadCount == 0)
+            {
+                modPtr->bootLoadResult = LoadModule(modPtr);
+                le_dls_Queue(&BootLoader.doneList, &(modPtr->dependencyLink));
+                le_sem_Post(BootLoader.doneSem);
+            }
+            else
+            {
+                LOCK
+                le_dls_Queue(&BootLoader.readyList, &(modPtr->dependencyLink));
+                UNLOCK
+
+                le_sem_Post(BootLoader.readySem);
+            }
+        }
+
+        linkPtr = le_dls_PeekNext(&ModuleAlphaOrderList, linkPtr);
+    }
+
+    return count;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Report the modules that were to be loaded at boot but were never handed to the loader, because
+ * loading stopped after a failure or because some module they require never got loaded.
+ *
+ * @return
+ *      - LE_OK if only optional modules were left out, or loading had already failed.
+ *      - LE_FAULT if a module that is not optional was left out.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReportUnloadedModules(bool afterFailure)
+{
+    le_result_t result = LE_OK;
+    le_dls_Link_t* linkPtr = le_dls_Peek(&ModuleAlphaOrderList);
+
+    while (linkPtr != NULL)
+    {
+        KModuleObj_t *modPtr = CONTAINER_OF(linkPtr, KModuleObj_t, alphabeticalLink);
+
+        if (modPtr->bootLoadState == BOOT_LOAD_WAITING)
+        {
+            if (afterFailure)
+            {
+                LE_ERROR("Module '%s' not loaded due to an earlier failure.", modPtr->name);
+            }
+            else if (modPtr->isOptional)
+            {
+                LE_WARN("Module '%s' not loaded as its required modules were not loaded, "
+                        "ignore as module is optional", modPtr->name);
+            }
+            else
+            {
+                LE_CRIT("Module '%s' not loaded as its required modules were not loaded.",
+                        modPtr->name);
+                result = LE_FAULT;
+            }
+        }
+
+        linkPtr = le_dls_PeekNext(&ModuleAlphaOrderList, linkPtr);
+    }
+
+    return result;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Iterate through the module table and install kernel module
+ *
+ * The modules to load and their dependencies are worked out once up front, and /proc/modules is
+ * read once to skip the modules that are already loaded.  The modules are then loaded by a pool
+ * of threads, each module as soon as all the modules it requires are loaded, so independent
+ * modules load in parallel.
  */
 //--------------------------------------------------------------------------------------------------
 static void installModules()
@@ -1251,6 +1609,8 @@ static void installModules()
     KModuleObj_t *modPtr;
     le_result_t result;
     le_dls_Link_t* linkPtr;
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+    size_t moduleCount = 0;
 
     /* Traverse linked list in alphabetical order of module name and traverse dependencies. */
     linkPtr = le_dls_Peek(&ModuleAlphaOrderList);
@@ -1260,9 +1620,8 @@ static void installModules()
         LE_ASSERT(modPtr != NULL);
 
         /*
-         * Skip if the modules are loaded manually via app or if it is a required module.
+         * Skip if the modules are loaded manually via app.
          * If the module is load manual, it will be loaded when app starts.
-         * If the module is a required module, it will be loaded with its parent module.
          */
         if (modPtr->isLoadManual)
         {
@@ -1270,16 +1629,162 @@ static void installModules()
             continue;
         }
 
-        result = InstallEachKernelModule(modPtr, true);
-        if (result != LE_OK)
+        le_dls_List_t moduleInsertList = LE_DLS_LIST_INIT;
+
+        result = TraverseDependencyInsert(&moduleInsertList, modPtr, true);
+        if ((result != LE_OK) && !modPtr->isOptional)
         {
+            LE_ERROR("Traversing module '%s' dependencies failed, fault action will be taken",
+                     modPtr->name);
             LE_ERROR("Error in installing module %s. Restarting system ...", modPtr->name);
             framework_Reboot();
-            break;
+            return;
+        }
+
+        /* Everything traversed from a module that is loaded at boot is loaded at boot. */
+        le_dls_Link_t *listLink;
+        while ((listLink = le_dls_Pop(&moduleInsertList)) != NULL)
+        {
+            KModuleObj_t *mod = CONTAINER_OF(listLink, KModuleObj_t, dependencyLink);
+
+            if ((result == LE_OK) && (mod->bootLoadState == BOOT_LOAD_NONE))
+            {
+                mod->bootLoadState = BOOT_LOAD_WAITING;
+            }
+        }
+
+        if (result != LE_OK)
+        {
+            LE_WARN("Traversing module '%s' dependencies failed, ignore as module is optional",
+                    modPtr->name);
+        }
+
+        linkPtr = le_dls_PeekNext(&ModuleAlphaOrderList, linkPtr);
+    }
+
+    ReadProcModules();
+
+    linkPtr = le_dls_Peek(&ModuleAlphaOrderList);
+    while (linkPtr != NULL)
+    {
+        modPtr = CONTAINER_OF(linkPtr, KModuleObj_t, alphabeticalLink);
+
+        if (modPtr->bootLoadState == BOOT_LOAD_WAITING)
+        {
+            if (modPtr->moduleLoadStatus == STATUS_INSTALLED)
+            {
+                modPtr->bootLoadState = BOOT_LOAD_DONE;
+            }
+            else
+            {
+                moduleCount++;
+            }
         }
 
         linkPtr = le_dls_PeekNext(&ModuleAlphaOrderList, linkPtr);
     }
+
+    if (moduleCount == 0)
+    {
+        return;
+    }
+
+    /* Start the loader threads.  No more threads than modules are needed. */
+    size_t threadCount = LE_CONFIG_SUPERV_KMOD_LOAD_THREADS;
+    if (threadCount > moduleCount)
+    {
+        threadCount = moduleCount;
+    }
+
+    le_thread_Ref_t threads[MAX_LOAD_THREADS];
+    size_t i;
+
+    BootLoader.readyList = LE_DLS_LIST_INIT;
+    BootLoader.doneList = LE_DLS_LIST_INIT;
+    BootLoader.readySem = le_sem_Create("KModReady", 0);
+    BootLoader.doneSem = le_sem_Create("KModDone", 0);
+
+    for (i = 0; i < threadCount; i++)
+    {
+        char threadName[LIMIT_MAX_THREAD_NAME_BYTES];
+
+        snprintf(threadName, sizeof(threadName), "kmodLoad%zu", i);
+        threads[i] = le_thread_Create(threadName, LoaderThreadMain, NULL);
+        le_thread_SetJoinable(threads[i]);
+        le_thread_Start(threads[i]);
+    }
+
+    /* Hand over modules as their required modules get loaded.  After a failure, let the modules
+     * being loaded finish but do not start any more.
+     */
+    size_t inFlight = QueueReadyModules(threadCount);
+    size_t loadedCount = 0;
+
+    result = LE_OK;
+
+    while (inFlight > 0)
+    {
+        le_sem_Wait(BootLoader.doneSem);
+
+        LOCK
+        linkPtr = le_dls_Pop(&BootLoader.doneList);
+        UNLOCK
+
+        LE_ASSERT(linkPtr != NULL);
+        modPtr = CONTAINER_OF(linkPtr, KModuleObj_t, dependencyLink);
+        modPtr->bootLoadState = BOOT_LOAD_DONE;
+        inFlight--;
+        loadedCount++;
+
+        if (modPtr->bootLoadResult != LE_OK)
+        {
+            LE_ERROR("Error in installing module %s.", modPtr->name);
+            result = modPtr->bootLoadResult;
+        }
+
+        if (result == LE_OK)
+        {
+            inFlight += QueueReadyModules(threadCount);
+        }
+    }
+
+    /* Stop the loader threads: each one exits when it finds the ready list empty. */
+    for (i = 0; i < threadCount; i++)
+    {
+        le_sem_Post(BootLoader.readySem);
+    }
+
+    for (i = 0; i < threadCount; i++)
+    {
+        le_thread_Join(threads[i], NULL);
+    }
+
+    le_sem_Delete(BootLoader.readySem);
+    le_sem_Delete(BootLoader.doneSem);
+
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+
+    LE_INFO("Loaded %zu of %zu kernel modules in %u ms using %zu loader threads.",
+            loadedCount,
+            moduleCount,
+            (uint32_t)((elapsed.sec * 1000) + (elapsed.usec / 1000)),
+            threadCount);
+
+    if (loadedCount < moduleCount)
+    {
+        le_result_t unloadedResult = ReportUnloadedModules(result != LE_OK);
+
+        if (result == LE_OK)
+        {
+            result = unloadedResult;
+        }
+    }
+
+    if (result != LE_OK)
+    {
+        LE_ERROR("Restarting system ...");
+        framework_Reboot();
+    }
 }
 
 
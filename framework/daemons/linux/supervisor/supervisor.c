@@ -220,6 +220,7 @@
 #include "sysStatus.h"
 #include "ima.h"
 #include "fs.h"
+#include "bootTrace.h"
 
 
 //--------------------------------------------------------------------------------------------------
@@ -524,7 +525,9 @@ static void StartFramework
     alarm(30);
 
     // Start all framework daemons.
+    bootTrace_Record(BOOT_TRACE_BEGIN, "framework daemons");
     fwDaemons_Start();
+    bootTrace_Record(BOOT_TRACE_END, "framework daemons");
 
     // Connect to the services we need from the framework daemons.
     LE_DEBUG("---- Connecting to services ----");
@@ -536,7 +539,9 @@ static void StartFramework
     alarm(0);
 
     // Insert kernel modules
+    bootTrace_Record(BOOT_TRACE_BEGIN, "kernel modules");
     kernelModules_Insert();
+    bootTrace_Record(BOOT_TRACE_END, "kernel modules");
 
     // Advertise services.
     LE_DEBUG("---- Advertising the Supervisor's APIs ----");
@@ -549,6 +554,7 @@ static void StartFramework
     le_appProc_AdvertiseService();
     le_ima_AdvertiseService();
     le_kernelModule_AdvertiseService();
+    bootTrace_Record(BOOT_TRACE_MARK, "services advertised");
 
     // Close stdin (and reopen to /dev/null to be safe).
     // This signals to the parent process that it is now safe to start using the framework.
@@ -573,6 +579,7 @@ static void StartFramework
     else
     {
         LE_INFO("Skipping app auto-start.");
+        bootTrace_Complete();
     }
 }
 
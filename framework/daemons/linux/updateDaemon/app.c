@@ -40,6 +40,7 @@
 #include "sysPaths.h"
 #include "fileSystem.h"
 #include "ima.h"
+#include "fileStore.h"
 
 
 static const char* InstallHookScriptPath = "/legato/systems/current/bin/install-hook";
@@ -324,6 +325,14 @@ static le_result_t SetSmackPermReadOnlyDir
     }
 
     fts_close(ftsPtr);
+
+    // Now that the files have their final labels, share the ones that are identical to files
+    // installed by other apps or app versions.
+    if (result == LE_OK)
+    {
+        fileStore_Dedup(readOnlyPath);
+    }
+
     return (result == LE_OK) ? LE_OK:LE_FAULT;
 }
 
@@ -0,0 +1,982 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file appDelta.c
+ *
+ * Implementation of the Update Daemon's app delta module.  See appDelta.h for the delta format.
+ *
+ * The files are rebuilt one per pass of the event loop, so the rest of the daemon (including the
+ * watchdog kicks) keeps running while a large app is rebuilt.  Each file is streamed through a
+ * fixed size buffer straight into the new app's directory, without holding the installed file,
+ * the patch or the new file in memory, and is checked against the size and CRC32 that the
+ * manifest gives for it before it is kept.
+ *
+ * The paths listed in the manifest are resolved one component at a time from the directories of
+ * the installed app, of the new app and of the patches, without following symbolic links, so that
+ * a symbolic link in the installed app or in the payload can't make a file be read from, or
+ * written to, outside of these directories.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "limit.h"
+#include "fileDescriptor.h"
+#include "appDelta.h"
+
+
+/// Largest manifest line that is accepted: the fields plus a path.
+#define MAX_LINE_BYTES          (LIMIT_MAX_PATH_BYTES + 128)
+
+/// Magic number at the start of a patch, and size of the patch header.
+#define PATCH_MAGIC             "LEDELTA1"
+#define PATCH_HEADER_BYTES      32
+
+/// Size of a patch's control tuple: the diff length, the extra length and the seek offset.
+#define PATCH_CONTROL_BYTES     24
+
+/// Default permissions of the directories created for files whose parent isn't in the payload.
+#define DEFAULT_DIR_MODE        (S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH)
+
+
+/// Number of characters of an app's hash ID (an MD5 sum in hexadecimal).
+#define MD5_STRING_LENGTH       32
+
+
+/// Directory the delta payload was extracted into, and the directory of the installed version.
+static char DirPath[LIMIT_MAX_PATH_BYTES];
+static char BaseDirPath[LIMIT_MAX_PATH_BYTES];
+
+/// Open directories of the new app, of its patches (".delta"), and of the installed version (-1 if
+/// not applying a delta).
+static int DirFd = -1;
+static int PatchDirFd = -1;
+static int BaseDirFd = -1;
+
+/// Manifest being applied (NULL if not applying a delta).
+static FILE* ManifestFile = NULL;
+
+/// Function to call when done.
+static appDelta_DoneHandler_t DoneHandler = NULL;
+
+/// Incremented every time a delta is started or stopped, so that a pass that was queued for an
+/// earlier delta is ignored.
+static uint32_t Generation = 0;
+
+/// What has been done so far, and when the delta was started.
+static size_t CopiedCount;
+static size_t PatchedCount;
+static uint64_t BytesWritten;
+static le_clk_Time_t StartTime;
+
+/// Buffers used to stream the files.
+static uint8_t OutBuffer[64 * 1024];
+static uint8_t BaseBuffer[64 * 1024];
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode a signed 64-bit number stored as a bsdiff patch stores it (little-endian magnitude, with
+ * the sign in the most significant bit).
+ *
+ * @return The number.
+ */
+//--------------------------------------------------------------------------------------------------
+static int64_t DecodeNumber
+(
+    const uint8_t* bytesPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    int64_t value = bytesPtr[7] & 0x7F;
+    int i;
+
+    for (i = 6; i >= 0; i--)
+    {
+        value = (value << 8) + bytesPtr[i];
+    }
+
+    return (bytesPtr[7] & 0x80) ? -value : value;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read exactly a number of bytes at an offset of a file.
+ *
+ * @return LE_OK if successful, LE_FORMAT_ERROR if the file is too short, LE_FAULT on error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReadAt
+(
+    int fd,
+    void* bufferPtr,
+    size_t size,
+    off_t offset
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t count = 0;
+
+    while (count < size)
+    {
+        ssize_t result = pread(fd, (uint8_t*)bufferPtr + count, size - count, offset + count);
+
+        if (result == 0)
+        {
+            return LE_FORMAT_ERROR;
+        }
+
+        if (result == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            LE_ERROR("Read failed (%m).");
+            return LE_FAULT;
+        }
+
+        count += result;
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write a buffer to the new file, and add it to the file's CRC32.
+ *
+ * @return LE_OK if successful, LE_FAULT on error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t Write
+(
+    int fd,
+    uint8_t* bufferPtr,
+    size_t size,
+    uint32_t* crcPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (fd_WriteSize(fd, bufferPtr, size) != (ssize_t)size)
+    {
+        LE_ERROR("Write failed (%m).");
+        return LE_FAULT;
+    }
+
+    *crcPtr = le_crc_Crc32(bufferPtr, size, *crcPtr);
+    BytesWritten += size;
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copy the installed file into the new file.
+ *
+ * @return LE_OK if successful, LE_FAULT on error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t CopyFile
+(
+    int baseFd,
+    int outFd,
+    uint64_t size,
+    uint32_t* crcPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint64_t offset = 0;
+
+    while (offset < size)
+    {
+        size_t count = (size - offset > sizeof(OutBuffer)) ? sizeof(OutBuffer) : (size - offset);
+        le_result_t result = ReadAt(baseFd, OutBuffer, count, offset);
+
+        if (result != LE_OK)
+        {
+            return (result == LE_FORMAT_ERROR) ? LE_FAULT : result;
+        }
+
+        result = Write(outFd, OutBuffer, count, crcPtr);
+
+        if (result != LE_OK)
+        {
+            return result;
+        }
+
+        offset += count;
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Rebuild the new file from the installed file and a patch.  Each control tuple of the patch adds
+ * a run of diff bytes to the installed file's bytes, appends a run of extra bytes, and then moves
+ * the position in the installed file.
+ *
+ * @return LE_OK if successful, LE_FORMAT_ERROR if the patch is malformed, LE_FAULT on error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t PatchFile
+(
+    int baseFd,
+    int64_t baseSize,
+    int patchFd,
+    int outFd,
+    int64_t size,
+    uint32_t* crcPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    struct stat patchStat;
+    uint8_t header[PATCH_HEADER_BYTES];
+
+    if (fstat(patchFd, &patchStat) == -1)
+    {
+        LE_ERROR("Could not stat patch (%m).");
+        return LE_FAULT;
+    }
+
+    le_result_t result = ReadAt(patchFd, header, sizeof(header), 0);
+
+    if (result != LE_OK)
+    {
+        return result;
+    }
+
+    int64_t controlSize = DecodeNumber(header + 8);
+    int64_t diffSize = DecodeNumber(header + 16);
+
+    // The header was read, so the patch is at least PATCH_HEADER_BYTES long.  Compare each block
+    // size with what is left of the patch rather than adding them up, which could overflow.
+    if ((memcmp(header, PATCH_MAGIC, 8) != 0) ||
+        (DecodeNumber(header + 24) != size) ||
+        (controlSize < 0) || (diffSize < 0) ||
+        (controlSize > patchStat.st_size - PATCH_HEADER_BYTES) ||
+        (diffSize > patchStat.st_size - PATCH_HEADER_BYTES - controlSize))
+    {
+        LE_ERROR("Bad patch header.");
+        return LE_FORMAT_ERROR;
+    }
+
+    off_t controlPos = PATCH_HEADER_BYTES;
+    off_t controlEnd = controlPos + controlSize;
+    off_t diffPos = controlEnd;
+    off_t diffEnd = diffPos + diffSize;
+    off_t extraPos = diffEnd;
+    off_t extraEnd = patchStat.st_size;
+    int64_t basePos = 0;
+    int64_t newPos = 0;
+
+    while (newPos < size)
+    {
+        uint8_t control[PATCH_CONTROL_BYTES];
+
+        if (controlPos + PATCH_CONTROL_BYTES > controlEnd)
+        {
+            LE_ERROR("Patch control block is too short.");
+            return LE_FORMAT_ERROR;
+        }
+
+        result = ReadAt(patchFd, control, sizeof(control), controlPos);
+
+        if (result != LE_OK)
+        {
+            return result;
+        }
+
+        controlPos += PATCH_CONTROL_BYTES;
+
+        int64_t diffLen = DecodeNumber(control);
+        int64_t extraLen = DecodeNumber(control + 8);
+        int64_t seek = DecodeNumber(control + 16);
+
+        // bsdiff always seeks to a position inside the installed file, which also keeps basePos
+        // from overflowing.
+        if ((diffLen < 0) || (extraLen < 0) ||
+            (diffLen > size - newPos) || (extraLen > size - newPos - diffLen) ||
+            (diffLen > diffEnd - diffPos) || (extraLen > extraEnd - extraPos) ||
+            (seek < -(basePos + diffLen)) || (seek > baseSize - (basePos + diffLen)))
+        {
+            LE_ERROR("Bad patch control tuple.");
+            return LE_FORMAT_ERROR;
+        }
+
+        // Add the diff bytes to the installed file's bytes.  Bytes outside of the installed file
+        // are taken as zeros.
+        while (diffLen > 0)
+        {
+            size_t count = (diffLen > (int64_t)sizeof(OutBuffer)) ? sizeof(OutBuffer) : diffLen;
+
+            result = ReadAt(patchFd, OutBuffer, count, diffPos);
+
+            if (result != LE_OK)
+            {
+                return result;
+            }
+
+            int64_t overlapStart = (basePos < 0) ? 0 : basePos;
+            int64_t overlapEnd = (basePos + (int64_t)count > baseSize) ? baseSize
+                                                                         : basePos + (int64_t)count;
+
+            if (overlapStart < overlapEnd)
+            {
+                size_t overlapOffset = overlapStart - basePos;
+                size_t overlapCount = overlapEnd - overlapStart;
+                size_t i;
+
+                result = ReadAt(baseFd, BaseBuffer, overlapCount, overlapStart);
+
+                if (result != LE_OK)
+                {
+                    return (result == LE_FORMAT_ERROR) ? LE_FAULT : result;
+                }
+
+                for (i = 0; i < overlapCount; i++)
+                {
+                    OutBuffer[overlapOffset + i] += BaseBuffer[i];
+                }
+            }
+
+            result = Write(outFd, OutBuffer, count, crcPtr);
+
+            if (result != LE_OK)
+            {
+                return result;
+            }
+
+            diffLen -= count;
+            diffPos += count;
+            basePos += count;
+            newPos += count;
+        }
+
+        // Append the extra bytes.
+        while (extraLen > 0)
+        {
+            size_t count = (extraLen > (int64_t)sizeof(OutBuffer)) ? sizeof(OutBuffer) : extraLen;
+
+            result = ReadAt(patchFd, OutBuffer, count, extraPos);
+
+            if (result == LE_OK)
+            {
+                result = Write(outFd, OutBuffer, count, crcPtr);
+            }
+
+            if (result != LE_OK)
+            {
+                return result;
+            }
+
+            extraLen -= count;
+            extraPos += count;
+            newPos += count;
+        }
+
+        basePos += seek;
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that a path from the manifest stays inside the app.
+ *
+ * @return true if the path is acceptable.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsPathValid
+(
+    const char* pathPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t length = strlen(pathPtr);
+
+    if ((length == 0) || (pathPtr[0] == '/') || (pathPtr[length - 1] == '/'))
+    {
+        return false;
+    }
+
+    const char* componentPtr = pathPtr;
+
+    while (componentPtr != NULL)
+    {
+        if ((componentPtr[0] == '.') && (componentPtr[1] == '.') &&
+            ((componentPtr[2] == '/') || (componentPtr[2] == '\0')))
+        {
+            return false;
+        }
+
+        componentPtr = strchr(componentPtr, '/');
+        if (componentPtr != NULL)
+        {
+            componentPtr++;
+        }
+    }
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close a file descriptor without changing errno.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CloseKeepErrno
+(
+    int fd
+)
+//--------------------------------------------------------------------------------------------------
+{
+    int savedErrno = errno;
+
+    fd_Close(fd);
+    errno = savedErrno;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open the parent directory of a path from the manifest, one component at a time from a root
+ * directory, without following symbolic links.
+ *
+ * @return File descriptor of the parent directory, or -1 on error (errno is ELOOP or ENOTDIR if
+ *         the path goes through something that is not a directory).
+ */
+//--------------------------------------------------------------------------------------------------
+static int OpenParentDir
+(
+    int rootFd,                 ///< [IN] Directory the path is relative to.
+    const char* pathPtr,        ///< [IN] Path from the manifest.
+    bool create,                ///< [IN] true to create missing directories.
+    const char** namePtrPtr     ///< [OUT] Name of the file in its parent directory.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const int flags = O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC;
+    char component[LIMIT_MAX_PATH_BYTES];
+    const char* namePtr = pathPtr;
+    const char* slashPtr;
+    int dirFd = fcntl(rootFd, F_DUPFD_CLOEXEC, 0);
+
+    while ((dirFd != -1) && ((slashPtr = strchr(namePtr, '/')) != NULL))
+    {
+        size_t length = slashPtr - namePtr;
+
+        memcpy(component, namePtr, length);
+        component[length] = '\0';
+        namePtr = slashPtr + 1;
+
+        if (length == 0)
+        {
+            continue;
+        }
+
+        int nextFd = openat(dirFd, component, flags);
+
+        if ((nextFd == -1) && (errno == ENOENT) && create)
+        {
+            if ((mkdirat(dirFd, component, DEFAULT_DIR_MODE) == 0) || (errno == EEXIST))
+            {
+                nextFd = openat(dirFd, component, flags);
+            }
+        }
+
+        CloseKeepErrno(dirFd);
+        dirFd = nextFd;
+    }
+
+    *namePtrPtr = namePtr;
+
+    return dirFd;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open a file for reading, without following symbolic links.
+ *
+ * @return File descriptor, or -1 on error.
+ */
+//--------------------------------------------------------------------------------------------------
+static int OpenFile
+(
+    int rootFd,                 ///< [IN] Directory the path is relative to.
+    const char* pathPtr         ///< [IN] Path from the manifest.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const char* namePtr;
+    int dirFd = OpenParentDir(rootFd, pathPtr, false, &namePtr);
+
+    if (dirFd == -1)
+    {
+        return -1;
+    }
+
+    int fd = openat(dirFd, namePtr, O_RDONLY | O_NOFOLLOW | O_CLOEXEC);
+
+    CloseKeepErrno(dirFd);
+
+    return fd;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a new file of the app in its (open) parent directory.
+ *
+ * @return File descriptor, or -1 on error.
+ */
+//--------------------------------------------------------------------------------------------------
+static int CreateFile
+(
+    int dirFd,
+    const char* namePtr,
+    const char* pathPtr,
+    uint64_t size
+)
+//--------------------------------------------------------------------------------------------------
+{
+    (void)unlinkat(dirFd, namePtr, 0);
+
+    int fd = openat(dirFd, namePtr, O_WRONLY | O_CREAT | O_EXCL | O_NOFOLLOW | O_CLOEXEC,
+                    S_IRUSR | S_IWUSR);
+
+    if (fd == -1)
+    {
+        LE_ERROR("Failed to create file '%s' (%m).", pathPtr);
+        return -1;
+    }
+
+    // Like the tar extractor, find out about a lack of space before writing anything.
+    if ((size > 0) && (fallocate(fd, 0, 0, size) != 0) && (errno == ENOSPC))
+    {
+        LE_ERROR("No space for file '%s' (%" PRIu64 " bytes).", pathPtr, size);
+        fd_Close(fd);
+        (void)unlinkat(dirFd, namePtr, 0);
+        return -1;
+    }
+
+    return fd;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Rebuild one file listed in the manifest.
+ *
+ * @return LE_OK if successful, LE_FORMAT_ERROR if the line or the patch is malformed, or the
+ *         result doesn't match, LE_FAULT on error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ApplyLine
+(
+    const char* linePtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    unsigned int mode;
+    uint64_t size;
+    uint32_t crc;
+    uint64_t baseSize;
+    int pathOffset = 0;
+    bool isPatch;
+
+    if ((sscanf(linePtr, "copy %o %" SCNu64 " %" SCNx32 " %n",
+                &mode, &size, &crc, &pathOffset) == 3) && (pathOffset > 0))
+    {
+        isPatch = false;
+        baseSize = size;
+    }
+    else if ((sscanf(linePtr, "patch %o %" SCNu64 " %" SCNx32 " %" SCNu64 " %n",
+                     &mode, &size, &crc, &baseSize, &pathOffset) == 4) && (pathOffset > 0))
+    {
+        isPatch = true;
+    }
+    else
+    {
+        LE_ERROR("Malformed delta manifest line '%s'.", linePtr);
+        return LE_FORMAT_ERROR;
+    }
+
+    const char* pathPtr = linePtr + pathOffset;
+
+    if ((!IsPathValid(pathPtr)) || ((mode & ~07777) != 0) ||
+        (size > INT64_MAX) || (baseSize > INT64_MAX))
+    {
+        LE_ERROR("Malformed delta manifest line '%s'.", linePtr);
+        return LE_FORMAT_ERROR;
+    }
+
+    char basePath[LIMIT_MAX_PATH_BYTES] = "";
+    char outPath[LIMIT_MAX_PATH_BYTES] = "";
+    char patchPath[LIMIT_MAX_PATH_BYTES] = "";
+
+    if ((le_path_Concat("/", basePath, sizeof(basePath), BaseDirPath, pathPtr, NULL) != LE_OK) ||
+        (le_path_Concat("/", outPath, sizeof(outPath), DirPath, pathPtr, NULL) != LE_OK) ||
+        (le_path_Concat("/", patchPath, sizeof(patchPath),
+                        DirPath, ".delta", pathPtr, NULL) != LE_OK))
+    {
+        LE_ERROR("Delta path '%s' is too long.", pathPtr);
+        return LE_FORMAT_ERROR;
+    }
+
+    int baseFd = OpenFile(BaseDirFd, pathPtr);
+    struct stat baseStat;
+
+    if ((baseFd == -1) || (fstat(baseFd, &baseStat) == -1) ||
+        (!S_ISREG(baseStat.st_mode)) || ((uint64_t)baseStat.st_size != baseSize))
+    {
+        LE_ERROR("'%s' does not match the version the delta was made against.", basePath);
+
+        if (baseFd != -1)
+        {
+            fd_Close(baseFd);
+        }
+
+        return LE_FORMAT_ERROR;
+    }
+
+    int patchFd = -1;
+
+    if (isPatch)
+    {
+        patchFd = OpenFile(PatchDirFd, pathPtr);
+
+        if (patchFd == -1)
+        {
+            LE_ERROR("Missing patch '%s' (%m).", patchPath);
+            fd_Close(baseFd);
+            return LE_FORMAT_ERROR;
+        }
+    }
+
+    le_result_t result = LE_FAULT;
+    uint32_t outCrc = LE_CRC_START_CRC32;
+    const char* outNamePtr;
+    int outDirFd = OpenParentDir(DirFd, pathPtr, true, &outNamePtr);
+    int outFd = -1;
+
+    if (outDirFd == -1)
+    {
+        if ((errno == ELOOP) || (errno == ENOTDIR))
+        {
+            LE_ERROR("'%s' goes through something that is not a directory.", outPath);
+            result = LE_FORMAT_ERROR;
+        }
+        else
+        {
+            LE_ERROR("Failed to open the directory of '%s' (%m).", outPath);
+        }
+    }
+    else
+    {
+        outFd = CreateFile(outDirFd, outNamePtr, outPath, size);
+    }
+
+    if (outFd != -1)
+    {
+        uint64_t startBytes = BytesWritten;
+
+        if (isPatch)
+        {
+            result = PatchFile(baseFd, baseSize, patchFd, outFd, size, &outCrc);
+        }
+        else
+        {
+            result = CopyFile(baseFd, outFd, size, &outCrc);
+        }
+
+        if ((result == LE_OK) && ((BytesWritten - startBytes != size) || (outCrc != crc)))
+        {
+            LE_ERROR("'%s' does not match its checksum (CRC32 %08" PRIx32 ", expected %08" PRIx32
+                     ").", outPath, outCrc, crc);
+            result = LE_FORMAT_ERROR;
+        }
+
+        if ((result == LE_OK) && (fchmod(outFd, mode) == -1))
+        {
+            LE_ERROR("Failed to set permissions of '%s' (%m).", outPath);
+            result = LE_FAULT;
+        }
+
+        if ((close(outFd) == -1) && (result == LE_OK))
+        {
+            LE_ERROR("Failed to write file '%s' (%m).", outPath);
+            result = LE_FAULT;
+        }
+
+        if (result != LE_OK)
+        {
+            (void)unlinkat(outDirFd, outNamePtr, 0);
+        }
+    }
+
+    if (outDirFd != -1)
+    {
+        fd_Close(outDirFd);
+    }
+
+    fd_Close(baseFd);
+
+    if (patchFd != -1)
+    {
+        fd_Close(patchFd);
+    }
+
+    if (result == LE_OK)
+    {
+        if (isPatch)
+        {
+            PatchedCount++;
+        }
+        else
+        {
+            CopiedCount++;
+        }
+    }
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close the manifest and the directories of the delta being applied.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CloseAll
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    int* fdPtrs[] = { &DirFd, &PatchDirFd, &BaseDirFd };
+    size_t i;
+
+    if (ManifestFile != NULL)
+    {
+        fclose(ManifestFile);
+        ManifestFile = NULL;
+    }
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(fdPtrs); i++)
+    {
+        if (*fdPtrs[i] != -1)
+        {
+            fd_Close(*fdPtrs[i]);
+            *fdPtrs[i] = -1;
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finish applying the delta, and report the result.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Finish
+(
+    le_result_t result
+)
+//--------------------------------------------------------------------------------------------------
+{
+    appDelta_DoneHandler_t handlerFunc = DoneHandler;
+
+    CloseAll();
+    DoneHandler = NULL;
+    Generation++;
+
+    if (result == LE_OK)
+    {
+        char deltaDirPath[LIMIT_MAX_PATH_BYTES] = "";
+
+        LE_ASSERT(le_path_Concat("/", deltaDirPath, sizeof(deltaDirPath),
+                                 DirPath, ".delta", NULL) == LE_OK);
+
+        if (le_dir_RemoveRecursive(deltaDirPath) != LE_OK)
+        {
+            LE_ERROR("Failed to remove '%s'.", deltaDirPath);
+            result = LE_FAULT;
+        }
+        else
+        {
+            le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), StartTime);
+
+            LE_INFO("Applied delta: %zu files copied, %zu files patched, %" PRIu64 " bytes"
+                    " written in %u ms.",
+                    CopiedCount,
+                    PatchedCount,
+                    BytesWritten,
+                    (unsigned int)((elapsed.sec * 1000) + (elapsed.usec / 1000)));
+        }
+    }
+
+    handlerFunc(result);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Rebuild the next file listed in the manifest, then queue the next pass.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ApplyNext
+(
+    void* generationPtr,
+    void* unusedPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (((uint32_t)(uintptr_t)generationPtr != Generation) || (ManifestFile == NULL))
+    {
+        return;
+    }
+
+    char line[MAX_LINE_BYTES];
+
+    if (fgets(line, sizeof(line), ManifestFile) == NULL)
+    {
+        if (ferror(ManifestFile))
+        {
+            LE_ERROR("Failed to read the delta manifest.");
+            Finish(LE_FAULT);
+        }
+        else
+        {
+            Finish(LE_OK);
+        }
+        return;
+    }
+
+    size_t length = strlen(line);
+
+    if ((length > 0) && (line[length - 1] == '\n'))
+    {
+        line[length - 1] = '\0';
+    }
+    else if (!feof(ManifestFile))
+    {
+        LE_ERROR("Delta manifest line is too long.");
+        Finish(LE_FORMAT_ERROR);
+        return;
+    }
+
+    le_result_t result = ApplyLine(line);
+
+    if (result != LE_OK)
+    {
+        Finish(result);
+        return;
+    }
+
+    le_event_QueueFunction(ApplyNext, generationPtr, NULL);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start rebuilding the files of an app that are listed in the manifest of an extracted delta
+ * payload.  The files are rebuilt one at a time from the event loop, and the handler is called
+ * when they all have been rebuilt and the ".delta" directory has been removed, or on failure.
+ */
+//--------------------------------------------------------------------------------------------------
+void appDelta_Start
+(
+    const char* dirPath,                ///< [IN] Directory the delta payload was extracted into.
+    const char* baseMd5Ptr,             ///< [IN] Hash ID of the installed version of the app.
+    appDelta_DoneHandler_t handlerFunc  ///< [IN] Function to call when done.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    appDelta_Stop();
+
+    // The hash ID names the installed version's directory, so it must not be anything else.
+    if ((strlen(baseMd5Ptr) != MD5_STRING_LENGTH) ||
+        (strspn(baseMd5Ptr, "0123456789abcdefABCDEF") != MD5_STRING_LENGTH))
+    {
+        LE_ERROR("Bad hash ID '%s' for the installed version of the app.", baseMd5Ptr);
+        handlerFunc(LE_FORMAT_ERROR);
+        return;
+    }
+
+    LE_ASSERT(le_utf8_Copy(DirPath, dirPath, sizeof(DirPath), NULL) == LE_OK);
+    LE_ASSERT(snprintf(BaseDirPath, sizeof(BaseDirPath), "/legato/apps/%s", baseMd5Ptr)
+              < sizeof(BaseDirPath));
+
+    CopiedCount = 0;
+    PatchedCount = 0;
+    BytesWritten = 0;
+    StartTime = le_clk_GetRelativeTime();
+
+    DirFd = open(DirPath, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    BaseDirFd = open(BaseDirPath, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+    if ((DirFd == -1) || (BaseDirFd == -1))
+    {
+        LE_ERROR("Failed to open '%s' or '%s' (%m).", DirPath, BaseDirPath);
+        CloseAll();
+        handlerFunc(LE_FAULT);
+        return;
+    }
+
+    // The patches and the manifest come from the payload, so don't follow symbolic links to them.
+    int manifestFd = -1;
+
+    PatchDirFd = openat(DirFd, ".delta", O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+
+    if (PatchDirFd != -1)
+    {
+        manifestFd = openat(PatchDirFd, "manifest", O_RDONLY | O_NOFOLLOW | O_CLOEXEC);
+    }
+
+    if ((manifestFd == -1) || ((ManifestFile = fdopen(manifestFd, "r")) == NULL))
+    {
+        LE_ERROR("Delta payload has no manifest (%m).");
+
+        if (manifestFd != -1)
+        {
+            fd_Close(manifestFd);
+        }
+
+        CloseAll();
+        handlerFunc(LE_FORMAT_ERROR);
+        return;
+    }
+
+    DoneHandler = handlerFunc;
+
+    le_event_QueueFunction(ApplyNext, (void*)(uintptr_t)Generation, NULL);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stop applying a delta.  The handler is not called.
+ */
+//--------------------------------------------------------------------------------------------------
+void appDelta_Stop
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    CloseAll();
+
+    DoneHandler = NULL;
+    Generation++;
+}
@@ -0,0 +1,75 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file appDelta.h
+ *
+ * Functions exported by the Update Daemon's app delta module, which rebuilds a new version of an
+ * app from the version that is installed on the target and a delta payload, so that app updates
+ * only need to carry what changed between the two versions.
+ *
+ * A delta payload is a tarball like a full app payload, except that the files that are identical
+ * in the installed version, or that can be rebuilt from the installed version, are left out of it.
+ * They are listed in the ".delta/manifest" file of the tarball instead, one per line:
+ *
+ * @verbatim
+   copy <mode> <size> <crc32> <path>
+   patch <mode> <size> <crc32> <baseSize> <path>
+   @endverbatim
+ *
+ * A "copy" file is copied from the same path in the installed version.  A "patch" file is rebuilt
+ * by applying the patch found at ".delta/<path>" to the file at the same path in the installed
+ * version.  Modes are octal, CRC32s are hexadecimal, and sizes are decimal.
+ *
+ * Patches use the bsdiff 4 layout, but with uncompressed control, diff and extra blocks (the
+ * whole payload is compressed already), and with "LEDELTA1" as magic number.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#ifndef LEGATO_UPDATE_DAEMON_APP_DELTA_H_INCLUDE_GUARD
+#define LEGATO_UPDATE_DAEMON_APP_DELTA_H_INCLUDE_GUARD
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function that is called when a delta has been applied.
+ *
+ * @param result
+ *      - LE_OK if the new version of the app has been rebuilt.
+ *      - LE_FORMAT_ERROR if the delta is malformed, or does not apply to the installed version.
+ *      - LE_FAULT if a file could not be read or written.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef void (*appDelta_DoneHandler_t)
+(
+    le_result_t result
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start rebuilding the files of an app that are listed in the manifest of an extracted delta
+ * payload.  The files are rebuilt one at a time from the event loop, and the handler is called
+ * when they all have been rebuilt and the ".delta" directory has been removed, or on failure.
+ */
+//--------------------------------------------------------------------------------------------------
+void appDelta_Start
+(
+    const char* dirPath,                ///< [IN] Directory the delta payload was extracted into.
+    const char* baseMd5Ptr,             ///< [IN] Hash ID of the installed version of the app.
+    appDelta_DoneHandler_t handlerFunc  ///< [IN] Function to call when done.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stop applying a delta.  The handler is not called.
+ */
+//--------------------------------------------------------------------------------------------------
+void appDelta_Stop
+(
+    void
+);
+
+
+#endif // LEGATO_UPDATE_DAEMON_APP_DELTA_H_INCLUDE_GUARD
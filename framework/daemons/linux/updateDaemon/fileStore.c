@@ -0,0 +1,814 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file fileStore.c
+ *
+ * Content-addressed file store of the Update Daemon.  See fileStore.h for an overview.
+ *
+ * /legato/store/
+ *               <key>-<size>
+ *
+ * The key is a 64-bit hash of a file's content, permissions, owner and extended attributes, so
+ * files that only differ by their SMACK label (e.g., the same library installed in two different
+ * apps) are stored separately, as their inodes can not be shared.  The hash is not trusted on its
+ * own: a file is only replaced by a link to the store when its content and attributes are
+ * identical to the stored file.
+ *
+ * A store entry is in use as long as some app or system has a hard link to it, so unused entries
+ * are the ones with a link count of one, which are removed once the apps and systems that used
+ * them have been removed.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "limit.h"
+#include "fileDescriptor.h"
+#include "fileSystem.h"
+#include "smack.h"
+#include "fileStore.h"
+
+#include <sys/xattr.h>
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Absolute file system path to the file store.  Must be on the same file system as the apps and
+ * systems, so that hard links can be made between them.
+ */
+//--------------------------------------------------------------------------------------------------
+#define STORE_PATH "/legato/store"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum size of a file's list of extended attribute names, and of an extended attribute value.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_XATTR_LIST_SIZE     4096
+#define MAX_XATTR_VALUE_SIZE    4096
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the buffers used to read files.  Must be a multiple of 8 bytes, the size of the words
+ * that are hashed.
+ */
+//--------------------------------------------------------------------------------------------------
+#define READ_BUFFER_SIZE        (64 * 1024)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Suffix of the temporary link that atomically replaces a file.
+ */
+//--------------------------------------------------------------------------------------------------
+#define TEMP_LINK_SUFFIX        ".fileStore~"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hash constants (64-bit primes with well distributed bits).
+ */
+//--------------------------------------------------------------------------------------------------
+#define HASH_PRIME_1            0x9E3779B185EBCA87ULL
+#define HASH_PRIME_2            0xC2B2AE3D27D4EB4FULL
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Buffers used to hash and compare files.  The Update Daemon is single threaded.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t ReadBuffer[READ_BUFFER_SIZE];
+static uint8_t CompareBuffer[READ_BUFFER_SIZE];
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Counts of what a deduplication pass did.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    size_t storedCount;     ///< Files that were new, and were put in the store.
+    size_t linkedCount;     ///< Files that were replaced by a link to an identical stored file.
+    uint64_t savedBytes;    ///< Bytes freed by replacing files with links.
+}
+DedupStats_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mix a 64-bit word into a hash.
+ *
+ * @return The new hash.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline uint64_t HashWord
+(
+    uint64_t hash,
+    uint64_t word
+)
+{
+    hash ^= word * HASH_PRIME_2;
+    hash = (hash << 31) | (hash >> 33);
+
+    return hash * HASH_PRIME_1;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mix a buffer into a hash.  Only the last buffer of a stream may have a length that is not a
+ * multiple of 8 bytes.
+ *
+ * @return The new hash.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t HashBytes
+(
+    uint64_t hash,
+    const uint8_t* bytesPtr,
+    size_t len
+)
+{
+    uint64_t word;
+
+    for (; len >= sizeof(word); len -= sizeof(word), bytesPtr += sizeof(word))
+    {
+        memcpy(&word, bytesPtr, sizeof(word));
+        hash = HashWord(hash, word);
+    }
+
+    if (len > 0)
+    {
+        word = 0;
+        memcpy(&word, bytesPtr, len);
+        hash = HashWord(hash, word ^ ((uint64_t)len << 56));
+    }
+
+    return hash;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finalize a hash, so that every input bit affects every output bit.
+ *
+ * @return The final hash.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t HashFinal
+(
+    uint64_t hash
+)
+{
+    hash ^= hash >> 33;
+    hash *= HASH_PRIME_2;
+    hash ^= hash >> 29;
+    hash *= HASH_PRIME_1;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read until a buffer is full or the end of the file is reached.
+ *
+ * @return Number of bytes read (less than the buffer size only at the end of the file), or -1 on
+ *         error.
+ */
+//--------------------------------------------------------------------------------------------------
+static ssize_t ReadFull
+(
+    int fd,
+    uint8_t* bufferPtr,
+    size_t bufferSize
+)
+{
+    size_t count = 0;
+
+    while (count < bufferSize)
+    {
+        ssize_t readCount = read(fd, bufferPtr + count, bufferSize - count);
+
+        if (readCount == 0)
+        {
+            break;
+        }
+
+        if (readCount == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            return -1;
+        }
+
+        count += readCount;
+    }
+
+    return count;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hash the content of a file.
+ *
+ * @return LE_OK if successful, LE_FAULT if the file could not be read.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t HashContent
+(
+    const char* pathPtr,        ///< [IN] File to hash.
+    uint64_t* hashPtr           ///< [OUT] Hash of the content.
+)
+{
+    int fd = open(pathPtr, O_RDONLY | O_CLOEXEC);
+
+    if (fd == -1)
+    {
+        LE_WARN("Could not open '%s'. %m", pathPtr);
+        return LE_FAULT;
+    }
+
+    uint64_t hash = 0;
+    ssize_t count;
+
+    while ((count = ReadFull(fd, ReadBuffer, sizeof(ReadBuffer))) > 0)
+    {
+        hash = HashBytes(hash, ReadBuffer, count);
+    }
+
+    if (count == -1)
+    {
+        LE_WARN("Could not read '%s'. %m", pathPtr);
+    }
+
+    fd_Close(fd);
+
+    *hashPtr = hash;
+
+    return (count == 0) ? LE_OK : LE_FAULT;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if two files have the same content.
+ *
+ * @return true if the content is the same.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsSameContent
+(
+    const char* pathPtr,
+    const char* otherPathPtr
+)
+{
+    int fd = open(pathPtr, O_RDONLY | O_CLOEXEC);
+
+    if (fd == -1)
+    {
+        return false;
+    }
+
+    int otherFd = open(otherPathPtr, O_RDONLY | O_CLOEXEC);
+
+    if (otherFd == -1)
+    {
+        fd_Close(fd);
+        return false;
+    }
+
+    bool isSame = true;
+    ssize_t count;
+
+    do
+    {
+        count = ReadFull(fd, ReadBuffer, sizeof(ReadBuffer));
+
+        if ((count == -1) ||
+            (ReadFull(otherFd, CompareBuffer, sizeof(CompareBuffer)) != count) ||
+            (memcmp(ReadBuffer, CompareBuffer, count) != 0))
+        {
+            isSame = false;
+        }
+    }
+    while (isSame && (count > 0));
+
+    fd_Close(fd);
+    fd_Close(otherFd);
+
+    return isSame;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the list of names of a file's extended attributes.
+ *
+ * @return Size of the list, or -1 on error.
+ */
+//--------------------------------------------------------------------------------------------------
+static ssize_t GetXattrList
+(
+    const char* pathPtr,
+    char* listPtr,              ///< [OUT] Null-separated list of names.
+    size_t listSize
+)
+{
+    ssize_t size = llistxattr(pathPtr, listPtr, listSize);
+
+    if (size == -1)
+    {
+        LE_WARN("Could not get list of extended attributes for '%s'. %m", pathPtr);
+    }
+
+    return size;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hash the extended attributes of a file.  The hash does not depend on the order the attributes
+ * are listed in.
+ *
+ * @return LE_OK if successful, LE_FAULT if the attributes could not be read.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t HashXattrs
+(
+    const char* pathPtr,
+    uint64_t* hashPtr           ///< [OUT] Hash of the extended attributes.
+)
+{
+    char list[MAX_XATTR_LIST_SIZE];
+    ssize_t listSize = GetXattrList(pathPtr, list, sizeof(list));
+
+    if (listSize == -1)
+    {
+        return LE_FAULT;
+    }
+
+    uint64_t hash = 0;
+    char* namePtr;
+
+    for (namePtr = list; namePtr < list + listSize; namePtr += strlen(namePtr) + 1)
+    {
+        char value[MAX_XATTR_VALUE_SIZE];
+        ssize_t valueSize = lgetxattr(pathPtr, namePtr, value, sizeof(value));
+
+        if (valueSize == -1)
+        {
+            LE_WARN("Could not get extended attribute %s of '%s'. %m", namePtr, pathPtr);
+            return LE_FAULT;
+        }
+
+        uint64_t attrHash = HashBytes(0, (uint8_t*)namePtr, strlen(namePtr) + 1);
+        attrHash = HashBytes(attrHash, (uint8_t*)value, valueSize);
+
+        hash += HashFinal(attrHash);
+    }
+
+    *hashPtr = hash;
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if two files have the same extended attributes.
+ *
+ * @return true if the attributes are the same.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsSameXattrs
+(
+    const char* pathPtr,
+    const char* otherPathPtr
+)
+{
+    char list[MAX_XATTR_LIST_SIZE];
+    char otherList[MAX_XATTR_LIST_SIZE];
+    ssize_t listSize = GetXattrList(pathPtr, list, sizeof(list));
+
+    if ((listSize == -1) || (GetXattrList(otherPathPtr, otherList, sizeof(otherList)) != listSize))
+    {
+        return false;
+    }
+
+    char* namePtr;
+
+    for (namePtr = list; namePtr < list + listSize; namePtr += strlen(namePtr) + 1)
+    {
+        char value[MAX_XATTR_VALUE_SIZE];
+        char otherValue[MAX_XATTR_VALUE_SIZE];
+        ssize_t valueSize = lgetxattr(pathPtr, namePtr, value, sizeof(value));
+
+        if ((valueSize == -1) ||
+            (lgetxattr(otherPathPtr, namePtr, otherValue, sizeof(otherValue)) != valueSize) ||
+            (memcmp(value, otherValue, valueSize) != 0))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copy the extended attributes of a file or directory to another one.
+ *
+ * @return LE_OK if successful, LE_FAULT otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t CopyXattrs
+(
+    const char* srcPathPtr,
+    const char* destPathPtr
+)
+{
+    char list[MAX_XATTR_LIST_SIZE];
+    ssize_t listSize = GetXattrList(srcPathPtr, list, sizeof(list));
+
+    if (listSize == -1)
+    {
+        return LE_FAULT;
+    }
+
+    char* namePtr;
+
+    for (namePtr = list; namePtr < list + listSize; namePtr += strlen(namePtr) + 1)
+    {
+        char value[MAX_XATTR_VALUE_SIZE];
+        ssize_t valueSize = lgetxattr(srcPathPtr, namePtr, value, sizeof(value));
+
+        if ((valueSize == -1) || (lsetxattr(destPathPtr, namePtr, value, valueSize, 0) == -1))
+        {
+            LE_ERROR("Could not copy extended attribute %s from '%s' to '%s'. %m",
+                     namePtr, srcPathPtr, destPathPtr);
+            return LE_FAULT;
+        }
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create the store directory if it does not exist yet.
+ *
+ * @return LE_OK if successful, LE_FAULT otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t MakeStoreDir
+(
+    void
+)
+{
+    if (le_dir_IsDir(STORE_PATH))
+    {
+        return LE_OK;
+    }
+
+    if (le_dir_MakePath(STORE_PATH, S_IRWXU) == LE_FAULT)
+    {
+        LE_ERROR("Could not create the file store '%s'.", STORE_PATH);
+        return LE_FAULT;
+    }
+
+    // Only the framework needs to reach the store.  Apps reach their files through their own
+    // directories.
+    smack_SetLabel(STORE_PATH, "framework");
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Put a file in the store, or replace it with a link to the identical file already in the store.
+ *
+ * @return LE_OK if the file is now shared with the store (or the file could be left alone), or
+ *         LE_FAULT if the store can not be used at all.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t DedupFile
+(
+    const char* pathPtr,            ///< [IN] File to deduplicate.
+    const struct stat* statPtr,     ///< [IN] Status of the file.
+    DedupStats_t* statsPtr          ///< [IN,OUT] What the pass has done so far.
+)
+{
+    uint64_t contentHash;
+    uint64_t xattrHash;
+
+    if ((HashXattrs(pathPtr, &xattrHash) != LE_OK) ||
+        (HashContent(pathPtr, &contentHash) != LE_OK))
+    {
+        return LE_OK;
+    }
+
+    uint64_t key = HashWord(contentHash, statPtr->st_size);
+    key = HashWord(key, statPtr->st_mode);
+    key = HashWord(key, ((uint64_t)statPtr->st_uid << 32) | statPtr->st_gid);
+    key = HashFinal(HashWord(key, xattrHash));
+
+    char storePath[LIMIT_MAX_PATH_BYTES];
+
+    LE_ASSERT(snprintf(storePath, sizeof(storePath), STORE_PATH "/%016" PRIx64 "-%" PRIx64,
+                       key, (uint64_t)statPtr->st_size) < sizeof(storePath));
+
+    struct stat storeStat;
+
+    if (lstat(storePath, &storeStat) == -1)
+    {
+        if (errno != ENOENT)
+        {
+            LE_ERROR("Could not stat '%s'. %m", storePath);
+            return LE_FAULT;
+        }
+
+        // First time this file is seen.  The file itself becomes the stored copy.
+        if (link(pathPtr, storePath) == -1)
+        {
+            LE_ERROR("Could not link '%s' to '%s'. %m", pathPtr, storePath);
+            return LE_FAULT;
+        }
+
+        statsPtr->storedCount++;
+        return LE_OK;
+    }
+
+    if ((storeStat.st_dev == statPtr->st_dev) && (storeStat.st_ino == statPtr->st_ino))
+    {
+        return LE_OK;
+    }
+
+    if ((!S_ISREG(storeStat.st_mode)) ||
+        (storeStat.st_size != statPtr->st_size) ||
+        (storeStat.st_mode != statPtr->st_mode) ||
+        (storeStat.st_uid != statPtr->st_uid) ||
+        (storeStat.st_gid != statPtr->st_gid) ||
+        (!IsSameXattrs(pathPtr, storePath)) ||
+        (!IsSameContent(pathPtr, storePath)))
+    {
+        LE_WARN("'%s' collides with '%s' in the file store. Not sharing it.", pathPtr, storePath);
+        return LE_OK;
+    }
+
+    // Atomically replace the file with a link to the stored copy, so the file is never missing.
+    char tempPath[LIMIT_MAX_PATH_BYTES];
+
+    if (snprintf(tempPath, sizeof(tempPath), "%s" TEMP_LINK_SUFFIX, pathPtr) >= sizeof(tempPath))
+    {
+        return LE_OK;
+    }
+
+    (void)unlink(tempPath);
+
+    if (link(storePath, tempPath) == -1)
+    {
+        LE_ERROR("Could not link '%s' to '%s'. %m", storePath, tempPath);
+        return LE_FAULT;
+    }
+
+    if (rename(tempPath, pathPtr) == -1)
+    {
+        LE_ERROR("Could not rename '%s' to '%s'. %m", tempPath, pathPtr);
+        (void)unlink(tempPath);
+        return LE_FAULT;
+    }
+
+    statsPtr->linkedCount++;
+    statsPtr->savedBytes += statPtr->st_size;
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Put all the regular files under a directory in the store, replacing each file that is identical
+ * (content, permissions, owner and extended attributes, including the SMACK label) to a file
+ * already in the store with a hard link to the stored copy.
+ *
+ * Must be called after the files' permissions and SMACK labels have been set.  Files that can not
+ * be shared are left as they are, so this never fails the install.
+ */
+//--------------------------------------------------------------------------------------------------
+void fileStore_Dedup
+(
+    const char* dirPath     ///< [IN] Directory to deduplicate.
+)
+{
+    if ((!le_dir_IsDir(dirPath)) || (MakeStoreDir() != LE_OK))
+    {
+        return;
+    }
+
+    char* pathArrayPtr[] = { (char*)dirPath, NULL };
+    FTS* ftsPtr = fts_open(pathArrayPtr, FTS_PHYSICAL | FTS_NOCHDIR, NULL);
+
+    if (ftsPtr == NULL)
+    {
+        LE_ERROR("Could not access dir '%s'. %m", dirPath);
+        return;
+    }
+
+    DedupStats_t stats = { 0 };
+    le_result_t result = LE_OK;
+
+    FTSENT* entPtr;
+    while ((result == LE_OK) && ((entPtr = fts_read(ftsPtr)) != NULL))
+    {
+        // Files with more than one link are already shared (with the store, or with a file that
+        // will be put in the store along with them).
+        if ((entPtr->fts_info == FTS_F) && (entPtr->fts_statp->st_nlink == 1))
+        {
+            result = DedupFile(entPtr->fts_path, entPtr->fts_statp, &stats);
+        }
+    }
+
+    fts_close(ftsPtr);
+
+    LE_INFO("Deduplicated '%s': %zu files stored, %zu files shared, %" PRIu64 " bytes saved.",
+            dirPath, stats.storedCount, stats.linkedCount, stats.savedBytes);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Recreate a read-only directory tree, hard linking its files instead of copying them.  The
+ * directories are created with the same permissions, owner and extended attributes as the
+ * source directories.
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_FAULT if the tree could not be recreated.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t fileStore_LinkTree
+(
+    const char* srcPath,    ///< [IN] Directory to link from.
+    const char* destPath    ///< [IN] Directory to create.  Must not exist.
+)
+{
+    size_t srcPathLen = strlen(srcPath);
+    char* pathArrayPtr[] = { (char*)srcPath, NULL };
+    FTS* ftsPtr = fts_open(pathArrayPtr, FTS_PHYSICAL | FTS_NOCHDIR, NULL);
+
+    if (ftsPtr == NULL)
+    {
+        LE_ERROR("Could not access dir '%s'. %m", srcPath);
+        return LE_FAULT;
+    }
+
+    le_result_t result = LE_OK;
+
+    FTSENT* entPtr;
+    while ((result == LE_OK) && ((entPtr = fts_read(ftsPtr)) != NULL))
+    {
+        char newPath[LIMIT_MAX_PATH_BYTES] = "";
+
+        if (le_path_Concat("/", newPath, sizeof(newPath),
+                           destPath, entPtr->fts_path + srcPathLen, NULL) != LE_OK)
+        {
+            LE_ERROR("Destination path to '%s' too long.", entPtr->fts_path);
+            result = LE_FAULT;
+            break;
+        }
+
+        const struct stat* statPtr = entPtr->fts_statp;
+
+        switch (entPtr->fts_info)
+        {
+            case FTS_D:
+                if ((entPtr->fts_level > 0) && fs_IsMountPoint(entPtr->fts_path))
+                {
+                    fts_set(ftsPtr, entPtr, FTS_SKIP);
+                }
+                else if ((mkdir(newPath, S_IRWXU) == -1) ||
+                         (chown(newPath, statPtr->st_uid, statPtr->st_gid) == -1) ||
+                         (CopyXattrs(entPtr->fts_path, newPath) != LE_OK) ||
+                         (chmod(newPath, statPtr->st_mode & 07777) == -1))
+                {
+                    LE_ERROR("Could not create directory '%s'. %m", newPath);
+                    result = LE_FAULT;
+                }
+                break;
+
+            case FTS_DP:
+                // Same directory traversed in post-order. So ignore it.
+                break;
+
+            case FTS_F:
+                if (link(entPtr->fts_path, newPath) == -1)
+                {
+                    LE_ERROR("Could not link '%s' to '%s'. %m", entPtr->fts_path, newPath);
+                    result = LE_FAULT;
+                }
+                break;
+
+            case FTS_SL:
+            case FTS_SLNONE:
+                {
+                    char target[LIMIT_MAX_PATH_BYTES];
+                    ssize_t len = readlink(entPtr->fts_path, target, sizeof(target));
+
+                    if ((len < 0) || (len >= sizeof(target)))
+                    {
+                        LE_ERROR("Failed to read symlink '%s'.", entPtr->fts_path);
+                        result = LE_FAULT;
+                        break;
+                    }
+
+                    target[len] = '\0';
+
+                    if ((symlink(target, newPath) == -1) ||
+                        (lchown(newPath, statPtr->st_uid, statPtr->st_gid) == -1))
+                    {
+                        LE_ERROR("Failed to create symlink '%s' to '%s'. %m", newPath, target);
+                        result = LE_FAULT;
+                    }
+                }
+                break;
+
+            default:
+                LE_ERROR("Unexpected file type %d at '%s'.", entPtr->fts_info, entPtr->fts_path);
+                result = LE_FAULT;
+                break;
+        }
+    }
+
+    fts_close(ftsPtr);
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete the files in the store that are no longer used by any app or system.
+ */
+//--------------------------------------------------------------------------------------------------
+void fileStore_RemoveUnused
+(
+    void
+)
+{
+    DIR* dirPtr = opendir(STORE_PATH);
+
+    if (dirPtr == NULL)
+    {
+        LE_ERROR_IF(errno != ENOENT, "Could not open '%s'. %m", STORE_PATH);
+        return;
+    }
+
+    size_t removedCount = 0;
+    uint64_t removedBytes = 0;
+    struct dirent* entPtr;
+
+    while ((entPtr = readdir(dirPtr)) != NULL)
+    {
+        struct stat fileStat;
+
+        if ((entPtr->d_name[0] == '.') ||
+            (fstatat(dirfd(dirPtr), entPtr->d_name, &fileStat, AT_SYMLINK_NOFOLLOW) == -1))
+        {
+            continue;
+        }
+
+        // The store's own link is the last one left, so no app or system uses the file anymore.
+        if (S_ISREG(fileStat.st_mode) && (fileStat.st_nlink == 1))
+        {
+            if (unlinkat(dirfd(dirPtr), entPtr->d_name, 0) == -1)
+            {
+                LE_ERROR("Could not remove '%s/%s'. %m", STORE_PATH, entPtr->d_name);
+                continue;
+            }
+
+            removedCount++;
+            removedBytes += fileStat.st_size;
+        }
+    }
+
+    closedir(dirPtr);
+
+    if (removedCount > 0)
+    {
+        LE_INFO("Removed %zu unused files (%" PRIu64 " bytes) from the file store.",
+                removedCount, removedBytes);
+    }
+}
@@ -0,0 +1,67 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file fileStore.h
+ *
+ * Functions exported by the Update Daemon's content-addressed file store, which keeps a single
+ * copy of each distinct read-only file installed in apps and systems.  Installed files are hard
+ * links to the copy in the store, so identical libraries and assets shared by several app versions
+ * or systems only take up flash once.
+ *
+ * @warning Files that have been put in the store share their inode with every other identical
+ *          file, so they must never be modified in place.  Only read-only content (app read-only
+ *          directories and system lib, bin and modules directories) is put in the store.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#ifndef LEGATO_UPDATE_DAEMON_FILE_STORE_H_INCLUDE_GUARD
+#define LEGATO_UPDATE_DAEMON_FILE_STORE_H_INCLUDE_GUARD
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Put all the regular files under a directory in the store, replacing each file that is identical
+ * (content, permissions, owner and extended attributes, including the SMACK label) to a file
+ * already in the store with a hard link to the stored copy.
+ *
+ * Must be called after the files' permissions and SMACK labels have been set.  Files that can not
+ * be shared are left as they are, so this never fails the install.
+ */
+//--------------------------------------------------------------------------------------------------
+void fileStore_Dedup
+(
+    const char* dirPath     ///< [IN] Directory to deduplicate.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Recreate a read-only directory tree, hard linking its files instead of copying them.  The
+ * directories are created with the same permissions, owner and extended attributes as the
+ * source directories.
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_FAULT if the tree could not be recreated.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t fileStore_LinkTree
+(
+    const char* srcPath,    ///< [IN] Directory to link from.
+    const char* destPath    ///< [IN] Directory to create.  Must not exist.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete the files in the store that are no longer used by any app or system.
+ */
+//--------------------------------------------------------------------------------------------------
+void fileStore_RemoveUnused
+(
+    void
+);
+
+
+#endif // LEGATO_UPDATE_DAEMON_FILE_STORE_H_INCLUDE_GUARD
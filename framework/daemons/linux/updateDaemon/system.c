@@ -23,6 +23,7 @@
 #include "sysPaths.h"
 #include "sysStatus.h"
 #include "smack.h"
+#include "fileStore.h"
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -775,6 +776,11 @@ le_result_t system_FinishUpdate
     SetSystemFilesPermissions("/legato/systems/unpack/lib");
     SetSystemFilesPermissions("/legato/systems/unpack/bin");
 
+    // Share the system files that are identical to ones of the previous systems.
+    fileStore_Dedup(UnpackLibDirPath);
+    fileStore_Dedup(UnpackBinDirPath);
+    fileStore_Dedup(UnpackModuleDirPath);
+
     // Now, move the unpacked system into its index.
     char newSystemPath[100] = "";
     snprintf(newSystemPath, sizeof(newSystemPath), "%s/%d", SystemPath, currentIndex);
@@ -784,6 +790,86 @@ le_result_t system_FinishUpdate
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copy the current system to the unpack directory.  The read-only lib, bin and modules directories
+ * are hard linked instead of copied, as they are never modified once installed.
+ *
+ * @note Like file_CopyRecursive(), does not copy mounted files or directories.
+ *
+ * @return LE_OK if successful.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t CopyCurrentSystem
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    static const char* linkedDirs[] = { "lib", "bin", "modules" };
+
+    DIR* dirPtr = opendir(CURRENT_SYSTEM_PATH);
+
+    if (dirPtr == NULL)
+    {
+        LE_ERROR("Error opening directory %s.  %m.", CURRENT_SYSTEM_PATH);
+        return LE_FAULT;
+    }
+
+    le_result_t result = LE_OK;
+    struct dirent* entPtr;
+
+    while ((result == LE_OK) && ((entPtr = readdir(dirPtr)) != NULL))
+    {
+        if ((strcmp(entPtr->d_name, ".") == 0) || (strcmp(entPtr->d_name, "..") == 0))
+        {
+            continue;
+        }
+
+        char sourcePath[LIMIT_MAX_PATH_BYTES] = CURRENT_SYSTEM_PATH;
+        char destPath[LIMIT_MAX_PATH_BYTES] = "";
+
+        if ((le_path_Concat("/", sourcePath, sizeof(sourcePath), entPtr->d_name, NULL) != LE_OK) ||
+            (le_path_Concat("/", destPath, sizeof(destPath),
+                            system_UnpackPath, entPtr->d_name, NULL) != LE_OK))
+        {
+            LE_ERROR("Path to '%s' is too long.", entPtr->d_name);
+            result = LE_FAULT;
+            break;
+        }
+
+        if (fs_IsMountPoint(sourcePath))
+        {
+            continue;
+        }
+
+        bool isLinked = false;
+        size_t i;
+
+        for (i = 0; i < NUM_ARRAY_MEMBERS(linkedDirs); i++)
+        {
+            if ((strcmp(entPtr->d_name, linkedDirs[i]) == 0) && le_dir_IsDir(sourcePath))
+            {
+                isLinked = true;
+            }
+        }
+
+        if (isLinked)
+        {
+            result = fileStore_LinkTree(sourcePath, destPath);
+        }
+        else if (file_CopyRecursive(sourcePath, destPath, NULL) != LE_OK)
+        {
+            result = LE_FAULT;
+        }
+    }
+
+    closedir(dirPtr);
+
+    return result;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Take a snapshot of the current system.
@@ -814,7 +900,7 @@ le_result_t system_Snapshot
 
     system_PrepUnpackDir();
 
-    if (file_CopyRecursive(CURRENT_SYSTEM_PATH, system_UnpackPath, NULL) != LE_OK)
+    if (CopyCurrentSystem() != LE_OK)
     {
         return LE_FAULT;
     }
@@ -1092,6 +1178,9 @@ void system_RemoveUnusedApps
     }
 
     fts_close(ftsPtr);
+
+    // Free the stored files that were only used by the removed apps.
+    fileStore_RemoveUnused();
 }
 
 
@@ -1220,6 +1309,9 @@ void system_RemoveUnneeded
     }
 
     fts_close(ftsPtr);
+
+    // Free the stored files that were only used by the removed systems.
+    fileStore_RemoveUnused();
 }
 
 
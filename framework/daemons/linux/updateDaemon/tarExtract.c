@@ -0,0 +1,1315 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file tarExtract.c
+ *
+ * Implementation of the Update Daemon's streaming tar extractor.
+ *
+ * The extractor is a small state machine that is fed from a non-blocking file descriptor (the
+ * output of the decompressor) whenever it becomes readable, so it shares the main thread's event
+ * loop with the rest of the update code.  Headers are read 512 bytes at a time, so the stream
+ * position is always at the start of a file's data when the data is needed; file data is then
+ * moved into the file with splice(), without being copied through the Update Daemon, into space
+ * that was preallocated for the whole file.
+ *
+ * The ustar format is supported, with the GNU long name and POSIX pax extensions used by the
+ * tar implementations that build update packs.  Like "tar xop", permissions are restored exactly,
+ * files are owned by the Update Daemon, and modification times are not restored.  Device nodes
+ * and FIFOs are skipped.
+ *
+ * Entries are confined to the extraction directory: paths with ".." components are refused, and
+ * every entry is created relative to its parent directory, which is opened one component at a time
+ * from the extraction directory without following symbolic links.  An entry whose path goes
+ * through a symbolic link (e.g. "a/passwd" after a link "a" -> "/etc") is refused.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "limit.h"
+#include "tarExtract.h"
+#include "fileDescriptor.h"
+
+
+/// Size of a tar block.  Headers are one block long, and data is padded to a multiple of this.
+#define BLOCK_BYTES             512
+
+/// Largest long name or pax header that is accepted.
+#define MAX_META_BYTES          4096
+
+/// Largest number of bytes moved by a single splice() call.
+#define MAX_SPLICE_BYTES        (1024 * 1024)
+
+/// Default permissions of the directories created for entries whose parent isn't in the stream.
+#define DEFAULT_DIR_MODE        (S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Layout of a ustar header block.  All numbers are octal ASCII strings.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    char name[100];
+    char mode[8];
+    char uid[8];
+    char gid[8];
+    char size[12];
+    char mtime[12];
+    char checksum[8];
+    char typeFlag;
+    char linkName[100];
+    char magic[6];
+    char version[2];
+    char userName[32];
+    char groupName[32];
+    char devMajor[8];
+    char devMinor[8];
+    char prefix[155];
+    char padding[12];
+}
+Header_t;
+
+static_assert(sizeof(Header_t) == BLOCK_BYTES, "Tar header layout must be one block long.");
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * State of the extractor.
+ */
+//--------------------------------------------------------------------------------------------------
+static enum
+{
+    STATE_HEADER,       ///< Reading a header block.
+    STATE_DATA,         ///< Moving a regular file's data into the file.
+    STATE_META,         ///< Reading the data of a long name or pax header entry.
+    STATE_SKIP,         ///< Skipping data that isn't extracted, and the padding after data.
+    STATE_TRAILER,      ///< Reading (and ignoring) everything after the end-of-archive block.
+    STATE_DONE          ///< Reached the end of the stream.
+}
+State = STATE_DONE;
+
+
+/// Directory that the stream is extracted into, and a file descriptor for it (-1 if not open).
+static char DirPath[LIMIT_MAX_PATH_BYTES];
+static int DirFd = -1;
+
+/// Header block being read, and the number of bytes of it that have been read so far.
+static union
+{
+    Header_t header;
+    char bytes[BLOCK_BYTES];
+}
+Block;
+static size_t BlockBytesRead;
+
+/// Data of the long name or pax header entry being read, and its size.
+static char Meta[MAX_META_BYTES + 1];
+static size_t MetaBytes;
+static size_t MetaBytesRead;
+static char MetaType;
+
+/// Path and link target for the next entry, from a long name or pax header entry ("" if none).
+static char LongName[LIMIT_MAX_PATH_BYTES];
+static char LongLinkName[LIMIT_MAX_PATH_BYTES];
+
+/// Size for the next entry from a pax header entry (-1 if none).
+static int64_t PaxSize = -1;
+
+/// Regular file being written (-1 if none), its path in the extraction directory, and its
+/// permissions.
+static int FileFd = -1;
+static char FilePath[LIMIT_MAX_PATH_BYTES];
+static mode_t FileMode;
+
+/// Number of data bytes of the current entry that are left to be moved or skipped.
+static uint64_t DataBytesLeft;
+
+/// Number of padding bytes to skip once the current entry's data has been handled.
+static size_t PaddingBytes;
+
+/// false if splice() isn't supported between the stream and the file system.
+static bool IsSpliceSupported = true;
+
+/// Buffer used to skip data, and to copy file data if splice() can't be used.
+static char Buffer[64 * 1024];
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read up to a number of bytes from the stream, retrying if interrupted by a signal.
+ *
+ * @return
+ *      - LE_OK if some bytes were read (count in *bytesReadPtr).
+ *      - LE_WOULD_BLOCK if there's nothing to read right now.
+ *      - LE_CLOSED on end of file.
+ *      - LE_FAULT on error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t Read
+(
+    int fd,
+    void* bufferPtr,
+    size_t bytesToRead,
+    size_t* bytesReadPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    ssize_t readResult;
+
+    do
+    {
+        readResult = read(fd, bufferPtr, bytesToRead);
+    }
+    while ((readResult == -1) && (errno == EINTR));
+
+    if (readResult == -1)
+    {
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+        {
+            return LE_WOULD_BLOCK;
+        }
+
+        LE_ERROR("Failed to read tar stream (%m).");
+        return LE_FAULT;
+    }
+
+    if (readResult == 0)
+    {
+        return LE_CLOSED;
+    }
+
+    *bytesReadPtr = readResult;
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse a numeric header field: octal ASCII, or base-256 if the top bit of the first byte is set
+ * (GNU extension for sizes of 8 GB and more).
+ *
+ * @return The value, or -1 if the field is not a valid number.
+ */
+//--------------------------------------------------------------------------------------------------
+static int64_t ParseNumber
+(
+    const char* fieldPtr,
+    size_t fieldSize
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint64_t value = 0;
+    size_t i = 0;
+
+    if ((unsigned char)fieldPtr[0] & 0x80)
+    {
+        value = (unsigned char)fieldPtr[0] & 0x3f;
+
+        for (i = 1; i < fieldSize; i++)
+        {
+            if (value > (INT64_MAX >> 8))
+            {
+                return -1;
+            }
+            value = (value << 8) | (unsigned char)fieldPtr[i];
+        }
+
+        return value;
+    }
+
+    // Skip leading spaces.
+    while ((i < fieldSize) && (fieldPtr[i] == ' '))
+    {
+        i++;
+    }
+
+    for (; (i < fieldSize) && (fieldPtr[i] >= '0') && (fieldPtr[i] <= '7'); i++)
+    {
+        if (value > (INT64_MAX >> 3))
+        {
+            return -1;
+        }
+        value = (value << 3) | (fieldPtr[i] - '0');
+    }
+
+    // The number must end with a space or a null (or fill the field).
+    if ((i < fieldSize) && (fieldPtr[i] != ' ') && (fieldPtr[i] != '\0'))
+    {
+        return -1;
+    }
+
+    return value;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check a header block's checksum.  The checksum is the sum of the header's bytes, with the
+ * checksum field itself counted as spaces.  Some old tar implementations summed signed chars.
+ *
+ * @return true if the checksum is correct.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsChecksumValid
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    int64_t expected = ParseNumber(Block.header.checksum, sizeof(Block.header.checksum));
+    size_t checksumOffset = offsetof(Header_t, checksum);
+    int64_t unsignedSum = 0;
+    int64_t signedSum = 0;
+    size_t i;
+
+    for (i = 0; i < BLOCK_BYTES; i++)
+    {
+        if ((i >= checksumOffset) && (i < checksumOffset + sizeof(Block.header.checksum)))
+        {
+            unsignedSum += ' ';
+            signedSum += ' ';
+        }
+        else
+        {
+            unsignedSum += (unsigned char)Block.bytes[i];
+            signedSum += (signed char)Block.bytes[i];
+        }
+    }
+
+    return (expected == unsignedSum) || (expected == signedSum);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copy a header field that may not be null-terminated.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CopyField
+(
+    char* destPtr,
+    size_t destSize,
+    const char* fieldPtr,
+    size_t fieldSize
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t length = strnlen(fieldPtr, fieldSize);
+
+    if (length >= destSize)
+    {
+        length = destSize - 1;
+    }
+
+    memcpy(destPtr, fieldPtr, length);
+    destPtr[length] = '\0';
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Build the path of an entry relative to the extraction directory.  Leading slashes and "./" are
+ * dropped, paths that would escape the directory are refused, and the extraction directory itself
+ * is ".".
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_FORMAT_ERROR if the path is not acceptable.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t GetEntryPath
+(
+    const char* entryPathPtr,       ///< [IN] Path found in the stream.
+    char* pathBuffPtr,              ///< [OUT] Path relative to the extraction directory.
+    size_t pathBuffSize
+)
+//--------------------------------------------------------------------------------------------------
+{
+    while ((entryPathPtr[0] == '/') ||
+           ((entryPathPtr[0] == '.') && (entryPathPtr[1] == '/')))
+    {
+        entryPathPtr += (entryPathPtr[0] == '/') ? 1 : 2;
+    }
+
+    // Refuse any ".." path component.
+    const char* componentPtr = entryPathPtr;
+
+    while (componentPtr != NULL)
+    {
+        if ((componentPtr[0] == '.') && (componentPtr[1] == '.') &&
+            ((componentPtr[2] == '/') || (componentPtr[2] == '\0')))
+        {
+            LE_ERROR("Tar entry '%s' is outside the extraction directory.", entryPathPtr);
+            return LE_FORMAT_ERROR;
+        }
+
+        componentPtr = strchr(componentPtr, '/');
+        if (componentPtr != NULL)
+        {
+            componentPtr++;
+        }
+    }
+
+    if (le_utf8_Copy(pathBuffPtr, (entryPathPtr[0] == '\0') ? "." : entryPathPtr, pathBuffSize,
+                     NULL) != LE_OK)
+    {
+        LE_ERROR("Tar entry path '%s' is too long.", entryPathPtr);
+        return LE_FORMAT_ERROR;
+    }
+
+    // Drop the trailing slash of directory entries.
+    size_t length = strlen(pathBuffPtr);
+
+    while ((length > 1) && (pathBuffPtr[length - 1] == '/'))
+    {
+        pathBuffPtr[--length] = '\0';
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close a directory opened by OpenParentDir().
+ */
+//--------------------------------------------------------------------------------------------------
+static void CloseDir
+(
+    int dirFd
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (dirFd != DirFd)
+    {
+        fd_Close(dirFd);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open the parent directory of an entry, one path component at a time from the extraction
+ * directory, without following symbolic links.  Parent directories that the stream didn't contain
+ * can be created on the way.
+ *
+ * @return
+ *      - LE_OK if successful.  The directory must be closed with CloseDir().
+ *      - LE_FORMAT_ERROR if the path goes through something that is not a directory, such as a
+ *        symbolic link.
+ *      - LE_FAULT if a directory could not be opened or created.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t OpenParentDir
+(
+    const char* pathPtr,        ///< [IN] Path relative to the extraction directory.
+    bool create,                ///< [IN] true to create missing directories.
+    int* dirFdPtr,              ///< [OUT] Parent directory.
+    const char** namePtrPtr     ///< [OUT] Name of the entry in its parent directory.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const int flags = O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC;
+    char component[LIMIT_MAX_PATH_BYTES];
+    const char* namePtr = pathPtr;
+    const char* slashPtr;
+    int dirFd = DirFd;
+
+    if (dirFd == -1)
+    {
+        LE_ERROR("Extraction directory '%s' is not open.", DirPath);
+        return LE_FAULT;
+    }
+
+    while ((slashPtr = strchr(namePtr, '/')) != NULL)
+    {
+        size_t length = slashPtr - namePtr;
+
+        memcpy(component, namePtr, length);
+        component[length] = '\0';
+        namePtr = slashPtr + 1;
+
+        if (length == 0)
+        {
+            continue;
+        }
+
+        int nextFd = openat(dirFd, component, flags);
+
+        if ((nextFd == -1) && (errno == ENOENT) && create)
+        {
+            if ((mkdirat(dirFd, component, DEFAULT_DIR_MODE) == 0) || (errno == EEXIST))
+            {
+                nextFd = openat(dirFd, component, flags);
+            }
+        }
+
+        if (nextFd == -1)
+        {
+            le_result_t result = LE_FAULT;
+
+            if ((errno == ELOOP) || (errno == ENOTDIR))
+            {
+                LE_ERROR("Tar entry '%s' goes through '%s', which is not a directory.",
+                         pathPtr,
+                         component);
+                result = LE_FORMAT_ERROR;
+            }
+            else
+            {
+                LE_ERROR("Failed to open directory '%s' of tar entry '%s' (%m).",
+                         component,
+                         pathPtr);
+            }
+
+            CloseDir(dirFd);
+            return result;
+        }
+
+        CloseDir(dirFd);
+        dirFd = nextFd;
+    }
+
+    *dirFdPtr = dirFd;
+    *namePtrPtr = namePtr;
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove whatever is in a directory under an entry's name, so it can be replaced.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RemoveExisting
+(
+    int dirFd,                  ///< [IN] Parent directory.
+    const char* namePtr,        ///< [IN] Name of the entry in its parent directory.
+    const char* pathPtr         ///< [IN] Path of the entry relative to the extraction directory.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // Never remove the extraction directory, or a directory from under itself.
+    if ((namePtr[0] == '\0') || (strcmp(namePtr, ".") == 0))
+    {
+        return;
+    }
+
+    if ((unlinkat(dirFd, namePtr, 0) == -1) && (errno == EISDIR))
+    {
+        // The parent directories have just been checked to be real directories, so the full
+        // path leads to the same place.
+        char fullPath[LIMIT_MAX_PATH_BYTES] = "";
+
+        if (le_path_Concat("/", fullPath, sizeof(fullPath), DirPath, pathPtr, NULL) == LE_OK)
+        {
+            le_dir_RemoveRecursive(fullPath);
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start extracting a regular file.
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_FORMAT_ERROR if the path goes through something that is not a directory.
+ *      - LE_FAULT if the file could not be created.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t StartFile
+(
+    const char* pathPtr,
+    mode_t mode,
+    uint64_t size
+)
+//--------------------------------------------------------------------------------------------------
+{
+    int dirFd;
+    const char* namePtr;
+    le_result_t result = OpenParentDir(pathPtr, true, &dirFd, &namePtr);
+
+    if (result != LE_OK)
+    {
+        return result;
+    }
+
+    RemoveExisting(dirFd, namePtr, pathPtr);
+
+    // O_EXCL and O_NOFOLLOW, so nothing that appears at the path can redirect the write.
+    FileFd = openat(dirFd, namePtr, O_WRONLY | O_CREAT | O_EXCL | O_NOFOLLOW | O_CLOEXEC,
+                    S_IRUSR | S_IWUSR);
+
+    if (FileFd == -1)
+    {
+        LE_ERROR("Failed to create file '%s' (%m).", pathPtr);
+        CloseDir(dirFd);
+        return LE_FAULT;
+    }
+
+    CloseDir(dirFd);
+
+    // Reserve the space for the whole file up front, so that it is laid out contiguously and
+    // running out of space is found before the data is written.  Not all file systems support
+    // this, which is fine.
+    if (size > 0)
+    {
+        int result = fallocate(FileFd, 0, 0, size);
+
+        if ((result != 0) && (errno == ENOSPC))
+        {
+            LE_ERROR("No space for file '%s' (%" PRIu64 " bytes).", pathPtr, size);
+            fd_Close(FileFd);
+            FileFd = -1;
+            return LE_FAULT;
+        }
+    }
+
+    LE_ASSERT(le_utf8_Copy(FilePath, pathPtr, sizeof(FilePath), NULL) == LE_OK);
+    FileMode = mode;
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finish extracting the regular file that is being written.
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_FAULT if the file could not be completed.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t FinishFile
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_result_t result = LE_OK;
+
+    if (fchmod(FileFd, FileMode) == -1)
+    {
+        LE_ERROR("Failed to set permissions of '%s' (%m).", FilePath);
+        result = LE_FAULT;
+    }
+
+    if (close(FileFd) == -1)
+    {
+        LE_ERROR("Failed to write file '%s' (%m).", FilePath);
+        result = LE_FAULT;
+    }
+
+    FileFd = -1;
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a directory, or update the permissions of an existing one.
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_FORMAT_ERROR if the path goes through something that is not a directory.
+ *      - LE_FAULT if the directory could not be created.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t MakeDir
+(
+    const char* pathPtr,
+    mode_t mode
+)
+//--------------------------------------------------------------------------------------------------
+{
+    int dirFd;
+    const char* namePtr;
+    le_result_t result = OpenParentDir(pathPtr, true, &dirFd, &namePtr);
+
+    if (result != LE_OK)
+    {
+        return result;
+    }
+
+    struct stat pathStat;
+
+    if ((fstatat(dirFd, namePtr, &pathStat, AT_SYMLINK_NOFOLLOW) == 0) &&
+        !S_ISDIR(pathStat.st_mode))
+    {
+        RemoveExisting(dirFd, namePtr, pathPtr);
+    }
+
+    int fd = -1;
+
+    if ((mkdirat(dirFd, namePtr, S_IRWXU) == 0) || (errno == EEXIST))
+    {
+        fd = openat(dirFd, namePtr, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    }
+
+    if ((fd == -1) || (fchmod(fd, mode) == -1))
+    {
+        LE_ERROR("Failed to create directory '%s' (%m).", pathPtr);
+        result = LE_FAULT;
+    }
+
+    if (fd != -1)
+    {
+        fd_Close(fd);
+    }
+
+    CloseDir(dirFd);
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a symbolic link or a hard link.
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_FORMAT_ERROR if the path or a hard link target is not acceptable.
+ *      - LE_FAULT if the link could not be created.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t MakeLink
+(
+    const char* pathPtr,
+    const char* linkNamePtr,
+    bool isSymlink
+)
+//--------------------------------------------------------------------------------------------------
+{
+    char targetPath[LIMIT_MAX_PATH_BYTES];
+    int targetDirFd = -1;
+    const char* targetNamePtr = linkNamePtr;
+    le_result_t result;
+
+    // Hard link targets are other entries of the stream, so they are looked up the same way.
+    if (!isSymlink)
+    {
+        result = GetEntryPath(linkNamePtr, targetPath, sizeof(targetPath));
+
+        if (result == LE_OK)
+        {
+            result = OpenParentDir(targetPath, false, &targetDirFd, &targetNamePtr);
+        }
+
+        if (result != LE_OK)
+        {
+            return result;
+        }
+    }
+
+    int dirFd;
+    const char* namePtr;
+
+    result = OpenParentDir(pathPtr, true, &dirFd, &namePtr);
+
+    if (result == LE_OK)
+    {
+        RemoveExisting(dirFd, namePtr, pathPtr);
+
+        // The link itself is created in the checked parent directory.  A symbolic link's target
+        // is only ever followed by the entries that go through it, which are refused.
+        if ((isSymlink ? symlinkat(linkNamePtr, dirFd, namePtr) :
+                         linkat(targetDirFd, targetNamePtr, dirFd, namePtr, 0)) == -1)
+        {
+            LE_ERROR("Failed to link '%s' to '%s' (%m).", pathPtr, linkNamePtr);
+            result = LE_FAULT;
+        }
+
+        CloseDir(dirFd);
+    }
+
+    if (targetDirFd != -1)
+    {
+        CloseDir(targetDirFd);
+    }
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Go to the state that handles an entry's data, followed by its padding.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ExpectData
+(
+    int dataState,
+    uint64_t size
+)
+//--------------------------------------------------------------------------------------------------
+{
+    DataBytesLeft = size;
+    PaddingBytes = (BLOCK_BYTES - (size % BLOCK_BYTES)) % BLOCK_BYTES;
+
+    if (dataState == STATE_SKIP)
+    {
+        // Skip the data and the padding in one go.
+        DataBytesLeft += PaddingBytes;
+        PaddingBytes = 0;
+    }
+
+    State = ((DataBytesLeft == 0) && (PaddingBytes == 0)) ? STATE_HEADER : dataState;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Go on to the padding after an entry's data, or to the next header.
+ */
+//--------------------------------------------------------------------------------------------------
+static void EndData
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    DataBytesLeft = PaddingBytes;
+    PaddingBytes = 0;
+    State = (DataBytesLeft == 0) ? STATE_HEADER : STATE_SKIP;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handle a complete header block.
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_FORMAT_ERROR if the header is not valid.
+ *      - LE_FAULT if the entry could not be created.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ProcessHeader
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // The end of the archive is marked by a block of zeros (normally two).
+    size_t i;
+
+    for (i = 0; (i < BLOCK_BYTES) && (Block.bytes[i] == '\0'); i++) {}
+
+    if (i == BLOCK_BYTES)
+    {
+        State = STATE_TRAILER;
+        return LE_OK;
+    }
+
+    if (!IsChecksumValid())
+    {
+        LE_ERROR("Bad tar header checksum.");
+        return LE_FORMAT_ERROR;
+    }
+
+    int64_t size = (PaxSize >= 0) ? PaxSize : ParseNumber(Block.header.size,
+                                                          sizeof(Block.header.size));
+    int64_t mode = ParseNumber(Block.header.mode, sizeof(Block.header.mode));
+
+    if ((size < 0) || (mode < 0))
+    {
+        LE_ERROR("Bad tar header.");
+        return LE_FORMAT_ERROR;
+    }
+
+    mode &= 07777;
+    PaxSize = -1;
+
+    // Long name and pax header entries describe the entry that follows them.
+    if ((Block.header.typeFlag == 'L') || (Block.header.typeFlag == 'K') ||
+        (Block.header.typeFlag == 'x'))
+    {
+        if (size > MAX_META_BYTES)
+        {
+            LE_ERROR("Tar extended header too long (%" PRId64 " bytes).", size);
+            return LE_FORMAT_ERROR;
+        }
+
+        MetaType = Block.header.typeFlag;
+        MetaBytes = size;
+        MetaBytesRead = 0;
+        ExpectData(STATE_META, size);
+        return LE_OK;
+    }
+
+    // Work out the entry's path and link target.
+    char entryPath[LIMIT_MAX_PATH_BYTES];
+    char linkName[LIMIT_MAX_PATH_BYTES];
+
+    if (LongName[0] != '\0')
+    {
+        LE_ASSERT(le_utf8_Copy(entryPath, LongName, sizeof(entryPath), NULL) == LE_OK);
+    }
+    else
+    {
+        char name[sizeof(Block.header.name) + 1];
+        char prefix[sizeof(Block.header.prefix) + 1];
+
+        CopyField(name, sizeof(name), Block.header.name, sizeof(Block.header.name));
+        CopyField(prefix, sizeof(prefix), Block.header.prefix, sizeof(Block.header.prefix));
+
+        entryPath[0] = '\0';
+        if ((memcmp(Block.header.magic, "ustar", 5) == 0) && (prefix[0] != '\0'))
+        {
+            LE_ASSERT(le_path_Concat("/", entryPath, sizeof(entryPath), prefix, name, NULL)
+                      == LE_OK);
+        }
+        else
+        {
+            LE_ASSERT(le_utf8_Copy(entryPath, name, sizeof(entryPath), NULL) == LE_OK);
+        }
+    }
+
+    if (LongLinkName[0] != '\0')
+    {
+        LE_ASSERT(le_utf8_Copy(linkName, LongLinkName, sizeof(linkName), NULL) == LE_OK);
+    }
+    else
+    {
+        CopyField(linkName, sizeof(linkName), Block.header.linkName, sizeof(Block.header.linkName));
+    }
+
+    LongName[0] = '\0';
+    LongLinkName[0] = '\0';
+
+    char path[LIMIT_MAX_PATH_BYTES];
+    le_result_t result = GetEntryPath(entryPath, path, sizeof(path));
+
+    if (result != LE_OK)
+    {
+        return result;
+    }
+
+    switch (Block.header.typeFlag)
+    {
+        case '0':
+        case '\0':
+        case '7':
+            result = StartFile(path, mode, size);
+            if (result == LE_OK)
+            {
+                ExpectData(STATE_DATA, size);
+                if (State != STATE_DATA)
+                {
+                    result = FinishFile();
+                    EndData();
+                }
+            }
+            return result;
+
+        case '5':
+            result = MakeDir(path, mode);
+            break;
+
+        case '1':
+            result = MakeLink(path, linkName, false);
+            break;
+
+        case '2':
+            result = MakeLink(path, linkName, true);
+            break;
+
+        case 'g':
+            // Global pax headers only hold defaults that don't matter here.
+            break;
+
+        default:
+            LE_WARN("Skipping tar entry '%s' of unsupported type '%c'.",
+                    entryPath,
+                    Block.header.typeFlag);
+            break;
+    }
+
+    // Skip any data that the entry has.
+    ExpectData(STATE_SKIP, size);
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handle the complete data of a long name or pax header entry.
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_FORMAT_ERROR if the data is not valid.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ProcessMeta
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Meta[MetaBytes] = '\0';
+
+    if (MetaType == 'L')
+    {
+        return (le_utf8_Copy(LongName, Meta, sizeof(LongName), NULL) == LE_OK) ?
+               LE_OK : LE_FORMAT_ERROR;
+    }
+
+    if (MetaType == 'K')
+    {
+        return (le_utf8_Copy(LongLinkName, Meta, sizeof(LongLinkName), NULL) == LE_OK) ?
+               LE_OK : LE_FORMAT_ERROR;
+    }
+
+    // Pax records look like "<length> <key>=<value>\n".
+    size_t offset = 0;
+
+    while (offset < MetaBytes)
+    {
+        char* recordPtr = Meta + offset;
+        char* endPtr;
+        unsigned long length = strtoul(recordPtr, &endPtr, 10);
+
+        if ((length == 0) || (length > MetaBytes - offset) || (*endPtr != ' ') ||
+            (recordPtr[length - 1] != '\n'))
+        {
+            LE_ERROR("Bad pax header record.");
+            return LE_FORMAT_ERROR;
+        }
+
+        recordPtr[length - 1] = '\0';
+
+        char* keyPtr = endPtr + 1;
+        char* valuePtr = strchr(keyPtr, '=');
+
+        if (valuePtr == NULL)
+        {
+            LE_ERROR("Bad pax header record.");
+            return LE_FORMAT_ERROR;
+        }
+
+        *valuePtr++ = '\0';
+
+        le_result_t result = LE_OK;
+
+        if (strcmp(keyPtr, "path") == 0)
+        {
+            result = le_utf8_Copy(LongName, valuePtr, sizeof(LongName), NULL);
+        }
+        else if (strcmp(keyPtr, "linkpath") == 0)
+        {
+            result = le_utf8_Copy(LongLinkName, valuePtr, sizeof(LongLinkName), NULL);
+        }
+        else if (strcmp(keyPtr, "size") == 0)
+        {
+            PaxSize = strtoll(valuePtr, NULL, 10);
+        }
+
+        if (result != LE_OK)
+        {
+            LE_ERROR("Tar entry path '%s' is too long.", valuePtr);
+            return LE_FORMAT_ERROR;
+        }
+
+        offset += length;
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move as much of a regular file's data as is available into the file.
+ *
+ * @return
+ *      - LE_OK if all the data has been written.
+ *      - LE_WOULD_BLOCK if more of the stream is needed.
+ *      - LE_CLOSED if the stream ends before the data.
+ *      - LE_FAULT if the stream could not be read or the file could not be written.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t CopyData
+(
+    int fd
+)
+//--------------------------------------------------------------------------------------------------
+{
+    while (DataBytesLeft > 0)
+    {
+        size_t bytesToMove = (DataBytesLeft > MAX_SPLICE_BYTES) ? MAX_SPLICE_BYTES : DataBytesLeft;
+        ssize_t bytesMoved = -1;
+
+        if (IsSpliceSupported)
+        {
+            // The file is always writable, so EAGAIN can only mean the stream is empty.
+            do
+            {
+                bytesMoved = splice(fd, NULL, FileFd, NULL, bytesToMove,
+                                    SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+            }
+            while ((bytesMoved == -1) && (errno == EINTR));
+
+            if ((bytesMoved == -1) && (errno == EINVAL))
+            {
+                LE_INFO("splice() not supported, copying file data instead.");
+                IsSpliceSupported = false;
+            }
+        }
+
+        if (!IsSpliceSupported)
+        {
+            size_t bytesRead;
+            le_result_t result = Read(fd,
+                                      Buffer,
+                                      (bytesToMove > sizeof(Buffer)) ? sizeof(Buffer) : bytesToMove,
+                                      &bytesRead);
+
+            if (result != LE_OK)
+            {
+                return result;
+            }
+
+            if (fd_WriteSize(FileFd, Buffer, bytesRead) != (ssize_t)bytesRead)
+            {
+                LE_ERROR("Failed to write file '%s' (%m).", FilePath);
+                return LE_FAULT;
+            }
+
+            bytesMoved = bytesRead;
+        }
+        else if (bytesMoved == 0)
+        {
+            return LE_CLOSED;
+        }
+        else if (bytesMoved == -1)
+        {
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+            {
+                return LE_WOULD_BLOCK;
+            }
+
+            LE_ERROR("Failed to write file '%s' (%m).", FilePath);
+            return LE_FAULT;
+        }
+
+        DataBytesLeft -= bytesMoved;
+    }
+
+    le_result_t result = FinishFile();
+
+    EndData();
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Perform one step of the extraction.
+ *
+ * @return
+ *      - LE_OK if the step is complete.
+ *      - LE_WOULD_BLOCK if more of the stream is needed.
+ *      - LE_CLOSED if the stream ends before the end-of-archive block.
+ *      - LE_FORMAT_ERROR if the stream is not valid.
+ *      - LE_FAULT on error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ProcessStep
+(
+    int fd
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_result_t result;
+    size_t bytesRead;
+
+    switch (State)
+    {
+        case STATE_HEADER:
+
+            result = Read(fd, Block.bytes + BlockBytesRead, BLOCK_BYTES - BlockBytesRead, &bytesRead);
+            if (result != LE_OK)
+            {
+                return result;
+            }
+
+            BlockBytesRead += bytesRead;
+            if (BlockBytesRead < BLOCK_BYTES)
+            {
+                return LE_OK;
+            }
+
+            BlockBytesRead = 0;
+            return ProcessHeader();
+
+        case STATE_DATA:
+
+            return CopyData(fd);
+
+        case STATE_META:
+
+            result = Read(fd, Meta + MetaBytesRead, MetaBytes - MetaBytesRead, &bytesRead);
+            if (result != LE_OK)
+            {
+                return result;
+            }
+
+            MetaBytesRead += bytesRead;
+            if (MetaBytesRead < MetaBytes)
+            {
+                return LE_OK;
+            }
+
+            EndData();
+            return ProcessMeta();
+
+        case STATE_SKIP:
+
+            result = Read(fd,
+                          Buffer,
+                          (DataBytesLeft > sizeof(Buffer)) ? sizeof(Buffer) : DataBytesLeft,
+                          &bytesRead);
+            if (result != LE_OK)
+            {
+                return result;
+            }
+
+            DataBytesLeft -= bytesRead;
+            if (DataBytesLeft == 0)
+            {
+                State = STATE_HEADER;
+            }
+            return LE_OK;
+
+        case STATE_TRAILER:
+
+            // Tar pads the archive to a whole number of records, so read until the end of file.
+            result = Read(fd, Buffer, sizeof(Buffer), &bytesRead);
+            if (result == LE_CLOSED)
+            {
+                State = STATE_DONE;
+                return LE_OK;
+            }
+            return result;
+
+        case STATE_DONE:
+
+            return LE_OK;
+    }
+
+    LE_FATAL("Unexpected tar extractor state %d.", State);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start extracting a new tar stream.  Any extraction in progress is abandoned.
+ */
+//--------------------------------------------------------------------------------------------------
+void tarExtract_Start
+(
+    const char* dirPath     ///< [IN] Directory to extract the tar stream into.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    tarExtract_Stop();
+
+    LE_ASSERT(le_utf8_Copy(DirPath, dirPath, sizeof(DirPath), NULL) == LE_OK);
+
+    // The extraction directory itself may be reached through symbolic links.  If it can't be
+    // opened, creating the entries will fail.
+    DirFd = open(DirPath, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+    if (DirFd == -1)
+    {
+        LE_ERROR("Failed to open extraction directory '%s' (%m).", DirPath);
+    }
+
+    State = STATE_HEADER;
+    BlockBytesRead = 0;
+    LongName[0] = '\0';
+    LongLinkName[0] = '\0';
+    PaxSize = -1;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Extract as much of the tar stream as can be read from a non-blocking file descriptor right now.
+ * Call again when the file descriptor becomes readable.
+ *
+ * @return
+ *      - LE_WOULD_BLOCK if more of the stream is needed.
+ *      - LE_OK if the whole stream has been extracted and the end of file has been reached.
+ *      - LE_FORMAT_ERROR if the stream is not a valid tar stream, or is truncated.
+ *      - LE_FAULT if the stream could not be read or a file could not be written.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t tarExtract_Process
+(
+    int fd                  ///< [IN] Non-blocking file descriptor to read the tar stream from.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    while (State != STATE_DONE)
+    {
+        le_result_t result = ProcessStep(fd);
+
+        if (result == LE_CLOSED)
+        {
+            LE_ERROR("Unexpected end of tar stream.");
+            result = LE_FORMAT_ERROR;
+        }
+
+        if (result != LE_OK)
+        {
+            if (result != LE_WOULD_BLOCK)
+            {
+                tarExtract_Stop();
+            }
+
+            return result;
+        }
+    }
+
+    tarExtract_Stop();
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stop extracting, closing any file that is being written and the extraction directory.
+ */
+//--------------------------------------------------------------------------------------------------
+void tarExtract_Stop
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (FileFd != -1)
+    {
+        fd_Close(FileFd);
+        FileFd = -1;
+    }
+
+    if (DirFd != -1)
+    {
+        fd_Close(DirFd);
+        DirFd = -1;
+    }
+
+    State = STATE_DONE;
+}
@@ -0,0 +1,56 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file tarExtract.h
+ *
+ * Functions exported by the Update Daemon's tar extractor, which unpacks a tar stream into a
+ * directory as the stream arrives, without blocking the event loop.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#ifndef LEGATO_UPDATE_DAEMON_TAR_EXTRACT_H_INCLUDE_GUARD
+#define LEGATO_UPDATE_DAEMON_TAR_EXTRACT_H_INCLUDE_GUARD
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start extracting a new tar stream.  Any extraction in progress is abandoned.
+ */
+//--------------------------------------------------------------------------------------------------
+void tarExtract_Start
+(
+    const char* dirPath     ///< [IN] Directory to extract the tar stream into.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Extract as much of the tar stream as can be read from a non-blocking file descriptor right now.
+ * Call again when the file descriptor becomes readable.
+ *
+ * @return
+ *      - LE_WOULD_BLOCK if more of the stream is needed.
+ *      - LE_OK if the whole stream has been extracted and the end of file has been reached.
+ *      - LE_FORMAT_ERROR if the stream is not a valid tar stream, or is truncated.
+ *      - LE_FAULT if the stream could not be read or a file could not be written.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t tarExtract_Process
+(
+    int fd                  ///< [IN] Non-blocking file descriptor to read the tar stream from.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stop extracting, closing any file that is being written and the extraction directory.
+ */
+//--------------------------------------------------------------------------------------------------
+void tarExtract_Stop
+(
+    void
+);
+
+
+#endif // LEGATO_UPDATE_DAEMON_TAR_EXTRACT_H_INCLUDE_GUARD
@@ -19,6 +19,10 @@
 #include "fileDescriptor.h"
 #include "system.h"
 #include "app.h"
+#include "tarExtract.h"
+#include "appDelta.h"
+
+#include <sys/resource.h>
 
 
 /// An MD5 hash string is 32 characters long, plus a null terminator.
@@ -40,6 +44,30 @@ static pipeline_Ref_t Pipeline = NULL;
 /// File descriptor connected to the input of a pipeline (-1 if not unpacking)
 static int PipelineFd = -1;
 
+/// Reference to the FD Monitor for the input of the pipeline (NULL if not unpacking).
+static le_fdMonitor_Ref_t PipelineFdMonitor = NULL;
+
+/// File descriptor connected to the output of a pipeline (-1 if not unpacking)
+static int OutputFd = -1;
+
+/// Reference to the FD Monitor for the output of the pipeline (NULL if not unpacking).
+static le_fdMonitor_Ref_t OutputFdMonitor = NULL;
+
+/// Payload bytes read from the input stream that are waiting to be written into the pipeline.
+static char CopyBuffer[64 * 1024];
+static size_t CopyBufferBytes;
+static size_t CopyBufferOffset;
+
+/// Has the payload been extracted?  Has the decompressor exited successfully?
+static bool IsExtracted;
+static bool IsDecompressed;
+
+/// Wall clock time, and CPU time of the Update Daemon and of its reaped children, at the start
+/// of the unpack of a payload.
+static le_clk_Time_t UnpackStartTime;
+static unsigned int UnpackStartCpuMs;
+static unsigned int UnpackStartChildCpuMs;
+
 /// Function to be called to report progress.
 static updateUnpack_ProgressHandler_t ProgressFunc = NULL;
 
@@ -55,6 +83,13 @@ static char AppName[LIMIT_MAX_APP_NAME_BYTES];
 /// The MD5 hash obtained from a JSON header.
 static char Md5[MD5_STRING_BYTES]; ///< The system's MD5 hash.
 
+/// The MD5 hash of the installed app version that an app update's delta payload applies to
+/// (empty if the payload is a full app).
+static char BaseMd5[MD5_STRING_BYTES];
+
+/// Directory the current payload is being unpacked into.
+static char UnpackDirPath[LIMIT_MAX_PATH_BYTES];
+
 /// # of bytes of payload following the JSON.
 static size_t PayloadSize;
 
@@ -142,6 +177,56 @@ static void DeleteFdMonitor
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete the FD Monitor objects of the unpack pipeline's input and output.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DeletePipelineFdMonitors
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (PipelineFdMonitor != NULL)
+    {
+        le_fdMonitor_Delete(PipelineFdMonitor);
+        PipelineFdMonitor = NULL;
+    }
+
+    if (OutputFdMonitor != NULL)
+    {
+        le_fdMonitor_Delete(OutputFdMonitor);
+        OutputFdMonitor = NULL;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the CPU time (user + system) used by this process or by its reaped children.
+ *
+ * @return The CPU time in milliseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static unsigned int GetCpuMs
+(
+    int who     ///< [IN] RUSAGE_SELF or RUSAGE_CHILDREN.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    struct rusage usage;
+
+    if (getrusage(who, &usage) != 0)
+    {
+        return 0;
+    }
+
+    return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000 +
+           (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Reset the update unpacker.
@@ -164,6 +249,10 @@ static void Reset
     }
 
     DeleteFdMonitor();
+    DeletePipelineFdMonitors();
+
+    tarExtract_Stop();
+    appDelta_Stop();
 
     // Close the pipes.
     if (InputFd != -1)
@@ -181,6 +270,11 @@ static void Reset
         fd_Close(PipelineFd);
         PipelineFd = -1;
     }
+    if (OutputFd != -1)
+    {
+        fd_Close(OutputFd);
+        OutputFd = -1;
+    }
 
     // Delete the pipeline.
     if (Pipeline != NULL)
@@ -358,6 +452,7 @@ static void StartParsing
     Command[0] = '\0';
     AppName[0] = '\0';
     Md5[0] = '\0';
+    BaseMd5[0] = '\0';
     PayloadSize = 0;
 
     // Set the state
@@ -370,38 +465,15 @@ static void StartParsing
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Completion callback for "tar xj" operation.
+ * Called when a payload has been fully installed in its unpack directory.
  */
 //--------------------------------------------------------------------------------------------------
-static void UntarDone
+static void PayloadDone
 (
-    pipeline_Ref_t pipeline,
-    int status
+    void
 )
 //--------------------------------------------------------------------------------------------------
 {
-    pipeline_Delete(Pipeline);
-    Pipeline = NULL;
-
-    if (!WIFEXITED(status) || (WEXITSTATUS(status) != EXIT_SUCCESS))
-    {
-        if (WIFEXITED(status))
-        {
-            LE_ERROR("Payload unpack pipeline failed with exit code: %d", WEXITSTATUS(status));
-        }
-        else if (WIFSIGNALED(status))
-        {
-            LE_ERROR("Payload unpack pipeline killed by signal: %d", WTERMSIG(status));
-        }
-        else
-        {
-            LE_ERROR("Payload unpack pipeline died for unknown reason (status: %d)", status);
-        }
-
-        HandleInternalError();
-        return;
-    }
-
     // If this update pack contains changes to individual apps,
     if (Type == TYPE_APP_UPDATE)
     {
@@ -436,6 +508,111 @@ static void UntarDone
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Completion callback for the application of an app delta payload.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DeltaDone
+(
+    le_result_t result
+)
+//--------------------------------------------------------------------------------------------------
+{
+    switch (result)
+    {
+        case LE_OK:
+            PayloadDone();
+            break;
+
+        case LE_FORMAT_ERROR:
+            LE_ERROR("Malformed update pack (bad delta against app %s)", BaseMd5);
+            HandleFormatError();
+            break;
+
+        default:
+            HandleInternalError();
+            break;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Called when a payload has been extracted and the decompressor has exited successfully.
+ */
+//--------------------------------------------------------------------------------------------------
+static void UnpackDone
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), UnpackStartTime);
+
+    LE_INFO("Unpacked %zu byte payload in %u ms (CPU: update daemon %u ms, decompressor %u ms).",
+            PayloadSize,
+            (unsigned int)((elapsed.sec * 1000) + (elapsed.usec / 1000)),
+            GetCpuMs(RUSAGE_SELF) - UnpackStartCpuMs,
+            GetCpuMs(RUSAGE_CHILDREN) - UnpackStartChildCpuMs);
+
+    // A delta payload only holds what changed in the app; rebuild the rest from the installed
+    // version.  This is asynchronous and will call DeltaDone() when finished.
+    if ((strcmp(Command, "updateApp") == 0) && (BaseMd5[0] != '\0'))
+    {
+        LE_INFO("Applying delta against app with MD5 sum %s.", BaseMd5);
+        appDelta_Start(UnpackDirPath, BaseMd5, DeltaDone);
+        return;
+    }
+
+    PayloadDone();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Completion callback for the unpack pipeline's decompressor.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DecompressDone
+(
+    pipeline_Ref_t pipeline,
+    int status
+)
+//--------------------------------------------------------------------------------------------------
+{
+    pipeline_Delete(Pipeline);
+    Pipeline = NULL;
+
+    if (!WIFEXITED(status) || (WEXITSTATUS(status) != EXIT_SUCCESS))
+    {
+        if (WIFEXITED(status))
+        {
+            LE_ERROR("Payload unpack pipeline failed with exit code: %d", WEXITSTATUS(status));
+        }
+        else if (WIFSIGNALED(status))
+        {
+            LE_ERROR("Payload unpack pipeline killed by signal: %d", WTERMSIG(status));
+        }
+        else
+        {
+            LE_ERROR("Payload unpack pipeline died for unknown reason (status: %d)", status);
+        }
+
+        HandleInternalError();
+        return;
+    }
+
+    // The extractor may still be working through the end of the decompressor's output.
+    IsDecompressed = true;
+
+    if (IsExtracted)
+    {
+        UnpackDone();
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Completion callback for skip forward operation that is done instead of an app unpack + install
@@ -473,7 +650,10 @@ static void SkipForwardDone
 //--------------------------------------------------------------------------------------------------
 /**
  * Copy bytes from the input fd to the pipeline's input fd until the input fd's read buffer is
- * empty or we have copied all the payload bytes.
+ * empty, the pipeline can't take any more right now, or we have copied all the payload bytes.
+ *
+ * While the pipeline is full, the input fd is not monitored, and the pipeline's input fd is
+ * monitored for space instead.
  */
 //--------------------------------------------------------------------------------------------------
 static void CopyBytesToPipeline
@@ -482,23 +662,65 @@ static void CopyBytesToPipeline
 )
 //--------------------------------------------------------------------------------------------------
 {
-    char buffer[1024];
-
-    // Keep copying as much as we can until we've copied all the payload.
-    while (PayloadBytesCopied < PayloadSize)
+    for (;;)
     {
+        // Write what is left from the last read first.
+        while (CopyBufferOffset < CopyBufferBytes)
+        {
+            ssize_t writeResult = write(PipelineFd,
+                                        CopyBuffer + CopyBufferOffset,
+                                        CopyBufferBytes - CopyBufferOffset);
+
+            if (writeResult == -1)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+
+                if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+                {
+                    // Wait for the decompressor to make some room.
+                    le_fdMonitor_Disable(InputFdMonitor, POLLIN);
+                    le_fdMonitor_Enable(PipelineFdMonitor, POLLOUT);
+                    return;
+                }
+
+                LE_ERROR("Failed to write to output stream (%m)");
+                goto error;
+            }
+
+            CopyBufferOffset += writeResult;
+        }
+
+        // If we have copied all the payload bytes to the pipeline's input, then we can stop
+        // monitoring the input fd now, close the pipeline input write pipe, and let the
+        // decompressor and the extractor finish.
+        LE_ASSERT(PayloadBytesCopied <= PayloadSize);
+        if (PayloadBytesCopied == PayloadSize)
+        {
+            LE_INFO("Payload copied: %zu/%zu", PayloadBytesCopied, PayloadSize);
+
+            DeleteFdMonitor();
+            le_fdMonitor_Delete(PipelineFdMonitor);
+            PipelineFdMonitor = NULL;
+            fd_Close(PipelineFd);
+            PipelineFd = -1;
+            return;
+        }
+
         // Compute the number of bytes to read.
         size_t bytesToRead = PayloadSize - PayloadBytesCopied;
-        if (bytesToRead > sizeof(buffer))
+        if (bytesToRead > sizeof(CopyBuffer))
         {
-            bytesToRead = sizeof(buffer);
+            bytesToRead = sizeof(CopyBuffer);
         }
 
         // Read the bytes, retrying if interrupted by a signal.
         ssize_t readResult;
         do
         {
-            readResult = read(InputFd, buffer, bytesToRead);
+            readResult = read(InputFd, CopyBuffer, bytesToRead);
         }
         while ((readResult == -1) && (errno == EINTR));
 
@@ -507,11 +729,12 @@ static void CopyBytesToPipeline
         {
             // EWOULDBLOCK indicates that there are currently no more bytes available to be
             // read from the fd, but more will probably become available later.
-            if (errno == EWOULDBLOCK)
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
             {
-                // Break out of the loop and let the FD Monitor call us back when there's
-                // more to read.
-                break;
+                // Let the FD Monitor call us back when there's more to read.
+                le_fdMonitor_Disable(PipelineFdMonitor, POLLOUT);
+                le_fdMonitor_Enable(InputFdMonitor, POLLIN);
+                return;
             }
 
             LE_ERROR("Failed to read from input stream (%m).");
@@ -527,29 +750,8 @@ static void CopyBytesToPipeline
             goto error;
         }
 
-        // Write the bytes that we read.
-        ssize_t bytesWritten = 0;
-        ssize_t writeResult;
-        do
-        {
-            writeResult = write(PipelineFd, buffer + bytesWritten, readResult - bytesWritten);
-
-            // If some bytes were written, remember how many bytes, so we don't try to write the
-            // same bytes again if we have more to write.
-            if (writeResult > 0)
-            {
-                bytesWritten += writeResult;
-            }
-        }
-        while (   ((writeResult == -1) && (errno == EINTR)) // Retry if interrupted by a signal
-               || ((writeResult != -1) && (bytesWritten < readResult))  ); // Continue if not done
-
-        // Check for errors.
-        if (writeResult == -1)
-        {
-            LE_ERROR("Failed to write to output stream (%m)");
-            goto error;
-        }
+        CopyBufferBytes = readResult;
+        CopyBufferOffset = 0;
 
         // Update the static progress variables and report progress to the client.
         PayloadBytesCopied += readResult;
@@ -557,19 +759,6 @@ static void CopyBytesToPipeline
         ReportProgress();
     }
 
-    // If we have copied all the payload bytes to the pipeline's input, then we can stop
-    // monitoring the input fd now, close the pipeline input write pipe, and wait for the pipeline
-    // completion callback (UntarDone()).
-    LE_INFO("Payload copied: %zu/%zu", PayloadBytesCopied, PayloadSize);
-    LE_ASSERT(PayloadBytesCopied <= PayloadSize);
-    if (PayloadBytesCopied == PayloadSize)
-    {
-        DeleteFdMonitor();
-        fd_Close(PipelineFd);
-        PipelineFd = -1;
-    }
-    return;
-
 error:
 
     HandleInternalError();
@@ -689,32 +878,161 @@ static void InputFdEventHandler
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Function that runs in the unpack pipeline's "tar" process.
+ * Event handler for the pipeline's input fd, when waiting for the pipeline to have room for more.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PipelineFdEventHandler
+(
+    int fd,
+    short events
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (events & POLLOUT)
+    {
+        CopyBytesToPipeline();
+    }
+    else
+    {
+        LE_ERROR("Payload decompressor stopped reading its input.");
+        HandleInternalError();
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Event handler for the pipeline's output fd, which carries the decompressed tar stream.
+ */
+//--------------------------------------------------------------------------------------------------
+static void OutputFdEventHandler
+(
+    int fd,
+    short events
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // End of file and errors are reported by the extractor when it reads the fd.
+    switch (tarExtract_Process(fd))
+    {
+        case LE_WOULD_BLOCK:
+            break;
+
+        case LE_OK:
+            le_fdMonitor_Delete(OutputFdMonitor);
+            OutputFdMonitor = NULL;
+            fd_Close(OutputFd);
+            OutputFd = -1;
+
+            IsExtracted = true;
+
+            // The decompressor may not have been reaped yet.
+            if (IsDecompressed)
+            {
+                UnpackDone();
+            }
+            break;
+
+        case LE_FORMAT_ERROR:
+            LE_ERROR("Malformed update pack (bad payload)");
+            HandleFormatError();
+            break;
+
+        default:
+            HandleInternalError();
+            break;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A program that decompresses bzip2 data from its standard input to its standard output.
+ **/
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const char* path;       ///< Path of the program.
+    const char* option;     ///< Option that makes it decompress to its standard output.
+}
+Decompressor_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decompressors that can unpack the payloads, in order of preference.  The target must have one
+ * of them: the bzip2 program, or the bunzip2 applet of busybox.
+ **/
+//--------------------------------------------------------------------------------------------------
+static const Decompressor_t Decompressors[] =
+{
+    { "/usr/bin/bzip2", "-dc" },
+    { "/bin/bzip2", "-dc" },
+    { "/usr/bin/bunzip2", "-c" },
+    { "/bin/bunzip2", "-c" },
+};
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Find the decompressor to unpack payloads with.
+ *
+ * @return The decompressor, or NULL if the target has none.
+ **/
+//--------------------------------------------------------------------------------------------------
+static const Decompressor_t* FindDecompressor
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t i;
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(Decompressors); i++)
+    {
+        if (access(Decompressors[i].path, X_OK) == 0)
+        {
+            return &Decompressors[i];
+        }
+    }
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function that runs in the unpack pipeline's decompressor process.
  **/
 //--------------------------------------------------------------------------------------------------
-static int Untar
+static int Decompress
 (
-    void* param
+    void* param     ///< The decompressor to run.
 )
 //--------------------------------------------------------------------------------------------------
 {
-    const char* unpackDir = param;
+    const Decompressor_t* decompressorPtr = param;
 
     // Close all open file descriptors except for stdin, stdout, and stderr.
     // This ensures that we don't keep copies of things like the pipeline input write pipe open.
     fd_CloseAllNonStd();
 
-    // Try bsdtar first.  If that fails, fallback to tar.
-    execl("/usr/bin/bsdtar", "bsdtar", "xjmop", "-f", "-", "-C", unpackDir, (char*)NULL);
-    execl("/bin/tar", "tar", "xjop", "-C", unpackDir, (char*)NULL);
+    execl(decompressorPtr->path, decompressorPtr->path, decompressorPtr->option, (char*)NULL);
 
-    LE_FATAL("Failed to exec tar (%m)");
+    LE_FATAL("Failed to exec '%s' (%m)", decompressorPtr->path);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
  * Start unpacking a tarball.
+ *
+ * The payload is a bzip2 compressed tarball.  It is copied from the input stream into a
+ * decompressor process, and the decompressed tar stream is extracted by the Update Daemon itself
+ * as it arrives (see tarExtract.c).  All three steps are driven by FD Monitors.
+ *
+ * The decompressor is an external program (see Decompressors), so the update is failed with an
+ * internal error if the target has none.
  */
 //--------------------------------------------------------------------------------------------------
 static void StartUntar
@@ -723,20 +1041,49 @@ static void StartUntar
 )
 //--------------------------------------------------------------------------------------------------
 {
+    const Decompressor_t* decompressorPtr = FindDecompressor();
+
+    if (decompressorPtr == NULL)
+    {
+        LE_CRIT("Can't unpack the update: no bzip2 or busybox bunzip2 program found.");
+        HandleInternalError();
+        return;
+    }
+
     State = STATE_UNPACKING_PAYLOAD;
 
+    LE_ASSERT(le_utf8_Copy(UnpackDirPath, dirPath, sizeof(UnpackDirPath), NULL) == LE_OK);
+
     PayloadBytesCopied = 0;
+    CopyBufferBytes = 0;
+    CopyBufferOffset = 0;
+    IsExtracted = false;
+    IsDecompressed = false;
 
-    // Create a pipeline: PipelineFd -> tar
+    UnpackStartTime = le_clk_GetRelativeTime();
+    UnpackStartCpuMs = GetCpuMs(RUSAGE_SELF);
+    UnpackStartChildCpuMs = GetCpuMs(RUSAGE_CHILDREN);
+
+    // Create a pipeline: PipelineFd -> bzip2 -> OutputFd
     Pipeline = pipeline_Create();
     PipelineFd = pipeline_CreateInputPipe(Pipeline);
-    pipeline_Append(Pipeline, Untar, (void*)dirPath);
-    pipeline_Start(Pipeline, UntarDone);
+    OutputFd = pipeline_CreateOutputPipe(Pipeline);
+    pipeline_Append(Pipeline, Decompress, (void*)decompressorPtr);
+    pipeline_Start(Pipeline, DecompressDone);
+
+    tarExtract_Start(dirPath);
 
     fd_SetNonBlocking(InputFd);
+    fd_SetNonBlocking(PipelineFd);
+    fd_SetNonBlocking(OutputFd);
 
-    // Create FD Monitor for the Input FD.
+    // Create FD Monitors for the Input FD and both ends of the pipeline.  The pipeline's input is
+    // only monitored while it is full.
     InputFdMonitor = le_fdMonitor_Create("unpack", InputFd, InputFdEventHandler, POLLIN);
+    PipelineFdMonitor = le_fdMonitor_Create("unpackIn", PipelineFd, PipelineFdEventHandler,
+                                            POLLOUT);
+    le_fdMonitor_Disable(PipelineFdMonitor, POLLOUT);
+    OutputFdMonitor = le_fdMonitor_Create("untar", OutputFd, OutputFdEventHandler, POLLIN);
 }
 
 
@@ -850,7 +1197,7 @@ static void JsonDone
             system_PrepUnpackDir();
 
             // Unpack the system tarball.
-            // This is asynchronous and will call UntarDone() when finished.
+            // This is asynchronous and will call UnpackDone() when finished.
             StartUntar(system_UnpackPath);
         }
     }
@@ -877,6 +1224,15 @@ static void JsonDone
             LE_ERROR("Malformed update pack (app update payload missing)");
             HandleFormatError();
         }
+        // The base MD5 names a directory under /legato/apps, so it must be a hash and nothing else.
+        else if ((BaseMd5[0] != '\0') &&
+                 ((strlen(BaseMd5) != MD5_STRING_BYTES - 1) ||
+                  (strspn(BaseMd5, "0123456789abcdefABCDEF") != MD5_STRING_BYTES - 1)))
+        {
+            LE_ERROR("Malformed update pack (bad base MD5 hash '%s' in app update section)",
+                     BaseMd5);
+            HandleFormatError();
+        }
         else
         {
             if (Type == TYPE_UNKNOWN)
@@ -890,7 +1246,16 @@ static void JsonDone
                 system_RemoveUnusedApps();
             }
 
-            if (app_Exists(Md5) == false)
+            // A delta payload can only be applied if the version it was made against is installed.
+            // This is checked after the clean-up above, which may have removed that version.
+            if ((BaseMd5[0] != '\0') && (!app_Exists(Md5)) && (!app_Exists(BaseMd5)))
+            {
+                LE_ERROR("Update pack doesn't apply (delta for app '%s' needs version %s).",
+                         AppName,
+                         BaseMd5);
+                HandleFormatError();
+            }
+            else if (app_Exists(Md5) == false)
             {
                 LE_INFO("App with MD5 sum %s being unpacked.", Md5);
 
@@ -902,7 +1267,7 @@ static void JsonDone
                     // Prepare the directory to unpack into.
                     app_PrepUnpackDir();
                     // Unpack the app tarball.
-                    // This is asynchronous and will call UntarDone() when finished.
+                    // This is asynchronous and will call UnpackDone() when finished.
                     StartUntar(app_UnpackPath);
                 }
                 else
@@ -917,7 +1282,7 @@ static void JsonDone
                     LE_FATAL_IF(LE_OK != le_dir_MakePath(unpackPath, S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH),
                                 "Failed to create directory '%s'.",
                                 unpackPath);
-                    // Untar the app tarball. Will call UntarDone() when finished.
+                    // Untar the app tarball. Will call UnpackDone() when finished.
                     StartUntar(unpackPath);
                 }
 
@@ -1073,6 +1438,21 @@ static void Md5EventHandler
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * "base" member parsing event function.
+ */
+//--------------------------------------------------------------------------------------------------
+static void BaseEventHandler
+(
+    le_json_Event_t event
+)
+//--------------------------------------------------------------------------------------------------
+{
+    StringMemberEventHandler(event, BaseMd5, sizeof(BaseMd5), "base MD5 hash");
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * "version" member parsing event function.
@@ -1188,6 +1568,10 @@ static void JsonEventHandler
             {
                 le_json_SetEventHandler(NameEventHandler);
             }
+            else if (strcmp(memberName, "base") == 0)
+            {
+                le_json_SetEventHandler(BaseEventHandler);
+            }
             else if (strcmp(memberName, "version") == 0)
             {
                 le_json_SetEventHandler(VersionEventHandler);
@@ -95,6 +95,18 @@
  * the threshold value is increased until a point at which all allowable watchdog resources have
  * been allocated at which point no more will be be created.
  *
+ * Heartbeats
+ *
+ * A process that kicks often can call le_wdog_OpenHeartbeat() to get a small shared memory region
+ * holding a heartbeat counter, and then kick by storing a new counter value instead of sending a
+ * kick message.  Watchdogs kicked this way do not use their timer.  Instead, a single repeating
+ * timer (running every LE_CONFIG_WDOG_HEARTBEAT_SCAN_INTERVAL milliseconds while there are
+ * heartbeat watchdogs) scans all the heartbeat counters: a counter that changed since the last scan
+ * counts as a kick and moves the watchdog's deadline, and a watchdog whose deadline has passed
+ * expires exactly as if its timer had expired.  Expiries are therefore detected up to one scan
+ * interval late.  le_wdog_Kick() and le_wdog_Timeout() still work for these processes, and set the
+ * deadline instead of the timer.
+ *
  * @note Critical systems rely on the watchdog daemon to ensure system liveness, so all
  * unrecoverable errors in the watchdogDaemon are considered fatal to the system, and will
  * cause a system reboot by calling LE_FATAL or LE_ASSERT.
@@ -106,8 +118,15 @@
 #include "limit.h"
 #include "interfaces.h"
 #include "user.h"
+#include "smack.h"
 #include "fileDescriptor.h"
 #include "pa_wdog.h"
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#ifndef MFD_CLOEXEC
+#   define MFD_CLOEXEC 0x0001U
+#endif
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -210,6 +229,13 @@
 //--------------------------------------------------------------------------------------------------
 #define SYSTEM_FRAMEWORK_CFG "/framework"
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the shared memory region holding a process' heartbeat counter.
+ */
+//--------------------------------------------------------------------------------------------------
+#define HEARTBEAT_BYTES sizeof(uint32_t)
+
 /// Macro used to generate trace output in this module.
 /// Takes the same parameters as LE_DEBUG() et. al.
 #define TRACE(...) LE_TRACE(TraceRef, ##__VA_ARGS__)
@@ -240,6 +266,13 @@ typedef struct
                                         ///< beyond it's maximum period by being treated as a
                                         ///< non-mandatory watchdog.
     le_timer_Ref_t timer;               ///< The timer this watchdog uses
+    uint32_t* heartbeatPtr;             ///< Heartbeat counter shared with the process, or NULL if
+                                        ///< the process only kicks through IPC.  When set, the
+                                        ///< timer is not used.
+    uint32_t lastHeartbeat;             ///< Heartbeat counter value seen by the last scan
+    le_clk_Time_t deadline;             ///< Relative time the heartbeat watchdog expires at
+    bool neverExpires;                  ///< true if the heartbeat watchdog is suspended
+    le_dls_Link_t heartbeatLink;        ///< Link in the list of heartbeat watchdogs
 }
 WatchdogObj_t;
 
@@ -287,6 +320,31 @@ static le_hashmap_Ref_t MandatoryWatchdogRefs;  ///< The container used to track
 
 static le_timer_Ref_t DefaultExternalWdogTimer; ///< Default external wdog timer
 
+static le_dls_List_t HeartbeatList = LE_DLS_LIST_INIT; ///< Watchdogs kicked through heartbeats
+static le_timer_Ref_t HeartbeatScanTimer;       ///< Timer that checks all heartbeat deadlines
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stop watching a process' heartbeat counter.  The watchdog goes back to using its timer, which is
+ * left stopped.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DetachHeartbeat
+(
+    WatchdogObj_t* dogPtr   ///< The watchdog using a heartbeat
+)
+{
+    le_dls_Remove(&HeartbeatList, &dogPtr->heartbeatLink);
+    LE_CRIT_IF(munmap(dogPtr->heartbeatPtr, HEARTBEAT_BYTES) != 0,
+               "Failed to unmap heartbeat of proc %d (%m)", dogPtr->procId);
+    dogPtr->heartbeatPtr = NULL;
+
+    if (le_dls_IsEmpty(&HeartbeatList))
+    {
+        le_timer_Stop(HeartbeatScanTimer);
+    }
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Remove the watchdog from our container, free the timer it contains and then free the storage
@@ -303,6 +361,12 @@ static void DeleteWatchdog
     {
         // All good. The dog was in the hash
         LE_DEBUG("Cleaning up watchdog resources for %d", deadDogPtr->procId);
+        if (deadDogPtr->heartbeatPtr != NULL)
+        {
+            DetachHeartbeat(deadDogPtr);
+            LE_ASSERT(LE_OK == le_timer_SetInterval(deadDogPtr->timer,
+                                                    deadDogPtr->kickTimeoutInterval));
+        }
         // Give the watchdog one more kick if it hasn't had one, then release it.
         // This allows mandatory watchdogs (which still exist in the MandatoryWatchdogRefs
         // one more kick to restart before they're considered expired.
@@ -466,19 +530,19 @@ static le_result_t GetAppNameFromPid
 
 //--------------------------------------------------------------------------------------------------
 /**
- * The handler for all time outs. No registered application wants to see us get here.
+ * Handle the expiry of a watchdog, whether its timer expired or its heartbeat deadline passed.
+ * No registered application wants to see us get here.
  * Arrival here means that some process has failed to service its watchdog and therefore,
  * we need to tattle to the supervisor who, if the app still exists, will deal with it
  * in the manner proscribed in the book of config.
  *
  */
 //--------------------------------------------------------------------------------------------------
-static void WatchdogHandleExpiry
+static void ExpireWatchdog
 (
-    le_timer_Ref_t timerRef ///< [IN] The reference to the expired timer
+    WatchdogObj_t* watchDogPtr ///< [IN] The expired watchdog
 )
 {
-    WatchdogObj_t* watchDogPtr = le_timer_GetContextPtr(timerRef);
     if (watchDogPtr->procId == NO_PROC)
     {
         // Mandatory watchdog expired without the process restarting.  Restart Legato.
@@ -525,6 +589,19 @@ static void WatchdogHandleExpiry
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * The handler for all watchdog timer time outs.
+ */
+//--------------------------------------------------------------------------------------------------
+static void WatchdogHandleExpiry
+(
+    le_timer_Ref_t timerRef ///< [IN] The reference to the expired timer
+)
+{
+    ExpireWatchdog(le_timer_GetContextPtr(timerRef));
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Construct le_clk_Time_t object that will give an interval of the provided number
@@ -546,6 +623,58 @@ static le_clk_Time_t MakeTimerInterval
     return interval;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set when a heartbeat watchdog expires.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SetHeartbeatDeadline
+(
+    WatchdogObj_t* dogPtr,      ///< [IN] The watchdog using a heartbeat
+    le_clk_Time_t now,          ///< [IN] Current relative time
+    le_clk_Time_t timeout       ///< [IN] Time left before the watchdog expires
+)
+{
+    dogPtr->neverExpires = le_clk_Equal(timeout, MakeTimerInterval(LE_WDOG_TIMEOUT_NEVER));
+    dogPtr->deadline = le_clk_Add(now, timeout);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The handler for the heartbeat scan timer.
+ *
+ * A heartbeat counter that changed since the last scan is a kick.  Otherwise the watchdog expires
+ * if its deadline has passed.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ScanHeartbeats
+(
+    le_timer_Ref_t timerRef ///< [IN] The heartbeat scan timer
+)
+{
+    le_clk_Time_t now = le_clk_GetRelativeTime();
+    le_dls_Link_t* linkPtr = le_dls_Peek(&HeartbeatList);
+
+    while (linkPtr != NULL)
+    {
+        WatchdogObj_t* dogPtr = CONTAINER_OF(linkPtr, WatchdogObj_t, heartbeatLink);
+
+        // Move on before the watchdog is possibly expired and removed from the list.
+        linkPtr = le_dls_PeekNext(&HeartbeatList, linkPtr);
+
+        uint32_t heartbeat = __atomic_load_n(dogPtr->heartbeatPtr, __ATOMIC_RELAXED);
+        if (heartbeat != dogPtr->lastHeartbeat)
+        {
+            dogPtr->lastHeartbeat = heartbeat;
+            SetHeartbeatDeadline(dogPtr, now, dogPtr->kickTimeoutInterval);
+        }
+        else if (!dogPtr->neverExpires && !le_clk_GreaterThan(dogPtr->deadline, now))
+        {
+            ExpireWatchdog(dogPtr);
+        }
+    }
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Check a regular watchdog is running.
@@ -561,9 +690,11 @@ bool CheckWatchdog
     bool* kickPtr = contextPtr;
     const WatchdogObj_t* dogPtr = valuePtr;
 
-    // If watchdog is operating correctly...
+    // If watchdog is operating correctly...  Heartbeat watchdogs are always running until they
+    // expire.
     if (   (dogPtr->timer) &&
            (le_clk_Equal(dogPtr->maxKickTimeoutInterval, MakeTimerInterval(LE_WDOG_TIMEOUT_NEVER)) ||
+            (dogPtr->heartbeatPtr != NULL) ||
             le_timer_IsRunning(dogPtr->timer)))
     {
         // ...  continue to next watchdog
@@ -623,7 +754,8 @@ static void ExternalWatchdogHandler
         le_hashmap_ForEach(MandatoryWatchdogRefs,
                            CheckMandatoryWatchdog,
                            &kick) &&
-        kick)
+        kick &&
+        (le_dls_IsEmpty(&HeartbeatList) || le_timer_IsRunning(HeartbeatScanTimer)))
     {
         // Kick the external watchdog
         LE_DEBUG("Kick external watchdog");
@@ -825,6 +957,8 @@ static void InitNewWatchdog
     newDogPtr->procId = clientPid;
     newDogPtr->kickTimeoutInterval = kickTimeoutInterval;
     newDogPtr->maxKickTimeoutInterval = maxKickTimeoutInterval;
+    newDogPtr->heartbeatPtr = NULL;
+    newDogPtr->heartbeatLink = LE_DLS_LINK_INIT;
 
     if (le_clk_GreaterThan(newDogPtr->kickTimeoutInterval, newDogPtr->maxKickTimeoutInterval))
     {
@@ -1059,7 +1193,15 @@ static void ResetClientWatchdog
             }
         }
 
-        if (!le_clk_Equal(timeoutValue, MakeTimerInterval(LE_WDOG_TIMEOUT_NEVER)))
+        if (watchDogPtr->heartbeatPtr != NULL)
+        {
+            // Heartbeats seen so far are older than this kick, so do not let the next scan count
+            // them again and override a new timeout.
+            watchDogPtr->lastHeartbeat = __atomic_load_n(watchDogPtr->heartbeatPtr,
+                                                         __ATOMIC_RELAXED);
+            SetHeartbeatDeadline(watchDogPtr, le_clk_GetRelativeTime(), timeoutValue);
+        }
+        else if (!le_clk_Equal(timeoutValue, MakeTimerInterval(LE_WDOG_TIMEOUT_NEVER)))
         {
             // timer should be stopped here so this should never fail
             LE_ASSERT(LE_OK == le_timer_SetInterval(watchDogPtr->timer, timeoutValue));
@@ -1133,6 +1275,144 @@ void le_wdog_Kick
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create the shared memory file holding a process' heartbeat counter, and label it so the process
+ * can receive and map it.
+ *
+ * @return The file descriptor, or -1 on failure.
+ */
+//--------------------------------------------------------------------------------------------------
+static int CreateHeartbeatFile
+(
+    pid_t procId    ///< [IN] The process the heartbeat is for
+)
+{
+#ifdef SYS_memfd_create
+    int fd = syscall(SYS_memfd_create, "wdogHeartbeat", MFD_CLOEXEC);
+#else
+    int fd = -1;
+    errno = ENOSYS;
+#endif
+    if (fd < 0)
+    {
+        LE_WARN("Cannot create heartbeat for proc %d (%m).", procId);
+        return -1;
+    }
+
+    if (ftruncate(fd, HEARTBEAT_BYTES) != 0)
+    {
+        LE_ERROR("Cannot size heartbeat for proc %d (%m).", procId);
+        fd_Close(fd);
+        return -1;
+    }
+
+    if (smack_IsEnabled())
+    {
+        char label[LIMIT_MAX_SMACK_LABEL_BYTES];
+        char path[LIMIT_MAX_PATH_BYTES];
+
+        LE_ASSERT(snprintf(path, sizeof(path), "/proc/self/fd/%d", fd) < sizeof(path));
+        if (   (LE_OK != smack_GetProcLabel(procId, label, sizeof(label)))
+            || (LE_OK != smack_SetLabel(path, label)))
+        {
+            LE_ERROR("Cannot label heartbeat for proc %d.", procId);
+            fd_Close(fd);
+            return -1;
+        }
+    }
+
+    return fd;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get a heartbeat counter shared with the watchdog daemon, so the watchdog can be kicked without
+ * IPC by storing a new value into it.
+ *
+ * The watchdog keeps running (or stopped) with the time it had left, as opening the heartbeat is
+ * not a kick.
+ *
+ * @return
+ *      - LE_OK            The heartbeat file descriptor is returned
+ *      - LE_DUPLICATE     The process already has a heartbeat
+ *      - LE_UNAVAILABLE   Heartbeats are not available, the process must use le_wdog_Kick()
+ *      - LE_FAULT         The client could not be identified
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_wdog_OpenHeartbeat
+(
+    int* fdPtr
+        ///< [OUT] File descriptor of the heartbeat counter
+)
+{
+    if (fdPtr == NULL)
+    {
+        LE_KILL_CLIENT("fdPtr is NULL.");
+        return LE_FAULT;
+    }
+    *fdPtr = -1;
+
+    WatchdogObj_t* watchDogPtr = GetClientWatchdogPtr();
+    if (watchDogPtr == NULL)
+    {
+        return LE_FAULT;
+    }
+
+    if (watchDogPtr->heartbeatPtr != NULL)
+    {
+        return LE_DUPLICATE;
+    }
+
+    int fd = CreateHeartbeatFile(watchDogPtr->procId);
+    if (fd < 0)
+    {
+        return LE_UNAVAILABLE;
+    }
+
+    uint32_t* heartbeatPtr = mmap(NULL, HEARTBEAT_BYTES, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (heartbeatPtr == MAP_FAILED)
+    {
+        LE_ERROR("Cannot map heartbeat for proc %d (%m).", watchDogPtr->procId);
+        fd_Close(fd);
+        return LE_UNAVAILABLE;
+    }
+
+    // Carry the time left on the watchdog timer over to the heartbeat deadline.  Mandatory
+    // watchdogs must always be running.
+    le_clk_Time_t now = le_clk_GetRelativeTime();
+    if (le_timer_IsRunning(watchDogPtr->timer))
+    {
+        SetHeartbeatDeadline(watchDogPtr, now, le_timer_GetTimeRemaining(watchDogPtr->timer));
+        le_timer_Stop(watchDogPtr->timer);
+    }
+    else if (!le_clk_Equal(watchDogPtr->maxKickTimeoutInterval,
+                           MakeTimerInterval(LE_WDOG_TIMEOUT_NEVER)))
+    {
+        SetHeartbeatDeadline(watchDogPtr, now, watchDogPtr->kickTimeoutInterval);
+    }
+    else
+    {
+        watchDogPtr->neverExpires = true;
+    }
+
+    watchDogPtr->heartbeatPtr = heartbeatPtr;
+    watchDogPtr->lastHeartbeat = 0;
+    le_dls_Queue(&HeartbeatList, &watchDogPtr->heartbeatLink);
+    if (!le_timer_IsRunning(HeartbeatScanTimer))
+    {
+        le_timer_Start(HeartbeatScanTimer);
+    }
+
+    LE_DEBUG("Proc %d kicks through a heartbeat", watchDogPtr->procId);
+
+    // The IPC closes our copy of the file descriptor once it is sent.
+    *fdPtr = fd;
+    return LE_OK;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Get the watchdog timeout configured for this process
@@ -1528,5 +1808,12 @@ COMPONENT_INIT
     le_timer_Start(DefaultExternalWdogTimer);
     pa_wdog_Init();
 
+    // Heartbeat deadlines are checked by one timer, which only runs while there are heartbeats.
+    HeartbeatScanTimer = le_timer_Create("HeartbeatScanTimer");
+    le_timer_SetMsInterval(HeartbeatScanTimer, LE_CONFIG_WDOG_HEARTBEAT_SCAN_INTERVAL);
+    le_timer_SetHandler(HeartbeatScanTimer, ScanHeartbeats);
+    le_timer_SetRepeat(HeartbeatScanTimer, 0);
+    le_timer_SetWakeup(HeartbeatScanTimer, false);
+
     LE_INFO("The watchdog service is ready");
 }
@@ -39,6 +39,9 @@ static void ServerMsgRecvHandler(le_msg_MessageRef_t, void*);
 static le_result_t DoConnectService(const char*, const uint32_t, const char*);
 static void ProcessServerResponse(rpcProxy_Message_t*, bool);
 static le_result_t RepackMessage(rpcProxy_Message_t*, rpcProxy_Message_t*, bool);
+static bool RepackIsInPlace(rpcProxy_Message_t*, bool, uint16_t*, bool*);
+static void RepackInPlace(rpcProxy_Message_t*, bool);
+static void RepackUpdateStats(bool, uint16_t, le_clk_Time_t);
 static le_result_t PreProcessResponse(void*, size_t*);
 #ifndef RPC_PROXY_LOCAL_SERVICE
 static void SendDisconnectService(const char* systemName,
@@ -121,6 +124,25 @@ responseParameterArray_t;
 #endif
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Repack statistics.  Used to measure how much of the Proxy Message traffic has to be copied
+ * into a temporary buffer by RepackMessage(), versus how much is forwarded in-place.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t      inPlaceCount;   ///< Number of messages repacked in-place
+    uint64_t      inPlaceBytes;   ///< Number of payload bytes forwarded without a copy
+    uint32_t      copyCount;      ///< Number of messages repacked by copy
+    uint64_t      copyBytes;      ///< Number of payload bytes copied while repacking
+    le_clk_Time_t repackTime;     ///< Cumulative time spent repacking messages
+}
+RepackStats_t;
+
+static RepackStats_t RepackStats;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Global Message ID to uniquely identify each RPC Proxy Message.
@@ -679,8 +701,11 @@ le_result_t rpcProxy_SendMsg
     le_result_t         result;
     size_t              byteCount;
     rpcProxy_Message_t  tmpProxyMessage;
-    rpcProxy_Message_t *proxyMessagePtr;
+    rpcProxy_Message_t *proxyMessagePtr = NULL;
     void               *sendMessagePtr;
+    bool                inPlace = false;
+    uint16_t            inPlaceMsgSize = 0;
+    uint16_t            origMsgSize = 0;
 
     // Retrieve the Network Record for this system
     NetworkRecord_t* networkRecordPtr =
@@ -761,12 +786,40 @@ le_result_t rpcProxy_SendMsg
             print_hex(proxyMessagePtr->message, proxyMessagePtr->msgSize);
 #endif
 
+            le_clk_Time_t startTime = le_clk_GetRelativeTime();
+
+            bool rollUp;
+
+            if (RepackIsInPlace(proxyMessagePtr, true, &inPlaceMsgSize, &rollUp))
+            {
+                // Nothing in the payload needs to be re-laid out, so send the original
+                // Proxy Message rather than copying it into tmpProxyMessage
+                RepackInPlace(proxyMessagePtr, true);
+                RepackUpdateStats(true, inPlaceMsgSize, startTime);
+
+                byteCount = RPC_PROXY_MSG_HEADER_SIZE + inPlaceMsgSize;
+
+                // Prepare the Proxy Message Common Header
+                commonHeaderPtr->id = htobe32(commonHeaderPtr->id);
+                commonHeaderPtr->serviceId = htobe32(commonHeaderPtr->serviceId);
+
+                // Put msgSize into Network-Order before sending, keeping the original to be
+                // restored once the message has been sent
+                origMsgSize = proxyMessagePtr->msgSize;
+                proxyMessagePtr->msgSize = htobe16(inPlaceMsgSize);
+
+                inPlace = true;
+                sendMessagePtr = proxyMessagePtr;
+                break;
+            }
+
             // Re-package proxy message before sending
             result = RepackMessage(proxyMessagePtr, &tmpProxyMessage, true);
             if (result != LE_OK)
             {
                 return result;
             }
+            RepackUpdateStats(false, tmpProxyMessage.msgSize, startTime);
 
 #if RPC_PROXY_HEX_DUMP
             print_hex(tmpProxyMessage.message, tmpProxyMessage.msgSize);
@@ -825,6 +878,13 @@ le_result_t rpcProxy_SendMsg
     commonHeaderPtr->id = be32toh(commonHeaderPtr->id);
     commonHeaderPtr->serviceId = be32toh(commonHeaderPtr->serviceId);
 
+    if (inPlace)
+    {
+        // Restore the original Proxy Message, as it may still be referenced by the caller
+        proxyMessagePtr->msgSize = origMsgSize;
+        RepackInPlace(proxyMessagePtr, false);
+    }
+
     return result;
 }
 
@@ -1030,8 +1090,9 @@ static inline void RepackCopyContents
     // Calculate the number of bytes to be copied
     uint16_t byteCount = (*msgBufPtr - *previousMsgBufPtr);
 
-    // Copy the contents before further processing
-    memcpy(*newMsgBufPtr, *previousMsgBufPtr, byteCount);
+    // Copy the contents before further processing; both buffers are the same when the message
+    // is repacked in-place
+    memmove(*newMsgBufPtr, *previousMsgBufPtr, byteCount);
     *newMsgBufPtr += byteCount;
     *previousMsgBufPtr = *msgBufPtr;
 }
@@ -1479,12 +1540,285 @@ static le_result_t RepackOptimizedData
 #endif
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function for checking whether a Proxy Message can be repacked in-place.
+ *
+ * Walks the message payload using the Tag IDs without copying anything.  If none of the
+ * parameters need their layout changed (i.e., there is no local-service string or array data
+ * to roll-up or un-roll), only the Msg ID needs its byte-order converted and the original
+ * buffer can be used as-is, avoiding the copy into (and out of) a temporary Proxy Message.
+ *
+ * Local-service string and array data received from the wire are rolled-up by RepackMessage()
+ * directly in the receive buffer, as long as no rolled-up parameter is larger than the original
+ * one: the data of a server response is moved into the response buffers, and the data of a
+ * client request is replaced by a pointer to its copy.  Outgoing messages are always repacked
+ * into a temporary Proxy Message, as the caller's message must be left intact.
+ *
+ * @return
+ *      - true if the message can be repacked in-place; msgSizePtr is set to the size of the
+ *        payload actually used, and rollUpPtr tells whether RepackMessage() must be called on
+ *        the message buffer itself.
+ *      - false if RepackMessage() must be used with a temporary Proxy Message.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool RepackIsInPlace
+(
+    rpcProxy_Message_t *proxyMessagePtr, ///< [IN] Pointer to the Proxy Message
+    bool sending, ///< [IN] Boolean to identify if message is in-coming or out-going
+    uint16_t* msgSizePtr, ///< [OUT] Size of the used message payload
+    bool* rollUpPtr ///< [OUT] Whether string or array data must be rolled-up in-place
+)
+{
+    uint8_t* msgBufPtr = &proxyMessagePtr->message[0];
+    bool done = false;
+
+    *rollUpPtr = false;
+
+    if (proxyMessagePtr->msgSize == 0)
+    {
+        // Empty message payload - nothing to repack
+        *msgSizePtr = 0;
+        return true;
+    }
+
+    if (proxyMessagePtr->msgSize < LE_PACK_SIZEOF_UINT32)
+    {
+        // Let RepackMessage() deal with malformed messages
+        return false;
+    }
+
+    // Skip over the Msg ID (uint32_t)
+    msgBufPtr = msgBufPtr + LE_PACK_SIZEOF_UINT32;
+
+    // Traverse through the Message buffer, using the Tag IDs as a reference
+    while (((msgBufPtr - &proxyMessagePtr->message[0]) < proxyMessagePtr->msgSize) && !done)
+    {
+        TagID_t tagId = *msgBufPtr;
+
+        switch(tagId)
+        {
+            // Fixed-length Types
+            case LE_PACK_UINT8:
+            case LE_PACK_INT8:
+            case LE_PACK_BOOL:
+            case LE_PACK_CHAR:
+            case LE_PACK_UINT16:
+            case LE_PACK_INT16:
+            case LE_PACK_RESULT:
+            case LE_PACK_ONOFF:
+            case LE_PACK_UINT32:
+            case LE_PACK_INT32:
+            case LE_PACK_REFERENCE:
+            case LE_PACK_SIZE:
+            case LE_PACK_UINT64:
+            case LE_PACK_INT64:
+            case LE_PACK_DOUBLE:
+            {
+                msgBufPtr += (LE_PACK_SIZEOF_TAG_ID + ItemPackSize[tagId]);
+                break;
+            }
+
+#ifndef RPC_PROXY_LOCAL_SERVICE
+            case LE_PACK_STRING_RESPONSE_SIZE:
+            case LE_PACK_ARRAY_RESPONSE_SIZE:
+            {
+                if (sending)
+                {
+                    return false;
+                }
+
+                msgBufPtr += (LE_PACK_SIZEOF_TAG_ID + ItemPackSize[tagId]);
+                break;
+            }
+
+            // Variable-length Type, bundled with a size
+            case LE_PACK_STRING:
+            {
+                uint32_t value = 0;
+
+                LE_ASSERT(le_pack_UnpackUint32(&msgBufPtr, &value));
+
+                if (((msgBufPtr + value) - &proxyMessagePtr->message[0]) >=
+                          RPC_PROXY_MAX_MESSAGE)
+                {
+                    // Let RepackMessage() report the format error
+                    return false;
+                }
+
+                msgBufPtr = msgBufPtr + value;
+                break;
+            }
+
+            // Variable-length Type, bundled with a size
+            case LE_PACK_ARRAYHEADER:
+            {
+                size_t value;
+
+                LE_ASSERT(le_pack_UnpackSize(&msgBufPtr, &value));
+
+                if (((msgBufPtr + value) - &proxyMessagePtr->message[0]) >=
+                          RPC_PROXY_MAX_MESSAGE)
+                {
+                    // Let RepackMessage() report the format error
+                    return false;
+                }
+
+                msgBufPtr = msgBufPtr + value;
+                break;
+            }
+#else
+            // Variable-length Types, bundled with a size, rolled-up when received
+            case LE_PACK_STRING:
+            case LE_PACK_ARRAYHEADER:
+            {
+                uint32_t value = 0;
+
+                if (sending)
+                {
+                    return false;
+                }
+
+                LE_ASSERT(le_pack_UnpackUint32(&msgBufPtr, &value));
+
+                if (((msgBufPtr + value) - &proxyMessagePtr->message[0]) >=
+                          RPC_PROXY_MAX_MESSAGE)
+                {
+                    // Let RepackMessage() report the format error
+                    return false;
+                }
+
+                if ((proxyMessagePtr->commonHeader.type != RPC_PROXY_SERVER_RESPONSE) &&
+                    (value < sizeof(uintptr_t)))
+                {
+                    // The pointer replacing the data is larger than the data
+                    return false;
+                }
+
+                msgBufPtr = msgBufPtr + value;
+                *rollUpPtr = true;
+                break;
+            }
+
+            // Response buffers are allocated, and pointers are un-rolled, by RepackMessage()
+            case LE_PACK_STRING_RESPONSE_SIZE:
+            case LE_PACK_ARRAY_RESPONSE_SIZE:
+            case LE_PACK_IN_STRING_POINTER:
+            case LE_PACK_OUT_STRING_POINTER:
+            case LE_PACK_IN_ARRAY_POINTER:
+            case LE_PACK_OUT_ARRAY_POINTER:
+            {
+                return false;
+            }
+#endif
+
+            default:
+                done = true;
+                break;
+        }
+    }
+
+#ifdef RPC_PROXY_LOCAL_SERVICE
+    if (sending && (proxyMessagePtr->commonHeader.type == RPC_PROXY_SERVER_RESPONSE))
+    {
+        // "Out" parameter response buffers are appended to the message by RepackMessage()
+        le_dls_Link_t* linkPtr = le_dls_Peek(&LocalMessageList);
+
+        while (linkPtr != NULL)
+        {
+            rpcProxy_LocalMessage_t* localMessagePtr =
+                CONTAINER_OF(linkPtr, rpcProxy_LocalMessage_t, link);
+
+            if (localMessagePtr->id == proxyMessagePtr->commonHeader.id)
+            {
+                return false;
+            }
+
+            linkPtr = le_dls_PeekNext(&LocalMessageList, linkPtr);
+        }
+    }
+#endif
+
+    *msgSizePtr = (msgBufPtr - &proxyMessagePtr->message[0]);
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function for repacking a Proxy Message in-place.  Converts the byte-order of the Msg ID only,
+ * and must only be called for messages which RepackIsInPlace() has accepted.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RepackInPlace
+(
+    rpcProxy_Message_t *proxyMessagePtr, ///< [IN] Pointer to the Proxy Message
+    bool sending ///< [IN] Boolean to identify if message is in-coming or out-going
+)
+{
+    uint32_t id;
+
+    if (proxyMessagePtr->msgSize < LE_PACK_SIZEOF_UINT32)
+    {
+        return;
+    }
+
+    memcpy((uint8_t*) &id, &proxyMessagePtr->message[0], LE_PACK_SIZEOF_UINT32);
+    id = sending ? htobe32(id) : be32toh(id);
+    memcpy(&proxyMessagePtr->message[0], (uint8_t*) &id, LE_PACK_SIZEOF_UINT32);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function for updating the repack statistics.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RepackUpdateStats
+(
+    bool inPlace, ///< [IN] Whether the message was repacked in-place
+    uint16_t msgSize, ///< [IN] Size of the repacked message payload
+    le_clk_Time_t startTime ///< [IN] Time at which the repack started
+)
+{
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+
+    if (inPlace)
+    {
+        RepackStats.inPlaceCount++;
+        RepackStats.inPlaceBytes += msgSize;
+    }
+    else
+    {
+        RepackStats.copyCount++;
+        RepackStats.copyBytes += msgSize;
+    }
+    RepackStats.repackTime = le_clk_Add(RepackStats.repackTime, elapsed);
+
+    LE_DEBUG("Repacked %s message, size [%u], time [%ld us]; "
+             "in-place [%" PRIu32 " msgs, %" PRIu64 " bytes], "
+             "copied [%" PRIu32 " msgs, %" PRIu64 " bytes], total time [%ld.%06ld s]",
+             inPlace ? "in-place" : "copied",
+             msgSize,
+             (long) (elapsed.sec * 1000000 + elapsed.usec),
+             RepackStats.inPlaceCount,
+             RepackStats.inPlaceBytes,
+             RepackStats.copyCount,
+             RepackStats.copyBytes,
+             (long) RepackStats.repackTime.sec,
+             (long) RepackStats.repackTime.usec);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Function for preparing Proxy Messages either being sent to or received from the far side
  *
  * It handles local-session string and array optimizations, endianness, and
  * 32-bit/64-bit architectural differences.  Uses the Tag ID to achieve this.
+ *
+ * The new Proxy Message may be the original one for received messages which RepackIsInPlace()
+ * has accepted, the repacked payload being written over the payload already processed.
  */
 //--------------------------------------------------------------------------------------------------
 static le_result_t RepackMessage
@@ -1499,6 +1833,7 @@ static le_result_t RepackMessage
     uint8_t* newMsgBufPtr;
     uint32_t id;
     uint16_t count = 0;
+    uint16_t msgSize = proxyMessagePtr->msgSize;
     bool done = false;
 #ifdef RPC_PROXY_LOCAL_SERVICE
     uint8_t  slotIndex = 0;
@@ -1508,7 +1843,7 @@ static le_result_t RepackMessage
     newProxyMessagePtr->msgSize = 0;
 
     // Verify Message Size
-    if (proxyMessagePtr->msgSize == 0)
+    if (msgSize == 0)
     {
         // Empty message payload - no need to proceed with repack
         return LE_OK;
@@ -1541,12 +1876,12 @@ static le_result_t RepackMessage
     newMsgBufPtr = newMsgBufPtr + LE_PACK_SIZEOF_UINT32;
 
     // Traverse through the Message buffer, using the Tag IDs as a reference
-    while (((msgBufPtr - &proxyMessagePtr->message[0]) < proxyMessagePtr->msgSize) && !done)
+    while (((msgBufPtr - &proxyMessagePtr->message[0]) < msgSize) && !done)
     {
         TagID_t tagId = *msgBufPtr;
 
         LE_DEBUG("Proxy Message size [%" PRIu16 "], index [%" PRIu32 "], tagId [%d]",
-                 proxyMessagePtr->msgSize,
+                 msgSize,
                  (uint32_t)(msgBufPtr - &proxyMessagePtr->message[0]),
                  tagId);
 
@@ -1784,7 +2119,7 @@ static le_result_t RepackMessage
     LE_DEBUG("Re-packing Proxy Message, proxy id [%" PRIu32 "], "
              "previous msgSize [%u], new msgSize [%u]",
              proxyMessagePtr->commonHeader.id,
-             proxyMessagePtr->msgSize,
+             msgSize,
              count);
 
     newProxyMessagePtr->msgSize = count;
@@ -1884,12 +2219,39 @@ static le_result_t PreProcessResponse
             print_hex(proxyMessagePtr->message, proxyMessagePtr->msgSize);
 #endif
 
+            le_clk_Time_t startTime = le_clk_GetRelativeTime();
+            uint16_t inPlaceMsgSize;
+            bool rollUp;
+
+            if (RepackIsInPlace(proxyMessagePtr, false, &inPlaceMsgSize, &rollUp))
+            {
+                // Process the message directly out of the receive buffer
+                if (rollUp)
+                {
+                    // Roll-up the string and array data within the receive buffer
+                    result = RepackMessage(proxyMessagePtr, proxyMessagePtr, false);
+                    if (result != LE_OK)
+                    {
+                        return result;
+                    }
+                    inPlaceMsgSize = proxyMessagePtr->msgSize;
+                }
+                else
+                {
+                    RepackInPlace(proxyMessagePtr, false);
+                    proxyMessagePtr->msgSize = inPlaceMsgSize;
+                }
+                RepackUpdateStats(true, inPlaceMsgSize, startTime);
+                break;
+            }
+
             // Re-package proxy message before processing
             result = RepackMessage(proxyMessagePtr, &tmpProxyMessage, false);
             if (result != LE_OK)
             {
                 return result;
             }
+            RepackUpdateStats(false, tmpProxyMessage.msgSize, startTime);
 
             //
             // Step 3. Prepare the Proxy Common Message Header of the tmpProxyMessage
@@ -145,6 +145,15 @@
  * The le_atomFile_Create() function can be used to create, lock and open a file in one function
  * call.
  *
+ * @section c_atomFile_performance Performance
+ *
+ * Opening an existing file for writing makes a copy of it, which changes are made to until the file
+ * is closed.  On file systems that support it, the copy shares the original file's data blocks
+ * until they are written to, otherwise the whole file is copied.  When the whole file is going to
+ * be rewritten, use le_atomFile_Create() or le_atomFile_CreateStream() with
+ * @c LE_FLOCK_REPLACE_IF_EXIST instead: nothing is copied, and closing the file just renames the new
+ * content over the old one.
+ *
  * @section c_atomFile_streams Streams
  *
  * The functions @c le_atomFile_OpenStream() and @c le_atomFile_CreateStream() can be used to obtain
@@ -145,6 +145,9 @@
  *     msgPayloadPtr->... = ...; // <-- Populate message payload...
  * @endcode
  *
+ * If the message is known to be smaller than the largest message in the protocol,
+ * le_msg_CreateSizedMsg() can be used instead to allocate it from a smaller message pool.
+ *
  * If no response is required from the server, the client sends the message using le_msg_Send().
  * At this point, the client has handed off the message to the messaging system, and the messaging
  * system will delete the message automatically once it has finished sending it.
@@ -594,6 +597,13 @@
  * To work around this, you could move the service to another thread that that runs the Legato event
  * loop.
  *
+ * A server may hand a received request over to another thread (e.g., a pool of worker threads) to
+ * keep a slow request from holding up the others.  On Linux, le_msg_Respond() can then be called
+ * from that thread; the response is sent from the service's thread.  The worker should process the
+ * request inside le_msg_CallServiceRecvHandler() so that le_msg_GetServiceRxMsg() and
+ * LE_KILL_CLIENT() work there too.  ifgen generates such a server for an interface when given the
+ * @c --server-workers option.
+ *
  * @subsection c_messagingServerExample Sample Code
  *
  * @code
@@ -796,6 +806,12 @@
  * You can also inspect message queues and view lists of outstanding message objects within
  * processes using the Process Inspector tool.
  *
+ * Every request-response transaction is also counted per interface and per message ID, along with
+ * a histogram of how long it took: round-trip time on the client side, and time from reception to
+ * le_msg_Respond() on the server side.  Use <c>inspect ipc <pid></c> to view these statistics.
+ * Generated interfaces label message IDs with their function names using
+ * le_msg_SetProtocolMsgNames().
+ *
  * If you're leaking messages by forgetting to release them when you're finished with them,
  * you'll see warning messages in the log indicating your message pool is growing.
  * You should be able to tell the related messaging service by the name of the expanding pool.
@@ -1065,6 +1081,23 @@ LE_FULL_API size_t le_msg_GetProtocolMaxMsgSize
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets the table of message names for a protocol.  The table is indexed by the message ID found in
+ * the first 32 bits of each request payload, and is only used to label per-message call statistics
+ * (see @ref c_messagingTroubleshooting).
+ *
+ * @note The table is not copied, so it must remain valid for as long as the protocol is in use.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_FULL_API void le_msg_SetProtocolMsgNames
+(
+    le_msg_ProtocolRef_t protocolRef,   ///< [in] Reference to the protocol.
+    const char* const*   namesPtr,      ///< [in] Message names, indexed by message ID.
+    size_t               nameCount      ///< [in] Number of entries in the table.
+);
+
+
 // =======================================
 //  SESSION FUNCTIONS
 // =======================================
@@ -1402,6 +1435,32 @@ le_msg_MessageRef_t le_msg_CreateMsg
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates a message to be sent over a given session, with a payload buffer only large enough to
+ * hold a given number of bytes.
+ *
+ * The payload is allocated from the smallest of the protocol's message size classes that can hold
+ * payloadSize bytes, so protocols with one large message don't pay for it on every small message.
+ * le_msg_GetMaxPayloadSize() reports the size actually allocated, which may be larger than
+ * requested but never larger than the protocol's maximum message size.
+ *
+ * @return  Message reference.
+ *
+ * @note
+ * - Function never returns on failure, there's no need to check the return code.
+ * - Only use this for messages which don't need a response, or whose response is received into
+ *   a separate message (e.g. le_msg_RequestSyncResponse()).  A received request always has room
+ *   for the largest response.
+ */
+//--------------------------------------------------------------------------------------------------
+le_msg_MessageRef_t le_msg_CreateSizedMsg
+(
+    le_msg_SessionRef_t sessionRef, ///< [in] Reference to the session.
+    size_t payloadSize              ///< [in] Bytes of payload the message needs to hold.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Adds to the reference count on a message object.
@@ -1594,6 +1653,9 @@ le_msg_MessageRef_t le_msg_RequestSyncResponse
  * the response.
  *
  * @note    Function can only be used on the server side of a session.
+ *
+ * @note    On Linux, this can be called from any thread.  If the calling thread isn't the one that
+ *          owns the session, the response is queued to that thread and sent from there.
  */
 //--------------------------------------------------------------------------------------------------
 void le_msg_Respond
@@ -1813,6 +1875,24 @@ le_msg_MessageRef_t le_msg_GetServiceRxMsg
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Calls a service's message receive handler for a message on the calling thread, the same way the
+ * messaging system does when the message arrives.  While the handler runs, le_msg_GetServiceRxMsg()
+ * returns the message and LE_KILL_CLIENT() closes its session.
+ *
+ * This is used by servers that process received messages on threads other than the service's
+ * thread.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_FULL_API void le_msg_CallServiceRecvHandler
+(
+    le_msg_ReceiveHandler_t handlerFunc,    ///< [in] Handler function.
+    le_msg_MessageRef_t     msgRef,         ///< [in] Message to pass to the handler.
+    void*                   contextPtr      ///< [in] Opaque pointer value to pass to the handler.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Logs an error message (at EMERGENCY level) and:
@@ -1687,4 +1687,490 @@ LE_DECLARE_INLINE bool le_pack_UnpackArrayHeader
     LE_PACK_UNPACKARRAY((bufferPtr), (arrayPtr), (arrayCountPtr),       \
                         (arrayMaxCount), (unpackFunc), (resultPtr))
 
+#ifndef LE_CONFIG_RPC
+//--------------------------------------------------------------------------------------------------
+// Compact pack functions
+//
+// Used by generated IPC code for interfaces built with compact encoding.  Integers are written as
+// little-endian base-128 varints: 7 data bits per byte, with the top bit set on every byte except
+// the last.  Signed values are zigzag encoded first, so small negative values (e.g. le_result_t
+// codes) also pack into a single byte.  Strings are prefixed by a varint length instead of a uint32.
+//
+// Not available with LE_CONFIG_RPC, as the RPC proxy relies on fixed width, tagged fields.
+//--------------------------------------------------------------------------------------------------
+
+/// Maximum number of bytes used by a varint encoded 32-bit value.
+#define LE_PACK_VARUINT32_MAX_SIZE    5
+
+/// Maximum number of bytes used by a varint encoded 64-bit value.
+#define LE_PACK_VARUINT64_MAX_SIZE    10
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pack a uint64_t as a varint into a buffer, incrementing the buffer pointer as appropriate.
+ *
+ * @note Uses at most LE_PACK_VARUINT64_MAX_SIZE bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_DECLARE_INLINE bool le_pack_PackVarUint64
+(
+    uint8_t** bufferPtr,
+    uint64_t value
+)
+{
+    uint8_t* outPtr = *bufferPtr;
+
+    while (value >= 0x80)
+    {
+        *outPtr++ = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    *outPtr++ = (uint8_t)value;
+
+    *bufferPtr = outPtr;
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pack a uint32_t as a varint into a buffer, incrementing the buffer pointer as appropriate.
+ *
+ * @note Uses at most LE_PACK_VARUINT32_MAX_SIZE bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_DECLARE_INLINE bool le_pack_PackVarUint32
+(
+    uint8_t** bufferPtr,
+    uint32_t value
+)
+{
+    return le_pack_PackVarUint64(bufferPtr, value);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pack a uint16_t as a varint into a buffer, incrementing the buffer pointer as appropriate.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_DECLARE_INLINE bool le_pack_PackVarUint16
+(
+    uint8_t** bufferPtr,
+    uint16_t value
+)
+{
+    return le_pack_PackVarUint64(bufferPtr, value);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pack an int64_t as a zigzag varint into a buffer, incrementing the buffer pointer as
+ * appropriate.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_DECLARE_INLINE bool le_pack_PackVarInt64
+(
+    uint8_t** bufferPtr,
+    int64_t value
+)
+{
+    return le_pack_PackVarUint64(bufferPtr,
+                                 ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pack an int32_t as a zigzag varint into a buffer, incrementing the buffer pointer as
+ * appropriate.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_DECLARE_INLINE bool le_pack_PackVarInt32
+(
+    uint8_t** bufferPtr,
+    int32_t value
+)
+{
+    return le_pack_PackVarUint64(bufferPtr,
+                                 ((uint32_t)value << 1) ^ (uint32_t)(value >> 31));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pack an int16_t as a zigzag varint into a buffer, incrementing the buffer pointer as
+ * appropriate.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_DECLARE_INLINE bool le_pack_PackVarInt16
+(
+    uint8_t** bufferPtr,
+    int16_t value
+)
+{
+    return le_pack_PackVarInt32(bufferPtr, value);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pack a size_t as a varint into a buffer, incrementing the buffer pointer as appropriate.
+ *
+ * @note Packed sizes are limited to 2^32-1, regardless of platform
+ */
+//--------------------------------------------------------------------------------------------------
+LE_DECLARE_INLINE bool le_pack_PackVarSize
+(
+    uint8_t **bufferPtr,
+    size_t value
+)
+{
+    if (value > UINT32_MAX)
+    {
+        return false;
+    }
+
+    return le_pack_PackVarUint32(bufferPtr, value);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pack a le_result_t as a zigzag varint into a buffer, incrementing the buffer pointer as
+ * appropriate.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_DECLARE_INLINE bool le_pack_PackVarResult
+(
+    uint8_t** bufferPtr,
+    le_result_t value
+)
+{
+    return le_pack_PackVarInt32(bufferPtr, (int32_t)value);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pack le_onoff_t as a varint into a buffer, incrementing the buffer pointer as appropriate.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_DECLARE_INLINE bool le_pack_PackVarOnOff
+(
+    uint8_t** bufferPtr,
+    le_onoff_t value
+)
+{
+    return le_pack_PackVarUint32(bufferPtr, (uint32_t)value);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pack a string with a varint length prefix into a buffer, incrementing the buffer pointer.
+ *
+ * @return false if the string is longer than maxStringCount.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_DECLARE_INLINE bool le_pack_PackVarString
+(
+    uint8_t** bufferPtr,
+    const char *stringPtr,
+    uint32_t maxStringCount
+)
+{
+    size_t stringLen;
+
+    if (!stringPtr)
+    {
+        return false;
+    }
+
+    stringLen = strnlen(stringPtr, maxStringCount);
+
+    // String was too long to fit in the buffer -- return false.
+    if (stringPtr[stringLen] != '\0')
+    {
+        return false;
+    }
+
+    le_pack_PackVarUint32(bufferPtr, stringLen);
+    memcpy(*bufferPtr, stringPtr, stringLen);
+    *bufferPtr = *bufferPtr + stringLen;
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Compact unpack functions
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unpack a varint encoded uint64_t from a buffer, incrementing the buffer pointer as appropriate.
+ *
+ * @return false if the varint is longer than LE_PACK_VARUINT64_MAX_SIZE bytes or overflows.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_DECLARE_INLINE bool le_pack_UnpackVarUint64
+(
+    uint8_t** bufferPtr,
+    uint64_t* valuePtr
+)
+{
+    const uint8_t* inPtr = *bufferPtr;
+    uint64_t value = 0;
+    unsigned int shift;
+
+    for (shift = 0; shift < 64; shift += 7)
+    {
+        uint8_t byte = *inPtr++;
+
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+        {
+            // Tenth byte may only carry the top bit of the value.
+            if ((shift == 63) && (byte > 1))
+            {
+                return false;
+            }
+
+            *valuePtr = value;
+            *bufferPtr = (uint8_t*)inPtr;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unpack a varint encoded uint32_t from a buffer, incrementing the buffer pointer as appropriate.
+ *
+ * @return false if the encoded value does not fit in 32 bits.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_DECLARE_INLINE bool le_pack_UnpackVarUint32
+(
+    uint8_t** bufferPtr,
+    uint32_t* valuePtr
+)
+{
+    uint8_t* startPtr = *bufferPtr;
+    uint64_t value;
+
+    if (!le_pack_UnpackVarUint64(bufferPtr, &value) ||
+        (value > UINT32_MAX))
+    {
+        *bufferPtr = startPtr;
+        return false;
+    }
+
+    *valuePtr = (uint32_t)value;
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unpack a varint encoded uint16_t from a buffer, incrementing the buffer pointer as appropriate.
+ *
+ * @return false if the encoded value does not fit in 16 bits.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_DECLARE_INLINE bool le_pack_UnpackVarUint16
+(
+    uint8_t** bufferPtr,
+    uint16_t* valuePtr
+)
+{
+    uint8_t* startPtr = *bufferPtr;
+    uint64_t value;
+
+    if (!le_pack_UnpackVarUint64(bufferPtr, &value) ||
+        (value > UINT16_MAX))
+    {
+        *bufferPtr = startPtr;
+        return false;
+    }
+
+    *valuePtr = (uint16_t)value;
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unpack a zigzag varint encoded int64_t from a buffer, incrementing the buffer pointer as
+ * appropriate.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_DECLARE_INLINE bool le_pack_UnpackVarInt64
+(
+    uint8_t** bufferPtr,
+    int64_t* valuePtr
+)
+{
+    uint64_t value;
+
+    if (!le_pack_UnpackVarUint64(bufferPtr, &value))
+    {
+        return false;
+    }
+
+    *valuePtr = (int64_t)((value >> 1) ^ (~(value & 1) + 1));
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unpack a zigzag varint encoded int32_t from a buffer, incrementing the buffer pointer as
+ * appropriate.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_DECLARE_INLINE bool le_pack_UnpackVarInt32
+(
+    uint8_t** bufferPtr,
+    int32_t* valuePtr
+)
+{
+    uint32_t value;
+
+    if (!le_pack_UnpackVarUint32(bufferPtr, &value))
+    {
+        return false;
+    }
+
+    *valuePtr = (int32_t)((value >> 1) ^ (~(value & 1) + 1));
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unpack a zigzag varint encoded int16_t from a buffer, incrementing the buffer pointer as
+ * appropriate.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_DECLARE_INLINE bool le_pack_UnpackVarInt16
+(
+    uint8_t** bufferPtr,
+    int16_t* valuePtr
+)
+{
+    uint16_t value;
+
+    if (!le_pack_UnpackVarUint16(bufferPtr, &value))
+    {
+        return false;
+    }
+
+    *valuePtr = (int16_t)((value >> 1) ^ (uint16_t)(~(value & 1) + 1));
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unpack a varint encoded size_t from a buffer, incrementing the buffer pointer as appropriate.
+ *
+ * @note Packed sizes are limited to 2^32-1, regardless of platform
+ */
+//--------------------------------------------------------------------------------------------------
+LE_DECLARE_INLINE bool le_pack_UnpackVarSize
+(
+    uint8_t **bufferPtr,
+    size_t *valuePtr
+)
+{
+    uint32_t rawValue;
+
+    if (!le_pack_UnpackVarUint32(bufferPtr, &rawValue))
+    {
+        return false;
+    }
+
+    *valuePtr = rawValue;
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unpack a zigzag varint encoded le_result_t from a buffer, incrementing the buffer pointer as
+ * appropriate.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_DECLARE_INLINE bool le_pack_UnpackVarResult
+(
+    uint8_t** bufferPtr,
+    le_result_t* valuePtr
+)
+{
+    int32_t value;
+
+    if (!le_pack_UnpackVarInt32(bufferPtr, &value))
+    {
+        return false;
+    }
+
+    *valuePtr = (le_result_t)value;
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unpack a varint encoded le_onoff_t from a buffer, incrementing the buffer pointer as
+ * appropriate.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_DECLARE_INLINE bool le_pack_UnpackVarOnOff
+(
+    uint8_t** bufferPtr,
+    le_onoff_t* valuePtr
+)
+{
+    uint32_t value;
+
+    if (!le_pack_UnpackVarUint32(bufferPtr, &value))
+    {
+        return false;
+    }
+
+    *valuePtr = (le_onoff_t)value;
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unpack a string with a varint length prefix from a buffer, incrementing the buffer pointer.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_DECLARE_INLINE bool le_pack_UnpackVarString
+(
+    uint8_t** bufferPtr,
+    char *stringPtr,
+    uint32_t bufferSize,
+    uint32_t maxStringCount
+)
+{
+    uint32_t stringSize;
+
+    // First get string size
+    if (!le_pack_UnpackVarUint32(bufferPtr, &stringSize))
+    {
+        return false;
+    }
+
+    if ((stringSize > maxStringCount) ||
+        (stringSize >= bufferSize))
+    {
+        return false;
+    }
+
+    if (!stringPtr)
+    {
+        // Only allow unpacking into no output buffer if the string is zero sized.
+        return (stringSize == 0);
+    }
+
+    memcpy(stringPtr, *bufferPtr, stringSize);
+    stringPtr[stringSize] = '\0';
+
+    *bufferPtr = *bufferPtr + stringSize;
+
+    return true;
+}
+#endif /* !LE_CONFIG_RPC */
+
 #endif /* LE_PACK_H_INCLUDE_GUARD */
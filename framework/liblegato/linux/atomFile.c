@@ -53,16 +53,19 @@
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Mutex used to protect shared data structures in this module.
+ * Number of shards in the table of files opened for atomic access.  Each shard has its own mutex,
+ * so that threads opening and closing different files rarely contend with each other.
  */
 //--------------------------------------------------------------------------------------------------
-static pthread_mutex_t Mutex = PTHREAD_MUTEX_INITIALIZER;   // POSIX "Fast" mutex.
+#define ACCESS_TABLE_SHARD_COUNT    8
 
-/// Locks the mutex.
-#define LOCK    LE_ASSERT(pthread_mutex_lock(&Mutex) == 0);
 
-/// Unlocks the mutex.
-#define UNLOCK  LE_ASSERT(pthread_mutex_unlock(&Mutex) == 0);
+//--------------------------------------------------------------------------------------------------
+/**
+ * Expected number of files open for atomic access at the same time in each shard.
+ */
+//--------------------------------------------------------------------------------------------------
+#define ACCESS_TABLE_SHARD_CAPACITY 4
 
 
 //--------------------------------------------------------------------------------------------------
@@ -73,7 +76,7 @@ static pthread_mutex_t Mutex = PTHREAD_MUTEX_INITIALIZER;   // POSIX "Fast" mute
 //-------------------------------------------------------------------------------------------------
 typedef struct
 {
-    le_dls_Link_t   link;                 ///< Used to link into the FileAccessList.
+    uint32_t fd;                          ///< File descriptor handed to the caller (table key).
     int tempFd;                           ///< File descriptor of temp file.
     int originFd;                         ///< File descriptor of original file.
     int lockFd;                           ///< File descriptor for lock file.
@@ -92,11 +95,59 @@ static le_mem_PoolRef_t FileAccessPool;
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Linked list of FileAccess_t objects.
+ * Shard of the table of files opened for atomic access.
+ **/
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    pthread_mutex_t mutex;                ///< Protects the map.
+    le_hashmap_Ref_t map;                 ///< FileAccess_t objects, keyed by file descriptor.
+}
+AccessShard_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Table of files opened for atomic access, sharded by the file descriptor handed to the caller
+ * (the temporary file's, or the original file's for read-only access).
+ **/
+//--------------------------------------------------------------------------------------------------
+static AccessShard_t AccessTable[ACCESS_TABLE_SHARD_COUNT];
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Lock the shard of the access table that a file descriptor belongs to.
+ *
+ * @return
+ *      The locked shard.
  **/
 //--------------------------------------------------------------------------------------------------
-static le_dls_List_t FileAccessList = LE_DLS_LIST_INIT;
+static AccessShard_t* LockShard
+(
+    uint32_t fd                 ///< [IN] File descriptor handed to the caller.
+)
+{
+    AccessShard_t* shardPtr = &AccessTable[fd % ACCESS_TABLE_SHARD_COUNT];
 
+    LE_ASSERT(pthread_mutex_lock(&shardPtr->mutex) == 0);
+
+    return shardPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unlock a shard of the access table.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void UnlockShard
+(
+    AccessShard_t* shardPtr     ///< [IN] Shard locked by LockShard().
+)
+{
+    LE_ASSERT(pthread_mutex_unlock(&shardPtr->mutex) == 0);
+}
 
 
 //--------------------------------------------------------------------------------------------------
@@ -113,27 +164,14 @@ static FileAccess_t* GetFileData
     int fd                 ///< [IN] File descriptor of atomically accessed file.
 )
 {
-    LOCK
-    le_dls_Link_t* linkPtr = le_dls_Peek(&FileAccessList);
-
-    while (linkPtr != NULL)
-    {
-        FileAccess_t* accessPtr = CONTAINER_OF(linkPtr, FileAccess_t, link);
+    uint32_t key = fd;
+    AccessShard_t* shardPtr = LockShard(key);
 
-        if ((accessPtr->tempFd == fd) ||
-            ((accessPtr->originFd == fd) && (accessPtr->tempFd == -1)))  // This is for READ_ONLY
-                                                                         // file check.
-        {
-            UNLOCK
-            return accessPtr;
-        }
+    FileAccess_t* accessPtr = le_hashmap_Get(shardPtr->map, &key);
 
-        linkPtr = le_dls_PeekNext(&FileAccessList, linkPtr);
-    }
+    UnlockShard(shardPtr);
 
-    UNLOCK
-
-    return NULL;
+    return accessPtr;
 }
 
 
@@ -150,18 +188,20 @@ static void SaveFileData
     const char* pathNamePtr   ///< Path to atomically accessed file.
 )
 {
-    LOCK
-
     FileAccess_t* accessPtr = le_mem_ForceAlloc(FileAccessPool);
 
-    accessPtr->link = LE_DLS_LINK_INIT;
+    // The caller gets the temporary file, except for read-only access.
+    accessPtr->fd = (tempFd > -1) ? tempFd : fd;
     accessPtr->originFd = fd;
     accessPtr->lockFd = lockFd;
     accessPtr->tempFd = tempFd;
     LE_ASSERT_OK(le_utf8_Copy(accessPtr->filePath, pathNamePtr, sizeof(accessPtr->filePath), NULL));
-    le_dls_Queue(&FileAccessList, &accessPtr->link);
 
-    UNLOCK
+    AccessShard_t* shardPtr = LockShard(accessPtr->fd);
+
+    LE_ASSERT(le_hashmap_Put(shardPtr->map, &accessPtr->fd, accessPtr) == NULL);
+
+    UnlockShard(shardPtr);
 }
 
 
@@ -175,12 +215,13 @@ static void DeleteFileData
     FileAccess_t* accessPtr  ///< File access data to be deleted.
 )
 {
-    LOCK
+    AccessShard_t* shardPtr = LockShard(accessPtr->fd);
 
-    le_dls_Remove(&FileAccessList, &accessPtr->link);
-    le_mem_Release(accessPtr);
+    LE_ASSERT(le_hashmap_Remove(shardPtr->map, &accessPtr->fd) == accessPtr);
 
-    UNLOCK
+    UnlockShard(shardPtr);
+
+    le_mem_Release(accessPtr);
 }
 
 
@@ -877,13 +918,8 @@ static le_result_t Close
 
     le_result_t result = LE_OK;
 
-    if ((accessPtr->originFd == fd) &&
-        (accessPtr->tempFd < 0))
-    {
-        le_flock_Close(fd);
-        le_flock_Close(accessPtr->lockFd);
-    }
-    else
+    if ((accessPtr->originFd != fd) ||
+        (accessPtr->tempFd > -1))
     {
         char tempFilePath[PATH_MAX];
         GetFilePath(accessPtr->filePath, TEMP_FILE_EXTENSION, tempFilePath, sizeof(tempFilePath));
@@ -898,20 +934,24 @@ static le_result_t Close
             // will be deleted when file descriptor will be closed.
             result = DeleteFile(tempFilePath);
         }
+    }
 
-        // Now close temp and original file descriptor.
-        le_flock_Close(fd);
+    // Release memory before closing the file descriptors: once closed, their numbers can be given
+    // to a file opened concurrently, which is then added to the table.
+    int originFd = accessPtr->originFd;
+    int lockFd = accessPtr->lockFd;
 
-        if (accessPtr->originFd > -1)
-        {
-            le_flock_Close(accessPtr->originFd);
-        }
+    DeleteFileData(accessPtr);
 
-        le_flock_Close(accessPtr->lockFd);
+    // Now close temp and original file descriptor.
+    le_flock_Close(fd);
+
+    if ((originFd > -1) && (originFd != fd))
+    {
+        le_flock_Close(originFd);
     }
 
-    // Release memory.
-    DeleteFileData(accessPtr);
+    le_flock_Close(lockFd);
 
     return result;
 }
@@ -1470,13 +1510,9 @@ static le_result_t CloseStream
 
     le_result_t result = LE_OK;
 
-    if ((accessPtr->tempFd < 0) &&  // Negative tempfd implies READ_ONLY access requested.
-        (accessPtr->originFd == fd))
-    {
-        le_flock_CloseStream(file);
-        le_flock_Close(accessPtr->lockFd);
-    }
-    else
+    // Negative tempfd implies READ_ONLY access requested.
+    if ((accessPtr->tempFd > -1) ||
+        (accessPtr->originFd != fd))
     {
         char tempFilePath[PATH_MAX];
         GetFilePath(accessPtr->filePath, TEMP_FILE_EXTENSION, tempFilePath, sizeof(tempFilePath));
@@ -1509,22 +1545,26 @@ static le_result_t CloseStream
             // will be deleted when file descriptor will be closed.
             result = DeleteFile(tempFilePath);
         }
+    }
 
-        // Now close temporary and original file.
+    // Release allocated memory before closing the files: once closed, their file descriptors can be
+    // given to a file opened concurrently, which is then added to the table.
+    int originFd = accessPtr->originFd;
+    int lockFd = accessPtr->lockFd;
 
-        // It is ok to close stream after renaming it as it is in same filesystem.
-        le_flock_CloseStream(file);
+    DeleteFileData(accessPtr);
 
-        if (accessPtr->originFd > -1)
-        {
-            le_flock_Close(accessPtr->originFd);
-        }
+    // Now close temporary and original file.
+
+    // It is ok to close stream after renaming it as it is in same filesystem.
+    le_flock_CloseStream(file);
 
-        le_flock_Close(accessPtr->lockFd);
+    if ((originFd > -1) && (originFd != fd))
+    {
+        le_flock_Close(originFd);
     }
 
-    // Release allocated memory
-    DeleteFileData(accessPtr);
+    le_flock_Close(lockFd);
 
     return result;
 }
@@ -1748,8 +1788,8 @@ le_result_t le_atomFile_TryDelete
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Initialize the atomic file access internal memory pools.  This function is meant to be called
- * from Legato's internal init.
+ * Initialize the atomic file access internal memory pools and tables.  This function is meant to
+ * be called from Legato's internal init.
  */
 //--------------------------------------------------------------------------------------------------
 void atomFile_Init
@@ -1760,4 +1800,14 @@ void atomFile_Init
     // Initialize pools
     FileAccessPool = le_mem_CreatePool("AtomicFileAccessPool",
                                         sizeof(FileAccess_t));
+
+    size_t i;
+    for (i = 0; i < NUM_ARRAY_MEMBERS(AccessTable); i++)
+    {
+        LE_ASSERT(pthread_mutex_init(&AccessTable[i].mutex, NULL) == 0);
+        AccessTable[i].map = le_hashmap_Create("AtomicFileAccess",
+                                               ACCESS_TABLE_SHARD_CAPACITY,
+                                               le_hashmap_HashUInt32,
+                                               le_hashmap_EqualsUInt32);
+    }
 }
@@ -0,0 +1,261 @@
+/** @file bootTrace.c
+ *
+ * Implements the Boot Trace recorder of liblegato.  See bootTrace.h for an overview.
+ *
+ * Each process maps the trace file the first time it records an event.  Writers claim a slot of
+ * the ring buffer by atomically incrementing the buffer's nextIndex, fill it in, and then publish
+ * it by storing the slot's sequence number last, so a reader can tell complete events from ones
+ * that are still being written or have been overwritten.
+ *
+ * The file is created writable by its owner only, and made read-only once the boot is complete.
+ * Processes do not map a read-only file, and bootTrace_IsRecording() checks the mode with a single
+ * stat(), so processes started after the boot do not pay for the trace.
+ *
+ * @warning The code in this file @b must be thread safe and re-entrant.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "bootTrace.h"
+#include "fileDescriptor.h"
+
+#include <sys/mman.h>
+
+
+// =======================================
+//  PRIVATE DATA
+// =======================================
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The trace buffer mapped into this process, or NULL if it could not be mapped.
+ */
+//--------------------------------------------------------------------------------------------------
+static bootTrace_Buffer_t* BufferPtr = NULL;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Makes sure the trace buffer is only mapped once per process.
+ */
+//--------------------------------------------------------------------------------------------------
+static pthread_once_t MapOnce = PTHREAD_ONCE_INIT;
+
+
+// =======================================
+//  PRIVATE FUNCTIONS
+// =======================================
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Map the trace file.
+ *
+ * @return  Pointer to the trace buffer, or NULL on failure.
+ */
+//--------------------------------------------------------------------------------------------------
+static bootTrace_Buffer_t* MapFile
+(
+    int flags           ///< [IN] Flags to open the file with.
+)
+{
+    int fd;
+
+    while (((fd = open(BOOT_TRACE_PATH, flags | O_RDWR | O_CLOEXEC, S_IRUSR | S_IWUSR)) == -1) &&
+           (errno == EINTR)) {}
+
+    if (fd == -1)
+    {
+        return NULL;
+    }
+
+    if ((flags & O_CREAT) && (ftruncate(fd, sizeof(bootTrace_Buffer_t)) == -1))
+    {
+        LE_ERROR("Could not size '%s'. %m", BOOT_TRACE_PATH);
+        fd_Close(fd);
+        return NULL;
+    }
+
+    struct stat fileStat;
+    void* mapPtr = MAP_FAILED;
+
+    // A read-only file holds a complete boot, which is not recorded into any more.
+    if ((fstat(fd, &fileStat) == 0) && (fileStat.st_size >= (off_t)sizeof(bootTrace_Buffer_t)) &&
+        (fileStat.st_mode & S_IWUSR))
+    {
+        mapPtr = mmap(NULL, sizeof(bootTrace_Buffer_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+
+    fd_Close(fd);
+
+    return (mapPtr == MAP_FAILED) ? NULL : mapPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Map the trace buffer created by startSystem, if this process can reach it.
+ */
+//--------------------------------------------------------------------------------------------------
+static void MapBuffer
+(
+    void
+)
+{
+    bootTrace_Buffer_t* bufferPtr = MapFile(0);
+
+    if ((bufferPtr != NULL) && (bufferPtr->magic != BOOT_TRACE_MAGIC))
+    {
+        munmap(bufferPtr, sizeof(bootTrace_Buffer_t));
+        bufferPtr = NULL;
+    }
+
+    BufferPtr = bufferPtr;
+}
+
+
+// =======================================
+//  PROTECTED (INTER-MODULE) FUNCTIONS
+// =======================================
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a new, empty trace buffer, replacing the one of the previous framework start.  Called by
+ * startSystem before it starts the framework.
+ */
+//--------------------------------------------------------------------------------------------------
+void bootTrace_Reset
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    pthread_once(&MapOnce, MapBuffer);
+
+    if (BufferPtr != NULL)
+    {
+        munmap(BufferPtr, sizeof(bootTrace_Buffer_t));
+        BufferPtr = NULL;
+    }
+
+    // Processes still holding the previous buffer keep the old, unlinked, file.
+    if ((unlink(BOOT_TRACE_PATH) == -1) && (errno != ENOENT))
+    {
+        LE_WARN("Could not remove '%s'. %m", BOOT_TRACE_PATH);
+    }
+
+    if (le_dir_MakePath(LE_CONFIG_RUNTIME_DIR, S_IRWXU | S_IXOTH) == LE_FAULT)
+    {
+        return;
+    }
+
+    bootTrace_Buffer_t* bufferPtr = MapFile(O_CREAT | O_EXCL);
+
+    if (bufferPtr == NULL)
+    {
+        LE_WARN("Could not create the boot trace buffer '%s'.", BOOT_TRACE_PATH);
+        return;
+    }
+
+    bufferPtr->maxEvents = BOOT_TRACE_MAX_EVENTS;
+    bufferPtr->nextIndex = 0;
+    bufferPtr->isComplete = 0;
+    __atomic_store_n(&bufferPtr->magic, BOOT_TRACE_MAGIC, __ATOMIC_RELEASE);
+
+    BufferPtr = bufferPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record an event.  Does nothing if the trace buffer can not be reached by this process, or if the
+ * boot is already complete.
+ */
+//--------------------------------------------------------------------------------------------------
+void bootTrace_Record
+(
+    bootTrace_Phase_t phase,    ///< [IN] Kind of event.
+    const char* nameFormat,     ///< [IN] printf-style format of the event name.
+    ...
+)
+//--------------------------------------------------------------------------------------------------
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    pthread_once(&MapOnce, MapBuffer);
+
+    bootTrace_Buffer_t* bufferPtr = BufferPtr;
+
+    if ((bufferPtr == NULL) || __atomic_load_n(&bufferPtr->isComplete, __ATOMIC_RELAXED))
+    {
+        return;
+    }
+
+    uint32_t index = __atomic_fetch_add(&bufferPtr->nextIndex, 1, __ATOMIC_RELAXED);
+    bootTrace_Event_t* eventPtr = &bufferPtr->events[index % BOOT_TRACE_MAX_EVENTS];
+
+    // Unpublish the slot while it is being overwritten.  The fence keeps the stores below from
+    // becoming visible before this one; it pairs with the acquire fence of the readers.
+    __atomic_store_n(&eventPtr->seq, 0, __ATOMIC_RELEASE);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    eventPtr->timeNs = ((uint64_t)now.tv_sec * 1000000000) + now.tv_nsec;
+    eventPtr->pid = getpid();
+    eventPtr->tid = syscall(SYS_gettid);
+    eventPtr->phase = (char)phase;
+
+    le_utf8_Copy(eventPtr->process, le_arg_GetProgramName(), sizeof(eventPtr->process), NULL);
+
+    va_list args;
+    va_start(args, nameFormat);
+    vsnprintf(eventPtr->name, sizeof(eventPtr->name), nameFormat, args);
+    va_end(args);
+
+    __atomic_store_n(&eventPtr->seq, index + 1, __ATOMIC_RELEASE);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mark the boot as complete.  No more events are recorded until the next bootTrace_Reset().
+ */
+//--------------------------------------------------------------------------------------------------
+void bootTrace_Complete
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    bootTrace_Record(BOOT_TRACE_MARK, "boot complete");
+
+    if (BufferPtr != NULL)
+    {
+        __atomic_store_n(&BufferPtr->isComplete, 1, __ATOMIC_RELAXED);
+
+        if (chmod(BOOT_TRACE_PATH, S_IRUSR) == -1)
+        {
+            LE_WARN("Could not make '%s' read-only. %m", BOOT_TRACE_PATH);
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if a boot is being recorded, without mapping the trace buffer.
+ *
+ * @return  true if the trace buffer exists and the boot is not complete yet.
+ */
+//--------------------------------------------------------------------------------------------------
+bool bootTrace_IsRecording
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    struct stat fileStat;
+
+    return (stat(BOOT_TRACE_PATH, &fileStat) == 0) && (fileStat.st_mode & S_IWUSR);
+}
@@ -0,0 +1,156 @@
+/** @file bootTrace.h
+ *
+ * Inter-module definitions exported by the Boot Trace module of liblegato.
+ *
+ * The framework records the milestones of its start-up (framework daemons, kernel modules, app
+ * launches, and the COMPONENT_INIT functions of every process that can reach the trace buffer)
+ * as time-stamped events in a ring buffer that is shared by all processes through a memory
+ * mapped file in the runtime directory.  The buffer is reset by startSystem each time it starts
+ * the framework, and the Supervisor closes it once all the apps have been auto-started, so it
+ * always holds the timeline of the last framework start.  The bootchart tool renders it.
+ *
+ * Recording an event takes no lock: it is a few stores into the mapped file, plus clock_gettime(),
+ * getpid() and gettid() system calls.  The first event a process records also opens and maps the
+ * file.  Once the boot is complete the file is made read-only, which lets processes started later
+ * skip mapping it altogether, so it can be left enabled.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#ifndef LE_BOOT_TRACE_H_INCLUDE_GUARD
+#define LE_BOOT_TRACE_H_INCLUDE_GUARD
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Path of the file that holds the trace buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+#define BOOT_TRACE_PATH             LE_CONFIG_RUNTIME_DIR "/bootTrace"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Value of the magic number at the start of a valid trace buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+#define BOOT_TRACE_MAGIC            0x4254524c
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of events the ring buffer holds.  Once it is full the oldest events are overwritten.
+ */
+//--------------------------------------------------------------------------------------------------
+#define BOOT_TRACE_MAX_EVENTS       1024
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sizes of the process and event name buffers (including null terminators).  Longer names are
+ * truncated.
+ */
+//--------------------------------------------------------------------------------------------------
+#define BOOT_TRACE_PROCESS_BYTES    16
+#define BOOT_TRACE_NAME_BYTES       48
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Kind of event.  The values are the matching Chrome trace event phases.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    BOOT_TRACE_BEGIN = 'B',     ///< Start of an activity.
+    BOOT_TRACE_END = 'E',       ///< End of the activity with the same name in the same thread.
+    BOOT_TRACE_MARK = 'i'       ///< Instant milestone.
+}
+bootTrace_Phase_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * One event in the trace buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint64_t timeNs;                            ///< CLOCK_MONOTONIC time of the event.
+    uint32_t seq;                               ///< Event index + 1 once written, 0 before.
+    int32_t pid;                                ///< Process that recorded the event.
+    int32_t tid;                                ///< Thread that recorded the event.
+    char phase;                                 ///< A bootTrace_Phase_t.
+    char process[BOOT_TRACE_PROCESS_BYTES];     ///< Name of the process.
+    char name[BOOT_TRACE_NAME_BYTES];           ///< Name of the event.
+}
+bootTrace_Event_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Layout of the trace buffer file.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t magic;                             ///< BOOT_TRACE_MAGIC.
+    uint32_t maxEvents;                         ///< Number of entries in events[].
+    uint32_t nextIndex;                         ///< Index of the next event to be recorded.
+    uint32_t isComplete;                        ///< Non-zero once the boot is complete.
+    bootTrace_Event_t events[BOOT_TRACE_MAX_EVENTS];    ///< Ring buffer of events.
+}
+bootTrace_Buffer_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a new, empty trace buffer, replacing the one of the previous framework start.  Called by
+ * startSystem before it starts the framework.
+ */
+//--------------------------------------------------------------------------------------------------
+void bootTrace_Reset
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record an event.  Does nothing if the trace buffer can not be reached by this process, or if the
+ * boot is already complete.
+ */
+//--------------------------------------------------------------------------------------------------
+void bootTrace_Record
+(
+    bootTrace_Phase_t phase,    ///< [IN] Kind of event.
+    const char* nameFormat,     ///< [IN] printf-style format of the event name.
+    ...
+) __attribute__((format(printf, 2, 3)));
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mark the boot as complete.  No more events are recorded until the next bootTrace_Reset().
+ */
+//--------------------------------------------------------------------------------------------------
+void bootTrace_Complete
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if a boot is being recorded, without mapping the trace buffer.
+ *
+ * @return  true if the trace buffer exists and the boot is not complete yet.
+ */
+//--------------------------------------------------------------------------------------------------
+bool bootTrace_IsRecording
+(
+    void
+);
+
+
+#endif // LE_BOOT_TRACE_H_INCLUDE_GUARD
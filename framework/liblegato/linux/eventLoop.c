@@ -45,6 +45,7 @@
 #include "fdMonitor.h"
 #include "limit.h"
 #include "fileDescriptor.h"
+#include "bootTrace.h"
 
 #include <sys/eventfd.h>
 
@@ -344,6 +345,10 @@ void fa_event_RunLoop
     // Update the state of the Event Loop.
     perThreadRecPtr->state = LE_EVENT_LOOP_RUNNING;
 
+    // The first Event Reports processed by the main thread include the queued COMPONENT_INIT
+    // functions, so they are timed for the boot trace, unless the boot is already complete.
+    bool isTracingInit = (getpid() == syscall(SYS_gettid)) && bootTrace_IsRecording();
+
     // Enter the infinite loop itself.
     for (;;)
     {
@@ -377,7 +382,17 @@ void fa_event_RunLoop
             }
 
             // Process all the Event Reports on the Event Queue.
-            event_ProcessEventReports(perThreadRecPtr);
+            if (isTracingInit)
+            {
+                bootTrace_Record(BOOT_TRACE_BEGIN, "COMPONENT_INIT");
+                event_ProcessEventReports(perThreadRecPtr);
+                bootTrace_Record(BOOT_TRACE_END, "COMPONENT_INIT");
+                isTracingInit = false;
+            }
+            else
+            {
+                event_ProcessEventReports(perThreadRecPtr);
+            }
         }
         // Otherwise, if an epoll_wait() reported an error, hopefully it's just an interruption
         // by a signal (EINTR).  Anything else is a fatal error.
@@ -10,6 +10,7 @@
 //--------------------------------------------------------------------------------------------------
 
 #include <sys/sendfile.h>
+#include <sys/ioctl.h>
 #include "legato.h"
 #include "smack.h"
 #include "fileDescriptor.h"
@@ -33,6 +34,18 @@
 #define MAX_XATTR_VALUE_SIZE            4096
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * ioctl() request that makes a file share the data blocks of another file (reflink), on file
+ * systems that support it (btrfs, xfs, overlayfs on those, ...).  Older kernel headers don't have
+ * it, but older kernels just fail the request, which is handled.
+ */
+//--------------------------------------------------------------------------------------------------
+#ifndef FICLONE
+#define FICLONE                         _IOW(0x94, 9, int)
+#endif
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Checks whether or not a file exists at a given file system path.
@@ -632,9 +645,10 @@ le_result_t file_Copy
         return result;
     }
 
-    // Get the kernel to copy the data over.  It may or may not happen in one go, so keep trying
-    // until the whole file has been written or we error out.
-    ssize_t sizeWritten = 0;
+    // Try sharing the data blocks first, so that nothing is copied until either file is changed.
+    // If the file system can't do it, get the kernel to copy the data over.  It may or may not
+    // happen in one go, so keep trying until the whole file has been written or we error out.
+    ssize_t sizeWritten = (ioctl(writeFd, FICLONE, readFd) == 0) ? sourceStatus.st_size : 0;
     result = LE_OK;
     off_t fileOffset = 0;
 
@@ -85,6 +85,10 @@
  * side.  For all other types of messages, this is set to 0 (NULL) to indicate that it does
  * not belong to a request-response transaction.
  *
+ * Each Interface object also keeps call statistics for its request-response transactions, one
+ * record per message ID, in the Call Statistics module (messagingStats.c).  The client side times
+ * the round trip; the server side times from reception of the request to le_msg_Respond().
+ *
  * See also @ref serviceDirectoryProtocol.
  *
  * @warning The code in this subsystem @b must be thread safe and re-entrant.
@@ -101,6 +105,7 @@
 #include "messagingSession.h"
 #include "messagingInterface.h"
 #include "messagingLocal.h"
+#include "messagingStats.h"
 
 // =======================================
 //  PROTECTED (INTER-MODULE) FUNCTIONS
@@ -123,5 +128,6 @@ void msg_Init
     msgProto_Init();
     msgMessage_Init();
     msgInterface_Init();
+    msgStats_Init();
     msgSession_Init();
 }
@@ -16,6 +16,7 @@
 #include "messagingInterface.h"
 #include "messagingSession.h"
 #include "messagingLocal.h"
+#include "messagingStats.h"
 #include "fileDescriptor.h"
 
 
@@ -202,6 +203,7 @@ static void InitInterface
                 sizeof(interfacePtr->id.name));
 
     interfacePtr->sessionList = LE_DLS_LIST_INIT;
+    interfacePtr->callStatsList = LE_SLS_LIST_INIT;
 }
 
 
@@ -385,6 +387,8 @@ static void ServiceDestructor
     ServiceObjMapChangeCount++;
     le_hashmap_Remove(ServiceMapRef, &servicePtr->interface.id);
 
+    msgStats_DeleteRecords(&servicePtr->interface);
+
     // Release the close handlers
     le_dls_Link_t* linkPtr;
     while ((linkPtr = le_dls_PopTail(&servicePtr->closeListPtr)) != NULL)
@@ -427,6 +431,8 @@ static void ClientInterfaceDestructor
 
     ClientInterfaceMapChangeCount++;
     le_hashmap_Remove(ClientInterfaceMapRef, &clientPtr->interface.id);
+
+    msgStats_DeleteRecords(&clientPtr->interface);
 }
 
 
@@ -960,6 +966,36 @@ void msgInterface_AddSession
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Locks the Mutex that protects the Interfaces' session lists.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgInterface_Lock
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LOCK
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unlocks the Mutex locked by msgInterface_Lock().
+ */
+//--------------------------------------------------------------------------------------------------
+void msgInterface_Unlock
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    UNLOCK
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Remove a Session from an Interface's list of open sessions.
@@ -1325,6 +1361,30 @@ void le_msg_SetServiceRecvHandler
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Calls a service's message receive handler for a message on the calling thread, the same way the
+ * messaging system does when the message arrives.  While the handler runs, le_msg_GetServiceRxMsg()
+ * returns the message and LE_KILL_CLIENT() closes its session.
+ *
+ * This is used by servers that process received messages on threads other than the service's
+ * thread.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_msg_CallServiceRecvHandler
+(
+    le_msg_ReceiveHandler_t handlerFunc,    ///< [in] Handler function.
+    le_msg_MessageRef_t     msgRef,         ///< [in] Message to pass to the handler.
+    void*                   contextPtr      ///< [in] Opaque pointer value to pass to the handler.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(handlerFunc != NULL);
+
+    msgCommon_CallRecvHandler(handlerFunc, msgRef, contextPtr);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Associates an opaque context value (void pointer) with a given service that can be retrieved
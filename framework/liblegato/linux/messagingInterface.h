@@ -53,6 +53,7 @@ typedef struct le_msg_Interface
     le_dls_List_t sessionList;         ///< List of Session objects for open sessions with other
                                        ///  interfaces.
     msgInterface_Type_t interfaceType; ///< The type of the more specific interface object.
+    le_sls_List_t callStatsList;       ///< Per-message call statistics (msgStats_Record_t).
 }
 msgInterface_Interface_t;
 
@@ -248,6 +249,29 @@ void msgInterface_RemoveSession
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Lock the Mutex that protects the Interfaces' session lists.  Used by the messagingSession module
+ * when it must delete a session with the Mutex already held (see msgInterface_RemoveSession()).
+ */
+//--------------------------------------------------------------------------------------------------
+void msgInterface_Lock
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unlock the Mutex locked by msgInterface_Lock().
+ */
+//--------------------------------------------------------------------------------------------------
+void msgInterface_Unlock
+(
+    void
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Call a Service's registered session close handler function, if there is one registered.
@@ -13,9 +13,31 @@
 #include "messagingSession.h"
 #include "messagingInterface.h"
 #include "messagingLocal.h"
+#include "messagingStats.h"
 #include "fileDescriptor.h"
 #include "unixSocket.h"
 
+// =======================================
+//  PRIVATE DATA
+// =======================================
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Payload size of the smallest message size class.  Most generated IPC messages (a message ID,
+ * a few scalars and references) fit in this.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SMALL_MSG_PAYLOAD_BYTES     128
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Ratio between the protocol's largest message payload and the medium size class payload.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MEDIUM_MSG_PAYLOAD_DIVISOR  4
+
+
 // =======================================
 //  PRIVATE FUNCTIONS
 // =======================================
@@ -54,6 +76,62 @@ static le_msg_MessageRef_t msgMessage_GetMessageRef(UnixMessage_t* msgPtr)
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Build the name of a Message Pool from a prefix and the protocol name.
+ */
+//--------------------------------------------------------------------------------------------------
+static void GetPoolName
+(
+    char* poolName,         ///< [out] Pool name buffer.
+    size_t poolNameSize,    ///< [in] Size of the pool name buffer.
+    const char* prefix,     ///< [in] Prefix identifying the size class.
+    const char* name        ///< [in] Name of the protocol.
+)
+{
+    size_t bytesCopied;
+    le_result_t result;
+
+    le_utf8_Copy(poolName, prefix, poolNameSize, &bytesCopied);
+    result = le_utf8_Copy(poolName + bytesCopied, name, poolNameSize - bytesCopied, NULL);
+    if (result != LE_OK)
+    {
+        LE_DEBUG("Pool name truncated to '%s' for protocol '%s'.", poolName, name);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a reduced-size Message Pool for a smaller size class, if it is worth having one.
+ *
+ * @return  A reference to the new pool, or superPool if the size class would not save memory.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t CreateSizeClassPool
+(
+    le_mem_PoolRef_t superPool, ///< [in] Pool of the next larger size class.
+    const char* prefix,         ///< [in] Pool name prefix for this size class.
+    const char* name,           ///< [in] Name of the protocol.
+    size_t superPayloadSize,    ///< [in] Payload size of the next larger size class.
+    size_t payloadSize          ///< [in] Payload size of this size class.
+)
+{
+    char poolName[LIMIT_MAX_MEM_POOL_NAME_BYTES];
+
+    // A reduced pool carves its blocks out of the parent's, so it only pays off if at least two
+    // of its blocks fit into one parent block.
+    if (payloadSize * 2 > superPayloadSize)
+    {
+        return superPool;
+    }
+
+    GetPoolName(poolName, sizeof(poolName), prefix, name);
+
+    return le_mem_CreateReducedPool(superPool, poolName, 0, sizeof(UnixMessage_t) + payloadSize);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Destructor function for Message objects.
@@ -130,7 +208,13 @@ void msgMessage_Init
 /**
  * Create a Message Pool.
  *
- * @return  A reference to the pool.
+ * Messages are split into up to three size classes: small, medium (a quarter of the largest
+ * message) and the largest message in the protocol.  The smaller classes are reduced-size
+ * sub-pools of the largest one, named "msgs-s-<protocol>" and "msgs-m-<protocol>", so their
+ * memory use shows up per protocol in "inspect pools".
+ *
+ * @return  A reference to the pool of the smallest size class.  Use le_mem_ForceVarAlloc() to
+ *          allocate a message of a given size from it.
  */
 //--------------------------------------------------------------------------------------------------
 le_mem_PoolRef_t msgMessage_CreatePool
@@ -141,15 +225,9 @@ le_mem_PoolRef_t msgMessage_CreatePool
 //--------------------------------------------------------------------------------------------------
 {
     char poolName[LIMIT_MAX_MEM_POOL_NAME_BYTES];
-    size_t bytesCopied;
-    le_result_t result;
+    size_t mediumMsgSize = largestMsgSize / MEDIUM_MSG_PAYLOAD_DIVISOR;
 
-    le_utf8_Copy(poolName, "msgs-", sizeof(poolName), &bytesCopied);
-    result = le_utf8_Copy(poolName + bytesCopied, name, sizeof(poolName) - bytesCopied, NULL);
-    if (result != LE_OK)
-    {
-        LE_DEBUG("Pool name truncated to '%s' for protocol '%s'.", poolName, name);
-    }
+    GetPoolName(poolName, sizeof(poolName), "msgs-", name);
 
     le_mem_PoolRef_t poolRef = le_mem_CreatePool(poolName, sizeof(UnixMessage_t) + largestMsgSize);
 
@@ -157,7 +235,16 @@ le_mem_PoolRef_t msgMessage_CreatePool
 
     le_mem_ExpandPool(poolRef, 10); /// @todo Make this configurable.
 
-    return poolRef;
+    // Sub-pools inherit the destructor.
+    le_mem_PoolRef_t mediumPoolRef = CreateSizeClassPool(poolRef, "msgs-m-", name,
+                                                         largestMsgSize, mediumMsgSize);
+    if (mediumPoolRef == poolRef)
+    {
+        mediumMsgSize = largestMsgSize;
+    }
+
+    return CreateSizeClassPool(mediumPoolRef, "msgs-s-", name,
+                               mediumMsgSize, SMALL_MSG_PAYLOAD_BYTES);
 }
 
 
@@ -241,6 +328,14 @@ le_result_t msgMessage_Receive
     if (msgSession_GetInterfaceType(msgRef->sessionRef) == LE_MSG_INTERFACE_SERVER)
     {
         msgPtr->clientServer.server.responseFd = -1;
+
+        // Start timing requests from the moment they are received, so that the statistics include
+        // the time spent waiting in the receive queue.
+        if ((result == LE_OK) && le_msg_NeedsResponse(msgRef))
+        {
+            msgPtr->statsStartUs = msgStats_GetTimestamp();
+            msgPtr->statsMsgId = msgStats_GetMsgId(msgRef);
+        }
     }
 
     return result;
@@ -298,6 +393,13 @@ void msgMessage_CallCompletionCallback
 {
     UnixMessage_t* requestMsgPtr = msgMessage_GetUnixMessagePtr(requestMsgRef);
 
+    if (responseMsgRef != NULL)
+    {
+        msgStats_Record(msgSession_GetInterfaceRef(requestMsgRef->sessionRef),
+                        requestMsgPtr->statsMsgId,
+                        requestMsgPtr->statsStartUs);
+    }
+
     if (requestMsgPtr->clientServer.client.completionCallback != NULL)
     {
         requestMsgPtr->clientServer.client.completionCallback(responseMsgRef,
@@ -327,6 +429,30 @@ le_msg_MessageRef_t le_msg_CreateMsg
     le_msg_SessionRef_t sessionRef  ///< [in] Reference to the session.
 )
 //--------------------------------------------------------------------------------------------------
+{
+    // Payload size is capped to the protocol's largest message.
+    return le_msg_CreateSizedMsg(sessionRef, SIZE_MAX);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates a message to be sent over a given session, with a payload buffer only large enough to
+ * hold a given number of bytes.
+ *
+ * @return  The message reference.
+ *
+ * @note
+ * - This function never returns on failure, so no need to check the return code.
+ * - Local sessions always allocate the largest message size.
+ */
+//--------------------------------------------------------------------------------------------------
+le_msg_MessageRef_t le_msg_CreateSizedMsg
+(
+    le_msg_SessionRef_t sessionRef, ///< [in] Reference to the session.
+    size_t payloadSize              ///< [in] Bytes of payload the message needs to hold.
+)
+//--------------------------------------------------------------------------------------------------
 {
     LE_ASSERT(sessionRef);
     // If this is a local session, create a local message
@@ -341,7 +467,7 @@ le_msg_MessageRef_t le_msg_CreateMsg
     // Get a reference to the Session's Protocol and ask the Protocol to allocate a Message
     // object from its Message Pool.
     le_msg_ProtocolRef_t protocolRef = le_msg_GetSessionProtocol(sessionRef);
-    UnixMessage_t* msgPtr = msgProto_AllocMessage(protocolRef);
+    UnixMessage_t* msgPtr = msgProto_AllocMessage(protocolRef, payloadSize);
 
     // Initialize the Message object's data members.
     msgPtr->link = LE_DLS_LINK_INIT;
@@ -364,9 +490,11 @@ le_msg_MessageRef_t le_msg_CreateMsg
             LE_FATAL("Unhandled interface type (%d).", interfaceType);
     }
 
+    msgPtr->statsStartUs = 0;
+    msgPtr->statsMsgId = MSG_STATS_OTHER_MSG_ID;
     msgPtr->fd = -1;
     msgPtr->txnId = 0;
-    memset(msgPtr->payload, 0, le_msg_GetProtocolMaxMsgSize(protocolRef));
+    memset(msgPtr->payload, 0, le_msg_GetMaxPayloadSize(msgMessage_GetMessageRef(msgPtr)));
 
     return msgMessage_GetMessageRef(msgPtr);
 }
@@ -511,7 +639,16 @@ size_t le_msg_GetMaxPayloadSize
         case LE_MSG_SESSION_LOCAL:
             return msgLocal_GetMaxPayloadSize(msgRef);
         case LE_MSG_SESSION_UNIX_SOCKET:
-            return le_msg_GetProtocolMaxMsgSize(le_msg_GetSessionProtocol(msgRef->sessionRef));
+        {
+            // The message may come from a smaller size class, and a size class block may be
+            // larger than the protocol's largest message.
+            size_t maxSize =
+                le_msg_GetProtocolMaxMsgSize(le_msg_GetSessionProtocol(msgRef->sessionRef));
+            UnixMessage_t* msgPtr = msgMessage_GetUnixMessagePtr(msgRef);
+            size_t blockPayloadSize = le_mem_GetBlockSize(msgPtr) - sizeof(UnixMessage_t);
+
+            return (blockPayloadSize < maxSize ? blockPayloadSize : maxSize);
+        }
         default:
             LE_FATAL("Corrupted session type: %d", msgRef->sessionRef->type);
     }
@@ -691,6 +828,9 @@ void le_msg_RequestResponse
             msgPtr->clientServer.client.completionCallback = handlerFunc;
             msgPtr->clientServer.client.contextPtr = contextPtr;
 
+            msgPtr->statsStartUs = msgStats_GetTimestamp();
+            msgPtr->statsMsgId = msgStats_GetMsgId(msgRef);
+
             // Tell the Session to do an asynchronous request-response transaction.
             msgSession_RequestResponse(msgRef->sessionRef, msgRef);
             break;
@@ -750,6 +890,52 @@ le_msg_MessageRef_t le_msg_RequestSyncResponse
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sends a response to a request that was received through a unix socket session.
+ *
+ * @note    Must be called by the thread that owns the session.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RespondUnix
+(
+    le_msg_MessageRef_t msgRef      ///< [in] Reference to the request message.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    UnixMessage_t* msgPtr = msgMessage_GetUnixMessagePtr(msgRef);
+
+    msgStats_Record(msgSession_GetInterfaceRef(msgRef->sessionRef),
+                    msgPtr->statsMsgId,
+                    msgPtr->statsStartUs);
+
+    // Send the response message.
+    msgSession_SendMessage(msgRef->sessionRef, msgRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sends a response on behalf of another thread.  Queued to the thread that owns the session by
+ * le_msg_Respond().
+ *
+ * @note    This function is called by the Event Loop as a "queued function".
+ *          That's why the parameter list looks unusual.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RespondQueued
+(
+    void* param1Ptr,    ///< [IN] Reference to the request message.
+    void* param2Ptr     ///< not used
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_UNUSED(param2Ptr);
+
+    RespondUnix(param1Ptr);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Sends a response back to the client that send the request message.
@@ -761,6 +947,9 @@ le_msg_MessageRef_t le_msg_RequestSyncResponse
  * the response.
  *
  * @note    This function can only be used on the server side of a session.
+ *
+ * @note    This can be called from any thread.  If the calling thread isn't the one that owns the
+ *          session, the response is queued to that thread and sent from there.
  */
 //--------------------------------------------------------------------------------------------------
 void le_msg_Respond
@@ -779,9 +968,21 @@ void le_msg_Respond
             msgLocal_Respond(msgRef);
             break;
         case LE_MSG_SESSION_UNIX_SOCKET:
-            // Send the response message.
-            msgSession_SendMessage(msgRef->sessionRef, msgRef);
+        {
+            le_thread_Ref_t threadRef = msgSession_GetThreadRef(msgRef->sessionRef);
+
+            // Only the thread that owns the session can send through it, so a response from
+            // any other thread (e.g., a server's worker thread) is sent from there.
+            if (le_thread_GetCurrent() != threadRef)
+            {
+                le_event_QueueFunctionToThread(threadRef, RespondQueued, msgRef, NULL);
+            }
+            else
+            {
+                RespondUnix(msgRef);
+            }
             break;
+        }
         default:
             LE_FATAL("Corrupted session type: %d", msgRef->sessionRef->type);
     }
@@ -40,6 +40,9 @@ typedef struct le_msg_UnixMessage
     }
     clientServer;
 
+    uint64_t                    statsStartUs; ///< Time the request was sent (client side) or
+                                              ///  received (server side), for call statistics.
+    uint32_t                    statsMsgId; ///< Message ID the call statistics are recorded under.
     int                         fd;         ///< File descriptor to send or received (-1 = no fd)
     void*                       txnId;      ///< Safe reference value used as a transaction ID.
     void*                       payload[0]; ///< Variable-length payload buffer appears at the end.
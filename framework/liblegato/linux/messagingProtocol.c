@@ -116,6 +116,8 @@ static msgProtocol_Protocol_t* CreateProtocol
     }
 
     protocolPtr->messagePoolRef = msgMessage_CreatePool(protocolId, largestMsgSize);
+    protocolPtr->msgNamesPtr = NULL;
+    protocolPtr->msgNameCount = 0;
 
     LOCK
 
@@ -150,19 +152,27 @@ void msgProto_Init
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Allocate a Message object from a given Protocol's Message Pool.
+ * Allocate a Message object from a given Protocol's Message Pool, using the smallest size class
+ * that can hold a given payload.
  *
  * @return A pointer to the (uninitialized) Message object memory.
  */
 //--------------------------------------------------------------------------------------------------
 UnixMessage_t *msgProto_AllocMessage
 (
-    le_msg_ProtocolRef_t protocolRef
+    le_msg_ProtocolRef_t protocolRef,
+    size_t payloadSize
 )
 //--------------------------------------------------------------------------------------------------
 {
-    // Allocate a Message object from this Protocol's Message Pool.
-    return le_mem_ForceAlloc(protocolRef->messagePoolRef);
+    if (payloadSize > protocolRef->maxPayloadSize)
+    {
+        payloadSize = protocolRef->maxPayloadSize;
+    }
+
+    // Allocate a Message object from this Protocol's Message Pool.  The pool is the smallest size
+    // class; larger requests are satisfied from its parent pools.
+    return le_mem_ForceVarAlloc(protocolRef->messagePoolRef, sizeof(UnixMessage_t) + payloadSize);
 }
 
 
@@ -233,3 +243,28 @@ size_t le_msg_GetProtocolMaxMsgSize
 {
     return protocolRef->maxPayloadSize;
 }
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets the table of message names for a protocol.  The table is indexed by the message ID found in
+ * the first 32 bits of each request payload, and is only used to label per-message call statistics.
+ *
+ * @note The table is not copied, so it must remain valid for as long as the protocol is in use.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_msg_SetProtocolMsgNames
+(
+    le_msg_ProtocolRef_t protocolRef,   ///< [in] Reference to the protocol.
+    const char* const*   namesPtr,      ///< [in] Message names, indexed by message ID.
+    size_t               nameCount      ///< [in] Number of entries in the table.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LOCK
+
+    protocolRef->msgNamesPtr = namesPtr;
+    protocolRef->msgNameCount = (namesPtr == NULL) ? 0 : nameCount;
+
+    UNLOCK
+}
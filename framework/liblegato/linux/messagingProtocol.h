@@ -21,7 +21,9 @@ typedef struct le_msg_Protocol
     le_sls_Link_t link;                     ///< Used to link this into the Protocol List.
     char id[LIMIT_MAX_PROTOCOL_ID_BYTES];   ///< Unique identifier for the protocol.
     size_t maxPayloadSize;                  ///< Max payload size (in bytes) in this protocol.
-    le_mem_PoolRef_t messagePoolRef;        ///< Pool of Message objects.
+    le_mem_PoolRef_t messagePoolRef;        ///< Pool of Message objects (smallest size class).
+    const char* const* msgNamesPtr;         ///< Message names indexed by message ID (or NULL).
+    size_t msgNameCount;                    ///< Number of entries in msgNamesPtr.
 }
 msgProtocol_Protocol_t;
 
@@ -40,14 +42,16 @@ void msgProto_Init
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Allocate a Message object from a given Protocol's Message Pool.
+ * Allocate a Message object from a given Protocol's Message Pool, using the smallest size class
+ * that can hold a given payload.
  *
  * @return A pointer to the (uninitialized) Message object memory.
  */
 //--------------------------------------------------------------------------------------------------
 UnixMessage_t *msgProto_AllocMessage
 (
-    le_msg_ProtocolRef_t protocolRef
+    le_msg_ProtocolRef_t protocolRef,
+    size_t payloadSize
 );
 
 
@@ -17,6 +17,7 @@
 #include "messagingProtocol.h"
 #include "messagingMessage.h"
 #include "messagingLocal.h"
+#include "messagingStats.h"
 #include "fileDescriptor.h"
 
 
@@ -1530,6 +1531,41 @@ static void TriggerDeferredProcessing
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Deletes a server-side session on behalf of another thread.  Queued to the thread that owns the
+ * session by CloseSessionCommon().
+ *
+ * @note    This function is called by the Event Loop as a "queued function".
+ *          That's why the parameter list looks unusual.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DeleteSessionQueued
+(
+    void* param1Ptr,    ///< [IN] Pointer to a Session object.
+    void* param2Ptr     ///< not used
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_UNUSED(param2Ptr);
+
+    msgSession_UnixSession_t* sessionPtr = param1Ptr;
+
+    // The client may have hung up, or the service may have been removed (see CloseAllSessions()
+    // in messagingInterface.c), in the meantime.  The latter can happen on any thread, so the
+    // state must be checked and the session deleted while holding the Interface Mutex.
+    msgInterface_Lock();
+    if (sessionPtr->state != LE_MSG_SESSION_STATE_CLOSED)
+    {
+        DeleteSession(sessionPtr, true);
+    }
+    msgInterface_Unlock();
+
+    // Release the reference taken when this function was queued.
+    le_mem_Release(sessionPtr);
+}
+
+
 // =======================================
 //  PROTECTED (INTER-MODULE) FUNCTIONS
 // =======================================
@@ -1702,6 +1738,9 @@ le_msg_MessageRef_t msgSession_DoSyncRequestResponse
     // Create an ID for this transaction.
     CreateTxnId(msgRef);
 
+    uint32_t statsMsgId = msgStats_GetMsgId(msgRef);
+    uint64_t statsStartUs = msgStats_GetTimestamp();
+
     // Put the socket into blocking mode.
     fd_SetBlocking(unixSessionPtr->socketFd);
 
@@ -1750,6 +1789,11 @@ le_msg_MessageRef_t msgSession_DoSyncRequestResponse
     // Invalidate the ID for this transaction.
     DeleteTxnId(msgRef);
 
+    if (rxMsgRef != NULL)
+    {
+        msgStats_Record(unixSessionPtr->interfaceRef, statsMsgId, statsStartUs);
+    }
+
     // Don't need the request message anymore.
     le_msg_ReleaseMsg(msgRef);
 
@@ -1778,6 +1822,25 @@ le_msg_InterfaceRef_t msgSession_GetInterfaceRef
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fetches the thread that owns a given Session object.  Only this thread may send messages
+ * through the session.
+ *
+ * @return  The thread reference.
+ */
+//--------------------------------------------------------------------------------------------------
+le_thread_Ref_t msgSession_GetThreadRef
+(
+    le_msg_SessionRef_t sessionRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    msgSession_UnixSession_t* unixSessionPtr = msgSession_GetUnixSessionPtr(sessionRef);
+    return unixSessionPtr->threadRef;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Gets a pointer to the list link inside of a Session object.  This is used to link the
@@ -2351,7 +2414,21 @@ static void CloseSessionCommon
             // On the server side, sessions are automatically deleted when they close.
             if (unixSessionPtr->interfaceRef->interfaceType == LE_MSG_INTERFACE_SERVER)
             {
-                DeleteSession(unixSessionPtr, mutexLocked);
+                // A server that handles requests on worker threads may close a client's session
+                // from one of them (e.g., using LE_KILL_CLIENT()), so hand the deletion over to
+                // the thread that owns the session.
+                if ((!mutexLocked) && (le_thread_GetCurrent() != unixSessionPtr->threadRef))
+                {
+                    le_mem_AddRef(unixSessionPtr);
+                    le_event_QueueFunctionToThread(unixSessionPtr->threadRef,
+                                                   DeleteSessionQueued,
+                                                   unixSessionPtr,
+                                                   NULL);
+                }
+                else
+                {
+                    DeleteSession(unixSessionPtr, mutexLocked);
+                }
             }
             else if (unixSessionPtr->state != LE_MSG_SESSION_STATE_CLOSED)
             {
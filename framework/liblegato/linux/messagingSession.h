@@ -165,6 +165,20 @@ le_msg_InterfaceRef_t msgSession_GetInterfaceRef
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fetches the thread that owns a given Session object.  Only this thread may send messages
+ * through the session.
+ *
+ * @return  The thread reference.
+ */
+//--------------------------------------------------------------------------------------------------
+le_thread_Ref_t msgSession_GetThreadRef
+(
+    le_msg_SessionRef_t sessionRef
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Gets a pointer to the list link inside of a Session object.  This is used to link the
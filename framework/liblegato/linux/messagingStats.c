@@ -0,0 +1,243 @@
+/** @file messagingStats.c
+ *
+ * Implements the per-interface, per-message "Call Statistics" of the Legato @ref c_messaging.
+ *
+ * Records are created the first time a message ID completes a transaction on an interface, and are
+ * kept on that interface's callStatsList until the interface is destroyed.  Updating a record is a
+ * short list walk and a handful of additions under a mutex, so this is always enabled.
+ *
+ * See @ref messaging.c for the overall subsystem design.
+ *
+ * @warning The code in this file @b must be thread safe and re-entrant.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "messagingStats.h"
+
+
+// =======================================
+//  PRIVATE DATA
+// =======================================
+
+/// Number of statistics records expected in a single process.
+#define MAX_EXPECTED_RECORDS    64
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool from which statistics records are allocated.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t RecordPoolRef;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A counter that increments every time a record is added to or removed from any interface.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t RecordListChangeCount = 0;
+static size_t* RecordListChangeCountRef = &RecordListChangeCount;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mutex used to protect data structures in this module from multi-threaded race conditions.
+ *
+ * @note This is a pthreads FAST mutex, chosen to minimize overhead.  It is non-recursive.
+ */
+//--------------------------------------------------------------------------------------------------
+static pthread_mutex_t Mutex = PTHREAD_MUTEX_INITIALIZER;
+#define LOCK    LE_ASSERT(pthread_mutex_lock(&Mutex) == 0);
+#define UNLOCK  LE_ASSERT(pthread_mutex_unlock(&Mutex) == 0);
+
+
+// =======================================
+//  PRIVATE FUNCTIONS
+// =======================================
+
+//--------------------------------------------------------------------------------------------------
+// Emit definition for inline functions
+//
+// See messagingStats.h for body and documentation
+//--------------------------------------------------------------------------------------------------
+LE_DEFINE_INLINE size_t msgStats_GetBucketIndex(uint32_t latencyUs);
+LE_DEFINE_INLINE uint32_t msgStats_GetBucketLowerBound(size_t bucketIndex);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets an interface's record for a given message ID, creating it if it doesn't exist yet.
+ *
+ * @return  Pointer to the record.
+ *
+ * @warning Assumes that the Mutex is locked.
+ */
+//--------------------------------------------------------------------------------------------------
+static msgStats_Record_t* GetRecord
+(
+    msgInterface_Interface_t* interfacePtr,
+    uint32_t msgId
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_sls_Link_t* linkPtr = le_sls_Peek(&interfacePtr->callStatsList);
+
+    while (linkPtr != NULL)
+    {
+        msgStats_Record_t* recordPtr = CONTAINER_OF(linkPtr, msgStats_Record_t, link);
+
+        if (recordPtr->msgId == msgId)
+        {
+            return recordPtr;
+        }
+
+        linkPtr = le_sls_PeekNext(&interfacePtr->callStatsList, linkPtr);
+    }
+
+    msgStats_Record_t* recordPtr = le_mem_ForceAlloc(RecordPoolRef);
+    memset(recordPtr, 0, sizeof(*recordPtr));
+    recordPtr->link = LE_SLS_LINK_INIT;
+    recordPtr->msgId = msgId;
+
+    RecordListChangeCount++;
+    le_sls_Queue(&interfacePtr->callStatsList, &recordPtr->link);
+
+    return recordPtr;
+}
+
+
+// =======================================
+//  PROTECTED (INTER-MODULE) FUNCTIONS
+// =======================================
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Exposing the statistics record list change counter; mainly for the Inspect tool.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t** msgStats_GetRecordListChgCntRef
+(
+    void
+)
+{
+    return (&RecordListChangeCountRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initializes the module.  This must be called only once at start-up, before any other functions in
+ * that module are called.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgStats_Init
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    RecordPoolRef = le_mem_CreatePool("MessagingCallStats", sizeof(msgStats_Record_t));
+    le_mem_ExpandPool(RecordPoolRef, MAX_EXPECTED_RECORDS);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the current time to use as the start of a transaction.
+ *
+ * @return  Relative time in microseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+uint64_t msgStats_GetTimestamp
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_clk_Time_t now = le_clk_GetRelativeTime();
+
+    return ((uint64_t)now.sec * 1000000) + now.usec;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the message ID that a request message's statistics are accounted under.
+ *
+ * @return  The message ID, or MSG_STATS_OTHER_MSG_ID.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t msgStats_GetMsgId
+(
+    le_msg_MessageRef_t msgRef  ///< [IN] Request message.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint32_t msgId;
+
+    if (le_msg_GetMaxPayloadSize(msgRef) < sizeof(msgId))
+    {
+        return MSG_STATS_OTHER_MSG_ID;
+    }
+
+    memcpy(&msgId, le_msg_GetPayloadPtr(msgRef), sizeof(msgId));
+
+    return (msgId <= MSG_STATS_MAX_MSG_ID) ? msgId : MSG_STATS_OTHER_MSG_ID;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Account for a completed transaction.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgStats_Record
+(
+    msgInterface_Interface_t* interfacePtr, ///< [IN] Interface the transaction went through.
+    uint32_t msgId,                         ///< [IN] Message ID from msgStats_GetMsgId().
+    uint64_t startUs                        ///< [IN] Start time from msgStats_GetTimestamp().
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint64_t elapsedUs = msgStats_GetTimestamp() - startUs;
+    uint32_t latencyUs = (elapsedUs > UINT32_MAX) ? UINT32_MAX : (uint32_t)elapsedUs;
+
+    LOCK
+
+    msgStats_Record_t* recordPtr = GetRecord(interfacePtr, msgId);
+
+    recordPtr->count++;
+    recordPtr->totalUs += latencyUs;
+    if (latencyUs > recordPtr->maxUs)
+    {
+        recordPtr->maxUs = latencyUs;
+    }
+    recordPtr->buckets[msgStats_GetBucketIndex(latencyUs)]++;
+
+    UNLOCK
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release all the statistics records of an interface.  Called when the interface is destroyed.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgStats_DeleteRecords
+(
+    msgInterface_Interface_t* interfacePtr  ///< [IN] Interface being destroyed.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_sls_Link_t* linkPtr;
+
+    LOCK
+
+    while ((linkPtr = le_sls_Pop(&interfacePtr->callStatsList)) != NULL)
+    {
+        RecordListChangeCount++;
+        le_mem_Release(CONTAINER_OF(linkPtr, msgStats_Record_t, link));
+    }
+
+    UNLOCK
+}
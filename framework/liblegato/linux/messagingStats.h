@@ -0,0 +1,178 @@
+/** @file messagingStats.h
+ *
+ * Inter-module definitions exported by the Call Statistics module of the @ref c_messaging
+ * implementation.
+ *
+ * Every request-response transaction is counted per interface and per message ID (the first 32 bits
+ * of the request payload), together with a log-linear histogram of its latency.  The records hang
+ * off the Interface objects so that the Inspect tool can read them from the process' memory.
+ *
+ * See @ref messaging.c for an overview of the @ref c_messaging implementation.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#ifndef LE_MESSAGING_STATS_H_INCLUDE_GUARD
+#define LE_MESSAGING_STATS_H_INCLUDE_GUARD
+
+#include "messagingInterface.h"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of latency histogram buckets.  Buckets 0 and 1 hold 0 and 1 microseconds; above that,
+ * each power-of-two octave is split into two buckets.  The last bucket (~12.5 s and up) also
+ * holds everything that is larger.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MSG_STATS_BUCKET_COUNT      48
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Largest message ID that gets its own record.  Anything larger (most likely a protocol that does
+ * not start its payload with a message ID) is accounted under MSG_STATS_OTHER_MSG_ID.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MSG_STATS_MAX_MSG_ID        255
+#define MSG_STATS_OTHER_MSG_ID      UINT32_MAX
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Call statistics for one message ID of one interface.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct msgStats_Record
+{
+    le_sls_Link_t link;         ///< Link in the Interface object's callStatsList.
+    uint32_t msgId;             ///< Message ID, or MSG_STATS_OTHER_MSG_ID.
+    uint32_t maxUs;             ///< Longest latency seen, in microseconds.
+    uint64_t count;             ///< Number of completed transactions.
+    uint64_t totalUs;           ///< Sum of all latencies, in microseconds.
+    uint32_t buckets[MSG_STATS_BUCKET_COUNT];   ///< Latency histogram.
+}
+msgStats_Record_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the histogram bucket that a latency falls into.
+ *
+ * @return  The bucket index.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_DECLARE_INLINE size_t msgStats_GetBucketIndex
+(
+    uint32_t latencyUs  ///< [IN] Latency in microseconds.
+)
+{
+    if (latencyUs < 2)
+    {
+        return latencyUs;
+    }
+
+    // Octave is the position of the most significant bit, and the next bit down selects the
+    // lower or upper half of the octave.
+    size_t octave = 31 - __builtin_clz(latencyUs);
+    size_t index = (2 * octave) + ((latencyUs >> (octave - 1)) & 1);
+
+    return (index < MSG_STATS_BUCKET_COUNT) ? index : (MSG_STATS_BUCKET_COUNT - 1);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the smallest latency that falls into a histogram bucket.
+ *
+ * @return  The latency in microseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_DECLARE_INLINE uint32_t msgStats_GetBucketLowerBound
+(
+    size_t bucketIndex  ///< [IN] Bucket index.
+)
+{
+    if (bucketIndex < 2)
+    {
+        return bucketIndex;
+    }
+
+    return (uint32_t)(2 + (bucketIndex & 1)) << ((bucketIndex / 2) - 1);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initializes the module.  This must be called only once at start-up, before any other functions in
+ * that module are called.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgStats_Init
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the current time to use as the start of a transaction.
+ *
+ * @return  Relative time in microseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+uint64_t msgStats_GetTimestamp
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the message ID that a request message's statistics are accounted under.
+ *
+ * @return  The message ID, or MSG_STATS_OTHER_MSG_ID.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t msgStats_GetMsgId
+(
+    le_msg_MessageRef_t msgRef  ///< [IN] Request message.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Account for a completed transaction.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgStats_Record
+(
+    msgInterface_Interface_t* interfacePtr, ///< [IN] Interface the transaction went through.
+    uint32_t msgId,                         ///< [IN] Message ID from msgStats_GetMsgId().
+    uint64_t startUs                        ///< [IN] Start time from msgStats_GetTimestamp().
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release all the statistics records of an interface.  Called when the interface is destroyed.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgStats_DeleteRecords
+(
+    msgInterface_Interface_t* interfacePtr  ///< [IN] Interface being destroyed.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Exposing the statistics record list change counter; mainly for the Inspect tool.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t** msgStats_GetRecordListChgCntRef
+(
+    void
+);
+
+
+#endif // LE_MESSAGING_STATS_H_INCLUDE_GUARD
@@ -332,6 +332,427 @@ static void MakeRuleStr
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the buffer that batched rules are accumulated in.  The kernel takes at most a page (minus
+ * one byte) of rules per write to the load file.
+ */
+//--------------------------------------------------------------------------------------------------
+#define RULE_BATCH_BYTES                    4000
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Expected number of subject/object pairs that rules are set for.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LOADED_RULE_CAPACITY                256
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Subject label used to check whether the kernel accepts several rules per write.
+ */
+//--------------------------------------------------------------------------------------------------
+#define PROBE_LABEL                         "le.smackProbe"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Rule that has been loaded into the kernel by this process, or that is in the batch buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    char labels[SMACK_RULE_STR_BYTES];      ///< "<subject> <object>".  Key in LoadedRules.
+    char mode[MAX_ACCESS_MODE_BYTES];       ///< Access mode, as written to the load file.
+    bool isPending;                         ///< true if only in the batch buffer, not written yet.
+}
+LoadedRule_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Batch of rules that are being accumulated, to be written to the kernel together.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    bool isOpen;                            ///< true if a batch has been started.
+    pthread_t thread;                       ///< Thread that started the batch.
+    int loadFd;                             ///< Load file, kept open for the batch.
+    char buffer[RULE_BATCH_BYTES];          ///< Rules not written yet, one per line.
+    size_t len;                             ///< Number of bytes used in the buffer.
+    size_t ruleCount;                       ///< Number of rules loaded for the batch.
+    size_t skipCount;                       ///< Number of rules that were loaded already.
+    size_t writeCount;                      ///< Number of writes to the load file.
+    le_clk_Time_t startTime;                ///< Time the batch was started.
+}
+RuleBatch_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Whether the kernel accepts several rules in one write to the load file (Linux 4.2 and later).
+ */
+//--------------------------------------------------------------------------------------------------
+static enum
+{
+    RULE_LISTS_UNKNOWN,
+    RULE_LISTS_SUPPORTED,
+    RULE_LISTS_UNSUPPORTED
+}
+RuleListSupport = RULE_LISTS_UNKNOWN;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mutex protecting the batch and the loaded rules.
+ */
+//--------------------------------------------------------------------------------------------------
+static pthread_mutex_t Mutex = PTHREAD_MUTEX_INITIALIZER;   // POSIX "Fast" mutex.
+
+/// Locks the mutex.
+#define LOCK    LE_ASSERT(pthread_mutex_lock(&Mutex) == 0);
+
+/// Unlocks the mutex.
+#define UNLOCK  LE_ASSERT(pthread_mutex_unlock(&Mutex) == 0);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Current rule batch.
+ */
+//--------------------------------------------------------------------------------------------------
+static RuleBatch_t Batch = { .isOpen = false, .loadFd = -1 };
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Rules loaded by this process since it started, keyed by subject and object labels, so that
+ * setting a rule that is already in place doesn't cost a write to the kernel.  Created on first
+ * use.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t LoadedRules;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool of LoadedRule_t objects.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t LoadedRulePool;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Opens the SMACK load file for writing.
+ *
+ * @return
+ *      File descriptor of the load file.
+ *
+ * @note If there's an error, this function will kill the calling process.
+ */
+//--------------------------------------------------------------------------------------------------
+static int OpenLoadFile
+(
+    void
+)
+{
+    int fd;
+
+    do
+    {
+        fd = open(SMACK_LOAD_FILE, O_WRONLY | O_CLOEXEC);
+    }
+    while ( (fd == -1) && (errno == EINTR) );
+
+    LE_FATAL_IF(fd == -1, "Could not open %s.  %m.\n", SMACK_LOAD_FILE);
+
+    return fd;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes rules to the SMACK load file.
+ *
+ * @return
+ *      Number of writes made.
+ *
+ * @note If there's an error, this function will kill the calling process.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t WriteRules
+(
+    int fd,                         ///< [IN] Load file.
+    const char* rulesPtr,           ///< [IN] Rules.  Several rules must be separated by new lines.
+    size_t rulesLen                 ///< [IN] Number of bytes of rules.
+)
+{
+    size_t writeCount = 0;
+    size_t offset = 0;
+
+    // The kernel may stop at the end of any rule.
+    while (offset < rulesLen)
+    {
+        ssize_t numBytes;
+
+        do
+        {
+            numBytes = write(fd, rulesPtr + offset, rulesLen - offset);
+        }
+        while ( (numBytes == -1) && (errno == EINTR) );
+
+        LE_FATAL_IF(numBytes <= 0, "Could not write SMACK rules '%.*s'.  %m.",
+                    (int)(rulesLen - offset), rulesPtr + offset);
+
+        offset += numBytes;
+        writeCount++;
+    }
+
+    return writeCount;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes a label to the SMACK revoke file.
+ *
+ * @note If there's an error, this function will kill the calling process.
+ */
+//--------------------------------------------------------------------------------------------------
+static void WriteRevokeSubject
+(
+    const char* subjectLabelPtr     ///< [IN] Subject label.
+)
+{
+    // Open the SMACK revoke file.
+    int fd;
+
+    do
+    {
+        fd = open(SMACK_REVOKE_FILE, O_WRONLY);
+    }
+    while ( (fd == -1) && (errno == EINTR) );
+
+    LE_FATAL_IF(fd == -1, "Could not open %s.  %m.\n", SMACK_REVOKE_FILE);
+
+    // Write the label to the SMACK revoke file.
+    int numBytes = 0;
+
+    do
+    {
+        numBytes = write(fd, subjectLabelPtr, strlen(subjectLabelPtr));
+    }
+    while ( (numBytes == -1) && (errno == EINTR) );
+
+    LE_FATAL_IF(numBytes < 0, "Could not revoke SMACK label '%s'.  %m.", subjectLabelPtr);
+
+    fd_Close(fd);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks whether the kernel accepts several rules in one write to the load file, by loading two
+ * rules for a probe label in one write and checking that the second one is in place.  Older
+ * kernels only take the first rule and ignore the rest of the write.
+ *
+ * @return
+ *      true if several rules can be written at once.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool CanWriteRuleLists
+(
+    int loadFd                      ///< [IN] Load file.
+)
+{
+    static const char probeRules[] = PROBE_LABEL " " PROBE_LABEL ".1 r----\n"
+                                     PROBE_LABEL " " PROBE_LABEL ".2 r----\n";
+    ssize_t numBytes;
+
+    do
+    {
+        numBytes = write(loadFd, probeRules, sizeof(probeRules) - 1);
+    }
+    while ( (numBytes == -1) && (errno == EINTR) );
+
+    bool isSupported = (numBytes == sizeof(probeRules) - 1) &&
+                       smack_HasAccess(PROBE_LABEL, "r", PROBE_LABEL ".2");
+
+    WriteRevokeSubject(PROBE_LABEL);
+
+    LE_DEBUG("Kernel %s several SMACK rules per write.", isSupported ? "accepts" : "doesn't accept");
+
+    return isSupported;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the loaded rule with the labels of a rule.  If there is none, one with no access mode is
+ * created.
+ *
+ * Must be called with the mutex locked.
+ *
+ * @return
+ *      The loaded rule.
+ */
+//--------------------------------------------------------------------------------------------------
+static LoadedRule_t* GetLoadedRule
+(
+    const char* rulePtr             ///< [IN] Rule, as made by MakeRuleStr().
+)
+{
+    if (LoadedRules == NULL)
+    {
+        LoadedRulePool = le_mem_CreatePool("SmackLoadedRules", sizeof(LoadedRule_t));
+        LoadedRules = le_hashmap_Create("SmackLoadedRules",
+                                        LOADED_RULE_CAPACITY,
+                                        le_hashmap_HashString,
+                                        le_hashmap_EqualsString);
+    }
+
+    // The rule ends with a space and the access mode, which is always MAX_ACCESS_MODE_LEN long.
+    size_t labelsLen = strlen(rulePtr) - MAX_ACCESS_MODE_LEN - 1;
+
+    char labels[SMACK_RULE_STR_BYTES];
+    memcpy(labels, rulePtr, labelsLen);
+    labels[labelsLen] = '\0';
+
+    LoadedRule_t* loadedRulePtr = le_hashmap_Get(LoadedRules, labels);
+
+    if (loadedRulePtr == NULL)
+    {
+        loadedRulePtr = le_mem_ForceAlloc(LoadedRulePool);
+        memcpy(loadedRulePtr->labels, labels, labelsLen + 1);
+        loadedRulePtr->mode[0] = '\0';
+        loadedRulePtr->isPending = false;
+        le_hashmap_Put(LoadedRules, loadedRulePtr->labels, loadedRulePtr);
+    }
+
+    return loadedRulePtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Forgets all the loaded rules of a subject.
+ *
+ * Must be called with the mutex locked.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ForgetLoadedRules
+(
+    const char* subjectLabelPtr     ///< [IN] Subject label.
+)
+{
+    if (LoadedRules == NULL)
+    {
+        return;
+    }
+
+    size_t subjectLen = strlen(subjectLabelPtr);
+
+    // Entries can't be removed while iterating, so restart after each removal.  Subjects are only
+    // revoked when apps stop, and each process only loads a few hundred rules.
+    LoadedRule_t* foundPtr;
+
+    do
+    {
+        foundPtr = NULL;
+
+        le_hashmap_It_Ref_t iterRef = le_hashmap_GetIterator(LoadedRules);
+
+        while (le_hashmap_NextNode(iterRef) == LE_OK)
+        {
+            LoadedRule_t* loadedRulePtr = le_hashmap_GetValue(iterRef);
+
+            if ( (strncmp(loadedRulePtr->labels, subjectLabelPtr, subjectLen) == 0) &&
+                 (loadedRulePtr->labels[subjectLen] == ' ') )
+            {
+                foundPtr = loadedRulePtr;
+                break;
+            }
+        }
+
+        if (foundPtr != NULL)
+        {
+            le_hashmap_Remove(LoadedRules, foundPtr->labels);
+            le_mem_Release(foundPtr);
+        }
+    }
+    while (foundPtr != NULL);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes the rules accumulated in the batch to the kernel, and marks them as loaded.
+ *
+ * Must be called with the mutex locked.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FlushBatch
+(
+    void
+)
+{
+    if (Batch.len > 0)
+    {
+        Batch.writeCount += WriteRules(Batch.loadFd, Batch.buffer, Batch.len);
+        Batch.len = 0;
+
+        // Only rules in the buffer are pending, so there are none left.
+        le_hashmap_It_Ref_t iterRef = le_hashmap_GetIterator(LoadedRules);
+
+        while (le_hashmap_NextNode(iterRef) == LE_OK)
+        {
+            ((LoadedRule_t*)le_hashmap_GetValue(iterRef))->isPending = false;
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds a rule to the batch.  The rule is written right away if the kernel only accepts one rule
+ * per write, or if the batch is full.
+ *
+ * Must be called with the mutex locked.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddToBatch
+(
+    const char* rulePtr,            ///< [IN] Rule, as made by MakeRuleStr().
+    LoadedRule_t* loadedRulePtr     ///< [IN] Loaded rule for the rule's labels.
+)
+{
+    size_t ruleLen = strlen(rulePtr);
+
+    Batch.ruleCount++;
+
+    if (RuleListSupport != RULE_LISTS_SUPPORTED)
+    {
+        Batch.writeCount += WriteRules(Batch.loadFd, rulePtr, ruleLen);
+        return;
+    }
+
+    if (Batch.len + ruleLen + 1 > sizeof(Batch.buffer))
+    {
+        FlushBatch();
+    }
+
+    memcpy(Batch.buffer + Batch.len, rulePtr, ruleLen);
+    Batch.len += ruleLen;
+    Batch.buffer[Batch.len++] = '\n';
+
+    loadedRulePtr->isPending = true;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Shows whether SMACK is enabled or disabled in the Legato Framework.
@@ -570,32 +991,130 @@ void smack_SetRule
     char rule[SMACK_RULE_STR_BYTES];
     MakeRuleStr(subjectLabelPtr, accessModePtr, objectLabelPtr, rule, sizeof(rule));
 
-    // Open the SMACK load file.
-    int fd;
+    LOCK
 
-    do
+    bool inBatch = Batch.isOpen && pthread_equal(Batch.thread, pthread_self());
+    LoadedRule_t* loadedRulePtr = GetLoadedRule(rule);
+    const char* modePtr = rule + strlen(loadedRulePtr->labels) + 1;
+
+    // A rule in another thread's batch is not in effect yet.  Load that batch first, so this
+    // thread doesn't skip the rule before it is in the kernel, and so rules for the same labels
+    // are loaded in the order they were set.
+    if (loadedRulePtr->isPending && !inBatch)
     {
-        fd = open(SMACK_LOAD_FILE, O_WRONLY);
+        FlushBatch();
     }
-    while ( (fd == -1) && (errno == EINTR) );
 
-    LE_FATAL_IF(fd == -1, "Could not open %s.  %m.\n", SMACK_LOAD_FILE);
+    if (strcmp(loadedRulePtr->mode, modePtr) == 0)
+    {
+        if (inBatch)
+        {
+            Batch.skipCount++;
+        }
+    }
+    else
+    {
+        LE_ASSERT(le_utf8_Copy(loadedRulePtr->mode, modePtr, sizeof(loadedRulePtr->mode), NULL)
+                  == LE_OK);
 
-    // Write the rule to the SMACK load file.
-    int numBytes = 0;
-    size_t ruleLength = strlen(rule);
+        if (inBatch)
+        {
+            AddToBatch(rule, loadedRulePtr);
+        }
+        else
+        {
+            // Write the rule to the SMACK load file.
+            int fd = OpenLoadFile();
+            WriteRules(fd, rule, strlen(rule));
+            fd_Close(fd);
+        }
+    }
 
-    do
+    UNLOCK
+
+    LE_DEBUG("Set SMACK rule '%s'.", rule);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Starts a batch of SMACK rules.  Until smack_CommitRuleBatch() is called, rules set by the calling
+ * thread with smack_SetRule() are accumulated and loaded into the kernel with as few writes as
+ * possible, so they may not be in effect until then.
+ *
+ * Only one thread can have a batch at a time.  Rules set by other threads in the meantime are
+ * loaded right away, as are rules set by a thread that calls this while another one has a batch.
+ *
+ * @note If there's an error, this function will kill the calling process.
+ */
+//--------------------------------------------------------------------------------------------------
+void smack_StartRuleBatch
+(
+    void
+)
+{
+    LOCK
+
+    if (!Batch.isOpen)
     {
-        numBytes = write(fd, rule, ruleLength);
+        Batch.isOpen = true;
+        Batch.thread = pthread_self();
+        Batch.loadFd = OpenLoadFile();
+        Batch.len = 0;
+        Batch.ruleCount = 0;
+        Batch.skipCount = 0;
+        Batch.writeCount = 0;
+        Batch.startTime = le_clk_GetRelativeTime();
+
+        if (RuleListSupport == RULE_LISTS_UNKNOWN)
+        {
+            RuleListSupport = CanWriteRuleLists(Batch.loadFd) ? RULE_LISTS_SUPPORTED :
+                                                                RULE_LISTS_UNSUPPORTED;
+        }
+    }
+    else
+    {
+        LE_FATAL_IF(pthread_equal(Batch.thread, pthread_self()),
+                    "SMACK rule batch already started by this thread.");
     }
-    while ( (numBytes == -1) && (errno == EINTR) );
 
-    LE_FATAL_IF(numBytes != ruleLength, "Could not write SMACK rule '%s'.  %m.", rule);
+    UNLOCK
+}
 
-    fd_Close(fd);
 
-    LE_DEBUG("Set SMACK rule '%s'.", rule);
+//--------------------------------------------------------------------------------------------------
+/**
+ * Loads the rules of the calling thread's batch into the kernel, and ends the batch.  Does
+ * nothing if the calling thread has no batch.
+ *
+ * @note If there's an error, this function will kill the calling process.
+ */
+//--------------------------------------------------------------------------------------------------
+void smack_CommitRuleBatch
+(
+    void
+)
+{
+    LOCK
+
+    if (Batch.isOpen && pthread_equal(Batch.thread, pthread_self()))
+    {
+        FlushBatch();
+
+        fd_Close(Batch.loadFd);
+        Batch.loadFd = -1;
+        Batch.isOpen = false;
+
+        le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), Batch.startTime);
+
+        LE_DEBUG("Loaded %zu SMACK rules (%zu already loaded) in %zu writes, %ld us.",
+                 Batch.ruleCount,
+                 Batch.skipCount,
+                 Batch.writeCount,
+                 (long)(elapsed.sec * 1000000 + elapsed.usec));
+    }
+
+    UNLOCK
 }
 
 
@@ -672,29 +1191,19 @@ void smack_RevokeSubject
     const char* subjectLabelPtr     ///< [IN] Subject label.
 )
 {
-    // Open the SMACK revoke file.
-    int fd;
+    LOCK
 
-    do
+    // Rules of this subject that are still batched must be loaded first, to be revoked as well.
+    if (Batch.isOpen)
     {
-        fd = open(SMACK_REVOKE_FILE, O_WRONLY);
+        FlushBatch();
     }
-    while ( (fd == -1) && (errno == EINTR) );
 
-    LE_FATAL_IF(fd == -1, "Could not open %s.  %m.\n", SMACK_REVOKE_FILE);
+    WriteRevokeSubject(subjectLabelPtr);
 
-    // Write the label to the SMACK revoke file.
-    int numBytes = 0;
+    ForgetLoadedRules(subjectLabelPtr);
 
-    do
-    {
-        numBytes = write(fd, subjectLabelPtr, strlen(subjectLabelPtr));
-    }
-    while ( (numBytes == -1) && (errno == EINTR) );
-
-    LE_FATAL_IF(numBytes < 0, "Could not revoke SMACK label '%s'.  %m.", subjectLabelPtr);
-
-    fd_Close(fd);
+    UNLOCK
 
     LE_DEBUG("Revoked SMACK label '%s'.", subjectLabelPtr);
 }
@@ -1055,6 +1564,34 @@ void smack_SetRule
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Starts a batch of SMACK rules.  Until smack_CommitRuleBatch() is called, rules set by the calling
+ * thread with smack_SetRule() are accumulated and loaded into the kernel with as few writes as
+ * possible.
+ */
+//--------------------------------------------------------------------------------------------------
+void smack_StartRuleBatch
+(
+    void
+)
+{
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Loads the rules of the calling thread's batch into the kernel, and ends the batch.
+ */
+//--------------------------------------------------------------------------------------------------
+void smack_CommitRuleBatch
+(
+    void
+)
+{
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Checks whether a subject has the specified access mode for an object.
@@ -63,6 +63,11 @@
  * Use smack_SetRule() to set an explicit SMACK rule that gives a specified subject access to a
  * specified object.
  *
+ * Setting many rules at once, as the Supervisor does when it starts an app, is cheaper between
+ * smack_StartRuleBatch() and smack_CommitRuleBatch(): the rules are then loaded into the kernel
+ * together, in as few writes as possible.  Rules that the calling process has already set (and
+ * not revoked since) are not loaded again.
+ *
  * Copyright (C) Sierra Wireless Inc.
  */
 
@@ -206,6 +211,38 @@ void smack_SetRule
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Starts a batch of SMACK rules.  Until smack_CommitRuleBatch() is called, rules set by the calling
+ * thread with smack_SetRule() are accumulated and loaded into the kernel with as few writes as
+ * possible, so they may not be in effect until then.
+ *
+ * Only one thread can have a batch at a time.  Rules set by other threads in the meantime are
+ * loaded right away, as are rules set by a thread that calls this while another one has a batch.
+ *
+ * @note If there is an error this function will kill the calling process.
+ */
+//--------------------------------------------------------------------------------------------------
+void smack_StartRuleBatch
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Loads the rules of the calling thread's batch into the kernel, and ends the batch.  Does nothing
+ * if the calling thread has no batch.
+ *
+ * @note If there is an error this function will kill the calling process.
+ */
+//--------------------------------------------------------------------------------------------------
+void smack_CommitRuleBatch
+(
+    void
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Checks whether a subject has the specified access mode for an object.
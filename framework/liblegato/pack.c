@@ -62,6 +62,33 @@ LE_DEFINE_INLINE bool le_pack_UnpackArrayHeader(uint8_t **bufferPtr,
                                              size_t *arrayCountPtr,
                                              size_t arrayMaxCount);
 
+#ifndef LE_CONFIG_RPC
+LE_DEFINE_INLINE bool le_pack_PackVarUint16(uint8_t** bufferPtr, uint16_t value);
+LE_DEFINE_INLINE bool le_pack_PackVarUint32(uint8_t** bufferPtr, uint32_t value);
+LE_DEFINE_INLINE bool le_pack_PackVarUint64(uint8_t** bufferPtr, uint64_t value);
+LE_DEFINE_INLINE bool le_pack_PackVarInt16(uint8_t** bufferPtr, int16_t value);
+LE_DEFINE_INLINE bool le_pack_PackVarInt32(uint8_t** bufferPtr, int32_t value);
+LE_DEFINE_INLINE bool le_pack_PackVarInt64(uint8_t** bufferPtr, int64_t value);
+LE_DEFINE_INLINE bool le_pack_PackVarSize(uint8_t **bufferPtr, size_t value);
+LE_DEFINE_INLINE bool le_pack_PackVarResult(uint8_t** bufferPtr, le_result_t value);
+LE_DEFINE_INLINE bool le_pack_PackVarOnOff(uint8_t** bufferPtr, le_onoff_t value);
+LE_DEFINE_INLINE bool le_pack_PackVarString(uint8_t** bufferPtr,
+                                            const char *stringPtr,
+                                            uint32_t maxStringCount);
+LE_DEFINE_INLINE bool le_pack_UnpackVarUint16(uint8_t** bufferPtr, uint16_t* valuePtr);
+LE_DEFINE_INLINE bool le_pack_UnpackVarUint32(uint8_t** bufferPtr, uint32_t* valuePtr);
+LE_DEFINE_INLINE bool le_pack_UnpackVarUint64(uint8_t** bufferPtr, uint64_t* valuePtr);
+LE_DEFINE_INLINE bool le_pack_UnpackVarInt16(uint8_t** bufferPtr, int16_t* valuePtr);
+LE_DEFINE_INLINE bool le_pack_UnpackVarInt32(uint8_t** bufferPtr, int32_t* valuePtr);
+LE_DEFINE_INLINE bool le_pack_UnpackVarInt64(uint8_t** bufferPtr, int64_t* valuePtr);
+LE_DEFINE_INLINE bool le_pack_UnpackVarSize(uint8_t **bufferPtr, size_t* valuePtr);
+LE_DEFINE_INLINE bool le_pack_UnpackVarResult(uint8_t** bufferPtr, le_result_t* valuePtr);
+LE_DEFINE_INLINE bool le_pack_UnpackVarOnOff(uint8_t** bufferPtr, le_onoff_t* valuePtr);
+LE_DEFINE_INLINE bool le_pack_UnpackVarString(uint8_t** bufferPtr,
+                                              char *stringPtr,
+                                              uint32_t bufferSize,
+                                              uint32_t maxStringCount);
+#endif
 #ifdef LE_CONFIG_RPC
 LE_DEFINE_INLINE bool le_pack_PackTagID(uint8_t** bufferPtr, TagID_t value);
 LE_DEFINE_INLINE bool le_pack_PackTaggedUint8(uint8_t** bufferPtr, uint8_t value, TagID_t tagId);
@@ -287,6 +287,28 @@ le_msg_MessageRef_t le_msg_CreateMsg
     return msgLocal_CreateMsg(sessionRef);
 }
 
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates a message to be sent over a given session, with a payload buffer only large enough to
+ * hold a given number of bytes.
+ *
+ * @return  Message reference.
+ *
+ * @note Local messages are always allocated at the service's maximum message size.
+ */
+//--------------------------------------------------------------------------------------------------
+le_msg_MessageRef_t le_msg_CreateSizedMsg
+(
+    le_msg_SessionRef_t sessionRef, ///< [in] Reference to the session.
+    size_t payloadSize              ///< [in] Bytes of payload the message needs to hold.
+)
+{
+    LE_UNUSED(payloadSize);
+
+    return msgLocal_CreateMsg(sessionRef);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Adds to the reference count on a message object.
@@ -523,7 +523,8 @@ ApiServerInterface_t::ApiServerInterface_t
 :   ApiRef_t(itemPtr, aPtr, cPtr, iName),
     async(isAsync),
     manualStart(false),
-    direct(false)
+    direct(false),
+    workerCount(0)
 //--------------------------------------------------------------------------------------------------
 {
 }
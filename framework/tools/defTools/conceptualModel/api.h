@@ -197,6 +197,7 @@ struct ApiServerInterface_t : public ApiRef_t
     bool manualStart;   ///< true = generated main() should not call AdvertiseService() function.
     bool direct;       ///< true = API can be called directly from other components within
                        ///<        the same process.
+    unsigned int workerCount;   ///< Number of worker threads processing requests (0 = none).
 
     ApiServerInterface_t(const parseTree::TokenList_t* itemPtr,
                          ApiFile_t* aPtr, Component_t* cPtr, const std::string& iName, bool async);
@@ -78,6 +78,9 @@ struct App_t : public HasTargetInfo_t
     /// Set of the names of groups that this application's user should be a member of.
     std::set<std::string> groups;
 
+    /// Set of the names of apps that must be started before this one at system start-up.
+    std::set<std::string> startAfter;
+
     // Per-user limits:
     PositiveIntLimit_t      cpuShare;           ///< Relative share value
     NonNegativeIntLimit_t   maxFileSystemBytes; ///< Total bytes in sandbox tmpfs file system.
@@ -2067,6 +2067,13 @@ model::App_t* GetApp
         {
             SetStart(appPtr, ToSimpleSectionPtr(sectionPtr));
         }
+        else if (sectionName == "startAfter")
+        {
+            for (auto tokenPtr : ToTokenListSectionPtr(sectionPtr)->Contents())
+            {
+                appPtr->startAfter.insert(tokenPtr->text);
+            }
+        }
         else if (sectionName == "version")
         {
             // Get the label
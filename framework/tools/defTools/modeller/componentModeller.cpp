@@ -516,6 +516,7 @@ static void GetProvidedApi
     bool async = false;
     bool manualStart = false;
     bool direct = false;
+    unsigned int workerCount = 0;
     for (auto contentPtr : contentList)
     {
         if (contentPtr->type == parseTree::Token_t::SERVER_IPC_OPTION)
@@ -532,6 +533,11 @@ static void GetProvidedApi
             {
                 direct = true;
             }
+            else if (contentPtr->text.compare(0, 9, "[workers=") == 0)
+            {
+                // The lexer has already checked that this is "[workers=N]", with N > 0.
+                workerCount = std::stoul(contentPtr->text.substr(9));
+            }
         }
     }
 
@@ -558,6 +564,7 @@ static void GetProvidedApi
                                                  async);
     ifPtr->manualStart = manualStart;
     ifPtr->direct = direct;
+    ifPtr->workerCount = workerCount;
 
     componentPtr->serverApis.push_back(ifPtr);
 
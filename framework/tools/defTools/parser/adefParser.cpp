@@ -656,6 +656,10 @@ static parseTree::CompoundItem_t* ParseSection
     {
         return ParseSimpleSection(lexer, sectionNameTokenPtr, parseTree::Token_t::NAME);
     }
+    else if (sectionName == "startAfter")
+    {
+        return ParseTokenListSection(lexer, sectionNameTokenPtr, parseTree::Token_t::NAME);
+    }
     else if (sectionName == "version")
     {
         return ParseSimpleSection(lexer, sectionNameTokenPtr, parseTree::Token_t::FILE_NAME);
@@ -1581,6 +1581,35 @@ void Lexer_t::PullFilePermissions
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether an IPC option is a worker thread count option (e.g., "[workers=4]").
+ *
+ * @return true if the option is "[workers=N]", where N is a decimal integer greater than zero.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsWorkersIpcOption
+(
+    const std::string& option
+)
+//--------------------------------------------------------------------------------------------------
+{
+    static const std::string prefix = "[workers=";
+
+    if (   (option.compare(0, prefix.length(), prefix) != 0)
+        || (option.length() < prefix.length() + 2)
+        || (option.back() != ']') )
+    {
+        return false;
+    }
+
+    auto countStr = option.substr(prefix.length(), option.length() - prefix.length() - 1);
+
+    return (   (countStr.find_first_not_of("0123456789") == std::string::npos)
+            && (countStr.find_first_not_of('0') != std::string::npos) );
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Pull a server-side IPC option (e.g., "[manual-start]") from the file and store it in the token.
@@ -1597,7 +1626,8 @@ void Lexer_t::PullServerIpcOption
     // Check that it's one of the valid server-side options.
     if (   (tokenPtr->text != "[manual-start]")
            && (tokenPtr->text != "[async]")
-           && (tokenPtr->text != "[direct]"))
+           && (tokenPtr->text != "[direct]")
+           && !IsWorkersIpcOption(tokenPtr->text) )
     {
         ThrowException(
             mk::format(LE_I18N("Invalid server-side IPC option: '%s'"), tokenPtr->text)
@@ -1664,7 +1694,10 @@ void Lexer_t::PullIpcOption
         {
             ThrowException(LE_I18N("Unexpected end-of-file before end of IPC option."));
         }
-        else if ((context.top().nextChars[0] != '-') && !islower(context.top().nextChars[0]))
+        else if (   (context.top().nextChars[0] != '-')
+                 && (context.top().nextChars[0] != '=')
+                 && !islower(context.top().nextChars[0])
+                 && !isdigit(context.top().nextChars[0]) )
         {
             UnexpectedChar(LE_I18N("Unexpected character %s inside option."));
         }
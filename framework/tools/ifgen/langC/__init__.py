@@ -22,6 +22,17 @@ def AddLangArgumentGroup(parser):
                         action='store_true',
                         default=False,
                         help='allow in-place function calls')
+    parser.add_argument('--compact-encoding',
+                        dest="compactEncoding",
+                        action='store_true',
+                        default=False,
+                        help='use variable-length encoding for integers and strings')
+    parser.add_argument('--server-workers',
+                        dest="serverWorkers",
+                        type=int,
+                        default=0,
+                        metavar='COUNT',
+                        help='process server requests on a pool of COUNT worker threads')
 
 # Custom filters needed for C templates
 Filters = { 'DecorateName':        codeGenHelpers.DecorateName,
@@ -39,7 +50,8 @@ Filters = { 'DecorateName':        codeGenHelpers.DecorateName,
             'UnpackFunction':        codeGenHelpers.GetUnpackFunction,
             'CAPIParameters':        codeGenHelpers.IterCAPIParameters,
             'MaxCOutputBuffers':     codeGenHelpers.GetMaxCOutputBuffers,
-            'LocalMessageSize':      codeGenHelpers.GetLocalMessageSize}
+            'LocalMessageSize':      codeGenHelpers.GetLocalMessageSize,
+            'RequestMessageSize':    codeGenHelpers.GetRequestMessageSize}
 
 
 Tests = { 'SizeParameter':         codeGenHelpers.IsSizeParameter }
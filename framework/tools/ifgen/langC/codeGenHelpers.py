@@ -314,6 +314,27 @@ _PackFunctionMapping = {
     interfaceIR.ONOFF_TYPE:  "le_pack_%sOnOff",
 }
 
+# Types which have a variable-length encoding when the interface is built with compact encoding.
+# All other types keep the fixed-width encoding from _PackFunctionMapping.
+_CompactPackFunctionMapping = {
+    interfaceIR.UINT16_TYPE: "le_pack_%sVarUint16",
+    interfaceIR.UINT32_TYPE: "le_pack_%sVarUint32",
+    interfaceIR.UINT64_TYPE: "le_pack_%sVarUint64",
+    interfaceIR.INT16_TYPE:  "le_pack_%sVarInt16",
+    interfaceIR.INT32_TYPE:  "le_pack_%sVarInt32",
+    interfaceIR.INT64_TYPE:  "le_pack_%sVarInt64",
+    interfaceIR.SIZE_TYPE:   "le_pack_%sVarSize",
+    interfaceIR.STRING_TYPE: "le_pack_%sVarString",
+    interfaceIR.RESULT_TYPE: "le_pack_%sVarResult",
+    interfaceIR.ONOFF_TYPE:  "le_pack_%sVarOnOff",
+}
+
+def _GetBasicPackFunction(context, apiType, direction):
+    args = context.get('args')
+    if getattr(args, 'compactEncoding', False) and apiType in _CompactPackFunctionMapping:
+        return _CompactPackFunctionMapping[apiType] % (direction, )
+    return _PackFunctionMapping[apiType] % (direction, )
+
 @contextfilter
 def GetPackFunction(context, apiType):
     if isinstance(apiType, interfaceIR.ReferenceType):
@@ -323,7 +344,7 @@ def GetPackFunction(context, apiType):
          isinstance(apiType, interfaceIR.StructType):
         return "{}_Pack{}".format(apiType.iface.baseName, apiType.name)
     else:
-        return _PackFunctionMapping[apiType] % ("Pack", )
+        return _GetBasicPackFunction(context, apiType, "Pack")
 
 @contextfilter
 def GetUnpackFunction(context, apiType):
@@ -334,7 +355,7 @@ def GetUnpackFunction(context, apiType):
          isinstance(apiType, interfaceIR.StructType):
         return "{}_Unpack{}".format(apiType.iface.baseName, apiType.name)
     else:
-        return _PackFunctionMapping[apiType] % ("Unpack", )
+        return _GetBasicPackFunction(context, apiType, "Unpack")
 
 def EscapeString(string):
     return string.encode('string_escape').replace('"', '\\"')
@@ -374,6 +395,29 @@ def GetLocalMessageSize(interface, pointerSize):
                     for handler in interface.types.values()
                     if isinstance(handler, interfaceIR.HandlerType)])
 
+@contextfilter
+def GetRequestMessageSize(context, item):
+    """
+    Get size of the message needed to send a function request or handler call.
+
+    A request is 4-bytes for message ID, 4 bytes for required output parameters (or the handler
+    context reference), and the packed input parameters.  Falls back to the full message size when
+    packing is not bounded per message (RPC tags, local service pointers), or when the request is
+    as big as the largest message anyway.
+    """
+    args = context.get('args')
+    if (os.environ.get('LE_CONFIG_RPC') == "y") or getattr(args, 'localService', False):
+        return "sizeof(_Message_t)"
+
+    size = 8 + sum([parameter.GetMaxSize(interfaceIR.DIR_IN) for parameter in item.parameters])
+    if getattr(args, 'compactEncoding', False):
+        size += (size + 1) // 2
+
+    if size >= 4 + context.get('messageSize'):
+        return "sizeof(_Message_t)"
+
+    return str(size)
+
 def GetCOutputBufferCount(function):
     outputCount = 0
     for parameter in function.parameters:
@@ -79,6 +79,21 @@ static le_mem_PoolRef_t _ClientThreadDataPool;
 //--------------------------------------------------------------------------------------------------
 static pthread_key_t _ThreadDataKey;
 
+{%- if not args.localService and functions %}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function names, indexed by message ID.  Used to label the IPC call statistics.
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* const _MsgNames[] =
+{
+    {%- for function in functions %}
+    "{{function.name}}",
+    {%- endfor %}
+};
+{%- endif %}
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -130,6 +145,9 @@ static le_result_t InitClientForThread
     le_msg_ProtocolRef_t protocolRef;
 
     protocolRef = le_msg_GetProtocolRef(PROTOCOL_ID_STR, sizeof(_Message_t));
+    {%- if functions %}
+    le_msg_SetProtocolMsgNames(protocolRef, _MsgNames, NUM_ARRAY_MEMBERS(_MsgNames));
+    {%- endif %}
     sessionRef = le_msg_CreateSession(protocolRef, SERVICE_INSTANCE_NAME);
 {%- endif %}
     le_result_t result = ifgen_{{apiBaseName}}_OpenSession(sessionRef, isBlocking);
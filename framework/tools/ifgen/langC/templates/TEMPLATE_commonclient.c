@@ -385,7 +385,7 @@ LE_SHARED {{function.returnType|FormatType(useBaseName=True)}} ifgen_{{apiBaseNa
 
 
     // Create a new message object and get the message buffer
-    _msgRef = le_msg_CreateMsg(_ifgen_sessionRef);
+    _msgRef = le_msg_CreateSizedMsg(_ifgen_sessionRef, {{function|RequestMessageSize}});
     _msgPtr = le_msg_GetPayloadPtr(_msgRef);
     _msgPtr->id = _MSGID_{{apiBaseName}}_{{function.name}};
     _msgBufPtr = _msgPtr->buffer;
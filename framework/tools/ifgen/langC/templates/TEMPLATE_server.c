@@ -8,6 +8,7 @@
  #  Copyright (C) Sierra Wireless Inc.
  #}
 {% import 'pack.templ' as pack with context -%}
+{% set serverWorkers = 0 if args.localService else args.serverWorkers -%}
 /*
  * ====================== WARNING ======================
  *
@@ -147,6 +148,20 @@ LE_REF_DEFINE_STATIC_MAP({{apiName}}_ServerHandlers,
  */
 //--------------------------------------------------------------------------------------------------
 static le_ref_MapRef_t _HandlerRefMap;
+{%- if not args.localService and functions %}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function names, indexed by message ID.  Used to label the IPC call statistics.
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* const _MsgNames[] =
+{
+    {%- for function in functions %}
+    "{{function.name}}",
+    {%- endfor %}
+};
+{%- endif %}
 {%- if args.async %}
 
 //--------------------------------------------------------------------------------------------------
@@ -172,6 +187,96 @@ __attribute__((unused)) static pthread_mutex_t _Mutex = PTHREAD_MUTEX_INITIALIZE
 
 /// Unlocks the mutex.
 #define _UNLOCK  LE_ASSERT(pthread_mutex_unlock(&_Mutex) == 0);
+{%- if serverWorkers %}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of worker threads that process client requests.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SERVER_WORKER_COUNT     {{serverWorkers}}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Worker thread object.
+ *
+ * A worker processes one request at a time.  Only the server thread changes the session reference.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_thread_Ref_t     threadRef;      ///< The worker thread.
+    le_msg_SessionRef_t sessionRef;     ///< Session of the request being processed; NULL if idle.
+}
+_ServerWorker_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The worker threads.
+ */
+//--------------------------------------------------------------------------------------------------
+static _ServerWorker_t _ServerWorkers[SERVER_WORKER_COUNT];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * True once the worker threads have been started.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool _ServerWorkersStarted = false;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function called on each worker thread when it starts, and its context pointer.
+ */
+//--------------------------------------------------------------------------------------------------
+static {{apiName}}_WorkerInitFunc_t _WorkerInitFunc = NULL;
+static void* _WorkerInitContextPtr = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Request that is waiting for a worker thread.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_dls_Link_t       link;           ///< Link in _PendingRequestList.
+    le_msg_MessageRef_t msgRef;         ///< The request message.
+}
+_PendingRequest_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Expected number of requests waiting for a worker thread.
+ */
+//--------------------------------------------------------------------------------------------------
+#define HIGH_PENDING_REQUEST_COUNT  (2 * SERVER_WORKER_COUNT)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Static pool for pending requests
+ */
+//--------------------------------------------------------------------------------------------------
+LE_MEM_DEFINE_STATIC_POOL({{apiName}}_PendingRequest,
+                          HIGH_PENDING_REQUEST_COUNT,
+                          sizeof(_PendingRequest_t));
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The memory pool for pending requests
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t _PendingRequestPool;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Requests waiting for a worker thread, oldest first.
+ *
+ * @warning Only accessed by the server thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_dls_List_t _PendingRequestList = LE_DLS_LIST_INIT;
+{%- endif %}
 
 
 //--------------------------------------------------------------------------------------------------
@@ -282,6 +387,25 @@ __attribute__((unused)) static void CleanupClientData
     LE_CDATA_THIS->_ClientSessionRef = 0;
 
     _UNLOCK
+    {%- if serverWorkers %}
+
+    // Drop the client's requests that haven't been given to a worker yet; nobody is waiting for
+    // their responses any more.
+    le_dls_Link_t* linkPtr = le_dls_Peek(&_PendingRequestList);
+
+    while ( linkPtr != NULL )
+    {
+        _PendingRequest_t* requestPtr = CONTAINER_OF(linkPtr, _PendingRequest_t, link);
+        linkPtr = le_dls_PeekNext(&_PendingRequestList, linkPtr);
+
+        if ( le_msg_GetSession(requestPtr->msgRef) == sessionRef )
+        {
+            le_dls_Remove(&_PendingRequestList, &requestPtr->link);
+            le_msg_ReleaseMsg(requestPtr->msgRef);
+            le_mem_Release(requestPtr);
+        }
+    }
+    {%- endif %}
 }
 
 
@@ -395,6 +519,16 @@ le_msg_SessionRef_t {{apiName}}_GetClientSessionRef
     void
 )
 {
+    {%- if serverWorkers %}
+    // On a worker thread, the current message is the one the worker is processing.
+    if ( le_thread_GetCurrent() != LE_CDATA_THIS->_ServerThreadRef )
+    {
+        le_msg_MessageRef_t msgRef = le_msg_GetServiceRxMsg();
+
+        return (msgRef != NULL) ? le_msg_GetSession(msgRef) : NULL;
+    }
+
+    {%- endif %}
     return LE_CDATA_THIS->_ClientSessionRef;
 }
 
@@ -432,12 +566,23 @@ void {{apiName}}_AdvertiseService
     // The size of the map should be based on the number of handlers defined for the server.
     _HandlerRefMap = le_ref_InitStaticMap({{apiName}}_ServerHandlers,
                         LE_MEM_BLOCKS({{apiName}}_ServerData, HIGH_SERVER_DATA_COUNT));
+    {%- if serverWorkers %}
+
+    // Create the pending request pool.  The worker threads are started when the first request is
+    // received, so that the worker init function can still be set from COMPONENT_INIT.
+    _PendingRequestPool = le_mem_InitStaticPool({{apiName}}_PendingRequest,
+                                                HIGH_PENDING_REQUEST_COUNT,
+                                                sizeof(_PendingRequest_t));
+    {%- endif %}
 
     // Start the server side of the service
     {%- if not args.localService %}
     le_msg_ProtocolRef_t protocolRef;
 
     protocolRef = le_msg_GetProtocolRef(PROTOCOL_ID_STR, sizeof(_Message_t));
+    {%- if functions %}
+    le_msg_SetProtocolMsgNames(protocolRef, _MsgNames, NUM_ARRAY_MEMBERS(_MsgNames));
+    {%- endif %}
     LE_CDATA_THIS->_ServerServiceRef = le_msg_CreateService(protocolRef, SERVICE_INSTANCE_NAME);
     {%- endif %}
     le_msg_SetServiceRecvHandler(LE_CDATA_THIS->_ServerServiceRef, ServerMsgRecvHandler, NULL);
@@ -565,7 +710,8 @@ static void AsyncResponse_{{apiName}}_{{function.name}}
     __attribute__((unused)) uint8_t* _msgBufPtr;
 
     // Create a new message object and get the message buffer
-    _msgRef = le_msg_CreateMsg(serverDataPtr->clientSessionRef);
+    _msgRef = le_msg_CreateSizedMsg(serverDataPtr->clientSessionRef,
+                                    {{handler.apiType|RequestMessageSize}});
     _msgPtr = le_msg_GetPayloadPtr(_msgRef);
     _msgPtr->id = _MSGID_{{apiBaseName}}_{{function.name}};
     _msgBufPtr = _msgPtr->buffer;
@@ -917,6 +1063,301 @@ error_unpack:
 }
 {%- endif %}
 {%- endfor %}
+{%- if serverWorkers %}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Dispatch a request to the appropriate message handler.
+ *
+ * Called on a worker thread, or on the server thread for requests that must run there, through
+ * le_msg_CallServiceRecvHandler().
+ */
+//--------------------------------------------------------------------------------------------------
+static void DispatchRequest
+(
+    le_msg_MessageRef_t msgRef,
+    void*               contextPtr
+)
+{
+    LE_UNUSED(contextPtr);
+
+    // Get the message payload so that we can get the message "id"
+    _Message_t* msgPtr = le_msg_GetPayloadPtr(msgRef);
+
+    // Dispatch to appropriate message handler and get response
+    switch (msgPtr->id)
+    {
+        {%- for function in functions %}
+        case _MSGID_{{apiBaseName}}_{{function.name}} :
+            Handle_{{apiName}}_{{function.name}}(msgRef);
+            break;
+        {%- endfor %}
+
+        default: LE_ERROR("Unknowm msg id = %" PRIu32 , msgPtr->id);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if a request must be processed on the server thread rather than on a worker thread.
+ *
+ * Handlers are added and removed on the server thread, so that they are called on the server
+ * thread as they would be without worker threads.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsServerThreadRequest
+(
+    le_msg_MessageRef_t msgRef
+)
+{
+    _Message_t* msgPtr = le_msg_GetPayloadPtr(msgRef);
+
+    switch (msgPtr->id)
+    {
+        {%- for function in functions if function is EventFunction %}
+        case _MSGID_{{apiBaseName}}_{{function.name}} :
+        {%- endfor %}
+        {%- if any(functions, "EventFunction") %}
+            return true;
+        {%- endif %}
+
+        default:
+            return false;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if a worker thread is processing a request from a given client session.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsSessionBusy
+(
+    le_msg_SessionRef_t sessionRef
+)
+{
+    int i;
+
+    for (i = 0; i < SERVER_WORKER_COUNT; i++)
+    {
+        if (_ServerWorkers[i].sessionRef == sessionRef)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get a worker thread that is not processing a request.
+ *
+ * @return The worker, or NULL if they are all busy.
+ */
+//--------------------------------------------------------------------------------------------------
+static _ServerWorker_t* GetIdleWorker
+(
+    void
+)
+{
+    int i;
+
+    for (i = 0; i < SERVER_WORKER_COUNT; i++)
+    {
+        if (_ServerWorkers[i].sessionRef == NULL)
+        {
+            return &_ServerWorkers[i];
+        }
+    }
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Forward declaration needed by ScheduleRequests
+ */
+//--------------------------------------------------------------------------------------------------
+static void ProcessRequest
+(
+    void* workerPtr,
+    void* msgRef
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Give the pending requests to the idle worker threads, oldest first.
+ *
+ * Requests from a session are processed one at a time and in the order they were received, so a
+ * request is skipped over while an earlier request from its session is still being processed.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ScheduleRequests
+(
+    void
+)
+{
+    le_dls_Link_t* linkPtr = le_dls_Peek(&_PendingRequestList);
+
+    while ( linkPtr != NULL )
+    {
+        _PendingRequest_t* requestPtr = CONTAINER_OF(linkPtr, _PendingRequest_t, link);
+        le_msg_MessageRef_t msgRef = requestPtr->msgRef;
+        le_msg_SessionRef_t sessionRef = le_msg_GetSession(msgRef);
+
+        linkPtr = le_dls_PeekNext(&_PendingRequestList, linkPtr);
+
+        if ( IsSessionBusy(sessionRef) )
+        {
+            continue;
+        }
+
+        if ( IsServerThreadRequest(msgRef) )
+        {
+            le_dls_Remove(&_PendingRequestList, &requestPtr->link);
+            le_mem_Release(requestPtr);
+
+            LE_CDATA_THIS->_ClientSessionRef = sessionRef;
+            le_msg_CallServiceRecvHandler(DispatchRequest, msgRef, NULL);
+            LE_CDATA_THIS->_ClientSessionRef = 0;
+
+            // The handler may have closed the session, and with it dropped pending requests.
+            linkPtr = le_dls_Peek(&_PendingRequestList);
+            continue;
+        }
+
+        _ServerWorker_t* workerPtr = GetIdleWorker();
+
+        if ( workerPtr == NULL )
+        {
+            // Leave the remaining requests queued until a worker becomes idle.
+            break;
+        }
+
+        le_dls_Remove(&_PendingRequestList, &requestPtr->link);
+        le_mem_Release(requestPtr);
+
+        workerPtr->sessionRef = sessionRef;
+        le_event_QueueFunctionToThread(workerPtr->threadRef, ProcessRequest, workerPtr, msgRef);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mark a worker thread idle and give it the next request, if any.
+ *
+ * @note This function is queued to the server thread by ProcessRequest().
+ */
+//--------------------------------------------------------------------------------------------------
+static void RequestDone
+(
+    void* workerPtr,        ///< [in] The worker.
+    void* unused            ///< [in] Not used
+)
+{
+    LE_UNUSED(unused);
+
+    ((_ServerWorker_t*)workerPtr)->sessionRef = NULL;
+
+    ScheduleRequests();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Process a request on a worker thread.
+ *
+ * @note This function is queued to the worker thread by ScheduleRequests().
+ */
+//--------------------------------------------------------------------------------------------------
+static void ProcessRequest
+(
+    void* workerPtr,        ///< [in] The worker.
+    void* msgRef            ///< [in] Reference to the request message.
+)
+{
+    le_msg_CallServiceRecvHandler(DispatchRequest, msgRef, NULL);
+
+    le_event_QueueFunctionToThread(LE_CDATA_THIS->_ServerThreadRef, RequestDone, workerPtr, NULL);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Main function of the worker threads.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* WorkerMain
+(
+    void* contextPtr
+)
+{
+    LE_UNUSED(contextPtr);
+
+    if ( _WorkerInitFunc != NULL )
+    {
+        _WorkerInitFunc(_WorkerInitContextPtr);
+    }
+
+    le_event_RunLoop();
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start the worker threads.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StartWorkers
+(
+    void
+)
+{
+    int i;
+
+    for (i = 0; i < SERVER_WORKER_COUNT; i++)
+    {
+        char threadName[24];
+
+        snprintf(threadName, sizeof(threadName), "{{apiName}}%d", i);
+
+        _ServerWorkers[i].sessionRef = NULL;
+        _ServerWorkers[i].threadRef = le_thread_Create(threadName, WorkerMain, NULL);
+        le_thread_Start(_ServerWorkers[i].threadRef);
+    }
+
+    _ServerWorkersStarted = true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the function called on each worker thread when it starts, before it processes any request.
+ */
+//--------------------------------------------------------------------------------------------------
+void {{apiName}}_SetWorkerInitHandler
+(
+    {{apiName}}_WorkerInitFunc_t initFunc,
+    void* contextPtr
+)
+{
+    LE_FATAL_IF(_ServerWorkersStarted,
+                "Worker init function set after the worker threads were started.");
+
+    _WorkerInitFunc = initFunc;
+    _WorkerInitContextPtr = contextPtr;
+}
+{%- endif %}
 
 
 static void ServerMsgRecvHandler
@@ -926,6 +1367,21 @@ static void ServerMsgRecvHandler
 )
 {
     LE_UNUSED(contextPtr);
+    {%- if serverWorkers %}
+
+    if ( !_ServerWorkersStarted )
+    {
+        StartWorkers();
+    }
+
+    // Queue the request for the worker threads.
+    _PendingRequest_t* requestPtr = le_mem_Alloc(_PendingRequestPool);
+    requestPtr->link = LE_DLS_LINK_INIT;
+    requestPtr->msgRef = msgRef;
+    le_dls_Queue(&_PendingRequestList, &requestPtr->link);
+
+    ScheduleRequests();
+    {%- else %}
 
     // Get the message payload so that we can get the message "id"
     _Message_t* msgPtr = le_msg_GetPayloadPtr(msgRef);
@@ -950,4 +1406,5 @@ static void ServerMsgRecvHandler
     // Clear the client session ref associated with the current message, since the message
     // has now been processed.
     LE_CDATA_THIS->_ClientSessionRef = 0;
+    {%- endif %}
 }
@@ -53,6 +53,33 @@ void {{apiName}}_AdvertiseService
 (
     void
 );
+{%- if args.serverWorkers and not args.localService %}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Prototype for the function called on each worker thread when it starts
+ */
+//--------------------------------------------------------------------------------------------------
+typedef void (*{{apiName}}_WorkerInitFunc_t)
+(
+    void* contextPtr    ///< [IN] Context pointer passed to {{apiName}}_SetWorkerInitHandler()
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set a function to be called on each worker thread when it starts, before it processes any
+ * request.  Use it to set up per-thread state, such as connections to other services.
+ *
+ * The worker threads are started when the first request is received, so this must be called
+ * before then, e.g. from COMPONENT_INIT.  It is a fatal error to call it later.
+ */
+//--------------------------------------------------------------------------------------------------
+void {{apiName}}_SetWorkerInitHandler
+(
+    {{apiName}}_WorkerInitFunc_t initFunc,  ///< [IN] Function to call; NULL for none.
+    void* contextPtr                        ///< [IN] Context pointer passed to the function.
+);
+{%- endif %}
 {%- endif %}
 {%- endblock %}
 {% block FunctionDeclaration %}
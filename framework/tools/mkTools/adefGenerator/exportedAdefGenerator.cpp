@@ -206,6 +206,20 @@ static void GenerateBasicInfo
 
         defStream << "}\n";
     }
+
+    if (!appPtr->startAfter.empty())
+    {
+        defStream << "\n"
+                     "startAfter:\n"
+                     "{\n";
+
+        for (auto const &appName : appPtr->startAfter)
+        {
+            defStream << "    " << appName << "\n";
+        }
+
+        defStream << "}\n";
+    }
 }
 
 
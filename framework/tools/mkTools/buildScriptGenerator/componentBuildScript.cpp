@@ -1433,6 +1433,10 @@ void ComponentBuildScriptGenerator_t::GenerateCBuildStatement
         {
             ifgenFlags += " --allow-direct";
         }
+        if (ifPtr->workerCount > 0)
+        {
+            ifgenFlags += " --server-workers=" + std::to_string(ifPtr->workerCount);
+        }
         ifgenFlags += " --name-prefix " + ifPtr->internalName;
         script << "build" << generatedFiles << ":"
                   " GenInterfaceCode " << ifPtr->apiFilePtr->path << " |";
@@ -120,6 +120,39 @@ static void GenerateGroupsConfig
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Generate the configuration for the list of apps that the Supervisor must start before this
+ * application at system start-up.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void GenerateStartAfterConfig
+(
+    std::ofstream& cfgStream,
+    const model::App_t* appPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // If the list is empty, nothing needs to be done.
+    if (appPtr->startAfter.empty())
+    {
+        return;
+    }
+
+    // App names are specified by inserting empty leaf nodes under the "startAfter" branch
+    // of the application's configuration tree.
+    cfgStream << "  \"startAfter\"" << std::endl;
+    cfgStream << "  {" << std::endl;
+
+    for (auto const &appName : appPtr->startAfter)
+    {
+        cfgStream << "    \"" << appName << "\" \"\"" << std::endl;
+    }
+
+    cfgStream << "  }" << std::endl << std::endl;
+}
+
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -926,6 +959,8 @@ void Generate
 
     GenerateGroupsConfig(cfgStream, appPtr);
 
+    GenerateStartAfterConfig(cfgStream, appPtr);
+
     GenerateFileMappingConfig(cfgStream, appPtr);
 
     GenerateProcessConfig(cfgStream, appPtr);
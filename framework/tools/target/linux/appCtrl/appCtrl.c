@@ -210,6 +210,7 @@ static void PrintHelp
         "    app status [<appName>]\n"
         "    app version <appName>\n"
         "    app info [<appName>]\n"
+        "    app startTimes [<appName>]\n"
         "    app runProc <appName> <procName> [options]\n"
         "    app runProc <appName> [<procName>] --exe=<exePath> [options]\n"
         "\n"
@@ -260,6 +261,12 @@ static void PrintHelp
         "       If no name is given, prints the information of all installed applications.\n"
         "       If a name is given, prints the information of the specified application.\n"
         "\n"
+        "    app startTimes [<appName>]\n"
+        "       Prints how long the last start of each installed application (or of the specified\n"
+        "       application) took, in milliseconds: waiting for the apps it depends on, setting up\n"
+        "       its sandbox, launching its processes, and in total.  For apps started on system\n"
+        "       start-up, the total is measured from when the Supervisor began starting apps.\n"
+        "\n"
         "    app runProc <appName> <procName> [options]\n"
         "       Runs a configured process inside an app using the process settings from the\n"
         "       configuration database.  If an exePath is provided as an option then the specified\n"
@@ -1289,6 +1296,58 @@ static void PrintAppVersion
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Prints the timings of the last start of an application.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PrintAppStartTimes
+(
+    const char* appNamePtr      ///< [IN] Application name to get the start times for.
+)
+{
+    uint32_t waitMs, sandboxMs, launchMs, totalMs;
+
+    le_appCtrl_ConnectService();
+
+    if (le_appCtrl_GetStartTimes(appNamePtr, &waitMs, &sandboxMs, &launchMs, &totalMs) == LE_OK)
+    {
+        printf("%-32s %8u %8u %8u %8u\n", appNamePtr, waitMs, sandboxMs, launchMs, totalMs);
+    }
+    else
+    {
+        printf("%-32s %8s %8s %8s %8s\n", appNamePtr, "-", "-", "-", "-");
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Implements the "startTimes" command.
+ *
+ * @note This function does not return.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void PrintStartTimes
+(
+    void
+)
+{
+    printf("%-32s %8s %8s %8s %8s\n", "APP (ms)", "WAIT", "SANDBOX", "LAUNCH", "TOTAL");
+
+    if (AppNamePtr == NULL)
+    {
+        ListInstalledApps(PrintAppStartTimes);
+    }
+    else
+    {
+        PrintAppStartTimes(AppNamePtr);
+    }
+
+    exit(EXIT_SUCCESS);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * A handler that is called when the application process exits.
@@ -1934,6 +1993,14 @@ static void CommandArgHandler
         le_arg_AddPositionalCallback(AppNameArgHandler);
         le_arg_AllowLessPositionalArgsThanCallbacks();
     }
+    else if (strcmp(command, "startTimes") == 0)
+    {
+        CommandFunc = PrintStartTimes;
+
+        // Accept an optional app name argument.
+        le_arg_AddPositionalCallback(AppNameArgHandler);
+        le_arg_AllowLessPositionalArgsThanCallbacks();
+    }
     else
     {
         fprintf(stderr, "Unknown command '%s'.  Try --help.\n", command);
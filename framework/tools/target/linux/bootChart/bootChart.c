@@ -0,0 +1,383 @@
+/** @file bootChart.c
+ *
+ * Boot chart tool.  Renders the timeline of the last framework start, as recorded in the boot
+ * trace buffer (see bootTrace.h), either as text or as Chrome trace event JSON that can be loaded
+ * into chrome://tracing or Perfetto.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "bootTrace.h"
+
+#include <sys/mman.h>
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Events copied out of the trace buffer, sorted by time.
+ */
+//--------------------------------------------------------------------------------------------------
+static bootTrace_Event_t Events[BOOT_TRACE_MAX_EVENTS];
+static size_t EventCount = 0;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * true if the boot was still in progress when the buffer was read.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsInProgress = false;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * true if the output should be Chrome trace event JSON instead of text.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsJson = false;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Prints help to stdout and exits.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PrintHelp
+(
+    void
+)
+{
+    puts(
+        "NAME:\n"
+        "    bootchart - Shows the timeline of the last framework start.\n"
+        "\n"
+        "SYNOPSIS:\n"
+        "    bootchart [--json]\n"
+        "\n"
+        "DESCRIPTION:\n"
+        "    bootchart\n"
+        "       Prints the framework start-up events as a text timeline.  Each activity is shown\n"
+        "       with its start time, relative to the first event, and its duration.\n"
+        "\n"
+        "    bootchart --json\n"
+        "       Prints the events as Chrome trace event JSON, for chrome://tracing or Perfetto.\n"
+        "\n"
+        "    bootchart -h\n"
+        "    bootchart --help\n"
+        "       Prints this help text.\n"
+        "\n"
+        );
+
+    exit(EXIT_SUCCESS);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Orders events by time, and events with the same time in the order they were recorded.
+ */
+//--------------------------------------------------------------------------------------------------
+static int CompareEvents
+(
+    const void* aPtr,
+    const void* bPtr
+)
+{
+    const bootTrace_Event_t* aEventPtr = aPtr;
+    const bootTrace_Event_t* bEventPtr = bPtr;
+
+    if (aEventPtr->timeNs != bEventPtr->timeNs)
+    {
+        return (aEventPtr->timeNs < bEventPtr->timeNs) ? -1 : 1;
+    }
+
+    return (aEventPtr->seq < bEventPtr->seq) ? -1 : (aEventPtr->seq > bEventPtr->seq);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copy the complete events out of the trace buffer and sort them.  Exits if there is no trace.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReadEvents
+(
+    void
+)
+{
+    int fd = open(BOOT_TRACE_PATH, O_RDONLY | O_CLOEXEC);
+
+    if (fd == -1)
+    {
+        fprintf(stderr, "No boot trace available (%s: %m).\n", BOOT_TRACE_PATH);
+        exit(EXIT_FAILURE);
+    }
+
+    struct stat fileStat;
+    const bootTrace_Buffer_t* bufferPtr = MAP_FAILED;
+
+    if ((fstat(fd, &fileStat) == 0) && (fileStat.st_size >= (off_t)sizeof(bootTrace_Buffer_t)))
+    {
+        bufferPtr = mmap(NULL, sizeof(bootTrace_Buffer_t), PROT_READ, MAP_SHARED, fd, 0);
+    }
+
+    close(fd);
+
+    if (bufferPtr == MAP_FAILED)
+    {
+        fprintf(stderr, "Could not read the boot trace '%s'.\n", BOOT_TRACE_PATH);
+        exit(EXIT_FAILURE);
+    }
+
+    if ((__atomic_load_n(&bufferPtr->magic, __ATOMIC_ACQUIRE) != BOOT_TRACE_MAGIC) ||
+        (bufferPtr->maxEvents != BOOT_TRACE_MAX_EVENTS))
+    {
+        fprintf(stderr, "'%s' is not a valid boot trace.\n", BOOT_TRACE_PATH);
+        exit(EXIT_FAILURE);
+    }
+
+    IsInProgress = (__atomic_load_n(&bufferPtr->isComplete, __ATOMIC_ACQUIRE) == 0);
+
+    uint32_t nextIndex = __atomic_load_n(&bufferPtr->nextIndex, __ATOMIC_ACQUIRE);
+    uint32_t index = (nextIndex > BOOT_TRACE_MAX_EVENTS) ? (nextIndex - BOOT_TRACE_MAX_EVENTS) : 0;
+
+    for (; index < nextIndex; index++)
+    {
+        const bootTrace_Event_t* slotPtr = &bufferPtr->events[index % BOOT_TRACE_MAX_EVENTS];
+
+        // Skip events that are still being written, and ones that get overwritten while they
+        // are being copied.
+        if (__atomic_load_n(&slotPtr->seq, __ATOMIC_ACQUIRE) != index + 1)
+        {
+            continue;
+        }
+
+        Events[EventCount] = *slotPtr;
+
+        // Keep the copy above from being reordered after the check below, which pairs with the
+        // release fence the writer issues after unpublishing the slot.
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+        if (__atomic_load_n(&slotPtr->seq, __ATOMIC_RELAXED) != index + 1)
+        {
+            continue;
+        }
+
+        Events[EventCount].process[sizeof(Events[EventCount].process) - 1] = '\0';
+        Events[EventCount].name[sizeof(Events[EventCount].name) - 1] = '\0';
+        EventCount++;
+    }
+
+    munmap((void*)bufferPtr, sizeof(bootTrace_Buffer_t));
+
+    qsort(Events, EventCount, sizeof(Events[0]), CompareEvents);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Find the end event that matches a begin event.
+ *
+ * @return  Pointer to the end event, or NULL if the activity never ended.
+ */
+//--------------------------------------------------------------------------------------------------
+static const bootTrace_Event_t* FindEnd
+(
+    size_t beginIndex           ///< [IN] Index of the begin event in Events[].
+)
+{
+    const bootTrace_Event_t* beginPtr = &Events[beginIndex];
+    size_t i;
+
+    for (i = beginIndex + 1; i < EventCount; i++)
+    {
+        const bootTrace_Event_t* eventPtr = &Events[i];
+
+        if ((eventPtr->phase == BOOT_TRACE_END) &&
+            (eventPtr->pid == beginPtr->pid) &&
+            (eventPtr->tid == beginPtr->tid) &&
+            (strcmp(eventPtr->name, beginPtr->name) == 0))
+        {
+            return eventPtr;
+        }
+    }
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Print the events as a text timeline.  End events are folded into the duration of their begin
+ * event.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PrintText
+(
+    void
+)
+{
+    printf("%10s %10s  %-15s %13s  %s\n", "START(ms)", "TIME(ms)", "PROCESS", "PID/TID", "EVENT");
+
+    size_t i;
+
+    for (i = 0; i < EventCount; i++)
+    {
+        const bootTrace_Event_t* eventPtr = &Events[i];
+        char durationStr[16] = "-";
+        char idStr[24];
+
+        if (eventPtr->phase == BOOT_TRACE_END)
+        {
+            continue;
+        }
+
+        if (eventPtr->phase == BOOT_TRACE_BEGIN)
+        {
+            const bootTrace_Event_t* endPtr = FindEnd(i);
+
+            if (endPtr != NULL)
+            {
+                snprintf(durationStr, sizeof(durationStr), "%.3f",
+                         (endPtr->timeNs - eventPtr->timeNs) / 1000000.0);
+            }
+            else
+            {
+                le_utf8_Copy(durationStr, "?", sizeof(durationStr), NULL);
+            }
+        }
+
+        snprintf(idStr, sizeof(idStr), "%d/%d", eventPtr->pid, eventPtr->tid);
+
+        printf("%10.3f %10s  %-15s %13s  %s\n",
+               (eventPtr->timeNs - Events[0].timeNs) / 1000000.0,
+               durationStr,
+               eventPtr->process,
+               idStr,
+               eventPtr->name);
+    }
+
+    if (EventCount > 0)
+    {
+        printf("\n%zu events over %.3f ms.\n",
+               EventCount, (Events[EventCount - 1].timeNs - Events[0].timeNs) / 1000000.0);
+    }
+
+    if (IsInProgress)
+    {
+        printf("The framework start is still in progress.\n");
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Print a string as a JSON string literal.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PrintJsonString
+(
+    const char* strPtr
+)
+{
+    putchar('"');
+
+    for (; *strPtr != '\0'; strPtr++)
+    {
+        unsigned char c = *strPtr;
+
+        if ((c == '"') || (c == '\\'))
+        {
+            printf("\\%c", c);
+        }
+        else if (c < 0x20)
+        {
+            printf("\\u%04x", c);
+        }
+        else
+        {
+            putchar(c);
+        }
+    }
+
+    putchar('"');
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Print the events in the Chrome trace event format.  Each process gets a process_name metadata
+ * event so the viewer shows process names instead of bare PIDs.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PrintJson
+(
+    void
+)
+{
+    const char* separatorPtr = "\n";
+    size_t i;
+
+    printf("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+
+    for (i = 0; i < EventCount; i++)
+    {
+        const bootTrace_Event_t* eventPtr = &Events[i];
+        size_t j;
+
+        // Name each process the first time it appears.
+        for (j = 0; (j < i) && (Events[j].pid != eventPtr->pid); j++) {}
+
+        if (j == i)
+        {
+            printf("%s{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":",
+                   separatorPtr, eventPtr->pid);
+            PrintJsonString(eventPtr->process);
+            printf("}}");
+            separatorPtr = ",\n";
+        }
+
+        printf("%s{\"name\":", separatorPtr);
+        PrintJsonString(eventPtr->name);
+        printf(",\"cat\":");
+        PrintJsonString(eventPtr->process);
+        printf(",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":%d,\"tid\":%d",
+               eventPtr->phase,
+               (eventPtr->timeNs - Events[0].timeNs) / 1000.0,
+               eventPtr->pid,
+               eventPtr->tid);
+
+        if (eventPtr->phase == BOOT_TRACE_MARK)
+        {
+            printf(",\"s\":\"g\"");
+        }
+
+        printf("}");
+        separatorPtr = ",\n";
+    }
+
+    printf("\n]}\n");
+}
+
+
+COMPONENT_INIT
+{
+    le_arg_SetFlagCallback(PrintHelp, "h", "help");
+    le_arg_SetFlagVar(&IsJson, NULL, "json");
+
+    le_arg_Scan();
+
+    ReadEvents();
+
+    if (IsJson)
+    {
+        PrintJson();
+    }
+    else
+    {
+        PrintText();
+    }
+
+    exit(EXIT_SUCCESS);
+}
@@ -17,6 +17,7 @@
 #include "messagingInterface.h"
 #include "messagingProtocol.h"
 #include "messagingSession.h"
+#include "messagingStats.h"
 #include "limit.h"
 #include "addr.h"
 #include "fileDescriptor.h"
@@ -72,6 +73,7 @@ typedef struct ServiceObjIter*      ServiceObjIter_Ref_t;
 typedef struct ClientObjIter*       ClientObjIter_Ref_t;
 typedef struct SessionObjIter*      SessionObjIter_Ref_t;
 typedef struct InterfaceObjIter*    InterfaceObjIter_Ref_t;
+typedef struct CallStatsIter*       CallStatsIter_Ref_t;
 
 
 //--------------------------------------------------------------------------------------------------
@@ -89,7 +91,9 @@ typedef enum
     INSPECT_INSP_TYPE_IPC_SERVERS,
     INSPECT_INSP_TYPE_IPC_CLIENTS,
     INSPECT_INSP_TYPE_IPC_SERVERS_SESSIONS,
-    INSPECT_INSP_TYPE_IPC_CLIENTS_SESSIONS
+    INSPECT_INSP_TYPE_IPC_CLIENTS_SESSIONS,
+    INSPECT_INSP_TYPE_IPC_SERVERS_STATS,
+    INSPECT_INSP_TYPE_IPC_CLIENTS_STATS
 }
 InspType_t;
 
@@ -248,8 +252,31 @@ typedef struct SessionObjIter
 }
 SessionObjIter_t;
 
-// Type describing the commonalities of the interface objects - namely service, client, and session
-// objects
+// A call statistics record, along with the interface object it belongs to.
+typedef struct CallStats
+{
+    msgInterface_Interface_t interfaceObj; ///< Interface object the record belongs to.
+    msgStats_Record_t record;              ///< Call statistics record.
+}
+CallStats_t;
+
+typedef struct CallStatsIter
+{
+    RemoteHashmapAccess_t interfaceObjMap; ///< Interface object map in the remote process.
+    size_t currIndex;
+    RemoteHashmapListAccess_t interfaceObjList;
+                                         ///< Interface object list (technically a list of hashmap
+                                         ///< entries containing pointers to interface objects)
+                                         ///< of the current bucket of the interface object map
+                                         ///< in the remote process.
+    le_hashmap_Entry_t currEntry;           ///< Current entry containing the interface obj.
+    RemoteSlsListAccess_t callStatsList;    ///< Call statistics list of the current interface obj.
+    CallStats_t currCallStats;              ///< Current call statistics record.
+}
+CallStatsIter_t;
+
+// Type describing the commonalities of the interface objects - namely service, client, session,
+// and call statistics objects
 typedef struct InterfaceObjIter
 {
     RemoteHashmapAccess_t interfaceObjMap;
@@ -640,7 +667,6 @@ static void InitRemoteDlsListAccessObj
  * Initialize a RemoteSlsListAccess_t data struct.
  */
 //--------------------------------------------------------------------------------------------------
-__attribute__((unused))
 static void InitRemoteSlsListAccessObj
 (
     RemoteSlsListAccess_t* remoteList
@@ -917,6 +943,16 @@ static InterfaceObjIter_Ref_t CreateInterfaceObjIter
             getMapFunc          = msgInterface_GetClientInterfaceMap;
             break;
 
+        case INSPECT_INSP_TYPE_IPC_SERVERS_STATS:
+            getMapChgCntRefFunc = msgInterface_GetServiceObjMapChgCntRef;
+            getMapFunc          = msgInterface_GetServiceObjMap;
+            break;
+
+        case INSPECT_INSP_TYPE_IPC_CLIENTS_STATS:
+            getMapChgCntRefFunc = msgInterface_GetClientInterfaceMapChgCntRef;
+            getMapFunc          = msgInterface_GetClientInterfaceMap;
+            break;
+
         default:
             INTERNAL_ERR("unexpected interface object type %d.", interfaceType);
     }
@@ -1051,6 +1087,53 @@ static SessionObjIter_Ref_t CreateSessionObjIter
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates an iterator that can be used to iterate over the call statistics records of all server
+ * or client interfaces of a specific process. See the comment block for CreateMemPoolIter for
+ * additional detail.
+ *
+ * @return
+ *      An iterator to the call statistics records.
+ */
+//--------------------------------------------------------------------------------------------------
+static CallStatsIter_Ref_t CreateCallStatsIter
+(
+    void
+)
+{
+    CallStatsIter_Ref_t iteratorPtr;
+
+    switch (InspectType)
+    {
+        case INSPECT_INSP_TYPE_IPC_SERVERS_STATS:
+        case INSPECT_INSP_TYPE_IPC_CLIENTS_STATS:
+            iteratorPtr = (CallStatsIter_Ref_t)CreateInterfaceObjIter(InspectType);
+            break;
+
+        default:
+            INTERNAL_ERR("unexpected inspect type %d.", InspectType);
+    }
+
+    // Get the address offset of the call stats list change counter for the proc to inspect.
+    uintptr_t listChgCntAddrOffset = GetRemoteAddress(PidToInspect,
+                                                      msgStats_GetRecordListChgCntRef());
+
+    // Initialize the list.
+    InitRemoteSlsListAccessObj(&iteratorPtr->callStatsList);
+
+    // Get the listChgCntRef for the process-under-inspection.
+    if (TargetReadAddress(PidToInspect, listChgCntAddrOffset,
+                          &(iteratorPtr->callStatsList.ListChgCntRef),
+                          sizeof(iteratorPtr->callStatsList.ListChgCntRef)) != LE_OK)
+    {
+        INTERNAL_ERR(REMOTE_READ_ERR("call stats list change counter ref"));
+    }
+
+    return iteratorPtr;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Gets the memory pool list change counter from the specified iterator.
@@ -1182,6 +1265,31 @@ static size_t GetSessionListChgCnt
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the call statistics list change counter from the specified iterator. The list is also
+ * considered "changed" if the interface object has changed.
+ *
+ * @return
+ *      List change counter.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t GetCallStatsListChgCnt
+(
+    CallStatsIter_Ref_t iterator ///< [IN] The iterator to get the list change counter from.
+)
+{
+    size_t callStatsListChgCnt;
+    if (TargetReadAddress(PidToInspect, (uintptr_t)(iterator->callStatsList.ListChgCntRef),
+                          &callStatsListChgCnt, sizeof(callStatsListChgCnt)) != LE_OK)
+    {
+        INTERNAL_ERR(REMOTE_READ_ERR("call stats list change counter"));
+    }
+
+    return GetInterfaceObjMapChgCnt((InterfaceObjIter_Ref_t)iterator) + callStatsListChgCnt;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Gets the next link of the provided link. This is for accessing a list in a remote process,
@@ -1267,7 +1375,6 @@ static le_dls_Link_t* GetNextDlsLink
  *      Pointer to a link of a node in the remote process
  */
 //--------------------------------------------------------------------------------------------------
-__attribute__((unused))
 static le_sls_Link_t* GetNextSlsLink
 (
     RemoteSlsListAccess_t* listInfoRef,    ///< [IN] Object for accessing a list in the remote process.
@@ -1878,6 +1985,69 @@ static msgSession_UnixSession_t* GetNextSessionObj
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the next call statistics record from the specified iterator. For other detail see
+ * GetNextMemPool.
+ *
+ * @return
+ *      A call statistics record, along with the interface object it belongs to.
+ */
+//--------------------------------------------------------------------------------------------------
+static CallStats_t* GetNextCallStats
+(
+    CallStatsIter_Ref_t callStatsIterRef ///< [IN] The iterator to get the next record from.
+)
+{
+    le_sls_Link_t* remRecordNextLinkPtr;
+    void* interfaceObjPtr;
+
+    // Get the link of the next item on the call stats list.
+    remRecordNextLinkPtr = GetNextSlsLink(&(callStatsIterRef->callStatsList),
+                                          &(callStatsIterRef->currCallStats.record.link));
+
+    while (remRecordNextLinkPtr == NULL)
+    {
+        interfaceObjPtr = GetNextInterfaceObjPtr((InterfaceObjIter_Ref_t)callStatsIterRef);
+
+        // There are no more interface objects. And therefore no more records.
+        if (interfaceObjPtr == NULL)
+        {
+            return NULL;
+        }
+
+        // Read the interface object into our own memory.
+        if (TargetReadAddress(PidToInspect, (uintptr_t)interfaceObjPtr,
+                              &(callStatsIterRef->currCallStats.interfaceObj),
+                              sizeof(callStatsIterRef->currCallStats.interfaceObj)) != LE_OK)
+        {
+            INTERNAL_ERR(REMOTE_READ_ERR("interface object"));
+        }
+
+        // Update the call stats list in the iterator. Also reset the list head.
+        callStatsIterRef->callStatsList.List =
+            callStatsIterRef->currCallStats.interfaceObj.callStatsList;
+        callStatsIterRef->callStatsList.headLinkPtr = NULL;
+
+        // Get the link of the next item on the call stats list.
+        remRecordNextLinkPtr = GetNextSlsLink(&(callStatsIterRef->callStatsList), NULL);
+    }
+
+    // Get the remote address of the record.
+    msgStats_Record_t* remRecordPtr = CONTAINER_OF(remRecordNextLinkPtr, msgStats_Record_t, link);
+
+    // Read the record into our own memory.
+    if (TargetReadAddress(PidToInspect, (uintptr_t)remRecordPtr,
+                          &(callStatsIterRef->currCallStats.record),
+                          sizeof(callStatsIterRef->currCallStats.record)) != LE_OK)
+    {
+        INTERNAL_ERR(REMOTE_READ_ERR("call stats record"));
+    }
+
+    return &(callStatsIterRef->currCallStats);
+}
+
+
 // TODO: migrate the above to a separate module.
 //--------------------------------------------------------------------------------------------------
 /**
@@ -1896,7 +2066,7 @@ static void PrintHelp
         "\n"
         "SYNOPSIS:\n"
         "    inspect <pools|threads|timers|mutexes|semaphores> [OPTIONS] PID\n"
-        "    inspect ipc <servers|clients [sessions]> [OPTIONS] PID\n"
+        "    inspect ipc <servers|clients [sessions|stats]> [OPTIONS] PID\n"
         "\n"
         "DESCRIPTION:\n"
         "    inspect pools              Prints the memory pools usage for the specified process.\n"
@@ -1909,6 +2079,13 @@ static void PrintHelp
                                         " specified process.\n"
         "    inspect ipc                Prints the info of ipc in all threads for the"
                                         " specified process.\n"
+        "    inspect ipc <servers|clients> stats\n"
+        "                               Prints the number of request-response transactions\n"
+        "                               and their latency percentiles, in microseconds, for\n"
+        "                               each interface and function of the specified process.\n"
+        "                               Clients measure the round trip; servers measure from\n"
+        "                               receiving the request to sending the response.\n"
+        "                               Verbose mode also prints the latency histogram.\n"
         "\n"
         "OPTIONS:\n"
         "    -f\n"
@@ -1979,6 +2156,16 @@ static char SubPoolStr[] = "(Sub-pool)";
 static char SuperPoolStr[] = "";
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Max number of characters of a function name in the call statistics, and of one entry of the
+ * call statistics histogram ("<lower bound>us:<count>").
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_MSG_NAME_BYTES          64
+#define MAX_HISTOGRAM_ENTRY_BYTES   24
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * These tables define the display tables of each inspection type. The column width is left at 0
@@ -2074,6 +2261,21 @@ static ColumnInfo_t SessionObjTableInfo[] =
 };
 static size_t SessionObjTableInfoSize = NUM_ARRAY_MEMBERS(SessionObjTableInfo);
 
+static ColumnInfo_t CallStatsTableInfo[] =
+{
+    {"INTERFACE NAME", "%*s", NULL, "%*s", LIMIT_MAX_IPC_INTERFACE_NAME_BYTES, true,  0, true},
+    {"FUNCTION",       "%*s", NULL, "%*s", MAX_MSG_NAME_BYTES,                 true,  0, true},
+    {"MSG ID",         "%*s", NULL, "%*u", sizeof(uint32_t),                   false, 0, false},
+    {"COUNT",          "%*s", NULL, "%*"PRIu64"", sizeof(uint64_t),            false, 0, true},
+    {"AVG US",         "%*s", NULL, "%*u", sizeof(uint32_t),                   false, 0, true},
+    {"P50 US",         "%*s", NULL, "%*u", sizeof(uint32_t),                   false, 0, true},
+    {"P90 US",         "%*s", NULL, "%*u", sizeof(uint32_t),                   false, 0, false},
+    {"P99 US",         "%*s", NULL, "%*u", sizeof(uint32_t),                   false, 0, true},
+    {"MAX US",         "%*s", NULL, "%*u", sizeof(uint32_t),                   false, 0, true},
+    {"HISTOGRAM",      "%*s", NULL, "%*s", MAX_HISTOGRAM_ENTRY_BYTES,          true,  0, false}
+};
+static size_t CallStatsTableInfoSize = NUM_ARRAY_MEMBERS(CallStatsTableInfo);
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -2407,6 +2609,11 @@ static void InitDisplay
             InitDisplayTable(SessionObjTableInfo, SessionObjTableInfoSize);
             break;
 
+        case INSPECT_INSP_TYPE_IPC_SERVERS_STATS:
+        case INSPECT_INSP_TYPE_IPC_CLIENTS_STATS:
+            InitDisplayTable(CallStatsTableInfo, CallStatsTableInfoSize);
+            break;
+
         default:
             INTERNAL_ERR("Failed to initialize display table - unexpected inspect type %d.",
                          inspectType);
@@ -2613,6 +2820,18 @@ static int PrintInspectHeader
             tableSize = SessionObjTableInfoSize;
             break;
 
+        case INSPECT_INSP_TYPE_IPC_SERVERS_STATS:
+            strncpy(inspectTypeString, "IPC Server Interface Call Stats", inspectTypeStringSize);
+            table = CallStatsTableInfo;
+            tableSize = CallStatsTableInfoSize;
+            break;
+
+        case INSPECT_INSP_TYPE_IPC_CLIENTS_STATS:
+            strncpy(inspectTypeString, "IPC Client Interface Call Stats", inspectTypeStringSize);
+            table = CallStatsTableInfo;
+            tableSize = CallStatsTableInfoSize;
+            break;
+
         default:
             INTERNAL_ERR("unexpected inspect type %d.", InspectType);
     }
@@ -4008,6 +4227,289 @@ static int PrintSessionObjInfo
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads a null-terminated string from the remote process.  Reads a word at a time so that reading
+ * never goes past the page that holds the end of the string.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReadRemoteString
+(
+    uintptr_t remoteAddr,   ///< [IN] Address of the string in the remote process.
+    char* buffer,           ///< [OUT] Buffer to read the string into.
+    size_t bufferSize       ///< [IN] Size of the buffer.
+)
+{
+    size_t i = 0;
+
+    while (i < (bufferSize - 1))
+    {
+        long word;
+        uintptr_t wordAddr = remoteAddr & ~(sizeof(word) - 1);
+
+        if (TargetReadAddress(PidToInspect, wordAddr, &word, sizeof(word)) != LE_OK)
+        {
+            break;
+        }
+
+        // Copy the part of the word at and after remoteAddr.
+        size_t offset;
+        for (offset = remoteAddr - wordAddr; (offset < sizeof(word)) && (i < (bufferSize - 1));
+             offset++)
+        {
+            buffer[i] = ((char*)&word)[offset];
+            if (buffer[i] == '\0')
+            {
+                return;
+            }
+            i++;
+        }
+
+        remoteAddr = wordAddr + sizeof(word);
+    }
+
+    buffer[i] = '\0';
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Look up the name of a message ID from the protocol's message name table in the remote process.
+ * If the protocol has no name for it, the message ID is printed instead.
+ */
+//--------------------------------------------------------------------------------------------------
+static void LookupMsgName
+(
+    le_msg_ProtocolRef_t protocolRef,   ///< [IN] Remote protocol object.
+    uint32_t msgId,                     ///< [IN] Message ID.
+    char* nameBuffer,                   ///< [OUT] Buffer for the name.
+    size_t nameBufferSize               ///< [IN] Size of the name buffer.
+)
+{
+    msgProtocol_Protocol_t protocol;
+    const char* remNamePtr = NULL;
+
+    if (TargetReadAddress(PidToInspect, (uintptr_t)protocolRef, &protocol,
+                          sizeof(protocol)) != LE_OK)
+    {
+        INTERNAL_ERR(REMOTE_READ_ERR("protocol object"));
+    }
+
+    if ((protocol.msgNamesPtr != NULL) && (msgId < protocol.msgNameCount))
+    {
+        if (TargetReadAddress(PidToInspect, (uintptr_t)(protocol.msgNamesPtr + msgId),
+                              &remNamePtr, sizeof(remNamePtr)) != LE_OK)
+        {
+            INTERNAL_ERR(REMOTE_READ_ERR("message name table"));
+        }
+    }
+
+    if (remNamePtr != NULL)
+    {
+        ReadRemoteString((uintptr_t)remNamePtr, nameBuffer, nameBufferSize);
+    }
+    else if (msgId == MSG_STATS_OTHER_MSG_ID)
+    {
+        snprintf(nameBuffer, nameBufferSize, "<other>");
+    }
+    else
+    {
+        snprintf(nameBuffer, nameBufferSize, "<msg %" PRIu32 ">", msgId);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Estimate a latency percentile from a call statistics histogram.  The upper bound of the bucket
+ * that the percentile falls into is reported, so the estimate errs on the high side by at most a
+ * quarter of the value.
+ *
+ * @return
+ *      The latency in microseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t GetLatencyPercentile
+(
+    msgStats_Record_t* recordRef,   ///< [IN] Call statistics record.
+    unsigned int percentile         ///< [IN] Percentile to estimate (1 to 100).
+)
+{
+    uint64_t total = 0;
+    uint64_t target;
+    uint64_t seen = 0;
+    size_t i;
+
+    for (i = 0; i < MSG_STATS_BUCKET_COUNT; i++)
+    {
+        total += recordRef->buckets[i];
+    }
+
+    if (total == 0)
+    {
+        return 0;
+    }
+
+    target = ((total * percentile) + 99) / 100;
+
+    for (i = 0; i < (MSG_STATS_BUCKET_COUNT - 1); i++)
+    {
+        seen += recordRef->buckets[i];
+        if (seen >= target)
+        {
+            break;
+        }
+    }
+
+    if (i == (MSG_STATS_BUCKET_COUNT - 1))
+    {
+        return recordRef->maxUs;
+    }
+
+    uint32_t upperBound = msgStats_GetBucketLowerBound(i + 1) - 1;
+
+    return (upperBound < recordRef->maxUs) ? upperBound : recordRef->maxUs;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Print call statistics record information to stdout.
+ */
+//--------------------------------------------------------------------------------------------------
+static int PrintCallStatsInfo
+(
+    CallStats_t* callStatsRef   ///< [IN] ref to call statistics record to be printed.
+)
+{
+    int lineCount = 0;
+    msgStats_Record_t* recordRef = &callStatsRef->record;
+
+    // Retrieve the function name.
+    char msgName[MAX_MSG_NAME_BYTES] = {0};
+    LookupMsgName(callStatsRef->interfaceObj.id.protocolRef, recordRef->msgId,
+                  msgName, sizeof(msgName));
+
+    uint32_t avgUs = (recordRef->count == 0) ? 0 : (uint32_t)(recordRef->totalUs / recordRef->count);
+    uint32_t p50Us = GetLatencyPercentile(recordRef, 50);
+    uint32_t p90Us = GetLatencyPercentile(recordRef, 90);
+    uint32_t p99Us = GetLatencyPercentile(recordRef, 99);
+
+    // Format the non-empty histogram buckets as "<lower bound>us:<count>".
+    char histogram[MSG_STATS_BUCKET_COUNT][MAX_HISTOGRAM_ENTRY_BYTES];
+    int histogramCount = 0;
+    size_t i;
+    for (i = 0; i < MSG_STATS_BUCKET_COUNT; i++)
+    {
+        if (recordRef->buckets[i] != 0)
+        {
+            snprintf(histogram[histogramCount], MAX_HISTOGRAM_ENTRY_BYTES, "%" PRIu32 "us:%" PRIu32,
+                     msgStats_GetBucketLowerBound(i), recordRef->buckets[i]);
+            histogramCount++;
+        }
+    }
+
+    // Output call statistics info
+    int index = 0;
+
+    if (!IsOutputJson)
+    {
+        FillStrColField   (callStatsRef->interfaceObj.id.name, CallStatsTableInfo,
+                                                               CallStatsTableInfoSize, &index);
+        FillStrColField   (msgName,                   CallStatsTableInfo,
+                                                      CallStatsTableInfoSize, &index);
+        FillUint32ColField(recordRef->msgId,          CallStatsTableInfo,
+                                                      CallStatsTableInfoSize, &index);
+        FillUint64ColField(recordRef->count,          CallStatsTableInfo,
+                                                      CallStatsTableInfoSize, &index);
+        FillUint32ColField(avgUs,                     CallStatsTableInfo,
+                                                      CallStatsTableInfoSize, &index);
+        FillUint32ColField(p50Us,                     CallStatsTableInfo,
+                                                      CallStatsTableInfoSize, &index);
+        FillUint32ColField(p90Us,                     CallStatsTableInfo,
+                                                      CallStatsTableInfoSize, &index);
+        FillUint32ColField(p99Us,                     CallStatsTableInfo,
+                                                      CallStatsTableInfoSize, &index);
+        FillUint32ColField(recordRef->maxUs,          CallStatsTableInfo,
+                                                      CallStatsTableInfoSize, &index);
+        FillStrColField   ((histogramCount > 0) ? histogram[0] : "", CallStatsTableInfo,
+                                                      CallStatsTableInfoSize, &index);
+
+        PrintInfo(CallStatsTableInfo, CallStatsTableInfoSize);
+        lineCount++;
+
+        if (IsVerbose)
+        {
+            int j;
+            for (j = 1; j < histogramCount; j++)
+            {
+                PrintUnderColumn("HISTOGRAM", CallStatsTableInfo, CallStatsTableInfoSize,
+                                 histogram[j]);
+                lineCount++;
+            }
+        }
+    }
+    else
+    {
+        // The histogram is exported as an array of [lower bound, count] pairs.
+        char histogramJsonArray[(MSG_STATS_BUCKET_COUNT * MAX_HISTOGRAM_ENTRY_BYTES) + 3];
+        int strIdx = 0;
+
+        strIdx += snprintf(histogramJsonArray + strIdx, sizeof(histogramJsonArray) - strIdx, "[");
+        for (i = 0; i < MSG_STATS_BUCKET_COUNT; i++)
+        {
+            if (recordRef->buckets[i] != 0)
+            {
+                strIdx += snprintf(histogramJsonArray + strIdx,
+                                   sizeof(histogramJsonArray) - strIdx,
+                                   "%s[%" PRIu32 ",%" PRIu32 "]", (strIdx > 1) ? "," : "",
+                                   msgStats_GetBucketLowerBound(i), recordRef->buckets[i]);
+            }
+        }
+        snprintf(histogramJsonArray + strIdx, sizeof(histogramJsonArray) - strIdx, "]");
+
+        // If it's not the first time, print a comma.
+        if (!IsPrintedNodeFirst)
+        {
+            printf(",");
+        }
+        else
+        {
+            IsPrintedNodeFirst = false;
+        }
+
+        bool printed = false;
+
+        printf("[");
+
+        ExportStrToJson   (callStatsRef->interfaceObj.id.name, CallStatsTableInfo,
+                                                  CallStatsTableInfoSize, &index, &printed);
+        ExportStrToJson   (msgName,               CallStatsTableInfo,
+                                                  CallStatsTableInfoSize, &index, &printed);
+        ExportUint32ToJson(recordRef->msgId,      CallStatsTableInfo,
+                                                  CallStatsTableInfoSize, &index, &printed);
+        ExportUint64ToJson(recordRef->count,      CallStatsTableInfo,
+                                                  CallStatsTableInfoSize, &index, &printed);
+        ExportUint32ToJson(avgUs,                 CallStatsTableInfo,
+                                                  CallStatsTableInfoSize, &index, &printed);
+        ExportUint32ToJson(p50Us,                 CallStatsTableInfo,
+                                                  CallStatsTableInfoSize, &index, &printed);
+        ExportUint32ToJson(p90Us,                 CallStatsTableInfo,
+                                                  CallStatsTableInfoSize, &index, &printed);
+        ExportUint32ToJson(p99Us,                 CallStatsTableInfo,
+                                                  CallStatsTableInfoSize, &index, &printed);
+        ExportUint32ToJson(recordRef->maxUs,      CallStatsTableInfo,
+                                                  CallStatsTableInfoSize, &index, &printed);
+        ExportArrayToJson (histogramJsonArray,    CallStatsTableInfo,
+                                                  CallStatsTableInfoSize, &index, &printed);
+
+        printf("]");
+    }
+
+    return lineCount;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Function prototype needed by InspectEndHandling.
@@ -4189,6 +4691,14 @@ static void InspectFunc
             printNodeInfoFunc = (PrintNodeInfoFunc_t) PrintSessionObjInfo;
             break;
 
+        case INSPECT_INSP_TYPE_IPC_SERVERS_STATS:
+        case INSPECT_INSP_TYPE_IPC_CLIENTS_STATS:
+            createIterFunc    = (CreateIterFunc_t)    CreateCallStatsIter;
+            getListChgCntFunc = (GetListChgCntFunc_t) GetCallStatsListChgCnt;
+            getNextNodeFunc   = (GetNextNodeFunc_t)   GetNextCallStats;
+            printNodeInfoFunc = (PrintNodeInfoFunc_t) PrintCallStatsInfo;
+            break;
+
         default:
             INTERNAL_ERR("unexpected inspect type %d.", inspectType);
     }
@@ -4320,7 +4830,26 @@ static void IpcSessionArgHandler
     const char* sessionsArg
 )
 {
-    if (strcmp(sessionsArg, "sessions") == 0)
+    if (strcmp(sessionsArg, "stats") == 0)
+    {
+        switch (InspectType)
+        {
+            case INSPECT_INSP_TYPE_IPC_SERVERS:
+                InspectType = INSPECT_INSP_TYPE_IPC_SERVERS_STATS;
+                break;
+
+            case INSPECT_INSP_TYPE_IPC_CLIENTS:
+                InspectType = INSPECT_INSP_TYPE_IPC_CLIENTS_STATS;
+                break;
+
+            default:
+                INTERNAL_ERR("unexpected inspect type %d.", InspectType);
+        }
+
+        // Handle the next argument which should be PID.
+        le_arg_AddPositionalCallback(PidArgHandler);
+    }
+    else if (strcmp(sessionsArg, "sessions") == 0)
     {
         switch (InspectType)
         {
@@ -4522,6 +5051,11 @@ static void InitIteratorPool
                    sizeof(ThreadObjIter_t) : sizeof(SessionObjIter_t);
             break;
 
+        case INSPECT_INSP_TYPE_IPC_SERVERS_STATS:
+        case INSPECT_INSP_TYPE_IPC_CLIENTS_STATS:
+            size = sizeof(CallStatsIter_t);
+            break;
+
         default:
             INTERNAL_ERR("unexpected inspect type %d.", inspectType);
     }